@@ -23,6 +23,64 @@ constexpr auto serializing_target_prettified = "temp/serializing_target_prettifi
 
 constexpr bool generate_data = false;
 
+// Looks up every key of every object in the tree, used to compare object backends
+template <class NodeType>
+std::size_t lookup_all_keys(const NodeType& node) {
+    std::size_t found = 0;
+    if (node.is_object())
+        for (const auto& [key, value] : node.get_object()) found += node.contains(key) + lookup_all_keys(node.at(key));
+    else if (node.is_array())
+        for (const auto& elem : node.get_array()) found += lookup_all_keys(elem);
+    return found;
+}
+
+// Small "telemetry" struct, a typical use case for high-rate struct serialization
+struct Telemetry {
+    std::string           sensor;
+    double                timestamp;
+    std::array<double, 3> position;
+    std::vector<double>   readings;
+    bool                  valid;
+};
+
+UTL_JSON_REFLECT(Telemetry, sensor, timestamp, position, readings, valid);
+
+void benchmark_reflection() {
+    using namespace utl;
+
+    std::cout << "\n\n====== BENCHMARKING ON DATA: `Telemetry` struct ======\n";
+
+    const Telemetry telemetry = {"sensor_17", 1718.25, {0.5, -1.25, 3.}, {1., 2.5, -3.75, 4., 5.125, 6.}, true};
+
+    bench.title("Serializing reflected struct").relative(true);
+
+    benchmark("from_struct().to_string()", [&]() {
+        DO_NOT_OPTIMIZE_AWAY(json::from_struct(telemetry).to_string(json::Format::MINIMIZED));
+    });
+
+    benchmark("to_json_string()", [&]() {
+        std::string chars;
+        json::to_json_string(telemetry, chars, json::Format::MINIMIZED);
+        DO_NOT_OPTIMIZE_AWAY(chars);
+    });
+
+    std::string reused_buffer;
+    benchmark("to_json_string() (reused buffer)", [&]() {
+        reused_buffer.clear();
+        json::to_json_string(telemetry, reused_buffer, json::Format::MINIMIZED);
+        DO_NOT_OPTIMIZE_AWAY(reused_buffer);
+    });
+
+    const std::string chars = json::from_struct(telemetry).to_string(json::Format::MINIMIZED);
+
+    bench.title("Parsing reflected struct").relative(true);
+
+    benchmark("from_string().to_struct()",
+              [&]() { DO_NOT_OPTIMIZE_AWAY(json::from_string(chars).to_struct<Telemetry>()); });
+
+    benchmark("from_json_string()", [&]() { DO_NOT_OPTIMIZE_AWAY(json::from_json_string<Telemetry>(chars)); });
+}
+
 void benchmark_on_data(const std::string& filepath) {
     using namespace utl;
 
@@ -33,7 +91,8 @@ void benchmark_on_data(const std::string& filepath) {
     const std::string string_buffer = (std::ostringstream() << std::ifstream(filepath).rdbuf()).str();
     
     // utl::json
-    json::Node     json_utl = json::from_string(string_buffer);
+    json::Node     json_utl      = json::from_string(string_buffer);
+    json::FlatNode json_utl_flat = json::from_string<json::FlatNode>(string_buffer);
     // nlohmann
     nlohmann::json json_nlohmann;
     std::ifstream(filepath) >> json_nlohmann;
@@ -59,6 +118,31 @@ void benchmark_on_data(const std::string& filepath) {
         DO_NOT_OPTIMIZE_AWAY(json);
     });
 
+    benchmark("utl::json (flat)", [&]() {
+        const auto json = json::from_file<json::FlatNode>(parsing_target_minimized);
+        DO_NOT_OPTIMIZE_AWAY(json);
+    });
+
+    benchmark("utl::json (SAX)", [&]() {
+        json::SaxHandler  handler; // no-op, measures validation & event dispatch without building a tree
+        const std::string buffer = (std::ostringstream() << std::ifstream(parsing_target_minimized).rdbuf()).str();
+        json::sax_from_string(buffer, handler);
+        DO_NOT_OPTIMIZE_AWAY(handler);
+    });
+
+    benchmark("utl::json (view)", [&]() {
+        const std::string buffer = (std::ostringstream() << std::ifstream(parsing_target_minimized).rdbuf()).str();
+        const auto        json   = json::view_from_string(buffer);
+        DO_NOT_OPTIMIZE_AWAY(json);
+    });
+
+    benchmark("utl::json (arena)", [&]() {
+        json::Arena       arena;
+        const std::string buffer = (std::ostringstream() << std::ifstream(parsing_target_minimized).rdbuf()).str();
+        const auto        json   = json::from_string(buffer, arena);
+        DO_NOT_OPTIMIZE_AWAY(json);
+    });
+
     benchmark("nlohmann", [&]() {
         nlohmann::json json;
         std::ifstream(parsing_target_minimized) >> json;
@@ -91,6 +175,31 @@ void benchmark_on_data(const std::string& filepath) {
         DO_NOT_OPTIMIZE_AWAY(json);
     });
 
+    benchmark("utl::json (flat)", [&]() {
+        const auto json = json::from_file<json::FlatNode>(parsing_target_prettified);
+        DO_NOT_OPTIMIZE_AWAY(json);
+    });
+
+    benchmark("utl::json (SAX)", [&]() {
+        json::SaxHandler  handler; // no-op, measures validation & event dispatch without building a tree
+        const std::string buffer = (std::ostringstream() << std::ifstream(parsing_target_prettified).rdbuf()).str();
+        json::sax_from_string(buffer, handler);
+        DO_NOT_OPTIMIZE_AWAY(handler);
+    });
+
+    benchmark("utl::json (view)", [&]() {
+        const std::string buffer = (std::ostringstream() << std::ifstream(parsing_target_prettified).rdbuf()).str();
+        const auto        json   = json::view_from_string(buffer);
+        DO_NOT_OPTIMIZE_AWAY(json);
+    });
+
+    benchmark("utl::json (arena)", [&]() {
+        json::Arena       arena;
+        const std::string buffer = (std::ostringstream() << std::ifstream(parsing_target_prettified).rdbuf()).str();
+        const auto        json   = json::from_string(buffer, arena);
+        DO_NOT_OPTIMIZE_AWAY(json);
+    });
+
     benchmark("nlohmann", [&]() {
         nlohmann::json json;
         std::ifstream(parsing_target_prettified) >> json;
@@ -116,6 +225,13 @@ void benchmark_on_data(const std::string& filepath) {
 
     benchmark("utl::json",
               [&]() { json_utl.to_file(serializing_target_minimized, json::Format::MINIMIZED); });
+
+    benchmark("utl::json (flat)",
+              [&]() { json_utl_flat.to_file(serializing_target_minimized, json::Format::MINIMIZED); });
+
+    benchmark("utl::json (to_string)", [&]() {
+        std::ofstream(serializing_target_minimized) << json_utl.to_string(json::Format::MINIMIZED);
+    });
     
     benchmark("nlohmann", [&]() { std::ofstream(serializing_target_minimized) << json_nlohmann.dump(); });
 
@@ -135,6 +251,13 @@ void benchmark_on_data(const std::string& filepath) {
 
     benchmark("utl::json", [&]() { json_utl.to_file(serializing_target_prettified, json::Format::PRETTY); });
 
+    benchmark("utl::json (flat)",
+              [&]() { json_utl_flat.to_file(serializing_target_prettified, json::Format::PRETTY); });
+
+    benchmark("utl::json (to_string)", [&]() {
+        std::ofstream(serializing_target_prettified) << json_utl.to_string(json::Format::PRETTY);
+    });
+
     benchmark("nlohmann", [&]() { std::ofstream(serializing_target_prettified) << json_nlohmann.dump(4); });
 
     benchmark("PicoJSON", [&]() { std::ofstream(serializing_target_prettified) << json_picojson.serialize(true); });
@@ -145,6 +268,13 @@ void benchmark_on_data(const std::string& filepath) {
         json_rapidjson.Accept(writer);
         std::ofstream(serializing_target_prettified) << buffer.GetString();
     });
+
+    // Benchmark object lookup
+    bench.title("Looking up all object keys").relative(true);
+
+    benchmark("utl::json", [&]() { DO_NOT_OPTIMIZE_AWAY(lookup_all_keys(json_utl)); });
+
+    benchmark("utl::json (flat)", [&]() { DO_NOT_OPTIMIZE_AWAY(lookup_all_keys(json_utl_flat)); });
 }
 
 int main() {
@@ -168,6 +298,9 @@ int main() {
         utl::json::Node(numbers).to_file("benchmarks/data/numbers.json");
     }
     
+    // Benchmark reflection
+    benchmark_reflection();
+
     // Benchmark on different datasets
     benchmark_on_data("benchmarks/data/strings.json");
     benchmark_on_data("benchmarks/data/numbers.json");
@@ -2,18 +2,25 @@
 
 #include "benchmark.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <climits>
 #include <complex>
+#include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <ios>
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <numeric>
+#include <optional>
 #include <random>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 
@@ -334,9 +341,273 @@ void benchmark_raw_logging_overhead() {
     });
 }
 
+// Benchmark for: overhead of log calls below the verbosity of all sinks
+//
+// Such calls used to reach 'push_message()', evaluate all arguments & walk the list of sinks only for every sink to
+// reject the message. Now macros check a single atomic "max verbosity" first, and 'UTL_LOG_COMPILE_LEVEL' removes
+// disabled levels entirely, which is what an empty loop emulates (the level can't be changed mid-translation-unit).
+//
+void benchmark_disabled_logging() {
+    using namespace utl;
+
+    constexpr int repeats = 10'000;
+
+    std::filesystem::create_directories("temp");
+
+    // Only errors reach the sink, which also keeps it silent during other benchmarks
+    log::add_file_sink("temp/disabled.log", log::OpenMode::REWRITE, log::Verbosity::ERR);
+
+    bench.title("Disabled log call overhead").timeUnit(1ns, "ns").minEpochIterations(50).warmup(10).relative(true);
+
+    benchmark("Sink-side rejection (old path)", [&]() {
+        REPEAT(repeats)
+        log::_logger::instance().push_message({__FILE__, __LINE__}, {log::Verbosity::TRACE}, "int = ", count_,
+                                              ", float = ", 0.5 * count_, ", string = ", datagen::rand_string());
+    });
+
+    benchmark("UTL_LOG_TRACE() (runtime-disabled)", [&]() {
+        REPEAT(repeats)
+        UTL_LOG_TRACE("int = ", count_, ", float = ", 0.5 * count_, ", string = ", datagen::rand_string());
+    });
+
+    benchmark("No logging (compiled out)", [&]() {
+        REPEAT(repeats) DO_NOT_OPTIMIZE_AWAY(count_);
+    });
+}
+
+// Benchmark for: cost of the decoration columns relative to logging just the message
+//
+// Date & thread columns used to call 'localtime()' + 'strftime()' & lock a global thread id map on every message,
+// now both are cached per thread, so all columns enabled should cost only marginally more than the message alone.
+//
+void benchmark_log_columns() {
+    using namespace utl;
+
+    constexpr int repeats = 5'000;
+
+    std::filesystem::create_directories("temp");
+
+    log::Columns message_only;
+    message_only.datetime = false;
+    message_only.uptime   = false;
+    message_only.thread   = false;
+    message_only.callsite = false;
+    message_only.level    = false;
+
+    // Only one sink is enabled at a time, the other one is set to reject everything below errors
+    auto& all_columns_sink  = log::add_file_sink("temp/columns_all.log").set_verbosity(log::Verbosity::ERR);
+    auto& message_only_sink = log::add_file_sink("temp/columns_message.log").set_columns(message_only);
+    message_only_sink.set_verbosity(log::Verbosity::ERR);
+
+    bench.title("Log columns overhead").timeUnit(1ms, "ms").minEpochIterations(20).warmup(10).relative(true);
+
+    message_only_sink.set_verbosity(log::Verbosity::TRACE);
+    benchmark("Message only", [&]() {
+        REPEAT(repeats) UTL_LOG_INFO("int = ", count_, ", float = ", 0.5 * count_, ", string = ", "some text");
+    });
+    message_only_sink.set_verbosity(log::Verbosity::ERR);
+
+    all_columns_sink.set_verbosity(log::Verbosity::TRACE);
+    benchmark("All columns", [&]() {
+        REPEAT(repeats) UTL_LOG_INFO("int = ", count_, ", float = ", 0.5 * count_, ", string = ", "some text");
+    });
+    all_columns_sink.set_verbosity(log::Verbosity::ERR);
+}
+
+// Benchmark for: cost of a noisy log call in a tight loop with & without rate limiting
+//
+// Suppressed calls only touch a per-callsite atomic, arguments aren't evaluated & sinks aren't involved.
+//
+void benchmark_rate_limited_logging() {
+    using namespace utl;
+
+    constexpr int repeats = 1'000;
+
+    std::filesystem::create_directories("temp");
+    log::add_file_sink("temp/rate_limited.log", log::OpenMode::REWRITE, log::Verbosity::WARN);
+
+    bench.title("Rate-limited log call overhead").timeUnit(1ns, "ns").minEpochIterations(50).warmup(10);
+    bench.relative(true);
+
+    benchmark("UTL_LOG_WARN()", [&]() {
+        REPEAT(repeats) UTL_LOG_WARN("residual = ", 0.5 * count_, " exceeds tolerance");
+    });
+
+    benchmark("UTL_LOG_EVERY_N(WARN, 1000)", [&]() {
+        REPEAT(repeats) UTL_LOG_EVERY_N(WARN, 1000, "residual = ", 0.5 * count_, " exceeds tolerance");
+    });
+
+    benchmark("UTL_LOG_EVERY_MS(WARN, 100)", [&]() {
+        REPEAT(repeats) UTL_LOG_EVERY_MS(WARN, 100, "residual = ", 0.5 * count_, " exceeds tolerance");
+    });
+
+    benchmark("UTL_LOG_RATE_LIMITED(WARN, 10, 5)", [&]() {
+        REPEAT(repeats) UTL_LOG_RATE_LIMITED(WARN, 10, 5, "residual = ", 0.5 * count_, " exceeds tolerance");
+    });
+}
+
+// Benchmark for: multi-threaded logging into a file, sync vs async modes
+//
+// In sync mode every thread formats its message & does a blocking 'write()' under the sink mutex, so threads stall
+// on I/O & on each other. In async mode threads only stringify the message & push it into a lock-free queue.
+// We measure producer-side throughput & latency of individual logging calls, the background thread keeps writing
+// after the producers are done, which is why the whole log is flushed before switching to the next mode.
+//
+// We use the number of logged calls to verify the result.
+//
+void benchmark_async_logging() {
+    using namespace utl;
+
+    constexpr int         thread_count       = 4;
+    constexpr int         messages_per_batch = 2'000; // per thread
+    constexpr int         latency_samples    = 20'000; // per thread
+    constexpr std::size_t queue_capacity     = 8192;
+
+    log::println("\n\n====== BENCHMARKING ON: Async logging ======\n");
+    log::println("Threads           -> ", thread_count);
+    log::println("Queue capacity    -> ", queue_capacity);
+
+    std::filesystem::create_directories("temp");
+
+    log::Columns cols;
+    cols.callsite = false;
+    log::add_file_sink("temp/async.log").set_columns(cols);
+
+    const std::pair<const char*, std::optional<log::Overflow>> modes[] = {
+        {"sync", std::nullopt},
+        {"async (Overflow::BLOCK)", log::Overflow::BLOCK},
+        {"async (Overflow::DROP)", log::Overflow::DROP},
+        {"async (Overflow::GROW)", log::Overflow::GROW},
+    };
+
+    const auto set_mode = [&](const std::optional<log::Overflow>& overflow) {
+        log::disable_async();
+        if (overflow) log::enable_async(queue_capacity, *overflow);
+    };
+
+    const auto run_threads = [&](auto&& thread_func) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < thread_count; ++t) threads.emplace_back(thread_func, t);
+        for (auto& thread : threads) thread.join();
+    };
+
+    // Throughput
+    bench.title("Multi-threaded logging throughput").timeUnit(1ms, "ms").minEpochIterations(10).warmup(2);
+    bench.relative(true);
+
+    for (const auto& [name, overflow] : modes) {
+        set_mode(overflow);
+
+        benchmark(name, [&]() {
+            run_threads([&](int t) {
+                for (int i = 0; i < messages_per_batch; ++i)
+                    UTL_LOG_INFO("thread = ", t, ", int = ", i, ", float = ", 0.5 * i, ", string = ", "some text");
+            });
+        });
+
+        log::flush();
+    }
+
+    // Latency of individual calls, measured manually since nanobench reports averages
+    log::println();
+    table::create({30, 15, 15, 15, 15, 15});
+    table::set_formats({table::DEFAULT(), table::DEFAULT(), table::DEFAULT(), table::FIXED(2), table::FIXED(2),
+                        table::FIXED(2)});
+    table::hline();
+    table::cell("Mode", "Calls", "Dropped", "Median (us)", "P99 (us)", "Max (us)");
+    table::hline();
+
+    for (const auto& [name, overflow] : modes) {
+        set_mode(overflow);
+
+        std::vector<std::vector<double>> latencies(thread_count, std::vector<double>(latency_samples));
+
+        run_threads([&](int t) {
+            for (int i = 0; i < latency_samples; ++i) {
+                const auto start = std::chrono::steady_clock::now();
+                UTL_LOG_INFO("thread = ", t, ", int = ", i, ", float = ", 0.5 * i, ", string = ", "some text");
+                const auto end = std::chrono::steady_clock::now();
+
+                latencies[t][i] = std::chrono::duration<double, std::micro>(end - start).count();
+            }
+        });
+
+        const std::size_t dropped = log::get_dropped_count();
+        log::flush();
+
+        std::vector<double> all;
+        for (const auto& samples : latencies) all.insert(all.end(), samples.begin(), samples.end());
+        std::sort(all.begin(), all.end());
+
+        table::cell(name, all.size(), dropped, all[all.size() / 2], all[all.size() * 99 / 100], all.back());
+    }
+
+    log::disable_async();
+}
+
+// Benchmark for: cost of a log call on the calling thread in regular, async & deferred modes
+//
+// Async mode still stringifies the arguments on the calling thread, deferred mode only copies their bytes into
+// a thread-local buffer & leaves stringification to the background thread. We measure producer-side latency of
+// individual calls, buffers are made large enough to absorb the whole batch, so nobody waits for the consumer.
+//
+void benchmark_deferred_logging() {
+    using namespace utl;
+
+    constexpr int calls = 50'000;
+
+    log::println("\n\n====== BENCHMARKING ON: Deferred logging ======\n");
+
+    std::filesystem::create_directories("temp");
+
+    log::Columns cols;
+    cols.callsite = false;
+    log::add_file_sink("temp/deferred.log").set_columns(cols);
+
+    const std::pair<const char*, std::function<void()>> modes[] = {
+        {"sync", [] {}},
+        {"async (Overflow::GROW)", [] { log::enable_async(calls, log::Overflow::GROW); }},
+        {"deferred", [] { log::enable_deferred(calls * 256); }},
+    };
+
+    table::create({30, 15, 15, 15});
+    table::set_formats({table::DEFAULT(), table::FIXED(1), table::FIXED(1), table::FIXED(1)});
+    table::hline();
+    table::cell("Mode", "Median (ns)", "P99 (ns)", "Mean (ns)");
+    table::hline();
+
+    std::vector<double> latencies(calls);
+
+    for (const auto& [name, enable_mode] : modes) {
+        enable_mode();
+
+        for (int i = 0; i < calls; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            UTL_LOG_INFO("iteration = ", i, ", residual = ", 1e-3 / (i + 1), ", converged = ", i % 7 == 0);
+            const auto end = std::chrono::steady_clock::now();
+
+            latencies[i] = std::chrono::duration<double, std::nano>(end - start).count();
+        }
+
+        log::flush();
+        log::disable_async();
+        log::disable_deferred();
+
+        const double mean = std::accumulate(latencies.begin(), latencies.end(), 0.) / calls;
+        std::sort(latencies.begin(), latencies.end());
+
+        table::cell(name, latencies[calls / 2], latencies[calls * 99 / 100], mean);
+    }
+}
+
 int main() {
     using namespace utl;
 
     benchmark_stringification();
     //benchmark_raw_logging_overhead();
+    benchmark_disabled_logging();
+    benchmark_log_columns();
+    benchmark_rate_limited_logging();
+    benchmark_async_logging();
+    benchmark_deferred_logging();
 }
\ No newline at end of file
@@ -2,17 +2,49 @@
 
 #include "benchmark.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <cstddef>
+#include <cstdlib>
 #include <functional>
+#include <future>
 #include <iterator>
+#include <new>
+#include <numeric>
+#include <string>
+#include <utility>
 #include <vector>
 
 #ifdef _OPENMP
 #include <omp.h>
 #endif
 
+#ifdef BENCHMARK_STD_EXECUTION
+#include <execution>
+#endif
+
 // _____________ BENCHMARK IMPLEMENTATION _____________
 
+// Replaced global allocation functions, used to count heap allocations performed by the thread pool
+std::atomic<std::size_t> allocation_count{0};
+
+// GCC flags 'std::free()' on memory from the replaced 'operator new' as a mismatch, but both sides use 'std::malloc()'
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void* operator new(std::size_t size) {
+    ++allocation_count;
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+#pragma GCC diagnostic pop
+
 // Benchmark for: repeated parallel matrix multiplication
 //    for (repeats) C += A * B;
 // assuming naive implementation.
@@ -229,7 +261,826 @@ void benchmark_sum() {
     table::cell("parallel::reduce<4>() (loop unrolling enabled))", sum_parallel_reduce_unrolled);
 }
 
+// Benchmark for: parallel dot product
+//    dot = sum(A[i] * B[i])
+//
+// Showcases 'parallel::transform_reduce()' which avoids materializing a temporary 'A[i] * B[i]' container.
+//
+// We use control sum to verify the result.
+//
+void benchmark_dot_product() {
+    constexpr std::size_t N            = 20'000'000;
+    constexpr std::size_t thread_count = 4;
+
+    log::println("\n\n====== BENCHMARKING ON: Parallel dot product ======\n");
+    log::println("Threads           -> ", thread_count);
+    log::println("N                 -> ", N);
+    log::println("Data memory usage -> ", math::to_memory_units(N * 2 * sizeof(double)), " MiB");
+
+    const std::vector<double> A(N, 0.5);
+    const std::vector<double> B(N, 2.0);
+
+    // Global benchmark options
+    bench.minEpochIterations(10).timeUnit(1ms, "ms").title("Parallel dot product").relative(true).warmup(10);
+
+    // Serial benchmark (reference)
+    double dot_serial;
+    benchmark("Serial version", [&]() {
+        dot_serial = 0;
+        for (std::size_t i = 0; i < N; ++i) dot_serial += A[i] * B[i];
+    });
+
+    // OpenMP reduce
+#ifdef _OPENMP
+    double dot_omp;
+    omp_set_num_threads(thread_count);
+    benchmark("OpenMP reduce", [&]() {
+        dot_omp = 0;
+#pragma omp parallel for reduction(+ : dot_omp)
+        for (std::size_t i = 0; i < N; ++i) dot_omp += A[i] * B[i];
+    });
+#endif
+
+    // parallel::reduce() over a temporary container
+    double dot_temporary;
+    parallel::set_thread_count(thread_count);
+    benchmark("parallel::reduce() (temporary container)", [&]() {
+        std::vector<double> products(N);
+        parallel::for_loop(parallel::IndexRange<std::size_t>{0, N}, [&](std::size_t low, std::size_t high) {
+            for (std::size_t i = low; i < high; ++i) products[i] = A[i] * B[i];
+        });
+        dot_temporary = parallel::reduce(products, parallel::sum<>{});
+    });
+
+    // parallel::transform_reduce()
+    double dot_transform_reduce;
+    benchmark("parallel::transform_reduce()", [&]() {
+        dot_transform_reduce = parallel::transform_reduce(A, B, parallel::sum<>{}, parallel::prod<>{});
+    });
+
+    // parallel::transform_reduce<4>()
+    double dot_transform_reduce_unrolled;
+    benchmark("parallel::transform_reduce<4>() (loop unrolling enabled)", [&]() {
+        dot_transform_reduce_unrolled = parallel::transform_reduce<4>(A, B, parallel::sum<>{}, parallel::prod<>{});
+    });
+
+    // Verify correctness
+    log::println();
+    table::create({60, 20});
+    table::set_formats({table::DEFAULT(), table::FIXED(10)});
+    table::hline();
+    table::cell("Method", "Control sum");
+    table::hline();
+    table::cell("Serial", dot_serial);
+#ifdef _OPENMP
+    table::cell("OpenMP reduce", dot_omp);
+#endif
+    table::cell("parallel::reduce() (temporary container)", dot_temporary);
+    table::cell("parallel::transform_reduce()", dot_transform_reduce);
+    table::cell("parallel::transform_reduce<4>() (loop unrolling enabled)", dot_transform_reduce_unrolled);
+}
+
+// Benchmark for: parallel for loop with fine-grained tasks
+//    for (i) B[i] = f(A[i]);
+// split into a large number of small tasks.
+//
+// With small grains a lot of time is spent on scheduling rather than doing the work, which is exactly
+// where a single shared task queue becomes a contention point and work stealing is supposed to help.
+//
+// We use control sum to verify the result.
+//
+void benchmark_fine_grained_for_loop() {
+    constexpr std::size_t N            = 4'000'000;
+    constexpr std::size_t grain_size   = 500;
+    constexpr std::size_t thread_count = 4;
+
+    log::println("\n\n====== BENCHMARKING ON: Fine-grained parallel for ======\n");
+    log::println("Threads           -> ", thread_count);
+    log::println("N                 -> ", N);
+    log::println("Grain size        -> ", grain_size);
+    log::println("Tasks             -> ", N / grain_size);
+
+    const std::vector<double> A(N, 0.5);
+    std::vector<double>       B(N);
+
+    const auto compute = [&](std::size_t low, std::size_t high) {
+        for (std::size_t i = low; i < high; ++i) B[i] = std::sqrt(A[i] * A[i] + 1.);
+    };
+
+    const auto control_sum = [&] {
+        double s = 0;
+        for (auto e : B) s += e;
+        return s;
+    };
+
+    // Global benchmark options
+    bench.minEpochIterations(10).timeUnit(1ms, "ms").title("Fine-grained parallel for").relative(true).warmup(10);
+
+    // Serial benchmark (reference)
+    benchmark("Serial version", [&]() { compute(0, N); });
+    const double sum_serial = control_sum();
+
+    // OpenMP parallel for
+#ifdef _OPENMP
+    omp_set_num_threads(thread_count);
+    benchmark("OpenMP parallel for (dynamic)", [&]() {
+#pragma omp parallel for schedule(dynamic, grain_size)
+        for (std::size_t i = 0; i < N; ++i) B[i] = std::sqrt(A[i] * A[i] + 1.);
+    });
+    const double sum_omp = control_sum();
+#endif
+
+    // parallel::for_loop() with a shared queue
+    parallel::set_thread_count(thread_count);
+    parallel::set_scheduler(parallel::Scheduler::SHARED_QUEUE);
+    benchmark("parallel::for_loop() (shared queue)",
+              [&]() { parallel::for_loop(parallel::IndexRange<std::size_t>{0, N, grain_size}, compute); });
+    const double sum_shared = control_sum();
+
+    // parallel::for_loop() with work stealing
+    parallel::set_scheduler(parallel::Scheduler::WORK_STEALING);
+    benchmark("parallel::for_loop() (work stealing)",
+              [&]() { parallel::for_loop(parallel::IndexRange<std::size_t>{0, N, grain_size}, compute); });
+    const double sum_stealing = control_sum();
+
+    parallel::set_scheduler(parallel::Scheduler::SHARED_QUEUE);
+
+    // Verify correctness
+    log::println();
+    table::create({50, 20});
+    table::set_formats({table::DEFAULT(), table::FIXED(2)});
+    table::hline();
+    table::cell("Method", "Control sum");
+    table::hline();
+    table::cell("Serial", sum_serial);
+#ifdef _OPENMP
+    table::cell("OpenMP parallel for (dynamic)", sum_omp);
+#endif
+    table::cell("parallel::for_loop() (shared queue)", sum_shared);
+    table::cell("parallel::for_loop() (work stealing)", sum_stealing);
+}
+
+// Benchmark for: parallel for loop with skewed per-iteration cost
+//    for (i) B[i] = work(A[i], cost(i));
+// where iteration cost varies ~100x across the range.
+//
+// Fixed upfront split leaves threads that got cheap chunks idle while others finish the expensive tail,
+// dynamic & guided schedules let idle threads claim more work from a shared counter.
+//
+// We use control sum to verify the result.
+//
+void benchmark_skewed_for_loop() {
+    constexpr std::size_t N            = 200'000;
+    constexpr std::size_t grain_size   = 64;
+    constexpr std::size_t thread_count = 4;
+
+    log::println("\n\n====== BENCHMARKING ON: Skewed parallel for ======\n");
+    log::println("Threads           -> ", thread_count);
+    log::println("N                 -> ", N);
+    log::println("Grain size        -> ", grain_size, " (dynamic & guided only)");
+
+    const std::vector<double> A(N, 0.5);
+    std::vector<double>       B(N);
+
+    const auto work = [](double x, std::size_t cost) {
+        for (std::size_t k = 0; k < cost; ++k) x = std::sqrt(x * x + 1.);
+        return x;
+    };
+
+    const auto control_sum = [&] {
+        double s = 0;
+        for (auto e : B) s += e;
+        return s;
+    };
+
+    // Cost profiles, both vary ~100x
+    const auto cost_ramp  = [](std::size_t i) { return 1 + 99 * i / N; };                 // grows towards the end
+    const auto cost_spiky = [](std::size_t i) { return ((i / 5000) % 8 == 0) ? 100 : 1; }; // expensive clusters
+
+    const auto benchmark_profile = [&](const char* title, auto cost) {
+        const auto compute = [&](std::size_t low, std::size_t high) {
+            for (std::size_t i = low; i < high; ++i) B[i] = work(A[i], cost(i));
+        };
+
+        // Global benchmark options
+        bench.minEpochIterations(10).timeUnit(1ms, "ms").title(title).relative(true).warmup(10);
+
+        // Serial benchmark (reference)
+        benchmark("Serial version", [&]() { compute(0, N); });
+        const double sum_serial = control_sum();
+
+        // OpenMP parallel for
+#ifdef _OPENMP
+        omp_set_num_threads(thread_count);
+        benchmark("OpenMP parallel for (static)", [&]() {
+#pragma omp parallel for schedule(static)
+            for (std::size_t i = 0; i < N; ++i) B[i] = work(A[i], cost(i));
+        });
+        const double sum_omp_static = control_sum();
+
+        benchmark("OpenMP parallel for (dynamic)", [&]() {
+#pragma omp parallel for schedule(dynamic, grain_size)
+            for (std::size_t i = 0; i < N; ++i) B[i] = work(A[i], cost(i));
+        });
+        const double sum_omp_dynamic = control_sum();
+
+        benchmark("OpenMP parallel for (guided)", [&]() {
+#pragma omp parallel for schedule(guided, grain_size)
+            for (std::size_t i = 0; i < N; ++i) B[i] = work(A[i], cost(i));
+        });
+        const double sum_omp_guided = control_sum();
+#endif
+
+        // parallel::for_loop() with different schedules
+        parallel::set_thread_count(thread_count);
+
+        benchmark("parallel::for_loop() (static)",
+                  [&]() { parallel::for_loop(parallel::IndexRange<std::size_t>{0, N}, compute); });
+        const double sum_static = control_sum();
+
+        benchmark("parallel::for_loop() (dynamic)", [&]() {
+            parallel::for_loop(parallel::IndexRange<std::size_t>{0, N, grain_size}, compute,
+                               parallel::Schedule::DYNAMIC);
+        });
+        const double sum_dynamic = control_sum();
+
+        benchmark("parallel::for_loop() (guided)", [&]() {
+            parallel::for_loop(parallel::IndexRange<std::size_t>{0, N, grain_size}, compute,
+                               parallel::Schedule::GUIDED);
+        });
+        const double sum_guided = control_sum();
+
+        // Verify correctness
+        log::println();
+        table::create({50, 20});
+        table::set_formats({table::DEFAULT(), table::FIXED(2)});
+        table::hline();
+        table::cell("Method", "Control sum");
+        table::hline();
+        table::cell("Serial", sum_serial);
+#ifdef _OPENMP
+        table::cell("OpenMP parallel for (static)", sum_omp_static);
+        table::cell("OpenMP parallel for (dynamic)", sum_omp_dynamic);
+        table::cell("OpenMP parallel for (guided)", sum_omp_guided);
+#endif
+        table::cell("parallel::for_loop() (static)", sum_static);
+        table::cell("parallel::for_loop() (dynamic)", sum_dynamic);
+        table::cell("parallel::for_loop() (guided)", sum_guided);
+        log::println();
+    };
+
+    benchmark_profile("Skewed parallel for (cost ramp)", cost_ramp);
+    benchmark_profile("Skewed parallel for (cost spikes)", cost_spiky);
+}
+
+// Benchmark for: recursive task spawning
+//    task(depth) = { if (depth) { task(depth - 1); task(depth - 1); } else { work(); } }
+//
+// Tasks submitted from inside the workers is where work stealing shines the most,
+// new tasks go into the local queue of the worker and never touch any shared state.
+//
+// We use the number of leaf tasks to verify the result.
+//
+void benchmark_recursive_tasks() {
+    constexpr std::size_t depth        = 14;
+    constexpr std::size_t thread_count = 4;
+
+    log::println("\n\n====== BENCHMARKING ON: Recursive task spawning ======\n");
+    log::println("Threads           -> ", thread_count);
+    log::println("Depth             -> ", depth);
+    log::println("Tasks             -> ", (std::size_t(1) << (depth + 1)) - 1);
+
+    std::atomic<std::size_t> leaves{0};
+
+    // Global benchmark options
+    bench.minEpochIterations(10).timeUnit(1ms, "ms").title("Recursive task spawning").relative(true).warmup(10);
+
+    // OpenMP tasks
+#ifdef _OPENMP
+    omp_set_num_threads(thread_count);
+    const std::function<void(std::size_t)> spawn_omp = [&](std::size_t level) {
+        if (level == 0) {
+            ++leaves;
+            return;
+        }
+#pragma omp task
+        spawn_omp(level - 1);
+#pragma omp task
+        spawn_omp(level - 1);
+    };
+    benchmark("OpenMP tasks", [&]() {
+        leaves = 0;
+#pragma omp parallel
+#pragma omp single
+        spawn_omp(depth);
+    });
+    const std::size_t leaves_omp = leaves;
+#endif
+
+    // parallel::ThreadPool
+    const auto benchmark_pool = [&](const char* name, parallel::Scheduler scheduler) {
+        parallel::ThreadPool pool(thread_count, scheduler);
+
+        std::function<void(std::size_t)> spawn = [&](std::size_t level) {
+            if (level == 0) {
+                ++leaves;
+                return;
+            }
+            pool.add_task(spawn, level - 1);
+            pool.add_task(spawn, level - 1);
+        };
+
+        benchmark(name, [&]() {
+            leaves = 0;
+            pool.add_task(spawn, depth);
+            pool.wait_for_tasks();
+        });
+
+        return leaves.load();
+    };
+
+    const std::size_t leaves_shared   = benchmark_pool("ThreadPool (shared queue)", parallel::Scheduler::SHARED_QUEUE);
+    const std::size_t leaves_stealing =
+        benchmark_pool("ThreadPool (work stealing)", parallel::Scheduler::WORK_STEALING);
+
+    // Verify correctness
+    log::println();
+    table::create({50, 20});
+    table::hline();
+    table::cell("Method", "Leaf tasks");
+    table::hline();
+#ifdef _OPENMP
+    table::cell("OpenMP tasks", leaves_omp);
+#endif
+    table::cell("ThreadPool (shared queue)", leaves_shared);
+    table::cell("ThreadPool (work stealing)", leaves_stealing);
+}
+
+// Benchmark for: parallel algorithms scaling
+//    sort(A), inclusive_scan(A), count_if(A), find_if(A), partition(A)
+// with thread count varying from 1 to the hardware concurrency.
+//
+// Standard parallel algorithms require a backend (TBB for libstdc++), to include them in comparison
+// define 'BENCHMARK_STD_EXECUTION' and link the backend, see 'benchmarks/CMakeLists.txt'.
+//
+// We use control sum to verify the result.
+//
+void benchmark_algorithms() {
+    constexpr std::size_t N = 5'000'000;
+
+    log::println("\n\n====== BENCHMARKING ON: Parallel algorithms ======\n");
+    log::println("Threads           -> 1..", parallel::max_thread_count());
+    log::println("N                 -> ", N);
+    log::println("Data memory usage -> ", math::to_memory_units(N * sizeof(double)), " MiB");
+
+    std::vector<double> data(N);
+    for (auto& e : data) e = random::rand_double();
+
+    std::vector<double> A, B(N);
+
+    std::vector<std::size_t> thread_counts;
+    for (std::size_t threads = 1; threads < parallel::max_thread_count(); threads *= 2)
+        thread_counts.push_back(threads);
+    thread_counts.push_back(parallel::max_thread_count());
+
+    // benchmark names get reused as labels of the control sum table
+    std::vector<std::string> names;
+    names.reserve(thread_counts.size() * 5);
+
+    const auto checksum = [](const std::vector<double>& vec) {
+        double s = 0;
+        for (std::size_t i = 0; i < vec.size(); ++i) s += vec[i] * static_cast<double>(i % 7);
+        return s; // position-dependent, so it also verifies the order
+    };
+
+    table::create({50, 20});
+    table::set_formats({table::DEFAULT(), table::FIXED(4)});
+
+    // --- Sort ---
+    bench.minEpochIterations(5).timeUnit(1ms, "ms").title("Parallel sort").relative(true).warmup(2);
+
+    benchmark("std::sort()", [&]() {
+        A = data;
+        std::sort(A.begin(), A.end());
+    });
+    const double sum_std_sort = checksum(A);
+
+#ifdef BENCHMARK_STD_EXECUTION
+    benchmark("std::sort(std::execution::par)", [&]() {
+        A = data;
+        std::sort(std::execution::par, A.begin(), A.end());
+    });
+    const double sum_std_par_sort = checksum(A);
+#endif
+
+    std::vector<double> sums_sort;
+    for (auto threads : thread_counts) {
+        parallel::set_thread_count(threads);
+        names.push_back("parallel::sort() (" + std::to_string(threads) + " threads)");
+        benchmark(names.back().c_str(), [&]() {
+            A = data;
+            parallel::sort(A);
+        });
+        sums_sort.push_back(checksum(A));
+    }
+
+    // --- Scan ---
+    bench.minEpochIterations(10).timeUnit(1ms, "ms").title("Parallel inclusive scan").relative(true).warmup(5);
+
+    benchmark("std::inclusive_scan()", [&]() { std::inclusive_scan(data.begin(), data.end(), B.begin()); });
+    const double sum_std_scan = checksum(B);
+
+#ifdef BENCHMARK_STD_EXECUTION
+    benchmark("std::inclusive_scan(std::execution::par)",
+              [&]() { std::inclusive_scan(std::execution::par, data.begin(), data.end(), B.begin()); });
+    const double sum_std_par_scan = checksum(B);
+#endif
+
+    std::vector<double> sums_scan;
+    for (auto threads : thread_counts) {
+        parallel::set_thread_count(threads);
+        names.push_back("parallel::inclusive_scan() (" + std::to_string(threads) + " threads)");
+        benchmark(names.back().c_str(), [&]() { parallel::inclusive_scan(data, B.begin(), parallel::sum<>{}); });
+        sums_scan.push_back(checksum(B));
+    }
+
+    // --- Count ---
+    bench.minEpochIterations(10).timeUnit(1ms, "ms").title("Parallel count_if").relative(true).warmup(5);
+
+    const auto pred = [](double x) { return x < 0.3; };
+
+    std::size_t count_std = 0;
+    benchmark("std::count_if()", [&]() { count_std = std::count_if(data.begin(), data.end(), pred); });
+
+#ifdef BENCHMARK_STD_EXECUTION
+    std::size_t count_std_par = 0;
+    benchmark("std::count_if(std::execution::par)",
+              [&]() { count_std_par = std::count_if(std::execution::par, data.begin(), data.end(), pred); });
+#endif
+
+    std::vector<std::size_t> counts;
+    for (auto threads : thread_counts) {
+        parallel::set_thread_count(threads);
+        names.push_back("parallel::count_if() (" + std::to_string(threads) + " threads)");
+        std::size_t count = 0;
+        benchmark(names.back().c_str(), [&]() { count = parallel::count_if(data, pred); });
+        counts.push_back(count);
+    }
+
+    // --- Find ---
+    bench.minEpochIterations(10).timeUnit(1ms, "ms").title("Parallel find_if (match at 3/4)").relative(true).warmup(5);
+
+    const double needle     = 2.; // not present in data, gets placed manually
+    const auto   is_needle  = [&](double x) { return x == needle; };
+    const auto   needle_pos = N * 3 / 4;
+
+    std::vector<double> haystack = data;
+    haystack[needle_pos]         = needle;
+
+    std::size_t found_std = 0;
+    benchmark("std::find_if()", [&]() {
+        found_std = std::find_if(haystack.begin(), haystack.end(), is_needle) - haystack.begin();
+    });
+
+#ifdef BENCHMARK_STD_EXECUTION
+    std::size_t found_std_par = 0;
+    benchmark("std::find_if(std::execution::par)", [&]() {
+        const auto it = std::find_if(std::execution::par, haystack.begin(), haystack.end(), is_needle);
+        found_std_par = it - haystack.begin();
+    });
+#endif
+
+    std::vector<std::size_t> founds;
+    for (auto threads : thread_counts) {
+        parallel::set_thread_count(threads);
+        names.push_back("parallel::find_if() (" + std::to_string(threads) + " threads)");
+        std::size_t found = 0;
+        benchmark(names.back().c_str(),
+                  [&]() { found = parallel::find_if(haystack, is_needle) - haystack.begin(); });
+        founds.push_back(found);
+    }
+
+    // --- Partition ---
+    bench.minEpochIterations(5).timeUnit(1ms, "ms").title("Parallel partition").relative(true).warmup(2);
+
+    benchmark("std::stable_partition()", [&]() {
+        A = data;
+        std::stable_partition(A.begin(), A.end(), pred);
+    });
+    const double sum_std_partition = checksum(A);
+
+#ifdef BENCHMARK_STD_EXECUTION
+    benchmark("std::stable_partition(std::execution::par)", [&]() {
+        A = data;
+        std::stable_partition(std::execution::par, A.begin(), A.end(), pred);
+    });
+    const double sum_std_par_partition = checksum(A);
+#endif
+
+    std::vector<double> sums_partition;
+    for (auto threads : thread_counts) {
+        parallel::set_thread_count(threads);
+        names.push_back("parallel::partition() (" + std::to_string(threads) + " threads)");
+        benchmark(names.back().c_str(), [&]() {
+            A = data;
+            parallel::partition(A, pred);
+        });
+        sums_partition.push_back(checksum(A));
+    }
+
+    // Verify correctness
+    log::println();
+    table::hline();
+    table::cell("Method", "Control sum");
+    table::hline();
+    table::cell("std::sort()", sum_std_sort);
+#ifdef BENCHMARK_STD_EXECUTION
+    table::cell("std::sort(std::execution::par)", sum_std_par_sort);
+#endif
+    for (std::size_t i = 0; i < thread_counts.size(); ++i) table::cell(names[i], sums_sort[i]);
+    table::hline();
+    table::cell("std::inclusive_scan()", sum_std_scan);
+#ifdef BENCHMARK_STD_EXECUTION
+    table::cell("std::inclusive_scan(std::execution::par)", sum_std_par_scan);
+#endif
+    for (std::size_t i = 0; i < thread_counts.size(); ++i) table::cell(names[thread_counts.size() + i], sums_scan[i]);
+    table::hline();
+    table::cell("std::count_if()", count_std);
+#ifdef BENCHMARK_STD_EXECUTION
+    table::cell("std::count_if(std::execution::par)", count_std_par);
+#endif
+    for (std::size_t i = 0; i < thread_counts.size(); ++i) table::cell(names[2 * thread_counts.size() + i], counts[i]);
+    table::hline();
+    table::cell("std::find_if()", found_std);
+#ifdef BENCHMARK_STD_EXECUTION
+    table::cell("std::find_if(std::execution::par)", found_std_par);
+#endif
+    for (std::size_t i = 0; i < thread_counts.size(); ++i) table::cell(names[3 * thread_counts.size() + i], founds[i]);
+    table::hline();
+    table::cell("std::stable_partition()", sum_std_partition);
+#ifdef BENCHMARK_STD_EXECUTION
+    table::cell("std::stable_partition(std::execution::par)", sum_std_par_partition);
+#endif
+    for (std::size_t i = 0; i < thread_counts.size(); ++i)
+        table::cell(names[4 * thread_counts.size() + i], sums_partition[i]);
+    table::hline();
+}
+
+// Benchmark for: task dispatch latency under different idle policies
+//    t_submit = now(); pool.add_task([]{ t_start = now(); });
+//
+// Workers that block on a condition variable right away need a futex wake-up for every task submitted
+// to an idle pool, spinning & yielding workers pick new tasks up without being notified. We measure
+// submit-to-start latency of tasks submitted to an idle pool, and a round-trip of a tiny 'for_loop()'
+// which also includes waking up the submitting thread once the loop is done.
+//
+// Spinning needs workers to have cores of their own, on machines with fewer cores than 'thread_count + 1'
+// spinning policies are expected to lose to blocking.
+//
+// We use the number of measured samples to verify the result.
+//
+void benchmark_idle_policy() {
+    constexpr std::size_t samples      = 2'000;
+    constexpr auto        idle_gap     = 50us; // lets workers go idle before the next submission
+    constexpr std::size_t thread_count = 4;
+
+    log::println("\n\n====== BENCHMARKING ON: Task dispatch latency ======\n");
+    log::println("Threads           -> ", thread_count);
+    log::println("Samples           -> ", samples);
+    log::println("Idle gap          -> ", idle_gap.count(), " us");
+
+    using clock = std::chrono::steady_clock;
+
+    const std::pair<const char*, parallel::IdlePolicy> policies[] = {
+        {"Block (default)", parallel::IdlePolicy{}},
+        {"Hybrid (spin 2000, yield 100)", parallel::IdlePolicy{2'000, 100}},
+        {"Spin (spin 50000)", parallel::IdlePolicy{50'000, 0}},
+    };
+
+    parallel::set_thread_count(thread_count);
+
+    // Global benchmark options
+    bench.minEpochIterations(100).timeUnit(1us, "us").title("Tiny parallel for round-trip").relative(true).warmup(10);
+
+    // Tiny 'for_loop()', 1 task per thread, round-trip is dominated by waking up workers & the waiting thread
+    for (const auto& [name, policy] : policies) {
+        parallel::set_idle_policy(policy);
+
+        benchmark(name, [&]() {
+            parallel::for_loop(parallel::IndexRange<std::size_t>{0, thread_count, 1},
+                               [&](std::size_t low, std::size_t) { ankerl::nanobench::doNotOptimizeAway(low); });
+        });
+    }
+
+    // Submit-to-start latency, measured manually since nanobench can't time a single event across threads
+    log::println();
+    table::create({40, 20, 20, 20});
+    table::set_formats({table::DEFAULT(), table::DEFAULT(), table::FIXED(2), table::FIXED(2)});
+    table::hline();
+    table::cell("Idle policy", "Samples", "Median (us)", "P99 (us)");
+    table::hline();
+
+    for (const auto& [name, policy] : policies) {
+        parallel::set_idle_policy(policy);
+
+        std::vector<double> latencies;
+        std::atomic<bool>   started{false};
+        clock::time_point   start_time;
+
+        for (std::size_t i = 0; i < samples; ++i) {
+            const auto gap_end = clock::now() + idle_gap;
+            while (clock::now() < gap_end) std::this_thread::yield();
+
+            started                = false;
+            const auto submit_time = clock::now();
+            parallel::task([&] {
+                start_time = clock::now();
+                started.store(true, std::memory_order_release);
+            });
+            while (!started.load(std::memory_order_acquire)) std::this_thread::yield();
+
+            latencies.push_back(std::chrono::duration<double, std::micro>(start_time - submit_time).count());
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        table::cell(name, latencies.size(), latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100]);
+    }
+
+    parallel::set_idle_policy(parallel::IdlePolicy{});
+    parallel::wait_for_tasks();
+}
+
+// Benchmark for: matrix transposition
+//    B(j, i) = A(i, j)
+//
+// One of the matrices is always traversed against its layout, splitting the loop into row strips means each
+// task walks a whole column of 'B' per row of 'A' & touches a new cache line on every write. 2D tiles keep both
+// the read & write working sets in cache, Morton traversal additionally keeps consecutive tiles of a task close.
+//
+// We use weighted control sum to verify the result.
+//
+void benchmark_tiled_for_loop() {
+    constexpr std::size_t N            = 2048;
+    constexpr std::size_t thread_count = 4;
+
+    log::println("\n\n====== BENCHMARKING ON: Tiled parallel for (matrix transposition) ======\n");
+    log::println("Threads           -> ", thread_count);
+    log::println("N                 -> ", N);
+    log::println("Data memory usage -> ", math::to_memory_units(N * N * 2 * sizeof(double)), " MiB");
+
+    mvl::Matrix<double> A(N, N);
+    mvl::Matrix<double> B(N, N);
+    for (std::size_t i = 0; i < N; ++i)
+        for (std::size_t j = 0; j < N; ++j) A(i, j) = static_cast<double>((i * 7 + j * 3) % 101);
+
+    const auto control_sum = [&] {
+        double sum = 0;
+        for (std::size_t i = 0; i < N; ++i)
+            for (std::size_t j = 0; j < N; ++j) sum += B(i, j) * static_cast<double>((i + 2 * j) % 7);
+        return sum;
+    };
+
+    const auto transpose_block = [&](std::size_t i_low, std::size_t i_high, std::size_t j_low, std::size_t j_high) {
+        for (std::size_t i = i_low; i < i_high; ++i)
+            for (std::size_t j = j_low; j < j_high; ++j) B(j, i) = A(i, j);
+    };
+
+    // Global benchmark options
+    bench.minEpochIterations(10).timeUnit(1ms, "ms").title("Tiled parallel for").relative(true).warmup(10);
+
+    // Serial benchmark (reference)
+    benchmark("Serial version", [&]() { transpose_block(0, N, 0, N); });
+    const double sum_serial = control_sum();
+
+    // OpenMP row strips
+#ifdef _OPENMP
+    omp_set_num_threads(thread_count);
+    benchmark("OpenMP parallel for (row strips)", [&]() {
+#pragma omp parallel for
+        for (std::size_t i = 0; i < N; ++i) transpose_block(i, i + 1, 0, N);
+    });
+    const double sum_omp = control_sum();
+#endif
+
+    // parallel::for_loop() over rows
+    parallel::set_thread_count(thread_count);
+    benchmark("parallel::for_loop() (row strips)", [&]() {
+        parallel::for_loop(parallel::IndexRange<std::size_t>{0, N},
+                           [&](std::size_t low, std::size_t high) { transpose_block(low, high, 0, N); });
+    });
+    const double sum_strips = control_sum();
+
+    // parallel::for_loop() over 2D tiles
+    benchmark("parallel::for_loop() (2D tiles)",
+              [&]() { parallel::for_loop(parallel::IndexRange2D{A}, transpose_block); });
+    const double sum_tiles = control_sum();
+
+    // parallel::for_loop() over 2D tiles in Morton order
+    benchmark("parallel::for_loop() (2D tiles, Morton order)", [&]() {
+        parallel::for_loop(parallel::IndexRange2D{A, parallel::Traversal::MORTON}, transpose_block);
+    });
+    const double sum_morton = control_sum();
+
+    // Verify correctness
+    log::println();
+    table::create({60, 20});
+    table::set_formats({table::DEFAULT(), table::FIXED(2)});
+    table::hline();
+    table::cell("Method", "Control sum");
+    table::hline();
+    table::cell("Serial", sum_serial);
+#ifdef _OPENMP
+    table::cell("OpenMP parallel for (row strips)", sum_omp);
+#endif
+    table::cell("parallel::for_loop() (row strips)", sum_strips);
+    table::cell("parallel::for_loop() (2D tiles)", sum_tiles);
+    table::cell("parallel::for_loop() (2D tiles, Morton order)", sum_morton);
+}
+
+// Benchmark for: submission of tiny tasks
+//    for (tasks) pool.add_task(tiny_task);
+//
+// Submission overhead dominates with tasks this small, a large part of which used to be heap allocations
+// of 'std::packaged_task<>' shared states. We count allocations performed by each method, tasks stored
+// inline by the small-buffer task wrapper shouldn't allocate at all.
+//
+// We use the number of executed tasks to verify the result.
+//
+void benchmark_task_submission() {
+    constexpr std::size_t task_count   = 100'000;
+    constexpr std::size_t batch_size   = 100; // should divide 'task_count'
+    constexpr std::size_t thread_count = 4;
+
+    log::println("\n\n====== BENCHMARKING ON: Tiny task submission ======\n");
+    log::println("Threads           -> ", thread_count);
+    log::println("Tasks             -> ", task_count);
+    log::println("Future batch size -> ", batch_size);
+
+    parallel::ThreadPool pool(thread_count);
+
+    std::atomic<std::size_t> executed{0};
+    const auto               tiny_task = [&](std::size_t x) { executed.fetch_add(x, std::memory_order_relaxed); };
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(batch_size);
+
+    // Global benchmark options
+    bench.minEpochIterations(10).timeUnit(1ms, "ms").title("Tiny task submission").relative(true).warmup(10);
+
+    // Measures allocations of a single run separately, so benchmark iterations don't affect the count
+    const auto measure = [&](const char* name, auto&& run) {
+        benchmark(name, run);
+
+        executed               = 0;
+        const std::size_t before = allocation_count;
+        run();
+        const std::size_t after  = allocation_count;
+
+        return std::pair{executed.load(), static_cast<double>(after - before) / task_count};
+    };
+
+    // Type-erased task per submission, the way the pool used to store tasks
+    const auto [executed_packaged, allocs_packaged] = measure("ThreadPool::add_task(std::packaged_task<>)", [&] {
+        for (std::size_t i = 0; i < task_count; ++i) pool.add_task(std::packaged_task<void()>(std::bind(tiny_task, 1)));
+        pool.wait_for_tasks();
+    });
+
+    // Fire-and-forget tasks
+    const auto [executed_add_task, allocs_add_task] = measure("ThreadPool::add_task()", [&] {
+        for (std::size_t i = 0; i < task_count; ++i) pool.add_task(tiny_task, 1);
+        pool.wait_for_tasks();
+    });
+
+    // Tasks with futures, waited on in batches the way fork-join code usually does it
+    const auto [executed_future, allocs_future] = measure("ThreadPool::add_task_with_future()", [&] {
+        for (std::size_t i = 0; i < task_count; i += batch_size) {
+            for (std::size_t j = 0; j < batch_size; ++j) futures.push_back(pool.add_task_with_future(tiny_task, 1));
+            for (auto& future : futures) future.wait();
+            futures.clear();
+        }
+    });
+
+    // Verify correctness
+    log::println();
+    table::create({50, 20, 20});
+    table::set_formats({table::DEFAULT(), table::DEFAULT(), table::FIXED(2)});
+    table::hline();
+    table::cell("Method", "Executed tasks", "Allocations / task");
+    table::hline();
+    table::cell("ThreadPool::add_task(std::packaged_task<>)", executed_packaged, allocs_packaged);
+    table::cell("ThreadPool::add_task()", executed_add_task, allocs_add_task);
+    table::cell("ThreadPool::add_task_with_future()", executed_future, allocs_future);
+}
+
 int main() {
     benchmark_sum();
+    benchmark_dot_product();
+    benchmark_fine_grained_for_loop();
+    benchmark_skewed_for_loop();
+    benchmark_tiled_for_loop();
+    benchmark_recursive_tasks();
+    benchmark_task_submission();
+    benchmark_idle_policy();
+    benchmark_algorithms();
     //benchmark_matrix_multiplication();
 }
\ No newline at end of file
@@ -18,30 +18,55 @@
 #include <charconv>         // to_chars(), from_chars()
 #include <climits>          // CHAR_BIT
 #include <cmath>            // isfinite()
-#include <cstddef>          // size_t
-#include <cstdint>          // uint8_t, uint16_t, uint32_t
+#include <cstddef>          // size_t, ptrdiff_t, offsetof()
+#include <cstdio>           // FILE, fwrite()
+#include <cstdint>          // uint8_t, uint16_t, uint32_t, uintptr_t
+#include <cstring>          // memcpy()
+#include <exception>        // exception_ptr, current_exception(), rethrow_exception()
 #include <filesystem>       // create_directories()
 #include <fstream>          // ifstream, ofstream
+#include <functional>       // less<>, hash<>
 #include <initializer_list> // initializer_list<>
+#include <iterator>         // random_access_iterator_tag
 #include <limits>           // numeric_limits<>::max_digits10, numeric_limits<>::max_exponent10
 #include <map>              // map<>
+#include <memory>           // unique_ptr<>, allocator<>, allocator_traits<>
+#include <new>              // bad_array_new_length
+#include <ostream>          // ostream
 #include <stdexcept>        // runtime_error
 #include <string>           // string
 #include <string_view>      // string_view
 #include <system_error>     // errc
-#include <type_traits>      // enable_if<>, void_t, is_convertible<>, is_same<>,
-                            // conjunction<>, disjunction<>, negation<>
-#include <utility>          // move(), declval<>()
+#include <tuple>            // tie(), forward_as_tuple()
+#include <type_traits>      // enable_if<>, void_t, is_convertible<>, is_same<>, remove_cv_t<>,
+                            // is_lvalue_reference<>, conjunction<>, disjunction<>, negation<>
+#include <utility>          // move(), declval<>(), exchange()
 #include <variant>          // variant<>
 #include <vector>           // vector<>
 
+// SIMD scanning is selected at compile time based on the target architecture, modules are self-contained
+// so we detect it here rather than through 'utl::predef'. Defining 'UTL_JSON_DISABLE_SIMD' forces scalar code.
+#if !defined(UTL_JSON_DISABLE_SIMD) && defined(__AVX2__)
+#define utl_json_simd_avx2
+#include <immintrin.h> // _mm256_...()
+#elif !defined(UTL_JSON_DISABLE_SIMD) &&                                                                               \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define utl_json_simd_sse2
+#include <emmintrin.h> // _mm_...()
+#endif
+
+#if defined(_MSC_VER) && (defined(utl_json_simd_avx2) || defined(utl_json_simd_sse2))
+#include <intrin.h> // _BitScanForward()
+#endif
+
 // ____________________ DEVELOPER DOCS ____________________
 
-// Reasonably simple (if we discount reflection) parser / serializer, doesn't use any intrinsics or compiler-specific
-// stuff. Unlike some other implementations, doesn't include the tokenizing step - we parse everything in a single 1D
-// scan over the data, constructing recursive JSON struct on the fly. The main reason we can do this so easily is
-// due to a nice quirk of JSON: when parsing nodes, we can always determine node type based on a single first
-// character, see '_parser::parse_node()'.
+// Reasonably simple (if we discount reflection) parser / serializer, the only intrinsics used are optional SSE2 / AVX2
+// fast paths for skipping whitespace & scanning strings. Unlike some other implementations, doesn't include the
+// tokenizing step - we parse everything in a single 1D scan over the data, reporting it as SAX events that get
+// turned into a recursive JSON struct on the fly. The main reason we can do this so easily is due to a nice quirk
+// of JSON: when parsing nodes, we can always determine node type based on a single first character,
+// see '_sax_parser::parse_node()'.
 //
 // Struct reflection is implemented through macros - alternative way would be to use templates with __PRETTY_FUNCTION__
 // (or __FUNCSIG__) and do some constexpr string parsing to perform "magic" reflection without requiring macros, but
@@ -80,7 +105,8 @@ namespace utl::json {
 // (each letter in a codepoint is a hex corresponding to 4 bits, 6 positions => 24 bits of info).
 // In terms of C++ 'U+ABCDEF' codepoints can be expressed as an integer hex-literal '0xABCDEF'.
 //
-inline bool _codepoint_to_utf8(std::string& destination, std::uint32_t cp) {
+template <class String>
+bool _codepoint_to_utf8(String& destination, std::uint32_t cp) {
     // returns success so we can handle the error message inside the parser itself.
 
     std::array<char, 4> buffer;
@@ -159,7 +185,7 @@ template <class T>
     return num < 10 ? 1 : 1 + _log_10_ceil(num / 10);
 }
 
-[[nodiscard]] inline std::string _pretty_error(std::size_t cursor, const std::string& chars) {
+[[nodiscard]] inline std::string _pretty_error(std::size_t cursor, std::string_view chars) {
     // Special case for empty buffers
     if (chars.empty()) return "";
 
@@ -232,6 +258,8 @@ utl_json_define_trait(_has_input_it, std::next(std::declval<T>().begin()));
 utl_json_define_trait(_has_key_type, std::declval<typename std::decay_t<T>::key_type>());
 utl_json_define_trait(_has_mapped_type, std::declval<typename std::decay_t<T>::mapped_type>());
 
+utl_json_define_trait(_has_reserve, std::declval<std::decay_t<T>&>().reserve(std::size_t{}));
+
 #undef utl_json_define_trait
 
 // Workaround for 'static_assert(false)' making program ill-formed even
@@ -281,12 +309,17 @@ constexpr bool _always_false_v = false;
 // --- JSON type conversion traits ---
 // ===================================
 
-template <class T>
-using _object_type_impl = std::map<std::string, T, std::less<>>;
+template <class T, class Allocator>
+using _rebind_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+template <class Allocator>
+using _string_type_impl = std::basic_string<char, std::char_traits<char>, _rebind_alloc<char, Allocator>>;
+template <class T, class Allocator>
+using _object_type_impl = std::map<_string_type_impl<Allocator>, T, std::less<>,
+                                   _rebind_alloc<std::pair<const _string_type_impl<Allocator>, T>, Allocator>>;
 // 'std::less<>' makes map transparent, which means we can use 'find()' for 'std::string_view' keys
-template <class T>
-using _array_type_impl  = std::vector<T>;
-using _string_type_impl = std::string;
+template <class T, class Allocator>
+using _array_type_impl  = std::vector<T, _rebind_alloc<T, Allocator>>;
 using _number_type_impl = double;
 using _bool_type_impl   = bool;
 struct _null_type_impl {
@@ -311,9 +344,8 @@ struct _null_type_impl {
 // The same cannot be said about 'std::unordered_map', which is why we don't use it.
 //
 // We could make a more pedantic choice and add a redundant level of indirection, but that both complicates
-// implementation needlessly and reduces performance. A perfect solution would be to write our own map implementation
-// tailored for JSON use cases and providing explicit support for heterogeneous lookup and incomplete types, but that
-// alone would be grander in scale than this entire parser for a mostly non-critical benefit.
+// implementation needlessly and reduces performance. Alternatively, there is a custom flat object implementation
+// with explicit support for heterogeneous lookup and incomplete types, see '_flat_object'.
 
 struct _dummy_type {};
 
@@ -394,20 +426,443 @@ utl_json_type_trait_conjunction(
 #undef utl_json_type_trait_conjunction
 #undef utl_json_type_trait_disjunction
 
+// ========================
+// --- Arena allocation ---
+// ========================
+
+// Minimal monotonic arena, hands out memory from large blocks that only get freed all at once.
+//
+// Parsing a large JSON into regular nodes ends up doing millions of small allocations (map nodes, vector buffers,
+// strings), which are just as expensive to free. Placing the whole tree into an arena turns all of those into
+// pointer bumps and makes deallocation a no-op, freeing the memory is then done by destroying the arena.
+//
+// Blocks grow geometrically up to a limit, this keeps small parses cheap without
+// making large parses do too many block allocations.
+class Arena {
+    constexpr static std::size_t min_block_size = 4096;
+    constexpr static std::size_t max_block_size = 1024 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char*                                block_cursor    = nullptr;
+    std::size_t                          block_remaining = 0;
+    std::size_t                          next_block_size = min_block_size;
+
+    void grow(std::size_t min_size) {
+        const std::size_t new_block_size = (min_size > this->next_block_size) ? min_size : this->next_block_size;
+        this->blocks.emplace_back(new char[new_block_size]);
+        // 'std::make_unique<char[]>()' would value-initialize the whole block, which is wasted work here
+        this->block_cursor    = this->blocks.back().get();
+        this->block_remaining = new_block_size;
+        if (this->next_block_size < max_block_size) this->next_block_size *= 2;
+    }
+
+    [[nodiscard]] static std::size_t padding_for(const char* ptr, std::size_t alignment) noexcept {
+        return (alignment - reinterpret_cast<std::uintptr_t>(ptr) % alignment) % alignment;
+    }
+
+public:
+    Arena()             = default;
+    Arena(const Arena&) = delete;
+
+    // Moved-from arena gets reset to the empty state, otherwise its cursor would keep
+    // pointing into a block that now belongs to the other arena
+    Arena(Arena&& other) noexcept
+        : blocks(std::move(other.blocks)), block_cursor(std::exchange(other.block_cursor, nullptr)),
+          block_remaining(std::exchange(other.block_remaining, 0)),
+          next_block_size(std::exchange(other.next_block_size, min_block_size)) {
+        other.blocks.clear();
+    }
+
+    Arena& operator=(const Arena&) = delete;
+
+    Arena& operator=(Arena&& other) noexcept {
+        if (this == &other) return *this;
+        this->blocks          = std::move(other.blocks);
+        this->block_cursor    = std::exchange(other.block_cursor, nullptr);
+        this->block_remaining = std::exchange(other.block_remaining, 0);
+        this->next_block_size = std::exchange(other.next_block_size, min_block_size);
+        other.blocks.clear();
+        return *this;
+    }
+
+    [[nodiscard]] void* allocate(std::size_t size, std::size_t alignment) {
+        // Block starts are aligned by 'new', we only need to pad the cursor, reserving
+        // 'size + alignment' on growth guarantees that padded allocation fits into the new block
+        std::size_t padding = padding_for(this->block_cursor, alignment);
+
+        if (size + padding > this->block_remaining) {
+            this->grow(size + alignment);
+            padding = padding_for(this->block_cursor, alignment);
+        }
+
+        char* const ptr = this->block_cursor + padding;
+        this->block_cursor += size + padding;
+        this->block_remaining -= size + padding;
+        return ptr;
+    }
+
+    [[nodiscard]] std::string_view store(std::string_view str) {
+        if (str.empty()) return {};
+        char* const ptr = static_cast<char*>(this->allocate(str.size(), 1));
+        std::memcpy(ptr, str.data(), str.size());
+        return {ptr, str.size()};
+    }
+
+    void release() noexcept {
+        this->blocks.clear();
+        this->block_cursor    = nullptr;
+        this->block_remaining = 0;
+        this->next_block_size = min_block_size;
+    }
+};
+
+// Stateful allocator adapter over 'Arena'. Default-constructed allocator falls back onto the regular heap,
+// this is necessary since nodes can create containers on their own (for example, 'null' node turning into an
+// object on 'operator[]'), such containers don't know about the arena and behave like they would normally.
+// The same applies to keys & strings created by 'operator[]' / assignment, only the parser passes the arena
+// along, so 'ArenaNode' trees are fully arena-allocated only as produced by 'from_string(chars, arena)'.
+template <class T>
+class ArenaAllocator {
+    Arena* arena = nullptr;
+
+    template <class>
+    friend class ArenaAllocator;
+
+public:
+    using value_type                             = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type;
+    // propagating on move is what makes moving arena-allocated nodes around as cheap as moving regular ones
+
+    ArenaAllocator() noexcept = default;
+    ArenaAllocator(Arena& arena) noexcept : arena(&arena) {}
+
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.arena) {}
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+        if (!this->arena) return std::allocator<T>{}.allocate(n);
+        if (n > std::size_t(-1) / sizeof(T)) throw std::bad_array_new_length{};
+        return static_cast<T*>(this->arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        if (!this->arena) std::allocator<T>{}.deallocate(ptr, n);
+        // arena memory is only freed all at once
+    }
+
+    template <class U>
+    [[nodiscard]] bool operator==(const ArenaAllocator<U>& other) const noexcept {
+        return this->arena == other.arena;
+    }
+
+    template <class U>
+    [[nodiscard]] bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+        return this->arena != other.arena;
+    }
+};
+
+// ===================
+// --- Flat object ---
+// ===================
+
+// Insertion-ordered object stored as a flat vector of key-value pairs, alternative to 'std::map<>'.
+//
+// Most objects in real JSONs have somewhere around 5-30 keys. For such sizes a red-black tree is a rather poor fit,
+// every key costs a separate node allocation and lookup has to chase pointers all over the memory. A flat vector
+// needs a single allocation and keeps all of the keys next to each other, which makes both parsing & iteration
+// a lot cheaper and keeps small lookups fast even with a linear search.
+//
+// Linear search obviously doesn't scale, once the object grows past 'linear_search_limit' we start maintaining
+// an open-addressing hash index over the vector (which stores positions of the pairs). The index stays at
+// load factor <= 0.5 and gets rebuilt on growth, which keeps both insertion & lookup amortized O(1).
+//
+// Differences from 'std::map<>':
+//    - Iteration (and serialization) follows insertion order rather than the sorted order of keys
+//    - Pairs are stored as 'std::pair<Key, T>' (so the vector can relocate them cheaply), iterators dereference
+//      to 'std::pair<const Key&, T&>' proxies which keep keys read-only since modifying them would invalidate
+//      the index. Range-for should bind pairs with 'const auto&' / 'auto&&' / 'auto' rather than 'auto&'
+//    - Insertion invalidates iterators & references (same as with 'std::vector<>')
+//    - Erasure is O(N)
+//
+// Since the storage is a 'std::vector<>' this type can be instantiated with incomplete 'T',
+// which is exactly what we need for recursive nodes.
+template <class Key, class T, class Allocator>
+class _flat_object {
+    using stored_type    = std::pair<Key, T>;
+    using container_type = std::vector<stored_type, _rebind_alloc<stored_type, Allocator>>;
+
+    // Thin wrapper over the vector iterator, exposes pairs with a const key
+    template <bool is_const>
+    class basic_iterator {
+        using base_type = std::conditional_t<is_const, typename container_type::const_iterator,
+                                             typename container_type::iterator>;
+        base_type it{};
+
+        friend class _flat_object;
+        template <bool>
+        friend class basic_iterator;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = std::pair<const Key, T>;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = std::pair<const Key&, std::conditional_t<is_const, const T&, T&>>;
+
+        struct pointer {
+            reference                      ref;
+            [[nodiscard]] const reference* operator->() const noexcept { return &this->ref; }
+        };
+
+        basic_iterator() = default;
+        explicit basic_iterator(base_type it) noexcept : it(it) {}
+
+        template <bool other_is_const, std::enable_if_t<is_const && !other_is_const, bool> = true>
+        basic_iterator(const basic_iterator<other_is_const>& other) noexcept : it(other.it) {}
+
+        [[nodiscard]] reference operator*() const noexcept { return {this->it->first, this->it->second}; }
+        [[nodiscard]] pointer   operator->() const noexcept { return {**this}; }
+        [[nodiscard]] reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+        basic_iterator& operator++() noexcept {
+            ++this->it;
+            return *this;
+        }
+        basic_iterator& operator--() noexcept {
+            --this->it;
+            return *this;
+        }
+        basic_iterator  operator++(int) noexcept { return basic_iterator(this->it++); }
+        basic_iterator  operator--(int) noexcept { return basic_iterator(this->it--); }
+        basic_iterator& operator+=(difference_type n) noexcept {
+            this->it += n;
+            return *this;
+        }
+        basic_iterator& operator-=(difference_type n) noexcept {
+            this->it -= n;
+            return *this;
+        }
+
+        friend basic_iterator  operator+(basic_iterator iter, difference_type n) noexcept { return iter += n; }
+        friend basic_iterator  operator+(difference_type n, basic_iterator iter) noexcept { return iter += n; }
+        friend basic_iterator  operator-(basic_iterator iter, difference_type n) noexcept { return iter -= n; }
+        friend difference_type operator-(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return lhs.it - rhs.it;
+        }
+
+        friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return lhs.it == rhs.it;
+        }
+        friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return lhs.it != rhs.it;
+        }
+        friend bool operator<(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return lhs.it < rhs.it;
+        }
+        friend bool operator>(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return lhs.it > rhs.it;
+        }
+        friend bool operator<=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return lhs.it <= rhs.it;
+        }
+        friend bool operator>=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return lhs.it >= rhs.it;
+        }
+    };
+
+public:
+    using key_type       = Key;
+    using mapped_type    = T;
+    using value_type     = std::pair<const Key, T>;
+    using allocator_type = typename container_type::allocator_type;
+    using size_type      = std::size_t;
+    using iterator       = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+private:
+    using index_allocator_type = _rebind_alloc<std::size_t, Allocator>;
+    using index_type           = std::vector<std::size_t, index_allocator_type>;
+
+    constexpr static std::size_t linear_search_limit = 8;
+    constexpr static std::size_t min_index_size      = 32;
+    constexpr static std::size_t empty_slot          = 0;
+    // index stores 'pos + 1' so that zero-initialized slots are empty
+
+    container_type pairs;
+    index_type     index; // empty while objects are small
+
+    [[nodiscard]] static std::size_t hash(std::string_view key) noexcept { return std::hash<std::string_view>{}(key); }
+
+    [[nodiscard]] std::size_t find_pos(std::string_view key) const noexcept {
+        if (this->index.empty()) {
+            for (std::size_t pos = 0; pos < this->pairs.size(); ++pos)
+                if (std::string_view(this->pairs[pos].first) == key) return pos;
+            return this->pairs.size();
+        }
+
+        const std::size_t mask = this->index.size() - 1;
+        for (std::size_t i = hash(key) & mask; this->index[i] != empty_slot; i = (i + 1) & mask) {
+            const std::size_t pos = this->index[i] - 1;
+            if (std::string_view(this->pairs[pos].first) == key) return pos;
+        }
+        return this->pairs.size();
+    }
+
+    void index_insert(std::size_t pos) noexcept {
+        const std::size_t mask = this->index.size() - 1;
+        std::size_t       i    = hash(this->pairs[pos].first) & mask;
+        while (this->index[i] != empty_slot) i = (i + 1) & mask; // linear probing
+        this->index[i] = pos + 1;
+    }
+
+    void rebuild_index() {
+        if (this->pairs.size() <= linear_search_limit) {
+            this->index.clear();
+            return;
+        }
+
+        std::size_t size = min_index_size;
+        while (size < 2 * this->pairs.size()) size *= 2; // keeps load factor <= 0.5
+
+        this->index.assign(size, empty_slot);
+        for (std::size_t pos = 0; pos < this->pairs.size(); ++pos) this->index_insert(pos);
+    }
+
+    void on_push_back() {
+        // doubling index size on rebuild makes insertion amortized O(1), same as with the vector itself
+        if (this->pairs.size() <= linear_search_limit) return;
+        if (2 * this->pairs.size() > this->index.size()) this->rebuild_index();
+        else this->index_insert(this->pairs.size() - 1);
+    }
+
+public:
+    _flat_object() = default;
+    explicit _flat_object(const allocator_type& allocator)
+        : pairs(allocator), index(index_allocator_type(allocator)) {}
+
+    _flat_object(std::initializer_list<value_type> ilist, const allocator_type& allocator = allocator_type())
+        : _flat_object(allocator) {
+        this->reserve(ilist.size());
+        // first duplicate wins, same as 'std::map'
+        for (const auto& [key, value] : ilist) this->try_emplace(key, value);
+    }
+
+    // - Iterators -
+    [[nodiscard]] iterator       begin() noexcept { return iterator(this->pairs.begin()); }
+    [[nodiscard]] iterator       end() noexcept { return iterator(this->pairs.end()); }
+    [[nodiscard]] const_iterator begin() const noexcept { return const_iterator(this->pairs.begin()); }
+    [[nodiscard]] const_iterator end() const noexcept { return const_iterator(this->pairs.end()); }
+    [[nodiscard]] const_iterator cbegin() const noexcept { return const_iterator(this->pairs.cbegin()); }
+    [[nodiscard]] const_iterator cend() const noexcept { return const_iterator(this->pairs.cend()); }
+
+    // - Capacity -
+    [[nodiscard]] bool      empty() const noexcept { return this->pairs.empty(); }
+    [[nodiscard]] size_type size() const noexcept { return this->pairs.size(); }
+
+    void reserve(size_type size) { this->pairs.reserve(size); }
+
+    // - Lookup -
+    [[nodiscard]] iterator       find(std::string_view key) { return this->begin() + this->find_pos(key); }
+    [[nodiscard]] const_iterator find(std::string_view key) const { return this->begin() + this->find_pos(key); }
+
+    [[nodiscard]] size_type count(std::string_view key) const { return this->find_pos(key) != this->size(); }
+    [[nodiscard]] bool      contains(std::string_view key) const { return this->count(key); }
+
+    [[nodiscard]] T& at(std::string_view key) {
+        const std::size_t pos = this->find_pos(key);
+        if (pos == this->size()) throw std::out_of_range("_flat_object::at()");
+        return this->pairs[pos].second;
+    }
+
+    [[nodiscard]] const T& at(std::string_view key) const {
+        const std::size_t pos = this->find_pos(key);
+        if (pos == this->size()) throw std::out_of_range("_flat_object::at()");
+        return this->pairs[pos].second;
+    }
+
+    // - Modifiers -
+    template <class K, class... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        const std::size_t pos = this->find_pos(key);
+        if (pos != this->size()) return {this->begin() + pos, false};
+
+        this->pairs.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                                 std::forward_as_tuple(std::forward<Args>(args)...));
+        this->on_push_back();
+        return {this->end() - 1, true};
+    }
+
+    template <class K, class V>
+    std::pair<iterator, bool> emplace(K&& key, V&& value) {
+        return this->try_emplace(std::forward<K>(key), std::forward<V>(value));
+    }
+
+    iterator erase(const_iterator it) {
+        const auto res = this->pairs.erase(it.it);
+        this->rebuild_index(); // positions of all following pairs have shifted
+        return iterator(res);
+    }
+
+    size_type erase(std::string_view key) {
+        const std::size_t pos = this->find_pos(key);
+        if (pos == this->size()) return 0;
+        this->erase(this->cbegin() + pos);
+        return 1;
+    }
+
+    void clear() noexcept {
+        this->pairs.clear();
+        this->index.clear();
+    }
+};
+
+// --- Object backends ---
+// -----------------------
+
+// 'BasicNode' takes object backend as a template parameter, this allows selecting object representation at compile
+// time while keeping exactly the same node API. Default backend can be switched to the flat one by defining
+// 'UTL_JSON_FLAT_OBJECT' before including the header, both backends can also be used side-by-side
+// through 'Node' and 'FlatNode' typedefs.
+
+struct MapObjectBackend {
+    template <class T, class Allocator>
+    using type = _object_type_impl<T, Allocator>;
+};
+
+struct FlatObjectBackend {
+    template <class T, class Allocator>
+    using type = _flat_object<_string_type_impl<Allocator>, T, Allocator>;
+};
+
+#ifdef UTL_JSON_FLAT_OBJECT
+using _default_object_backend = FlatObjectBackend;
+#else
+using _default_object_backend = MapObjectBackend;
+#endif
+
 // ==================
 // --- Node class ---
 // ==================
 
 enum class Format : std::uint8_t { PRETTY, MINIMIZED };
 
-class Node;
-inline void _serialize_json_to_buffer(std::string& chars, const Node& node, Format format);
+template <class NodeType>
+void _serialize_json_to_buffer(std::string& chars, const NodeType& node, Format format);
 
-class Node {
+template <class NodeType, class Callback>
+void _serialize_json_to_callback(Callback& callback, const NodeType& node, Format format);
+
+// BasicNode is templated on the allocator used by its containers, which allows parsed trees to be placed into an arena,
+// see 'ArenaNode'. Regular 'BasicNode' uses 'std::allocator<>' and that's what all of the API defaults to.
+// Object representation is selected by 'ObjectBackend', see 'FlatNode'.
+template <class Allocator, class ObjectBackend = _default_object_backend>
+class BasicNode {
 public:
-    using object_type = _object_type_impl<Node>;
-    using array_type  = _array_type_impl<Node>;
-    using string_type = _string_type_impl;
+    using object_type = typename ObjectBackend::template type<BasicNode, Allocator>;
+    using array_type  = _array_type_impl<BasicNode, Allocator>;
+    using string_type = _string_type_impl<Allocator>;
     using number_type = _number_type_impl;
     using bool_type   = _bool_type_impl;
     using null_type   = _null_type_impl;
@@ -471,17 +926,17 @@ class Node {
     // -- Object methods ---
     // ---------------------
 
-    Node& operator[](std::string_view key) {
+    BasicNode& operator[](std::string_view key) {
         // 'std::map<K, V>::operator[]()' and 'std::map<K, V>::at()' don't support
         // support heterogeneous lookup, we have to reimplement them manually
         if (this->is_null()) this->data = object_type{}; // 'null' converts to objects automatically
         auto& object = this->get_object();
         auto  it     = object.find(key);
-        if (it == object.end()) it = object.emplace(key, Node{}).first;
+        if (it == object.end()) it = object.emplace(key, BasicNode{}).first;
         return it->second;
     }
 
-    [[nodiscard]] const Node& operator[](std::string_view key) const {
+    [[nodiscard]] const BasicNode& operator[](std::string_view key) const {
         // 'std::map<K, V>::operator[]()' and 'std::map<K, V>::at()' don't support
         // support heterogeneous lookup, we have to reimplement them manually
         const auto& object = this->get_object();
@@ -491,7 +946,7 @@ class Node {
         return it->second;
     }
 
-    [[nodiscard]] Node& at(std::string_view key) {
+    [[nodiscard]] BasicNode& at(std::string_view key) {
         // Non-const 'operator[]' inserts non-existent keys, '.at()' should throw instead
         auto&      object = this->get_object();
         const auto it     = object.find(key);
@@ -500,19 +955,19 @@ class Node {
         return it->second;
     }
 
-    [[nodiscard]] const Node& at(std::string_view key) const { return this->operator[](key); }
+    [[nodiscard]] const BasicNode& at(std::string_view key) const { return this->operator[](key); }
 
     [[nodiscard]] bool contains(std::string_view key) const {
         const auto& object = this->get_object();
-        const auto  it     = object.find(std::string(key));
+        const auto  it     = object.find(key);
         return it != object.end();
     }
 
     template <class T>
     [[nodiscard]] const T& value_or(std::string_view key, const T& else_value) {
         const auto& object = this->get_object();
-        const auto  it     = object.find(std::string(key));
-        if (it != object.end()) return it->second.get<T>();
+        const auto  it     = object.find(key);
+        if (it != object.end()) return it->second.template get<T>();
         return else_value;
         // same thing as 'this->contains(key) ? json.at(key).get<T>() : else_value' but without a second map lookup
     }
@@ -520,20 +975,20 @@ class Node {
     // -- Array methods ---
     // --------------------
 
-    [[nodiscard]] Node& operator[](std::size_t pos) { return this->get_array()[pos]; }
+    [[nodiscard]] BasicNode& operator[](std::size_t pos) { return this->get_array()[pos]; }
 
-    [[nodiscard]] const Node& operator[](std::size_t pos) const { return this->get_array()[pos]; }
+    [[nodiscard]] const BasicNode& operator[](std::size_t pos) const { return this->get_array()[pos]; }
 
-    [[nodiscard]] Node& at(std::size_t pos) { return this->get_array().at(pos); }
+    [[nodiscard]] BasicNode& at(std::size_t pos) { return this->get_array().at(pos); }
 
-    [[nodiscard]] const Node& at(std::size_t pos) const { return this->get_array().at(pos); }
+    [[nodiscard]] const BasicNode& at(std::size_t pos) const { return this->get_array().at(pos); }
 
-    void push_back(const Node& node) {
+    void push_back(const BasicNode& node) {
         if (this->is_null()) this->data = array_type{}; // 'null' converts to arrays automatically
         this->get_array().push_back(node);
     }
 
-    void push_back(Node&& node) {
+    void push_back(BasicNode&& node) {
         if (this->is_null()) this->data = array_type{}; // 'null' converts to arrays automatically
         this->get_array().push_back(node);
     }
@@ -542,12 +997,12 @@ class Node {
     // ----------------
 
     // Converting assignment
-    template <class T, std::enable_if_t<!std::is_same_v<std::decay_t<T>, Node> &&
+    template <class T, std::enable_if_t<!std::is_same_v<std::decay_t<T>, BasicNode> &&
                                             !std::is_same_v<std::decay_t<T>, object_type> &&
                                             !std::is_same_v<std::decay_t<T>, array_type> &&
                                             !std::is_same_v<std::decay_t<T>, string_type> && is_json_convertible_v<T>,
                                         bool> = true>
-    Node& operator=(const T& value) {
+    BasicNode& operator=(const T& value) {
         // Don't take types that decay to Node/object/array/string to prevent
         // shadowing native copy/move assignment for those types
 
@@ -556,21 +1011,22 @@ class Node {
         // string > object > array > bool > null > numeric
 
         if constexpr (is_string_like_v<T>) {
-            this->data.emplace<string_type>(value);
+            this->data.template emplace<string_type>(value);
         } else if constexpr (is_object_like_v<T>) {
-            this->data.emplace<object_type>();
-            auto& object = this->get_object();
-            for (const auto& [key, val] : value) object[key] = val;
+            this->data.template emplace<object_type>();
+            for (const auto& [key, val] : value) (*this)[std::string_view(key)] = val;
+            // going through 'BasicNode::operator[]' since 'string_type' with a custom allocator
+            // isn't implicitly constructible from the key, while 'std::string_view' works for any
         } else if constexpr (is_array_like_v<T>) {
-            this->data.emplace<array_type>();
+            this->data.template emplace<array_type>();
             auto& array = this->get_array();
             for (const auto& elem : value) array.emplace_back(elem);
         } else if constexpr (is_bool_like_v<T>) {
-            this->data.emplace<bool_type>(value);
+            this->data.template emplace<bool_type>(value);
         } else if constexpr (is_null_like_v<T>) {
-            this->data.emplace<null_type>(value);
+            this->data.template emplace<null_type>(value);
         } else if constexpr (is_numeric_like_v<T>) {
-            this->data.emplace<number_type>(value);
+            this->data.template emplace<number_type>(value);
         } else {
             static_assert(_always_false_v<T>, "Method is a non-exhaustive visitor of std::variant<>.");
         }
@@ -579,29 +1035,29 @@ class Node {
     }
 
     // "native" copy/move semantics for types that support it
-    Node& operator=(const object_type& value) {
+    BasicNode& operator=(const object_type& value) {
         this->data = value;
         return *this;
     }
-    Node& operator=(object_type&& value) {
+    BasicNode& operator=(object_type&& value) {
         this->data = std::move(value);
         return *this;
     }
 
-    Node& operator=(const array_type& value) {
+    BasicNode& operator=(const array_type& value) {
         this->data = value;
         return *this;
     }
-    Node& operator=(array_type&& value) {
+    BasicNode& operator=(array_type&& value) {
         this->data = std::move(value);
         return *this;
     }
 
-    Node& operator=(const string_type& value) {
+    BasicNode& operator=(const string_type& value) {
         this->data = value;
         return *this;
     }
-    Node& operator=(string_type&& value) {
+    BasicNode& operator=(string_type&& value) {
         this->data = std::move(value);
         return *this;
     }
@@ -609,7 +1065,7 @@ class Node {
     // Support for 'std::initializer_list' type deduction,
     // (otherwise the call is ambiguous)
     template <class T>
-    Node& operator=(std::initializer_list<T> ilist) {
+    BasicNode& operator=(std::initializer_list<T> ilist) {
         // We can't just do 'return *this = array_type(value);' because compiler doesn't realize it can
         // convert 'std::initializer_list<T>' to 'std::vector<Node>' for all 'T' convertible to 'Node',
         // we have to invoke 'Node()' constructor explicitly (here it happens in 'emplace_back()')
@@ -621,7 +1077,7 @@ class Node {
     }
 
     template <class T>
-    Node& operator=(std::initializer_list<std::initializer_list<T>> ilist) {
+    BasicNode& operator=(std::initializer_list<std::initializer_list<T>> ilist) {
         // Support for 2D brace initialization
         array_type array_value;
         array_value.reserve(ilist.size());
@@ -635,7 +1091,7 @@ class Node {
     }
 
     template <class T>
-    Node& operator=(std::initializer_list<std::initializer_list<std::initializer_list<T>>> ilist) {
+    BasicNode& operator=(std::initializer_list<std::initializer_list<std::initializer_list<T>>> ilist) {
         // Support for 3D brace initialization
         // it's dumb, but it works
         array_type array_value;
@@ -655,12 +1111,12 @@ class Node {
     // -- Constructors --
     // ------------------
 
-    Node& operator=(const Node&) = default;
-    Node& operator=(Node&&)      = default;
+    BasicNode& operator=(const BasicNode&) = default;
+    BasicNode& operator=(BasicNode&&)      = default;
 
-    Node()            = default;
-    Node(const Node&) = default;
-    Node(Node&&)      = default;
+    BasicNode()                 = default;
+    BasicNode(const BasicNode&) = default;
+    BasicNode(BasicNode&&)      = default;
     // Note:
     // We suffer a lot if 'object_type' move-constructor is not marked 'noexcept', if that's the case
     // 'Node' move-constructor doesn't get 'noexcept' either which means `std::vector<Node>` will copy
@@ -669,25 +1125,25 @@ class Node {
     // See noexcept status summary here: http://howardhinnant.github.io/container_summary.html
 
     // Converting ctor
-    template <class T, std::enable_if_t<!std::is_same_v<std::decay_t<T>, Node> &&
+    template <class T, std::enable_if_t<!std::is_same_v<std::decay_t<T>, BasicNode> &&
                                             !std::is_same_v<std::decay_t<T>, object_type> &&
                                             !std::is_same_v<std::decay_t<T>, array_type> &&
                                             !std::is_same_v<std::decay_t<T>, string_type> && is_json_convertible_v<T>,
                                         bool> = true>
-    Node(const T& value) {
+    BasicNode(const T& value) {
         *this = value;
     }
 
-    Node(const object_type& value) { this->data = value; }
-    Node(object_type&& value) { this->data = std::move(value); }
-    Node(const array_type& value) { this->data = value; }
-    Node(array_type&& value) { this->data = std::move(value); }
-    Node(std::string_view value) { this->data = string_type(value); }
-    Node(const string_type& value) { this->data = value; }
-    Node(string_type&& value) { this->data = std::move(value); }
-    Node(number_type value) { this->data = value; }
-    Node(bool_type value) { this->data = value; }
-    Node(null_type value) { this->data = value; }
+    BasicNode(const object_type& value) { this->data = value; }
+    BasicNode(object_type&& value) { this->data = std::move(value); }
+    BasicNode(const array_type& value) { this->data = value; }
+    BasicNode(array_type&& value) { this->data = std::move(value); }
+    BasicNode(std::string_view value) { this->data = string_type(value); }
+    BasicNode(const string_type& value) { this->data = value; }
+    BasicNode(string_type&& value) { this->data = std::move(value); }
+    BasicNode(number_type value) { this->data = value; }
+    BasicNode(bool_type value) { this->data = value; }
+    BasicNode(null_type value) { this->data = value; }
 
     // --- JSON Serializing public API ---
     // -----------------------------------
@@ -698,9 +1154,22 @@ class Node {
         return buffer;
     }
 
-    void to_file(const std::string& filepath, Format format = Format::PRETTY) const {
-        const auto chars = this->to_string(format);
+    // Streaming serialization, output gets passed to the sink in 'std::string_view' chunks through a fixed-size
+    // buffer, which means the whole serialized string never has to exist in memory at once
+    template <class Callback>
+    void to_callback(Callback&& callback, Format format = Format::PRETTY) const {
+        _serialize_json_to_callback(callback, *this, format);
+    }
+
+    void to_stream(std::ostream& stream, Format format = Format::PRETTY) const {
+        this->to_callback([&](std::string_view chunk) { stream.write(chunk.data(), chunk.size()); }, format);
+    }
+
+    void to_stream(std::FILE* file, Format format = Format::PRETTY) const {
+        this->to_callback([&](std::string_view chunk) { std::fwrite(chunk.data(), 1, chunk.size(), file); }, format);
+    }
 
+    void to_file(const std::string& filepath, Format format = Format::PRETTY) const {
         const std::filesystem::path path = filepath;
         if (path.has_parent_path() && !std::filesystem::exists(path.parent_path()))
             std::filesystem::create_directories(std::filesystem::path(filepath).parent_path());
@@ -709,10 +1178,11 @@ class Node {
         // even when there is no need to actually perform directory creation because it already exists
 
         // if user doesn't want to pay for 'create_directories()' call (which seems to be inconsequential
-        // on my benchmarks) they can always use 'std::ofstream' and 'to_string()' to export manually
+        // on my benchmarks) they can always use 'std::ofstream' and 'to_stream()' to export manually
 
-        std::ofstream(filepath).write(chars.data(), chars.size());
-        // maybe a little faster than doing 'std::ofstream(filepath) << node.to_string(format)'
+        std::ofstream file(filepath);
+        this->to_stream(file, format);
+        // streams through a bounded buffer, peak memory doesn't scale with the size of serialized JSON
     }
 
     // --- Reflection ---
@@ -735,6 +1205,10 @@ class Node {
     }
 };
 
+using Node      = BasicNode<std::allocator<char>>;
+using ArenaNode = BasicNode<ArenaAllocator<char>>;
+using FlatNode  = BasicNode<std::allocator<char>, FlatObjectBackend>;
+
 // Public typedefs
 using Object = Node::object_type;
 using Array  = Node::array_type;
@@ -743,6 +1217,126 @@ using Number = Node::number_type;
 using Bool   = Node::bool_type;
 using Null   = Node::null_type;
 
+// ==================
+// --- View class ---
+// ==================
+
+// Read-only counterpart of 'Node' produced by 'view_from_string()'. Strings are 'std::string_view's pointing
+// straight into the parsed buffer, which means parsing doesn't copy any string contents. Strings with escape
+// sequences can't be referenced directly, those get decoded once into an arena owned by the 'ViewDocument'.
+//
+// Objects are stored as flat vectors of key-value pairs with linear lookup. It loses to a map on huge objects,
+// but views are meant for a "parse large payload, read a few fields" use case where this is rarely relevant,
+// while not having to allocate a map node per key is a noticeable win during parsing.
+
+class View {
+public:
+    using object_type = std::vector<std::pair<std::string_view, View>>;
+    using array_type  = std::vector<View>;
+    using string_type = std::string_view;
+    using number_type = _number_type_impl;
+    using bool_type   = _bool_type_impl;
+    using null_type   = _null_type_impl;
+
+private:
+    using variant_type = std::variant<null_type, object_type, array_type, string_type, number_type, bool_type>;
+
+    variant_type data{};
+
+    [[nodiscard]] const View* find(std::string_view key) const {
+        for (const auto& [name, value] : this->get_object())
+            if (name == key) return &value;
+        return nullptr;
+    }
+
+    [[nodiscard]] const View& find_or_throw(std::string_view key) const {
+        if (const View* value = this->find(key)) return *value;
+        throw std::runtime_error("Accessing non-existent key {" + std::string(key) + "} in JSON object.");
+    }
+
+public:
+    // -- Getters --
+    // -------------
+
+    template <class T>
+    [[nodiscard]] const T& get() const {
+        return std::get<T>(this->data);
+    }
+
+    [[nodiscard]] const object_type& get_object() const { return this->get<object_type>(); }
+    [[nodiscard]] const array_type&  get_array() const { return this->get<array_type>(); }
+    [[nodiscard]] const string_type& get_string() const { return this->get<string_type>(); }
+    [[nodiscard]] const number_type& get_number() const { return this->get<number_type>(); }
+    [[nodiscard]] const bool_type&   get_bool() const { return this->get<bool_type>(); }
+    [[nodiscard]] const null_type&   get_null() const { return this->get<null_type>(); }
+
+    template <class T>
+    [[nodiscard]] bool is() const noexcept {
+        return std::holds_alternative<T>(this->data);
+    }
+
+    [[nodiscard]] bool is_object() const noexcept { return this->is<object_type>(); }
+    [[nodiscard]] bool is_array() const noexcept { return this->is<array_type>(); }
+    [[nodiscard]] bool is_string() const noexcept { return this->is<string_type>(); }
+    [[nodiscard]] bool is_number() const noexcept { return this->is<number_type>(); }
+    [[nodiscard]] bool is_bool() const noexcept { return this->is<bool_type>(); }
+    [[nodiscard]] bool is_null() const noexcept { return this->is<null_type>(); }
+
+    template <class T>
+    [[nodiscard]] const T* get_if() const noexcept {
+        return std::get_if<T>(&this->data);
+    }
+
+    // -- Object methods ---
+    // ---------------------
+
+    [[nodiscard]] const View& operator[](std::string_view key) const { return this->find_or_throw(key); }
+
+    [[nodiscard]] const View& at(std::string_view key) const { return this->find_or_throw(key); }
+
+    [[nodiscard]] bool contains(std::string_view key) const { return this->find(key) != nullptr; }
+
+    template <class T>
+    [[nodiscard]] const T& value_or(std::string_view key, const T& else_value) const {
+        if (const View* value = this->find(key)) return value->get<T>();
+        return else_value;
+    }
+
+    // -- Array methods ---
+    // --------------------
+
+    [[nodiscard]] const View& operator[](std::size_t pos) const { return this->get_array()[pos]; }
+
+    [[nodiscard]] const View& at(std::size_t pos) const { return this->get_array().at(pos); }
+
+    // -- Constructors --
+    // ------------------
+
+    View()            = default;
+    View(const View&) = default;
+    View(View&&)      = default;
+
+    View& operator=(const View&) = default;
+    View& operator=(View&&)      = default;
+
+    // views are only meant to be constructed by the parser, but there is no harm in leaving these public
+    View(object_type&& value) { this->data = std::move(value); }
+    View(array_type&& value) { this->data = std::move(value); }
+    View(string_type value) { this->data = value; }
+    View(number_type value) { this->data = value; }
+    View(bool_type value) { this->data = value; }
+    View(null_type value) { this->data = value; }
+};
+
+// Root of the 'View' tree, owns the storage of decoded strings. Parsed buffer is NOT owned and
+// should outlive the document, copying views out of the document is fine as long as both are alive.
+class ViewDocument : public View {
+    Arena arena;
+
+public:
+    ViewDocument(View&& root, Arena&& arena) : View(std::move(root)), arena(std::move(arena)) {}
+};
+
 // =====================
 // --- Lookup Tables ---
 // =====================
@@ -805,6 +1399,16 @@ constexpr std::array<bool, _number_of_char_values> _lookup_whitespace_chars = []
     return res;
 }();
 
+// Lookup table used to determine chars that need special handling inside JSON strings when scanning string
+// contents without SIMD. This includes quotes, backslashes and control characters (codepoints U+0000 to U+001F).
+constexpr std::array<bool, _number_of_char_values> _lookup_string_special_chars = [] {
+    std::array<bool, _number_of_char_values> res{};
+    for (std::uint8_t c = 0; c <= 31; ++c) res[c] = true;
+    res[_u8('"')]  = true;
+    res[_u8('\\')] = true;
+    return res;
+}();
+
 // Lookup table used to get an appropriate char for the escaped char in a 2-char JSON escape sequence.
 constexpr std::array<char, _number_of_char_values> _lookup_parsed_escaped_chars = [] {
     std::array<char, _number_of_char_values> res{};
@@ -819,6 +1423,112 @@ constexpr std::array<char, _number_of_char_values> _lookup_parsed_escaped_chars
     return res;
 }();
 
+// =====================
+// --- SIMD scanning ---
+// =====================
+
+// The hottest loops of the parser are skipping whitespace (which can take a large portion of runtime for
+// prettified inputs) and scanning string contents for the next quote / backslash / control character,
+// the latter is also the hottest loop of the serializer since these are exactly the chars that need escaping.
+// Both can be done 16 (SSE2) or 32 (AVX2) bytes at a time, comparing the whole block with all symbols of
+// interest and using the resulting bitmask to find the position of the first match. When SIMD isn't available
+// (or the remaining input is too short to load a full block) we fall back to a regular per-char loop.
+
+#if defined(utl_json_simd_avx2) || defined(utl_json_simd_sse2)
+[[nodiscard]] inline std::size_t _count_trailing_zeros(std::uint32_t mask) noexcept {
+    // 'mask' is assumed to be non-zero
+#if defined(_MSC_VER)
+    unsigned long index{};
+    _BitScanForward(&index, mask);
+    return static_cast<std::size_t>(index);
+#else
+    return static_cast<std::size_t>(__builtin_ctz(mask));
+#endif
+}
+#endif
+
+// Returns position of the first non-whitespace char starting from 'cursor', or 'chars.size()' if there is none
+[[nodiscard]] inline std::size_t _find_non_whitespace(std::string_view chars, std::size_t cursor) noexcept {
+#if defined(utl_json_simd_avx2) || defined(utl_json_simd_sse2)
+    // Most whitespace runs in minimized JSON (and many in prettified) are either empty or a single space,
+    // checking 2 chars ahead is cheaper than setting up a SIMD comparison for them
+    for (const std::size_t end = (cursor + 2 < chars.size()) ? cursor + 2 : chars.size(); cursor < end; ++cursor)
+        if (!_lookup_whitespace_chars[_u8(chars[cursor])]) return cursor;
+#endif
+
+#if defined(utl_json_simd_avx2)
+    const __m256i space           = _mm256_set1_epi8(' ');
+    const __m256i tab             = _mm256_set1_epi8('\t');
+    const __m256i newline         = _mm256_set1_epi8('\n');
+    const __m256i carriage_return = _mm256_set1_epi8('\r');
+
+    for (; cursor + 32 <= chars.size(); cursor += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chars.data() + cursor));
+        const __m256i space_or_tab = _mm256_or_si256(_mm256_cmpeq_epi8(block, space), _mm256_cmpeq_epi8(block, tab));
+        const __m256i line_break =
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, newline), _mm256_cmpeq_epi8(block, carriage_return));
+        const __m256i whitespace = _mm256_or_si256(space_or_tab, line_break);
+        const auto mask = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(whitespace));
+        if (mask) return cursor + _count_trailing_zeros(mask);
+    }
+#elif defined(utl_json_simd_sse2)
+    const __m128i space           = _mm_set1_epi8(' ');
+    const __m128i tab             = _mm_set1_epi8('\t');
+    const __m128i newline         = _mm_set1_epi8('\n');
+    const __m128i carriage_return = _mm_set1_epi8('\r');
+
+    for (; cursor + 16 <= chars.size(); cursor += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars.data() + cursor));
+        const __m128i whitespace =
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, tab)),
+                         _mm_or_si128(_mm_cmpeq_epi8(block, newline), _mm_cmpeq_epi8(block, carriage_return)));
+        const auto mask = ~static_cast<std::uint32_t>(_mm_movemask_epi8(whitespace)) & 0xFFFF;
+        if (mask) return cursor + _count_trailing_zeros(mask);
+    }
+#endif
+
+    for (; cursor < chars.size(); ++cursor)
+        if (!_lookup_whitespace_chars[_u8(chars[cursor])]) return cursor;
+    return chars.size();
+}
+
+// Returns position of the first quote '"', backslash '\' or control character (codepoints U+0000 to U+001F)
+// starting from 'cursor', or 'chars.size()' if there is none. These are the only chars that need special
+// handling inside JSON strings, everything in-between can be copied as-is.
+[[nodiscard]] inline std::size_t _find_string_special_char(std::string_view chars, std::size_t cursor) noexcept {
+#if defined(utl_json_simd_avx2)
+    const __m256i quote     = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i max_ctrl  = _mm256_set1_epi8(31);
+
+    for (; cursor + 32 <= chars.size(); cursor += 32) {
+        const __m256i block   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chars.data() + cursor));
+        const __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(block, max_ctrl), block); // unsigned 'c <= 31'
+        const __m256i special = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, quote), _mm256_cmpeq_epi8(block, backslash)), control);
+        const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(special));
+        if (mask) return cursor + _count_trailing_zeros(mask);
+    }
+#elif defined(utl_json_simd_sse2)
+    const __m128i quote     = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i max_ctrl  = _mm_set1_epi8(31);
+
+    for (; cursor + 16 <= chars.size(); cursor += 16) {
+        const __m128i block   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars.data() + cursor));
+        const __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(block, max_ctrl), block); // unsigned 'c <= 31'
+        const __m128i special =
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, backslash)), control);
+        const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(special));
+        if (mask) return cursor + _count_trailing_zeros(mask);
+    }
+#endif
+
+    for (; cursor < chars.size(); ++cursor)
+        if (_lookup_string_special_chars[_u8(chars[cursor])]) return cursor;
+    return chars.size();
+}
+
 // ==========================
 // --- JSON Parsing impl. ---
 // ==========================
@@ -827,57 +1537,116 @@ constexpr unsigned int _default_recursion_limit = 1000;
 // this recursion limit applies only to parsing from text, conversions from
 // structs & containers are a separate thing and don't really need it as much
 
-struct _parser {
-    const std::string& chars;
-    unsigned int       recursion_limit;
-    unsigned int       recursion_depth = 0;
+// SAX-style parser, performs all of the validation & escape handling, but instead of building a tree it reports
+// the structure of the document as a flat sequence of events to the 'Handler'. Nothing gets materialized here
+// except a single reusable buffer for decoding escaped strings, memory usage depends only on the nesting depth.
+//
+// Every tree-building parse ('Node', 'ArenaNode', 'FlatNode', 'View') is just one of the handlers, see '_node_builder'.
+//
+// 'Handler' is expected to provide the following methods:
+//    > on_object_begin(), on_object_end(), on_array_begin(), on_array_end(),
+//    > on_key(std::string_view), on_string(std::string_view), on_number(double), on_bool(bool), on_null()
+// Strings passed to 'on_key()' / 'on_string()' are only valid until the callback returns.
+template <class Handler>
+struct _sax_parser {
+    using number_type = _number_type_impl;
+    using bool_type   = _bool_type_impl;
+    using null_type   = _null_type_impl;
+
+    std::string_view chars;
+    unsigned int     recursion_limit;
+    unsigned int     recursion_depth = 0;
     // we track recursion depth to handle stack allocation errors
     // (this can be caused malicious inputs with extreme level of nesting, for example, 100k array
     // opening brackets, which would cause huge recursion depth causing the stack to overflow with SIGSEGV)
 
     // dynamic allocation errors can be handled with regular exceptions through std::bad_alloc
 
-    _parser() = delete;
-    _parser(const std::string& chars, unsigned int& recursion_limit) : chars(chars), recursion_limit(recursion_limit) {}
+    Handler&    handler;
+    std::string buffer; // used to decode strings with escape sequences, reused between strings
+
+    _sax_parser() = delete;
+    _sax_parser(std::string_view chars, unsigned int recursion_limit, Handler& handler)
+        : chars(chars), recursion_limit(recursion_limit), handler(handler) {}
 
     // Parser state
     std::size_t skip_nonsignificant_whitespace(std::size_t cursor) {
         using namespace std::string_literals;
 
-        while (cursor < this->chars.size()) {
-            if (!_lookup_whitespace_chars[_u8(this->chars[cursor])]) return cursor;
-            ++cursor;
-        }
+        cursor = _find_non_whitespace(this->chars, cursor);
+        if (cursor < this->chars.size()) return cursor;
 
         throw std::runtime_error("JSON parser reached the end of buffer at pos "s + std::to_string(cursor) +
                                  " while skipping insignificant whitespace segment."s +
                                  _pretty_error(cursor, this->chars));
     }
 
-    // Parsing methods
-    std::pair<std::size_t, Node> parse_node(std::size_t cursor) {
+    void enter_nested_node() {
         using namespace std::string_literals;
 
-        // Node selector assumes it is starting at a significant symbol
-        // which is the first symbol of the node to be parsed
-
-        const char c = this->chars[cursor];
-
-        // Assuming valid JSON, we can determine node type based on a single first character
+        if (++this->recursion_depth > this->recursion_limit)
+            throw std::runtime_error("JSON parser has exceeded maximum allowed recursion depth of "s +
+                                     std::to_string(this->recursion_limit) +
+                                     ". If stated depth wasn't caused by an invalid input, "s +
+                                     "recursion limit can be increased with json::set_recursion_limit()."s);
+    }
+
+    void leave_nested_node() noexcept { --this->recursion_depth; }
+
+    // Parsing methods
+    void parse_root() {
+        using namespace std::string_literals;
+
+        const std::size_t json_start = this->skip_nonsignificant_whitespace(0); // skip leading whitespace
+        const std::size_t end_cursor = this->parse_node(json_start); // starts parsing recursively from the root node
+
+        this->check_trailing_symbols(end_cursor);
+    }
+
+    void check_trailing_symbols(std::size_t cursor) const {
+        using namespace std::string_literals;
+
+        for (; cursor < this->chars.size(); ++cursor)
+            if (!_lookup_whitespace_chars[_u8(this->chars[cursor])])
+                throw std::runtime_error("Invalid trailing symbols encountered after the root JSON node at pos "s +
+                                         std::to_string(cursor) + "."s + _pretty_error(cursor, this->chars));
+    }
+
+    std::size_t parse_node(std::size_t cursor) {
+        using namespace std::string_literals;
+
+        // Node selector assumes it is starting at a significant symbol
+        // which is the first symbol of the node to be parsed
+
+        const char c = this->chars[cursor];
+
+        // Assuming valid JSON, we can determine node type based on a single first character
         if (c == '{') {
             return this->parse_object(cursor);
         } else if (c == '[') {
             return this->parse_array(cursor);
         } else if (c == '"') {
-            return this->parse_string(cursor);
+            std::string_view string_value;
+            std::tie(cursor, string_value) = this->parse_string(cursor);
+            this->handler.on_string(string_value);
+            return cursor;
         } else if (('0' <= c && c <= '9') || (c == '-')) {
-            return this->parse_number(cursor);
+            number_type number_value;
+            std::tie(cursor, number_value) = this->parse_number(cursor);
+            this->handler.on_number(number_value);
+            return cursor;
         } else if (c == 't') {
-            return this->parse_true(cursor);
+            std::tie(cursor, std::ignore) = this->parse_true(cursor);
+            this->handler.on_bool(true);
+            return cursor;
         } else if (c == 'f') {
-            return this->parse_false(cursor);
+            std::tie(cursor, std::ignore) = this->parse_false(cursor);
+            this->handler.on_bool(false);
+            return cursor;
         } else if (c == 'n') {
-            return this->parse_null(cursor);
+            std::tie(cursor, std::ignore) = this->parse_null(cursor);
+            this->handler.on_null();
+            return cursor;
         }
         throw std::runtime_error("JSON node selector encountered unexpected marker symbol {"s + this->chars[cursor] +
                                  "} at pos "s + std::to_string(cursor) + " (should be one of {0123456789{[\"tfn})."s +
@@ -886,14 +1655,15 @@ struct _parser {
         // Note: using a lookup table instead of an 'if' chain doesn't seem to offer any performance benefits here
     }
 
-    std::size_t parse_object_pair(std::size_t cursor, Object& parent) {
+    std::size_t parse_object_pair(std::size_t cursor) {
         using namespace std::string_literals;
 
         // Object pair parser assumes it is starting at a '"'
 
         // Parse pair key
-        std::string key; // allocating a string here is fine since we will std::move() it into a map key
+        std::string_view key;
         std::tie(cursor, key) = this->parse_string(cursor);
+        this->handler.on_key(key);
 
         // Handle stuff in-between
         cursor = this->skip_nonsignificant_whitespace(cursor);
@@ -905,67 +1675,32 @@ struct _parser {
         cursor = this->skip_nonsignificant_whitespace(cursor);
 
         // Parse pair value
-        if (++this->recursion_depth > this->recursion_limit)
-            throw std::runtime_error("JSON parser has exceeded maximum allowed recursion depth of "s +
-                                     std::to_string(this->recursion_limit) +
-                                     ". If stated depth wasn't caused by an invalid input, "s +
-                                     "recursion limit can be increased with json::set_recursion_limit()."s);
-
-        Node value;
-        std::tie(cursor, value) = this->parse_node(cursor);
-
-        --this->recursion_depth;
-
-        // Note 1:
-        // The question of whether JSON allows duplicate keys is non-trivial but the resulting answer is YES.
-        // JSON is governed by 2 standards:
-        // 1) ECMA-404 https://ecma-international.org/wp-content/uploads/ECMA-404.pdf
-        //    which doesn't say anything about duplicate kys
-        // 2) RFC-8259 https://www.rfc-editor.org/rfc/rfc8259
-        //    which states "The names within an object SHOULD be unique.",
-        //    however as defined in RFC-2119 https://www.rfc-editor.org/rfc/rfc2119:
-        //       "SHOULD This word, or the adjective "RECOMMENDED", mean that there may exist valid reasons in
-        //       particular circumstances to ignore a particular item, but the full implications must be understood
-        //       and carefully weighed before choosing a different course."
-        // which means at the end of the day duplicate keys are discouraged but still valid
+        this->enter_nested_node();
+        cursor = this->parse_node(cursor);
+        this->leave_nested_node();
 
-        // Note 2:
-        // There is no standard specification on which JSON value should be preferred in case of duplicate keys.
-        // This is considered implementation detail as per RFC-8259:
-        //    "An object whose names are all unique is interoperable in the sense that all software implementations
-        //    receiving that object will agree on the name-value mappings. When the names within an object are not
-        //    unique, the behavior of software that receives such an object is unpredictable. Many implementations
-        //    report the last name/value pair only. Other implementations report an error or fail to parse the object,
-        //    and some implementations report all of the name/value pairs, including duplicates."
-
-        // Note 3:
-        // We could easily check for duplicate keys since 'std::map<>::emplace()' returns insertion success as a bool
-        // (the same isn't true for 'std::map<>::emplace_hint()' which returns just the iterator), however we will
-        // not since that goes against the standard
-
-        // Note 4:
-        // 'parent.emplace_hint(parent.end(), ...)' can drastically speed up parsing of sorted JSON objects, however
-        // since most JSONs in the wild aren't sorted we will resort to a more generic option of regular '.emplace()'
-        parent.try_emplace(std::move(key), std::move(value));
+        // Note:
+        // Duplicate keys are reported as-is, it is up to the handler to decide what to do with them,
+        // tree-building handler keeps the first one, see '_node_builder::on_object_end()'
 
         return cursor;
     }
 
-    std::pair<std::size_t, Object> parse_object(std::size_t cursor) {
+    std::size_t parse_object(std::size_t cursor) {
         using namespace std::string_literals;
 
         ++cursor; // move past the opening brace '{'
 
-        // Empty object that will accumulate child nodes as we parse them
-        Object object_value;
+        this->handler.on_object_begin();
 
         // Handle 1st pair
         cursor = this->skip_nonsignificant_whitespace(cursor);
         if (this->chars[cursor] != '}') {
-            cursor = this->parse_object_pair(cursor, object_value);
+            cursor = this->parse_object_pair(cursor);
         } else {
             ++cursor; // move past the closing brace '}'
-            return {cursor, std::move(object_value)};
+            this->handler.on_object_end();
+            return cursor;
         }
 
         // Handle other pairs
@@ -989,10 +1724,11 @@ struct _parser {
             if (c == ',') {
                 ++cursor; // move past the comma ','
                 cursor = this->skip_nonsignificant_whitespace(cursor);
-                cursor = this->parse_object_pair(cursor, object_value);
+                cursor = this->parse_object_pair(cursor);
             } else if (c == '}') {
                 ++cursor; // move past the closing brace '}'
-                return {cursor, std::move(object_value)};
+                this->handler.on_object_end();
+                return cursor;
             } else {
                 throw std::runtime_error(
                     "JSON array node could not find comma {,} or object ending symbol {}} after the element at pos "s +
@@ -1004,43 +1740,30 @@ struct _parser {
                                  _pretty_error(cursor, this->chars));
     }
 
-    std::size_t parse_array_element(std::size_t cursor, Array& parent) {
-        using namespace std::string_literals;
-
+    std::size_t parse_array_element(std::size_t cursor) {
         // Array element parser assumes it is starting at the first symbol of some JSON node
-
-        // Parse pair key
-        if (++this->recursion_depth > this->recursion_limit)
-            throw std::runtime_error("JSON parser has exceeded maximum allowed recursion depth of "s +
-                                     std::to_string(this->recursion_limit) +
-                                     ". If stated depth wasn't caused by an invalid input, "s +
-                                     "recursion limit can be increased with json::set_recursion_limit()."s);
-
-        Node value;
-        std::tie(cursor, value) = this->parse_node(cursor);
-
-        --this->recursion_depth;
-
-        parent.emplace_back(std::move(value));
+        this->enter_nested_node();
+        cursor = this->parse_node(cursor);
+        this->leave_nested_node();
 
         return cursor;
     }
 
-    std::pair<std::size_t, Array> parse_array(std::size_t cursor) {
+    std::size_t parse_array(std::size_t cursor) {
         using namespace std::string_literals;
 
         ++cursor; // move past the opening bracket '['
 
-        // Empty array that will accumulate child nodes as we parse them
-        Array array_value;
+        this->handler.on_array_begin();
 
         // Handle 1st pair
         cursor = this->skip_nonsignificant_whitespace(cursor);
         if (this->chars[cursor] != ']') {
-            cursor = this->parse_array_element(cursor, array_value);
+            cursor = this->parse_array_element(cursor);
         } else {
             ++cursor; // move past the closing bracket ']'
-            return {cursor, std::move(array_value)};
+            this->handler.on_array_end();
+            return cursor;
         }
 
         // Handle other pairs
@@ -1052,10 +1775,11 @@ struct _parser {
             if (c == ',') {
                 ++cursor; // move past the comma ','
                 cursor = this->skip_nonsignificant_whitespace(cursor);
-                cursor = this->parse_array_element(cursor, array_value);
+                cursor = this->parse_array_element(cursor);
             } else if (c == ']') {
                 ++cursor; // move past the closing bracket ']'
-                return {cursor, std::move(array_value)};
+                this->handler.on_array_end();
+                return cursor;
             } else {
                 throw std::runtime_error(
                     "JSON array node could not find comma {,} or array ending symbol {]} after the element at pos "s +
@@ -1067,7 +1791,7 @@ struct _parser {
                                  _pretty_error(cursor, this->chars));
     }
 
-    inline std::size_t parse_escaped_unicode_codepoint(std::size_t cursor, std::string& string_value) {
+    std::size_t parse_escaped_unicode_codepoint(std::size_t cursor, std::string& string_value) {
         using namespace std::string_literals;
 
         // Note 1:
@@ -1157,14 +1881,38 @@ struct _parser {
         }
     }
 
-    std::pair<std::size_t, String> parse_string(std::size_t cursor) {
+    std::pair<std::size_t, std::string_view> parse_string(std::size_t cursor) {
         using namespace std::string_literals;
 
-        // Empty string that will accumulate characters as we parse them
-        std::string string_value;
+        const auto throw_control_character_error = [&]() {
+            throw std::runtime_error("JSON string node encountered unescaped ASCII control character character \\"s +
+                                     std::to_string(static_cast<int>(this->chars[cursor])) + " at pos "s +
+                                     std::to_string(cursor) + "."s + _pretty_error(cursor, this->chars));
+        };
 
         ++cursor; // move past the opening quote '"'
 
+        // Most strings in the wild contain no escape sequences, in which case string contents are just
+        // a segment of the buffer. We can scan for it without doing any appends and report a view directly
+        // into the buffer, handlers that need to own the string can then construct it in a single allocation.
+        const std::size_t string_start = cursor;
+
+        cursor = _find_string_special_char(this->chars, cursor);
+        if (cursor < this->chars.size()) {
+            const char c = this->chars[cursor];
+
+            if (c == '"') {
+                const std::string_view contents(this->chars.data() + string_start, cursor - string_start);
+                ++cursor; // move past the closing quote '"'
+                return {cursor, contents};
+            } else if (c != '\\') throw_control_character_error();
+            // on backslash fall back onto a regular escape-handling loop
+        }
+
+        // Reusable buffer that will accumulate characters as we parse them, starts with an already scanned segment
+        std::string& string_value = this->buffer;
+        string_value.assign(this->chars.data() + string_start, cursor - string_start);
+
         // Serialize string while handling escape sequences.
         //
         // Doing 'string_value += c' for every char is ~50-60% slower than appending whole string at once,
@@ -1172,13 +1920,17 @@ struct _parser {
         // whole chunks of the buffer to 'string_value' when we encounter an escape sequence or end of the string.
         //
         for (std::size_t segment_start = cursor; cursor < this->chars.size(); ++cursor) {
+            cursor = _find_string_special_char(this->chars, cursor); // skip to the next char that needs handling
+            if (cursor == this->chars.size()) break;
+
             const char c = this->chars[cursor];
 
             // Reached the end of the string
             if (c == '"') {
                 string_value.append(this->chars.data() + segment_start, cursor - segment_start);
                 ++cursor; // move past the closing quote '"'
-                return {cursor, std::move(string_value)};
+                return {cursor, string_value};
+                // decoded strings can't reference the buffer, they are valid until the next escaped string
             }
             // Handle escape sequences inside the string
             else if (c == '\\') {
@@ -1217,21 +1969,17 @@ struct _parser {
                 continue;
             }
             // Reject unescaped control characters (codepoints U+0000 to U+001F)
-            else if (_u8(c) <= 31)
-                throw std::runtime_error(
-                    "JSON string node encountered unescaped ASCII control character character \\"s +
-                    std::to_string(static_cast<int>(c)) + " at pos "s + std::to_string(cursor) + "."s +
-                    _pretty_error(cursor, this->chars));
+            else if (_u8(c) <= 31) throw_control_character_error();
         }
 
         throw std::runtime_error("JSON string node reached the end of buffer while parsing string contents." +
                                  _pretty_error(cursor, this->chars));
     }
 
-    std::pair<std::size_t, Number> parse_number(std::size_t cursor) {
+    std::pair<std::size_t, number_type> parse_number(std::size_t cursor) {
         using namespace std::string_literals;
 
-        Number number_value;
+        number_type number_value;
 
         const auto [numer_end_ptr, error_code] =
             std::from_chars(this->chars.data() + cursor, this->chars.data() + this->chars.size(), number_value);
@@ -1255,7 +2003,7 @@ struct _parser {
         return {numer_end_ptr - this->chars.data(), number_value};
     }
 
-    std::pair<std::size_t, Bool> parse_true(std::size_t cursor) {
+    std::pair<std::size_t, bool_type> parse_true(std::size_t cursor) {
         using namespace std::string_literals;
         constexpr std::size_t token_length = 4;
 
@@ -1273,10 +2021,10 @@ struct _parser {
             throw std::runtime_error("JSON bool node could not parse {true} at pos "s + std::to_string(cursor) + "."s +
                                      _pretty_error(cursor, this->chars));
 
-        return {cursor + token_length, Bool(true)};
+        return {cursor + token_length, bool_type(true)};
     }
 
-    std::pair<std::size_t, Bool> parse_false(std::size_t cursor) {
+    std::pair<std::size_t, bool_type> parse_false(std::size_t cursor) {
         using namespace std::string_literals;
         constexpr std::size_t token_length = 5;
 
@@ -1295,10 +2043,10 @@ struct _parser {
             throw std::runtime_error("JSON bool node could not parse {false} at pos "s + std::to_string(cursor) + "."s +
                                      _pretty_error(cursor, this->chars));
 
-        return {cursor + token_length, Bool(false)};
+        return {cursor + token_length, bool_type(false)};
     }
 
-    std::pair<std::size_t, Null> parse_null(std::size_t cursor) {
+    std::pair<std::size_t, null_type> parse_null(std::size_t cursor) {
         using namespace std::string_literals;
         constexpr std::size_t token_length = 4;
 
@@ -1316,19 +2064,252 @@ struct _parser {
             throw std::runtime_error("JSON null node could not parse {null} at pos "s + std::to_string(cursor) + "."s +
                                      _pretty_error(cursor, this->chars));
 
-        return {cursor + token_length, Null()};
+        return {cursor + token_length, null_type()};
     }
 };
 
+// Tree-building SAX handler, this is what all of the 'from_string()' variants parse with.
+//
+// Values of all currently open containers are accumulated on a single stack, once a container is closed its elements
+// get moved into a container allocated with an exact size. Apart from saving on regrowth, this is also important for
+// arena nodes, since arena memory is never reused every regrowth would leave the old buffer behind as dead memory.
+//
+// Builder is templated on the resulting node type, this way the same logic can construct both owning 'Node' trees
+// and non-owning 'View' trees. The only parts that differ are string handling (copy vs. reference into the buffer)
+// and object insertion (map vs. flat vector), see 'if constexpr' branches.
+template <class NodeType>
+struct _node_builder {
+    using object_type = typename NodeType::object_type;
+    using array_type  = typename NodeType::array_type;
+    using string_type = typename NodeType::string_type;
+    using number_type = typename NodeType::number_type;
+    using bool_type   = typename NodeType::bool_type;
+    using null_type   = typename NodeType::null_type;
+
+    constexpr static bool is_view = std::is_same_v<string_type, std::string_view>;
+
+    using allocator_type = typename array_type::allocator_type;
+
+    struct frame {
+        std::size_t values_start;
+        std::size_t keys_start;
+    };
+
+    std::vector<NodeType>    values; // values of all currently open containers, innermost container goes last
+    std::vector<string_type> keys;   // keys of all currently open objects
+    std::vector<frame>       frames; // one per currently open container
+
+    std::string_view chars;           // parsed buffer, views reference strings directly from it
+    allocator_type   allocator;       // allocator for all the containers, only meaningful for arena nodes
+    Arena*           arena = nullptr; // storage for decoded escaped strings, only used when building a 'View'
+
+    explicit _node_builder(std::string_view chars, const allocator_type& allocator = {}, Arena* arena = nullptr)
+        : chars(chars), allocator(allocator), arena(arena) {}
+
+    // Containers & strings have to be explicitly constructed with an allocator, otherwise nodes that use
+    // stateful allocators would end up with a default-constructed one (which isn't the one we want)
+    [[nodiscard]] string_type make_string(std::string_view contents) const {
+        if constexpr (is_view) {
+            const std::less<const char*> less;
+            const bool                   points_into_buffer = !less(contents.data(), this->chars.data()) &&
+                                            less(contents.data(), this->chars.data() + this->chars.size());
+            if (points_into_buffer) return contents;
+            else return this->arena->store(contents);
+            // decoded strings can't reference the buffer, views keep them in the arena owned by the document
+        } else return string_type(contents, this->allocator);
+    }
+
+    [[nodiscard]] NodeType result() { return std::move(this->values.back()); }
+
+    // - Events -
+    void on_object_begin() { this->frames.push_back({this->values.size(), this->keys.size()}); }
+    void on_array_begin() { this->frames.push_back({this->values.size(), this->keys.size()}); }
+
+    void on_key(std::string_view key) { this->keys.push_back(this->make_string(key)); }
+
+    void on_string(std::string_view value) { this->values.emplace_back(this->make_string(value)); }
+    void on_number(number_type value) { this->values.emplace_back(value); }
+    void on_bool(bool_type value) { this->values.emplace_back(value); }
+    void on_null() { this->values.emplace_back(null_type{}); }
+
+    void on_object_end() {
+        const frame       current = this->frames.back();
+        const std::size_t size    = this->values.size() - current.values_start;
+        this->frames.pop_back();
+
+        object_type object_value(this->allocator);
+        if constexpr (_has_reserve_v<object_type>) object_value.reserve(size);
+
+        for (std::size_t i = 0; i < size; ++i) {
+            auto& key   = this->keys[current.keys_start + i];
+            auto& value = this->values[current.values_start + i];
+
+            // Note 1:
+            // The question of whether JSON allows duplicate keys is non-trivial but the resulting answer is YES.
+            // JSON is governed by 2 standards:
+            // 1) ECMA-404 https://ecma-international.org/wp-content/uploads/ECMA-404.pdf
+            //    which doesn't say anything about duplicate kys
+            // 2) RFC-8259 https://www.rfc-editor.org/rfc/rfc8259
+            //    which states "The names within an object SHOULD be unique.",
+            //    however as defined in RFC-2119 https://www.rfc-editor.org/rfc/rfc2119:
+            //       "SHOULD This word, or the adjective "RECOMMENDED", mean that there may exist valid reasons in
+            //       particular circumstances to ignore a particular item, but the full implications must be understood
+            //       and carefully weighed before choosing a different course."
+            // which means at the end of the day duplicate keys are discouraged but still valid
+
+            // Note 2:
+            // There is no standard specification on which JSON value should be preferred in case of duplicate keys.
+            // This is considered implementation detail as per RFC-8259:
+            //    "An object whose names are all unique is interoperable in the sense that all software
+            //    implementations receiving that object will agree on the name-value mappings. When the names
+            //    within an object are not unique, the behavior of software that receives such an object is
+            //    unpredictable. Many implementations report the last name/value pair only. Other implementations
+            //    report an error or fail to parse the object, and some implementations report all of the
+            //    name/value pairs, including duplicates."
+
+            // Note 3:
+            // We could easily check for duplicate keys since 'try_emplace()' returns insertion success as a bool,
+            // however we will not since that goes against the standard
+
+            // Note 4:
+            // 'parent.emplace_hint(parent.end(), ...)' can drastically speed up parsing of sorted JSON objects,
+            // however since most JSONs in the wild aren't sorted we will resort to a more generic option of
+            // regular '.emplace()'
+            if constexpr (is_view) object_value.emplace_back(key, std::move(value));
+            else object_value.try_emplace(std::move(key), std::move(value));
+            // views keep pairs in a flat vector, lookup returns the first match which
+            // makes duplicate key handling consistent with 'try_emplace()' on a map
+        }
+
+        this->values.erase(this->values.begin() + current.values_start, this->values.end());
+        this->keys.erase(this->keys.begin() + current.keys_start, this->keys.end());
+        this->values.emplace_back(std::move(object_value));
+    }
+
+    void on_array_end() {
+        const frame       current = this->frames.back();
+        const std::size_t size    = this->values.size() - current.values_start;
+        this->frames.pop_back();
+
+        array_type array_value(this->allocator);
+        array_value.reserve(size);
+
+        for (std::size_t i = 0; i < size; ++i)
+            array_value.emplace_back(std::move(this->values[current.values_start + i]));
+
+        this->values.erase(this->values.begin() + current.values_start, this->values.end());
+        this->values.emplace_back(std::move(array_value));
+    }
+};
 
 // ==============================
 // --- JSON Serializing impl. ---
 // ==============================
 
-template <bool prettify>
-inline void _serialize_json_recursion(const Node& node, std::string& chars, unsigned int indent_level = 0,
-                                      bool skip_first_indent = false) {
+// Serializer always writes into a 'std::string' buffer, sinks decide what happens to the part that was
+// already written. Streaming sinks flush the buffer once it grows past '_sink_buffer_size', checks only
+// happen between array elements & object pairs so the per-char hot path stays exactly the same as for
+// 'to_string()'. This bounds memory usage by the buffer size plus the size of the largest leaf value.
+
+constexpr std::size_t _sink_buffer_size = 1 << 16; // 64 KiB
+
+struct _string_sink {
+    void maybe_flush(std::string&) noexcept {}
+    void flush(std::string&) noexcept {}
+};
+
+template <class Callback>
+struct _callback_sink {
+    Callback& callback;
+
+    void maybe_flush(std::string& chars) {
+        if (chars.size() >= _sink_buffer_size) this->flush(chars);
+    }
+
+    void flush(std::string& chars) {
+        if (chars.empty()) return;
+        this->callback(std::string_view(chars));
+        chars.clear(); // keeps the capacity
+    }
+};
+
+inline void _serialize_string(std::string& chars, std::string_view string_value) {
+    chars += '"';
+
+    // Serialize string while handling escape sequences.
+    // Without escape sequences we could just do 'chars += string_value'.
+    //
+    // Since appending individual characters is ~twice as slow as appending the whole string, we use a
+    // "buffered" way of appending, appending whole segments up to the currently escaped char.
+    // Strings with no escaped chars get appended in a single call.
+    //
+    // Chars that need escaping are exactly the ones parser has to handle specially, which means we can
+    // use the same SIMD scanner to jump from one escaped char to the next, see '_find_string_special_char()'.
+    //
+    std::size_t segment_start = 0;
+    for (std::size_t i = _find_string_special_char(string_value, 0); i < string_value.size();
+         i = _find_string_special_char(string_value, i + 1)) {
+        chars.append(string_value.data() + segment_start, i - segment_start);
+        chars += '\\';
+
+        const char c = string_value[i];
+        if (const char escaped_char_replacement = _lookup_serialized_escaped_chars[_u8(c)]) {
+            chars += escaped_char_replacement;
+        } else {
+            // control chars without a 2-character escape sequence have to be escaped as '\u00XX'
+            constexpr std::string_view hex_digits = "0123456789abcdef";
+            chars += "u00";
+            chars += hex_digits[_u8(c) >> 4];
+            chars += hex_digits[_u8(c) & 0xF];
+        }
+
+        segment_start = i + 1; // skip over the "actual" technical character in the string
+    }
+    chars.append(string_value.data() + segment_start, string_value.size() - segment_start);
+
+    chars += '"';
+}
+
+template <class Number>
+void _serialize_number(std::string& chars, Number number_value) {
+    using namespace std::string_literals;
+
+    constexpr int max_exponent = std::numeric_limits<Number>::max_exponent10;
+    constexpr int max_digits =
+        4 + std::numeric_limits<Number>::max_digits10 + std::max(2, _log_10_ceil(max_exponent));
+    // should be the smallest buffer size to account for all possible 'std::to_chars()' outputs,
+    // see [https://stackoverflow.com/questions/68472720/stdto-chars-minimal-floating-point-buffer-size]
+
+    std::array<char, max_digits> buffer;
+
+    const auto [number_end_ptr, error_code] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), number_value);
+
+    if (error_code != std::errc{})
+        throw std::runtime_error(
+            "JSON serializing encountered std::to_chars() formatting error while serializing value {"s +
+            std::to_string(number_value) + "}."s);
+
+    // Save NaN/Inf cases as strings, since JSON spec doesn't include IEEE 754.
+    // (!) May result in non-homogenous arrays like [ 1.0, "inf" , 3.0, 4.0, "nan" ]
+    if (std::isfinite(number_value)) {
+        chars.append(buffer.data(), number_end_ptr - buffer.data());
+    } else {
+        chars += '"';
+        chars.append(buffer.data(), number_end_ptr - buffer.data());
+        chars += '"';
+    }
+}
+
+template <bool prettify, class NodeType, class Sink>
+void _serialize_json_recursion(const NodeType& node, std::string& chars, Sink& sink, unsigned int indent_level = 0,
+                               bool skip_first_indent = false) {
     using namespace std::string_literals;
+    using Object = typename NodeType::object_type;
+    using Array  = typename NodeType::array_type;
+    using String = typename NodeType::string_type;
+    using Number = typename NodeType::number_type;
+    using Bool   = typename NodeType::bool_type;
+    using Null   = typename NodeType::null_type;
     constexpr std::size_t indent_level_size = 4;
     const std::size_t     indent_size       = indent_level_size * indent_level;
 
@@ -1367,7 +2348,7 @@ inline void _serialize_json_recursion(const Node& node, std::string& chars, unsi
         if (!skip_first_indent) chars.append(indent_size, ' ');
 
     // JSON Object
-    if (auto* ptr = node.get_if<Object>()) {
+    if (auto* ptr = node.template get_if<Object>()) {
         const auto& object_value = *ptr;
 
         // Skip all logic for empty objects
@@ -1382,12 +2363,12 @@ inline void _serialize_json_recursion(const Node& node, std::string& chars, unsi
         for (auto it = object_value.cbegin();;) {
             if constexpr (prettify) chars.append(indent_size + indent_level_size, ' ');
             // Key
-            chars += '"';
-            chars += it->first;
-            if constexpr (prettify) chars += "\": ";
-            else chars += "\":";
+            _serialize_string(chars, it->first); // keys need escaping just as much as the values
+            if constexpr (prettify) chars += ": ";
+            else chars += ':';
             // Value
-            _serialize_json_recursion<prettify>(it->second, chars, indent_level + 1, true);
+            _serialize_json_recursion<prettify>(it->second, chars, sink, indent_level + 1, true);
+            sink.maybe_flush(chars);
             // Comma
             if (++it != object_value.cend()) { // prevents trailing comma
                 chars += ',';
@@ -1402,7 +2383,7 @@ inline void _serialize_json_recursion(const Node& node, std::string& chars, unsi
         chars += '}';
     }
     // JSON Array
-    else if (auto* ptr = node.get_if<Array>()) {
+    else if (auto* ptr = node.template get_if<Array>()) {
         const auto& array_value = *ptr;
 
         // Skip all logic for empty arrays
@@ -1416,7 +2397,8 @@ inline void _serialize_json_recursion(const Node& node, std::string& chars, unsi
 
         for (auto it = array_value.cbegin();;) {
             // Node
-            _serialize_json_recursion<prettify>(*it, chars, indent_level + 1);
+            _serialize_json_recursion<prettify>(*it, chars, sink, indent_level + 1);
+            sink.maybe_flush(chars);
             // Comma
             if (++it != array_value.cend()) { // prevents trailing comma
                 chars += ',';
@@ -1430,108 +2412,246 @@ inline void _serialize_json_recursion(const Node& node, std::string& chars, unsi
         chars += ']';
     }
     // String
-    else if (auto* ptr = node.get_if<String>()) {
+    else if (auto* ptr = node.template get_if<String>()) {
         const auto& string_value = *ptr;
 
-        chars += '"';
-
-        // Serialize string while handling escape sequences.
-        /// Without escape sequences we could just do 'chars += string_value'.
-        //
-        // Since appending individual characters is ~twice as slow as appending the whole string, we use a
-        // "buffered" way of appending, appending whole segments up to the currently escaped char.
-        // Strings with no escaped chars get appended in a single call.
-        //
-        std::size_t segment_start = 0;
-        for (std::size_t i = 0; i < string_value.size(); ++i) {
-            if (const char escaped_char_replacement = _lookup_serialized_escaped_chars[_u8(string_value[i])]) {
-                chars.append(string_value.data() + segment_start, i - segment_start);
-                chars += '\\';
-                chars += escaped_char_replacement;
-                segment_start = i + 1; // skip over the "actual" technical character in the string
-            }
-        }
-        chars.append(string_value.data() + segment_start, string_value.size() - segment_start);
-
-        chars += '"';
+        _serialize_string(chars, string_value);
     }
     // Number
-    else if (auto* ptr = node.get_if<Number>()) {
-        const auto& number_value = *ptr;
-
-        constexpr int max_exponent = std::numeric_limits<Number>::max_exponent10;
-        constexpr int max_digits =
-            4 + std::numeric_limits<Number>::max_digits10 + std::max(2, _log_10_ceil(max_exponent));
-        // should be the smallest buffer size to account for all possible 'std::to_chars()' outputs,
-        // see [https://stackoverflow.com/questions/68472720/stdto-chars-minimal-floating-point-buffer-size]
-
-        std::array<char, max_digits> buffer;
-
-        const auto [number_end_ptr, error_code] =
-            std::to_chars(buffer.data(), buffer.data() + buffer.size(), number_value);
-
-        if (error_code != std::errc{})
-            throw std::runtime_error(
-                "JSON serializing encountered std::to_chars() formatting error while serializing value {"s +
-                std::to_string(number_value) + "}."s);
-
-        const std::string_view number_string(buffer.data(), number_end_ptr - buffer.data());
-
-        // Save NaN/Inf cases as strings, since JSON spec doesn't include IEEE 754.
-        // (!) May result in non-homogenous arrays like [ 1.0, "inf" , 3.0, 4.0, "nan" ]
-        if (std::isfinite(number_value)) {
-            chars.append(buffer.data(), number_end_ptr - buffer.data());
-        } else {
-            chars += '"';
-            chars.append(buffer.data(), number_end_ptr - buffer.data());
-            chars += '"';
-        }
+    else if (auto* ptr = node.template get_if<Number>()) {
+        _serialize_number(chars, *ptr);
     }
     // Bool
-    else if (auto* ptr = node.get_if<Bool>()) {
+    else if (auto* ptr = node.template get_if<Bool>()) {
         const auto& bool_value = *ptr;
         chars += (bool_value ? "true" : "false");
     }
     // Null
-    else if (node.is<Null>()) {
+    else if (node.template is<Null>()) {
         chars += "null";
     }
 }
 
-inline void _serialize_json_to_buffer(std::string& chars, const Node& node, Format format) {
-    if (format == Format::PRETTY) _serialize_json_recursion<true>(node, chars);
-    else _serialize_json_recursion<false>(node, chars);
+template <class NodeType>
+void _serialize_json_to_buffer(std::string& chars, const NodeType& node, Format format) {
+    _string_sink sink;
+    if (format == Format::PRETTY) _serialize_json_recursion<true>(node, chars, sink);
+    else _serialize_json_recursion<false>(node, chars, sink);
+}
+
+template <class NodeType, class Callback>
+void _serialize_json_to_callback(Callback& callback, const NodeType& node, Format format) {
+    std::string chars;
+    chars.reserve(_sink_buffer_size + _sink_buffer_size / 4); // leave some room for the overshoot
+
+    _callback_sink<Callback> sink{callback};
+    if (format == Format::PRETTY) _serialize_json_recursion<true>(node, chars, sink);
+    else _serialize_json_recursion<false>(node, chars, sink);
+    sink.flush(chars);
 }
 
 // ===============================
 // --- JSON Parsing public API ---
 // ===============================
 
-[[nodiscard]] inline Node from_string(const std::string& chars,
-                                      unsigned int       recursion_limit = _default_recursion_limit) {
-    _parser           parser(chars, recursion_limit);
-    const std::size_t json_start = parser.skip_nonsignificant_whitespace(0); // skip leading whitespace
-    auto [end_cursor, node]      = parser.parse_node(json_start); // starts parsing recursively from the root node
-
-    // Check for invalid trailing symbols
-    using namespace std::string_literals;
-
-    for (auto cursor = end_cursor; cursor < chars.size(); ++cursor)
-        if (!_lookup_whitespace_chars[_u8(chars[cursor])])
-            throw std::runtime_error("Invalid trailing symbols encountered after the root JSON node at pos "s +
-                                     std::to_string(cursor) + "."s + _pretty_error(cursor, chars));
+// Base for SAX handlers, provides no-op callbacks for all of the events,
+// which means derived handlers only need to define the events they care about
+struct SaxHandler {
+    void on_object_begin() {}
+    void on_object_end() {}
+    void on_array_begin() {}
+    void on_array_end() {}
+    void on_key(std::string_view) {}
+    void on_string(std::string_view) {}
+    void on_number(Number) {}
+    void on_bool(Bool) {}
+    void on_null() {}
+};
 
-    return std::move(node); // implicit tuple blocks copy elision, we have to move() manually
+template <class Handler>
+void sax_from_string(std::string_view chars, Handler& handler,
+                     unsigned int recursion_limit = _default_recursion_limit) {
+    _sax_parser<Handler> parser(chars, recursion_limit, handler);
+    parser.parse_root();
+}
 
-    // Note: Some code analyzers detect 'return std::move(node)' as a performance issue, it is
-    //       not, NOT having 'std::move()' on the other hand is very much a performance issue
+template <class NodeType = Node>
+[[nodiscard]] NodeType from_string(const std::string& chars, unsigned int recursion_limit = _default_recursion_limit) {
+    _node_builder<NodeType> builder(chars);
+    sax_from_string(chars, builder, recursion_limit);
+    return builder.result();
+}
+[[nodiscard]] inline ArenaNode from_string(const std::string& chars, Arena& arena,
+                                           unsigned int recursion_limit = _default_recursion_limit) {
+    _node_builder<ArenaNode> builder(chars, arena);
+    sax_from_string(chars, builder, recursion_limit);
+    return builder.result();
 }
-[[nodiscard]] inline Node from_file(const std::string& filepath,
-                                    unsigned int       recursion_limit = _default_recursion_limit) {
+
+template <class NodeType = Node>
+[[nodiscard]] NodeType from_file(const std::string& filepath, unsigned int recursion_limit = _default_recursion_limit) {
     const std::string chars = _read_file_to_string(filepath);
-    return from_string(chars, recursion_limit);
+    return from_string<NodeType>(chars, recursion_limit);
+}
+
+[[nodiscard]] inline ViewDocument view_from_string(std::string_view chars,
+                                                  unsigned int     recursion_limit = _default_recursion_limit) {
+    Arena               arena;
+    _node_builder<View> builder(chars, {}, &arena);
+    sax_from_string(chars, builder, recursion_limit);
+    return ViewDocument(builder.result(), std::move(arena));
 }
 
+template <class T, std::enable_if_t<std::is_same_v<std::remove_cv_t<T>, std::string> &&
+                                        !std::is_lvalue_reference_v<T>,
+                                    bool> = true>
+ViewDocument view_from_string(T&& chars, unsigned int recursion_limit = _default_recursion_limit) = delete;
+// views reference the parsed buffer, parsing a temporary string (const or not) would leave them dangling
+
+// Incremental parser for input that arrives in chunks (sockets, pipes, log streams). Input can contain any number of
+// whitespace-separated top-level values (NDJSON, concatenated JSON, or just a single document), every value gets
+// passed to the callback as soon as its last chunk arrives.
+//
+// Resumable parsing is done at the granularity of top-level values: incoming chunks go through a lightweight scanner
+// that only tracks nesting depth & string boundaries to detect where each value ends, complete values are then
+// parsed with the regular parser. This way only the current incomplete value is ever buffered, while validation
+// and error messages stay exactly the same as with 'from_string()'.
+class StreamParser {
+public:
+    using callback_type = std::function<void(Node&&)>;
+
+private:
+    callback_type callback;
+    unsigned int  recursion_limit;
+
+    std::string buffer;          // unprocessed input, starts with the current incomplete value (if there is one)
+    std::size_t cursor      = 0; // everything in the 'buffer' before the cursor was already scanned
+    std::size_t value_start = 0; // start of the current incomplete value in the 'buffer'
+
+    // Scanner state
+    bool        in_value  = false;
+    bool        in_scalar = false; // numbers, bools & nulls can only end on a delimiter
+    bool        in_string = false;
+    bool        escaped   = false;
+    std::size_t depth     = 0;
+
+    [[nodiscard]] static bool is_delimiter(char c) noexcept {
+        return _lookup_whitespace_chars[_u8(c)] || c == '{' || c == '}' || c == '[' || c == ']' || c == ',' ||
+               c == '"';
+    }
+
+    void reset_scanner() noexcept {
+        this->in_value  = false;
+        this->in_scalar = false;
+        this->in_string = false;
+        this->escaped   = false;
+        this->depth     = 0;
+    }
+
+    void emit(std::string_view value) {
+        _node_builder<Node> builder(value);
+        sax_from_string(value, builder, this->recursion_limit);
+        this->callback(builder.result());
+    }
+
+    void emit_current_value(std::size_t value_end) {
+        this->reset_scanner(); // invalid value shouldn't prevent us from parsing the following ones
+        this->emit(std::string_view(this->buffer).substr(this->value_start, value_end - this->value_start));
+    }
+
+    // Scans the whole buffer, an invalid value doesn't stop the scan since the scanner is already past it,
+    // the first error gets returned to be rethrown once the following values were processed
+    [[nodiscard]] std::exception_ptr scan() {
+        std::exception_ptr error;
+
+        const auto try_emit = [&](std::size_t value_end) {
+            try {
+                this->emit_current_value(value_end);
+            } catch (...) {
+                if (!error) error = std::current_exception();
+            }
+        };
+
+        while (this->cursor < this->buffer.size()) {
+            const char c = this->buffer[this->cursor];
+
+            // Skip whitespace between the values, first significant symbol determines the kind of value
+            if (!this->in_value) {
+                if (!_lookup_whitespace_chars[_u8(c)]) {
+                    this->in_value    = true;
+                    this->value_start = this->cursor;
+
+                    if (c == '{' || c == '[') this->depth = 1;
+                    else if (c == '"') this->in_string = true;
+                    else this->in_scalar = true;
+                }
+                ++this->cursor;
+                continue;
+            }
+
+            // Scalars end right before the delimiter, which can be the start of the next value
+            if (this->in_scalar) {
+                if (is_delimiter(c)) try_emit(this->cursor);
+                else ++this->cursor;
+                continue;
+            }
+
+            ++this->cursor;
+
+            // Strings & containers end right after their closing symbol
+            if (this->in_string) {
+                if (this->escaped) this->escaped = false;
+                else if (c == '\\') this->escaped = true;
+                else if (c == '"') {
+                    this->in_string = false;
+                    if (this->depth == 0) try_emit(this->cursor);
+                }
+            } else if (c == '"') {
+                this->in_string = true;
+            } else if (c == '{' || c == '[') {
+                ++this->depth;
+            } else if (c == '}' || c == ']') {
+                if (--this->depth == 0) try_emit(this->cursor);
+                // mismatched brackets are left for the parser to report
+            }
+        }
+
+        return error;
+    }
+
+public:
+    explicit StreamParser(callback_type callback, unsigned int recursion_limit = _default_recursion_limit)
+        : callback(std::move(callback)), recursion_limit(recursion_limit) {}
+
+    void feed(std::string_view chunk) {
+        this->buffer += chunk;
+        const std::exception_ptr error = this->scan();
+
+        // Drop the input that was fully processed, this keeps the buffer bounded by the size of a single value
+        const std::size_t processed = this->in_value ? this->value_start : this->cursor;
+        this->buffer.erase(0, processed);
+        this->cursor -= processed;
+        if (this->in_value) this->value_start = 0;
+
+        if (error) std::rethrow_exception(error);
+    }
+
+    void finish() {
+        // Whatever remains must be a complete value, incomplete strings
+        // & containers will be rejected by the parser with a proper error
+        const std::string remaining   = std::move(this->buffer);
+        const bool        has_value   = this->in_value;
+        const std::size_t value_start = this->value_start;
+
+        this->buffer.clear();
+        this->cursor      = 0;
+        this->value_start = 0;
+        this->reset_scanner();
+
+        if (has_value) this->emit(std::string_view(remaining).substr(value_start));
+    }
+};
+
 namespace literals {
 [[nodiscard]] inline Node operator""_utl_json(const char* c_str, std::size_t c_str_size) {
     return from_string(std::string(c_str, c_str_size));
@@ -1588,6 +2708,108 @@ void _assign_value_to_node(Node& node, const T& value) {
 
 #define utl_json_from_struct_assign(fieldname_) _assign_value_to_node(json[#fieldname_], val.fieldname_);
 
+// --- direct serialization utils ---
+// ----------------------------------
+
+// 'from_struct(value).to_string()' builds a whole tree of nodes (with all the map insertions and string copies)
+// only to immediately throw it away after serializing. For reflected structs we know the layout at compile time,
+// which means fields can be written straight into the output buffer using the same formatting as the regular
+// serializer. Field names are identifiers and never need escaping, the macro bakes them into quoted literals.
+
+template <class T>
+struct _struct_serializer {
+    static_assert(_always_false_v<T>,
+                  "Provided type doesn't have a defined JSON reflection. Use 'UTL_JSON_REFLECT' macro to define one.");
+};
+// specializations that do the actual work are generated by 'UTL_JSON_REFLECT'
+
+constexpr std::size_t _indent_level_size = 4;
+
+template <bool prettify, class T>
+void _serialize_value(std::string& chars, const T& value, unsigned int indent_level) {
+    // same conversion priority as 'Node::operator=()': string > object > array > bool > null > numeric
+    if constexpr (is_string_like_v<T>) _serialize_string(chars, value);
+    else if constexpr (is_object_like_v<T>) {
+        if (value.begin() == value.end()) {
+            chars += "{}";
+            return;
+        }
+
+        chars += '{';
+        bool first = true;
+        for (const auto& [key, val] : value) {
+            if (!first) chars += ',';
+            first = false;
+            if constexpr (prettify) {
+                chars += '\n';
+                chars.append(_indent_level_size * (indent_level + 1), ' ');
+            }
+            _serialize_string(chars, key);
+            if constexpr (prettify) chars += ": ";
+            else chars += ':';
+            _serialize_value<prettify>(chars, val, indent_level + 1);
+        }
+        if constexpr (prettify) {
+            chars += '\n';
+            chars.append(_indent_level_size * indent_level, ' ');
+        }
+        chars += '}';
+    } else if constexpr (is_array_like_v<T>) {
+        if (value.begin() == value.end()) {
+            chars += "[]";
+            return;
+        }
+
+        chars += '[';
+        bool first = true;
+        for (const auto& elem : value) {
+            if (!first) chars += ',';
+            first = false;
+            if constexpr (prettify) {
+                chars += '\n';
+                chars.append(_indent_level_size * (indent_level + 1), ' ');
+            }
+            _serialize_value<prettify>(chars, elem, indent_level + 1);
+        }
+        if constexpr (prettify) {
+            chars += '\n';
+            chars.append(_indent_level_size * indent_level, ' ');
+        }
+        chars += ']';
+    } else if constexpr (is_bool_like_v<T>) chars += (value ? "true" : "false");
+    else if constexpr (is_null_like_v<T>) chars += "null";
+    else if constexpr (is_numeric_like_v<T>) _serialize_number(chars, static_cast<_number_type_impl>(value));
+    else if constexpr (_is_reflected_struct<T>)
+        _struct_serializer<T>::template serialize<prettify>(chars, value, indent_level);
+    else static_assert(_always_false_v<T>, "Could not resolve recursive conversion from 'T' to JSON.");
+}
+
+// 'key' is a pre-quoted literal like '"fieldname"'
+template <bool prettify, std::size_t N, class T>
+void _serialize_struct_field(std::string& chars, const char (&key)[N], const T& value, unsigned int indent_level,
+                             bool& first) {
+    if (!first) chars += ',';
+    first = false;
+    if constexpr (prettify) {
+        chars += '\n';
+        chars.append(_indent_level_size * (indent_level + 1), ' ');
+    }
+    chars.append(key, N - 1);
+    if constexpr (prettify) chars += ": ";
+    else chars += ':';
+    _serialize_value<prettify>(chars, value, indent_level + 1);
+}
+
+#define utl_json_serialize_struct_field(fieldname_)                                                                    \
+    utl::json::_serialize_struct_field<prettify>(chars, "\"" #fieldname_ "\"", val.fieldname_, indent_level, first);
+
+// Appends JSON serialized from 'value' to 'chars', the buffer can be reused between calls to avoid reallocation
+template <class T>
+void to_json_string(const T& value, std::string& chars, Format format = Format::PRETTY) {
+    if (format == Format::PRETTY) _serialize_value<true>(chars, value, 0);
+    else _serialize_value<false>(chars, value, 0);
+}
+
 // --- to-struct utils ---
 // -----------------------
 
@@ -1599,10 +2821,10 @@ template <class T>
 void _assign_node_to_value_recursively(T& value, const Node& node) {
     if constexpr (is_string_like_v<T>) value = node.get_string();
     else if constexpr (is_object_like_v<T>) {
-        const auto object = node.get_object();
+        const auto& object = node.get_object();
         for (const auto& [key, val] : object) _assign_node_to_value_recursively(value[key], val);
     } else if constexpr (is_array_like_v<T>) {
-        const auto array = node.get_array();
+        const auto& array = node.get_array();
         value.resize(array.size());
         for (std::size_t i = 0; i < array.size(); ++i) _assign_node_to_value_recursively(value[i], array[i]);
     } else if constexpr (is_bool_like_v<T>) value = node.get_bool();
@@ -1618,7 +2840,7 @@ template <class T, std::size_t N>
 void _assign_node_to_value_recursively(std::array<T, N>& value, const Node& node) {
     using namespace std::string_literals;
 
-    const auto array = node.get_array();
+    const auto& array = node.get_array();
 
     if (array.size() != value.size())
         throw std::runtime_error("JSON to structure serializer encountered non-mathing std::array size of "s +
@@ -1633,6 +2855,211 @@ void _assign_node_to_value_recursively(std::array<T, N>& value, const Node& node
 // JSON might not have an entry corresponding to each structure member,
 // such members will stay defaulted according to the struct constructor
 
+// --- direct parsing utils ---
+// ----------------------------
+
+// 'from_string(chars).to_struct<T>()' parses the whole tree only to copy values out of it. Knowing the target
+// type lets us parse straight into it instead: known fields get parsed directly into the members, values
+// of unknown keys get validated & skipped by the regular SAX parser with a no-op handler.
+
+template <class T>
+struct _struct_deserializer {
+    static_assert(_always_false_v<T>,
+                  "Provided type doesn't have a defined JSON reflection. Use 'UTL_JSON_REFLECT' macro to define one.");
+};
+// specializations that do the actual work are generated by 'UTL_JSON_REFLECT'
+
+struct _struct_parser {
+    SaxHandler              skipper; // handler for the values we don't need
+    _sax_parser<SaxHandler> parser;
+
+    _struct_parser(std::string_view chars, unsigned int recursion_limit) : parser(chars, recursion_limit, skipper) {}
+
+    [[noreturn]] void throw_type_error(std::size_t cursor, std::string_view expected) const {
+        using namespace std::string_literals;
+
+        throw std::runtime_error("JSON to structure parser encountered unexpected symbol {"s +
+                                 this->parser.chars[cursor] + "} at pos "s + std::to_string(cursor) + ", expected "s +
+                                 std::string(expected) + " value."s + _pretty_error(cursor, this->parser.chars));
+    }
+
+    // Calls 'parse_pair(cursor, key)' for every pair of the object starting at 'cursor'
+    template <class Func>
+    std::size_t parse_object(std::size_t cursor, Func&& parse_pair) {
+        using namespace std::string_literals;
+
+        if (this->parser.chars[cursor] != '{') this->throw_type_error(cursor, "object");
+        ++cursor; // move past the opening brace '{'
+
+        cursor = this->parser.skip_nonsignificant_whitespace(cursor);
+        if (this->parser.chars[cursor] == '}') return cursor + 1;
+
+        while (true) {
+            if (this->parser.chars[cursor] != '"')
+                throw std::runtime_error("JSON object node encountered unexpected symbol {"s +
+                                         this->parser.chars[cursor] + "} instead of the pair key at pos "s +
+                                         std::to_string(cursor) + "."s + _pretty_error(cursor, this->parser.chars));
+
+            std::string_view key;
+            std::tie(cursor, key) = this->parser.parse_string(cursor);
+            // 'key' may point into the reusable parser buffer, 'parse_pair()' has to use it before parsing the value
+
+            cursor = this->parser.skip_nonsignificant_whitespace(cursor);
+            if (this->parser.chars[cursor] != ':')
+                throw std::runtime_error("JSON object node encountered unexpected symbol {"s +
+                                         this->parser.chars[cursor] + "} after the pair key at pos "s +
+                                         std::to_string(cursor) + " (should be {:})."s +
+                                         _pretty_error(cursor, this->parser.chars));
+            ++cursor; // move past the colon ':'
+            cursor = this->parser.skip_nonsignificant_whitespace(cursor);
+
+            this->parser.enter_nested_node();
+            cursor = parse_pair(cursor, key);
+            this->parser.leave_nested_node();
+
+            cursor = this->parser.skip_nonsignificant_whitespace(cursor);
+            const char c = this->parser.chars[cursor];
+
+            if (c == '}') return cursor + 1;
+            if (c != ',')
+                throw std::runtime_error(
+                    "JSON object node could not find comma {,} or object ending symbol {}} after the element at pos "s +
+                    std::to_string(cursor) + "."s + _pretty_error(cursor, this->parser.chars));
+            ++cursor; // move past the comma ','
+            cursor = this->parser.skip_nonsignificant_whitespace(cursor);
+        }
+    }
+
+    // Calls 'parse_element(cursor, index)' for every element of the array starting at 'cursor'
+    template <class Func>
+    std::size_t parse_array(std::size_t cursor, Func&& parse_element) {
+        using namespace std::string_literals;
+
+        if (this->parser.chars[cursor] != '[') this->throw_type_error(cursor, "array");
+        ++cursor; // move past the opening bracket '['
+
+        cursor = this->parser.skip_nonsignificant_whitespace(cursor);
+        if (this->parser.chars[cursor] == ']') return cursor + 1;
+
+        for (std::size_t index = 0;; ++index) {
+            this->parser.enter_nested_node();
+            cursor = parse_element(cursor, index);
+            this->parser.leave_nested_node();
+
+            cursor       = this->parser.skip_nonsignificant_whitespace(cursor);
+            const char c = this->parser.chars[cursor];
+
+            if (c == ']') return cursor + 1;
+            if (c != ',')
+                throw std::runtime_error(
+                    "JSON array node could not find comma {,} or array ending symbol {]} after the element at pos "s +
+                    std::to_string(cursor) + "."s + _pretty_error(cursor, this->parser.chars));
+            ++cursor; // move past the comma ','
+            cursor = this->parser.skip_nonsignificant_whitespace(cursor);
+        }
+    }
+
+    // Parses value starting at 'cursor' into 'value', same conversions as '_assign_node_to_value_recursively()'
+    template <class T>
+    std::size_t parse_value(std::size_t cursor, T& value) {
+        const char c = this->parser.chars[cursor];
+
+        if constexpr (is_string_like_v<T>) {
+            if (c != '"') this->throw_type_error(cursor, "string");
+            std::string_view string_value;
+            std::tie(cursor, string_value) = this->parser.parse_string(cursor);
+            value                          = string_value;
+            return cursor;
+        } else if constexpr (is_object_like_v<T>) {
+            value.clear();
+            return this->parse_object(cursor, [&](std::size_t pair_cursor, std::string_view key) {
+                const auto [it, inserted] = value.try_emplace(typename T::key_type(key));
+                if (!inserted) return this->parser.parse_node(pair_cursor); // first duplicate wins, same as 'Node'
+                return this->parse_value(pair_cursor, it->second);
+            });
+        } else if constexpr (is_array_like_v<T>) {
+            value.clear();
+            return this->parse_array(cursor, [&](std::size_t element_cursor, std::size_t) {
+                return this->parse_value(element_cursor, value.emplace_back());
+            });
+        } else if constexpr (is_bool_like_v<T>) {
+            if (c == 't') std::tie(cursor, value) = this->parser.parse_true(cursor);
+            else if (c == 'f') std::tie(cursor, value) = this->parser.parse_false(cursor);
+            else this->throw_type_error(cursor, "bool");
+            return cursor;
+        } else if constexpr (is_null_like_v<T>) {
+            if (c != 'n') this->throw_type_error(cursor, "null");
+            std::tie(cursor, value) = this->parser.parse_null(cursor);
+            return cursor;
+        } else if constexpr (is_numeric_like_v<T>) {
+            if (!(('0' <= c && c <= '9') || (c == '-'))) this->throw_type_error(cursor, "number");
+            _number_type_impl number_value;
+            std::tie(cursor, number_value) = this->parser.parse_number(cursor);
+            value                          = static_cast<T>(number_value);
+            return cursor;
+        } else if constexpr (_is_reflected_struct<T>) {
+            std::array<bool, _struct_deserializer<T>::field_count> parsed_fields{};
+            return this->parse_object(cursor, [&](std::size_t pair_cursor, std::string_view key) {
+                std::size_t field_end = pair_cursor;
+                if (_struct_deserializer<T>::parse_field(*this, field_end, key, value, parsed_fields.data()))
+                    return field_end;
+                return this->parser.parse_node(pair_cursor); // skips unknown keys & repeated fields
+            });
+        } else static_assert(_always_false_v<T>, "Method is a non-exhaustive visitor of std::variant<>.");
+    }
+
+    // Not sure how to generically handle array-like types with compile-time known size,
+    // so we're just going to make a special case for 'std::array'
+    template <class T, std::size_t N>
+    std::size_t parse_value(std::size_t cursor, std::array<T, N>& value) {
+        using namespace std::string_literals;
+
+        std::size_t size = 0;
+        cursor = this->parse_array(cursor, [&](std::size_t element_cursor, std::size_t index) {
+            if (index >= N)
+                throw std::runtime_error("JSON to structure serializer encountered non-mathing std::array size of "s +
+                                         std::to_string(N) + ", corresponding node has more elements."s);
+            ++size;
+            return this->parse_value(element_cursor, value[index]);
+        });
+
+        if (size != N)
+            throw std::runtime_error("JSON to structure serializer encountered non-mathing std::array size of "s +
+                                     std::to_string(N) + ", corresponding node has a size of "s +
+                                     std::to_string(size) + "."s);
+
+        return cursor;
+    }
+};
+
+#define utl_json_declare_struct_field(fieldname_) char fieldname_;
+
+#define utl_json_parse_struct_field(fieldname_)                                                                        \
+    if (key == #fieldname_) {                                                                                          \
+        constexpr std::size_t field = offsetof(field_list, fieldname_);                                                \
+        if (parsed_fields[field]) return false; /* first duplicate wins, same as 'from_string().to_struct()' */        \
+        parsed_fields[field] = true;                                                                                   \
+        cursor               = parser.parse_value(cursor, val.fieldname_);                                             \
+        return true;                                                                                                   \
+    }
+
+// Parses JSON from 'chars' straight into a reflected struct, JSON keys that don't correspond
+// to any field are skipped, fields that have no corresponding key stay value-initialized
+template <class T>
+[[nodiscard]] T from_json_string(std::string_view chars, unsigned int recursion_limit = _default_recursion_limit) {
+    static_assert(_is_reflected_struct<T>,
+                  "Provided type doesn't have a defined JSON reflection. Use 'UTL_JSON_REFLECT' macro to define one.");
+
+    T              value{};
+    _struct_parser parser(chars, recursion_limit);
+
+    const std::size_t json_start = parser.parser.skip_nonsignificant_whitespace(0);
+    const std::size_t end_cursor = parser.parse_value(json_start, value);
+    parser.parser.check_trailing_symbols(end_cursor);
+
+    return value;
+}
+
 // --- Codegen ---
 // ---------------
 
@@ -1650,6 +3077,7 @@ void _assign_node_to_value_recursively(std::array<T, N>& value, const Node& node
     }                                                                                                                  \
                                                                                                                        \
     template <>                                                                                                        \
+    template <>                                                                                                        \
     inline auto utl::json::Node::to_struct<struct_name_>() const->struct_name_ {                                       \
         struct_name_ val;                                                                                              \
         /* map 'val.<FIELDNAME> = this->at("<FIELDNAME>").get<decltype(val.<FIELDNAME>)>();' */                        \
@@ -1657,10 +3085,45 @@ void _assign_node_to_value_recursively(std::array<T, N>& value, const Node& node
         return val;                                                                                                    \
     }                                                                                                                  \
                                                                                                                        \
+    template <>                                                                                                        \
+    struct utl::json::_struct_deserializer<struct_name_> {                                                             \
+        /* one 'char' per field, offset of a member is the index of the corresponding field */                         \
+        struct field_list {                                                                                            \
+            utl_json_map(utl_json_declare_struct_field, __VA_ARGS__);                                                  \
+        };                                                                                                             \
+        constexpr static std::size_t field_count = sizeof(field_list);                                                 \
+                                                                                                                       \
+        static bool parse_field(utl::json::_struct_parser& parser, std::size_t& cursor, std::string_view key,          \
+                                struct_name_& val, bool* parsed_fields) {                                              \
+            /* map 'if (key == "<FIELDNAME>") { <parse into 'val.<FIELDNAME>'>; return true; }' */                     \
+            utl_json_map(utl_json_parse_struct_field, __VA_ARGS__);                                                    \
+            return false;                                                                                              \
+        }                                                                                                              \
+    };                                                                                                                 \
+                                                                                                                       \
+    template <>                                                                                                        \
+    struct utl::json::_struct_serializer<struct_name_> {                                                               \
+        template <bool prettify>                                                                                       \
+        static void serialize(std::string& chars, const struct_name_& val, unsigned int indent_level) {                \
+            bool first = true;                                                                                         \
+            chars += '{';                                                                                              \
+            /* map '_serialize_struct_field<prettify>(chars, "<FIELDNAME>", val.<FIELDNAME>, ...);' */                 \
+            utl_json_map(utl_json_serialize_struct_field, __VA_ARGS__);                                                \
+            if constexpr (prettify) {                                                                                  \
+                chars += '\n';                                                                                         \
+                chars.append(utl::json::_indent_level_size * indent_level, ' ');                                       \
+            }                                                                                                          \
+            chars += '}';                                                                                              \
+        }                                                                                                              \
+    };                                                                                                                 \
+                                                                                                                       \
     static_assert(true)
 
 
 } // namespace utl::json
 
+#undef utl_json_simd_avx2
+#undef utl_json_simd_sse2
+
 #endif
 #endif // module utl::json
\ No newline at end of file
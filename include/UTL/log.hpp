@@ -14,29 +14,38 @@
 
 // _______________________ INCLUDES _______________________
 
-#include <array>         // array<>
-#include <charconv>      // to_chars()
-#include <chrono>        // steady_clock
-#include <cstddef>       // size_t
-#include <exception>     // exception
-#include <fstream>       // ofstream
-#include <iostream>      // cout
-#include <iterator>      // next()
-#include <limits>        // numeric_limits<>
-#include <list>          // list<>
-#include <mutex>         // lock_guard<>, mutex
-#include <ostream>       // ostream
-#include <sstream>       // std::ostringstream
-#include <stdexcept>     // std::runtime_error
-#include <string>        // string
-#include <string_view>   // string_view
-#include <system_error>  // errc()
-#include <thread>        // this_thread::get_id()
-#include <tuple>         // tuple_size<>
-#include <type_traits>   // is_integral_v<>, is_floating_point_v<>, is_same_v<>, is_convertible_to_v<>
-#include <unordered_map> // unordered_map<>
-#include <utility>       // forward<>()
-#include <variant>       // variant<>
+#include <algorithm>          // min(), max(), find_if(), any_of(), remove_if()
+#include <array>              // array<>
+#include <atomic>             // atomic<>
+#include <charconv>           // to_chars()
+#include <chrono>             // steady_clock
+#include <condition_variable> // condition_variable
+#include <cstddef>            // size_t, ptrdiff_t
+#include <cstdint>            // uint32_t
+#include <cstring>            // memcpy(), memset()
+#include <ctime>              // time_t, time()
+#include <deque>              // deque<>
+#include <exception>          // exception
+#include <fstream>            // ofstream
+#include <future>             // promise<>
+#include <iostream>           // cout
+#include <iterator>           // next()
+#include <limits>             // numeric_limits<>
+#include <list>               // list<>
+#include <memory>             // unique_ptr<>, make_unique<>()
+#include <mutex>              // lock_guard<>, mutex
+#include <ostream>            // ostream
+#include <sstream>            // std::ostringstream
+#include <stdexcept>          // std::runtime_error
+#include <string>             // string
+#include <string_view>        // string_view
+#include <system_error>       // errc()
+#include <thread>             // thread, this_thread::yield()
+#include <tuple>              // tuple_size<>
+#include <type_traits>        // is_integral_v<>, is_floating_point_v<>, is_same_v<>, is_convertible_to_v<>
+#include <utility>            // forward<>(), move(), swap(), pair<>
+#include <variant>            // variant<>
+#include <vector>             // vector<>
 
 // ____________________ DEVELOPER DOCS ____________________
 
@@ -57,7 +66,15 @@
 //
 //       Note: I did try using a stripped down version of 'utl::parallel::ThreadPool' to upload tasks
 //             for flushing the buffer, it generally improves performance by ~30%, however I decided it
-//             is not worth the added complexity & cpu usage for that little gain
+//             is not worth the added complexity & cpu usage for that little gain.
+//
+//             This is now available as an opt-in async mode (see 'enable_async()'), producers stringify
+//             the message & push it into a lock-free ring, a background thread formats columns & does I/O.
+//             For multi-threaded logging into files the gain is a lot more noticeable than 30%, since
+//             producers no longer contend on the sink mutex while somebody else is stuck in 'write()'.
+//
+//             Deferred mode (see 'enable_deferred()') goes a step further & moves stringification off the calling
+//             thread as well, producers only copy raw argument bytes into a per-thread buffer.
 //
 //    3. Platform-specific methods to query stuff like time & thread id with less overhead
 //
@@ -71,6 +88,9 @@
 //       the individual sinks, I don't see a way of making style checks here constexpr, but in the end
 //       that would be a proper solution.
 //
+//       This is now mostly done, the logger queries time & thread only if some sink needs them, stringifies
+//       arguments once into a '_record' and sinks with identical decoration share a single formatted line.
+//
 
 // ____________________ IMPLEMENTATION ____________________
 
@@ -93,17 +113,12 @@ auto _available_localtime_impl(TimeMoment time_moment, TimeType timer)
     return localtime_r(std::forward<TimeType>(timer), std::forward<TimeMoment>(time_moment));
 }
 
-inline std::size_t _get_thread_index(const std::thread::id id) {
-    static std::mutex     mutex;
-    const std::lock_guard lock(mutex);
-
-    static std::unordered_map<std::thread::id, std::size_t> thread_ids;
-    static std::size_t                                      next_id = 0;
-
-    const auto it = thread_ids.find(id);
-    if (it == thread_ids.end()) return thread_ids[id] = next_id++;
-    return it->second;
-    // this map effectively "demangles" platform-specific IDs into human-readable IDs (0, 1, 2, ...)
+// Effectively "demangles" platform-specific thread IDs into human-readable IDs (0, 1, 2, ...) in the order
+// of first use, each thread only touches the shared counter once & then reads its own 'thread_local' copy
+inline std::size_t _get_thread_index() noexcept {
+    static std::atomic<std::size_t> next_index{0};
+    thread_local const std::size_t  index = next_index.fetch_add(1, std::memory_order_relaxed);
+    return index;
 }
 
 template <class IntType, std::enable_if_t<std::is_integral<IntType>::value, bool> = true>
@@ -544,6 +559,18 @@ struct MessageMetadata {
     Verbosity verbosity;
 };
 
+// Everything needed to format a message, captured once on the calling thread & shared by all sinks
+struct _record {
+    Callsite          callsite{};
+    Verbosity         verbosity = Verbosity::TRACE;
+    clock::time_point now{};
+    std::time_t       time   = 0;
+    std::size_t       thread = 0;
+    std::string       message; // stringified arguments, without column delimiters
+
+    std::promise<void>* flushed = nullptr; // set for 'flush()' barriers, which carry no message
+};
+
 constexpr bool operator<(Verbosity l, Verbosity r) { return static_cast<int>(l) < static_cast<int>(r); }
 constexpr bool operator<=(Verbosity l, Verbosity r) { return static_cast<int>(l) <= static_cast<int>(r); }
 
@@ -638,6 +665,16 @@ constexpr std::string_view _color_err   = color::bold_red;
 // --- Sink class ---
 // ==================
 
+// Highest verbosity accepted by any sink, lets logging macros reject a message before evaluating its arguments.
+// Recomputed every time sinks or their verbosity change, default sink accepts everything.
+inline std::atomic<Verbosity> _max_verbosity{Verbosity::TRACE};
+
+inline void _update_max_verbosity();
+
+[[nodiscard]] inline bool _is_enabled(Verbosity verbosity) noexcept {
+    return verbosity <= _max_verbosity.load(std::memory_order_relaxed);
+}
+
 class Sink {
 private:
     using os_ref_wrapper = std::reference_wrapper<std::ostream>;
@@ -674,6 +711,7 @@ class Sink {
     // We want a way of changing sink options using its handle / reference returned by the logger
     Sink& set_verbosity(Verbosity verbosity) {
         this->verbosity = verbosity;
+        _update_max_verbosity();
         return *this;
     }
     Sink& set_colors(Colors colors) {
@@ -693,41 +731,29 @@ class Sink {
         return *this;
     }
 
-private:
-    template <class... Args>
-    void format(const Callsite& callsite, const MessageMetadata& meta, const Args&... args) {
-        if (meta.verbosity > this->verbosity) return;
-
-        thread_local std::string buffer;
-
-        const clock::time_point now = clock::now();
-
-        // To minimize logging overhead we use string buffer, append characters to it and then write the whole buffer
-        // to `std::ostream`. This avoids the inherent overhead of ostream formatting (caused largely by
-        // virtualization, syncronization and locale handling, neither of which are relevant for the logger).
-        //
-        // This buffer gets reused between calls. Note the 'thread_local', if buffer was just a class member, multiple
-        // threads could fight trying to clear and resize the buffer while it's being written to by another thread.
-        //
-        // Buffer may grow when formatting a message longer that any one that was formatted before, otherwise we just
-        // reuse the reserved memory and no new allocations take place.
-
-        buffer.clear();
+    void flush() {
+        const std::lock_guard ostream_lock(this->ostream_mutex);
+        this->ostream_ref().flush();
+    }
 
-        // Print log header on the first call
-        {
-            static std::mutex     header_mutex;
-            const std::lock_guard lock(header_mutex);
-            if (this->print_header) {
-                this->print_header = false;
-                this->format_header(buffer);
-            }
-            // no need to lock the buffer, other threads can't reach buffer
-            // output code while they're stuck waiting for the header to print
-        }
+private:
+    // Sinks with the same decoration produce identical lines & can share the formatted result
+    [[nodiscard]] bool same_decoration(const Sink& other) const noexcept {
+        const Columns& l = this->columns;
+        const Columns& r = other.columns;
+        return this->colors == other.colors && l.datetime == r.datetime && l.uptime == r.uptime &&
+               l.thread == r.thread && l.callsite == r.callsite && l.level == r.level && l.message == r.message;
+    }
 
+    // Decorates a message that was already captured & stringified by the logger, the same line can then be written
+    // to every sink with the same decoration.
+    //
+    // To minimize logging overhead we use string buffer, append characters to it and then write the whole buffer
+    // to `std::ostream`. This avoids the inherent overhead of ostream formatting (caused largely by
+    // virtualization, syncronization and locale handling, neither of which are relevant for the logger).
+    void format_line(std::string& buffer, const _record& record) const {
         // Format columns one-by-one
-        if (this->colors == Colors::ENABLE) switch (meta.verbosity) {
+        if (this->colors == Colors::ENABLE) switch (record.verbosity) {
             case Verbosity::ERR: buffer += _color_err; break;
             case Verbosity::WARN: buffer += _color_warn; break;
             case Verbosity::NOTE: buffer += _color_note; break;
@@ -736,19 +762,30 @@ class Sink {
             case Verbosity::TRACE: buffer += _color_trace; break;
             }
 
-        if (this->columns.datetime) this->format_column_datetime(buffer);
-        if (this->columns.uptime) this->format_column_uptime(buffer, now);
-        if (this->columns.thread) this->format_column_thread(buffer);
-        if (this->columns.callsite) this->format_column_callsite(buffer, callsite);
-        if (this->columns.level) this->format_column_level(buffer, meta.verbosity);
-        if (this->columns.message) this->format_column_message(buffer, args...);
+        if (this->columns.datetime) this->format_column_datetime(buffer, record.time);
+        if (this->columns.uptime) this->format_column_uptime(buffer, record.now);
+        if (this->columns.thread) this->format_column_thread(buffer, record.thread);
+        if (this->columns.callsite) this->format_column_callsite(buffer, record.callsite);
+        if (this->columns.level) this->format_column_level(buffer, record.verbosity);
+        if (this->columns.message) this->format_column_message(buffer, record.message);
 
         if (this->colors == Colors::ENABLE) buffer += _color_reset;
+    }
 
+    void write(const std::string& buffer, clock::time_point now) {
         // 'std::ostream' isn't guaranteed to be thread-safe, even through many implementations seem to have
         // some thread-safety built into `std::cout` the same cannot be said about a generic 'std::ostream'
         const std::lock_guard ostream_lock(this->ostream_mutex);
 
+        // Print log header on the first call, this only happens once so allocating a string here is fine
+        if (this->print_header) {
+            this->print_header = false;
+
+            std::string header;
+            this->format_header(header);
+            this->ostream_ref().write(header.data(), header.size());
+        }
+
         this->ostream_ref().write(buffer.data(), buffer.size());
 
         // flush every message immediately
@@ -762,7 +799,7 @@ class Sink {
         }
     }
 
-    void format_header(std::string& buffer) {
+    void format_header(std::string& buffer) const {
         if (this->colors == Colors::ENABLE) buffer += _color_heading;
         if (this->columns.datetime)
             append_stringified(buffer, _col_ld_datetime, PadRight{"date       time", _col_w_datetime},
@@ -779,24 +816,25 @@ class Sink {
         if (this->colors == Colors::ENABLE) buffer += _color_reset;
     }
 
-    void format_column_datetime(std::string& buffer) {
-        std::time_t timer = std::time(nullptr);
-        std::tm     time_moment{};
-
-        _available_localtime_impl(&time_moment, &timer);
-
-        // Format time straight into the buffer
-        std::array<char, _col_w_datetime + 1>
-            strftime_buffer; // size includes the null terminator added by 'strftime()'
-        std::strftime(strftime_buffer.data(), strftime_buffer.size(), "%Y-%m-%d %H:%M:%S", &time_moment);
+    void format_column_datetime(std::string& buffer, std::time_t timer) const {
+        // Date & time only change once a second, while 'localtime()' & 'strftime()' are rather slow (and might
+        // even lock on some platforms), so each thread keeps the last formatted value around and reuses it
+        thread_local std::time_t                            cached_timer = -1;
+        thread_local std::array<char, _col_w_datetime + 1> cached_datetime{}; // +1 for null added by 'strftime()'
+
+        if (timer != cached_timer) {
+            std::tm time_moment{};
+            _available_localtime_impl(&time_moment, &timer);
+            std::strftime(cached_datetime.data(), cached_datetime.size(), "%Y-%m-%d %H:%M:%S", &time_moment);
+            cached_timer = timer;
+        }
 
-        // strftime_buffer.back() = ' '; // replace null-terminator added by 'strftime()' with a space
         buffer += _col_ld_datetime;
-        buffer.append(strftime_buffer.data(), _col_w_datetime);
+        buffer.append(cached_datetime.data(), _col_w_datetime);
         buffer += _col_rd_datetime;
     }
 
-    void format_column_uptime(std::string& buffer, clock::time_point now) {
+    void format_column_uptime(std::string& buffer, clock::time_point now) const {
         const auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - _program_entry_time_point);
         const auto sec        = (elapsed_ms / 1000).count();
         const auto ms         = (elapsed_ms % 1000).count(); // is 'elapsed_ms - 1000 * full_seconds; faster?
@@ -819,19 +857,39 @@ class Sink {
         buffer += _col_rd_uptime;
     }
 
-    void format_column_thread(std::string& buffer) {
-        const auto thread_id       = _get_thread_index(std::this_thread::get_id());
-        const auto thread_id_width = _integer_digit_count(thread_id);
+    void format_column_thread(std::string& buffer, std::size_t thread_id) const {
+        // Thread index never changes for a given thread, so unless the records come from different threads
+        // (which only happens in async mode) the padded column can be reused as is
+        thread_local std::size_t cached_thread_id = std::size_t(-1);
+        thread_local std::string cached_column;
+
+        if (thread_id != cached_thread_id) {
+            const auto thread_id_width = _integer_digit_count(thread_id);
+
+            cached_column.clear();
+            cached_column += _col_ld_thread;
+            if (thread_id_width < _col_w_thread) cached_column.append(_col_w_thread - thread_id_width, ' ');
+            append_stringified(cached_column, thread_id);
+            cached_column += _col_rd_thread;
+            cached_thread_id = thread_id;
+        }
 
-        buffer += _col_ld_thread;
-        if (thread_id_width < _col_w_thread) buffer.append(_col_w_thread - thread_id_width, ' ');
-        append_stringified(buffer, thread_id);
-        buffer += _col_rd_thread;
+        buffer += cached_column;
     }
 
-    void format_column_callsite(std::string& buffer, const Callsite& callsite) {
+    void format_column_callsite(std::string& buffer, const Callsite& callsite) const {
+        // '__FILE__' of the same file is usually the same literal, which lets us skip the search for the last
+        // separator when consecutive messages come from the same file (which they usually do)
+        thread_local std::string_view cached_file;
+        thread_local std::string_view cached_filename;
+
+        if (callsite.file.data() != cached_file.data() || callsite.file.size() != cached_file.size()) {
+            cached_file     = callsite.file;
+            cached_filename = callsite.file.substr(callsite.file.find_last_of("/\\") + 1);
+        }
+
         // Get just filename from the full path
-        std::string_view filename = callsite.file.substr(callsite.file.find_last_of("/\\") + 1);
+        std::string_view filename = cached_filename;
 
         // Left-pad callsite to column width, trim first characters if it's too long
         if (filename.size() < _w_callsite_before_dot) buffer.append(_w_callsite_before_dot - filename.size(), ' ');
@@ -846,7 +904,7 @@ class Sink {
         buffer += _col_rd_callsite;
     }
 
-    void format_column_level(std::string& buffer, Verbosity level) {
+    void format_column_level(std::string& buffer, Verbosity level) const {
         buffer += _col_ld_level;
         switch (level) {
         case Verbosity::ERR: buffer += "  ERR"; break;
@@ -859,14 +917,609 @@ class Sink {
         buffer += _col_rd_level;
     }
 
-    template <class... Args>
-    void format_column_message(std::string& buffer, const Args&... args) {
+    void format_column_message(std::string& buffer, std::string_view message) const {
         buffer += _col_ld_message;
-        append_stringified(buffer, args...);
+        buffer += message;
         buffer += _col_rd_message;
     }
 };
 
+// =====================
+// --- Async backend ---
+// =====================
+
+// What producers do when the async queue is full:
+//    - 'BLOCK' - wait until the background thread frees up some space, no messages are lost
+//    - 'DROP'  - discard the message & count it, logging never waits
+//    - 'GROW'  - spill into an unbounded mutex-protected queue, logging never waits & no messages are lost,
+//                but memory usage is unbounded if producers are consistently faster than the sinks
+enum class Overflow { BLOCK, DROP, GROW };
+
+constexpr std::size_t default_async_capacity = 8192;
+
+constexpr std::size_t _cache_line_size = 64;
+
+// Bounded lock-free MPSC ring, a simplified version of Dmitry Vyukov's bounded MPMC queue.
+//
+// Every cell carries a sequence number that tells whose turn it is: 'pos' means free for the producer that
+// claims position 'pos', 'pos + 1' means filled & ready for the consumer. Producers claim positions with a CAS,
+// there is a single consumer so its position is a plain integer.
+//
+// Records are swapped in & out rather than moved, this way cells, producers & the consumer keep trading string
+// buffers with already reserved capacity and the steady state doesn't allocate at all.
+class _mpsc_ring {
+private:
+    struct alignas(_cache_line_size) Cell {
+        std::atomic<std::size_t> sequence;
+        _record                  record;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    std::size_t             mask;
+
+    alignas(_cache_line_size) std::atomic<std::size_t> enqueue_pos{0};
+    alignas(_cache_line_size) std::size_t dequeue_pos = 0; // only touched by the consumer
+
+public:
+    explicit _mpsc_ring(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity) size *= 2; // power of 2 sizes allow indexing with a mask
+
+        this->cells = std::make_unique<Cell[]>(size);
+        this->mask  = size - 1;
+        for (std::size_t i = 0; i < size; ++i) this->cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // On success 'record' receives an old record with unspecified contents, on failure it's left untouched
+    bool try_push(_record& record) {
+        std::size_t pos = this->enqueue_pos.load(std::memory_order_relaxed);
+
+        while (true) {
+            Cell&             cell     = this->cells[pos & this->mask];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto        diff     = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+
+            if (diff == 0) {
+                // 'seq_cst' pairs with the consumer going to sleep, see '_async_backend::consumer_main()'
+                if (this->enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_seq_cst,
+                                                            std::memory_order_relaxed)) {
+                    std::swap(cell.record, record);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) return false; // cell still holds a record from the previous lap => queue is full
+            else pos = this->enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // On success 'record' receives the oldest record, old contents of 'record' go back into the cell
+    bool try_pop(_record& record) {
+        Cell& cell = this->cells[this->dequeue_pos & this->mask];
+        if (cell.sequence.load(std::memory_order_acquire) != this->dequeue_pos + 1) return false;
+
+        std::swap(cell.record, record);
+        cell.sequence.store(this->dequeue_pos + this->mask + 1, std::memory_order_release);
+        ++this->dequeue_pos;
+        return true;
+    }
+
+    // Also true while some position is claimed but its record isn't published yet, consumer only
+    [[nodiscard]] bool empty() const { return this->enqueue_pos.load(std::memory_order_seq_cst) == this->dequeue_pos; }
+};
+
+// Writes record to the sinks, or flushes them if the record is a 'flush()' barrier, defined after the logger
+inline void _process_record(_record& record);
+
+class _async_backend {
+private:
+    _mpsc_ring ring;
+    Overflow   overflow;
+
+    std::mutex          overflow_mutex;
+    std::deque<_record> overflow_queue;     // used by 'Overflow::GROW' once the ring is full
+    std::atomic<bool>   overflowing{false}; // while set, producers bypass the ring so messages stay in order
+
+    std::atomic<std::size_t> dropped{0}; // used by 'Overflow::DROP'
+
+    std::mutex              wake_mutex;
+    std::condition_variable wake_cv;
+    std::atomic<bool>       consumer_sleeping{false}; // lets producers skip notification while consumer is awake
+    std::atomic<bool>       stopping{false};
+
+    std::thread consumer;
+
+    void wake_consumer() {
+        if (!this->consumer_sleeping.load(std::memory_order_seq_cst)) return;
+        { const std::lock_guard wake_lock(this->wake_mutex); }
+        this->wake_cv.notify_one();
+    }
+
+    // Overflow queue only contains messages newer than the ones in the ring, which is why we drain the ring first,
+    // producers keep bypassing the ring until the overflow queue is empty, which keeps per-thread message order
+    void drain_overflow(_record& record) {
+        std::deque<_record> batch;
+        {
+            const std::lock_guard overflow_lock(this->overflow_mutex);
+            batch.swap(this->overflow_queue);
+        }
+
+        while (this->ring.try_pop(record)) _process_record(record);
+        for (auto& overflow_record : batch) _process_record(overflow_record);
+
+        const std::lock_guard overflow_lock(this->overflow_mutex);
+        if (this->overflow_queue.empty()) this->overflowing.store(false, std::memory_order_seq_cst);
+    }
+
+    void consumer_main() {
+        _record record;
+
+        while (true) {
+            bool worked = false;
+
+            while (this->ring.try_pop(record)) {
+                _process_record(record);
+                worked = true;
+            }
+
+            if (this->overflowing.load(std::memory_order_seq_cst)) {
+                this->drain_overflow(record);
+                worked = true;
+            }
+
+            if (worked) continue;
+
+            if (!this->ring.empty()) { // some producer claimed a cell but hasn't filled it yet
+                std::this_thread::yield();
+                continue;
+            }
+
+            if (this->stopping) break; // everything is written at this point
+
+            // Producers publish with a 'seq_cst' CAS & then check 'consumer_sleeping', we set 'consumer_sleeping'
+            // & then check the ring, so either the producer sees us sleeping, or we see its message
+            std::unique_lock wake_lock(this->wake_mutex);
+            this->consumer_sleeping.store(true, std::memory_order_seq_cst);
+            this->wake_cv.wait(wake_lock, [&] {
+                return this->stopping || !this->ring.empty() || this->overflowing.load(std::memory_order_seq_cst);
+            });
+            this->consumer_sleeping.store(false, std::memory_order_seq_cst);
+        }
+    }
+
+public:
+    _async_backend(std::size_t capacity, Overflow overflow) : ring(capacity), overflow(overflow) {
+        this->consumer = std::thread(&_async_backend::consumer_main, this);
+    }
+
+    _async_backend(const _async_backend&) = delete;
+    _async_backend(_async_backend&&)      = delete;
+
+    ~_async_backend() {
+        {
+            const std::lock_guard wake_lock(this->wake_mutex);
+            this->stopping = true;
+        }
+        this->wake_cv.notify_one();
+        this->consumer.join(); // consumer drains the queue before exiting
+    }
+
+    // On return 'record' holds an old record with unspecified contents, which lets the caller reuse its buffer
+    void push(_record& record) {
+        if (this->overflow == Overflow::GROW) {
+            if (this->overflowing.load(std::memory_order_acquire) || !this->ring.try_push(record)) {
+                const std::lock_guard overflow_lock(this->overflow_mutex);
+                this->overflowing.store(true, std::memory_order_seq_cst);
+                this->overflow_queue.push_back(std::move(record));
+            }
+            this->wake_consumer();
+            return;
+        }
+
+        const bool droppable = (this->overflow == Overflow::DROP) && !record.flushed; // barriers can't be lost
+
+        while (!this->ring.try_push(record)) {
+            if (droppable) {
+                this->dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            this->wake_consumer();
+            std::this_thread::yield();
+        }
+        this->wake_consumer();
+    }
+
+    [[nodiscard]] std::size_t get_dropped_count() const { return this->dropped.load(std::memory_order_relaxed); }
+};
+
+// ========================
+// --- Deferred backend ---
+// ========================
+
+// NanoLog-style logging: producers don't stringify anything, they copy raw argument bytes into a per-thread
+// buffer together with a pointer to a decoder instantiated for that exact list of argument types. Background
+// thread later decodes the bytes, stringifies them with the same stringifier & passes the result to the sinks,
+// which makes the output identical to the regular mode.
+//
+// Only arithmetic types & strings are stored as raw bytes, messages with any other arguments (containers, tuples,
+// padding wrappers & etc.) are stringified on the calling thread & stored as a single string.
+
+constexpr std::size_t default_deferred_buffer_size = 1 << 20; // per thread
+
+using _deferred_decoder = void (*)(const char* data, std::string& message);
+
+// Header of every entry in the buffer, copied with 'memcpy()' so entries don't need any alignment
+struct _deferred_header {
+    std::uint32_t       size; // of the whole entry, including the header, 0 marks padding until the end of buffer
+    Verbosity           verbosity;
+    Callsite            callsite;
+    clock::rep          now;
+    _deferred_decoder   decode;  // null for 'flush()' barriers
+    std::promise<void>* flushed; // only for barriers
+};
+
+template <class T>
+constexpr bool _is_deferred_string_v =
+    std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+    std::is_same_v<std::decay_t<T>, const char*> || std::is_same_v<std::decay_t<T>, char*>;
+
+template <class T>
+constexpr bool _is_deferrable_v = std::is_arithmetic_v<T> || _is_deferred_string_v<T>;
+
+// Arithmetic values are stored as is, strings as a 32-bit length followed by characters
+template <class T>
+auto _to_deferred(const T& arg) {
+    if constexpr (std::is_arithmetic_v<T>) return arg;
+    else return std::string_view(arg);
+}
+
+template <class T>
+std::size_t _deferred_size(const T& value) {
+    if constexpr (std::is_arithmetic_v<T>) return sizeof(T);
+    else return sizeof(std::uint32_t) + value.size();
+}
+
+template <class T>
+void _write_deferred(char*& data, const T& value) {
+    if constexpr (std::is_arithmetic_v<T>) {
+        std::memcpy(data, &value, sizeof(T));
+        data += sizeof(T);
+    } else {
+        const auto length = static_cast<std::uint32_t>(value.size());
+        std::memcpy(data, &length, sizeof(length));
+        std::memcpy(data + sizeof(length), value.data(), length);
+        data += sizeof(length) + length;
+    }
+}
+
+template <class T>
+T _read_deferred(const char*& data) {
+    if constexpr (std::is_arithmetic_v<T>) {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        data += sizeof(T);
+        return value;
+    } else {
+        std::uint32_t length = 0;
+        std::memcpy(&length, data, sizeof(length));
+        const std::string_view value(data + sizeof(length), length);
+        data += sizeof(length) + length;
+        return value;
+    }
+}
+
+template <class... Values>
+void _decode_deferred(const char* data, std::string& message) {
+    (append_stringified(message, _read_deferred<Values>(data)), ...); // comma fold is evaluated left-to-right
+}
+
+// Lock-free SPSC byte ring, each thread writes into its own buffer so producers never contend with each other.
+//
+// Positions grow monotonically & get mapped into the buffer with a mask. Entries are always contiguous,
+// when an entry doesn't fit before the end of the buffer producer skips the remaining space (marking it with
+// a zero-sized header if there is room for one) & places the entry at the start.
+class _staging_buffer {
+private:
+    std::unique_ptr<char[]> data;
+    std::size_t             capacity;
+
+    alignas(_cache_line_size) std::atomic<std::size_t> write_pos{0};
+    std::size_t cached_read_pos = 0; // producer-side copy of 'read_pos', saves a read of the consumer's cache line
+    std::size_t entry_pos       = 0; // where the last reserved entry starts, producer only
+
+    alignas(_cache_line_size) std::atomic<std::size_t> read_pos{0};
+
+public:
+    const std::size_t thread;         // index of the owning thread
+    std::atomic<bool> retired{false}; // owning thread has exited, buffer can be removed once empty
+
+    _staging_buffer(std::size_t size, std::size_t thread) : thread(thread) {
+        this->capacity = 64;
+        while (this->capacity < size) this->capacity *= 2; // power of 2 sizes allow indexing with a mask
+        this->data = std::make_unique<char[]>(this->capacity);
+    }
+
+    // Largest entry that can always fit, even if it has to skip the space at the end of the buffer
+    [[nodiscard]] std::size_t max_entry_size() const noexcept { return this->capacity / 2; }
+
+    // Producer, returns null when there is currently no space for 'size' bytes
+    [[nodiscard]] char* try_reserve(std::size_t size) noexcept {
+        const std::size_t pos    = this->write_pos.load(std::memory_order_relaxed);
+        const std::size_t offset = pos & (this->capacity - 1);
+        const std::size_t to_end = this->capacity - offset;
+        const std::size_t skip   = (size <= to_end) ? 0 : to_end;
+
+        if (pos + skip + size - this->cached_read_pos > this->capacity) {
+            this->cached_read_pos = this->read_pos.load(std::memory_order_acquire);
+            if (pos + skip + size - this->cached_read_pos > this->capacity) return nullptr;
+        }
+
+        // Skipped space gets published together with the entry
+        if (skip && to_end >= sizeof(std::uint32_t)) std::memset(this->data.get() + offset, 0, sizeof(std::uint32_t));
+
+        this->entry_pos = pos + skip;
+        return this->data.get() + (this->entry_pos & (this->capacity - 1));
+    }
+
+    // Producer, publishes the entry written into the last reserved space
+    void commit(std::size_t size) noexcept {
+        this->write_pos.store(this->entry_pos + size, std::memory_order_release);
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return this->read_pos.load(std::memory_order_acquire) == this->write_pos.load(std::memory_order_acquire);
+    }
+
+    // Consumer, calls 'func(entry)' for every published entry & frees the space after each one
+    template <class Func>
+    bool consume(Func&& func) {
+        std::size_t       pos = this->read_pos.load(std::memory_order_relaxed);
+        const std::size_t end = this->write_pos.load(std::memory_order_acquire);
+        if (pos == end) return false;
+
+        while (pos != end) {
+            const std::size_t offset = pos & (this->capacity - 1);
+            const std::size_t to_end = this->capacity - offset;
+
+            std::uint32_t size = 0;
+            if (to_end >= sizeof(size)) std::memcpy(&size, this->data.get() + offset, sizeof(size));
+
+            if (size == 0) { // padding
+                pos += to_end;
+                continue;
+            }
+
+            func(static_cast<const char*>(this->data.get() + offset));
+            pos += size;
+            this->read_pos.store(pos, std::memory_order_release);
+        }
+
+        this->read_pos.store(pos, std::memory_order_release);
+        return true;
+    }
+};
+
+class _deferred_backend {
+private:
+    std::size_t buffer_size;
+    std::size_t generation; // tells threads that their buffer belongs to a previous backend
+
+    std::mutex                                    buffers_mutex;
+    std::vector<std::shared_ptr<_staging_buffer>> buffers;
+    std::atomic<bool>                             buffers_changed{false};
+
+    // Messages only carry 'steady_clock' time, date gets reconstructed from the offset between clocks
+    clock::time_point                     steady_start = clock::now();
+    std::chrono::system_clock::time_point system_start = std::chrono::system_clock::now();
+
+    std::mutex              wake_mutex;
+    std::condition_variable wake_cv;
+    bool                    wake_requested = false;
+    std::atomic<bool>       stopping{false};
+
+    std::thread consumer;
+
+    // Regular messages don't wake up the consumer since it polls anyways, this keeps the hot path free of
+    // any shared writes, only 'flush()' & producers waiting for space need an immediate response
+    static constexpr auto poll_interval = std::chrono::milliseconds(1);
+
+    inline static std::atomic<std::size_t> next_generation{0};
+
+    // Owned by a 'thread_local', marks the buffer as retired on thread exit, consumer still drains what's left
+    struct BufferHandle {
+        std::shared_ptr<_staging_buffer> buffer;
+        std::size_t                      generation = std::size_t(-1);
+
+        ~BufferHandle() {
+            if (this->buffer) this->buffer->retired.store(true, std::memory_order_release);
+        }
+    };
+
+    _staging_buffer& thread_buffer() {
+        thread_local BufferHandle handle;
+
+        if (handle.generation != this->generation) {
+            if (handle.buffer) handle.buffer->retired.store(true, std::memory_order_release);
+
+            handle.buffer     = std::make_shared<_staging_buffer>(this->buffer_size, _get_thread_index());
+            handle.generation = this->generation;
+
+            const std::lock_guard buffers_lock(this->buffers_mutex);
+            this->buffers.push_back(handle.buffer);
+            this->buffers_changed.store(true, std::memory_order_release);
+        }
+
+        return *handle.buffer;
+    }
+
+    void wake_consumer() {
+        {
+            const std::lock_guard wake_lock(this->wake_mutex);
+            this->wake_requested = true;
+        }
+        this->wake_cv.notify_one();
+    }
+
+    void decode(const char* entry, std::size_t thread, _record& record) const {
+        _deferred_header header;
+        std::memcpy(&header, entry, sizeof(header));
+
+        const auto now = clock::time_point(clock::duration(header.now));
+        const auto sys = this->system_start + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                                                  now - this->steady_start);
+
+        record.callsite  = header.callsite;
+        record.verbosity = header.verbosity;
+        record.now       = now;
+        record.time      = std::chrono::system_clock::to_time_t(sys);
+        record.thread    = thread;
+        record.flushed   = header.flushed;
+        record.message.clear();
+        if (header.decode) header.decode(entry + sizeof(header), record.message);
+    }
+
+    // Every thread's messages come out in order, messages of different threads are interleaved in chunks.
+    //
+    // Barrier only sits in the buffer of the thread that called 'flush()', buffers that were already visited
+    // during the same pass could've received messages logged before the call, which is why barriers are only
+    // completed after the next full pass.
+    void consumer_main() {
+        std::vector<std::shared_ptr<_staging_buffer>> local_buffers;
+        std::vector<std::promise<void>*>              barriers_seen, barriers_ready;
+        _record                                       record;
+
+        while (true) {
+            const bool stop = this->stopping.load(std::memory_order_acquire);
+
+            if (this->buffers_changed.exchange(false, std::memory_order_acquire)) {
+                const std::lock_guard buffers_lock(this->buffers_mutex);
+                local_buffers = this->buffers;
+            }
+
+            bool worked = false;
+            for (const auto& buffer : local_buffers)
+                worked |= buffer->consume([&](const char* entry) {
+                    this->decode(entry, buffer->thread, record);
+                    if (record.flushed) barriers_seen.push_back(record.flushed);
+                    else _process_record(record);
+                });
+
+            for (auto* barrier : barriers_ready) {
+                record.flushed = barrier;
+                _process_record(record); // flushes the sinks
+            }
+            barriers_ready.clear();
+            barriers_ready.swap(barriers_seen);
+
+            // Retired buffers are only removed once drained, their threads can't write anything new
+            const auto is_done = [](const auto& buffer) {
+                return buffer->retired.load(std::memory_order_acquire) && buffer->empty();
+            };
+            if (std::any_of(local_buffers.begin(), local_buffers.end(), is_done)) {
+                const std::lock_guard buffers_lock(this->buffers_mutex);
+                this->buffers.erase(std::remove_if(this->buffers.begin(), this->buffers.end(), is_done),
+                                    this->buffers.end());
+                local_buffers = this->buffers;
+            }
+
+            if (worked || !barriers_ready.empty()) continue;
+            if (stop) break; // stop was requested before the last pass found nothing, everything is written
+
+            std::unique_lock wake_lock(this->wake_mutex);
+            this->wake_cv.wait_for(wake_lock, poll_interval, [&] { return this->wake_requested; });
+            this->wake_requested = false;
+        }
+    }
+
+    template <class... Values>
+    void push_values(const Callsite& callsite, Verbosity verbosity, std::promise<void>* flushed,
+                     _deferred_decoder decode, const Values&... values) {
+        const std::size_t size = sizeof(_deferred_header) + (std::size_t{} + ... + _deferred_size(values));
+
+        _deferred_header header;
+        header.size      = static_cast<std::uint32_t>(size);
+        header.verbosity = verbosity;
+        header.callsite  = callsite;
+        header.now       = clock::now().time_since_epoch().count();
+        header.decode    = decode;
+        header.flushed   = flushed;
+
+        _staging_buffer& buffer = this->thread_buffer();
+
+        // Huge messages can't fit into the buffer, once all previous messages of this thread are written
+        // we can format them right here without breaking the order
+        if (size > buffer.max_entry_size()) {
+            while (!buffer.empty()) {
+                this->wake_consumer();
+                std::this_thread::yield();
+            }
+
+            std::string entry(size, '\0');
+            char*       data = entry.data();
+            std::memcpy(data, &header, sizeof(header));
+            data += sizeof(header);
+            (_write_deferred(data, values), ...);
+
+            thread_local _record record;
+            this->decode(entry.data(), buffer.thread, record);
+            _process_record(record);
+            return;
+        }
+
+        char* data = buffer.try_reserve(size);
+        while (!data) {
+            this->wake_consumer();
+            std::this_thread::yield();
+            data = buffer.try_reserve(size);
+        }
+
+        std::memcpy(data, &header, sizeof(header));
+        data += sizeof(header);
+        (_write_deferred(data, values), ...);
+
+        buffer.commit(size);
+    }
+
+public:
+    explicit _deferred_backend(std::size_t buffer_size)
+        : buffer_size(buffer_size), generation(next_generation.fetch_add(1, std::memory_order_relaxed)) {
+        this->consumer = std::thread(&_deferred_backend::consumer_main, this);
+    }
+
+    _deferred_backend(const _deferred_backend&) = delete;
+    _deferred_backend(_deferred_backend&&)      = delete;
+
+    ~_deferred_backend() {
+        this->stopping.store(true, std::memory_order_release);
+        this->wake_consumer();
+        this->consumer.join(); // consumer drains all buffers before exiting
+    }
+
+    template <class... Args>
+    void push(const Callsite& callsite, Verbosity verbosity, const Args&... args) {
+        if constexpr ((_is_deferrable_v<Args> && ...)) {
+            this->push_values(callsite, verbosity, nullptr, &_decode_deferred<decltype(_to_deferred(args))...>,
+                              _to_deferred(args)...);
+        } else {
+            thread_local std::string message;
+            message.clear();
+            append_stringified(message, args...);
+            this->push_values(callsite, verbosity, nullptr, &_decode_deferred<std::string_view>,
+                              std::string_view(message));
+        }
+    }
+
+    // Barrier goes through the calling thread's buffer, so it's processed after all previous messages of that thread
+    void flush() {
+        std::promise<void> flushed;
+        auto               future = flushed.get_future();
+
+        this->push_values({}, Verbosity::ERR, &flushed, nullptr);
+        this->wake_consumer();
+
+        future.wait();
+    }
+};
+
 // ====================
 // --- Logger class ---
 // ====================
@@ -880,22 +1533,101 @@ struct _logger {
     static inline Sink default_sink{std::cout, Verbosity::TRACE, Colors::ENABLE, std::chrono::milliseconds(0),
                                     Columns{}};
 
+    std::unique_ptr<_async_backend>    async;    // null => synchronous logging
+    std::unique_ptr<_deferred_backend> deferred; // null => regular logging, modes are mutually exclusive
+
     static _logger& instance() {
         static _logger logger;
         return logger;
     }
 
+    // When no sinks were manually created, default sink-to-terminal takes over
+    template <class Func>
+    static void for_each_sink(Func&& func) {
+        if (sinks.empty()) func(default_sink);
+        else
+            for (auto& sink : sinks) func(sink);
+    }
+
+    // Arguments & shared columns are stringified / queried once per message no matter the number of sinks,
+    // in sync mode the record gets formatted right away, in async mode it's passed to the background thread
     template <class... Args>
     void push_message(const Callsite& callsite, const MessageMetadata& meta, const Args&... args) {
-        // When no sinks were manually created, default sink-to-terminal takes over
-        if (this->sinks.empty()) {
-            // static Sink default_sink(std::cout, Verbosity::TRACE, Colors::ENABLE, ms(0), Columns{});
-            default_sink.format(callsite, meta, args...);
-        } else
-            for (auto& sink : this->sinks) sink.format(callsite, meta, args...);
+        // Deferred mode does everything on the background thread, including the checks below
+        if (this->deferred) {
+            this->deferred->push(callsite, meta.verbosity, args...);
+            return;
+        }
+
+        // Only query things that some sink will actually use
+        bool accepted = false, needs_datetime = false, needs_thread = false;
+        for_each_sink([&](const Sink& sink) {
+            if (meta.verbosity > sink.verbosity) return;
+            accepted = true;
+            needs_datetime |= sink.columns.datetime;
+            needs_thread |= sink.columns.thread;
+        });
+        if (!accepted) return;
+
+        // Record gets reused between calls, its message buffer only allocates when it needs to grow.
+        // Note the 'thread_local', if it was a member, multiple threads would fight over the same buffer.
+        thread_local _record record;
+
+        record.callsite  = callsite;
+        record.verbosity = meta.verbosity;
+        record.now       = clock::now();
+        record.time      = needs_datetime ? std::time(nullptr) : 0;
+        record.thread    = needs_thread ? _get_thread_index() : 0;
+        record.flushed   = nullptr;
+        record.message.clear();
+        append_stringified(record.message, args...);
+
+        if (this->async) this->async->push(record);
+        else process_record(record);
+    }
+
+    static void process_record(_record& record) {
+        if (record.flushed) {
+            for_each_sink([](Sink& sink) { sink.flush(); });
+            record.flushed->set_value();
+            record.flushed = nullptr;
+            return;
+        }
+
+        // Decorated lines, one per distinct sink decoration among the accepting sinks. Usually there are only
+        // a few of those (like a colored terminal & a bunch of plain files) so a linear search is good enough.
+        thread_local std::vector<std::pair<const Sink*, std::string>> lines;
+        std::size_t                                                 line_count = 0;
+
+        for_each_sink([&](Sink& sink) {
+            if (record.verbosity > sink.verbosity) return;
+
+            auto line = std::find_if(lines.begin(), lines.begin() + line_count,
+                                     [&](const auto& decorated) { return decorated.first->same_decoration(sink); });
+
+            if (line == lines.begin() + line_count) {
+                if (line_count == lines.size()) lines.emplace_back();
+                line        = lines.begin() + line_count++;
+                line->first = &sink;
+                line->second.clear();
+                sink.format_line(line->second, record);
+            }
+
+            sink.write(line->second, record.now);
+        });
+    }
+
+    static void update_max_verbosity() {
+        Verbosity max = Verbosity::ERR;
+        for_each_sink([&](const Sink& sink) { max = std::max(max, sink.verbosity); });
+        _max_verbosity.store(max, std::memory_order_relaxed);
     }
 };
 
+inline void _process_record(_record& record) { _logger::process_record(record); }
+
+inline void _update_max_verbosity() { _logger::update_max_verbosity(); }
+
 // =======================
 // --- Sink public API ---
 // =======================
@@ -906,7 +1638,9 @@ inline Sink& add_ostream_sink(std::ostream&   os,
                               clock::duration flush_interval = std::chrono::milliseconds{}, //
                               const Columns&  columns        = Columns{}                    //
 ) {
-    return _logger::instance().sinks.emplace_back(os, verbosity, colors, flush_interval, columns);
+    Sink& sink = _logger::instance().sinks.emplace_back(os, verbosity, colors, flush_interval, columns);
+    _update_max_verbosity();
+    return sink;
 }
 
 inline Sink& add_file_sink(const std::string& filename,                                       //
@@ -917,31 +1651,210 @@ inline Sink& add_file_sink(const std::string& filename,
                            const Columns&     columns        = Columns{}                      //
 ) {
     const auto ios_open_mode = (open_mode == OpenMode::APPEND) ? std::ios::out | std::ios::app : std::ios::out;
-    return _logger::instance().sinks.emplace_back(std::ofstream(filename, ios_open_mode), verbosity, colors,
-                                                  flush_interval, columns);
+    Sink& sink = _logger::instance().sinks.emplace_back(std::ofstream(filename, ios_open_mode), verbosity, colors,
+                                                        flush_interval, columns);
+    _update_max_verbosity();
+    return sink;
+}
+
+// ===================================
+// --- Async & deferred public API ---
+// ===================================
+
+// Switching modes isn't thread-safe, same as adding sinks it should happen before logging from multiple threads
+inline void enable_async(std::size_t capacity = default_async_capacity, Overflow overflow = Overflow::BLOCK) {
+    auto& logger = _logger::instance();
+    logger.deferred.reset();
+    logger.async.reset(); // drains the previous queue first
+    logger.async = std::make_unique<_async_backend>(capacity, overflow);
+}
+
+inline void disable_async() { _logger::instance().async.reset(); }
+
+[[nodiscard]] inline bool is_async() { return static_cast<bool>(_logger::instance().async); }
+
+// Same rules as for async mode, enabling one mode disables the other
+inline void enable_deferred(std::size_t buffer_size = default_deferred_buffer_size) {
+    auto& logger = _logger::instance();
+    logger.async.reset();
+    logger.deferred.reset(); // drains the previous buffers first
+    logger.deferred = std::make_unique<_deferred_backend>(buffer_size);
 }
 
+inline void disable_deferred() { _logger::instance().deferred.reset(); }
+
+[[nodiscard]] inline bool is_deferred() { return static_cast<bool>(_logger::instance().deferred); }
+
+// Blocks until every message logged by this thread before the call is written & all sinks are flushed
+inline void flush() {
+    auto& logger = _logger::instance();
+
+    if (logger.deferred) {
+        logger.deferred->flush();
+        return;
+    }
+
+    if (!logger.async) {
+        _logger::for_each_sink([](Sink& sink) { sink.flush(); });
+        return;
+    }
+
+    std::promise<void> flushed;
+    auto               future = flushed.get_future();
+
+    _record barrier;
+    barrier.flushed = &flushed;
+    logger.async->push(barrier);
+
+    future.wait();
+}
+
+[[nodiscard]] inline std::size_t get_dropped_count() {
+    const auto& logger = _logger::instance();
+    return logger.async ? logger.async->get_dropped_count() : 0;
+}
+
+// =====================
+// --- Rate limiting ---
+// =====================
+
+// Per-callsite limiters used by rate-limited macros, each macro creates a 'static' limiter in its own scope.
+// State is shared by all threads & lock-free, so a noisy callsite can't flood the sinks no matter how many
+// threads hit it. Parameters are captured on the first call.
+
+// Passes calls #0, #n, #2n, ...
+class _every_n {
+    std::atomic<std::size_t> count{0};
+    std::size_t              n;
+
+public:
+    explicit _every_n(std::size_t n) noexcept : n(n ? n : 1) {}
+
+    bool operator()() noexcept { return this->count.fetch_add(1, std::memory_order_relaxed) % this->n == 0; }
+};
+
+// Passes first 'n' calls
+class _first_n {
+    std::atomic<std::size_t> count{0};
+    std::size_t              n;
+
+public:
+    explicit _first_n(std::size_t n) noexcept : n(n) {}
+
+    bool operator()() noexcept {
+        // plain load first, once the limit is reached callers stop writing into a shared cache line
+        return this->count.load(std::memory_order_relaxed) < this->n &&
+               this->count.fetch_add(1, std::memory_order_relaxed) < this->n;
+    }
+};
+
+// Passes at most one call per 'interval'
+class _every_interval {
+    std::atomic<clock::rep> last{std::numeric_limits<clock::rep>::min()}; // min() => nothing passed yet
+    clock::rep              interval;
+
+public:
+    explicit _every_interval(clock::duration interval) noexcept : interval(interval.count()) {}
+
+    bool operator()() noexcept {
+        const clock::rep now  = clock::now().time_since_epoch().count();
+        clock::rep       last = this->last.load(std::memory_order_relaxed);
+
+        if (last != std::numeric_limits<clock::rep>::min() && now - last < this->interval) return false;
+        return this->last.compare_exchange_strong(last, now, std::memory_order_relaxed); // one thread wins
+    }
+};
+
+// Token bucket that refills at 'rate' tokens per second & holds at most 'burst' tokens, implemented as GCRA
+// (generic cell rate algorithm) which only needs a single atomic: "theoretical arrival time" when the bucket
+// would be full again. Call passes if it doesn't push that time more than 'burst' intervals into the future.
+class _token_bucket {
+    std::atomic<clock::rep> tat{0};
+    clock::rep              interval;  // time to refill one token
+    clock::rep              tolerance; // how far ahead 'tat' can get, (burst - 1) intervals
+
+public:
+    _token_bucket(double rate, std::size_t burst) noexcept {
+        // Interval is computed in floating point & capped before the conversion to ticks, converting an out-of-range
+        // value would be UB. Cap also keeps 'tat' arithmetic from overflowing. Non-positive & NaN rates get the
+        // largest interval, such bucket never refills and only lets the initial burst through.
+        constexpr double max_ticks = static_cast<double>(std::numeric_limits<clock::rep>::max() / 4);
+
+        using ticks = std::chrono::duration<double, clock::period>;
+
+        const double size     = static_cast<double>(burst ? burst : 1);
+        const double seconds  = rate > 0 ? 1. / rate : max_ticks; // also catches NaN
+        const double interval = std::chrono::duration_cast<ticks>(std::chrono::duration<double>(seconds)).count();
+        const double capped   = std::max(std::min(interval, max_ticks / size), 1.);
+
+        this->interval  = static_cast<clock::rep>(capped);
+        this->tolerance = static_cast<clock::rep>(std::min(capped * (size - 1), max_ticks));
+    }
+
+    bool operator()() noexcept {
+        const clock::rep now = clock::now().time_since_epoch().count();
+        clock::rep       tat = this->tat.load(std::memory_order_relaxed);
+
+        while (true) {
+            const clock::rep base = std::max(tat, now);
+            if (base - now > this->tolerance) return false;
+            if (this->tat.compare_exchange_weak(tat, base + this->interval, std::memory_order_relaxed)) return true;
+        }
+    }
+};
+
 // ======================
 // --- Logging macros ---
 // ======================
 
-#define UTL_LOG_ERR(...)                                                                                               \
-    utl::log::_logger::instance().push_message({__FILE__, __LINE__}, {utl::log::Verbosity::ERR}, __VA_ARGS__)
+// Messages above the max sink verbosity are rejected by a single atomic load, arguments don't get evaluated.
+// Levels above 'UTL_LOG_COMPILE_LEVEL' (which uses integer values of 'Verbosity') are removed from the code entirely.
 
-#define UTL_LOG_WARN(...)                                                                                              \
-    utl::log::_logger::instance().push_message({__FILE__, __LINE__}, {utl::log::Verbosity::WARN}, __VA_ARGS__)
+#ifndef UTL_LOG_COMPILE_LEVEL
+#define UTL_LOG_COMPILE_LEVEL 5
+#endif
 
-#define UTL_LOG_NOTE(...)                                                                                              \
-    utl::log::_logger::instance().push_message({__FILE__, __LINE__}, {utl::log::Verbosity::NOTE}, __VA_ARGS__)
+#define utl_log_message(verbosity_, ...)                                                                               \
+    (utl::log::_is_enabled(utl::log::Verbosity::verbosity_)                                                            \
+         ? utl::log::_logger::instance().push_message({__FILE__, __LINE__}, {utl::log::Verbosity::verbosity_},         \
+                                                      __VA_ARGS__)                                                     \
+         : void())
 
-#define UTL_LOG_INFO(...)                                                                                              \
-    utl::log::_logger::instance().push_message({__FILE__, __LINE__}, {utl::log::Verbosity::INFO}, __VA_ARGS__)
+#if UTL_LOG_COMPILE_LEVEL >= 0
+#define UTL_LOG_ERR(...) utl_log_message(ERR, __VA_ARGS__)
+#else
+#define UTL_LOG_ERR(...) static_cast<void>(0)
+#endif
 
-#define UTL_LOG_DEBUG(...)                                                                                             \
-    utl::log::_logger::instance().push_message({__FILE__, __LINE__}, {utl::log::Verbosity::DEBUG}, __VA_ARGS__)
+#if UTL_LOG_COMPILE_LEVEL >= 1
+#define UTL_LOG_WARN(...) utl_log_message(WARN, __VA_ARGS__)
+#else
+#define UTL_LOG_WARN(...) static_cast<void>(0)
+#endif
+
+#if UTL_LOG_COMPILE_LEVEL >= 2
+#define UTL_LOG_NOTE(...) utl_log_message(NOTE, __VA_ARGS__)
+#else
+#define UTL_LOG_NOTE(...) static_cast<void>(0)
+#endif
 
-#define UTL_LOG_TRACE(...)                                                                                             \
-    utl::log::_logger::instance().push_message({__FILE__, __LINE__}, {utl::log::Verbosity::TRACE}, __VA_ARGS__)
+#if UTL_LOG_COMPILE_LEVEL >= 3
+#define UTL_LOG_INFO(...) utl_log_message(INFO, __VA_ARGS__)
+#else
+#define UTL_LOG_INFO(...) static_cast<void>(0)
+#endif
+
+#if UTL_LOG_COMPILE_LEVEL >= 4
+#define UTL_LOG_DEBUG(...) utl_log_message(DEBUG, __VA_ARGS__)
+#else
+#define UTL_LOG_DEBUG(...) static_cast<void>(0)
+#endif
+
+#if UTL_LOG_COMPILE_LEVEL >= 5
+#define UTL_LOG_TRACE(...) utl_log_message(TRACE, __VA_ARGS__)
+#else
+#define UTL_LOG_TRACE(...) static_cast<void>(0)
+#endif
 
 #ifdef _DEBUG
 #define UTL_LOG_DERR(...) UTL_LOG_ERR(__VA_ARGS__)
@@ -959,6 +1872,31 @@ inline Sink& add_file_sink(const std::string& filename,
 #define UTL_LOG_DTRACE(...)
 #endif
 
+// Rate-limited logging, 'level_' is one of the 'Verbosity' names, limits are per callsite & shared by all threads.
+// Suppressed calls don't evaluate arguments & don't reach the sinks.
+//    - 'UTL_LOG_EVERY_N'      - logs calls #0, #n, #2n, ...
+//    - 'UTL_LOG_FIRST_N'      - logs first 'n' calls
+//    - 'UTL_LOG_EVERY_MS'     - logs at most once per 'ms' milliseconds
+//    - 'UTL_LOG_RATE_LIMITED' - logs at most 'rate_' messages per second on average, with bursts up to 'burst_'
+
+#define utl_log_limited(level_, limiter_type_, limiter_args_, ...)                                                     \
+    do {                                                                                                               \
+        if (static_cast<int>(utl::log::Verbosity::level_) > UTL_LOG_COMPILE_LEVEL) break;                             \
+        if (!utl::log::_is_enabled(utl::log::Verbosity::level_)) break;                                                \
+        static utl::log::limiter_type_ utl_log_limiter limiter_args_;                                                  \
+        if (utl_log_limiter()) UTL_LOG_##level_(__VA_ARGS__);                                                          \
+    } while (false)
+
+#define UTL_LOG_EVERY_N(level_, n_, ...) utl_log_limited(level_, _every_n, (n_), __VA_ARGS__)
+
+#define UTL_LOG_FIRST_N(level_, n_, ...) utl_log_limited(level_, _first_n, (n_), __VA_ARGS__)
+
+#define UTL_LOG_EVERY_MS(level_, ms_, ...)                                                                             \
+    utl_log_limited(level_, _every_interval, (std::chrono::milliseconds(ms_)), __VA_ARGS__)
+
+#define UTL_LOG_RATE_LIMITED(level_, rate_, burst_, ...)                                                               \
+    utl_log_limited(level_, _token_bucket, (rate_, burst_), __VA_ARGS__)
+
 
 } // namespace utl::log
 
@@ -8,24 +8,49 @@
 //
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-#include <iterator>
 #if !defined(UTL_PICK_MODULES) || defined(UTLMODULE_PARALLEL)
 #ifndef UTLHEADERGUARD_PARALLEL
 #define UTLHEADERGUARD_PARALLEL
 
 // _______________________ INCLUDES _______________________
 
+#include <algorithm>          // sort(), merge()
+#include <array>              // array<>
+#include <atomic>             // atomic<>
 #include <condition_variable> // condition_variable
 #include <cstddef>            // size_t
+#include <deque>              // deque<>
+#include <exception>          // exception_ptr, current_exception(), rethrow_exception()
+#include <fstream>            // ifstream
 #include <functional>         // bind()
-#include <future>             // future<>, packaged_task<>
+#include <future>             // future<>, promise<>
+#include <iterator>           // iterator_traits<>, make_move_iterator()
+#include <limits>             // numeric_limits<>
+#include <memory>             // unique_ptr<>, make_unique<>(), allocator<>, allocator_arg
 #include <mutex>              // mutex, recursive_mutex, lock_guard<>, unique_lock<>
-#include <queue>              // queue<>
+#include <new>                // operator new, operator delete
+#include <optional>           // optional<>
+#include <string>             // string, to_string(), getline()
 #include <thread>             // thread
 #include <type_traits>        // decay_t<>, invoke_result_t<>
-#include <utility>            // forward<>()
+#include <utility>            // forward<>(), exchange(), pair<>
 #include <vector>             // vector
 
+// Thread pinning & naming are OS-specific, modules are self-contained so we detect the platform here rather than
+// through 'utl::predef'. On other platforms corresponding pool options are accepted, but have no effect.
+#if defined(__linux__)
+#define utl_parallel_linux
+#include <pthread.h> // pthread_self(), pthread_setaffinity_np(), pthread_setname_np()
+#include <sched.h>   // cpu_set_t, CPU_ZERO(), CPU_SET(), CPU_ISSET(), sched_getaffinity()
+#elif defined(__APPLE__)
+#define utl_parallel_apple
+#include <pthread.h> // pthread_setname_np()
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h> // _mm_pause()
+#endif
+
 // ____________________ DEVELOPER DOCS ____________________
 
 // In C++20 'std::jthread' can be used to simplify code a bit, no reason not to do so.
@@ -74,8 +99,8 @@ class MutexProtected {
     // in this case we reasonably assume there is a single thread available
 }
 
-// No reason to include the entirety of <algorithm> just for 2 one-liner functions,
-// so we implement 'std::size_t' min/max here
+// 'std::min()' & 'std::max()' require both arguments to have the same type, which gets verbose once
+// we start mixing 'std::size_t' with iterator differences, so we implement 'std::size_t' min/max here
 [[nodiscard]] constexpr std::size_t _min_size(std::size_t a, std::size_t b) noexcept { return (b < a) ? b : a; }
 [[nodiscard]] constexpr std::size_t _max_size(std::size_t a, std::size_t b) noexcept { return (b < a) ? a : b; }
 
@@ -109,84 +134,649 @@ constexpr void _unroll(F&& f) {
     _unroll_impl(std::make_integer_sequence<T, count>{}, std::forward<F>(f));
 }
 
+// Hints the CPU that we're in a spin-wait loop, this saves power & frees up resources for the sibling
+// hyper-thread. Falls back to a no-op on architectures we don't recognize.
+inline void _cpu_relax() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// ====================
+// --- Task storage ---
+// ====================
+
+// Move-only type-erased 'void()' callable with inline small-buffer storage.
+//
+// Thread pool used to store tasks as 'std::packaged_task<void()>', which allocates a shared state for every task
+// even when nobody asks for a future. Most tasks are small (a functor reference & a couple of indices), so we store
+// them inline and only fall back onto the heap for large or throwing-move callables. Buffer size is chosen so the
+// whole wrapper fits into 64 bytes.
+//
+// Unlike 'std::function' it doesn't require callables to be copyable, which lets us store promises & packaged tasks.
+
+constexpr std::size_t _task_buffer_size = 56;
+
+class _task {
+    struct vtable_type {
+        void (*invoke)(void* self);
+        void (*move)(void* dst, void* src) noexcept; // move-constructs 'dst' from 'src' and destroys 'src'
+        void (*destroy)(void* self) noexcept;
+    };
+
+    template <class Func>
+    constexpr static bool stored_inline = sizeof(Func) <= _task_buffer_size &&
+                                          alignof(Func) <= alignof(std::max_align_t) &&
+                                          std::is_nothrow_move_constructible_v<Func>;
+
+    template <class Func>
+    constexpr static vtable_type inline_vtable = {
+        [](void* self) { (*static_cast<Func*>(self))(); },
+        [](void* dst, void* src) noexcept {
+            ::new (dst) Func(std::move(*static_cast<Func*>(src)));
+            static_cast<Func*>(src)->~Func();
+        },
+        [](void* self) noexcept { static_cast<Func*>(self)->~Func(); }};
+
+    template <class Func>
+    constexpr static vtable_type heap_vtable = {
+        [](void* self) { (**static_cast<Func**>(self))(); },
+        [](void* dst, void* src) noexcept { *static_cast<Func**>(dst) = *static_cast<Func**>(src); },
+        [](void* self) noexcept { delete *static_cast<Func**>(self); }};
+
+    alignas(std::max_align_t) unsigned char buffer[_task_buffer_size];
+    const vtable_type*                      vtable = nullptr;
+
+public:
+    _task() noexcept = default;
+
+    template <class Func, std::enable_if_t<!std::is_same_v<std::decay_t<Func>, _task>, bool> = true>
+    explicit _task(Func&& func) {
+        using callable_type = std::decay_t<Func>;
+
+        if constexpr (stored_inline<callable_type>) {
+            ::new (static_cast<void*>(this->buffer)) callable_type(std::forward<Func>(func));
+            this->vtable = &inline_vtable<callable_type>;
+        } else {
+            ::new (static_cast<void*>(this->buffer)) callable_type*(new callable_type(std::forward<Func>(func)));
+            this->vtable = &heap_vtable<callable_type>;
+        }
+    }
+
+    _task(const _task&)            = delete;
+    _task& operator=(const _task&) = delete;
+
+    _task(_task&& other) noexcept { *this = std::move(other); }
+
+    _task& operator=(_task&& other) noexcept {
+        if (this == &other) return *this;
+
+        this->reset();
+        if (other.vtable) {
+            other.vtable->move(this->buffer, other.buffer);
+            this->vtable = std::exchange(other.vtable, nullptr);
+        }
+        return *this;
+    }
+
+    ~_task() { this->reset(); }
+
+    void reset() noexcept {
+        if (this->vtable) std::exchange(this->vtable, nullptr)->destroy(this->buffer);
+    }
+
+    void operator()() { this->vtable->invoke(this->buffer); }
+
+    explicit operator bool() const noexcept { return this->vtable != nullptr; }
+};
+
+// Thread-local cache of fixed-size memory blocks, used to recycle shared states of futures.
+//
+// Blocks are often freed on a different thread than the one that allocated them (for example promise
+// dies on a worker, future dies on the caller), which is fine since every cache is capped and returns
+// surplus blocks to the heap. This keeps the common case of repeatedly submitting tasks allocation-free.
+template <std::size_t block_size>
+class _block_cache {
+    constexpr static std::size_t capacity = 256;
+
+    struct Storage {
+        std::size_t size = 0;
+        void*       blocks[capacity];
+
+        ~Storage() {
+            for (std::size_t i = 0; i < this->size; ++i) ::operator delete(this->blocks[i]);
+            destroyed = true;
+        }
+    };
+
+    inline static thread_local Storage storage;
+    inline static thread_local bool    destroyed = false;
+    // futures can outlive thread-local storage (for example when stored in a static variable), trivially
+    // destructible flag stays valid till the very end and lets us fall back onto the heap in such case
+
+public:
+    [[nodiscard]] static void* allocate() {
+        if (destroyed || storage.size == 0) return ::operator new(block_size);
+        return storage.blocks[--storage.size];
+    }
+
+    static void deallocate(void* block) noexcept {
+        if (destroyed || storage.size == capacity) return ::operator delete(block);
+        storage.blocks[storage.size++] = block;
+    }
+};
+
+template <class T>
+struct _pooled_allocator {
+    using value_type = T;
+
+    constexpr static std::size_t block_size = (sizeof(T) + 15) / 16 * 16; // rounding lets similar types share caches
+    constexpr static bool        pooled     = alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    _pooled_allocator() noexcept = default;
+
+    template <class U>
+    _pooled_allocator(const _pooled_allocator<U>&) noexcept {}
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+        if constexpr (pooled)
+            if (n == 1) return static_cast<T*>(_block_cache<block_size>::allocate());
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        if constexpr (pooled)
+            if (n == 1) return _block_cache<block_size>::deallocate(ptr);
+        std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    template <class U>
+    bool operator==(const _pooled_allocator<U>&) const noexcept {
+        return true;
+    }
+    template <class U>
+    bool operator!=(const _pooled_allocator<U>&) const noexcept {
+        return false;
+    }
+};
+
+// ========================
+// --- Thread placement ---
+// ========================
+
+// Worker pinning, similar to OpenMP 'proc_bind(close | spread)':
+//    - 'NONE'     - workers aren't pinned, OS is free to migrate them between CPUs
+//    - 'COMPACT'  - workers are packed onto consecutive CPUs, filling up one NUMA node before moving to the next
+//    - 'SCATTER'  - workers are spread round-robin across NUMA nodes, then across CPUs within each node
+//    - 'EXPLICIT' - worker 'i' is pinned to 'cpus[i % cpus.size()]' from a user-provided list
+// Compact placement keeps workers sharing caches & memory of a single node, scatter placement maximizes total
+// memory bandwidth. Pinning is only supported on Linux, on other platforms the option has no effect.
+enum class Affinity { NONE, COMPACT, SCATTER, EXPLICIT };
+
+// Parses Linux CPU list format used by sysfs, for example "0-3,8-11"
+[[nodiscard]] inline std::vector<std::size_t> _parse_cpu_list(const std::string& list) {
+    std::vector<std::size_t> cpus;
+
+    std::size_t i = 0;
+
+    const auto parse_number = [&](std::size_t& number) -> bool {
+        if (i >= list.size() || list[i] < '0' || list[i] > '9') return false;
+        number = 0;
+        while (i < list.size() && list[i] >= '0' && list[i] <= '9') number = number * 10 + (list[i++] - '0');
+        return true;
+    };
+
+    std::size_t first, last;
+    while (parse_number(first)) {
+        last = first;
+        if (i < list.size() && list[i] == '-' && !(++i, parse_number(last))) break;
+        for (std::size_t cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+
+        if (i < list.size() && list[i] == ',') ++i;
+        else break;
+    }
+
+    return cpus;
+}
+
+[[nodiscard]] inline std::string _read_first_line(const std::string& path) {
+    std::ifstream file(path);
+    std::string   line;
+    std::getline(file, line);
+    return line;
+}
+
+// CPUs available to the process grouped by NUMA node, nodes without available CPUs are skipped.
+// Machines without NUMA information (or non-Linux ones) are treated as a single node.
+[[nodiscard]] inline std::vector<std::vector<std::size_t>> _read_numa_topology() {
+    std::vector<std::vector<std::size_t>> nodes;
+
+#ifdef utl_parallel_linux
+    // Respect the process affinity mask, containers & 'taskset' often restrict the set of usable CPUs
+    cpu_set_t  allowed;
+    CPU_ZERO(&allowed);
+    const bool has_mask   = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+    const auto is_allowed = [&](std::size_t cpu) {
+        return !has_mask || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed));
+    };
+
+    const std::string sysfs = "/sys/devices/system/node/";
+
+    for (std::size_t node : _parse_cpu_list(_read_first_line(sysfs + "online"))) {
+        std::vector<std::size_t> cpus;
+        for (std::size_t cpu : _parse_cpu_list(_read_first_line(sysfs + "node" + std::to_string(node) + "/cpulist")))
+            if (is_allowed(cpu)) cpus.push_back(cpu);
+        if (!cpus.empty()) nodes.push_back(std::move(cpus));
+    }
+
+    if (nodes.empty() && has_mask) {
+        std::vector<std::size_t> cpus;
+        for (std::size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            if (CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+        if (!cpus.empty()) nodes.push_back(std::move(cpus));
+    }
+#endif
+
+    if (nodes.empty()) {
+        std::vector<std::size_t> cpus(max_thread_count());
+        for (std::size_t cpu = 0; cpu < cpus.size(); ++cpu) cpus[cpu] = cpu;
+        nodes.push_back(std::move(cpus));
+    }
+
+    return nodes;
+}
+
+// Topology doesn't change during the runtime, no reason to read sysfs more than once
+[[nodiscard]] inline const std::vector<std::vector<std::size_t>>& _numa_topology() {
+    static const std::vector<std::vector<std::size_t>> topology = _read_numa_topology();
+    return topology;
+}
+
+struct _worker_placement {
+    std::optional<std::size_t> cpu;      // no value => worker isn't pinned
+    std::size_t                node = 0; // index of the NUMA node, used to prefer stealing from nearby workers
+};
+
+// Topology is taken as a parameter so the placement logic doesn't depend on the machine it runs on
+[[nodiscard]] inline std::vector<_worker_placement>
+_place_workers(std::size_t thread_count, Affinity affinity, const std::vector<std::size_t>& explicit_cpus,
+               const std::vector<std::vector<std::size_t>>& nodes) {
+    std::vector<_worker_placement> placement(thread_count);
+
+    if (affinity == Affinity::NONE) return placement;
+
+    const auto node_of = [&](std::size_t cpu) -> std::size_t {
+        for (std::size_t node = 0; node < nodes.size(); ++node)
+            if (std::find(nodes[node].begin(), nodes[node].end(), cpu) != nodes[node].end()) return node;
+        return 0;
+    };
+
+    std::vector<std::size_t> compact_cpus; // CPUs ordered node by node
+    for (const auto& node : nodes) compact_cpus.insert(compact_cpus.end(), node.begin(), node.end());
+
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        if (affinity == Affinity::COMPACT) {
+            placement[i].cpu = compact_cpus[i % compact_cpus.size()];
+        } else if (affinity == Affinity::SCATTER) {
+            const auto& node = nodes[i % nodes.size()];
+            placement[i].cpu = node[(i / nodes.size()) % node.size()];
+        } else if (!explicit_cpus.empty()) {
+            placement[i].cpu = explicit_cpus[i % explicit_cpus.size()];
+        }
+
+        if (placement[i].cpu) placement[i].node = node_of(*placement[i].cpu);
+    }
+
+    return placement;
+}
+
+[[nodiscard]] inline std::vector<_worker_placement>
+_place_workers(std::size_t thread_count, Affinity affinity, const std::vector<std::size_t>& explicit_cpus) {
+    if (affinity == Affinity::NONE) return std::vector<_worker_placement>(thread_count); // no need to read sysfs
+    return _place_workers(thread_count, affinity, explicit_cpus, _numa_topology());
+}
+
+// Failures are ignored, a CPU outside of the allowed set simply leaves the thread unpinned
+inline void _pin_current_thread(std::size_t cpu) {
+#ifdef utl_parallel_linux
+    if (cpu >= CPU_SETSIZE) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
+
+// Names show up in debuggers, 'top -H', 'perf' & other profilers, Linux limits them to 15 characters
+// so we truncate the prefix rather than the index which is what tells workers apart
+inline void _name_current_thread(const std::string& prefix, std::size_t index) {
+    const std::string suffix = "-" + std::to_string(index);
+#if defined(utl_parallel_linux)
+    const std::string name = prefix.substr(0, 15 - _min_size(15, suffix.size())) + suffix;
+    pthread_setname_np(pthread_self(), name.c_str());
+#elif defined(utl_parallel_apple)
+    pthread_setname_np((prefix + suffix).c_str());
+#else
+    (void)prefix;
+    (void)suffix;
+#endif
+}
+
 // ===================
 // --- Thread pool ---
 // ===================
 
-// A simple single-queue task threadpool, uploads of arbitrary callables as tasks,
-// returns optional futures, supports pausing. Work stealing would probably be better
-// in a general case, however it complicates the implementation quite noticeably and
-// doesn't provide much measurable benefit under the API of this module.
+// A task threadpool, uploads of arbitrary callables as tasks, returns optional futures, supports pausing.
+//
+// Pool supports 2 scheduling modes:
+//    - 'SHARED_QUEUE'  - a single FIFO queue shared by all workers, simple and fair
+//    - 'WORK_STEALING' - one deque per worker, workers pop their own deque from the back (LIFO, which keeps
+//                        recently produced data in cache) and steal from the front of other deques when idle
+// Under a single queue every submission & every pop contend on the same lock, which starts to dominate once
+// tasks are fine-grained and the thread count is high. Work stealing spreads that contention over per-worker
+// locks: tasks submitted from inside a worker go to its own deque, external submissions get distributed
+// round-robin. Both modes share the same implementation, shared queue is just a case with one deque.
+//
+// Worker deques are regular mutex-protected deques rather than lock-free Chase-Lev deques, uncontended
+// locks are cheap and this keeps the implementation simple while removing the global contention point.
+//
+// Workers can be pinned to CPUs (see 'Affinity') & named for profiling. Pinned workers steal from workers
+// on the same NUMA node first, so stolen tasks are more likely to find their data in a nearby cache & memory.
 
-// Note:
+// Note 1:
 // We don't use 'MutexProtected' here to make implementation a bit more decoupled, plus such idiom isn't nearly as
 // convenient once we enter the realm of non-trivial syncronization with recursive mutexes and condition variables.
 
+// Note 2:
+// Reconfiguring the pool with '.set_thread_count()' / '.set_scheduler()' is not supposed to happen concurrently
+// with task submission from other threads, same as with any other non-trivial reconfiguration of a pool.
+
+enum class Scheduler { SHARED_QUEUE, WORK_STEALING };
+
+// What idle threads do before going to sleep:
+//    1. Spin 'spin_count' iterations with a CPU 'pause' hint, checking for new tasks
+//    2. Call 'std::this_thread::yield()' 'yield_count' times, checking for new tasks
+//    3. Block on a condition variable until notified
+// Blocking right away (the default) costs nothing while idle, but every task submitted to a sleeping pool
+// pays for a futex wake-up, which is several microseconds of latency & gets paid again on every 'for_loop()'
+// in a tight outer loop. Spinning & yielding workers pick up new tasks almost immediately without being
+// notified, at the cost of burning CPU time while idle. Same policy applies to threads waiting for tasks,
+// for example to a thread that waits for 'for_loop()' to finish.
+//
+// Spinning only makes sense when workers don't compete with other threads for cores, on oversubscribed
+// machines spinning workers take time away from threads that do useful work.
+struct IdlePolicy {
+    std::size_t spin_count  = 0;
+    std::size_t yield_count = 0;
+};
+
+constexpr std::size_t _cache_line_size = 64;
+// 'std::hardware_destructive_interference_size' would be the proper way to get this, but it isn't
+// implemented by some compilers and produces ABI warnings on others, 64 bytes is correct for most CPUs
+
 class ThreadPool {
 private:
+    friend class TaskGroup;
+
+    using task_type = _task;
+
+    struct alignas(_cache_line_size) TaskQueue {
+        std::mutex            mutex;
+        std::deque<task_type> tasks;
+    }; // aligned so different worker queues don't share cache lines
+
     std::vector<std::thread>     threads;
     mutable std::recursive_mutex thread_mutex;
 
-    std::queue<std::packaged_task<void()>> tasks{};
-    mutable std::mutex                     task_mutex;
+    Scheduler                               scheduler = Scheduler::SHARED_QUEUE;
+    std::vector<std::unique_ptr<TaskQueue>> queues; // 1 queue for a shared queue mode, 1 per worker otherwise
+    std::atomic<std::size_t>                next_queue{0}; // round-robin counter for external submissions
+    std::vector<std::vector<std::size_t>>   steal_order;   // per-queue list of queues to steal from, nearest first
+
+    Affinity                       affinity = Affinity::NONE;
+    std::vector<std::size_t>       affinity_cpus; // used by 'Affinity::EXPLICIT'
+    std::vector<_worker_placement> placement;     // computed on every (re)start, one per worker
+    std::string                    thread_name;   // workers are named '<thread_name>-<index>' unless empty
 
-    std::condition_variable task_cv;          // used to notify changes to the task queue
-    std::condition_variable task_finished_cv; // used to notify of finished tasks
+    mutable std::mutex      task_mutex;       // used for sleeping & waiting, queues themselves have separate locks
+    std::condition_variable task_cv;          // used to notify sleeping workers of new tasks
+    std::condition_variable task_finished_cv; // used to notify of all tasks being finished
 
     // Signals
-    bool stopping = false; // signal for workers to shut down '.worker_main()'
-    bool paused   = false; // signal for workers to not pull new tasks from the queue
-    bool waiting  = false; // signal for workers that they should notify 'task_finished_cv' when
-                           // finishing a task, which is used to implement 'wait for tasks' methods
+    std::atomic<bool> stopping{false}; // signal for workers to shut down '.worker_main()'
+    std::atomic<bool> paused{false};   // signal for workers to not pull new tasks from the queue
+
+    std::atomic<std::size_t> tasks_queued{0};     // number of tasks waiting in the queues
+    std::atomic<std::size_t> tasks_unfinished{0}; // number of tasks queued or currently executed by workers
+    std::atomic<std::size_t> workers_sleeping{0}; // lets submission skip notification when nobody sleeps
+
+    std::atomic<std::size_t> idle_spin_count{0};  // see 'IdlePolicy', read by idle threads before sleeping
+    std::atomic<std::size_t> idle_yield_count{0}; // which means policy can be changed without restarting workers
+
+    // Lets tasks know which pool & worker they are running on, used to submit nested tasks into local queues
+    inline static thread_local ThreadPool* current_pool   = nullptr;
+    inline static thread_local std::size_t current_worker = 0;
+
+    // --- Queues ---
+
+    void rebuild_queues(std::size_t queue_count) {
+        std::vector<std::unique_ptr<TaskQueue>> new_queues(queue_count);
+        for (auto& queue : new_queues) queue = std::make_unique<TaskQueue>();
+
+        // Tasks still waiting in the old queues (for example due to pause) get redistributed
+        std::size_t i = 0;
+        for (auto& queue : this->queues)
+            for (auto& task : queue->tasks) new_queues[i++ % queue_count]->tasks.push_back(std::move(task));
+
+        this->queues = std::move(new_queues);
+
+        // Victims are ordered by NUMA distance first & by index second, without pinning
+        // all workers count as a single node and this is a regular round-robin order
+        const auto node_of = [&](std::size_t queue) {
+            return queue < this->placement.size() ? this->placement[queue].node : std::size_t(0);
+        };
 
-    int tasks_running = 0; // number of tasks currently executed by workers
+        this->steal_order.assign(queue_count, {});
+        if (queue_count == 1) return;
+
+        for (std::size_t home = 0; home < queue_count; ++home) {
+            auto& order = this->steal_order[home];
+            for (std::size_t offset = 1; offset < queue_count; ++offset) order.push_back((home + offset) % queue_count);
+            std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+                return (node_of(a) != node_of(home)) < (node_of(b) != node_of(home));
+            });
+        }
+    }
+
+    void push_task(task_type&& task) {
+        ++this->tasks_unfinished; // has to be incremented before the task can be seen & finished by a worker
+
+        const std::size_t queue_count = this->queues.size();
+
+        std::size_t index = 0;
+        if (queue_count > 1) index = (current_pool == this) ? current_worker : this->next_queue++ % queue_count;
+
+        {
+            TaskQueue&                        queue = *this->queues[index];
+            const std::lock_guard<std::mutex> queue_lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+            ++this->tasks_queued;
+        }
+
+        // Sleeping workers re-check 'tasks_queued' under the 'task_mutex' before going to sleep, locking it
+        // here ensures the notification can't slip in-between that check and the wait, which means no lost wakeups
+        if (this->workers_sleeping > 0) {
+            { const std::lock_guard<std::mutex> task_lock(this->task_mutex); }
+            this->task_cv.notify_one(); // wakes up one thread (if possible) so it can pull the new task
+        }
+    }
+
+    bool try_pop_task(std::size_t worker, task_type& task) {
+        if (this->tasks_queued == 0) return false; // quick escape, avoids locking every queue while idle
+
+        const std::size_t queue_count = this->queues.size();
+        const std::size_t home        = (queue_count == 1) ? 0 : worker;
+
+        // Own queue, LIFO when work stealing
+        {
+            TaskQueue&                        queue = *this->queues[home];
+            const std::lock_guard<std::mutex> queue_lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                if (this->scheduler == Scheduler::WORK_STEALING) {
+                    task = std::move(queue.tasks.back());
+                    queue.tasks.pop_back();
+                } else {
+                    task = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                }
+                --this->tasks_queued;
+                return true;
+            }
+        }
+
+        // Steal from other queues, FIFO
+        for (std::size_t victim : this->steal_order[home]) {
+            TaskQueue&                        queue = *this->queues[victim];
+            const std::lock_guard<std::mutex> queue_lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                --this->tasks_queued;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void run_task(task_type& task) {
+        try {
+            task();
+        } catch (...) {} // tasks with futures store their exceptions, fire-and-forget tasks have nowhere to report them
+        task.reset();    // release resources captured by the task before reporting it as finished
+
+        if (--this->tasks_unfinished == 0) {
+            { const std::lock_guard<std::mutex> task_lock(this->task_mutex); }
+            this->task_finished_cv.notify_all();
+        }
+    }
+
+    // --- Idling ---
+
+    // Spins & yields according to the idle policy, returns 'true' as soon as 'ready()' is satisfied,
+    // returns 'false' if the thread should proceed to block
+    template <class Pred>
+    bool spin_until(Pred&& ready) const {
+        const std::size_t spin_count  = this->idle_spin_count.load(std::memory_order_relaxed);
+        const std::size_t yield_count = this->idle_yield_count.load(std::memory_order_relaxed);
+
+        for (std::size_t i = 0; i < spin_count; ++i) {
+            if (ready()) return true;
+            _cpu_relax();
+        }
+        for (std::size_t i = 0; i < yield_count; ++i) {
+            if (ready()) return true;
+            std::this_thread::yield();
+        }
+        return false;
+    }
+
+    // --- Helping ---
+
+    // Instead of blocking, threads waiting for some condition can execute pending tasks in the meantime.
+    // This is what makes nested parallelism possible: a worker waiting for its nested tasks keeps running
+    // them (or any other tasks) rather than blocking, so workers can't all end up waiting on each other.
+    template <class Pred>
+    void wait_and_help(Pred&& done) {
+        const std::size_t worker = (current_pool == this) ? current_worker : 0;
+
+        task_type task;
+
+        const auto ready = [&] { return done() || (!this->paused && this->tasks_queued > 0); };
+
+        while (!done()) {
+            if (!this->paused && this->try_pop_task(worker, task)) {
+                this->run_task(task);
+                continue;
+            }
+
+            if (this->spin_until(ready)) continue;
+
+            // Nothing to help with, sleep until there is a new task or condition is satisfied,
+            // see '.notify_helpers()'. Helpers sleep the same way workers do so submissions wake them up.
+            std::unique_lock<std::mutex> task_lock(this->task_mutex);
+            ++this->workers_sleeping;
+            this->task_cv.wait(task_lock, ready);
+            --this->workers_sleeping;
+        }
+    }
+
+    // Should be called after making condition of some '.wait_and_help()' true
+    void notify_helpers() {
+        { const std::lock_guard<std::mutex> task_lock(this->task_mutex); }
+        this->task_cv.notify_all();
+    }
+
+    // --- Workers ---
 
     // Main function for worker threads,
-    // here workers wait for the queue, pull new tasks from it and run them
-    void thread_main() {
-        bool task_was_finished = false;
+    // here workers pull tasks from the queues and run them, sleeping when there is nothing to do
+    void thread_main(std::size_t worker) {
+        current_pool   = this;
+        current_worker = worker;
+
+        if (this->placement[worker].cpu) _pin_current_thread(*this->placement[worker].cpu);
+        if (!this->thread_name.empty()) _name_current_thread(this->thread_name, worker);
+
+        task_type task;
+
+        const auto ready = [&] { return this->stopping || (!this->paused && this->tasks_queued > 0); };
 
         while (true) {
-            std::unique_lock<std::mutex> task_lock(this->task_mutex);
+            if (!this->paused && this->try_pop_task(worker, task)) {
+                this->run_task(task);
+                continue;
+            }
 
-            if (task_was_finished) {
-                --this->tasks_running;
-                if (this->waiting) this->task_finished_cv.notify_all();
-                // no need to set 'task_was_finished' back to 'false',
-                // the only way we get back into this condition is if another task was finished
+            if (this->spin_until(ready)) {
+                if (this->stopping) break;
+                continue;
             }
 
             // Pool isn't destructing, isn't paused and there are tasks available in the queue
-            //    => continue execution, a new task from the queue and start executing it
+            //    => continue execution, pull a new task from the queue and start executing it
             // otherwise
             //    => unlock the mutex and wait until a new task is submitted,
             //       pool is unpaused or destruction is initiated
-            this->task_cv.wait(task_lock, [&] { return this->stopping || (!this->paused && !this->tasks.empty()); });
+            std::unique_lock<std::mutex> task_lock(this->task_mutex);
+            ++this->workers_sleeping;
+            this->task_cv.wait(task_lock, ready);
+            --this->workers_sleeping;
 
             if (this->stopping) break; // escape hatch for thread destruction
-
-            // Pull a new task from the queue and start executing it
-            std::packaged_task<void()> task_to_execute = std::move(this->tasks.front());
-            this->tasks.pop();
-            ++this->tasks_running;
-            task_lock.unlock();
-
-            task_to_execute(); // NOTE: Should I catch exceptions here?
-            task_was_finished = true;
         }
+
+        current_pool = nullptr;
     }
 
-    void start_threads(std::size_t worker_count_increase) {
+    void start_threads(std::size_t thread_count) {
         const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
         // the mutex has to be recursive because we call '.start_threads()' inside '.set_num_threads()'
         // which also locks 'worker_mutex', if mutex wan't recursive we would deadlock trying to lock
         // it a 2nd time on the same thread.
 
-        // NOTE: It feels like '.start_threads()' can be split into '.start_threads()' and
-        // '._start_threads_assuming_locked()' which would remove the need for recursive mutex
+        // Workers index their own queues & placement, which means those have to be set up before workers start
+        this->placement = _place_workers(thread_count, this->affinity, this->affinity_cpus);
+        this->rebuild_queues(this->scheduler == Scheduler::WORK_STEALING ? _max_size(thread_count, 1) : 1);
 
-        for (std::size_t i = 0; i < worker_count_increase; ++i)
-            this->threads.emplace_back(&ThreadPool::thread_main, this);
+        this->stopping = false;
+        for (std::size_t i = 0; i < thread_count; ++i) this->threads.emplace_back(&ThreadPool::thread_main, this, i);
     }
 
     void stop_all_threads() {
@@ -205,13 +795,24 @@ class ThreadPool {
         this->threads.clear();
     }
 
+    void restart_threads(std::size_t thread_count) {
+        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
+        this->stop_all_threads();
+        this->start_threads(thread_count);
+        // Restarting the whole pool is the simplest way to keep per-worker queues consistent with the workers,
+        // reconfiguration is rare enough for this to not matter
+    }
+
 public:
     // --- Construction ---
     // --------------------
 
-    ThreadPool() = default;
+    ThreadPool() : ThreadPool(0) {}
 
-    explicit ThreadPool(std::size_t thread_count) { this->start_threads(thread_count); }
+    explicit ThreadPool(std::size_t thread_count, Scheduler scheduler = Scheduler::SHARED_QUEUE)
+        : scheduler(scheduler) {
+        this->start_threads(thread_count);
+    }
 
     ~ThreadPool() {
         this->unpause();
@@ -229,25 +830,95 @@ class ThreadPool {
 
     void set_thread_count(std::size_t thread_count) {
         this->wait_for_tasks(); // all threads need to be free
-        
-        const std::size_t current_thread_count = this->get_thread_count();
 
-        if (thread_count == current_thread_count) return;
+        if (thread_count == this->get_thread_count()) return;
         // 'quick escape' so we don't experience too much slowdown when the user calls '.set_thread_count()' repeatedly
 
-        if (thread_count > current_thread_count) {
-            this->start_threads(thread_count - current_thread_count);
-        } else {
-            this->stop_all_threads();
-            {
-                const std::lock_guard<std::mutex> task_lock(this->task_mutex);
-                this->stopping = false;
-            }
-            this->start_threads(thread_count);
-            // It is possible to improve implementation by making the pool shrink by joining only the necessary amount
-            // of threads instead of recreating the the whole pool, however that task is non-trivial and would likely
-            // require a more granular signaling with one flag per thread instead of a global 'stopping' flag.
-        }
+        this->restart_threads(thread_count);
+    }
+
+    // --- Scheduling ---
+    // ------------------
+
+    [[nodiscard]] Scheduler get_scheduler() const {
+        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
+        return this->scheduler;
+    }
+
+    void set_scheduler(Scheduler scheduler) {
+        this->wait_for_tasks(); // all threads need to be free
+
+        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
+
+        if (scheduler == this->scheduler) return;
+
+        this->scheduler = scheduler;
+        this->restart_threads(this->threads.size());
+    }
+
+    // --- Idling ---
+    // --------------
+
+    [[nodiscard]] IdlePolicy get_idle_policy() const {
+        return {this->idle_spin_count.load(std::memory_order_relaxed),
+                this->idle_yield_count.load(std::memory_order_relaxed)};
+    }
+
+    void set_idle_policy(IdlePolicy policy) {
+        this->idle_spin_count.store(policy.spin_count, std::memory_order_relaxed);
+        this->idle_yield_count.store(policy.yield_count, std::memory_order_relaxed);
+    }
+
+    // --- Placement ---
+    // -----------------
+
+    [[nodiscard]] Affinity get_affinity() const {
+        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
+        return this->affinity;
+    }
+
+    void set_affinity(Affinity affinity) {
+        this->wait_for_tasks(); // all threads need to be free
+
+        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
+
+        if (affinity == this->affinity) return;
+
+        // Workers read placement settings on startup, they can only change while no workers exist
+        const std::size_t thread_count = this->threads.size();
+        this->stop_all_threads();
+        this->affinity = affinity;
+        this->start_threads(thread_count);
+    }
+
+    void set_affinity(std::vector<std::size_t> cpus) {
+        this->wait_for_tasks(); // all threads need to be free
+
+        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
+
+        const std::size_t thread_count = this->threads.size();
+        this->stop_all_threads();
+        this->affinity      = Affinity::EXPLICIT;
+        this->affinity_cpus = std::move(cpus);
+        this->start_threads(thread_count);
+    }
+
+    [[nodiscard]] std::string get_thread_name() const {
+        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
+        return this->thread_name;
+    }
+
+    void set_thread_name(std::string name) {
+        this->wait_for_tasks(); // all threads need to be free
+
+        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
+
+        if (name == this->thread_name) return;
+
+        const std::size_t thread_count = this->threads.size();
+        this->stop_all_threads();
+        this->thread_name = std::move(name);
+        this->start_threads(thread_count);
     }
 
     // --- Task queue ---
@@ -255,42 +926,50 @@ class ThreadPool {
 
     template <class Func, class... Args>
     void add_task(Func&& func, Args&&... args) {
-        const std::lock_guard<std::mutex> task_lock(this->task_mutex);
-        this->tasks.emplace(std::bind(std::forward<Func>(func), std::forward<Args>(args)...));
-        this->task_cv.notify_one(); // wakes up one thread (if possible) so it can pull the new task
+        this->push_task(task_type(std::bind(std::forward<Func>(func), std::forward<Args>(args)...)));
     }
 
     template <class Func, class... Args,
               class FuncReturnType = std::invoke_result_t<std::decay_t<Func>, std::decay_t<Args>...>>
     [[nodiscard]] std::future<FuncReturnType> add_task_with_future(Func&& func, Args&&... args) {
-#if defined(_MSC_VER) || defined(_MSC_FULL_VER)
-        // MSVC messed up implementation of 'std::packaged_task<>' so it is not movable (which,
-        // according to the standard, it should be) and they can't fix it for 7 (and counting) years
-        // because fixing the bug would change the ABI. See this thread about the bug report:
-        // https://developercommunity.visualstudio.com/t/unable-to-move-stdpackaged-task-into-any-stl-conta/108672
-        // As a workaround we wrap the packaged task into a shared pointer and add another layer of packaging.
-        auto new_task = std::make_shared<std::packaged_task<FuncReturnType()>>(
-            std::bind(std::forward<Func>(func), std::forward<Args>(args)...));
-        this->add_task([new_task] { (*new_task)(); }); // horrible
-        return new_task->get_future();
-#else
-        std::packaged_task<FuncReturnType()> new_task(std::bind(std::forward<Func>(func), std::forward<Args>(args)...));
-        auto                                 future = new_task.get_future();
-        this->add_task(std::move(new_task));
+        // Shared state is allocated through a pooled allocator so repeated submissions recycle the same memory,
+        // promise is move-only which is fine since '_task' doesn't require copyability. This also sidesteps MSVC
+        // 'std::packaged_task<>' not being movable, which used to require wrapping it into a shared pointer.
+        std::promise<FuncReturnType> promise(std::allocator_arg, _pooled_allocator<char>{}); // gets rebound
+        auto                         future = promise.get_future();
+
+        auto task = std::bind(std::forward<Func>(func), std::forward<Args>(args)...);
+
+        this->push_task(task_type([promise = std::move(promise), task = std::move(task)]() mutable {
+            try {
+                if constexpr (std::is_void_v<FuncReturnType>) {
+                    task();
+                    promise.set_value();
+                } else promise.set_value(task());
+            } catch (...) { promise.set_exception(std::current_exception()); }
+        }));
+
         return future;
-#endif
     }
 
     void wait_for_tasks() {
         std::unique_lock<std::mutex> task_lock(this->task_mutex);
-        this->waiting = true;
-        this->task_finished_cv.wait(task_lock, [&] { return this->tasks.empty() && this->tasks_running == 0; });
-        this->waiting = false;
+        this->task_finished_cv.wait(task_lock, [&] { return this->tasks_unfinished == 0; });
     }
 
     void clear_task_queue() {
-        const std::lock_guard<std::mutex> task_lock(this->task_mutex);
-        this->tasks = {}; // for some reason 'std::queue' has no '.clear()', complexity O(N)
+        std::size_t cleared = 0;
+        for (auto& queue : this->queues) {
+            const std::lock_guard<std::mutex> queue_lock(queue->mutex);
+            cleared += queue->tasks.size();
+            this->tasks_queued -= queue->tasks.size();
+            queue->tasks.clear();
+        }
+
+        if (cleared && (this->tasks_unfinished -= cleared) == 0) {
+            { const std::lock_guard<std::mutex> task_lock(this->task_mutex); }
+            this->task_finished_cv.notify_all();
+        }
     }
 
     // --- Pausing ---
@@ -307,10 +986,7 @@ class ThreadPool {
         this->task_cv.notify_all();
     }
 
-    [[nodiscard]] bool is_paused() const {
-        const std::lock_guard<std::mutex> task_lock(this->task_mutex);
-        return this->paused;
-    }
+    [[nodiscard]] bool is_paused() const { return this->paused; }
 };
 
 // =====================================
@@ -327,6 +1003,81 @@ inline ThreadPool& static_thread_pool() {
 
 inline void set_thread_count(std::size_t thread_count) { static_thread_pool().set_thread_count(thread_count); }
 
+[[nodiscard]] inline Scheduler get_scheduler() { return static_thread_pool().get_scheduler(); }
+
+inline void set_scheduler(Scheduler scheduler) { static_thread_pool().set_scheduler(scheduler); }
+
+[[nodiscard]] inline IdlePolicy get_idle_policy() { return static_thread_pool().get_idle_policy(); }
+
+inline void set_idle_policy(IdlePolicy policy) { static_thread_pool().set_idle_policy(policy); }
+
+[[nodiscard]] inline Affinity get_affinity() { return static_thread_pool().get_affinity(); }
+
+inline void set_affinity(Affinity affinity) { static_thread_pool().set_affinity(affinity); }
+
+inline void set_affinity(std::vector<std::size_t> cpus) { static_thread_pool().set_affinity(std::move(cpus)); }
+
+[[nodiscard]] inline std::string get_thread_name() { return static_thread_pool().get_thread_name(); }
+
+inline void set_thread_name(std::string name) { static_thread_pool().set_thread_name(std::move(name)); }
+
+// ==================
+// --- Task group ---
+// ==================
+
+// A handle for a group of tasks that can be waited on independently from the rest of the pool.
+//
+// Waiting on the whole pool from inside a task would deadlock (the task itself is never finished while it waits)
+// and makes unrelated parallel sections wait on each other. Task group only waits for its own tasks, and does so
+// by helping to execute pending tasks, which makes nested parallel loops & divide-and-conquer algorithms possible.
+//
+// Exceptions thrown by the tasks are captured, the first one gets rethrown by '.wait()'.
+
+class TaskGroup {
+    ThreadPool&              pool;
+    std::atomic<std::size_t> tasks_pending{0};
+
+    std::mutex         exception_mutex;
+    std::exception_ptr exception;
+
+    void wait_without_rethrow() {
+        this->pool.wait_and_help([&] { return this->tasks_pending == 0; });
+    }
+
+public:
+    explicit TaskGroup(ThreadPool& pool = static_thread_pool()) : pool(pool) {}
+
+    TaskGroup(const TaskGroup&)            = delete;
+    TaskGroup(TaskGroup&&)                 = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    TaskGroup& operator=(TaskGroup&&)      = delete;
+
+    ~TaskGroup() { this->wait_without_rethrow(); } // tasks reference the group, it can't die before they finish
+
+    template <class Func, class... Args>
+    void add_task(Func&& func, Args&&... args) {
+        ++this->tasks_pending;
+
+        this->pool.add_task([this, task = std::bind(std::forward<Func>(func), std::forward<Args>(args)...)]() mutable {
+            try {
+                task();
+            } catch (...) {
+                const std::lock_guard<std::mutex> exception_lock(this->exception_mutex);
+                if (!this->exception) this->exception = std::current_exception();
+            }
+
+            ThreadPool& pool = this->pool; // group may be destroyed as soon as the counter reaches zero
+            if (--this->tasks_pending == 0) pool.notify_helpers();
+        });
+    }
+
+    void wait() {
+        this->wait_without_rethrow();
+
+        if (this->exception) std::rethrow_exception(std::exchange(this->exception, nullptr));
+    }
+};
+
 // ================
 // --- Task API ---
 // ================
@@ -354,6 +1105,11 @@ constexpr std::size_t default_grains_per_thread = 4;
 // yet we want it to be a bit more granular than doing 1 task per thread since
 // that would be horrible if tasks are noticeably uneven.
 
+// Pool with no threads still runs tasks on the waiting thread, for splitting purposes it counts as 1 thread
+[[nodiscard]] inline std::size_t _default_grain_size(std::size_t range_size) {
+    return _max_size(1, range_size / (_max_size(1, get_thread_count()) * default_grains_per_thread));
+}
+
 // Note:
 // In range constructors we intentionally allow some possibly narrowing conversions like 'it1 - it2' to 'size_t'
 // for better compatibility with containers that can use large ints as their difference type
@@ -368,7 +1124,7 @@ struct IndexRange {
     constexpr IndexRange(Idx first, Idx last, std::size_t grain_size)
         : first(first), last(last), grain_size(grain_size) {}
     IndexRange(Idx first, Idx last)
-        : IndexRange(first, last, _max_size(1, (last - first) / (get_thread_count() * default_grains_per_thread))){};
+        : IndexRange(first, last, _default_grain_size(last - first)){};
 };
 
 template <class Iter>
@@ -380,13 +1136,14 @@ struct Range {
     Range() = delete;
     constexpr Range(Iter begin, Iter end, std::size_t grain_size) : begin(begin), end(end), grain_size(grain_size) {}
     Range(Iter begin, Iter end)
-        : Range(begin, end, _max_size(1, (end - begin) / (get_thread_count() * default_grains_per_thread))) {}
+        : Range(begin, end, _default_grain_size(end - begin)) {}
 
 
-    template <class Container>
+    // Copying a non-const 'Range' lvalue would pick templated constructors over the copy constructor, hence the SFINAE
+    template <class Container, std::enable_if_t<!std::is_same_v<std::remove_cv_t<Container>, Range>, bool> = true>
     Range(const Container& container) : Range(container.begin(), container.end()) {}
 
-    template <class Container>
+    template <class Container, std::enable_if_t<!std::is_same_v<std::remove_cv_t<Container>, Range>, bool> = true>
     Range(Container& container) : Range(container.begin(), container.end()) {}
 };// requires random-access iterator, but no good way to express that before C++20 concepts
 
@@ -402,29 +1159,288 @@ Range(const Container& container) -> Range<typename Container::const_iterator>;
 template <class Container>
 Range(Container& container) -> Range<typename Container::iterator>;
 
+// --- Multi-dimensional ranges ---
+// --------------------------------
+
+// Blocked 2D / 3D index spaces, each dimension is an 'IndexRange' whose 'grain_size' acts as the tile extent
+// along that dimension. Dimensions are listed from the outermost (slowest-varying) to the innermost one, which
+// for a row-major matrix means '{ rows, cols }'.
+//
+// Tile traversal order decides which tiles end up next to each other in a task (and in time):
+//    - 'ROW_MAJOR' - tiles are walked row by row, same as a regular nested loop
+//    - 'MORTON'    - tiles are walked along the Z-order curve, consecutive tiles stay close in every dimension,
+//                    which helps kernels that also touch neighbouring tiles (stencils, transposition, etc.)
+enum class Traversal { ROW_MAJOR, MORTON };
+
+constexpr std::size_t default_tile_size_2d = 64;
+constexpr std::size_t default_tile_size_3d = 16;
+// 64x64 doubles is 32 KiB & 16x16x16 doubles is another 32 KiB, which is a tile of input & a tile of output
+// fitting into a typical 32-64 KiB L1 cache. Like 'default_grains_per_thread' this is empirical rather than exact.
+
+template <class Idx>
+struct IndexRange2D {
+    IndexRange<Idx> i;
+    IndexRange<Idx> j;
+    Traversal       traversal;
+
+    IndexRange2D() = delete;
+    constexpr IndexRange2D(IndexRange<Idx> i, IndexRange<Idx> j, Traversal traversal = Traversal::ROW_MAJOR)
+        : i(i), j(j), traversal(traversal) {}
+    constexpr IndexRange2D(Idx i_extent, Idx j_extent, Traversal traversal = Traversal::ROW_MAJOR)
+        : IndexRange2D({Idx{}, i_extent, default_tile_size_2d}, {Idx{}, j_extent, default_tile_size_2d}, traversal) {}
+
+    // Accepts any matrix-like type with '.rows()' & '.cols()', such as 'mvl::Matrix'
+    template <class Matrix, class = decltype(std::declval<const Matrix&>().cols())>
+    explicit IndexRange2D(const Matrix& matrix, Traversal traversal = Traversal::ROW_MAJOR)
+        : IndexRange2D(static_cast<Idx>(matrix.rows()), static_cast<Idx>(matrix.cols()), traversal) {}
+};
+
+template <class Matrix, class = decltype(std::declval<const Matrix&>().cols())>
+IndexRange2D(const Matrix& matrix) -> IndexRange2D<decltype(std::declval<const Matrix&>().rows())>;
+
+template <class Matrix, class = decltype(std::declval<const Matrix&>().cols())>
+IndexRange2D(const Matrix& matrix, Traversal traversal) -> IndexRange2D<decltype(std::declval<const Matrix&>().rows())>;
+
+template <class Idx>
+struct IndexRange3D {
+    IndexRange<Idx> i;
+    IndexRange<Idx> j;
+    IndexRange<Idx> k;
+    Traversal       traversal;
+
+    IndexRange3D() = delete;
+    constexpr IndexRange3D(IndexRange<Idx> i, IndexRange<Idx> j, IndexRange<Idx> k,
+                           Traversal traversal = Traversal::ROW_MAJOR)
+        : i(i), j(j), k(k), traversal(traversal) {}
+    constexpr IndexRange3D(Idx i_extent, Idx j_extent, Idx k_extent, Traversal traversal = Traversal::ROW_MAJOR)
+        : IndexRange3D({Idx{}, i_extent, default_tile_size_3d}, {Idx{}, j_extent, default_tile_size_3d},
+                       {Idx{}, k_extent, default_tile_size_3d}, traversal) {}
+};
+
 // ==========================
 // --- 'Parallel for' API ---
 // ==========================
 
+// Loops only wait for their own tasks, which means they can be safely nested and called from inside other tasks
+
+// Loop schedules, similar to OpenMP 'schedule(static | dynamic | guided)':
+//    - 'STATIC'  - range gets split into 'grain_size' chunks upfront, each chunk is submitted as a separate task
+//    - 'DYNAMIC' - 1 task per thread, tasks claim 'grain_size' chunks from a shared atomic counter until the range
+//                  is exhausted, threads that got cheap iterations simply claim more chunks
+//    - 'GUIDED'  - same as 'DYNAMIC', but the claimed chunk is proportional to the remaining work and shrinks
+//                  down to 'grain_size', large chunks at the start keep claiming overhead low, small chunks
+//                  at the end balance out the tail
+// Static schedule has the least overhead and works best when iterations have similar cost, dynamic & guided
+// schedules are meant for irregular workloads where a fixed split leaves threads idle at the tail.
+//
+// Not to be confused with 'Scheduler', which selects how the pool itself distributes tasks between workers.
+enum class Schedule { STATIC, DYNAMIC, GUIDED };
+
+// Runs 'func(low, high)' over sub-ranges of '[0, size)' claimed from a shared counter, used by non-static schedules
+template <class Func>
+void _for_loop_claiming(std::size_t size, std::size_t grain_size, Schedule schedule, Func& func) {
+    if (size == 0) return;
+
+    const std::size_t thread_count = _max_size(1, get_thread_count());
+    const std::size_t min_chunk    = _max_size(1, grain_size);
+    const std::size_t task_count   = _min_size(thread_count, (size + min_chunk - 1) / min_chunk);
+
+    std::atomic<std::size_t> next{0};
+    // relaxed ordering is sufficient, the counter only partitions the range,
+    // results are synchronized by the task group once the loop is finished
+
+    const auto claim = [&](std::size_t& low, std::size_t& high) -> bool {
+        if (schedule == Schedule::DYNAMIC) {
+            low = next.fetch_add(min_chunk, std::memory_order_relaxed);
+            if (low >= size) return false;
+            high = _min_size(low + min_chunk, size);
+            return true;
+        }
+
+        low = next.load(std::memory_order_relaxed);
+        do {
+            if (low >= size) return false;
+            const std::size_t remaining = size - low;
+            high = low + _min_size(remaining, _max_size(min_chunk, remaining / (2 * thread_count)));
+        } while (!next.compare_exchange_weak(low, high, std::memory_order_relaxed));
+        return true;
+    };
+
+    const auto run = [&] {
+        std::size_t low, high;
+        while (claim(low, high)) func(low, high);
+    };
+
+    TaskGroup group;
+
+    for (std::size_t i = 0; i < task_count; ++i) group.add_task(std::ref(run));
+
+    group.wait();
+}
+
 template <class Idx, class Func>
-void for_loop(IndexRange<Idx> range, Func&& func) {
-    for (Idx i = range.first; i < range.last; i += range.grain_size)
-        task(std::forward<Func>(func), i, _min_size(i + range.grain_size, range.last));
+void for_loop(IndexRange<Idx> range, Func&& func, Schedule schedule = Schedule::STATIC) {
+    if (schedule != Schedule::STATIC) {
+        if (!(range.first < range.last)) return;
+
+        auto offset_func = [&](std::size_t low, std::size_t high) {
+            func(static_cast<Idx>(range.first + low), static_cast<Idx>(range.first + high));
+        };
+        _for_loop_claiming(range.last - range.first, range.grain_size, schedule, offset_func);
+        return;
+    }
 
-    wait_for_tasks();
+    const std::size_t grain_size = _max_size(1, range.grain_size);
+
+    TaskGroup group;
+
+    for (Idx i = range.first; i < range.last; i += grain_size) {
+        const bool is_last_chunk = static_cast<std::size_t>(range.last - i) <= grain_size;
+        group.add_task(std::ref(func), i, is_last_chunk ? range.last : static_cast<Idx>(i + grain_size));
+    } // no '_min_size()' here since it would break for negative indices
+
+    group.wait();
 }
 
 template <class Iter, class Func>
-void for_loop(Range<Iter> range, Func&& func) {
-    for (Iter i = range.begin; i < range.end; i += range.grain_size)
-        task(std::forward<Func>(func), i, i + _min_size(range.grain_size, range.end - i));
+void for_loop(Range<Iter> range, Func&& func, Schedule schedule = Schedule::STATIC) {
+    if (schedule != Schedule::STATIC) {
+        if (!(range.begin < range.end)) return;
+
+        auto offset_func = [&](std::size_t low, std::size_t high) { func(range.begin + low, range.begin + high); };
+        _for_loop_claiming(range.end - range.begin, range.grain_size, schedule, offset_func);
+        return;
+    }
+
+    const std::size_t grain_size = _max_size(1, range.grain_size);
+
+    TaskGroup group;
+
+    for (Iter i = range.begin; i < range.end; i += grain_size)
+        group.add_task(std::ref(func), i, i + _min_size(grain_size, range.end - i));
 
-    wait_for_tasks();
+    group.wait();
 }
 
 template <class Container, class Func>
-void for_loop(Container&& container, Func&& func) {
-    for_loop(Range{std::forward<Container>(container)}, std::forward<Func>(func));
+void for_loop(Container&& container, Func&& func, Schedule schedule = Schedule::STATIC) {
+    for_loop(Range{std::forward<Container>(container)}, std::forward<Func>(func), schedule);
+}
+
+// Parallel algorithms often need to know which chunk they are working on (to store per-chunk results),
+// these helpers split '[0, size)' into 'grain_size' chunks & run 'func(chunk, low, high)' for each one in parallel
+[[nodiscard]] constexpr std::size_t _chunk_count(std::size_t size, std::size_t grain_size) noexcept {
+    grain_size = _max_size(1, grain_size);
+    return (size + grain_size - 1) / grain_size;
+}
+
+template <class Func>
+void _for_each_chunk(std::size_t size, std::size_t grain_size, Func&& func) {
+    grain_size = _max_size(1, grain_size);
+
+    for_loop(IndexRange<std::size_t>{0, _chunk_count(size, grain_size), 1}, [&](std::size_t low, std::size_t high) {
+        for (std::size_t chunk = low; chunk < high; ++chunk)
+            func(chunk, chunk * grain_size, _min_size((chunk + 1) * grain_size, size));
+    });
+}
+
+// --- Multi-dimensional loops ---
+// -------------------------------
+
+// Tiles of each dimension are numbered '0, 1, ...', the last tile may be partial
+template <class Idx>
+[[nodiscard]] std::size_t _tile_count(const IndexRange<Idx>& range) noexcept {
+    if (!(range.first < range.last)) return 0;
+    return _chunk_count(static_cast<std::size_t>(range.last - range.first), range.grain_size);
+}
+
+template <class Idx>
+[[nodiscard]] std::pair<Idx, Idx> _tile_bounds(const IndexRange<Idx>& range, std::size_t tile) noexcept {
+    const std::size_t grain_size = _max_size(1, range.grain_size);
+    const std::size_t size       = static_cast<std::size_t>(range.last - range.first);
+    const std::size_t low        = tile * grain_size;
+    const std::size_t high       = _min_size(low + grain_size, size);
+    return {static_cast<Idx>(range.first + static_cast<Idx>(low)),
+            static_cast<Idx>(range.first + static_cast<Idx>(high))};
+}
+
+// Interleaves bits of tile coordinates, sorting tiles by this code walks them along the Z-order curve
+template <std::size_t N>
+[[nodiscard]] constexpr std::size_t _morton_code(const std::array<std::size_t, N>& coords) noexcept {
+    constexpr std::size_t bits_per_coord = std::numeric_limits<std::size_t>::digits / N;
+
+    std::size_t code = 0;
+    for (std::size_t bit = 0; bit < bits_per_coord; ++bit)
+        for (std::size_t d = 0; d < N; ++d) code |= ((coords[d] >> bit) & 1) << (bit * N + (N - 1 - d));
+    return code;
+}
+
+// Runs 'func(coords)' for every tile of an 'N'-dimensional tile grid, tiles are split into tasks
+// along the chosen traversal order, so each task gets a contiguous piece of the curve
+template <std::size_t N, class Func>
+void _for_each_tile(const std::array<std::size_t, N>& tile_counts, Traversal traversal, Schedule schedule,
+                    Func&& func) {
+    std::size_t total = 1;
+    for (std::size_t count : tile_counts) total *= count;
+    if (total == 0) return;
+
+    const auto unflatten = [&](std::size_t flat) {
+        std::array<std::size_t, N> coords{};
+        for (std::size_t d = N; d-- > 0;) {
+            coords[d] = flat % tile_counts[d];
+            flat /= tile_counts[d];
+        }
+        return coords;
+    };
+
+    const IndexRange<std::size_t> tiles{0, total, _default_grain_size(total)};
+
+    if (traversal == Traversal::ROW_MAJOR) {
+        for_loop(
+            tiles,
+            [&](std::size_t low, std::size_t high) {
+                for (std::size_t t = low; t < high; ++t) func(unflatten(t));
+            },
+            schedule);
+        return;
+    }
+
+    // Tile grids are small compared to the index space (a tile covers thousands of indices),
+    // so sorting them by Morton code is cheap & handles grids that aren't powers of 2 without any special cases
+    std::vector<std::pair<std::size_t, std::size_t>> order(total); // { morton code, row-major index }
+    for (std::size_t t = 0; t < total; ++t) order[t] = {_morton_code<N>(unflatten(t)), t};
+    std::sort(order.begin(), order.end());
+
+    for_loop(
+        tiles,
+        [&](std::size_t low, std::size_t high) {
+            for (std::size_t t = low; t < high; ++t) func(unflatten(order[t].second));
+        },
+        schedule);
+}
+
+template <class Idx, class Func>
+void for_loop(IndexRange2D<Idx> range, Func&& func, Schedule schedule = Schedule::STATIC) {
+    const std::array<std::size_t, 2> tile_counts = {_tile_count(range.i), _tile_count(range.j)};
+
+    _for_each_tile<2>(tile_counts, range.traversal, schedule, [&](const std::array<std::size_t, 2>& tile) {
+        const auto [i_low, i_high] = _tile_bounds(range.i, tile[0]);
+        const auto [j_low, j_high] = _tile_bounds(range.j, tile[1]);
+        func(i_low, i_high, j_low, j_high);
+    });
+}
+
+template <class Idx, class Func>
+void for_loop(IndexRange3D<Idx> range, Func&& func, Schedule schedule = Schedule::STATIC) {
+    const std::array<std::size_t, 3> tile_counts = {_tile_count(range.i), _tile_count(range.j),
+                                                    _tile_count(range.k)};
+
+    _for_each_tile<3>(tile_counts, range.traversal, schedule, [&](const std::array<std::size_t, 3>& tile) {
+        const auto [i_low, i_high] = _tile_bounds(range.i, tile[0]);
+        const auto [j_low, j_high] = _tile_bounds(range.j, tile[1]);
+        const auto [k_low, k_high] = _tile_bounds(range.k, tile[2]);
+        func(i_low, i_high, j_low, j_high, k_low, k_high);
+    });
 }
 
 // =============================
@@ -433,58 +1449,75 @@ void for_loop(Container&& container, Func&& func) {
 
 constexpr std::size_t default_unroll = 1;
 
-template <std::size_t unroll = default_unroll, class BinaryOp, class Iter, class T = typename Iter::value_type>
-auto reduce(Range<Iter> range, BinaryOp&& op) -> T {
+// Per-chunk partial results are padded to a cache line so neighbouring chunks finishing at the same time
+// don't invalidate each other's slots, 'std::optional<>' lets us avoid requiring 'T' to be default-constructible
+template <class T>
+struct alignas(_cache_line_size) _padded_partial {
+    std::optional<T> value;
+};
 
-    MutexProtected<T> result = *range.begin;
-    // we have to start from the 1st element and not 'T{}' because there is no guarantee
-    // than doing so would be correct for some non-trivial 'T' and 'op'
-
-    for_loop(Range<Iter>{range.begin + 1, range.end, range.grain_size}, [&](Iter low, Iter high) {
-        const std::size_t range_size = high - low;
-
-        // Execute unrolled loop if unrolling is enabled and the range is sufficiently large
-        if constexpr (unroll > 1)
-            if (range_size > unroll) {
-                // (parallel section) Compute partial result (unrolled for SIMD)
-                // Reduce unrollable part
-                std::array<T, unroll> partial_results;
-                _unroll<std::size_t, unroll>([&](std::size_t j) { partial_results[j] = *(low + j); });
-                Iter it = low + unroll;
-                for (; it < high - unroll; it += unroll)
-                    _unroll<std::size_t, unroll>(
-                        [&, it](std::size_t j) { partial_results[j] = op(partial_results[j], *(it + j)); });
-                // Reduce remaining elements
-                for (; it < high; ++it) partial_results[0] = op(partial_results[0], *it);
-                // Collect the result
-                for (std::size_t i = 1; i < partial_results.size(); ++i)
-                    partial_results[0] = op(partial_results[0], partial_results[i]);
-
-                // (critical section) Add partial result to the global one
-                result.apply([&](auto&& res) { res = op(std::forward<decltype(res)>(res), partial_results[0]); });
-
-                return; // skip the non-unrolled version
-            }
+// Reduces '[low, high)' sequentially, 'get(it)' produces the value associated with iterator 'it'.
+// Every chunk starts from its own first value and not 'T{}' because there is no guarantee
+// that doing so would be correct for some non-trivial 'T' and 'op'.
+template <std::size_t unroll, class T, class Iter, class BinaryOp, class Getter>
+T _reduce_chunk(Iter low, Iter high, BinaryOp& op, Getter& get) {
+    const std::size_t range_size = high - low;
+
+    // Execute unrolled loop if unrolling is enabled and the range is sufficiently large
+    if constexpr (unroll > 1)
+        if (range_size > unroll) {
+            // Reduce unrollable part (unrolled for SIMD)
+            std::array<T, unroll> partial_results;
+            _unroll<std::size_t, unroll>([&](std::size_t j) { partial_results[j] = get(low + j); });
+            Iter it = low + unroll;
+            for (; it < high - unroll; it += unroll)
+                _unroll<std::size_t, unroll>(
+                    [&, it](std::size_t j) { partial_results[j] = op(partial_results[j], get(it + j)); });
+            // Reduce remaining elements
+            for (; it < high; ++it) partial_results[0] = op(partial_results[0], get(it));
+            // Collect the result
+            for (std::size_t i = 1; i < partial_results.size(); ++i)
+                partial_results[0] = op(partial_results[0], partial_results[i]);
+
+            return partial_results[0]; // skip the non-unrolled version
+        }
+    // 'if constexpr (unroll > 1)' ensures that unrolling logic will have no effect
+    //  whatsoever on the non-unrolled version of the template, it will not even compile.
+
+    // Fallback onto a regular reduction loop otherwise
+    T partial_result = get(low);
+    for (auto it = low + 1; it != high; ++it) partial_result = op(partial_result, get(it));
+    return partial_result;
+}
+
+template <std::size_t unroll, class T, class Iter, class BinaryOp, class Getter>
+T _reduce_impl(Range<Iter> range, BinaryOp& op, Getter& get) {
+    const std::size_t range_size  = range.end - range.begin;
+    const std::size_t chunk_count = _chunk_count(range_size, range.grain_size);
 
-        // Fallback onto a regular reduction loop otherwise
-        // (parallel section) Compute partial result
-        T partial_result = *low;
-        for (auto it = low + 1; it != high; ++it) partial_result = op(partial_result, *it);
+    // (parallel section) Each chunk writes its partial result into its own slot, no locking needed
+    std::vector<_padded_partial<T>> partials(chunk_count);
 
-        // (critical section) Add partial result to the global one
-        result.apply([&](auto&& res) { res = op(std::forward<decltype(res)>(res), partial_result); });
+    _for_each_chunk(range_size, range.grain_size, [&](std::size_t chunk, std::size_t low, std::size_t high) {
+        partials[chunk].value.emplace(_reduce_chunk<unroll, T>(range.begin + low, range.begin + high, op, get));
     });
 
-    // Note 1:
-    // We could also collect results into an array of partial results and then reduce it on the
-    // main thread at the end, but that leads to a much less clean implementation and doesn't
-    // seem to be measurably faster.
+    // (serial section) Combine partial results pairwise in a tree, this keeps the order of operations
+    // deterministic for a given grain size and tends to accumulate less floating point error than a linear fold
+    for (std::size_t stride = 1; stride < chunk_count; stride *= 2)
+        for (std::size_t i = 0; i + stride < chunk_count; i += 2 * stride)
+            partials[i].value.emplace(op(*partials[i].value, *partials[i + stride].value));
 
-    // Note 2:
-    // 'if constexpr (unroll > 1)' ensures that unrolling logic will have no effect
-    //  whatsoever on the non-unrolled version of the template, it will not even compile.
+    return std::move(*partials.front().value);
+}
 
-    return result.release();
+// Note:
+// All reductions expect a non-empty range since there is no identity element to return otherwise
+
+template <std::size_t unroll = default_unroll, class BinaryOp, class Iter, class T = typename Iter::value_type>
+auto reduce(Range<Iter> range, BinaryOp&& op) -> T {
+    auto get = [](Iter it) -> decltype(auto) { return *it; };
+    return _reduce_impl<unroll, T>(range, op, get);
 }
 
 template <std::size_t unroll = default_unroll, class BinaryOp, class Container>
@@ -492,6 +1525,37 @@ auto reduce(Container&& container, BinaryOp&& op) -> typename std::decay_t<Conta
     return reduce<unroll>(Range{std::forward<Container>(container)}, std::forward<BinaryOp>(op));
 }
 
+// --- Transform-reduce ---
+// ------------------------
+
+template <std::size_t unroll = default_unroll, class BinaryOp, class UnaryOp, class Iter,
+          class T = std::decay_t<std::invoke_result_t<UnaryOp&, typename std::iterator_traits<Iter>::reference>>>
+auto transform_reduce(Range<Iter> range, BinaryOp&& reduce_op, UnaryOp&& transform_op) -> T {
+    auto get = [&](Iter it) -> T { return transform_op(*it); };
+    return _reduce_impl<unroll, T>(range, reduce_op, get);
+}
+
+template <std::size_t unroll = default_unroll, class BinaryOp, class UnaryOp, class Container>
+auto transform_reduce(Container&& container, BinaryOp&& reduce_op, UnaryOp&& transform_op) {
+    return transform_reduce<unroll>(Range{std::forward<Container>(container)}, std::forward<BinaryOp>(reduce_op),
+                                    std::forward<UnaryOp>(transform_op));
+}
+
+template <std::size_t unroll = default_unroll, class BinaryOp, class TransformOp, class Iter1, class Iter2,
+          class T = std::decay_t<std::invoke_result_t<TransformOp&, typename std::iterator_traits<Iter1>::reference,
+                                                      typename std::iterator_traits<Iter2>::reference>>>
+auto transform_reduce(Range<Iter1> range, Iter2 first2, BinaryOp&& reduce_op, TransformOp&& transform_op) -> T {
+    auto get = [&](Iter1 it) -> T { return transform_op(*it, *(first2 + (it - range.begin))); };
+    return _reduce_impl<unroll, T>(range, reduce_op, get);
+}
+
+template <std::size_t unroll = default_unroll, class BinaryOp, class TransformOp, class Container1, class Container2>
+auto transform_reduce(Container1&& container1, Container2&& container2, BinaryOp&& reduce_op,
+                      TransformOp&& transform_op) {
+    return transform_reduce<unroll>(Range{std::forward<Container1>(container1)}, container2.begin(),
+                                    std::forward<BinaryOp>(reduce_op), std::forward<TransformOp>(transform_op));
+}
+
 // --- Pre-defined binary ops ---
 // ------------------------------
 
@@ -553,7 +1617,355 @@ struct max<void> {
     using is_transparent = std::less<>::is_transparent;
 };
 
+// ===========================
+// --- Parallel algorithms ---
+// ===========================
+
+// Parallel counterparts of some standard algorithms built on top of ranges & the thread pool.
+//
+// Algorithms that need a temporary buffer ('partition()', 'sort()') require 'value_type' to be default-constructible
+// and move-assignable, this allows buffers to be filled in parallel. All iterators are expected to be random-access.
+
+// --- Transform ---
+// -----------------
+
+template <class Iter, class OutIter, class UnaryOp>
+OutIter transform(Range<Iter> range, OutIter out, UnaryOp&& op) {
+    for_loop(range, [&](Iter low, Iter high) {
+        OutIter dst = out + (low - range.begin);
+        for (Iter it = low; it != high; ++it, ++dst) *dst = op(*it);
+    });
+
+    return out + (range.end - range.begin);
+}
+
+template <class Container, class OutIter, class UnaryOp>
+OutIter transform(Container&& container, OutIter out, UnaryOp&& op) {
+    return transform(Range{std::forward<Container>(container)}, out, std::forward<UnaryOp>(op));
+}
+
+// --- Count ---
+// -------------
+
+template <class Iter, class UnaryPred>
+std::size_t count_if(Range<Iter> range, UnaryPred&& pred) {
+    if (!(range.begin < range.end)) return 0;
+
+    return transform_reduce(range, sum<>{}, [&](const auto& value) -> std::size_t { return pred(value) ? 1 : 0; });
+}
+
+template <class Container, class UnaryPred>
+std::size_t count_if(Container&& container, UnaryPred&& pred) {
+    return count_if(Range{std::forward<Container>(container)}, std::forward<UnaryPred>(pred));
+}
+
+// --- Find ---
+// ------------
+
+// Chunks check the index of the best match found so far every '_find_check_period' iterations
+// and stop early once it is known that no element of theirs can be the first match
+constexpr std::size_t _find_check_period = 1024;
+
+template <class Iter, class UnaryPred>
+Iter find_if(Range<Iter> range, UnaryPred&& pred) {
+    const std::size_t range_size = range.end - range.begin;
+
+    std::atomic<std::size_t> found{range_size}; // index of the first match found so far
+
+    _for_each_chunk(range_size, range.grain_size, [&](std::size_t, std::size_t low, std::size_t high) {
+        for (std::size_t block = low; block < high; block += _find_check_period) {
+            if (found.load(std::memory_order_relaxed) < block) return;
+
+            const Iter block_begin = range.begin + block;
+            const Iter block_end   = range.begin + _min_size(block + _find_check_period, high);
+
+            for (Iter it = block_begin; it != block_end; ++it) {
+                if (!pred(*it)) continue;
+
+                const std::size_t i       = it - range.begin;
+                std::size_t       current = found.load(std::memory_order_relaxed);
+                while (i < current && !found.compare_exchange_weak(current, i, std::memory_order_relaxed));
+                return;
+            }
+        }
+    });
+
+    return range.begin + found.load();
+}
+
+template <class Container, class UnaryPred>
+auto find_if(Container&& container, UnaryPred&& pred) {
+    return find_if(Range{std::forward<Container>(container)}, std::forward<UnaryPred>(pred));
+}
+
+// --- Scan ---
+// ------------
+
+// Both scans are done in 3 passes:
+//    1. (parallel) Reduce every chunk
+//    2. (serial)   Scan chunk results to get the starting value of every chunk
+//    3. (parallel) Scan every chunk starting from its value
+// Every element gets read before its output is written, which means scans can be done in-place ('out == range.begin').
+
+template <class Iter, class OutIter, class BinaryOp>
+OutIter inclusive_scan(Range<Iter> range, OutIter out, BinaryOp&& op) {
+    using value_type = typename std::iterator_traits<Iter>::value_type;
+
+    const std::size_t range_size  = range.end - range.begin;
+    const std::size_t chunk_count = _chunk_count(range_size, range.grain_size);
+
+    std::vector<_padded_partial<value_type>> partials(chunk_count);
+
+    auto get = [](Iter it) -> decltype(auto) { return *it; };
+
+    _for_each_chunk(range_size, range.grain_size, [&](std::size_t chunk, std::size_t low, std::size_t high) {
+        if (chunk + 1 == chunk_count) return; // total of the last chunk is never used
+        partials[chunk].value.emplace(_reduce_chunk<1, value_type>(range.begin + low, range.begin + high, op, get));
+    });
+
+    for (std::size_t chunk = 1; chunk + 1 < chunk_count; ++chunk)
+        partials[chunk].value.emplace(op(*partials[chunk - 1].value, *partials[chunk].value));
+    // now 'partials[i]' holds the reduction of all chunks up to 'i' inclusive
+
+    _for_each_chunk(range_size, range.grain_size, [&](std::size_t chunk, std::size_t low, std::size_t high) {
+        Iter    it  = range.begin + low;
+        OutIter dst = out + low;
+
+        value_type acc = chunk ? op(*partials[chunk - 1].value, *it) : *it;
+        *dst           = acc;
+
+        for (++it, ++dst; it != range.begin + high; ++it, ++dst) {
+            acc  = op(acc, *it);
+            *dst = acc;
+        }
+    });
+
+    return out + range_size;
+}
+
+template <class Container, class OutIter, class BinaryOp>
+OutIter inclusive_scan(Container&& container, OutIter out, BinaryOp&& op) {
+    return inclusive_scan(Range{std::forward<Container>(container)}, out, std::forward<BinaryOp>(op));
+}
+
+template <class Iter, class OutIter, class T, class BinaryOp>
+OutIter exclusive_scan(Range<Iter> range, OutIter out, T init, BinaryOp&& op) {
+    const std::size_t range_size  = range.end - range.begin;
+    const std::size_t chunk_count = _chunk_count(range_size, range.grain_size);
+
+    std::vector<_padded_partial<T>> partials(chunk_count);
+
+    auto get = [](Iter it) -> T { return *it; };
+
+    _for_each_chunk(range_size, range.grain_size, [&](std::size_t chunk, std::size_t low, std::size_t high) {
+        if (chunk + 1 == chunk_count) return; // total of the last chunk is never used
+        partials[chunk].value.emplace(_reduce_chunk<1, T>(range.begin + low, range.begin + high, op, get));
+    });
+
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        if (chunk + 1 == chunk_count) {
+            partials[chunk].value.emplace(std::move(init));
+            break;
+        }
+        T next = op(init, *partials[chunk].value);
+        partials[chunk].value.emplace(std::move(init));
+        init = std::move(next);
+    } // now 'partials[i]' holds the starting value of the chunk 'i'
+
+    _for_each_chunk(range_size, range.grain_size, [&](std::size_t chunk, std::size_t low, std::size_t high) {
+        OutIter dst = out + low;
+        T       acc = std::move(*partials[chunk].value);
+
+        for (Iter it = range.begin + low; it != range.begin + high; ++it, ++dst) {
+            T next = op(acc, *it);
+            *dst   = std::move(acc);
+            acc    = std::move(next);
+        }
+    });
+
+    return out + range_size;
+}
+
+template <class Container, class OutIter, class T, class BinaryOp>
+OutIter exclusive_scan(Container&& container, OutIter out, T init, BinaryOp&& op) {
+    return exclusive_scan(Range{std::forward<Container>(container)}, out, std::move(init), std::forward<BinaryOp>(op));
+}
+
+// --- Partition ---
+// -----------------
+
+// Stable partition done in 3 passes:
+//    1. (parallel) Evaluate predicate for every element & count matches in every chunk
+//    2. (serial)   Compute where matching & non-matching elements of every chunk should go
+//    3. (parallel) Move elements into a buffer at their final positions, then move them back
+// Predicate results are cached so it gets evaluated exactly once per element.
+
+template <class Iter, class UnaryPred>
+Iter partition(Range<Iter> range, UnaryPred&& pred) {
+    using value_type = typename std::iterator_traits<Iter>::value_type;
+
+    const std::size_t range_size  = range.end - range.begin;
+    const std::size_t grain_size  = _max_size(1, range.grain_size);
+    const std::size_t chunk_count = _chunk_count(range_size, grain_size);
+
+    std::vector<char>        matches(range_size); // not 'std::vector<bool>' since we write to it from multiple threads
+    std::vector<std::size_t> match_counts(chunk_count);
+
+    _for_each_chunk(range_size, grain_size, [&](std::size_t chunk, std::size_t low, std::size_t high) {
+        std::size_t count = 0;
+        for (std::size_t i = low; i < high; ++i) count += (matches[i] = pred(*(range.begin + i)) ? 1 : 0);
+        match_counts[chunk] = count;
+    });
+
+    std::vector<std::size_t> match_offsets(chunk_count);
+    std::vector<std::size_t> mismatch_offsets(chunk_count);
+
+    std::size_t total_matches = 0;
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        match_offsets[chunk] = total_matches;
+        total_matches += match_counts[chunk];
+    }
+
+    std::size_t total_mismatches = total_matches; // non-matching elements go after the matching ones
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        mismatch_offsets[chunk] = total_mismatches;
+        total_mismatches += _min_size(grain_size, range_size - chunk * grain_size) - match_counts[chunk];
+    }
+
+    std::vector<value_type> buffer(range_size);
+
+    _for_each_chunk(range_size, grain_size, [&](std::size_t chunk, std::size_t low, std::size_t high) {
+        std::size_t match_pos    = match_offsets[chunk];
+        std::size_t mismatch_pos = mismatch_offsets[chunk];
+        for (std::size_t i = low; i < high; ++i)
+            buffer[matches[i] ? match_pos++ : mismatch_pos++] = std::move(*(range.begin + i));
+    });
+
+    _for_each_chunk(range_size, grain_size, [&](std::size_t, std::size_t low, std::size_t high) {
+        for (std::size_t i = low; i < high; ++i) *(range.begin + i) = std::move(buffer[i]);
+    });
+
+    return range.begin + total_matches;
+}
+
+template <class Container, class UnaryPred>
+auto partition(Container&& container, UnaryPred&& pred) {
+    return partition(Range{std::forward<Container>(container)}, std::forward<UnaryPred>(pred));
+}
+
+// --- Sort ---
+// ------------
+
+// Parallel merge sort:
+//    1. (parallel) Sort every chunk with 'std::sort()'
+//    2. (parallel) Merge sorted runs pairwise until a single run remains, ping-ponging between the range & a buffer
+// Merging 2 large runs on a single thread would make the last rounds serial, to avoid this every merge gets split into
+// independent parts using merge path partitioning, which keeps the number of tasks per round roughly constant.
+
+// Returns how many elements of 'a' go into the first 'k' elements of 'merge(a, b)', the same way 'std::merge()'
+// would do it, that is, equivalent elements of 'a' go before those of 'b'
+template <class Iter1, class Iter2, class Compare>
+std::size_t _merge_path(std::size_t k, Iter1 a, std::size_t a_size, Iter2 b, std::size_t b_size, Compare& comp) {
+    std::size_t low  = (k > b_size) ? k - b_size : 0;
+    std::size_t high = _min_size(k, a_size);
+
+    while (low < high) {
+        const std::size_t mid = low + (high - low) / 2;
+        if (!comp(*(b + (k - mid - 1)), *(a + mid))) low = mid + 1; // 'a[mid]' goes before 'b[k - mid - 1]'
+        else high = mid;
+    }
+
+    return low;
+}
+
+template <class Iter, class Compare = std::less<>>
+void sort(Range<Iter> range, Compare&& comp = Compare{}) {
+    using value_type = typename std::iterator_traits<Iter>::value_type;
+
+    const std::size_t range_size  = range.end - range.begin;
+    const std::size_t grain_size  = _max_size(1, range.grain_size);
+    const std::size_t chunk_count = _chunk_count(range_size, grain_size);
+
+    if (chunk_count <= 1) return std::sort(range.begin, range.end, comp); // nothing to parallelize
+
+    _for_each_chunk(range_size, grain_size, [&](std::size_t, std::size_t low, std::size_t high) {
+        std::sort(range.begin + low, range.begin + high, comp);
+    });
+
+    std::vector<value_type>  buffer(range_size);
+    std::vector<std::size_t> splits; // how many elements of the 1st run precede every merge part
+
+    // Merges pairs of sorted runs of size 'run' from 'src' into 'dst', every merge is split into 'part_count' parts
+    const auto merge_round = [&](auto src, auto dst, std::size_t run, std::size_t pair_count, std::size_t part_count) {
+        const auto bounds = [&](std::size_t pair) {
+            const std::size_t low = pair * 2 * run;
+            return std::array{low, _min_size(low + run, range_size), _min_size(low + 2 * run, range_size)};
+        };
+        const auto part_start = [&](std::size_t merged_size, std::size_t part) {
+            return merged_size * part / part_count;
+        };
+
+        // Split points have to be found before merging starts since merging moves elements out of 'src'
+        splits.resize(pair_count * (part_count + 1));
+        for (std::size_t pair = 0; pair < pair_count; ++pair) {
+            const auto [low, mid, high] = bounds(pair);
+            for (std::size_t part = 0; part <= part_count; ++part)
+                splits[pair * (part_count + 1) + part] =
+                    _merge_path(part_start(high - low, part), src + low, mid - low, src + mid, high - mid, comp);
+        }
+
+        TaskGroup group;
+
+        for (std::size_t pair = 0; pair < pair_count; ++pair) {
+            for (std::size_t part = 0; part < part_count; ++part) {
+                group.add_task([&, pair, part] {
+                    const auto [low, mid, high] = bounds(pair);
+
+                    const std::size_t k_first = part_start(high - low, part);
+                    const std::size_t k_last  = part_start(high - low, part + 1);
+                    const std::size_t i_first = splits[pair * (part_count + 1) + part];
+                    const std::size_t i_last  = splits[pair * (part_count + 1) + part + 1];
+
+                    const auto a = src + low;
+                    const auto b = src + mid;
+
+                    std::merge(std::make_move_iterator(a + i_first), std::make_move_iterator(a + i_last),
+                               std::make_move_iterator(b + (k_first - i_first)),
+                               std::make_move_iterator(b + (k_last - i_last)), dst + low + k_first, comp);
+                });
+            }
+        }
+
+        group.wait();
+    };
+
+    bool in_buffer = false; // which side holds the sorted runs
+
+    for (std::size_t run = grain_size; run < range_size; run *= 2) {
+        const std::size_t pair_count = (range_size + 2 * run - 1) / (2 * run);
+        const std::size_t part_count = _max_size(1, chunk_count / pair_count);
+
+        if (in_buffer) merge_round(buffer.begin(), range.begin, run, pair_count, part_count);
+        else merge_round(range.begin, buffer.begin(), run, pair_count, part_count);
+
+        in_buffer = !in_buffer;
+    }
+
+    if (in_buffer)
+        _for_each_chunk(range_size, grain_size, [&](std::size_t, std::size_t low, std::size_t high) {
+            for (std::size_t i = low; i < high; ++i) *(range.begin + i) = std::move(buffer[i]);
+        });
+}
+
+template <class Container, class Compare = std::less<>>
+void sort(Container&& container, Compare&& comp = Compare{}) {
+    sort(Range{std::forward<Container>(container)}, std::forward<Compare>(comp));
+}
+
 } // namespace utl::parallel
 
+#undef utl_parallel_linux
+#undef utl_parallel_apple
+
 #endif
 #endif // module utl::parallel
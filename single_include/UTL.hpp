@@ -765,30 +765,55 @@ namespace literals {
 #include <charconv>         // to_chars(), from_chars()
 #include <climits>          // CHAR_BIT
 #include <cmath>            // isfinite()
-#include <cstddef>          // size_t
-#include <cstdint>          // uint8_t, uint16_t, uint32_t
+#include <cstddef>          // size_t, ptrdiff_t, offsetof()
+#include <cstdio>           // FILE, fwrite()
+#include <cstdint>          // uint8_t, uint16_t, uint32_t, uintptr_t
+#include <cstring>          // memcpy()
+#include <exception>        // exception_ptr, current_exception(), rethrow_exception()
 #include <filesystem>       // create_directories()
 #include <fstream>          // ifstream, ofstream
+#include <functional>       // less<>, hash<>
 #include <initializer_list> // initializer_list<>
+#include <iterator>         // random_access_iterator_tag
 #include <limits>           // numeric_limits<>::max_digits10, numeric_limits<>::max_exponent10
 #include <map>              // map<>
+#include <memory>           // unique_ptr<>, allocator<>, allocator_traits<>
+#include <new>              // bad_array_new_length
+#include <ostream>          // ostream
 #include <stdexcept>        // runtime_error
 #include <string>           // string
 #include <string_view>      // string_view
 #include <system_error>     // errc
-#include <type_traits>      // enable_if<>, void_t, is_convertible<>, is_same<>,
-                            // conjunction<>, disjunction<>, negation<>
-#include <utility>          // move(), declval<>()
+#include <tuple>            // tie(), forward_as_tuple()
+#include <type_traits>      // enable_if<>, void_t, is_convertible<>, is_same<>, remove_cv_t<>,
+                            // is_lvalue_reference<>, conjunction<>, disjunction<>, negation<>
+#include <utility>          // move(), declval<>(), exchange()
 #include <variant>          // variant<>
 #include <vector>           // vector<>
 
+// SIMD scanning is selected at compile time based on the target architecture, modules are self-contained
+// so we detect it here rather than through 'utl::predef'. Defining 'UTL_JSON_DISABLE_SIMD' forces scalar code.
+#if !defined(UTL_JSON_DISABLE_SIMD) && defined(__AVX2__)
+#define utl_json_simd_avx2
+#include <immintrin.h> // _mm256_...()
+#elif !defined(UTL_JSON_DISABLE_SIMD) &&                                                                               \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define utl_json_simd_sse2
+#include <emmintrin.h> // _mm_...()
+#endif
+
+#if defined(_MSC_VER) && (defined(utl_json_simd_avx2) || defined(utl_json_simd_sse2))
+#include <intrin.h> // _BitScanForward()
+#endif
+
 // ____________________ DEVELOPER DOCS ____________________
 
-// Reasonably simple (if we discount reflection) parser / serializer, doesn't use any intrinsics or compiler-specific
-// stuff. Unlike some other implementations, doesn't include the tokenizing step - we parse everything in a single 1D
-// scan over the data, constructing recursive JSON struct on the fly. The main reason we can do this so easily is
-// due to a nice quirk of JSON: when parsing nodes, we can always determine node type based on a single first
-// character, see '_parser::parse_node()'.
+// Reasonably simple (if we discount reflection) parser / serializer, the only intrinsics used are optional SSE2 / AVX2
+// fast paths for skipping whitespace & scanning strings. Unlike some other implementations, doesn't include the
+// tokenizing step - we parse everything in a single 1D scan over the data, reporting it as SAX events that get
+// turned into a recursive JSON struct on the fly. The main reason we can do this so easily is due to a nice quirk
+// of JSON: when parsing nodes, we can always determine node type based on a single first character,
+// see '_sax_parser::parse_node()'.
 //
 // Struct reflection is implemented through macros - alternative way would be to use templates with __PRETTY_FUNCTION__
 // (or __FUNCSIG__) and do some constexpr string parsing to perform "magic" reflection without requiring macros, but
@@ -827,7 +852,8 @@ namespace utl::json {
 // (each letter in a codepoint is a hex corresponding to 4 bits, 6 positions => 24 bits of info).
 // In terms of C++ 'U+ABCDEF' codepoints can be expressed as an integer hex-literal '0xABCDEF'.
 //
-inline bool _codepoint_to_utf8(std::string& destination, std::uint32_t cp) {
+template <class String>
+bool _codepoint_to_utf8(String& destination, std::uint32_t cp) {
     // returns success so we can handle the error message inside the parser itself.
 
     std::array<char, 4> buffer;
@@ -906,7 +932,7 @@ template <class T>
     return num < 10 ? 1 : 1 + _log_10_ceil(num / 10);
 }
 
-[[nodiscard]] inline std::string _pretty_error(std::size_t cursor, const std::string& chars) {
+[[nodiscard]] inline std::string _pretty_error(std::size_t cursor, std::string_view chars) {
     // Special case for empty buffers
     if (chars.empty()) return "";
 
@@ -979,6 +1005,8 @@ utl_json_define_trait(_has_input_it, std::next(std::declval<T>().begin()));
 utl_json_define_trait(_has_key_type, std::declval<typename std::decay_t<T>::key_type>());
 utl_json_define_trait(_has_mapped_type, std::declval<typename std::decay_t<T>::mapped_type>());
 
+utl_json_define_trait(_has_reserve, std::declval<std::decay_t<T>&>().reserve(std::size_t{}));
+
 #undef utl_json_define_trait
 
 // Workaround for 'static_assert(false)' making program ill-formed even
@@ -1028,12 +1056,17 @@ constexpr bool _always_false_v = false;
 // --- JSON type conversion traits ---
 // ===================================
 
-template <class T>
-using _object_type_impl = std::map<std::string, T, std::less<>>;
+template <class T, class Allocator>
+using _rebind_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+template <class Allocator>
+using _string_type_impl = std::basic_string<char, std::char_traits<char>, _rebind_alloc<char, Allocator>>;
+template <class T, class Allocator>
+using _object_type_impl = std::map<_string_type_impl<Allocator>, T, std::less<>,
+                                   _rebind_alloc<std::pair<const _string_type_impl<Allocator>, T>, Allocator>>;
 // 'std::less<>' makes map transparent, which means we can use 'find()' for 'std::string_view' keys
-template <class T>
-using _array_type_impl  = std::vector<T>;
-using _string_type_impl = std::string;
+template <class T, class Allocator>
+using _array_type_impl  = std::vector<T, _rebind_alloc<T, Allocator>>;
 using _number_type_impl = double;
 using _bool_type_impl   = bool;
 struct _null_type_impl {
@@ -1058,9 +1091,8 @@ struct _null_type_impl {
 // The same cannot be said about 'std::unordered_map', which is why we don't use it.
 //
 // We could make a more pedantic choice and add a redundant level of indirection, but that both complicates
-// implementation needlessly and reduces performance. A perfect solution would be to write our own map implementation
-// tailored for JSON use cases and providing explicit support for heterogeneous lookup and incomplete types, but that
-// alone would be grander in scale than this entire parser for a mostly non-critical benefit.
+// implementation needlessly and reduces performance. Alternatively, there is a custom flat object implementation
+// with explicit support for heterogeneous lookup and incomplete types, see '_flat_object'.
 
 struct _dummy_type {};
 
@@ -1141,20 +1173,443 @@ utl_json_type_trait_conjunction(
 #undef utl_json_type_trait_conjunction
 #undef utl_json_type_trait_disjunction
 
+// ========================
+// --- Arena allocation ---
+// ========================
+
+// Minimal monotonic arena, hands out memory from large blocks that only get freed all at once.
+//
+// Parsing a large JSON into regular nodes ends up doing millions of small allocations (map nodes, vector buffers,
+// strings), which are just as expensive to free. Placing the whole tree into an arena turns all of those into
+// pointer bumps and makes deallocation a no-op, freeing the memory is then done by destroying the arena.
+//
+// Blocks grow geometrically up to a limit, this keeps small parses cheap without
+// making large parses do too many block allocations.
+class Arena {
+    constexpr static std::size_t min_block_size = 4096;
+    constexpr static std::size_t max_block_size = 1024 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char*                                block_cursor    = nullptr;
+    std::size_t                          block_remaining = 0;
+    std::size_t                          next_block_size = min_block_size;
+
+    void grow(std::size_t min_size) {
+        const std::size_t new_block_size = (min_size > this->next_block_size) ? min_size : this->next_block_size;
+        this->blocks.emplace_back(new char[new_block_size]);
+        // 'std::make_unique<char[]>()' would value-initialize the whole block, which is wasted work here
+        this->block_cursor    = this->blocks.back().get();
+        this->block_remaining = new_block_size;
+        if (this->next_block_size < max_block_size) this->next_block_size *= 2;
+    }
+
+    [[nodiscard]] static std::size_t padding_for(const char* ptr, std::size_t alignment) noexcept {
+        return (alignment - reinterpret_cast<std::uintptr_t>(ptr) % alignment) % alignment;
+    }
+
+public:
+    Arena()             = default;
+    Arena(const Arena&) = delete;
+
+    // Moved-from arena gets reset to the empty state, otherwise its cursor would keep
+    // pointing into a block that now belongs to the other arena
+    Arena(Arena&& other) noexcept
+        : blocks(std::move(other.blocks)), block_cursor(std::exchange(other.block_cursor, nullptr)),
+          block_remaining(std::exchange(other.block_remaining, 0)),
+          next_block_size(std::exchange(other.next_block_size, min_block_size)) {
+        other.blocks.clear();
+    }
+
+    Arena& operator=(const Arena&) = delete;
+
+    Arena& operator=(Arena&& other) noexcept {
+        if (this == &other) return *this;
+        this->blocks          = std::move(other.blocks);
+        this->block_cursor    = std::exchange(other.block_cursor, nullptr);
+        this->block_remaining = std::exchange(other.block_remaining, 0);
+        this->next_block_size = std::exchange(other.next_block_size, min_block_size);
+        other.blocks.clear();
+        return *this;
+    }
+
+    [[nodiscard]] void* allocate(std::size_t size, std::size_t alignment) {
+        // Block starts are aligned by 'new', we only need to pad the cursor, reserving
+        // 'size + alignment' on growth guarantees that padded allocation fits into the new block
+        std::size_t padding = padding_for(this->block_cursor, alignment);
+
+        if (size + padding > this->block_remaining) {
+            this->grow(size + alignment);
+            padding = padding_for(this->block_cursor, alignment);
+        }
+
+        char* const ptr = this->block_cursor + padding;
+        this->block_cursor += size + padding;
+        this->block_remaining -= size + padding;
+        return ptr;
+    }
+
+    [[nodiscard]] std::string_view store(std::string_view str) {
+        if (str.empty()) return {};
+        char* const ptr = static_cast<char*>(this->allocate(str.size(), 1));
+        std::memcpy(ptr, str.data(), str.size());
+        return {ptr, str.size()};
+    }
+
+    void release() noexcept {
+        this->blocks.clear();
+        this->block_cursor    = nullptr;
+        this->block_remaining = 0;
+        this->next_block_size = min_block_size;
+    }
+};
+
+// Stateful allocator adapter over 'Arena'. Default-constructed allocator falls back onto the regular heap,
+// this is necessary since nodes can create containers on their own (for example, 'null' node turning into an
+// object on 'operator[]'), such containers don't know about the arena and behave like they would normally.
+// The same applies to keys & strings created by 'operator[]' / assignment, only the parser passes the arena
+// along, so 'ArenaNode' trees are fully arena-allocated only as produced by 'from_string(chars, arena)'.
+template <class T>
+class ArenaAllocator {
+    Arena* arena = nullptr;
+
+    template <class>
+    friend class ArenaAllocator;
+
+public:
+    using value_type                             = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type;
+    // propagating on move is what makes moving arena-allocated nodes around as cheap as moving regular ones
+
+    ArenaAllocator() noexcept = default;
+    ArenaAllocator(Arena& arena) noexcept : arena(&arena) {}
+
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.arena) {}
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+        if (!this->arena) return std::allocator<T>{}.allocate(n);
+        if (n > std::size_t(-1) / sizeof(T)) throw std::bad_array_new_length{};
+        return static_cast<T*>(this->arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        if (!this->arena) std::allocator<T>{}.deallocate(ptr, n);
+        // arena memory is only freed all at once
+    }
+
+    template <class U>
+    [[nodiscard]] bool operator==(const ArenaAllocator<U>& other) const noexcept {
+        return this->arena == other.arena;
+    }
+
+    template <class U>
+    [[nodiscard]] bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+        return this->arena != other.arena;
+    }
+};
+
+// ===================
+// --- Flat object ---
+// ===================
+
+// Insertion-ordered object stored as a flat vector of key-value pairs, alternative to 'std::map<>'.
+//
+// Most objects in real JSONs have somewhere around 5-30 keys. For such sizes a red-black tree is a rather poor fit,
+// every key costs a separate node allocation and lookup has to chase pointers all over the memory. A flat vector
+// needs a single allocation and keeps all of the keys next to each other, which makes both parsing & iteration
+// a lot cheaper and keeps small lookups fast even with a linear search.
+//
+// Linear search obviously doesn't scale, once the object grows past 'linear_search_limit' we start maintaining
+// an open-addressing hash index over the vector (which stores positions of the pairs). The index stays at
+// load factor <= 0.5 and gets rebuilt on growth, which keeps both insertion & lookup amortized O(1).
+//
+// Differences from 'std::map<>':
+//    - Iteration (and serialization) follows insertion order rather than the sorted order of keys
+//    - Pairs are stored as 'std::pair<Key, T>' (so the vector can relocate them cheaply), iterators dereference
+//      to 'std::pair<const Key&, T&>' proxies which keep keys read-only since modifying them would invalidate
+//      the index. Range-for should bind pairs with 'const auto&' / 'auto&&' / 'auto' rather than 'auto&'
+//    - Insertion invalidates iterators & references (same as with 'std::vector<>')
+//    - Erasure is O(N)
+//
+// Since the storage is a 'std::vector<>' this type can be instantiated with incomplete 'T',
+// which is exactly what we need for recursive nodes.
+template <class Key, class T, class Allocator>
+class _flat_object {
+    using stored_type    = std::pair<Key, T>;
+    using container_type = std::vector<stored_type, _rebind_alloc<stored_type, Allocator>>;
+
+    // Thin wrapper over the vector iterator, exposes pairs with a const key
+    template <bool is_const>
+    class basic_iterator {
+        using base_type = std::conditional_t<is_const, typename container_type::const_iterator,
+                                             typename container_type::iterator>;
+        base_type it{};
+
+        friend class _flat_object;
+        template <bool>
+        friend class basic_iterator;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = std::pair<const Key, T>;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = std::pair<const Key&, std::conditional_t<is_const, const T&, T&>>;
+
+        struct pointer {
+            reference                      ref;
+            [[nodiscard]] const reference* operator->() const noexcept { return &this->ref; }
+        };
+
+        basic_iterator() = default;
+        explicit basic_iterator(base_type it) noexcept : it(it) {}
+
+        template <bool other_is_const, std::enable_if_t<is_const && !other_is_const, bool> = true>
+        basic_iterator(const basic_iterator<other_is_const>& other) noexcept : it(other.it) {}
+
+        [[nodiscard]] reference operator*() const noexcept { return {this->it->first, this->it->second}; }
+        [[nodiscard]] pointer   operator->() const noexcept { return {**this}; }
+        [[nodiscard]] reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+        basic_iterator& operator++() noexcept {
+            ++this->it;
+            return *this;
+        }
+        basic_iterator& operator--() noexcept {
+            --this->it;
+            return *this;
+        }
+        basic_iterator  operator++(int) noexcept { return basic_iterator(this->it++); }
+        basic_iterator  operator--(int) noexcept { return basic_iterator(this->it--); }
+        basic_iterator& operator+=(difference_type n) noexcept {
+            this->it += n;
+            return *this;
+        }
+        basic_iterator& operator-=(difference_type n) noexcept {
+            this->it -= n;
+            return *this;
+        }
+
+        friend basic_iterator  operator+(basic_iterator iter, difference_type n) noexcept { return iter += n; }
+        friend basic_iterator  operator+(difference_type n, basic_iterator iter) noexcept { return iter += n; }
+        friend basic_iterator  operator-(basic_iterator iter, difference_type n) noexcept { return iter -= n; }
+        friend difference_type operator-(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return lhs.it - rhs.it;
+        }
+
+        friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return lhs.it == rhs.it;
+        }
+        friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return lhs.it != rhs.it;
+        }
+        friend bool operator<(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return lhs.it < rhs.it;
+        }
+        friend bool operator>(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return lhs.it > rhs.it;
+        }
+        friend bool operator<=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return lhs.it <= rhs.it;
+        }
+        friend bool operator>=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept {
+            return lhs.it >= rhs.it;
+        }
+    };
+
+public:
+    using key_type       = Key;
+    using mapped_type    = T;
+    using value_type     = std::pair<const Key, T>;
+    using allocator_type = typename container_type::allocator_type;
+    using size_type      = std::size_t;
+    using iterator       = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+private:
+    using index_allocator_type = _rebind_alloc<std::size_t, Allocator>;
+    using index_type           = std::vector<std::size_t, index_allocator_type>;
+
+    constexpr static std::size_t linear_search_limit = 8;
+    constexpr static std::size_t min_index_size      = 32;
+    constexpr static std::size_t empty_slot          = 0;
+    // index stores 'pos + 1' so that zero-initialized slots are empty
+
+    container_type pairs;
+    index_type     index; // empty while objects are small
+
+    [[nodiscard]] static std::size_t hash(std::string_view key) noexcept { return std::hash<std::string_view>{}(key); }
+
+    [[nodiscard]] std::size_t find_pos(std::string_view key) const noexcept {
+        if (this->index.empty()) {
+            for (std::size_t pos = 0; pos < this->pairs.size(); ++pos)
+                if (std::string_view(this->pairs[pos].first) == key) return pos;
+            return this->pairs.size();
+        }
+
+        const std::size_t mask = this->index.size() - 1;
+        for (std::size_t i = hash(key) & mask; this->index[i] != empty_slot; i = (i + 1) & mask) {
+            const std::size_t pos = this->index[i] - 1;
+            if (std::string_view(this->pairs[pos].first) == key) return pos;
+        }
+        return this->pairs.size();
+    }
+
+    void index_insert(std::size_t pos) noexcept {
+        const std::size_t mask = this->index.size() - 1;
+        std::size_t       i    = hash(this->pairs[pos].first) & mask;
+        while (this->index[i] != empty_slot) i = (i + 1) & mask; // linear probing
+        this->index[i] = pos + 1;
+    }
+
+    void rebuild_index() {
+        if (this->pairs.size() <= linear_search_limit) {
+            this->index.clear();
+            return;
+        }
+
+        std::size_t size = min_index_size;
+        while (size < 2 * this->pairs.size()) size *= 2; // keeps load factor <= 0.5
+
+        this->index.assign(size, empty_slot);
+        for (std::size_t pos = 0; pos < this->pairs.size(); ++pos) this->index_insert(pos);
+    }
+
+    void on_push_back() {
+        // doubling index size on rebuild makes insertion amortized O(1), same as with the vector itself
+        if (this->pairs.size() <= linear_search_limit) return;
+        if (2 * this->pairs.size() > this->index.size()) this->rebuild_index();
+        else this->index_insert(this->pairs.size() - 1);
+    }
+
+public:
+    _flat_object() = default;
+    explicit _flat_object(const allocator_type& allocator)
+        : pairs(allocator), index(index_allocator_type(allocator)) {}
+
+    _flat_object(std::initializer_list<value_type> ilist, const allocator_type& allocator = allocator_type())
+        : _flat_object(allocator) {
+        this->reserve(ilist.size());
+        // first duplicate wins, same as 'std::map'
+        for (const auto& [key, value] : ilist) this->try_emplace(key, value);
+    }
+
+    // - Iterators -
+    [[nodiscard]] iterator       begin() noexcept { return iterator(this->pairs.begin()); }
+    [[nodiscard]] iterator       end() noexcept { return iterator(this->pairs.end()); }
+    [[nodiscard]] const_iterator begin() const noexcept { return const_iterator(this->pairs.begin()); }
+    [[nodiscard]] const_iterator end() const noexcept { return const_iterator(this->pairs.end()); }
+    [[nodiscard]] const_iterator cbegin() const noexcept { return const_iterator(this->pairs.cbegin()); }
+    [[nodiscard]] const_iterator cend() const noexcept { return const_iterator(this->pairs.cend()); }
+
+    // - Capacity -
+    [[nodiscard]] bool      empty() const noexcept { return this->pairs.empty(); }
+    [[nodiscard]] size_type size() const noexcept { return this->pairs.size(); }
+
+    void reserve(size_type size) { this->pairs.reserve(size); }
+
+    // - Lookup -
+    [[nodiscard]] iterator       find(std::string_view key) { return this->begin() + this->find_pos(key); }
+    [[nodiscard]] const_iterator find(std::string_view key) const { return this->begin() + this->find_pos(key); }
+
+    [[nodiscard]] size_type count(std::string_view key) const { return this->find_pos(key) != this->size(); }
+    [[nodiscard]] bool      contains(std::string_view key) const { return this->count(key); }
+
+    [[nodiscard]] T& at(std::string_view key) {
+        const std::size_t pos = this->find_pos(key);
+        if (pos == this->size()) throw std::out_of_range("_flat_object::at()");
+        return this->pairs[pos].second;
+    }
+
+    [[nodiscard]] const T& at(std::string_view key) const {
+        const std::size_t pos = this->find_pos(key);
+        if (pos == this->size()) throw std::out_of_range("_flat_object::at()");
+        return this->pairs[pos].second;
+    }
+
+    // - Modifiers -
+    template <class K, class... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        const std::size_t pos = this->find_pos(key);
+        if (pos != this->size()) return {this->begin() + pos, false};
+
+        this->pairs.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                                 std::forward_as_tuple(std::forward<Args>(args)...));
+        this->on_push_back();
+        return {this->end() - 1, true};
+    }
+
+    template <class K, class V>
+    std::pair<iterator, bool> emplace(K&& key, V&& value) {
+        return this->try_emplace(std::forward<K>(key), std::forward<V>(value));
+    }
+
+    iterator erase(const_iterator it) {
+        const auto res = this->pairs.erase(it.it);
+        this->rebuild_index(); // positions of all following pairs have shifted
+        return iterator(res);
+    }
+
+    size_type erase(std::string_view key) {
+        const std::size_t pos = this->find_pos(key);
+        if (pos == this->size()) return 0;
+        this->erase(this->cbegin() + pos);
+        return 1;
+    }
+
+    void clear() noexcept {
+        this->pairs.clear();
+        this->index.clear();
+    }
+};
+
+// --- Object backends ---
+// -----------------------
+
+// 'BasicNode' takes object backend as a template parameter, this allows selecting object representation at compile
+// time while keeping exactly the same node API. Default backend can be switched to the flat one by defining
+// 'UTL_JSON_FLAT_OBJECT' before including the header, both backends can also be used side-by-side
+// through 'Node' and 'FlatNode' typedefs.
+
+struct MapObjectBackend {
+    template <class T, class Allocator>
+    using type = _object_type_impl<T, Allocator>;
+};
+
+struct FlatObjectBackend {
+    template <class T, class Allocator>
+    using type = _flat_object<_string_type_impl<Allocator>, T, Allocator>;
+};
+
+#ifdef UTL_JSON_FLAT_OBJECT
+using _default_object_backend = FlatObjectBackend;
+#else
+using _default_object_backend = MapObjectBackend;
+#endif
+
 // ==================
 // --- Node class ---
 // ==================
 
 enum class Format : std::uint8_t { PRETTY, MINIMIZED };
 
-class Node;
-inline void _serialize_json_to_buffer(std::string& chars, const Node& node, Format format);
+template <class NodeType>
+void _serialize_json_to_buffer(std::string& chars, const NodeType& node, Format format);
+
+template <class NodeType, class Callback>
+void _serialize_json_to_callback(Callback& callback, const NodeType& node, Format format);
 
-class Node {
+// BasicNode is templated on the allocator used by its containers, which allows parsed trees to be placed into an arena,
+// see 'ArenaNode'. Regular 'BasicNode' uses 'std::allocator<>' and that's what all of the API defaults to.
+// Object representation is selected by 'ObjectBackend', see 'FlatNode'.
+template <class Allocator, class ObjectBackend = _default_object_backend>
+class BasicNode {
 public:
-    using object_type = _object_type_impl<Node>;
-    using array_type  = _array_type_impl<Node>;
-    using string_type = _string_type_impl;
+    using object_type = typename ObjectBackend::template type<BasicNode, Allocator>;
+    using array_type  = _array_type_impl<BasicNode, Allocator>;
+    using string_type = _string_type_impl<Allocator>;
     using number_type = _number_type_impl;
     using bool_type   = _bool_type_impl;
     using null_type   = _null_type_impl;
@@ -1218,17 +1673,17 @@ class Node {
     // -- Object methods ---
     // ---------------------
 
-    Node& operator[](std::string_view key) {
+    BasicNode& operator[](std::string_view key) {
         // 'std::map<K, V>::operator[]()' and 'std::map<K, V>::at()' don't support
         // support heterogeneous lookup, we have to reimplement them manually
         if (this->is_null()) this->data = object_type{}; // 'null' converts to objects automatically
         auto& object = this->get_object();
         auto  it     = object.find(key);
-        if (it == object.end()) it = object.emplace(key, Node{}).first;
+        if (it == object.end()) it = object.emplace(key, BasicNode{}).first;
         return it->second;
     }
 
-    [[nodiscard]] const Node& operator[](std::string_view key) const {
+    [[nodiscard]] const BasicNode& operator[](std::string_view key) const {
         // 'std::map<K, V>::operator[]()' and 'std::map<K, V>::at()' don't support
         // support heterogeneous lookup, we have to reimplement them manually
         const auto& object = this->get_object();
@@ -1238,7 +1693,7 @@ class Node {
         return it->second;
     }
 
-    [[nodiscard]] Node& at(std::string_view key) {
+    [[nodiscard]] BasicNode& at(std::string_view key) {
         // Non-const 'operator[]' inserts non-existent keys, '.at()' should throw instead
         auto&      object = this->get_object();
         const auto it     = object.find(key);
@@ -1247,19 +1702,19 @@ class Node {
         return it->second;
     }
 
-    [[nodiscard]] const Node& at(std::string_view key) const { return this->operator[](key); }
+    [[nodiscard]] const BasicNode& at(std::string_view key) const { return this->operator[](key); }
 
     [[nodiscard]] bool contains(std::string_view key) const {
         const auto& object = this->get_object();
-        const auto  it     = object.find(std::string(key));
+        const auto  it     = object.find(key);
         return it != object.end();
     }
 
     template <class T>
     [[nodiscard]] const T& value_or(std::string_view key, const T& else_value) {
         const auto& object = this->get_object();
-        const auto  it     = object.find(std::string(key));
-        if (it != object.end()) return it->second.get<T>();
+        const auto  it     = object.find(key);
+        if (it != object.end()) return it->second.template get<T>();
         return else_value;
         // same thing as 'this->contains(key) ? json.at(key).get<T>() : else_value' but without a second map lookup
     }
@@ -1267,20 +1722,20 @@ class Node {
     // -- Array methods ---
     // --------------------
 
-    [[nodiscard]] Node& operator[](std::size_t pos) { return this->get_array()[pos]; }
+    [[nodiscard]] BasicNode& operator[](std::size_t pos) { return this->get_array()[pos]; }
 
-    [[nodiscard]] const Node& operator[](std::size_t pos) const { return this->get_array()[pos]; }
+    [[nodiscard]] const BasicNode& operator[](std::size_t pos) const { return this->get_array()[pos]; }
 
-    [[nodiscard]] Node& at(std::size_t pos) { return this->get_array().at(pos); }
+    [[nodiscard]] BasicNode& at(std::size_t pos) { return this->get_array().at(pos); }
 
-    [[nodiscard]] const Node& at(std::size_t pos) const { return this->get_array().at(pos); }
+    [[nodiscard]] const BasicNode& at(std::size_t pos) const { return this->get_array().at(pos); }
 
-    void push_back(const Node& node) {
+    void push_back(const BasicNode& node) {
         if (this->is_null()) this->data = array_type{}; // 'null' converts to arrays automatically
         this->get_array().push_back(node);
     }
 
-    void push_back(Node&& node) {
+    void push_back(BasicNode&& node) {
         if (this->is_null()) this->data = array_type{}; // 'null' converts to arrays automatically
         this->get_array().push_back(node);
     }
@@ -1289,12 +1744,12 @@ class Node {
     // ----------------
 
     // Converting assignment
-    template <class T, std::enable_if_t<!std::is_same_v<std::decay_t<T>, Node> &&
+    template <class T, std::enable_if_t<!std::is_same_v<std::decay_t<T>, BasicNode> &&
                                             !std::is_same_v<std::decay_t<T>, object_type> &&
                                             !std::is_same_v<std::decay_t<T>, array_type> &&
                                             !std::is_same_v<std::decay_t<T>, string_type> && is_json_convertible_v<T>,
                                         bool> = true>
-    Node& operator=(const T& value) {
+    BasicNode& operator=(const T& value) {
         // Don't take types that decay to Node/object/array/string to prevent
         // shadowing native copy/move assignment for those types
 
@@ -1303,21 +1758,22 @@ class Node {
         // string > object > array > bool > null > numeric
 
         if constexpr (is_string_like_v<T>) {
-            this->data.emplace<string_type>(value);
+            this->data.template emplace<string_type>(value);
         } else if constexpr (is_object_like_v<T>) {
-            this->data.emplace<object_type>();
-            auto& object = this->get_object();
-            for (const auto& [key, val] : value) object[key] = val;
+            this->data.template emplace<object_type>();
+            for (const auto& [key, val] : value) (*this)[std::string_view(key)] = val;
+            // going through 'BasicNode::operator[]' since 'string_type' with a custom allocator
+            // isn't implicitly constructible from the key, while 'std::string_view' works for any
         } else if constexpr (is_array_like_v<T>) {
-            this->data.emplace<array_type>();
+            this->data.template emplace<array_type>();
             auto& array = this->get_array();
             for (const auto& elem : value) array.emplace_back(elem);
         } else if constexpr (is_bool_like_v<T>) {
-            this->data.emplace<bool_type>(value);
+            this->data.template emplace<bool_type>(value);
         } else if constexpr (is_null_like_v<T>) {
-            this->data.emplace<null_type>(value);
+            this->data.template emplace<null_type>(value);
         } else if constexpr (is_numeric_like_v<T>) {
-            this->data.emplace<number_type>(value);
+            this->data.template emplace<number_type>(value);
         } else {
             static_assert(_always_false_v<T>, "Method is a non-exhaustive visitor of std::variant<>.");
         }
@@ -1326,29 +1782,29 @@ class Node {
     }
 
     // "native" copy/move semantics for types that support it
-    Node& operator=(const object_type& value) {
+    BasicNode& operator=(const object_type& value) {
         this->data = value;
         return *this;
     }
-    Node& operator=(object_type&& value) {
+    BasicNode& operator=(object_type&& value) {
         this->data = std::move(value);
         return *this;
     }
 
-    Node& operator=(const array_type& value) {
+    BasicNode& operator=(const array_type& value) {
         this->data = value;
         return *this;
     }
-    Node& operator=(array_type&& value) {
+    BasicNode& operator=(array_type&& value) {
         this->data = std::move(value);
         return *this;
     }
 
-    Node& operator=(const string_type& value) {
+    BasicNode& operator=(const string_type& value) {
         this->data = value;
         return *this;
     }
-    Node& operator=(string_type&& value) {
+    BasicNode& operator=(string_type&& value) {
         this->data = std::move(value);
         return *this;
     }
@@ -1356,7 +1812,7 @@ class Node {
     // Support for 'std::initializer_list' type deduction,
     // (otherwise the call is ambiguous)
     template <class T>
-    Node& operator=(std::initializer_list<T> ilist) {
+    BasicNode& operator=(std::initializer_list<T> ilist) {
         // We can't just do 'return *this = array_type(value);' because compiler doesn't realize it can
         // convert 'std::initializer_list<T>' to 'std::vector<Node>' for all 'T' convertible to 'Node',
         // we have to invoke 'Node()' constructor explicitly (here it happens in 'emplace_back()')
@@ -1368,7 +1824,7 @@ class Node {
     }
 
     template <class T>
-    Node& operator=(std::initializer_list<std::initializer_list<T>> ilist) {
+    BasicNode& operator=(std::initializer_list<std::initializer_list<T>> ilist) {
         // Support for 2D brace initialization
         array_type array_value;
         array_value.reserve(ilist.size());
@@ -1382,7 +1838,7 @@ class Node {
     }
 
     template <class T>
-    Node& operator=(std::initializer_list<std::initializer_list<std::initializer_list<T>>> ilist) {
+    BasicNode& operator=(std::initializer_list<std::initializer_list<std::initializer_list<T>>> ilist) {
         // Support for 3D brace initialization
         // it's dumb, but it works
         array_type array_value;
@@ -1402,12 +1858,12 @@ class Node {
     // -- Constructors --
     // ------------------
 
-    Node& operator=(const Node&) = default;
-    Node& operator=(Node&&)      = default;
+    BasicNode& operator=(const BasicNode&) = default;
+    BasicNode& operator=(BasicNode&&)      = default;
 
-    Node()            = default;
-    Node(const Node&) = default;
-    Node(Node&&)      = default;
+    BasicNode()                 = default;
+    BasicNode(const BasicNode&) = default;
+    BasicNode(BasicNode&&)      = default;
     // Note:
     // We suffer a lot if 'object_type' move-constructor is not marked 'noexcept', if that's the case
     // 'Node' move-constructor doesn't get 'noexcept' either which means `std::vector<Node>` will copy
@@ -1416,25 +1872,25 @@ class Node {
     // See noexcept status summary here: http://howardhinnant.github.io/container_summary.html
 
     // Converting ctor
-    template <class T, std::enable_if_t<!std::is_same_v<std::decay_t<T>, Node> &&
+    template <class T, std::enable_if_t<!std::is_same_v<std::decay_t<T>, BasicNode> &&
                                             !std::is_same_v<std::decay_t<T>, object_type> &&
                                             !std::is_same_v<std::decay_t<T>, array_type> &&
                                             !std::is_same_v<std::decay_t<T>, string_type> && is_json_convertible_v<T>,
                                         bool> = true>
-    Node(const T& value) {
+    BasicNode(const T& value) {
         *this = value;
     }
 
-    Node(const object_type& value) { this->data = value; }
-    Node(object_type&& value) { this->data = std::move(value); }
-    Node(const array_type& value) { this->data = value; }
-    Node(array_type&& value) { this->data = std::move(value); }
-    Node(std::string_view value) { this->data = string_type(value); }
-    Node(const string_type& value) { this->data = value; }
-    Node(string_type&& value) { this->data = std::move(value); }
-    Node(number_type value) { this->data = value; }
-    Node(bool_type value) { this->data = value; }
-    Node(null_type value) { this->data = value; }
+    BasicNode(const object_type& value) { this->data = value; }
+    BasicNode(object_type&& value) { this->data = std::move(value); }
+    BasicNode(const array_type& value) { this->data = value; }
+    BasicNode(array_type&& value) { this->data = std::move(value); }
+    BasicNode(std::string_view value) { this->data = string_type(value); }
+    BasicNode(const string_type& value) { this->data = value; }
+    BasicNode(string_type&& value) { this->data = std::move(value); }
+    BasicNode(number_type value) { this->data = value; }
+    BasicNode(bool_type value) { this->data = value; }
+    BasicNode(null_type value) { this->data = value; }
 
     // --- JSON Serializing public API ---
     // -----------------------------------
@@ -1445,9 +1901,22 @@ class Node {
         return buffer;
     }
 
-    void to_file(const std::string& filepath, Format format = Format::PRETTY) const {
-        const auto chars = this->to_string(format);
+    // Streaming serialization, output gets passed to the sink in 'std::string_view' chunks through a fixed-size
+    // buffer, which means the whole serialized string never has to exist in memory at once
+    template <class Callback>
+    void to_callback(Callback&& callback, Format format = Format::PRETTY) const {
+        _serialize_json_to_callback(callback, *this, format);
+    }
 
+    void to_stream(std::ostream& stream, Format format = Format::PRETTY) const {
+        this->to_callback([&](std::string_view chunk) { stream.write(chunk.data(), chunk.size()); }, format);
+    }
+
+    void to_stream(std::FILE* file, Format format = Format::PRETTY) const {
+        this->to_callback([&](std::string_view chunk) { std::fwrite(chunk.data(), 1, chunk.size(), file); }, format);
+    }
+
+    void to_file(const std::string& filepath, Format format = Format::PRETTY) const {
         const std::filesystem::path path = filepath;
         if (path.has_parent_path() && !std::filesystem::exists(path.parent_path()))
             std::filesystem::create_directories(std::filesystem::path(filepath).parent_path());
@@ -1456,10 +1925,11 @@ class Node {
         // even when there is no need to actually perform directory creation because it already exists
 
         // if user doesn't want to pay for 'create_directories()' call (which seems to be inconsequential
-        // on my benchmarks) they can always use 'std::ofstream' and 'to_string()' to export manually
+        // on my benchmarks) they can always use 'std::ofstream' and 'to_stream()' to export manually
 
-        std::ofstream(filepath).write(chars.data(), chars.size());
-        // maybe a little faster than doing 'std::ofstream(filepath) << node.to_string(format)'
+        std::ofstream file(filepath);
+        this->to_stream(file, format);
+        // streams through a bounded buffer, peak memory doesn't scale with the size of serialized JSON
     }
 
     // --- Reflection ---
@@ -1482,6 +1952,10 @@ class Node {
     }
 };
 
+using Node      = BasicNode<std::allocator<char>>;
+using ArenaNode = BasicNode<ArenaAllocator<char>>;
+using FlatNode  = BasicNode<std::allocator<char>, FlatObjectBackend>;
+
 // Public typedefs
 using Object = Node::object_type;
 using Array  = Node::array_type;
@@ -1490,6 +1964,126 @@ using Number = Node::number_type;
 using Bool   = Node::bool_type;
 using Null   = Node::null_type;
 
+// ==================
+// --- View class ---
+// ==================
+
+// Read-only counterpart of 'Node' produced by 'view_from_string()'. Strings are 'std::string_view's pointing
+// straight into the parsed buffer, which means parsing doesn't copy any string contents. Strings with escape
+// sequences can't be referenced directly, those get decoded once into an arena owned by the 'ViewDocument'.
+//
+// Objects are stored as flat vectors of key-value pairs with linear lookup. It loses to a map on huge objects,
+// but views are meant for a "parse large payload, read a few fields" use case where this is rarely relevant,
+// while not having to allocate a map node per key is a noticeable win during parsing.
+
+class View {
+public:
+    using object_type = std::vector<std::pair<std::string_view, View>>;
+    using array_type  = std::vector<View>;
+    using string_type = std::string_view;
+    using number_type = _number_type_impl;
+    using bool_type   = _bool_type_impl;
+    using null_type   = _null_type_impl;
+
+private:
+    using variant_type = std::variant<null_type, object_type, array_type, string_type, number_type, bool_type>;
+
+    variant_type data{};
+
+    [[nodiscard]] const View* find(std::string_view key) const {
+        for (const auto& [name, value] : this->get_object())
+            if (name == key) return &value;
+        return nullptr;
+    }
+
+    [[nodiscard]] const View& find_or_throw(std::string_view key) const {
+        if (const View* value = this->find(key)) return *value;
+        throw std::runtime_error("Accessing non-existent key {" + std::string(key) + "} in JSON object.");
+    }
+
+public:
+    // -- Getters --
+    // -------------
+
+    template <class T>
+    [[nodiscard]] const T& get() const {
+        return std::get<T>(this->data);
+    }
+
+    [[nodiscard]] const object_type& get_object() const { return this->get<object_type>(); }
+    [[nodiscard]] const array_type&  get_array() const { return this->get<array_type>(); }
+    [[nodiscard]] const string_type& get_string() const { return this->get<string_type>(); }
+    [[nodiscard]] const number_type& get_number() const { return this->get<number_type>(); }
+    [[nodiscard]] const bool_type&   get_bool() const { return this->get<bool_type>(); }
+    [[nodiscard]] const null_type&   get_null() const { return this->get<null_type>(); }
+
+    template <class T>
+    [[nodiscard]] bool is() const noexcept {
+        return std::holds_alternative<T>(this->data);
+    }
+
+    [[nodiscard]] bool is_object() const noexcept { return this->is<object_type>(); }
+    [[nodiscard]] bool is_array() const noexcept { return this->is<array_type>(); }
+    [[nodiscard]] bool is_string() const noexcept { return this->is<string_type>(); }
+    [[nodiscard]] bool is_number() const noexcept { return this->is<number_type>(); }
+    [[nodiscard]] bool is_bool() const noexcept { return this->is<bool_type>(); }
+    [[nodiscard]] bool is_null() const noexcept { return this->is<null_type>(); }
+
+    template <class T>
+    [[nodiscard]] const T* get_if() const noexcept {
+        return std::get_if<T>(&this->data);
+    }
+
+    // -- Object methods ---
+    // ---------------------
+
+    [[nodiscard]] const View& operator[](std::string_view key) const { return this->find_or_throw(key); }
+
+    [[nodiscard]] const View& at(std::string_view key) const { return this->find_or_throw(key); }
+
+    [[nodiscard]] bool contains(std::string_view key) const { return this->find(key) != nullptr; }
+
+    template <class T>
+    [[nodiscard]] const T& value_or(std::string_view key, const T& else_value) const {
+        if (const View* value = this->find(key)) return value->get<T>();
+        return else_value;
+    }
+
+    // -- Array methods ---
+    // --------------------
+
+    [[nodiscard]] const View& operator[](std::size_t pos) const { return this->get_array()[pos]; }
+
+    [[nodiscard]] const View& at(std::size_t pos) const { return this->get_array().at(pos); }
+
+    // -- Constructors --
+    // ------------------
+
+    View()            = default;
+    View(const View&) = default;
+    View(View&&)      = default;
+
+    View& operator=(const View&) = default;
+    View& operator=(View&&)      = default;
+
+    // views are only meant to be constructed by the parser, but there is no harm in leaving these public
+    View(object_type&& value) { this->data = std::move(value); }
+    View(array_type&& value) { this->data = std::move(value); }
+    View(string_type value) { this->data = value; }
+    View(number_type value) { this->data = value; }
+    View(bool_type value) { this->data = value; }
+    View(null_type value) { this->data = value; }
+};
+
+// Root of the 'View' tree, owns the storage of decoded strings. Parsed buffer is NOT owned and
+// should outlive the document, copying views out of the document is fine as long as both are alive.
+class ViewDocument : public View {
+    Arena arena;
+
+public:
+    ViewDocument(View&& root, Arena&& arena) : View(std::move(root)), arena(std::move(arena)) {}
+};
+
 // =====================
 // --- Lookup Tables ---
 // =====================
@@ -1552,6 +2146,16 @@ constexpr std::array<bool, _number_of_char_values> _lookup_whitespace_chars = []
     return res;
 }();
 
+// Lookup table used to determine chars that need special handling inside JSON strings when scanning string
+// contents without SIMD. This includes quotes, backslashes and control characters (codepoints U+0000 to U+001F).
+constexpr std::array<bool, _number_of_char_values> _lookup_string_special_chars = [] {
+    std::array<bool, _number_of_char_values> res{};
+    for (std::uint8_t c = 0; c <= 31; ++c) res[c] = true;
+    res[_u8('"')]  = true;
+    res[_u8('\\')] = true;
+    return res;
+}();
+
 // Lookup table used to get an appropriate char for the escaped char in a 2-char JSON escape sequence.
 constexpr std::array<char, _number_of_char_values> _lookup_parsed_escaped_chars = [] {
     std::array<char, _number_of_char_values> res{};
@@ -1566,6 +2170,112 @@ constexpr std::array<char, _number_of_char_values> _lookup_parsed_escaped_chars
     return res;
 }();
 
+// =====================
+// --- SIMD scanning ---
+// =====================
+
+// The hottest loops of the parser are skipping whitespace (which can take a large portion of runtime for
+// prettified inputs) and scanning string contents for the next quote / backslash / control character,
+// the latter is also the hottest loop of the serializer since these are exactly the chars that need escaping.
+// Both can be done 16 (SSE2) or 32 (AVX2) bytes at a time, comparing the whole block with all symbols of
+// interest and using the resulting bitmask to find the position of the first match. When SIMD isn't available
+// (or the remaining input is too short to load a full block) we fall back to a regular per-char loop.
+
+#if defined(utl_json_simd_avx2) || defined(utl_json_simd_sse2)
+[[nodiscard]] inline std::size_t _count_trailing_zeros(std::uint32_t mask) noexcept {
+    // 'mask' is assumed to be non-zero
+#if defined(_MSC_VER)
+    unsigned long index{};
+    _BitScanForward(&index, mask);
+    return static_cast<std::size_t>(index);
+#else
+    return static_cast<std::size_t>(__builtin_ctz(mask));
+#endif
+}
+#endif
+
+// Returns position of the first non-whitespace char starting from 'cursor', or 'chars.size()' if there is none
+[[nodiscard]] inline std::size_t _find_non_whitespace(std::string_view chars, std::size_t cursor) noexcept {
+#if defined(utl_json_simd_avx2) || defined(utl_json_simd_sse2)
+    // Most whitespace runs in minimized JSON (and many in prettified) are either empty or a single space,
+    // checking 2 chars ahead is cheaper than setting up a SIMD comparison for them
+    for (const std::size_t end = (cursor + 2 < chars.size()) ? cursor + 2 : chars.size(); cursor < end; ++cursor)
+        if (!_lookup_whitespace_chars[_u8(chars[cursor])]) return cursor;
+#endif
+
+#if defined(utl_json_simd_avx2)
+    const __m256i space           = _mm256_set1_epi8(' ');
+    const __m256i tab             = _mm256_set1_epi8('\t');
+    const __m256i newline         = _mm256_set1_epi8('\n');
+    const __m256i carriage_return = _mm256_set1_epi8('\r');
+
+    for (; cursor + 32 <= chars.size(); cursor += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chars.data() + cursor));
+        const __m256i space_or_tab = _mm256_or_si256(_mm256_cmpeq_epi8(block, space), _mm256_cmpeq_epi8(block, tab));
+        const __m256i line_break =
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, newline), _mm256_cmpeq_epi8(block, carriage_return));
+        const __m256i whitespace = _mm256_or_si256(space_or_tab, line_break);
+        const auto mask = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(whitespace));
+        if (mask) return cursor + _count_trailing_zeros(mask);
+    }
+#elif defined(utl_json_simd_sse2)
+    const __m128i space           = _mm_set1_epi8(' ');
+    const __m128i tab             = _mm_set1_epi8('\t');
+    const __m128i newline         = _mm_set1_epi8('\n');
+    const __m128i carriage_return = _mm_set1_epi8('\r');
+
+    for (; cursor + 16 <= chars.size(); cursor += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars.data() + cursor));
+        const __m128i whitespace =
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, tab)),
+                         _mm_or_si128(_mm_cmpeq_epi8(block, newline), _mm_cmpeq_epi8(block, carriage_return)));
+        const auto mask = ~static_cast<std::uint32_t>(_mm_movemask_epi8(whitespace)) & 0xFFFF;
+        if (mask) return cursor + _count_trailing_zeros(mask);
+    }
+#endif
+
+    for (; cursor < chars.size(); ++cursor)
+        if (!_lookup_whitespace_chars[_u8(chars[cursor])]) return cursor;
+    return chars.size();
+}
+
+// Returns position of the first quote '"', backslash '\' or control character (codepoints U+0000 to U+001F)
+// starting from 'cursor', or 'chars.size()' if there is none. These are the only chars that need special
+// handling inside JSON strings, everything in-between can be copied as-is.
+[[nodiscard]] inline std::size_t _find_string_special_char(std::string_view chars, std::size_t cursor) noexcept {
+#if defined(utl_json_simd_avx2)
+    const __m256i quote     = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i max_ctrl  = _mm256_set1_epi8(31);
+
+    for (; cursor + 32 <= chars.size(); cursor += 32) {
+        const __m256i block   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chars.data() + cursor));
+        const __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(block, max_ctrl), block); // unsigned 'c <= 31'
+        const __m256i special = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, quote), _mm256_cmpeq_epi8(block, backslash)), control);
+        const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(special));
+        if (mask) return cursor + _count_trailing_zeros(mask);
+    }
+#elif defined(utl_json_simd_sse2)
+    const __m128i quote     = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i max_ctrl  = _mm_set1_epi8(31);
+
+    for (; cursor + 16 <= chars.size(); cursor += 16) {
+        const __m128i block   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars.data() + cursor));
+        const __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(block, max_ctrl), block); // unsigned 'c <= 31'
+        const __m128i special =
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, backslash)), control);
+        const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(special));
+        if (mask) return cursor + _count_trailing_zeros(mask);
+    }
+#endif
+
+    for (; cursor < chars.size(); ++cursor)
+        if (_lookup_string_special_chars[_u8(chars[cursor])]) return cursor;
+    return chars.size();
+}
+
 // ==========================
 // --- JSON Parsing impl. ---
 // ==========================
@@ -1574,39 +2284,86 @@ constexpr unsigned int _default_recursion_limit = 1000;
 // this recursion limit applies only to parsing from text, conversions from
 // structs & containers are a separate thing and don't really need it as much
 
-struct _parser {
-    const std::string& chars;
-    unsigned int       recursion_limit;
-    unsigned int       recursion_depth = 0;
+// SAX-style parser, performs all of the validation & escape handling, but instead of building a tree it reports
+// the structure of the document as a flat sequence of events to the 'Handler'. Nothing gets materialized here
+// except a single reusable buffer for decoding escaped strings, memory usage depends only on the nesting depth.
+//
+// Every tree-building parse ('Node', 'ArenaNode', 'FlatNode', 'View') is just one of the handlers, see '_node_builder'.
+//
+// 'Handler' is expected to provide the following methods:
+//    > on_object_begin(), on_object_end(), on_array_begin(), on_array_end(),
+//    > on_key(std::string_view), on_string(std::string_view), on_number(double), on_bool(bool), on_null()
+// Strings passed to 'on_key()' / 'on_string()' are only valid until the callback returns.
+template <class Handler>
+struct _sax_parser {
+    using number_type = _number_type_impl;
+    using bool_type   = _bool_type_impl;
+    using null_type   = _null_type_impl;
+
+    std::string_view chars;
+    unsigned int     recursion_limit;
+    unsigned int     recursion_depth = 0;
     // we track recursion depth to handle stack allocation errors
     // (this can be caused malicious inputs with extreme level of nesting, for example, 100k array
     // opening brackets, which would cause huge recursion depth causing the stack to overflow with SIGSEGV)
 
     // dynamic allocation errors can be handled with regular exceptions through std::bad_alloc
 
-    _parser() = delete;
-    _parser(const std::string& chars, unsigned int& recursion_limit) : chars(chars), recursion_limit(recursion_limit) {}
+    Handler&    handler;
+    std::string buffer; // used to decode strings with escape sequences, reused between strings
+
+    _sax_parser() = delete;
+    _sax_parser(std::string_view chars, unsigned int recursion_limit, Handler& handler)
+        : chars(chars), recursion_limit(recursion_limit), handler(handler) {}
 
     // Parser state
     std::size_t skip_nonsignificant_whitespace(std::size_t cursor) {
         using namespace std::string_literals;
 
-        while (cursor < this->chars.size()) {
-            if (!_lookup_whitespace_chars[_u8(this->chars[cursor])]) return cursor;
-            ++cursor;
-        }
+        cursor = _find_non_whitespace(this->chars, cursor);
+        if (cursor < this->chars.size()) return cursor;
 
         throw std::runtime_error("JSON parser reached the end of buffer at pos "s + std::to_string(cursor) +
                                  " while skipping insignificant whitespace segment."s +
                                  _pretty_error(cursor, this->chars));
     }
 
-    // Parsing methods
-    std::pair<std::size_t, Node> parse_node(std::size_t cursor) {
+    void enter_nested_node() {
         using namespace std::string_literals;
 
-        // Node selector assumes it is starting at a significant symbol
-        // which is the first symbol of the node to be parsed
+        if (++this->recursion_depth > this->recursion_limit)
+            throw std::runtime_error("JSON parser has exceeded maximum allowed recursion depth of "s +
+                                     std::to_string(this->recursion_limit) +
+                                     ". If stated depth wasn't caused by an invalid input, "s +
+                                     "recursion limit can be increased with json::set_recursion_limit()."s);
+    }
+
+    void leave_nested_node() noexcept { --this->recursion_depth; }
+
+    // Parsing methods
+    void parse_root() {
+        using namespace std::string_literals;
+
+        const std::size_t json_start = this->skip_nonsignificant_whitespace(0); // skip leading whitespace
+        const std::size_t end_cursor = this->parse_node(json_start); // starts parsing recursively from the root node
+
+        this->check_trailing_symbols(end_cursor);
+    }
+
+    void check_trailing_symbols(std::size_t cursor) const {
+        using namespace std::string_literals;
+
+        for (; cursor < this->chars.size(); ++cursor)
+            if (!_lookup_whitespace_chars[_u8(this->chars[cursor])])
+                throw std::runtime_error("Invalid trailing symbols encountered after the root JSON node at pos "s +
+                                         std::to_string(cursor) + "."s + _pretty_error(cursor, this->chars));
+    }
+
+    std::size_t parse_node(std::size_t cursor) {
+        using namespace std::string_literals;
+
+        // Node selector assumes it is starting at a significant symbol
+        // which is the first symbol of the node to be parsed
 
         const char c = this->chars[cursor];
 
@@ -1616,15 +2373,27 @@ struct _parser {
         } else if (c == '[') {
             return this->parse_array(cursor);
         } else if (c == '"') {
-            return this->parse_string(cursor);
+            std::string_view string_value;
+            std::tie(cursor, string_value) = this->parse_string(cursor);
+            this->handler.on_string(string_value);
+            return cursor;
         } else if (('0' <= c && c <= '9') || (c == '-')) {
-            return this->parse_number(cursor);
+            number_type number_value;
+            std::tie(cursor, number_value) = this->parse_number(cursor);
+            this->handler.on_number(number_value);
+            return cursor;
         } else if (c == 't') {
-            return this->parse_true(cursor);
+            std::tie(cursor, std::ignore) = this->parse_true(cursor);
+            this->handler.on_bool(true);
+            return cursor;
         } else if (c == 'f') {
-            return this->parse_false(cursor);
+            std::tie(cursor, std::ignore) = this->parse_false(cursor);
+            this->handler.on_bool(false);
+            return cursor;
         } else if (c == 'n') {
-            return this->parse_null(cursor);
+            std::tie(cursor, std::ignore) = this->parse_null(cursor);
+            this->handler.on_null();
+            return cursor;
         }
         throw std::runtime_error("JSON node selector encountered unexpected marker symbol {"s + this->chars[cursor] +
                                  "} at pos "s + std::to_string(cursor) + " (should be one of {0123456789{[\"tfn})."s +
@@ -1633,14 +2402,15 @@ struct _parser {
         // Note: using a lookup table instead of an 'if' chain doesn't seem to offer any performance benefits here
     }
 
-    std::size_t parse_object_pair(std::size_t cursor, Object& parent) {
+    std::size_t parse_object_pair(std::size_t cursor) {
         using namespace std::string_literals;
 
         // Object pair parser assumes it is starting at a '"'
 
         // Parse pair key
-        std::string key; // allocating a string here is fine since we will std::move() it into a map key
+        std::string_view key;
         std::tie(cursor, key) = this->parse_string(cursor);
+        this->handler.on_key(key);
 
         // Handle stuff in-between
         cursor = this->skip_nonsignificant_whitespace(cursor);
@@ -1652,67 +2422,32 @@ struct _parser {
         cursor = this->skip_nonsignificant_whitespace(cursor);
 
         // Parse pair value
-        if (++this->recursion_depth > this->recursion_limit)
-            throw std::runtime_error("JSON parser has exceeded maximum allowed recursion depth of "s +
-                                     std::to_string(this->recursion_limit) +
-                                     ". If stated depth wasn't caused by an invalid input, "s +
-                                     "recursion limit can be increased with json::set_recursion_limit()."s);
-
-        Node value;
-        std::tie(cursor, value) = this->parse_node(cursor);
-
-        --this->recursion_depth;
-
-        // Note 1:
-        // The question of whether JSON allows duplicate keys is non-trivial but the resulting answer is YES.
-        // JSON is governed by 2 standards:
-        // 1) ECMA-404 https://ecma-international.org/wp-content/uploads/ECMA-404.pdf
-        //    which doesn't say anything about duplicate kys
-        // 2) RFC-8259 https://www.rfc-editor.org/rfc/rfc8259
-        //    which states "The names within an object SHOULD be unique.",
-        //    however as defined in RFC-2119 https://www.rfc-editor.org/rfc/rfc2119:
-        //       "SHOULD This word, or the adjective "RECOMMENDED", mean that there may exist valid reasons in
-        //       particular circumstances to ignore a particular item, but the full implications must be understood
-        //       and carefully weighed before choosing a different course."
-        // which means at the end of the day duplicate keys are discouraged but still valid
+        this->enter_nested_node();
+        cursor = this->parse_node(cursor);
+        this->leave_nested_node();
 
-        // Note 2:
-        // There is no standard specification on which JSON value should be preferred in case of duplicate keys.
-        // This is considered implementation detail as per RFC-8259:
-        //    "An object whose names are all unique is interoperable in the sense that all software implementations
-        //    receiving that object will agree on the name-value mappings. When the names within an object are not
-        //    unique, the behavior of software that receives such an object is unpredictable. Many implementations
-        //    report the last name/value pair only. Other implementations report an error or fail to parse the object,
-        //    and some implementations report all of the name/value pairs, including duplicates."
-
-        // Note 3:
-        // We could easily check for duplicate keys since 'std::map<>::emplace()' returns insertion success as a bool
-        // (the same isn't true for 'std::map<>::emplace_hint()' which returns just the iterator), however we will
-        // not since that goes against the standard
-
-        // Note 4:
-        // 'parent.emplace_hint(parent.end(), ...)' can drastically speed up parsing of sorted JSON objects, however
-        // since most JSONs in the wild aren't sorted we will resort to a more generic option of regular '.emplace()'
-        parent.try_emplace(std::move(key), std::move(value));
+        // Note:
+        // Duplicate keys are reported as-is, it is up to the handler to decide what to do with them,
+        // tree-building handler keeps the first one, see '_node_builder::on_object_end()'
 
         return cursor;
     }
 
-    std::pair<std::size_t, Object> parse_object(std::size_t cursor) {
+    std::size_t parse_object(std::size_t cursor) {
         using namespace std::string_literals;
 
         ++cursor; // move past the opening brace '{'
 
-        // Empty object that will accumulate child nodes as we parse them
-        Object object_value;
+        this->handler.on_object_begin();
 
         // Handle 1st pair
         cursor = this->skip_nonsignificant_whitespace(cursor);
         if (this->chars[cursor] != '}') {
-            cursor = this->parse_object_pair(cursor, object_value);
+            cursor = this->parse_object_pair(cursor);
         } else {
             ++cursor; // move past the closing brace '}'
-            return {cursor, std::move(object_value)};
+            this->handler.on_object_end();
+            return cursor;
         }
 
         // Handle other pairs
@@ -1736,10 +2471,11 @@ struct _parser {
             if (c == ',') {
                 ++cursor; // move past the comma ','
                 cursor = this->skip_nonsignificant_whitespace(cursor);
-                cursor = this->parse_object_pair(cursor, object_value);
+                cursor = this->parse_object_pair(cursor);
             } else if (c == '}') {
                 ++cursor; // move past the closing brace '}'
-                return {cursor, std::move(object_value)};
+                this->handler.on_object_end();
+                return cursor;
             } else {
                 throw std::runtime_error(
                     "JSON array node could not find comma {,} or object ending symbol {}} after the element at pos "s +
@@ -1751,43 +2487,30 @@ struct _parser {
                                  _pretty_error(cursor, this->chars));
     }
 
-    std::size_t parse_array_element(std::size_t cursor, Array& parent) {
-        using namespace std::string_literals;
-
+    std::size_t parse_array_element(std::size_t cursor) {
         // Array element parser assumes it is starting at the first symbol of some JSON node
-
-        // Parse pair key
-        if (++this->recursion_depth > this->recursion_limit)
-            throw std::runtime_error("JSON parser has exceeded maximum allowed recursion depth of "s +
-                                     std::to_string(this->recursion_limit) +
-                                     ". If stated depth wasn't caused by an invalid input, "s +
-                                     "recursion limit can be increased with json::set_recursion_limit()."s);
-
-        Node value;
-        std::tie(cursor, value) = this->parse_node(cursor);
-
-        --this->recursion_depth;
-
-        parent.emplace_back(std::move(value));
+        this->enter_nested_node();
+        cursor = this->parse_node(cursor);
+        this->leave_nested_node();
 
         return cursor;
     }
 
-    std::pair<std::size_t, Array> parse_array(std::size_t cursor) {
+    std::size_t parse_array(std::size_t cursor) {
         using namespace std::string_literals;
 
         ++cursor; // move past the opening bracket '['
 
-        // Empty array that will accumulate child nodes as we parse them
-        Array array_value;
+        this->handler.on_array_begin();
 
         // Handle 1st pair
         cursor = this->skip_nonsignificant_whitespace(cursor);
         if (this->chars[cursor] != ']') {
-            cursor = this->parse_array_element(cursor, array_value);
+            cursor = this->parse_array_element(cursor);
         } else {
             ++cursor; // move past the closing bracket ']'
-            return {cursor, std::move(array_value)};
+            this->handler.on_array_end();
+            return cursor;
         }
 
         // Handle other pairs
@@ -1799,10 +2522,11 @@ struct _parser {
             if (c == ',') {
                 ++cursor; // move past the comma ','
                 cursor = this->skip_nonsignificant_whitespace(cursor);
-                cursor = this->parse_array_element(cursor, array_value);
+                cursor = this->parse_array_element(cursor);
             } else if (c == ']') {
                 ++cursor; // move past the closing bracket ']'
-                return {cursor, std::move(array_value)};
+                this->handler.on_array_end();
+                return cursor;
             } else {
                 throw std::runtime_error(
                     "JSON array node could not find comma {,} or array ending symbol {]} after the element at pos "s +
@@ -1814,7 +2538,7 @@ struct _parser {
                                  _pretty_error(cursor, this->chars));
     }
 
-    inline std::size_t parse_escaped_unicode_codepoint(std::size_t cursor, std::string& string_value) {
+    std::size_t parse_escaped_unicode_codepoint(std::size_t cursor, std::string& string_value) {
         using namespace std::string_literals;
 
         // Note 1:
@@ -1904,14 +2628,38 @@ struct _parser {
         }
     }
 
-    std::pair<std::size_t, String> parse_string(std::size_t cursor) {
+    std::pair<std::size_t, std::string_view> parse_string(std::size_t cursor) {
         using namespace std::string_literals;
 
-        // Empty string that will accumulate characters as we parse them
-        std::string string_value;
+        const auto throw_control_character_error = [&]() {
+            throw std::runtime_error("JSON string node encountered unescaped ASCII control character character \\"s +
+                                     std::to_string(static_cast<int>(this->chars[cursor])) + " at pos "s +
+                                     std::to_string(cursor) + "."s + _pretty_error(cursor, this->chars));
+        };
 
         ++cursor; // move past the opening quote '"'
 
+        // Most strings in the wild contain no escape sequences, in which case string contents are just
+        // a segment of the buffer. We can scan for it without doing any appends and report a view directly
+        // into the buffer, handlers that need to own the string can then construct it in a single allocation.
+        const std::size_t string_start = cursor;
+
+        cursor = _find_string_special_char(this->chars, cursor);
+        if (cursor < this->chars.size()) {
+            const char c = this->chars[cursor];
+
+            if (c == '"') {
+                const std::string_view contents(this->chars.data() + string_start, cursor - string_start);
+                ++cursor; // move past the closing quote '"'
+                return {cursor, contents};
+            } else if (c != '\\') throw_control_character_error();
+            // on backslash fall back onto a regular escape-handling loop
+        }
+
+        // Reusable buffer that will accumulate characters as we parse them, starts with an already scanned segment
+        std::string& string_value = this->buffer;
+        string_value.assign(this->chars.data() + string_start, cursor - string_start);
+
         // Serialize string while handling escape sequences.
         //
         // Doing 'string_value += c' for every char is ~50-60% slower than appending whole string at once,
@@ -1919,13 +2667,17 @@ struct _parser {
         // whole chunks of the buffer to 'string_value' when we encounter an escape sequence or end of the string.
         //
         for (std::size_t segment_start = cursor; cursor < this->chars.size(); ++cursor) {
+            cursor = _find_string_special_char(this->chars, cursor); // skip to the next char that needs handling
+            if (cursor == this->chars.size()) break;
+
             const char c = this->chars[cursor];
 
             // Reached the end of the string
             if (c == '"') {
                 string_value.append(this->chars.data() + segment_start, cursor - segment_start);
                 ++cursor; // move past the closing quote '"'
-                return {cursor, std::move(string_value)};
+                return {cursor, string_value};
+                // decoded strings can't reference the buffer, they are valid until the next escaped string
             }
             // Handle escape sequences inside the string
             else if (c == '\\') {
@@ -1964,21 +2716,17 @@ struct _parser {
                 continue;
             }
             // Reject unescaped control characters (codepoints U+0000 to U+001F)
-            else if (_u8(c) <= 31)
-                throw std::runtime_error(
-                    "JSON string node encountered unescaped ASCII control character character \\"s +
-                    std::to_string(static_cast<int>(c)) + " at pos "s + std::to_string(cursor) + "."s +
-                    _pretty_error(cursor, this->chars));
+            else if (_u8(c) <= 31) throw_control_character_error();
         }
 
         throw std::runtime_error("JSON string node reached the end of buffer while parsing string contents." +
                                  _pretty_error(cursor, this->chars));
     }
 
-    std::pair<std::size_t, Number> parse_number(std::size_t cursor) {
+    std::pair<std::size_t, number_type> parse_number(std::size_t cursor) {
         using namespace std::string_literals;
 
-        Number number_value;
+        number_type number_value;
 
         const auto [numer_end_ptr, error_code] =
             std::from_chars(this->chars.data() + cursor, this->chars.data() + this->chars.size(), number_value);
@@ -2002,7 +2750,7 @@ struct _parser {
         return {numer_end_ptr - this->chars.data(), number_value};
     }
 
-    std::pair<std::size_t, Bool> parse_true(std::size_t cursor) {
+    std::pair<std::size_t, bool_type> parse_true(std::size_t cursor) {
         using namespace std::string_literals;
         constexpr std::size_t token_length = 4;
 
@@ -2020,10 +2768,10 @@ struct _parser {
             throw std::runtime_error("JSON bool node could not parse {true} at pos "s + std::to_string(cursor) + "."s +
                                      _pretty_error(cursor, this->chars));
 
-        return {cursor + token_length, Bool(true)};
+        return {cursor + token_length, bool_type(true)};
     }
 
-    std::pair<std::size_t, Bool> parse_false(std::size_t cursor) {
+    std::pair<std::size_t, bool_type> parse_false(std::size_t cursor) {
         using namespace std::string_literals;
         constexpr std::size_t token_length = 5;
 
@@ -2042,10 +2790,10 @@ struct _parser {
             throw std::runtime_error("JSON bool node could not parse {false} at pos "s + std::to_string(cursor) + "."s +
                                      _pretty_error(cursor, this->chars));
 
-        return {cursor + token_length, Bool(false)};
+        return {cursor + token_length, bool_type(false)};
     }
 
-    std::pair<std::size_t, Null> parse_null(std::size_t cursor) {
+    std::pair<std::size_t, null_type> parse_null(std::size_t cursor) {
         using namespace std::string_literals;
         constexpr std::size_t token_length = 4;
 
@@ -2063,19 +2811,252 @@ struct _parser {
             throw std::runtime_error("JSON null node could not parse {null} at pos "s + std::to_string(cursor) + "."s +
                                      _pretty_error(cursor, this->chars));
 
-        return {cursor + token_length, Null()};
+        return {cursor + token_length, null_type()};
     }
 };
 
+// Tree-building SAX handler, this is what all of the 'from_string()' variants parse with.
+//
+// Values of all currently open containers are accumulated on a single stack, once a container is closed its elements
+// get moved into a container allocated with an exact size. Apart from saving on regrowth, this is also important for
+// arena nodes, since arena memory is never reused every regrowth would leave the old buffer behind as dead memory.
+//
+// Builder is templated on the resulting node type, this way the same logic can construct both owning 'Node' trees
+// and non-owning 'View' trees. The only parts that differ are string handling (copy vs. reference into the buffer)
+// and object insertion (map vs. flat vector), see 'if constexpr' branches.
+template <class NodeType>
+struct _node_builder {
+    using object_type = typename NodeType::object_type;
+    using array_type  = typename NodeType::array_type;
+    using string_type = typename NodeType::string_type;
+    using number_type = typename NodeType::number_type;
+    using bool_type   = typename NodeType::bool_type;
+    using null_type   = typename NodeType::null_type;
+
+    constexpr static bool is_view = std::is_same_v<string_type, std::string_view>;
+
+    using allocator_type = typename array_type::allocator_type;
+
+    struct frame {
+        std::size_t values_start;
+        std::size_t keys_start;
+    };
+
+    std::vector<NodeType>    values; // values of all currently open containers, innermost container goes last
+    std::vector<string_type> keys;   // keys of all currently open objects
+    std::vector<frame>       frames; // one per currently open container
+
+    std::string_view chars;           // parsed buffer, views reference strings directly from it
+    allocator_type   allocator;       // allocator for all the containers, only meaningful for arena nodes
+    Arena*           arena = nullptr; // storage for decoded escaped strings, only used when building a 'View'
+
+    explicit _node_builder(std::string_view chars, const allocator_type& allocator = {}, Arena* arena = nullptr)
+        : chars(chars), allocator(allocator), arena(arena) {}
+
+    // Containers & strings have to be explicitly constructed with an allocator, otherwise nodes that use
+    // stateful allocators would end up with a default-constructed one (which isn't the one we want)
+    [[nodiscard]] string_type make_string(std::string_view contents) const {
+        if constexpr (is_view) {
+            const std::less<const char*> less;
+            const bool                   points_into_buffer = !less(contents.data(), this->chars.data()) &&
+                                            less(contents.data(), this->chars.data() + this->chars.size());
+            if (points_into_buffer) return contents;
+            else return this->arena->store(contents);
+            // decoded strings can't reference the buffer, views keep them in the arena owned by the document
+        } else return string_type(contents, this->allocator);
+    }
+
+    [[nodiscard]] NodeType result() { return std::move(this->values.back()); }
+
+    // - Events -
+    void on_object_begin() { this->frames.push_back({this->values.size(), this->keys.size()}); }
+    void on_array_begin() { this->frames.push_back({this->values.size(), this->keys.size()}); }
+
+    void on_key(std::string_view key) { this->keys.push_back(this->make_string(key)); }
+
+    void on_string(std::string_view value) { this->values.emplace_back(this->make_string(value)); }
+    void on_number(number_type value) { this->values.emplace_back(value); }
+    void on_bool(bool_type value) { this->values.emplace_back(value); }
+    void on_null() { this->values.emplace_back(null_type{}); }
+
+    void on_object_end() {
+        const frame       current = this->frames.back();
+        const std::size_t size    = this->values.size() - current.values_start;
+        this->frames.pop_back();
+
+        object_type object_value(this->allocator);
+        if constexpr (_has_reserve_v<object_type>) object_value.reserve(size);
+
+        for (std::size_t i = 0; i < size; ++i) {
+            auto& key   = this->keys[current.keys_start + i];
+            auto& value = this->values[current.values_start + i];
+
+            // Note 1:
+            // The question of whether JSON allows duplicate keys is non-trivial but the resulting answer is YES.
+            // JSON is governed by 2 standards:
+            // 1) ECMA-404 https://ecma-international.org/wp-content/uploads/ECMA-404.pdf
+            //    which doesn't say anything about duplicate kys
+            // 2) RFC-8259 https://www.rfc-editor.org/rfc/rfc8259
+            //    which states "The names within an object SHOULD be unique.",
+            //    however as defined in RFC-2119 https://www.rfc-editor.org/rfc/rfc2119:
+            //       "SHOULD This word, or the adjective "RECOMMENDED", mean that there may exist valid reasons in
+            //       particular circumstances to ignore a particular item, but the full implications must be understood
+            //       and carefully weighed before choosing a different course."
+            // which means at the end of the day duplicate keys are discouraged but still valid
+
+            // Note 2:
+            // There is no standard specification on which JSON value should be preferred in case of duplicate keys.
+            // This is considered implementation detail as per RFC-8259:
+            //    "An object whose names are all unique is interoperable in the sense that all software
+            //    implementations receiving that object will agree on the name-value mappings. When the names
+            //    within an object are not unique, the behavior of software that receives such an object is
+            //    unpredictable. Many implementations report the last name/value pair only. Other implementations
+            //    report an error or fail to parse the object, and some implementations report all of the
+            //    name/value pairs, including duplicates."
+
+            // Note 3:
+            // We could easily check for duplicate keys since 'try_emplace()' returns insertion success as a bool,
+            // however we will not since that goes against the standard
+
+            // Note 4:
+            // 'parent.emplace_hint(parent.end(), ...)' can drastically speed up parsing of sorted JSON objects,
+            // however since most JSONs in the wild aren't sorted we will resort to a more generic option of
+            // regular '.emplace()'
+            if constexpr (is_view) object_value.emplace_back(key, std::move(value));
+            else object_value.try_emplace(std::move(key), std::move(value));
+            // views keep pairs in a flat vector, lookup returns the first match which
+            // makes duplicate key handling consistent with 'try_emplace()' on a map
+        }
+
+        this->values.erase(this->values.begin() + current.values_start, this->values.end());
+        this->keys.erase(this->keys.begin() + current.keys_start, this->keys.end());
+        this->values.emplace_back(std::move(object_value));
+    }
+
+    void on_array_end() {
+        const frame       current = this->frames.back();
+        const std::size_t size    = this->values.size() - current.values_start;
+        this->frames.pop_back();
+
+        array_type array_value(this->allocator);
+        array_value.reserve(size);
+
+        for (std::size_t i = 0; i < size; ++i)
+            array_value.emplace_back(std::move(this->values[current.values_start + i]));
+
+        this->values.erase(this->values.begin() + current.values_start, this->values.end());
+        this->values.emplace_back(std::move(array_value));
+    }
+};
 
 // ==============================
 // --- JSON Serializing impl. ---
 // ==============================
 
-template <bool prettify>
-inline void _serialize_json_recursion(const Node& node, std::string& chars, unsigned int indent_level = 0,
-                                      bool skip_first_indent = false) {
+// Serializer always writes into a 'std::string' buffer, sinks decide what happens to the part that was
+// already written. Streaming sinks flush the buffer once it grows past '_sink_buffer_size', checks only
+// happen between array elements & object pairs so the per-char hot path stays exactly the same as for
+// 'to_string()'. This bounds memory usage by the buffer size plus the size of the largest leaf value.
+
+constexpr std::size_t _sink_buffer_size = 1 << 16; // 64 KiB
+
+struct _string_sink {
+    void maybe_flush(std::string&) noexcept {}
+    void flush(std::string&) noexcept {}
+};
+
+template <class Callback>
+struct _callback_sink {
+    Callback& callback;
+
+    void maybe_flush(std::string& chars) {
+        if (chars.size() >= _sink_buffer_size) this->flush(chars);
+    }
+
+    void flush(std::string& chars) {
+        if (chars.empty()) return;
+        this->callback(std::string_view(chars));
+        chars.clear(); // keeps the capacity
+    }
+};
+
+inline void _serialize_string(std::string& chars, std::string_view string_value) {
+    chars += '"';
+
+    // Serialize string while handling escape sequences.
+    // Without escape sequences we could just do 'chars += string_value'.
+    //
+    // Since appending individual characters is ~twice as slow as appending the whole string, we use a
+    // "buffered" way of appending, appending whole segments up to the currently escaped char.
+    // Strings with no escaped chars get appended in a single call.
+    //
+    // Chars that need escaping are exactly the ones parser has to handle specially, which means we can
+    // use the same SIMD scanner to jump from one escaped char to the next, see '_find_string_special_char()'.
+    //
+    std::size_t segment_start = 0;
+    for (std::size_t i = _find_string_special_char(string_value, 0); i < string_value.size();
+         i = _find_string_special_char(string_value, i + 1)) {
+        chars.append(string_value.data() + segment_start, i - segment_start);
+        chars += '\\';
+
+        const char c = string_value[i];
+        if (const char escaped_char_replacement = _lookup_serialized_escaped_chars[_u8(c)]) {
+            chars += escaped_char_replacement;
+        } else {
+            // control chars without a 2-character escape sequence have to be escaped as '\u00XX'
+            constexpr std::string_view hex_digits = "0123456789abcdef";
+            chars += "u00";
+            chars += hex_digits[_u8(c) >> 4];
+            chars += hex_digits[_u8(c) & 0xF];
+        }
+
+        segment_start = i + 1; // skip over the "actual" technical character in the string
+    }
+    chars.append(string_value.data() + segment_start, string_value.size() - segment_start);
+
+    chars += '"';
+}
+
+template <class Number>
+void _serialize_number(std::string& chars, Number number_value) {
+    using namespace std::string_literals;
+
+    constexpr int max_exponent = std::numeric_limits<Number>::max_exponent10;
+    constexpr int max_digits =
+        4 + std::numeric_limits<Number>::max_digits10 + std::max(2, _log_10_ceil(max_exponent));
+    // should be the smallest buffer size to account for all possible 'std::to_chars()' outputs,
+    // see [https://stackoverflow.com/questions/68472720/stdto-chars-minimal-floating-point-buffer-size]
+
+    std::array<char, max_digits> buffer;
+
+    const auto [number_end_ptr, error_code] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), number_value);
+
+    if (error_code != std::errc{})
+        throw std::runtime_error(
+            "JSON serializing encountered std::to_chars() formatting error while serializing value {"s +
+            std::to_string(number_value) + "}."s);
+
+    // Save NaN/Inf cases as strings, since JSON spec doesn't include IEEE 754.
+    // (!) May result in non-homogenous arrays like [ 1.0, "inf" , 3.0, 4.0, "nan" ]
+    if (std::isfinite(number_value)) {
+        chars.append(buffer.data(), number_end_ptr - buffer.data());
+    } else {
+        chars += '"';
+        chars.append(buffer.data(), number_end_ptr - buffer.data());
+        chars += '"';
+    }
+}
+
+template <bool prettify, class NodeType, class Sink>
+void _serialize_json_recursion(const NodeType& node, std::string& chars, Sink& sink, unsigned int indent_level = 0,
+                               bool skip_first_indent = false) {
     using namespace std::string_literals;
+    using Object = typename NodeType::object_type;
+    using Array  = typename NodeType::array_type;
+    using String = typename NodeType::string_type;
+    using Number = typename NodeType::number_type;
+    using Bool   = typename NodeType::bool_type;
+    using Null   = typename NodeType::null_type;
     constexpr std::size_t indent_level_size = 4;
     const std::size_t     indent_size       = indent_level_size * indent_level;
 
@@ -2114,7 +3095,7 @@ inline void _serialize_json_recursion(const Node& node, std::string& chars, unsi
         if (!skip_first_indent) chars.append(indent_size, ' ');
 
     // JSON Object
-    if (auto* ptr = node.get_if<Object>()) {
+    if (auto* ptr = node.template get_if<Object>()) {
         const auto& object_value = *ptr;
 
         // Skip all logic for empty objects
@@ -2129,12 +3110,12 @@ inline void _serialize_json_recursion(const Node& node, std::string& chars, unsi
         for (auto it = object_value.cbegin();;) {
             if constexpr (prettify) chars.append(indent_size + indent_level_size, ' ');
             // Key
-            chars += '"';
-            chars += it->first;
-            if constexpr (prettify) chars += "\": ";
-            else chars += "\":";
+            _serialize_string(chars, it->first); // keys need escaping just as much as the values
+            if constexpr (prettify) chars += ": ";
+            else chars += ':';
             // Value
-            _serialize_json_recursion<prettify>(it->second, chars, indent_level + 1, true);
+            _serialize_json_recursion<prettify>(it->second, chars, sink, indent_level + 1, true);
+            sink.maybe_flush(chars);
             // Comma
             if (++it != object_value.cend()) { // prevents trailing comma
                 chars += ',';
@@ -2149,7 +3130,7 @@ inline void _serialize_json_recursion(const Node& node, std::string& chars, unsi
         chars += '}';
     }
     // JSON Array
-    else if (auto* ptr = node.get_if<Array>()) {
+    else if (auto* ptr = node.template get_if<Array>()) {
         const auto& array_value = *ptr;
 
         // Skip all logic for empty arrays
@@ -2163,7 +3144,8 @@ inline void _serialize_json_recursion(const Node& node, std::string& chars, unsi
 
         for (auto it = array_value.cbegin();;) {
             // Node
-            _serialize_json_recursion<prettify>(*it, chars, indent_level + 1);
+            _serialize_json_recursion<prettify>(*it, chars, sink, indent_level + 1);
+            sink.maybe_flush(chars);
             // Comma
             if (++it != array_value.cend()) { // prevents trailing comma
                 chars += ',';
@@ -2177,108 +3159,246 @@ inline void _serialize_json_recursion(const Node& node, std::string& chars, unsi
         chars += ']';
     }
     // String
-    else if (auto* ptr = node.get_if<String>()) {
+    else if (auto* ptr = node.template get_if<String>()) {
         const auto& string_value = *ptr;
 
-        chars += '"';
-
-        // Serialize string while handling escape sequences.
-        /// Without escape sequences we could just do 'chars += string_value'.
-        //
-        // Since appending individual characters is ~twice as slow as appending the whole string, we use a
-        // "buffered" way of appending, appending whole segments up to the currently escaped char.
-        // Strings with no escaped chars get appended in a single call.
-        //
-        std::size_t segment_start = 0;
-        for (std::size_t i = 0; i < string_value.size(); ++i) {
-            if (const char escaped_char_replacement = _lookup_serialized_escaped_chars[_u8(string_value[i])]) {
-                chars.append(string_value.data() + segment_start, i - segment_start);
-                chars += '\\';
-                chars += escaped_char_replacement;
-                segment_start = i + 1; // skip over the "actual" technical character in the string
-            }
-        }
-        chars.append(string_value.data() + segment_start, string_value.size() - segment_start);
-
-        chars += '"';
+        _serialize_string(chars, string_value);
     }
     // Number
-    else if (auto* ptr = node.get_if<Number>()) {
-        const auto& number_value = *ptr;
-
-        constexpr int max_exponent = std::numeric_limits<Number>::max_exponent10;
-        constexpr int max_digits =
-            4 + std::numeric_limits<Number>::max_digits10 + std::max(2, _log_10_ceil(max_exponent));
-        // should be the smallest buffer size to account for all possible 'std::to_chars()' outputs,
-        // see [https://stackoverflow.com/questions/68472720/stdto-chars-minimal-floating-point-buffer-size]
-
-        std::array<char, max_digits> buffer;
-
-        const auto [number_end_ptr, error_code] =
-            std::to_chars(buffer.data(), buffer.data() + buffer.size(), number_value);
-
-        if (error_code != std::errc{})
-            throw std::runtime_error(
-                "JSON serializing encountered std::to_chars() formatting error while serializing value {"s +
-                std::to_string(number_value) + "}."s);
-
-        const std::string_view number_string(buffer.data(), number_end_ptr - buffer.data());
-
-        // Save NaN/Inf cases as strings, since JSON spec doesn't include IEEE 754.
-        // (!) May result in non-homogenous arrays like [ 1.0, "inf" , 3.0, 4.0, "nan" ]
-        if (std::isfinite(number_value)) {
-            chars.append(buffer.data(), number_end_ptr - buffer.data());
-        } else {
-            chars += '"';
-            chars.append(buffer.data(), number_end_ptr - buffer.data());
-            chars += '"';
-        }
+    else if (auto* ptr = node.template get_if<Number>()) {
+        _serialize_number(chars, *ptr);
     }
     // Bool
-    else if (auto* ptr = node.get_if<Bool>()) {
+    else if (auto* ptr = node.template get_if<Bool>()) {
         const auto& bool_value = *ptr;
         chars += (bool_value ? "true" : "false");
     }
     // Null
-    else if (node.is<Null>()) {
+    else if (node.template is<Null>()) {
         chars += "null";
     }
 }
 
-inline void _serialize_json_to_buffer(std::string& chars, const Node& node, Format format) {
-    if (format == Format::PRETTY) _serialize_json_recursion<true>(node, chars);
-    else _serialize_json_recursion<false>(node, chars);
+template <class NodeType>
+void _serialize_json_to_buffer(std::string& chars, const NodeType& node, Format format) {
+    _string_sink sink;
+    if (format == Format::PRETTY) _serialize_json_recursion<true>(node, chars, sink);
+    else _serialize_json_recursion<false>(node, chars, sink);
+}
+
+template <class NodeType, class Callback>
+void _serialize_json_to_callback(Callback& callback, const NodeType& node, Format format) {
+    std::string chars;
+    chars.reserve(_sink_buffer_size + _sink_buffer_size / 4); // leave some room for the overshoot
+
+    _callback_sink<Callback> sink{callback};
+    if (format == Format::PRETTY) _serialize_json_recursion<true>(node, chars, sink);
+    else _serialize_json_recursion<false>(node, chars, sink);
+    sink.flush(chars);
 }
 
 // ===============================
 // --- JSON Parsing public API ---
 // ===============================
 
-[[nodiscard]] inline Node from_string(const std::string& chars,
-                                      unsigned int       recursion_limit = _default_recursion_limit) {
-    _parser           parser(chars, recursion_limit);
-    const std::size_t json_start = parser.skip_nonsignificant_whitespace(0); // skip leading whitespace
-    auto [end_cursor, node]      = parser.parse_node(json_start); // starts parsing recursively from the root node
-
-    // Check for invalid trailing symbols
-    using namespace std::string_literals;
-
-    for (auto cursor = end_cursor; cursor < chars.size(); ++cursor)
-        if (!_lookup_whitespace_chars[_u8(chars[cursor])])
-            throw std::runtime_error("Invalid trailing symbols encountered after the root JSON node at pos "s +
-                                     std::to_string(cursor) + "."s + _pretty_error(cursor, chars));
+// Base for SAX handlers, provides no-op callbacks for all of the events,
+// which means derived handlers only need to define the events they care about
+struct SaxHandler {
+    void on_object_begin() {}
+    void on_object_end() {}
+    void on_array_begin() {}
+    void on_array_end() {}
+    void on_key(std::string_view) {}
+    void on_string(std::string_view) {}
+    void on_number(Number) {}
+    void on_bool(Bool) {}
+    void on_null() {}
+};
 
-    return std::move(node); // implicit tuple blocks copy elision, we have to move() manually
+template <class Handler>
+void sax_from_string(std::string_view chars, Handler& handler,
+                     unsigned int recursion_limit = _default_recursion_limit) {
+    _sax_parser<Handler> parser(chars, recursion_limit, handler);
+    parser.parse_root();
+}
 
-    // Note: Some code analyzers detect 'return std::move(node)' as a performance issue, it is
-    //       not, NOT having 'std::move()' on the other hand is very much a performance issue
+template <class NodeType = Node>
+[[nodiscard]] NodeType from_string(const std::string& chars, unsigned int recursion_limit = _default_recursion_limit) {
+    _node_builder<NodeType> builder(chars);
+    sax_from_string(chars, builder, recursion_limit);
+    return builder.result();
+}
+[[nodiscard]] inline ArenaNode from_string(const std::string& chars, Arena& arena,
+                                           unsigned int recursion_limit = _default_recursion_limit) {
+    _node_builder<ArenaNode> builder(chars, arena);
+    sax_from_string(chars, builder, recursion_limit);
+    return builder.result();
 }
-[[nodiscard]] inline Node from_file(const std::string& filepath,
-                                    unsigned int       recursion_limit = _default_recursion_limit) {
+
+template <class NodeType = Node>
+[[nodiscard]] NodeType from_file(const std::string& filepath, unsigned int recursion_limit = _default_recursion_limit) {
     const std::string chars = _read_file_to_string(filepath);
-    return from_string(chars, recursion_limit);
+    return from_string<NodeType>(chars, recursion_limit);
+}
+
+[[nodiscard]] inline ViewDocument view_from_string(std::string_view chars,
+                                                  unsigned int     recursion_limit = _default_recursion_limit) {
+    Arena               arena;
+    _node_builder<View> builder(chars, {}, &arena);
+    sax_from_string(chars, builder, recursion_limit);
+    return ViewDocument(builder.result(), std::move(arena));
 }
 
+template <class T, std::enable_if_t<std::is_same_v<std::remove_cv_t<T>, std::string> &&
+                                        !std::is_lvalue_reference_v<T>,
+                                    bool> = true>
+ViewDocument view_from_string(T&& chars, unsigned int recursion_limit = _default_recursion_limit) = delete;
+// views reference the parsed buffer, parsing a temporary string (const or not) would leave them dangling
+
+// Incremental parser for input that arrives in chunks (sockets, pipes, log streams). Input can contain any number of
+// whitespace-separated top-level values (NDJSON, concatenated JSON, or just a single document), every value gets
+// passed to the callback as soon as its last chunk arrives.
+//
+// Resumable parsing is done at the granularity of top-level values: incoming chunks go through a lightweight scanner
+// that only tracks nesting depth & string boundaries to detect where each value ends, complete values are then
+// parsed with the regular parser. This way only the current incomplete value is ever buffered, while validation
+// and error messages stay exactly the same as with 'from_string()'.
+class StreamParser {
+public:
+    using callback_type = std::function<void(Node&&)>;
+
+private:
+    callback_type callback;
+    unsigned int  recursion_limit;
+
+    std::string buffer;          // unprocessed input, starts with the current incomplete value (if there is one)
+    std::size_t cursor      = 0; // everything in the 'buffer' before the cursor was already scanned
+    std::size_t value_start = 0; // start of the current incomplete value in the 'buffer'
+
+    // Scanner state
+    bool        in_value  = false;
+    bool        in_scalar = false; // numbers, bools & nulls can only end on a delimiter
+    bool        in_string = false;
+    bool        escaped   = false;
+    std::size_t depth     = 0;
+
+    [[nodiscard]] static bool is_delimiter(char c) noexcept {
+        return _lookup_whitespace_chars[_u8(c)] || c == '{' || c == '}' || c == '[' || c == ']' || c == ',' ||
+               c == '"';
+    }
+
+    void reset_scanner() noexcept {
+        this->in_value  = false;
+        this->in_scalar = false;
+        this->in_string = false;
+        this->escaped   = false;
+        this->depth     = 0;
+    }
+
+    void emit(std::string_view value) {
+        _node_builder<Node> builder(value);
+        sax_from_string(value, builder, this->recursion_limit);
+        this->callback(builder.result());
+    }
+
+    void emit_current_value(std::size_t value_end) {
+        this->reset_scanner(); // invalid value shouldn't prevent us from parsing the following ones
+        this->emit(std::string_view(this->buffer).substr(this->value_start, value_end - this->value_start));
+    }
+
+    // Scans the whole buffer, an invalid value doesn't stop the scan since the scanner is already past it,
+    // the first error gets returned to be rethrown once the following values were processed
+    [[nodiscard]] std::exception_ptr scan() {
+        std::exception_ptr error;
+
+        const auto try_emit = [&](std::size_t value_end) {
+            try {
+                this->emit_current_value(value_end);
+            } catch (...) {
+                if (!error) error = std::current_exception();
+            }
+        };
+
+        while (this->cursor < this->buffer.size()) {
+            const char c = this->buffer[this->cursor];
+
+            // Skip whitespace between the values, first significant symbol determines the kind of value
+            if (!this->in_value) {
+                if (!_lookup_whitespace_chars[_u8(c)]) {
+                    this->in_value    = true;
+                    this->value_start = this->cursor;
+
+                    if (c == '{' || c == '[') this->depth = 1;
+                    else if (c == '"') this->in_string = true;
+                    else this->in_scalar = true;
+                }
+                ++this->cursor;
+                continue;
+            }
+
+            // Scalars end right before the delimiter, which can be the start of the next value
+            if (this->in_scalar) {
+                if (is_delimiter(c)) try_emit(this->cursor);
+                else ++this->cursor;
+                continue;
+            }
+
+            ++this->cursor;
+
+            // Strings & containers end right after their closing symbol
+            if (this->in_string) {
+                if (this->escaped) this->escaped = false;
+                else if (c == '\\') this->escaped = true;
+                else if (c == '"') {
+                    this->in_string = false;
+                    if (this->depth == 0) try_emit(this->cursor);
+                }
+            } else if (c == '"') {
+                this->in_string = true;
+            } else if (c == '{' || c == '[') {
+                ++this->depth;
+            } else if (c == '}' || c == ']') {
+                if (--this->depth == 0) try_emit(this->cursor);
+                // mismatched brackets are left for the parser to report
+            }
+        }
+
+        return error;
+    }
+
+public:
+    explicit StreamParser(callback_type callback, unsigned int recursion_limit = _default_recursion_limit)
+        : callback(std::move(callback)), recursion_limit(recursion_limit) {}
+
+    void feed(std::string_view chunk) {
+        this->buffer += chunk;
+        const std::exception_ptr error = this->scan();
+
+        // Drop the input that was fully processed, this keeps the buffer bounded by the size of a single value
+        const std::size_t processed = this->in_value ? this->value_start : this->cursor;
+        this->buffer.erase(0, processed);
+        this->cursor -= processed;
+        if (this->in_value) this->value_start = 0;
+
+        if (error) std::rethrow_exception(error);
+    }
+
+    void finish() {
+        // Whatever remains must be a complete value, incomplete strings
+        // & containers will be rejected by the parser with a proper error
+        const std::string remaining   = std::move(this->buffer);
+        const bool        has_value   = this->in_value;
+        const std::size_t value_start = this->value_start;
+
+        this->buffer.clear();
+        this->cursor      = 0;
+        this->value_start = 0;
+        this->reset_scanner();
+
+        if (has_value) this->emit(std::string_view(remaining).substr(value_start));
+    }
+};
+
 namespace literals {
 [[nodiscard]] inline Node operator""_utl_json(const char* c_str, std::size_t c_str_size) {
     return from_string(std::string(c_str, c_str_size));
@@ -2335,6 +3455,108 @@ void _assign_value_to_node(Node& node, const T& value) {
 
 #define utl_json_from_struct_assign(fieldname_) _assign_value_to_node(json[#fieldname_], val.fieldname_);
 
+// --- direct serialization utils ---
+// ----------------------------------
+
+// 'from_struct(value).to_string()' builds a whole tree of nodes (with all the map insertions and string copies)
+// only to immediately throw it away after serializing. For reflected structs we know the layout at compile time,
+// which means fields can be written straight into the output buffer using the same formatting as the regular
+// serializer. Field names are identifiers and never need escaping, the macro bakes them into quoted literals.
+
+template <class T>
+struct _struct_serializer {
+    static_assert(_always_false_v<T>,
+                  "Provided type doesn't have a defined JSON reflection. Use 'UTL_JSON_REFLECT' macro to define one.");
+};
+// specializations that do the actual work are generated by 'UTL_JSON_REFLECT'
+
+constexpr std::size_t _indent_level_size = 4;
+
+template <bool prettify, class T>
+void _serialize_value(std::string& chars, const T& value, unsigned int indent_level) {
+    // same conversion priority as 'Node::operator=()': string > object > array > bool > null > numeric
+    if constexpr (is_string_like_v<T>) _serialize_string(chars, value);
+    else if constexpr (is_object_like_v<T>) {
+        if (value.begin() == value.end()) {
+            chars += "{}";
+            return;
+        }
+
+        chars += '{';
+        bool first = true;
+        for (const auto& [key, val] : value) {
+            if (!first) chars += ',';
+            first = false;
+            if constexpr (prettify) {
+                chars += '\n';
+                chars.append(_indent_level_size * (indent_level + 1), ' ');
+            }
+            _serialize_string(chars, key);
+            if constexpr (prettify) chars += ": ";
+            else chars += ':';
+            _serialize_value<prettify>(chars, val, indent_level + 1);
+        }
+        if constexpr (prettify) {
+            chars += '\n';
+            chars.append(_indent_level_size * indent_level, ' ');
+        }
+        chars += '}';
+    } else if constexpr (is_array_like_v<T>) {
+        if (value.begin() == value.end()) {
+            chars += "[]";
+            return;
+        }
+
+        chars += '[';
+        bool first = true;
+        for (const auto& elem : value) {
+            if (!first) chars += ',';
+            first = false;
+            if constexpr (prettify) {
+                chars += '\n';
+                chars.append(_indent_level_size * (indent_level + 1), ' ');
+            }
+            _serialize_value<prettify>(chars, elem, indent_level + 1);
+        }
+        if constexpr (prettify) {
+            chars += '\n';
+            chars.append(_indent_level_size * indent_level, ' ');
+        }
+        chars += ']';
+    } else if constexpr (is_bool_like_v<T>) chars += (value ? "true" : "false");
+    else if constexpr (is_null_like_v<T>) chars += "null";
+    else if constexpr (is_numeric_like_v<T>) _serialize_number(chars, static_cast<_number_type_impl>(value));
+    else if constexpr (_is_reflected_struct<T>)
+        _struct_serializer<T>::template serialize<prettify>(chars, value, indent_level);
+    else static_assert(_always_false_v<T>, "Could not resolve recursive conversion from 'T' to JSON.");
+}
+
+// 'key' is a pre-quoted literal like '"fieldname"'
+template <bool prettify, std::size_t N, class T>
+void _serialize_struct_field(std::string& chars, const char (&key)[N], const T& value, unsigned int indent_level,
+                             bool& first) {
+    if (!first) chars += ',';
+    first = false;
+    if constexpr (prettify) {
+        chars += '\n';
+        chars.append(_indent_level_size * (indent_level + 1), ' ');
+    }
+    chars.append(key, N - 1);
+    if constexpr (prettify) chars += ": ";
+    else chars += ':';
+    _serialize_value<prettify>(chars, value, indent_level + 1);
+}
+
+#define utl_json_serialize_struct_field(fieldname_)                                                                    \
+    utl::json::_serialize_struct_field<prettify>(chars, "\"" #fieldname_ "\"", val.fieldname_, indent_level, first);
+
+// Appends JSON serialized from 'value' to 'chars', the buffer can be reused between calls to avoid reallocation
+template <class T>
+void to_json_string(const T& value, std::string& chars, Format format = Format::PRETTY) {
+    if (format == Format::PRETTY) _serialize_value<true>(chars, value, 0);
+    else _serialize_value<false>(chars, value, 0);
+}
+
 // --- to-struct utils ---
 // -----------------------
 
@@ -2346,10 +3568,10 @@ template <class T>
 void _assign_node_to_value_recursively(T& value, const Node& node) {
     if constexpr (is_string_like_v<T>) value = node.get_string();
     else if constexpr (is_object_like_v<T>) {
-        const auto object = node.get_object();
+        const auto& object = node.get_object();
         for (const auto& [key, val] : object) _assign_node_to_value_recursively(value[key], val);
     } else if constexpr (is_array_like_v<T>) {
-        const auto array = node.get_array();
+        const auto& array = node.get_array();
         value.resize(array.size());
         for (std::size_t i = 0; i < array.size(); ++i) _assign_node_to_value_recursively(value[i], array[i]);
     } else if constexpr (is_bool_like_v<T>) value = node.get_bool();
@@ -2365,7 +3587,7 @@ template <class T, std::size_t N>
 void _assign_node_to_value_recursively(std::array<T, N>& value, const Node& node) {
     using namespace std::string_literals;
 
-    const auto array = node.get_array();
+    const auto& array = node.get_array();
 
     if (array.size() != value.size())
         throw std::runtime_error("JSON to structure serializer encountered non-mathing std::array size of "s +
@@ -2380,37 +3602,278 @@ void _assign_node_to_value_recursively(std::array<T, N>& value, const Node& node
 // JSON might not have an entry corresponding to each structure member,
 // such members will stay defaulted according to the struct constructor
 
-// --- Codegen ---
-// ---------------
+// --- direct parsing utils ---
+// ----------------------------
 
-#define UTL_JSON_REFLECT(struct_name_, ...)                                                                            \
-                                                                                                                       \
-    template <>                                                                                                        \
-    constexpr bool utl::json::_is_reflected_struct<struct_name_> = true;                                               \
-                                                                                                                       \
-    template <>                                                                                                        \
-    inline utl::json::Node utl::json::from_struct<struct_name_>(const struct_name_& val) {                             \
-        utl::json::Node json;                                                                                          \
-        /* map 'json["<FIELDNAME>"] = val.<FIELDNAME>;' */                                                             \
-        utl_json_map(utl_json_from_struct_assign, __VA_ARGS__);                                                        \
-        return json;                                                                                                   \
-    }                                                                                                                  \
-                                                                                                                       \
-    template <>                                                                                                        \
-    inline auto utl::json::Node::to_struct<struct_name_>() const->struct_name_ {                                       \
-        struct_name_ val;                                                                                              \
-        /* map 'val.<FIELDNAME> = this->at("<FIELDNAME>").get<decltype(val.<FIELDNAME>)>();' */                        \
-        utl_json_map(utl_json_to_struct_assign, __VA_ARGS__);                                                          \
-        return val;                                                                                                    \
-    }                                                                                                                  \
-                                                                                                                       \
-    static_assert(true)
+// 'from_string(chars).to_struct<T>()' parses the whole tree only to copy values out of it. Knowing the target
+// type lets us parse straight into it instead: known fields get parsed directly into the members, values
+// of unknown keys get validated & skipped by the regular SAX parser with a no-op handler.
 
+template <class T>
+struct _struct_deserializer {
+    static_assert(_always_false_v<T>,
+                  "Provided type doesn't have a defined JSON reflection. Use 'UTL_JSON_REFLECT' macro to define one.");
+};
+// specializations that do the actual work are generated by 'UTL_JSON_REFLECT'
 
-} // namespace utl::json
+struct _struct_parser {
+    SaxHandler              skipper; // handler for the values we don't need
+    _sax_parser<SaxHandler> parser;
 
-#endif
-#endif // module utl::json
+    _struct_parser(std::string_view chars, unsigned int recursion_limit) : parser(chars, recursion_limit, skipper) {}
+
+    [[noreturn]] void throw_type_error(std::size_t cursor, std::string_view expected) const {
+        using namespace std::string_literals;
+
+        throw std::runtime_error("JSON to structure parser encountered unexpected symbol {"s +
+                                 this->parser.chars[cursor] + "} at pos "s + std::to_string(cursor) + ", expected "s +
+                                 std::string(expected) + " value."s + _pretty_error(cursor, this->parser.chars));
+    }
+
+    // Calls 'parse_pair(cursor, key)' for every pair of the object starting at 'cursor'
+    template <class Func>
+    std::size_t parse_object(std::size_t cursor, Func&& parse_pair) {
+        using namespace std::string_literals;
+
+        if (this->parser.chars[cursor] != '{') this->throw_type_error(cursor, "object");
+        ++cursor; // move past the opening brace '{'
+
+        cursor = this->parser.skip_nonsignificant_whitespace(cursor);
+        if (this->parser.chars[cursor] == '}') return cursor + 1;
+
+        while (true) {
+            if (this->parser.chars[cursor] != '"')
+                throw std::runtime_error("JSON object node encountered unexpected symbol {"s +
+                                         this->parser.chars[cursor] + "} instead of the pair key at pos "s +
+                                         std::to_string(cursor) + "."s + _pretty_error(cursor, this->parser.chars));
+
+            std::string_view key;
+            std::tie(cursor, key) = this->parser.parse_string(cursor);
+            // 'key' may point into the reusable parser buffer, 'parse_pair()' has to use it before parsing the value
+
+            cursor = this->parser.skip_nonsignificant_whitespace(cursor);
+            if (this->parser.chars[cursor] != ':')
+                throw std::runtime_error("JSON object node encountered unexpected symbol {"s +
+                                         this->parser.chars[cursor] + "} after the pair key at pos "s +
+                                         std::to_string(cursor) + " (should be {:})."s +
+                                         _pretty_error(cursor, this->parser.chars));
+            ++cursor; // move past the colon ':'
+            cursor = this->parser.skip_nonsignificant_whitespace(cursor);
+
+            this->parser.enter_nested_node();
+            cursor = parse_pair(cursor, key);
+            this->parser.leave_nested_node();
+
+            cursor = this->parser.skip_nonsignificant_whitespace(cursor);
+            const char c = this->parser.chars[cursor];
+
+            if (c == '}') return cursor + 1;
+            if (c != ',')
+                throw std::runtime_error(
+                    "JSON object node could not find comma {,} or object ending symbol {}} after the element at pos "s +
+                    std::to_string(cursor) + "."s + _pretty_error(cursor, this->parser.chars));
+            ++cursor; // move past the comma ','
+            cursor = this->parser.skip_nonsignificant_whitespace(cursor);
+        }
+    }
+
+    // Calls 'parse_element(cursor, index)' for every element of the array starting at 'cursor'
+    template <class Func>
+    std::size_t parse_array(std::size_t cursor, Func&& parse_element) {
+        using namespace std::string_literals;
+
+        if (this->parser.chars[cursor] != '[') this->throw_type_error(cursor, "array");
+        ++cursor; // move past the opening bracket '['
+
+        cursor = this->parser.skip_nonsignificant_whitespace(cursor);
+        if (this->parser.chars[cursor] == ']') return cursor + 1;
+
+        for (std::size_t index = 0;; ++index) {
+            this->parser.enter_nested_node();
+            cursor = parse_element(cursor, index);
+            this->parser.leave_nested_node();
+
+            cursor       = this->parser.skip_nonsignificant_whitespace(cursor);
+            const char c = this->parser.chars[cursor];
+
+            if (c == ']') return cursor + 1;
+            if (c != ',')
+                throw std::runtime_error(
+                    "JSON array node could not find comma {,} or array ending symbol {]} after the element at pos "s +
+                    std::to_string(cursor) + "."s + _pretty_error(cursor, this->parser.chars));
+            ++cursor; // move past the comma ','
+            cursor = this->parser.skip_nonsignificant_whitespace(cursor);
+        }
+    }
+
+    // Parses value starting at 'cursor' into 'value', same conversions as '_assign_node_to_value_recursively()'
+    template <class T>
+    std::size_t parse_value(std::size_t cursor, T& value) {
+        const char c = this->parser.chars[cursor];
+
+        if constexpr (is_string_like_v<T>) {
+            if (c != '"') this->throw_type_error(cursor, "string");
+            std::string_view string_value;
+            std::tie(cursor, string_value) = this->parser.parse_string(cursor);
+            value                          = string_value;
+            return cursor;
+        } else if constexpr (is_object_like_v<T>) {
+            value.clear();
+            return this->parse_object(cursor, [&](std::size_t pair_cursor, std::string_view key) {
+                const auto [it, inserted] = value.try_emplace(typename T::key_type(key));
+                if (!inserted) return this->parser.parse_node(pair_cursor); // first duplicate wins, same as 'Node'
+                return this->parse_value(pair_cursor, it->second);
+            });
+        } else if constexpr (is_array_like_v<T>) {
+            value.clear();
+            return this->parse_array(cursor, [&](std::size_t element_cursor, std::size_t) {
+                return this->parse_value(element_cursor, value.emplace_back());
+            });
+        } else if constexpr (is_bool_like_v<T>) {
+            if (c == 't') std::tie(cursor, value) = this->parser.parse_true(cursor);
+            else if (c == 'f') std::tie(cursor, value) = this->parser.parse_false(cursor);
+            else this->throw_type_error(cursor, "bool");
+            return cursor;
+        } else if constexpr (is_null_like_v<T>) {
+            if (c != 'n') this->throw_type_error(cursor, "null");
+            std::tie(cursor, value) = this->parser.parse_null(cursor);
+            return cursor;
+        } else if constexpr (is_numeric_like_v<T>) {
+            if (!(('0' <= c && c <= '9') || (c == '-'))) this->throw_type_error(cursor, "number");
+            _number_type_impl number_value;
+            std::tie(cursor, number_value) = this->parser.parse_number(cursor);
+            value                          = static_cast<T>(number_value);
+            return cursor;
+        } else if constexpr (_is_reflected_struct<T>) {
+            std::array<bool, _struct_deserializer<T>::field_count> parsed_fields{};
+            return this->parse_object(cursor, [&](std::size_t pair_cursor, std::string_view key) {
+                std::size_t field_end = pair_cursor;
+                if (_struct_deserializer<T>::parse_field(*this, field_end, key, value, parsed_fields.data()))
+                    return field_end;
+                return this->parser.parse_node(pair_cursor); // skips unknown keys & repeated fields
+            });
+        } else static_assert(_always_false_v<T>, "Method is a non-exhaustive visitor of std::variant<>.");
+    }
+
+    // Not sure how to generically handle array-like types with compile-time known size,
+    // so we're just going to make a special case for 'std::array'
+    template <class T, std::size_t N>
+    std::size_t parse_value(std::size_t cursor, std::array<T, N>& value) {
+        using namespace std::string_literals;
+
+        std::size_t size = 0;
+        cursor = this->parse_array(cursor, [&](std::size_t element_cursor, std::size_t index) {
+            if (index >= N)
+                throw std::runtime_error("JSON to structure serializer encountered non-mathing std::array size of "s +
+                                         std::to_string(N) + ", corresponding node has more elements."s);
+            ++size;
+            return this->parse_value(element_cursor, value[index]);
+        });
+
+        if (size != N)
+            throw std::runtime_error("JSON to structure serializer encountered non-mathing std::array size of "s +
+                                     std::to_string(N) + ", corresponding node has a size of "s +
+                                     std::to_string(size) + "."s);
+
+        return cursor;
+    }
+};
+
+#define utl_json_declare_struct_field(fieldname_) char fieldname_;
+
+#define utl_json_parse_struct_field(fieldname_)                                                                        \
+    if (key == #fieldname_) {                                                                                          \
+        constexpr std::size_t field = offsetof(field_list, fieldname_);                                                \
+        if (parsed_fields[field]) return false; /* first duplicate wins, same as 'from_string().to_struct()' */        \
+        parsed_fields[field] = true;                                                                                   \
+        cursor               = parser.parse_value(cursor, val.fieldname_);                                             \
+        return true;                                                                                                   \
+    }
+
+// Parses JSON from 'chars' straight into a reflected struct, JSON keys that don't correspond
+// to any field are skipped, fields that have no corresponding key stay value-initialized
+template <class T>
+[[nodiscard]] T from_json_string(std::string_view chars, unsigned int recursion_limit = _default_recursion_limit) {
+    static_assert(_is_reflected_struct<T>,
+                  "Provided type doesn't have a defined JSON reflection. Use 'UTL_JSON_REFLECT' macro to define one.");
+
+    T              value{};
+    _struct_parser parser(chars, recursion_limit);
+
+    const std::size_t json_start = parser.parser.skip_nonsignificant_whitespace(0);
+    const std::size_t end_cursor = parser.parse_value(json_start, value);
+    parser.parser.check_trailing_symbols(end_cursor);
+
+    return value;
+}
+
+// --- Codegen ---
+// ---------------
+
+#define UTL_JSON_REFLECT(struct_name_, ...)                                                                            \
+                                                                                                                       \
+    template <>                                                                                                        \
+    constexpr bool utl::json::_is_reflected_struct<struct_name_> = true;                                               \
+                                                                                                                       \
+    template <>                                                                                                        \
+    inline utl::json::Node utl::json::from_struct<struct_name_>(const struct_name_& val) {                             \
+        utl::json::Node json;                                                                                          \
+        /* map 'json["<FIELDNAME>"] = val.<FIELDNAME>;' */                                                             \
+        utl_json_map(utl_json_from_struct_assign, __VA_ARGS__);                                                        \
+        return json;                                                                                                   \
+    }                                                                                                                  \
+                                                                                                                       \
+    template <>                                                                                                        \
+    template <>                                                                                                        \
+    inline auto utl::json::Node::to_struct<struct_name_>() const->struct_name_ {                                       \
+        struct_name_ val;                                                                                              \
+        /* map 'val.<FIELDNAME> = this->at("<FIELDNAME>").get<decltype(val.<FIELDNAME>)>();' */                        \
+        utl_json_map(utl_json_to_struct_assign, __VA_ARGS__);                                                          \
+        return val;                                                                                                    \
+    }                                                                                                                  \
+                                                                                                                       \
+    template <>                                                                                                        \
+    struct utl::json::_struct_deserializer<struct_name_> {                                                             \
+        /* one 'char' per field, offset of a member is the index of the corresponding field */                         \
+        struct field_list {                                                                                            \
+            utl_json_map(utl_json_declare_struct_field, __VA_ARGS__);                                                  \
+        };                                                                                                             \
+        constexpr static std::size_t field_count = sizeof(field_list);                                                 \
+                                                                                                                       \
+        static bool parse_field(utl::json::_struct_parser& parser, std::size_t& cursor, std::string_view key,          \
+                                struct_name_& val, bool* parsed_fields) {                                              \
+            /* map 'if (key == "<FIELDNAME>") { <parse into 'val.<FIELDNAME>'>; return true; }' */                     \
+            utl_json_map(utl_json_parse_struct_field, __VA_ARGS__);                                                    \
+            return false;                                                                                              \
+        }                                                                                                              \
+    };                                                                                                                 \
+                                                                                                                       \
+    template <>                                                                                                        \
+    struct utl::json::_struct_serializer<struct_name_> {                                                               \
+        template <bool prettify>                                                                                       \
+        static void serialize(std::string& chars, const struct_name_& val, unsigned int indent_level) {                \
+            bool first = true;                                                                                         \
+            chars += '{';                                                                                              \
+            /* map '_serialize_struct_field<prettify>(chars, "<FIELDNAME>", val.<FIELDNAME>, ...);' */                 \
+            utl_json_map(utl_json_serialize_struct_field, __VA_ARGS__);                                                \
+            if constexpr (prettify) {                                                                                  \
+                chars += '\n';                                                                                         \
+                chars.append(utl::json::_indent_level_size * indent_level, ' ');                                       \
+            }                                                                                                          \
+            chars += '}';                                                                                              \
+        }                                                                                                              \
+    };                                                                                                                 \
+                                                                                                                       \
+    static_assert(true)
+
+
+} // namespace utl::json
+
+#undef utl_json_simd_avx2
+#undef utl_json_simd_sse2
+
+#endif
+#endif // module utl::json
 
 
 
@@ -2432,29 +3895,38 @@ void _assign_node_to_value_recursively(std::array<T, N>& value, const Node& node
 
 // _______________________ INCLUDES _______________________
 
-#include <array>         // array<>
-#include <charconv>      // to_chars()
-#include <chrono>        // steady_clock
-#include <cstddef>       // size_t
-#include <exception>     // exception
-#include <fstream>       // ofstream
-#include <iostream>      // cout
-#include <iterator>      // next()
-#include <limits>        // numeric_limits<>
-#include <list>          // list<>
-#include <mutex>         // lock_guard<>, mutex
-#include <ostream>       // ostream
-#include <sstream>       // std::ostringstream
-#include <stdexcept>     // std::runtime_error
-#include <string>        // string
-#include <string_view>   // string_view
-#include <system_error>  // errc()
-#include <thread>        // this_thread::get_id()
-#include <tuple>         // tuple_size<>
-#include <type_traits>   // is_integral_v<>, is_floating_point_v<>, is_same_v<>, is_convertible_to_v<>
-#include <unordered_map> // unordered_map<>
-#include <utility>       // forward<>()
-#include <variant>       // variant<>
+#include <algorithm>          // min(), max(), find_if(), any_of(), remove_if()
+#include <array>              // array<>
+#include <atomic>             // atomic<>
+#include <charconv>           // to_chars()
+#include <chrono>             // steady_clock
+#include <condition_variable> // condition_variable
+#include <cstddef>            // size_t, ptrdiff_t
+#include <cstdint>            // uint32_t
+#include <cstring>            // memcpy(), memset()
+#include <ctime>              // time_t, time()
+#include <deque>              // deque<>
+#include <exception>          // exception
+#include <fstream>            // ofstream
+#include <future>             // promise<>
+#include <iostream>           // cout
+#include <iterator>           // next()
+#include <limits>             // numeric_limits<>
+#include <list>               // list<>
+#include <memory>             // unique_ptr<>, make_unique<>()
+#include <mutex>              // lock_guard<>, mutex
+#include <ostream>            // ostream
+#include <sstream>            // std::ostringstream
+#include <stdexcept>          // std::runtime_error
+#include <string>             // string
+#include <string_view>        // string_view
+#include <system_error>       // errc()
+#include <thread>             // thread, this_thread::yield()
+#include <tuple>              // tuple_size<>
+#include <type_traits>        // is_integral_v<>, is_floating_point_v<>, is_same_v<>, is_convertible_to_v<>
+#include <utility>            // forward<>(), move(), swap(), pair<>
+#include <variant>            // variant<>
+#include <vector>             // vector<>
 
 // ____________________ DEVELOPER DOCS ____________________
 
@@ -2475,7 +3947,15 @@ void _assign_node_to_value_recursively(std::array<T, N>& value, const Node& node
 //
 //       Note: I did try using a stripped down version of 'utl::parallel::ThreadPool' to upload tasks
 //             for flushing the buffer, it generally improves performance by ~30%, however I decided it
-//             is not worth the added complexity & cpu usage for that little gain
+//             is not worth the added complexity & cpu usage for that little gain.
+//
+//             This is now available as an opt-in async mode (see 'enable_async()'), producers stringify
+//             the message & push it into a lock-free ring, a background thread formats columns & does I/O.
+//             For multi-threaded logging into files the gain is a lot more noticeable than 30%, since
+//             producers no longer contend on the sink mutex while somebody else is stuck in 'write()'.
+//
+//             Deferred mode (see 'enable_deferred()') goes a step further & moves stringification off the calling
+//             thread as well, producers only copy raw argument bytes into a per-thread buffer.
 //
 //    3. Platform-specific methods to query stuff like time & thread id with less overhead
 //
@@ -2489,6 +3969,9 @@ void _assign_node_to_value_recursively(std::array<T, N>& value, const Node& node
 //       the individual sinks, I don't see a way of making style checks here constexpr, but in the end
 //       that would be a proper solution.
 //
+//       This is now mostly done, the logger queries time & thread only if some sink needs them, stringifies
+//       arguments once into a '_record' and sinks with identical decoration share a single formatted line.
+//
 
 // ____________________ IMPLEMENTATION ____________________
 
@@ -2511,17 +3994,12 @@ auto _available_localtime_impl(TimeMoment time_moment, TimeType timer)
     return localtime_r(std::forward<TimeType>(timer), std::forward<TimeMoment>(time_moment));
 }
 
-inline std::size_t _get_thread_index(const std::thread::id id) {
-    static std::mutex     mutex;
-    const std::lock_guard lock(mutex);
-
-    static std::unordered_map<std::thread::id, std::size_t> thread_ids;
-    static std::size_t                                      next_id = 0;
-
-    const auto it = thread_ids.find(id);
-    if (it == thread_ids.end()) return thread_ids[id] = next_id++;
-    return it->second;
-    // this map effectively "demangles" platform-specific IDs into human-readable IDs (0, 1, 2, ...)
+// Effectively "demangles" platform-specific thread IDs into human-readable IDs (0, 1, 2, ...) in the order
+// of first use, each thread only touches the shared counter once & then reads its own 'thread_local' copy
+inline std::size_t _get_thread_index() noexcept {
+    static std::atomic<std::size_t> next_index{0};
+    thread_local const std::size_t  index = next_index.fetch_add(1, std::memory_order_relaxed);
+    return index;
 }
 
 template <class IntType, std::enable_if_t<std::is_integral<IntType>::value, bool> = true>
@@ -2962,6 +4440,18 @@ struct MessageMetadata {
     Verbosity verbosity;
 };
 
+// Everything needed to format a message, captured once on the calling thread & shared by all sinks
+struct _record {
+    Callsite          callsite{};
+    Verbosity         verbosity = Verbosity::TRACE;
+    clock::time_point now{};
+    std::time_t       time   = 0;
+    std::size_t       thread = 0;
+    std::string       message; // stringified arguments, without column delimiters
+
+    std::promise<void>* flushed = nullptr; // set for 'flush()' barriers, which carry no message
+};
+
 constexpr bool operator<(Verbosity l, Verbosity r) { return static_cast<int>(l) < static_cast<int>(r); }
 constexpr bool operator<=(Verbosity l, Verbosity r) { return static_cast<int>(l) <= static_cast<int>(r); }
 
@@ -3056,6 +4546,16 @@ constexpr std::string_view _color_err   = color::bold_red;
 // --- Sink class ---
 // ==================
 
+// Highest verbosity accepted by any sink, lets logging macros reject a message before evaluating its arguments.
+// Recomputed every time sinks or their verbosity change, default sink accepts everything.
+inline std::atomic<Verbosity> _max_verbosity{Verbosity::TRACE};
+
+inline void _update_max_verbosity();
+
+[[nodiscard]] inline bool _is_enabled(Verbosity verbosity) noexcept {
+    return verbosity <= _max_verbosity.load(std::memory_order_relaxed);
+}
+
 class Sink {
 private:
     using os_ref_wrapper = std::reference_wrapper<std::ostream>;
@@ -3092,6 +4592,7 @@ class Sink {
     // We want a way of changing sink options using its handle / reference returned by the logger
     Sink& set_verbosity(Verbosity verbosity) {
         this->verbosity = verbosity;
+        _update_max_verbosity();
         return *this;
     }
     Sink& set_colors(Colors colors) {
@@ -3111,41 +4612,29 @@ class Sink {
         return *this;
     }
 
-private:
-    template <class... Args>
-    void format(const Callsite& callsite, const MessageMetadata& meta, const Args&... args) {
-        if (meta.verbosity > this->verbosity) return;
-
-        thread_local std::string buffer;
-
-        const clock::time_point now = clock::now();
-
-        // To minimize logging overhead we use string buffer, append characters to it and then write the whole buffer
-        // to `std::ostream`. This avoids the inherent overhead of ostream formatting (caused largely by
-        // virtualization, syncronization and locale handling, neither of which are relevant for the logger).
-        //
-        // This buffer gets reused between calls. Note the 'thread_local', if buffer was just a class member, multiple
-        // threads could fight trying to clear and resize the buffer while it's being written to by another thread.
-        //
-        // Buffer may grow when formatting a message longer that any one that was formatted before, otherwise we just
-        // reuse the reserved memory and no new allocations take place.
-
-        buffer.clear();
+    void flush() {
+        const std::lock_guard ostream_lock(this->ostream_mutex);
+        this->ostream_ref().flush();
+    }
 
-        // Print log header on the first call
-        {
-            static std::mutex     header_mutex;
-            const std::lock_guard lock(header_mutex);
-            if (this->print_header) {
-                this->print_header = false;
-                this->format_header(buffer);
-            }
-            // no need to lock the buffer, other threads can't reach buffer
-            // output code while they're stuck waiting for the header to print
-        }
+private:
+    // Sinks with the same decoration produce identical lines & can share the formatted result
+    [[nodiscard]] bool same_decoration(const Sink& other) const noexcept {
+        const Columns& l = this->columns;
+        const Columns& r = other.columns;
+        return this->colors == other.colors && l.datetime == r.datetime && l.uptime == r.uptime &&
+               l.thread == r.thread && l.callsite == r.callsite && l.level == r.level && l.message == r.message;
+    }
 
+    // Decorates a message that was already captured & stringified by the logger, the same line can then be written
+    // to every sink with the same decoration.
+    //
+    // To minimize logging overhead we use string buffer, append characters to it and then write the whole buffer
+    // to `std::ostream`. This avoids the inherent overhead of ostream formatting (caused largely by
+    // virtualization, syncronization and locale handling, neither of which are relevant for the logger).
+    void format_line(std::string& buffer, const _record& record) const {
         // Format columns one-by-one
-        if (this->colors == Colors::ENABLE) switch (meta.verbosity) {
+        if (this->colors == Colors::ENABLE) switch (record.verbosity) {
             case Verbosity::ERR: buffer += _color_err; break;
             case Verbosity::WARN: buffer += _color_warn; break;
             case Verbosity::NOTE: buffer += _color_note; break;
@@ -3154,19 +4643,30 @@ class Sink {
             case Verbosity::TRACE: buffer += _color_trace; break;
             }
 
-        if (this->columns.datetime) this->format_column_datetime(buffer);
-        if (this->columns.uptime) this->format_column_uptime(buffer, now);
-        if (this->columns.thread) this->format_column_thread(buffer);
-        if (this->columns.callsite) this->format_column_callsite(buffer, callsite);
-        if (this->columns.level) this->format_column_level(buffer, meta.verbosity);
-        if (this->columns.message) this->format_column_message(buffer, args...);
+        if (this->columns.datetime) this->format_column_datetime(buffer, record.time);
+        if (this->columns.uptime) this->format_column_uptime(buffer, record.now);
+        if (this->columns.thread) this->format_column_thread(buffer, record.thread);
+        if (this->columns.callsite) this->format_column_callsite(buffer, record.callsite);
+        if (this->columns.level) this->format_column_level(buffer, record.verbosity);
+        if (this->columns.message) this->format_column_message(buffer, record.message);
 
         if (this->colors == Colors::ENABLE) buffer += _color_reset;
+    }
 
+    void write(const std::string& buffer, clock::time_point now) {
         // 'std::ostream' isn't guaranteed to be thread-safe, even through many implementations seem to have
         // some thread-safety built into `std::cout` the same cannot be said about a generic 'std::ostream'
         const std::lock_guard ostream_lock(this->ostream_mutex);
 
+        // Print log header on the first call, this only happens once so allocating a string here is fine
+        if (this->print_header) {
+            this->print_header = false;
+
+            std::string header;
+            this->format_header(header);
+            this->ostream_ref().write(header.data(), header.size());
+        }
+
         this->ostream_ref().write(buffer.data(), buffer.size());
 
         // flush every message immediately
@@ -3180,7 +4680,7 @@ class Sink {
         }
     }
 
-    void format_header(std::string& buffer) {
+    void format_header(std::string& buffer) const {
         if (this->colors == Colors::ENABLE) buffer += _color_heading;
         if (this->columns.datetime)
             append_stringified(buffer, _col_ld_datetime, PadRight{"date       time", _col_w_datetime},
@@ -3197,24 +4697,25 @@ class Sink {
         if (this->colors == Colors::ENABLE) buffer += _color_reset;
     }
 
-    void format_column_datetime(std::string& buffer) {
-        std::time_t timer = std::time(nullptr);
-        std::tm     time_moment{};
-
-        _available_localtime_impl(&time_moment, &timer);
+    void format_column_datetime(std::string& buffer, std::time_t timer) const {
+        // Date & time only change once a second, while 'localtime()' & 'strftime()' are rather slow (and might
+        // even lock on some platforms), so each thread keeps the last formatted value around and reuses it
+        thread_local std::time_t                            cached_timer = -1;
+        thread_local std::array<char, _col_w_datetime + 1> cached_datetime{}; // +1 for null added by 'strftime()'
 
-        // Format time straight into the buffer
-        std::array<char, _col_w_datetime + 1>
-            strftime_buffer; // size includes the null terminator added by 'strftime()'
-        std::strftime(strftime_buffer.data(), strftime_buffer.size(), "%Y-%m-%d %H:%M:%S", &time_moment);
+        if (timer != cached_timer) {
+            std::tm time_moment{};
+            _available_localtime_impl(&time_moment, &timer);
+            std::strftime(cached_datetime.data(), cached_datetime.size(), "%Y-%m-%d %H:%M:%S", &time_moment);
+            cached_timer = timer;
+        }
 
-        // strftime_buffer.back() = ' '; // replace null-terminator added by 'strftime()' with a space
         buffer += _col_ld_datetime;
-        buffer.append(strftime_buffer.data(), _col_w_datetime);
+        buffer.append(cached_datetime.data(), _col_w_datetime);
         buffer += _col_rd_datetime;
     }
 
-    void format_column_uptime(std::string& buffer, clock::time_point now) {
+    void format_column_uptime(std::string& buffer, clock::time_point now) const {
         const auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - _program_entry_time_point);
         const auto sec        = (elapsed_ms / 1000).count();
         const auto ms         = (elapsed_ms % 1000).count(); // is 'elapsed_ms - 1000 * full_seconds; faster?
@@ -3237,19 +4738,39 @@ class Sink {
         buffer += _col_rd_uptime;
     }
 
-    void format_column_thread(std::string& buffer) {
-        const auto thread_id       = _get_thread_index(std::this_thread::get_id());
-        const auto thread_id_width = _integer_digit_count(thread_id);
+    void format_column_thread(std::string& buffer, std::size_t thread_id) const {
+        // Thread index never changes for a given thread, so unless the records come from different threads
+        // (which only happens in async mode) the padded column can be reused as is
+        thread_local std::size_t cached_thread_id = std::size_t(-1);
+        thread_local std::string cached_column;
+
+        if (thread_id != cached_thread_id) {
+            const auto thread_id_width = _integer_digit_count(thread_id);
 
-        buffer += _col_ld_thread;
-        if (thread_id_width < _col_w_thread) buffer.append(_col_w_thread - thread_id_width, ' ');
-        append_stringified(buffer, thread_id);
-        buffer += _col_rd_thread;
+            cached_column.clear();
+            cached_column += _col_ld_thread;
+            if (thread_id_width < _col_w_thread) cached_column.append(_col_w_thread - thread_id_width, ' ');
+            append_stringified(cached_column, thread_id);
+            cached_column += _col_rd_thread;
+            cached_thread_id = thread_id;
+        }
+
+        buffer += cached_column;
     }
 
-    void format_column_callsite(std::string& buffer, const Callsite& callsite) {
+    void format_column_callsite(std::string& buffer, const Callsite& callsite) const {
+        // '__FILE__' of the same file is usually the same literal, which lets us skip the search for the last
+        // separator when consecutive messages come from the same file (which they usually do)
+        thread_local std::string_view cached_file;
+        thread_local std::string_view cached_filename;
+
+        if (callsite.file.data() != cached_file.data() || callsite.file.size() != cached_file.size()) {
+            cached_file     = callsite.file;
+            cached_filename = callsite.file.substr(callsite.file.find_last_of("/\\") + 1);
+        }
+
         // Get just filename from the full path
-        std::string_view filename = callsite.file.substr(callsite.file.find_last_of("/\\") + 1);
+        std::string_view filename = cached_filename;
 
         // Left-pad callsite to column width, trim first characters if it's too long
         if (filename.size() < _w_callsite_before_dot) buffer.append(_w_callsite_before_dot - filename.size(), ' ');
@@ -3264,7 +4785,7 @@ class Sink {
         buffer += _col_rd_callsite;
     }
 
-    void format_column_level(std::string& buffer, Verbosity level) {
+    void format_column_level(std::string& buffer, Verbosity level) const {
         buffer += _col_ld_level;
         switch (level) {
         case Verbosity::ERR: buffer += "  ERR"; break;
@@ -3277,3385 +4798,4855 @@ class Sink {
         buffer += _col_rd_level;
     }
 
-    template <class... Args>
-    void format_column_message(std::string& buffer, const Args&... args) {
+    void format_column_message(std::string& buffer, std::string_view message) const {
         buffer += _col_ld_message;
-        append_stringified(buffer, args...);
+        buffer += message;
         buffer += _col_rd_message;
     }
 };
 
-// ====================
-// --- Logger class ---
-// ====================
+// =====================
+// --- Async backend ---
+// =====================
 
-struct _logger {
-    inline static std::list<Sink> sinks;
-    // we use list<> because we don't want sinks to ever reallocate when growing / shrinking
-    // (reallocation requires a move-constructor, which 'std::mutex' doesn't have),
-    // the added overhead of iterating a list is negligible
+// What producers do when the async queue is full:
+//    - 'BLOCK' - wait until the background thread frees up some space, no messages are lost
+//    - 'DROP'  - discard the message & count it, logging never waits
+//    - 'GROW'  - spill into an unbounded mutex-protected queue, logging never waits & no messages are lost,
+//                but memory usage is unbounded if producers are consistently faster than the sinks
+enum class Overflow { BLOCK, DROP, GROW };
 
-    static inline Sink default_sink{std::cout, Verbosity::TRACE, Colors::ENABLE, std::chrono::milliseconds(0),
-                                    Columns{}};
+constexpr std::size_t default_async_capacity = 8192;
 
-    static _logger& instance() {
-        static _logger logger;
-        return logger;
-    }
+constexpr std::size_t _cache_line_size = 64;
 
-    template <class... Args>
-    void push_message(const Callsite& callsite, const MessageMetadata& meta, const Args&... args) {
-        // When no sinks were manually created, default sink-to-terminal takes over
-        if (this->sinks.empty()) {
-            // static Sink default_sink(std::cout, Verbosity::TRACE, Colors::ENABLE, ms(0), Columns{});
-            default_sink.format(callsite, meta, args...);
-        } else
-            for (auto& sink : this->sinks) sink.format(callsite, meta, args...);
-    }
-};
+// Bounded lock-free MPSC ring, a simplified version of Dmitry Vyukov's bounded MPMC queue.
+//
+// Every cell carries a sequence number that tells whose turn it is: 'pos' means free for the producer that
+// claims position 'pos', 'pos + 1' means filled & ready for the consumer. Producers claim positions with a CAS,
+// there is a single consumer so its position is a plain integer.
+//
+// Records are swapped in & out rather than moved, this way cells, producers & the consumer keep trading string
+// buffers with already reserved capacity and the steady state doesn't allocate at all.
+class _mpsc_ring {
+private:
+    struct alignas(_cache_line_size) Cell {
+        std::atomic<std::size_t> sequence;
+        _record                  record;
+    };
 
-// =======================
-// --- Sink public API ---
-// =======================
+    std::unique_ptr<Cell[]> cells;
+    std::size_t             mask;
 
-inline Sink& add_ostream_sink(std::ostream&   os,                                           //
-                              Verbosity       verbosity      = Verbosity::INFO,             //
-                              Colors          colors         = Colors::ENABLE,              //
-                              clock::duration flush_interval = std::chrono::milliseconds{}, //
-                              const Columns&  columns        = Columns{}                    //
-) {
-    return _logger::instance().sinks.emplace_back(os, verbosity, colors, flush_interval, columns);
-}
+    alignas(_cache_line_size) std::atomic<std::size_t> enqueue_pos{0};
+    alignas(_cache_line_size) std::size_t dequeue_pos = 0; // only touched by the consumer
 
-inline Sink& add_file_sink(const std::string& filename,                                       //
-                           OpenMode           open_mode      = OpenMode::REWRITE,             //
-                           Verbosity          verbosity      = Verbosity::TRACE,              //
-                           Colors             colors         = Colors::DISABLE,               //
-                           clock::duration    flush_interval = std::chrono::milliseconds{15}, //
-                           const Columns&     columns        = Columns{}                      //
-) {
-    const auto ios_open_mode = (open_mode == OpenMode::APPEND) ? std::ios::out | std::ios::app : std::ios::out;
-    return _logger::instance().sinks.emplace_back(std::ofstream(filename, ios_open_mode), verbosity, colors,
-                                                  flush_interval, columns);
-}
+public:
+    explicit _mpsc_ring(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity) size *= 2; // power of 2 sizes allow indexing with a mask
 
-// ======================
-// --- Logging macros ---
-// ======================
+        this->cells = std::make_unique<Cell[]>(size);
+        this->mask  = size - 1;
+        for (std::size_t i = 0; i < size; ++i) this->cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
 
-#define UTL_LOG_ERR(...)                                                                                               \
-    utl::log::_logger::instance().push_message({__FILE__, __LINE__}, {utl::log::Verbosity::ERR}, __VA_ARGS__)
+    // On success 'record' receives an old record with unspecified contents, on failure it's left untouched
+    bool try_push(_record& record) {
+        std::size_t pos = this->enqueue_pos.load(std::memory_order_relaxed);
 
-#define UTL_LOG_WARN(...)                                                                                              \
-    utl::log::_logger::instance().push_message({__FILE__, __LINE__}, {utl::log::Verbosity::WARN}, __VA_ARGS__)
+        while (true) {
+            Cell&             cell     = this->cells[pos & this->mask];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto        diff     = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+
+            if (diff == 0) {
+                // 'seq_cst' pairs with the consumer going to sleep, see '_async_backend::consumer_main()'
+                if (this->enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_seq_cst,
+                                                            std::memory_order_relaxed)) {
+                    std::swap(cell.record, record);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) return false; // cell still holds a record from the previous lap => queue is full
+            else pos = this->enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
 
-#define UTL_LOG_NOTE(...)                                                                                              \
-    utl::log::_logger::instance().push_message({__FILE__, __LINE__}, {utl::log::Verbosity::NOTE}, __VA_ARGS__)
+    // On success 'record' receives the oldest record, old contents of 'record' go back into the cell
+    bool try_pop(_record& record) {
+        Cell& cell = this->cells[this->dequeue_pos & this->mask];
+        if (cell.sequence.load(std::memory_order_acquire) != this->dequeue_pos + 1) return false;
 
-#define UTL_LOG_INFO(...)                                                                                              \
-    utl::log::_logger::instance().push_message({__FILE__, __LINE__}, {utl::log::Verbosity::INFO}, __VA_ARGS__)
+        std::swap(cell.record, record);
+        cell.sequence.store(this->dequeue_pos + this->mask + 1, std::memory_order_release);
+        ++this->dequeue_pos;
+        return true;
+    }
 
-#define UTL_LOG_DEBUG(...)                                                                                             \
-    utl::log::_logger::instance().push_message({__FILE__, __LINE__}, {utl::log::Verbosity::DEBUG}, __VA_ARGS__)
+    // Also true while some position is claimed but its record isn't published yet, consumer only
+    [[nodiscard]] bool empty() const { return this->enqueue_pos.load(std::memory_order_seq_cst) == this->dequeue_pos; }
+};
 
-#define UTL_LOG_TRACE(...)                                                                                             \
-    utl::log::_logger::instance().push_message({__FILE__, __LINE__}, {utl::log::Verbosity::TRACE}, __VA_ARGS__)
+// Writes record to the sinks, or flushes them if the record is a 'flush()' barrier, defined after the logger
+inline void _process_record(_record& record);
 
-#ifdef _DEBUG
-#define UTL_LOG_DERR(...) UTL_LOG_ERR(__VA_ARGS__)
-#define UTL_LOG_DWARN(...) UTL_LOG_WARN(__VA_ARGS__)
-#define UTL_LOG_DNOTE(...) UTL_LOG_NOTE(__VA_ARGS__)
-#define UTL_LOG_DINFO(...) UTL_LOG_INFO(__VA_ARGS__)
-#define UTL_LOG_DDEBUG(...) UTL_LOG_DEBUG(__VA_ARGS__)
-#define UTL_LOG_DTRACE(...) UTL_LOG_TRACE(__VA_ARGS__)
-#else
-#define UTL_LOG_DERR(...)
-#define UTL_LOG_DWARN(...)
-#define UTL_LOG_DNOTE(...)
-#define UTL_LOG_DINFO(...)
-#define UTL_LOG_DDEBUG(...)
-#define UTL_LOG_DTRACE(...)
-#endif
+class _async_backend {
+private:
+    _mpsc_ring ring;
+    Overflow   overflow;
 
+    std::mutex          overflow_mutex;
+    std::deque<_record> overflow_queue;     // used by 'Overflow::GROW' once the ring is full
+    std::atomic<bool>   overflowing{false}; // while set, producers bypass the ring so messages stay in order
 
-} // namespace utl::log
+    std::atomic<std::size_t> dropped{0}; // used by 'Overflow::DROP'
 
-#endif
-#endif // module utl::log
+    std::mutex              wake_mutex;
+    std::condition_variable wake_cv;
+    std::atomic<bool>       consumer_sleeping{false}; // lets producers skip notification while consumer is awake
+    std::atomic<bool>       stopping{false};
 
+    std::thread consumer;
 
+    void wake_consumer() {
+        if (!this->consumer_sleeping.load(std::memory_order_seq_cst)) return;
+        { const std::lock_guard wake_lock(this->wake_mutex); }
+        this->wake_cv.notify_one();
+    }
 
+    // Overflow queue only contains messages newer than the ones in the ring, which is why we drain the ring first,
+    // producers keep bypassing the ring until the overflow queue is empty, which keeps per-thread message order
+    void drain_overflow(_record& record) {
+        std::deque<_record> batch;
+        {
+            const std::lock_guard overflow_lock(this->overflow_mutex);
+            batch.swap(this->overflow_queue);
+        }
 
+        while (this->ring.try_pop(record)) _process_record(record);
+        for (auto& overflow_record : batch) _process_record(overflow_record);
 
+        const std::lock_guard overflow_lock(this->overflow_mutex);
+        if (this->overflow_queue.empty()) this->overflowing.store(false, std::memory_order_seq_cst);
+    }
 
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-//
-// Module:        utl::math
-// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_math.md
-// Source repo:   https://github.com/DmitriBogdanov/UTL
-//
-// This project is licensed under the MIT License
-//
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    void consumer_main() {
+        _record record;
 
-#if !defined(UTL_PICK_MODULES) || defined(UTLMODULE_MATH)
-#ifndef UTLHEADERGUARD_MATH
-#define UTLHEADERGUARD_MATH
+        while (true) {
+            bool worked = false;
 
-// _______________________ INCLUDES _______________________
+            while (this->ring.try_pop(record)) {
+                _process_record(record);
+                worked = true;
+            }
 
-#include <algorithm>        // sort(), is_permutation(), reverse()
-#include <cassert>          // assert()
-#include <cmath>            // cos
-#include <cstddef>          // size_t
-#include <initializer_list> // initializer_list<>
-#include <tuple>            // get<>(), tuple_size_v<>, apply<>()
-#include <type_traits>      // enable_if_t<>, is_floating_point<>, is_arithmetic<>, conditional_t<>, is_integral<>, ...
-#include <utility>          // declval<>(), move(), forward<>()
-#include <vector>           // vector<>
+            if (this->overflowing.load(std::memory_order_seq_cst)) {
+                this->drain_overflow(record);
+                worked = true;
+            }
 
-// ____________________ DEVELOPER DOCS ____________________
+            if (worked) continue;
 
-// With C++20 following functions will be added into the standard:
-// - midpoint()
+            if (!this->ring.empty()) { // some producer claimed a cell but hasn't filled it yet
+                std::this_thread::yield();
+                continue;
+            }
 
-// ____________________ IMPLEMENTATION ____________________
+            if (this->stopping) break; // everything is written at this point
 
-namespace utl::math {
-
-// ============================
-// --- Implementation Utils ---
-// ============================
-
-// Make SFINAE a bit nicer
-template <bool Cond>
-using _require = std::enable_if_t<Cond, bool>; // makes SFINAE a bit less cumbersome
-
-template <class T>
-using _require_arithmetic = _require<std::is_arithmetic_v<T>>;
+            // Producers publish with a 'seq_cst' CAS & then check 'consumer_sleeping', we set 'consumer_sleeping'
+            // & then check the ring, so either the producer sees us sleeping, or we see its message
+            std::unique_lock wake_lock(this->wake_mutex);
+            this->consumer_sleeping.store(true, std::memory_order_seq_cst);
+            this->wake_cv.wait(wake_lock, [&] {
+                return this->stopping || !this->ring.empty() || this->overflowing.load(std::memory_order_seq_cst);
+            });
+            this->consumer_sleeping.store(false, std::memory_order_seq_cst);
+        }
+    }
 
-template <class T>
-using _require_integral = _require<std::is_integral_v<T>>;
+public:
+    _async_backend(std::size_t capacity, Overflow overflow) : ring(capacity), overflow(overflow) {
+        this->consumer = std::thread(&_async_backend::consumer_main, this);
+    }
 
-template <class T>
-using _require_uint = _require<std::is_integral_v<T> && std::is_unsigned_v<T>>;
+    _async_backend(const _async_backend&) = delete;
+    _async_backend(_async_backend&&)      = delete;
 
-template <class T>
-using _require_float = _require<std::is_floating_point_v<T>>;
+    ~_async_backend() {
+        {
+            const std::lock_guard wake_lock(this->wake_mutex);
+            this->stopping = true;
+        }
+        this->wake_cv.notify_one();
+        this->consumer.join(); // consumer drains the queue before exiting
+    }
 
-template <class Return, class T, class... Args>
-using _require_invocable_r = _require<std::is_invocable_r_v<Return, T, Args...>>;
+    // On return 'record' holds an old record with unspecified contents, which lets the caller reuse its buffer
+    void push(_record& record) {
+        if (this->overflow == Overflow::GROW) {
+            if (this->overflowing.load(std::memory_order_acquire) || !this->ring.try_push(record)) {
+                const std::lock_guard overflow_lock(this->overflow_mutex);
+                this->overflowing.store(true, std::memory_order_seq_cst);
+                this->overflow_queue.push_back(std::move(record));
+            }
+            this->wake_consumer();
+            return;
+        }
 
-template <class T, class... Args>
-using _require_invocable = _require<std::is_invocable_v<T, Args...>>;
+        const bool droppable = (this->overflow == Overflow::DROP) && !record.flushed; // barriers can't be lost
 
-// ===================
-// --- Type Traits ---
-// ===================
+        while (!this->ring.try_push(record)) {
+            if (droppable) {
+                this->dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            this->wake_consumer();
+            std::this_thread::yield();
+        }
+        this->wake_consumer();
+    }
 
-#define utl_math_define_trait(trait_name_, ...)                                                                        \
-    template <class T, class = void>                                                                                   \
-    struct trait_name_ : std::false_type {};                                                                           \
-                                                                                                                       \
-    template <class T>                                                                                                 \
-    struct trait_name_<T, std::void_t<decltype(__VA_ARGS__)>> : std::true_type {};                                     \
-                                                                                                                       \
-    template <class T>                                                                                                 \
-    constexpr bool trait_name_##_v = trait_name_<T>::value;
+    [[nodiscard]] std::size_t get_dropped_count() const { return this->dropped.load(std::memory_order_relaxed); }
+};
 
-utl_math_define_trait(has_size, std::declval<T>().size());
-utl_math_define_trait(has_capacity, std::declval<T>().capacity());
-utl_math_define_trait(has_data, std::declval<T>().data());
-utl_math_define_trait(has_value_type, std::declval<typename T::value_type>());
-utl_math_define_trait(has_node_type, std::declval<typename T::node_type>());
-utl_math_define_trait(has_allocator_type, std::declval<typename T::allocator_type>());
-utl_math_define_trait(has_tuple_size, std::tuple_size<T>::value);
-utl_math_define_trait(has_get, std::get<0>(std::declval<T>()));
+// ========================
+// --- Deferred backend ---
+// ========================
 
-#undef utl_math_define_trait
+// NanoLog-style logging: producers don't stringify anything, they copy raw argument bytes into a per-thread
+// buffer together with a pointer to a decoder instantiated for that exact list of argument types. Background
+// thread later decodes the bytes, stringifies them with the same stringifier & passes the result to the sinks,
+// which makes the output identical to the regular mode.
+//
+// Only arithmetic types & strings are stored as raw bytes, messages with any other arguments (containers, tuples,
+// padding wrappers & etc.) are stringified on the calling thread & stored as a single string.
 
-// =================
-// --- Constants ---
-// =================
+constexpr std::size_t default_deferred_buffer_size = 1 << 20; // per thread
 
-namespace constants {
+using _deferred_decoder = void (*)(const char* data, std::string& message);
 
-constexpr double pi      = 3.14159265358979323846;
-constexpr double two_pi  = 2. * pi;
-constexpr double half_pi = 0.5 * pi;
-constexpr double e       = 2.71828182845904523536;
-constexpr double phi     = 1.6180339887498948482; // golden ration
+// Header of every entry in the buffer, copied with 'memcpy()' so entries don't need any alignment
+struct _deferred_header {
+    std::uint32_t       size; // of the whole entry, including the header, 0 marks padding until the end of buffer
+    Verbosity           verbosity;
+    Callsite            callsite;
+    clock::rep          now;
+    _deferred_decoder   decode;  // null for 'flush()' barriers
+    std::promise<void>* flushed; // only for barriers
+};
 
-} // namespace constants
+template <class T>
+constexpr bool _is_deferred_string_v =
+    std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+    std::is_same_v<std::decay_t<T>, const char*> || std::is_same_v<std::decay_t<T>, char*>;
 
-// =======================
-// --- Basic functions ---
-// =======================
+template <class T>
+constexpr bool _is_deferrable_v = std::is_arithmetic_v<T> || _is_deferred_string_v<T>;
 
-template <class T, _require_arithmetic<T> = true>
-[[nodiscard]] constexpr T abs(T x) noexcept {
-    return (x > T(0)) ? x : -x;
+// Arithmetic values are stored as is, strings as a 32-bit length followed by characters
+template <class T>
+auto _to_deferred(const T& arg) {
+    if constexpr (std::is_arithmetic_v<T>) return arg;
+    else return std::string_view(arg);
 }
 
-template <class T, _require_arithmetic<T> = true>
-[[nodiscard]] constexpr T sign(T x) noexcept {
-    if constexpr (std::is_unsigned_v<T>) return (x > T(0)) ? T(1) : T(0);
-    else return (x > T(0)) ? T(1) : (x < T(0)) ? T(-1) : T(0);
-} // returns -1 / 0 / 1
-
-template <class T, _require_arithmetic<T> = true>
-[[nodiscard]] constexpr T bsign(T x) noexcept {
-    if constexpr (std::is_unsigned_v<T>) return T(1);
-    else return (x >= T(0)) ? T(1) : T(-1);
-} // returns -1 / 1 (1 gets priority in x == 0)
-
-template <class T, _require_arithmetic<T> = true>
-[[nodiscard]] constexpr T sqr(T x) noexcept {
-    return x * x;
+template <class T>
+std::size_t _deferred_size(const T& value) {
+    if constexpr (std::is_arithmetic_v<T>) return sizeof(T);
+    else return sizeof(std::uint32_t) + value.size();
 }
 
-template <class T, _require_arithmetic<T> = true>
-[[nodiscard]] constexpr T cube(T x) noexcept {
-    return x * x * x;
+template <class T>
+void _write_deferred(char*& data, const T& value) {
+    if constexpr (std::is_arithmetic_v<T>) {
+        std::memcpy(data, &value, sizeof(T));
+        data += sizeof(T);
+    } else {
+        const auto length = static_cast<std::uint32_t>(value.size());
+        std::memcpy(data, &length, sizeof(length));
+        std::memcpy(data + sizeof(length), value.data(), length);
+        data += sizeof(length) + length;
+    }
 }
 
-template <class T, _require_arithmetic<T> = true>
-[[nodiscard]] constexpr T inv(T x) noexcept {
-    return 1. / x; // integers will be cast to float then rounded
+template <class T>
+T _read_deferred(const char*& data) {
+    if constexpr (std::is_arithmetic_v<T>) {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        data += sizeof(T);
+        return value;
+    } else {
+        std::uint32_t length = 0;
+        std::memcpy(&length, data, sizeof(length));
+        const std::string_view value(data + sizeof(length), length);
+        data += sizeof(length) + length;
+        return value;
+    }
 }
 
-template <class T, _require_arithmetic<T> = true>
-[[nodiscard]] constexpr T pow(T x, std::size_t p) noexcept {
-    if (p == 0) return T(1);
-    if (p == 1) return x;
-    const T half_pow = pow(x, p / 2);
-    return (p % 2 == 0) ? half_pow * half_pow : half_pow * half_pow * x;
+template <class... Values>
+void _decode_deferred(const char* data, std::string& message) {
+    (append_stringified(message, _read_deferred<Values>(data)), ...); // comma fold is evaluated left-to-right
 }
 
-template <class T, _require_arithmetic<T> = true>
-[[nodiscard]] constexpr T midpoint(T a, T b) noexcept {
-    return (a + b) * 0.5; // integers will be cast to float then rounded
-}
+// Lock-free SPSC byte ring, each thread writes into its own buffer so producers never contend with each other.
+//
+// Positions grow monotonically & get mapped into the buffer with a mask. Entries are always contiguous,
+// when an entry doesn't fit before the end of the buffer producer skips the remaining space (marking it with
+// a zero-sized header if there is room for one) & places the entry at the start.
+class _staging_buffer {
+private:
+    std::unique_ptr<char[]> data;
+    std::size_t             capacity;
 
-template <class T, _require_arithmetic<T> = true>
-[[nodiscard]] constexpr T absdiff(T a, T b) noexcept {
-    return (a > b) ? (a - b) : (b - a);
-}
+    alignas(_cache_line_size) std::atomic<std::size_t> write_pos{0};
+    std::size_t cached_read_pos = 0; // producer-side copy of 'read_pos', saves a read of the consumer's cache line
+    std::size_t entry_pos       = 0; // where the last reserved entry starts, producer only
 
-[[nodiscard]] constexpr int signpow(int p) noexcept { return (p % 2 == 0) ? 1 : -1; }
+    alignas(_cache_line_size) std::atomic<std::size_t> read_pos{0};
 
-// ===========================
-// --- Indicator functions ---
-// ===========================
+public:
+    const std::size_t thread;         // index of the owning thread
+    std::atomic<bool> retired{false}; // owning thread has exited, buffer can be removed once empty
 
-template <class T, _require_arithmetic<T> = true>
-[[nodiscard]] constexpr T heaviside(T x) noexcept {
-    return static_cast<T>(x > T(0));
-}
+    _staging_buffer(std::size_t size, std::size_t thread) : thread(thread) {
+        this->capacity = 64;
+        while (this->capacity < size) this->capacity *= 2; // power of 2 sizes allow indexing with a mask
+        this->data = std::make_unique<char[]>(this->capacity);
+    }
 
-template <class T, _require_integral<T> = true>
-[[nodiscard]] constexpr T kronecker_delta(T i, T j) noexcept {
-    return (i == j) ? T(1) : T(0);
-}
+    // Largest entry that can always fit, even if it has to skip the space at the end of the buffer
+    [[nodiscard]] std::size_t max_entry_size() const noexcept { return this->capacity / 2; }
 
-template <class T, _require_integral<T> = true>
-[[nodiscard]] constexpr T levi_civita(T i, T j, T k) noexcept {
-    if (i == j || j == k || k == i) return T(0);
-    const std::size_t inversions = (i > j) + (i > k) + (j > k);
-    return (inversions % 2 == 0) ? T(1) : T(-1);
-}
+    // Producer, returns null when there is currently no space for 'size' bytes
+    [[nodiscard]] char* try_reserve(std::size_t size) noexcept {
+        const std::size_t pos    = this->write_pos.load(std::memory_order_relaxed);
+        const std::size_t offset = pos & (this->capacity - 1);
+        const std::size_t to_end = this->capacity - offset;
+        const std::size_t skip   = (size <= to_end) ? 0 : to_end;
 
-// ===========================
-// --- Degrees and radians ---
-// ===========================
+        if (pos + skip + size - this->cached_read_pos > this->capacity) {
+            this->cached_read_pos = this->read_pos.load(std::memory_order_acquire);
+            if (pos + skip + size - this->cached_read_pos > this->capacity) return nullptr;
+        }
 
-// Degree <-> radian conversion
-template <class T, _require_float<T> = true>
-[[nodiscard]] constexpr T deg_to_rad(T degrees) noexcept {
-    constexpr T factor = T(constants::pi / 180.);
-    return degrees * factor;
-}
+        // Skipped space gets published together with the entry
+        if (skip && to_end >= sizeof(std::uint32_t)) std::memset(this->data.get() + offset, 0, sizeof(std::uint32_t));
 
-template <class T, _require_float<T> = true>
-[[nodiscard]] constexpr T rad_to_deg(T radians) noexcept {
-    constexpr T factor = T(180. / constants::pi);
-    return radians * factor;
-}
+        this->entry_pos = pos + skip;
+        return this->data.get() + (this->entry_pos & (this->capacity - 1));
+    }
 
-// ===========================
-// --- Sequence operations ---
-// ===========================
+    // Producer, publishes the entry written into the last reserved space
+    void commit(std::size_t size) noexcept {
+        this->write_pos.store(this->entry_pos + size, std::memory_order_release);
+    }
 
-template <class Idx, class Func, _require_invocable<Func, Idx> = true>
-[[nodiscard]] constexpr auto sum(Idx low, Idx high, Func&& func) noexcept(noexcept(func(Idx{}))) {
-    assert(low <= high);
-    std::invoke_result_t<Func, Idx> res = 0;
-    for (Idx i = low; i <= high; ++i) res += func(i);
-    return res;
-}
+    [[nodiscard]] bool empty() const noexcept {
+        return this->read_pos.load(std::memory_order_acquire) == this->write_pos.load(std::memory_order_acquire);
+    }
 
-template <class Idx, class Func, _require_invocable<Func, Idx> = true>
-[[nodiscard]] constexpr auto prod(Idx low, Idx high, Func&& func) noexcept(noexcept(func(Idx{}))) {
-    assert(low <= high);
-    std::invoke_result_t<Func, Idx> res = 1;
-    for (Idx i = low; i <= high; ++i) res *= func(i);
-    return res;
-}
+    // Consumer, calls 'func(entry)' for every published entry & frees the space after each one
+    template <class Func>
+    bool consume(Func&& func) {
+        std::size_t       pos = this->read_pos.load(std::memory_order_relaxed);
+        const std::size_t end = this->write_pos.load(std::memory_order_acquire);
+        if (pos == end) return false;
 
-// ==================
-// --- Indexation ---
-// ==================
+        while (pos != end) {
+            const std::size_t offset = pos & (this->capacity - 1);
+            const std::size_t to_end = this->capacity - offset;
 
-// Same thing as C++20 ssize()
-template <class T, _require<has_size_v<T>> = true>
-[[nodiscard]] constexpr auto ssize(const T& container) {
-    using return_type = std::common_type_t<std::ptrdiff_t, std::make_signed_t<decltype(container.size())>>;
-    return static_cast<return_type>(container.size());
-}
+            std::uint32_t size = 0;
+            if (to_end >= sizeof(size)) std::memcpy(&size, this->data.get() + offset, sizeof(size));
 
-// Utility used to reverse indexation logic, mostly useful when working with unsigned indices
-template <class T, _require_integral<T> = true>
-[[nodiscard]] constexpr T reverse_idx(T idx, T size) noexcept {
-    return size - T(1) - idx;
-}
+            if (size == 0) { // padding
+                pos += to_end;
+                continue;
+            }
 
-// ====================
-// --- Permutations ---
-// ====================
+            func(static_cast<const char*>(this->data.get() + offset));
+            pos += size;
+            this->read_pos.store(pos, std::memory_order_release);
+        }
 
-template <class Array>
-bool is_permutation(const Array& array) {
-    std::vector<std::size_t> p(array.size()); // Note: "non-allocating range adapter" would fit like a glove here
-    for (std::size_t i = 0; i < p.size(); ++i) p[i] = i;
+        this->read_pos.store(pos, std::memory_order_release);
+        return true;
+    }
+};
 
-    return std::is_permutation(array.begin(), array.end(), p.begin()); // I'm surprised it exists in the standard
-}
+class _deferred_backend {
+private:
+    std::size_t buffer_size;
+    std::size_t generation; // tells threads that their buffer belongs to a previous backend
 
-template <class Array, class Permutation = std::initializer_list<std::size_t>>
-void apply_permutation(Array& array, const Permutation& permutation) {
-    Array res(array.size());
+    std::mutex                                    buffers_mutex;
+    std::vector<std::shared_ptr<_staging_buffer>> buffers;
+    std::atomic<bool>                             buffers_changed{false};
 
-    typename Array::size_type emplace_idx = 0;
-    for (auto i : permutation) res[emplace_idx++] = std::move(array[i]);
-    array = std::move(res);
-}
+    // Messages only carry 'steady_clock' time, date gets reconstructed from the offset between clocks
+    clock::time_point                     steady_start = clock::now();
+    std::chrono::system_clock::time_point system_start = std::chrono::system_clock::now();
 
-template <class Array, class Cmp = std::less<>>
-std::vector<std::size_t> sorting_permutation(const Array& array, Cmp cmp = Cmp()) {
-    std::vector<std::size_t> permutation(array.size());
-    for (std::size_t i = 0; i < permutation.size(); ++i) permutation[i] = i;
+    std::mutex              wake_mutex;
+    std::condition_variable wake_cv;
+    bool                    wake_requested = false;
+    std::atomic<bool>       stopping{false};
 
-    std::sort(permutation.begin(), permutation.end(),
-              [&](const auto& lhs, const auto& rhs) { return cmp(array[lhs], array[rhs]); });
+    std::thread consumer;
 
-    return permutation;
-}
+    // Regular messages don't wake up the consumer since it polls anyways, this keeps the hot path free of
+    // any shared writes, only 'flush()' & producers waiting for space need an immediate response
+    static constexpr auto poll_interval = std::chrono::milliseconds(1);
 
-template <class Array, class... SyncedArrays>
-void sort_together(Array& array, SyncedArrays&... synced_arrays) {
-    // Get permutation that would make the 1st array sorted
-    const auto permutation = sorting_permutation(array);
+    inline static std::atomic<std::size_t> next_generation{0};
 
-    // Apply permutation to all arrays to "sort them in sync"
-    apply_permutation(array, permutation);
-    (apply_permutation(synced_arrays, permutation), ...);
-}
+    // Owned by a 'thread_local', marks the buffer as retired on thread exit, consumer still drains what's left
+    struct BufferHandle {
+        std::shared_ptr<_staging_buffer> buffer;
+        std::size_t                      generation = std::size_t(-1);
 
-// ==========================
-// --- Branchless ternary ---
-// ==========================
+        ~BufferHandle() {
+            if (this->buffer) this->buffer->retired.store(true, std::memory_order_release);
+        }
+    };
 
-template <class T, _require_arithmetic<T> = true>
-[[nodiscard]] constexpr T ternary_branchless(bool condition, T return_if_true, T return_if_false) noexcept {
-    return (condition * return_if_true) + (!condition * return_if_false);
-}
+    _staging_buffer& thread_buffer() {
+        thread_local BufferHandle handle;
 
-template <class T, _require_integral<T> = true>
-[[nodiscard]] constexpr T ternary_bitselect(bool condition, T return_if_true, T return_if_false) noexcept {
-    return (return_if_true & -T(condition)) | (return_if_false & ~(-T(condition)));
-}
+        if (handle.generation != this->generation) {
+            if (handle.buffer) handle.buffer->retired.store(true, std::memory_order_release);
 
-template <class T, _require_integral<T> = true>
-[[nodiscard]] constexpr T ternary_bitselect(bool condition, T return_if_true /* returns 0 if false*/) noexcept {
-    return return_if_true & -T(condition);
-}
+            handle.buffer     = std::make_shared<_staging_buffer>(this->buffer_size, _get_thread_index());
+            handle.generation = this->generation;
 
-// ===============
-// --- Meshing ---
-// ===============
+            const std::lock_guard buffers_lock(this->buffers_mutex);
+            this->buffers.push_back(handle.buffer);
+            this->buffers_changed.store(true, std::memory_order_release);
+        }
 
-// Semantic helpers that allow user to directly pass both interval/point counts for grid subdivision,
-// without thinking about whether function need +1 or -1 to its argument
-struct Points {
-    std::size_t count;
+        return *handle.buffer;
+    }
 
-    Points() = delete;
-    constexpr explicit Points(std::size_t count) noexcept : count(count) {}
-};
+    void wake_consumer() {
+        {
+            const std::lock_guard wake_lock(this->wake_mutex);
+            this->wake_requested = true;
+        }
+        this->wake_cv.notify_one();
+    }
 
-struct Intervals {
-    std::size_t count;
+    void decode(const char* entry, std::size_t thread, _record& record) const {
+        _deferred_header header;
+        std::memcpy(&header, entry, sizeof(header));
 
-    Intervals() = delete;
-    constexpr explicit Intervals(std::size_t count) noexcept : count(count) {}
-    constexpr Intervals(Points points) noexcept : count(points.count > 0 ? points.count - 1 : 0) {}
-};
+        const auto now = clock::time_point(clock::duration(header.now));
+        const auto sys = this->system_start + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                                                  now - this->steady_start);
 
-// Linear 1D mesh
-template <class T, _require_float<T> = true>
-[[nodiscard]] std::vector<T> linspace(T L1, T L2, Intervals N) {
-    assert(L1 < L2);
-    assert(N.count >= 1);
+        record.callsite  = header.callsite;
+        record.verbosity = header.verbosity;
+        record.now       = now;
+        record.time      = std::chrono::system_clock::to_time_t(sys);
+        record.thread    = thread;
+        record.flushed   = header.flushed;
+        record.message.clear();
+        if (header.decode) header.decode(entry + sizeof(header), record.message);
+    }
 
-    std::vector<T> res(N.count + 1);
-    for (std::size_t i = 0; i < res.size(); ++i) res[i] = i * (L2 - L1) / N.count;
-    return res;
-}
+    // Every thread's messages come out in order, messages of different threads are interleaved in chunks.
+    //
+    // Barrier only sits in the buffer of the thread that called 'flush()', buffers that were already visited
+    // during the same pass could've received messages logged before the call, which is why barriers are only
+    // completed after the next full pass.
+    void consumer_main() {
+        std::vector<std::shared_ptr<_staging_buffer>> local_buffers;
+        std::vector<std::promise<void>*>              barriers_seen, barriers_ready;
+        _record                                       record;
 
-// Chebyshev 1D mesh
-template <class T, _require_float<T> = true>
-[[nodiscard]] std::vector<T> chebspace(T L1, T L2, Intervals N) {
-    assert(L1 < L2);
-    assert(N.count >= 1);
+        while (true) {
+            const bool stop = this->stopping.load(std::memory_order_acquire);
 
-    std::vector<T> res(N.count + 1);
-    res.front() = L2;
-    for (std::size_t i = 1; i < res.size() - 1; ++i) {
-        const std::size_t n  = res.size() - 2;
-        const T           c1 = T(0.5) * (L2 + L1);
-        const T           c2 = T(0.5) * (L2 - L1);
-        const T           c3 = constants::pi * (2 * i - 1) / (2 * n);
-        res[i]               = c1 + c2 * std::cos(c3);
-    }
-    res.back() = L1;
+            if (this->buffers_changed.exchange(false, std::memory_order_acquire)) {
+                const std::lock_guard buffers_lock(this->buffers_mutex);
+                local_buffers = this->buffers;
+            }
 
-    std::reverse(res.begin(), res.end()); // standard formula goes from '1' to '-1', we want things sorted
-    return res;
-}
+            bool worked = false;
+            for (const auto& buffer : local_buffers)
+                worked |= buffer->consume([&](const char* entry) {
+                    this->decode(entry, buffer->thread, record);
+                    if (record.flushed) barriers_seen.push_back(record.flushed);
+                    else _process_record(record);
+                });
 
-template <class T, class Func, _require_float<T> = true, _require_invocable_r<T, Func, T> = true>
-[[nodiscard]] T integrate_trapezoidal(Func&& f, T L1, T L2, Intervals N) {
-    assert(L1 < L2);
-    assert(N.count >= 1);
+            for (auto* barrier : barriers_ready) {
+                record.flushed = barrier;
+                _process_record(record); // flushes the sinks
+            }
+            barriers_ready.clear();
+            barriers_ready.swap(barriers_seen);
+
+            // Retired buffers are only removed once drained, their threads can't write anything new
+            const auto is_done = [](const auto& buffer) {
+                return buffer->retired.load(std::memory_order_acquire) && buffer->empty();
+            };
+            if (std::any_of(local_buffers.begin(), local_buffers.end(), is_done)) {
+                const std::lock_guard buffers_lock(this->buffers_mutex);
+                this->buffers.erase(std::remove_if(this->buffers.begin(), this->buffers.end(), is_done),
+                                    this->buffers.end());
+                local_buffers = this->buffers;
+            }
 
-    const T step = (L2 - L1) / N.count;
+            if (worked || !barriers_ready.empty()) continue;
+            if (stop) break; // stop was requested before the last pass found nothing, everything is written
 
-    T sum = 0;
-    T x   = L1;
+            std::unique_lock wake_lock(this->wake_mutex);
+            this->wake_cv.wait_for(wake_lock, poll_interval, [&] { return this->wake_requested; });
+            this->wake_requested = false;
+        }
+    }
 
-    for (std::size_t i = 0; i < N.count; ++i, x += step) sum += f(x) + f(x + step);
+    template <class... Values>
+    void push_values(const Callsite& callsite, Verbosity verbosity, std::promise<void>* flushed,
+                     _deferred_decoder decode, const Values&... values) {
+        const std::size_t size = sizeof(_deferred_header) + (std::size_t{} + ... + _deferred_size(values));
 
-    return T(0.5) * sum * step;
-}
+        _deferred_header header;
+        header.size      = static_cast<std::uint32_t>(size);
+        header.verbosity = verbosity;
+        header.callsite  = callsite;
+        header.now       = clock::now().time_since_epoch().count();
+        header.decode    = decode;
+        header.flushed   = flushed;
 
-// ====================
-// --- Memory usage ---
-// ====================
+        _staging_buffer& buffer = this->thread_buffer();
 
-// Below are a few methods to do inaccurate but nonintrusive estimates of containers
-// memory usage, we can't really count anything accurately without intrusively knowing implementation
-// or providing a custom allocator that gathers statistics, nor can we distinguish heap usage from
-// stack usage, however we can get "good enough" estimates to know if something is relatively "big" or
-// "small" which is often quite handy for testing & debugging.
-//
-// Note 1: Node-based containers can be slightly inaccurate due to specifics of node allocation.
-//
-// Note 2: Contiguous containers should be accurate.
-//
-// Note 3:
-// Estimates for 'std::list', 'std::queue', 'std::dequeue', 'std::priority_queue' are quite inaccurate since unlike
-// node-based containers they don't expose the underlying node type to the user, we can only count actual content.
+        // Huge messages can't fit into the buffer, once all previous messages of this thread are written
+        // we can format them right here without breaking the order
+        if (size > buffer.max_entry_size()) {
+            while (!buffer.empty()) {
+                this->wake_consumer();
+                std::this_thread::yield();
+            }
 
-enum class MemoryUnit { BYTE, KiB, MiB, GiB, TiB, KB, MB, GB, TB };
+            std::string entry(size, '\0');
+            char*       data = entry.data();
+            std::memcpy(data, &header, sizeof(header));
+            data += sizeof(header);
+            (_write_deferred(data, values), ...);
 
-// Workaround for 'static_assert(false)' making program ill-formed even when placed inside an 'if constexpr' branch
-// that never compiles. 'static_assert(_always_false_v<T>)' on the the other hand delays its evaluation and works as
-// we would want. This is super-well known, this comment just explains the basics should I have amnesia in the future.
-template <MemoryUnit units>
-constexpr bool _always_false_mem_v = false;
+            thread_local _record record;
+            this->decode(entry.data(), buffer.thread, record);
+            _process_record(record);
+            return;
+        }
 
-template <class T, class Func>
-constexpr void _tuple_for_each(T&& tuple, Func&& func) {
-    std::apply([&func](auto&&... args) { (func(std::forward<decltype(args)>(args)), ...); }, std::forward<T>(tuple));
-}
+        char* data = buffer.try_reserve(size);
+        while (!data) {
+            this->wake_consumer();
+            std::this_thread::yield();
+            data = buffer.try_reserve(size);
+        }
 
-template <MemoryUnit units = MemoryUnit::MiB>
-[[nodiscard]] constexpr double to_memory_units(std::size_t bytes) noexcept {
-    if constexpr (units == MemoryUnit::BYTE) return bytes;
-    else if constexpr (units == MemoryUnit::KiB) return bytes / 1024.;
-    else if constexpr (units == MemoryUnit::MiB) return bytes / 1024. / 1024.;
-    else if constexpr (units == MemoryUnit::GiB) return bytes / 1024. / 1024. / 1024.;
-    else if constexpr (units == MemoryUnit::TiB) return bytes / 1024. / 1024. / 1024. / 1024.;
-    else if constexpr (units == MemoryUnit::KB) return bytes / 1000.;
-    else if constexpr (units == MemoryUnit::MB) return bytes / 1000. / 1000.;
-    else if constexpr (units == MemoryUnit::GB) return bytes / 1000. / 1000. / 1000.;
-    else if constexpr (units == MemoryUnit::TB) return bytes / 1000. / 1000. / 1000. / 1000.;
-    else static_assert(_always_false_mem_v<units>, "Function is a non-exhaustive visitor of enum class {MemoryUnit}.");
-}
+        std::memcpy(data, &header, sizeof(header));
+        data += sizeof(header);
+        (_write_deferred(data, values), ...);
 
-// Quick memory usage estimate, doesn't iterate containers and doesn't try to expand
-// recursively, gives the best guess it can get by just querying the size
-template <MemoryUnit units = MemoryUnit::MiB, class T>
-[[nodiscard]] constexpr double quick_memory_estimate(const T& value) {
-    std::size_t bytes{};
+        buffer.commit(size);
+    }
 
-    // Node-based containers with size
-    // (like 'std::map', 'std::unordered_map', 'std::set', 'std::unordered_set')
-    if constexpr (has_size_v<T> && has_node_type_v<T>) {
-        bytes += sizeof(T);
-        bytes += value.size() * sizeof(typename T::node_type);
+public:
+    explicit _deferred_backend(std::size_t buffer_size)
+        : buffer_size(buffer_size), generation(next_generation.fetch_add(1, std::memory_order_relaxed)) {
+        this->consumer = std::thread(&_deferred_backend::consumer_main, this);
     }
-    // Contiguous containers with static size
-    // (like 'std::array')
-    else if constexpr (has_data_v<T> && has_tuple_size_v<T> && has_value_type_v<T>) {
-        // counting 'sizeof(T)' here would likely lead to double-counting the same elements
-        bytes += std::tuple_size_v<T> * sizeof(typename T::value_type);
+
+    _deferred_backend(const _deferred_backend&) = delete;
+    _deferred_backend(_deferred_backend&&)      = delete;
+
+    ~_deferred_backend() {
+        this->stopping.store(true, std::memory_order_release);
+        this->wake_consumer();
+        this->consumer.join(); // consumer drains all buffers before exiting
     }
-    // Contiguous containers with dynamic capacity
-    // (like 'std::vector', 'std::string' and most custom ones)
-    else if constexpr (has_data_v<T> && has_capacity_v<T> && has_value_type_v<T>) {
-        bytes += sizeof(T);
-        bytes += value.capacity() * sizeof(typename T::value_type);
+
+    template <class... Args>
+    void push(const Callsite& callsite, Verbosity verbosity, const Args&... args) {
+        if constexpr ((_is_deferrable_v<Args> && ...)) {
+            this->push_values(callsite, verbosity, nullptr, &_decode_deferred<decltype(_to_deferred(args))...>,
+                              _to_deferred(args)...);
+        } else {
+            thread_local std::string message;
+            message.clear();
+            append_stringified(message, args...);
+            this->push_values(callsite, verbosity, nullptr, &_decode_deferred<std::string_view>,
+                              std::string_view(message));
+        }
     }
-    // Contiguous containers with dynamic size
-    // (like 'std::list', 'std::queue', 'std::dequeue', 'std::priority_queue')
-    else if constexpr (has_data_v<T> && has_size_v<T> && has_value_type_v<T>) {
-        bytes += sizeof(T);
-        bytes += value.size() * sizeof(typename T::value_type);
+
+    // Barrier goes through the calling thread's buffer, so it's processed after all previous messages of that thread
+    void flush() {
+        std::promise<void> flushed;
+        auto               future = flushed.get_future();
+
+        this->push_values({}, Verbosity::ERR, &flushed, nullptr);
+        this->wake_consumer();
+
+        future.wait();
     }
-    // Tuple-like types
-    // (like 'std::tuple', 'std::pair')
-    else if constexpr (has_tuple_size_v<T> && has_get_v<T>) {
-        _tuple_for_each(value, [&](auto&& e) { bytes += quick_memory_estimate(e); });
+};
+
+// ====================
+// --- Logger class ---
+// ====================
+
+struct _logger {
+    inline static std::list<Sink> sinks;
+    // we use list<> because we don't want sinks to ever reallocate when growing / shrinking
+    // (reallocation requires a move-constructor, which 'std::mutex' doesn't have),
+    // the added overhead of iterating a list is negligible
+
+    static inline Sink default_sink{std::cout, Verbosity::TRACE, Colors::ENABLE, std::chrono::milliseconds(0),
+                                    Columns{}};
+
+    std::unique_ptr<_async_backend>    async;    // null => synchronous logging
+    std::unique_ptr<_deferred_backend> deferred; // null => regular logging, modes are mutually exclusive
+
+    static _logger& instance() {
+        static _logger logger;
+        return logger;
     }
-    // Non-contiguous sized containers
-    // (like 'std::list', 'std::queue', 'std::dequeue', 'std::priority_queue')
-    else if constexpr (has_size_v<T> && has_value_type_v<T>) {
-        bytes += sizeof(T);
-        bytes += value.size() * sizeof(typename T::value_type);
+
+    // When no sinks were manually created, default sink-to-terminal takes over
+    template <class Func>
+    static void for_each_sink(Func&& func) {
+        if (sinks.empty()) func(default_sink);
+        else
+            for (auto& sink : sinks) func(sink);
     }
-    // Everything else
-    else {
-        bytes += sizeof(T);
-    };
 
-    return to_memory_units<units>(bytes);
-}
+    // Arguments & shared columns are stringified / queried once per message no matter the number of sinks,
+    // in sync mode the record gets formatted right away, in async mode it's passed to the background thread
+    template <class... Args>
+    void push_message(const Callsite& callsite, const MessageMetadata& meta, const Args&... args) {
+        // Deferred mode does everything on the background thread, including the checks below
+        if (this->deferred) {
+            this->deferred->push(callsite, meta.verbosity, args...);
+            return;
+        }
 
-// TODO:
-// recursive_memory_estimate()
+        // Only query things that some sink will actually use
+        bool accepted = false, needs_datetime = false, needs_thread = false;
+        for_each_sink([&](const Sink& sink) {
+            if (meta.verbosity > sink.verbosity) return;
+            accepted = true;
+            needs_datetime |= sink.columns.datetime;
+            needs_thread |= sink.columns.thread;
+        });
+        if (!accepted) return;
+
+        // Record gets reused between calls, its message buffer only allocates when it needs to grow.
+        // Note the 'thread_local', if it was a member, multiple threads would fight over the same buffer.
+        thread_local _record record;
+
+        record.callsite  = callsite;
+        record.verbosity = meta.verbosity;
+        record.now       = clock::now();
+        record.time      = needs_datetime ? std::time(nullptr) : 0;
+        record.thread    = needs_thread ? _get_thread_index() : 0;
+        record.flushed   = nullptr;
+        record.message.clear();
+        append_stringified(record.message, args...);
+
+        if (this->async) this->async->push(record);
+        else process_record(record);
+    }
+
+    static void process_record(_record& record) {
+        if (record.flushed) {
+            for_each_sink([](Sink& sink) { sink.flush(); });
+            record.flushed->set_value();
+            record.flushed = nullptr;
+            return;
+        }
 
-} // namespace utl::math
+        // Decorated lines, one per distinct sink decoration among the accepting sinks. Usually there are only
+        // a few of those (like a colored terminal & a bunch of plain files) so a linear search is good enough.
+        thread_local std::vector<std::pair<const Sink*, std::string>> lines;
+        std::size_t                                                 line_count = 0;
 
-#endif
-#endif // module utl::math
+        for_each_sink([&](Sink& sink) {
+            if (record.verbosity > sink.verbosity) return;
 
+            auto line = std::find_if(lines.begin(), lines.begin() + line_count,
+                                     [&](const auto& decorated) { return decorated.first->same_decoration(sink); });
 
+            if (line == lines.begin() + line_count) {
+                if (line_count == lines.size()) lines.emplace_back();
+                line        = lines.begin() + line_count++;
+                line->first = &sink;
+                line->second.clear();
+                sink.format_line(line->second, record);
+            }
 
+            sink.write(line->second, record.now);
+        });
+    }
 
+    static void update_max_verbosity() {
+        Verbosity max = Verbosity::ERR;
+        for_each_sink([&](const Sink& sink) { max = std::max(max, sink.verbosity); });
+        _max_verbosity.store(max, std::memory_order_relaxed);
+    }
+};
 
+inline void _process_record(_record& record) { _logger::process_record(record); }
 
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-//
-// Module:        utl::mvl
-// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_mvl.md
-// Source repo:   https://github.com/DmitriBogdanov/UTL
-//
-// This project is licensed under the MIT License
-//
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+inline void _update_max_verbosity() { _logger::update_max_verbosity(); }
 
-#if !defined(UTL_PICK_MODULES) || defined(UTLMODULE_MVL)
-#ifndef UTLHEADERGUARD_MVL
-#define UTLHEADERGUARD_MVL
+// =======================
+// --- Sink public API ---
+// =======================
 
-// _______________________ INCLUDES _______________________
+inline Sink& add_ostream_sink(std::ostream&   os,                                           //
+                              Verbosity       verbosity      = Verbosity::INFO,             //
+                              Colors          colors         = Colors::ENABLE,              //
+                              clock::duration flush_interval = std::chrono::milliseconds{}, //
+                              const Columns&  columns        = Columns{}                    //
+) {
+    Sink& sink = _logger::instance().sinks.emplace_back(os, verbosity, colors, flush_interval, columns);
+    _update_max_verbosity();
+    return sink;
+}
 
-#include <algorithm>        // swap(), find(), count(), is_sorted(), min_element(),
-                            // max_element(), sort(), stable_sort(), min(), max(), remove_if(), copy()
-#include <cassert>          // assert() // Note: Perhaps temporary
-#include <charconv>         // to_chars()
-#include <cmath>            // isfinite()
-#include <cstddef>          // size_t, ptrdiff_t, nullptr_t
-#include <exception>        // exception
-#include <functional>       // reference_wrapper<>, multiplies<>
-#include <initializer_list> // initializer_list<>
-#include <iomanip>          // setw()
-#include <ios>              // right(), boolalpha(), ios::boolalpha
-#include <iterator>         // random_access_iterator_tag, reverse_iterator<>
-#include <memory>           // unique_ptr<>
-#include <numeric>          // accumulate()
-#include <ostream>          // ostream
-#include <sstream>          // ostringstream
-#include <stdexcept>        // out_of_range, invalid_argument
-#include <string>           // string
-#include <string_view>      // string_view<>
-#include <type_traits>      // conditional_t<>, enable_if_t<>, void_t<>, true_type, false_type, remove_reference_t<>
-#include <utility>          // move()
-#include <vector>           // vector<>
+inline Sink& add_file_sink(const std::string& filename,                                       //
+                           OpenMode           open_mode      = OpenMode::REWRITE,             //
+                           Verbosity          verbosity      = Verbosity::TRACE,              //
+                           Colors             colors         = Colors::DISABLE,               //
+                           clock::duration    flush_interval = std::chrono::milliseconds{15}, //
+                           const Columns&     columns        = Columns{}                      //
+) {
+    const auto ios_open_mode = (open_mode == OpenMode::APPEND) ? std::ios::out | std::ios::app : std::ios::out;
+    Sink& sink = _logger::instance().sinks.emplace_back(std::ofstream(filename, ios_open_mode), verbosity, colors,
+                                                        flush_interval, columns);
+    _update_max_verbosity();
+    return sink;
+}
 
-// ____________________ DEVELOPER DOCS ____________________
+// ===================================
+// --- Async & deferred public API ---
+// ===================================
 
-// This module tries to implement an "unreasonably flexible yet convenient" template for vectors and matrices,
-// in order to do so we have to rely heavily on either conditional compilation or automatic code generation
-// (or both). There are multiple seemingly viable approaches to it, yet the most of them proved to be either
-// unsuitable or unreasonable from the implementation standpoint. Below is a little rundown of implementations
-// that were attempted and used/discared for various reasons.
-//
-// Currently matrix/vector/view/etc code reuse is implemented though a whole bunch of conditional compilation with
-// SFINAE, abuse of conditional inheritance, conditional types and constexpr if's. While not perfect, this is
-// the best working approach so far. Below is a list of approaches that has been considered & tried:
-//
-// 1) No code reuse, all classes implemented manually - unrealistically cumbersome, huge code duplication
-//
-//    => [-] UNSUITABLE APPROACH
-//
-// 2) Regular OOP with virtual classes - having vtables in lightweight containers is highly undesirable,
-//    we can avoid this using CRTP however we run into issues with multiple inheritance (see below)
-//
-//    => [-] UNSUITABLE APPROACH
-//
-// 3) CRTP - we unavoidably run into multiple inheritance issues (diamond problem) with concepts like:
-//       [mutable-matrix-like] : [const-matrix-like] & [mutable-iterable] where both parents derive from
-//       [const-iterable]
-//
-//    While those issues are resolvable, their handling becomes more and more difficult as parent classes grow larger.
-//    A usual solution for this would be virtual inheritance, however it prevents us from calling derived methods inside
-//    the base class due to "static downcast via virtual inheritance" rule, which makes 'static_cast<Derived*>(this)'
-//    illegal. We can resolve all name collisions manually, however it leads to a code that is absolutely horrific and
-//    easy to mess up.
-//
-//    There is also an issue of extreme boilerplate, since we want to propagate '_types<>' wrapper and the 'Final'
-//    return type to all base classes we end up with extremely unwieldy template arguments that make compile errors and
-//    refactoring a challenge.
-//
-//    => [~] SUITABLE, BUT VERY PROBLEMATIC APPROACH
-//
-// 4) Template-based mixins without CRTP - these allow to add functionality on top of a class, essentially it works
-//    like "inverted" CRTP from the code logic POV. While being almost a perfect solution, it doesn't allow us to
-//    return objects of derived type from base class methods, which is a requirement for the intended matrix API.
-//
-//    => [-] UNSUITABLE APPROACH
-//
-// 5) Macro-based mixins - insert functionality directly in a class, a simple way of doing exactly what we want.
-//    "Mixed-in" methods are simply functions implemented in terms of certain "required" methods.
-//    Doesn't lead to huge template chains and doesn't have any inheritance at all. The main downside is being
-//    preprocessor based, which exposes some identifiers to a global namespace and makes all "connection points"
-//    in logic dependant on correct naming inside macros, rather than actual semantical symbols.
-//
-//    Difficult to work with due to being ignored by the language server, gets increasingly cumbersome as the number of
-//    classes grows and still has significant code duplication (vector/matrix * dense/strided/sparse *
-//    * container/view/const_view = 18 manually created definitions).
-//
-//    => [+-] SUITABLE, BUT HEAVILY FLAWED APPROACH
-//
-// 6) A single class with all pars of API correctly enabled/disabled through SFINAE. Closes thing to a sensible
-//    approach with minimal (basically none) code duplication. However it has a number of non-trivial quirks
-//    when it comes to conditionally compiling member variables, types & functions (every group has a quirk of
-//    its own, functions are the least problematic). Some of such quirks limit possible conditional API (member
-//    types suffer from this) or, for example, prevent use of initialization lists on conditionally compiled
-//    constructors (big sad).
-//
-//    A less obvious downside compared to macros, is that it doesn't get handles as well by the language server
-//    autocomplete - SFINAE-disabled methods still show up as autocomplete suggestions, even if they get marked
-//    as missing immediately upon writing the whole name.
-//
-//    => [+] DIFFICULT, BUT WORKABLE, BEST APPROACH SO FAR
-//
-// NOTES ON SPAN:
-//
-// We can easily implement Matlab-like API to take matrix blocks like this:
-//    matrix(Span{0, 10}, 4)
-// which would be equivalent to
-//    matrix.block(0, 4, 10, 1)
-// we only need a thin 'Span' POD with 2 members and a few overloads for 'operator()' that redirect span
-// to 'this->block(...)'
-//
-// NOTES ON NAMING:
-//
-// Macro naming is a bit of a mess as of now.
+// Switching modes isn't thread-safe, same as adding sinks it should happen before logging from multiple threads
+inline void enable_async(std::size_t capacity = default_async_capacity, Overflow overflow = Overflow::BLOCK) {
+    auto& logger = _logger::instance();
+    logger.deferred.reset();
+    logger.async.reset(); // drains the previous queue first
+    logger.async = std::make_unique<_async_backend>(capacity, overflow);
+}
 
-// ____________________ IMPLEMENTATION ____________________
+inline void disable_async() { _logger::instance().async.reset(); }
 
-namespace utl::mvl {
+[[nodiscard]] inline bool is_async() { return static_cast<bool>(_logger::instance().async); }
 
-// ===================
-// --- Type Traits ---
-// ===================
+// Same rules as for async mode, enabling one mode disables the other
+inline void enable_deferred(std::size_t buffer_size = default_deferred_buffer_size) {
+    auto& logger = _logger::instance();
+    logger.async.reset();
+    logger.deferred.reset(); // drains the previous buffers first
+    logger.deferred = std::make_unique<_deferred_backend>(buffer_size);
+}
 
-// Macro for generating type traits with all their boilerplate
-//
-// While it'd be nice to avoid macro usage alltogether, having a few macros for generating standardized boilerplate
-// that gets repeated several dozen times DRASTICALLY improves the maintainability of the whole conditional compilation
-// mechanism down the line. They will be later #undef'ed.
+inline void disable_deferred() { _logger::instance().deferred.reset(); }
 
-#define utl_mvl_define_trait(trait_name_, ...)                                                                         \
-    template <class T, class = void>                                                                                   \
-    struct trait_name_ : std::false_type {};                                                                           \
-                                                                                                                       \
-    template <class T>                                                                                                 \
-    struct trait_name_<T, std::void_t<decltype(__VA_ARGS__)>> : std::true_type {};                                     \
-                                                                                                                       \
-    template <class T>                                                                                                 \
-    constexpr bool trait_name_##_v = trait_name_<T>::value;                                                            \
-                                                                                                                       \
-    template <class T>                                                                                                 \
-    using trait_name_##_enable_if = std::enable_if_t<trait_name_<T>::value, bool>
+[[nodiscard]] inline bool is_deferred() { return static_cast<bool>(_logger::instance().deferred); }
 
-// Shortcuts for different types of requirements
+// Blocks until every message logged by this thread before the call is written & all sinks are flushed
+inline void flush() {
+    auto& logger = _logger::instance();
 
-#define utl_mvl_define_trait_has_binary_op(trait_name_, op_)                                                           \
-    utl_mvl_define_trait(trait_name_, std::declval<std::decay_t<T>>() op_ std::declval<std::decay_t<T>>())
+    if (logger.deferred) {
+        logger.deferred->flush();
+        return;
+    }
 
-#define utl_mvl_define_trait_has_assignment_op(trait_name_, op_)                                                       \
-    utl_mvl_define_trait(trait_name_, std::declval<std::decay_t<T>&>() op_ std::declval<std::decay_t<T>>())
-// for operators like '+=' lhs should be a reference
+    if (!logger.async) {
+        _logger::for_each_sink([](Sink& sink) { sink.flush(); });
+        return;
+    }
 
-#define utl_mvl_define_trait_has_unary_op(trait_name_, op_)                                                            \
-    utl_mvl_define_trait(trait_name_, op_ std::declval<std::decay_t<T>>())
+    std::promise<void> flushed;
+    auto               future = flushed.get_future();
 
-#define utl_mvl_define_trait_has_member(trait_name_, member_)                                                          \
-    utl_mvl_define_trait(trait_name_, std::declval<std::decay_t<T>>().member_)
+    _record barrier;
+    barrier.flushed = &flushed;
+    logger.async->push(barrier);
 
-#define utl_mvl_define_trait_has_member_type(trait_name_, member_)                                                     \
-    utl_mvl_define_trait(trait_name_, std::declval<typename std::decay_t<T>::member_>())
+    future.wait();
+}
 
-// --- Type traits ---
-// -------------------
+[[nodiscard]] inline std::size_t get_dropped_count() {
+    const auto& logger = _logger::instance();
+    return logger.async ? logger.async->get_dropped_count() : 0;
+}
 
-utl_mvl_define_trait(_has_ostream_output_op, std::declval<std::ostream>() << std::declval<T>());
+// =====================
+// --- Rate limiting ---
+// =====================
 
-utl_mvl_define_trait_has_binary_op(_has_binary_op_plus, +);
-utl_mvl_define_trait_has_binary_op(_has_binary_op_minus, -);
-utl_mvl_define_trait_has_binary_op(_has_binary_op_multiplies, *);
-utl_mvl_define_trait_has_binary_op(_has_binary_op_less, <);
-utl_mvl_define_trait_has_binary_op(_has_binary_op_greater, >);
-utl_mvl_define_trait_has_binary_op(_has_binary_op_equal, ==);
+// Per-callsite limiters used by rate-limited macros, each macro creates a 'static' limiter in its own scope.
+// State is shared by all threads & lock-free, so a noisy callsite can't flood the sinks no matter how many
+// threads hit it. Parameters are captured on the first call.
 
-utl_mvl_define_trait_has_assignment_op(_has_assignment_op_plus, +=);
-utl_mvl_define_trait_has_assignment_op(_has_assignment_op_minus, -=);
-utl_mvl_define_trait_has_assignment_op(_has_assignment_op_multiplies, *=);
+// Passes calls #0, #n, #2n, ...
+class _every_n {
+    std::atomic<std::size_t> count{0};
+    std::size_t              n;
 
-utl_mvl_define_trait_has_unary_op(_has_unary_op_plus, +);
-utl_mvl_define_trait_has_unary_op(_has_unary_op_minus, -);
+public:
+    explicit _every_n(std::size_t n) noexcept : n(n ? n : 1) {}
 
-utl_mvl_define_trait_has_member(_has_member_i, i);
-utl_mvl_define_trait_has_member(_has_member_j, j);
-utl_mvl_define_trait_has_member(_has_member_value, value);
+    bool operator()() noexcept { return this->count.fetch_add(1, std::memory_order_relaxed) % this->n == 0; }
+};
 
-utl_mvl_define_trait_has_member(_is_tensor, is_tensor);
-utl_mvl_define_trait_has_member(_is_sparse_entry_1d, is_sparse_entry_1d);
-utl_mvl_define_trait_has_member(_is_sparse_entry_2d, is_sparse_entry_2d);
+// Passes first 'n' calls
+class _first_n {
+    std::atomic<std::size_t> count{0};
+    std::size_t              n;
 
-// =======================
-// --- Stringification ---
-// =======================
+public:
+    explicit _first_n(std::size_t n) noexcept : n(n) {}
 
-// Stringification implementation from 'utl::log' module, see its source for more notes.
+    bool operator()() noexcept {
+        // plain load first, once the limit is reached callers stop writing into a shared cache line
+        return this->count.load(std::memory_order_relaxed) < this->n &&
+               this->count.fetch_add(1, std::memory_order_relaxed) < this->n;
+    }
+};
 
-// --- Internal type traits ---
-// ----------------------------
+// Passes at most one call per 'interval'
+class _every_interval {
+    std::atomic<clock::rep> last{std::numeric_limits<clock::rep>::min()}; // min() => nothing passed yet
+    clock::rep              interval;
 
-utl_mvl_define_trait(_has_string_append, std::string() += std::declval<T>());
-utl_mvl_define_trait(_has_real, std::declval<T>().real());
-utl_mvl_define_trait(_has_imag, std::declval<T>().imag());
-utl_mvl_define_trait(_has_begin, std::declval<T>().begin());
-utl_mvl_define_trait(_has_end, std::declval<T>().end());
-utl_mvl_define_trait(_has_input_iter, std::next(std::declval<T>().begin()));
-utl_mvl_define_trait(_has_get, std::get<0>(std::declval<T>()));
-utl_mvl_define_trait(_has_tuple_size, std::tuple_size<T>::value);
-utl_mvl_define_trait(_has_ostream_insert, std::declval<std::ostream>() << std::declval<T>());
+public:
+    explicit _every_interval(clock::duration interval) noexcept : interval(interval.count()) {}
 
-// --- Internal utils ---
-// ----------------------
+    bool operator()() noexcept {
+        const clock::rep now  = clock::now().time_since_epoch().count();
+        clock::rep       last = this->last.load(std::memory_order_relaxed);
 
-template <class>
-inline constexpr bool _always_false_v = false;
+        if (last != std::numeric_limits<clock::rep>::min() && now - last < this->interval) return false;
+        return this->last.compare_exchange_strong(last, now, std::memory_order_relaxed); // one thread wins
+    }
+};
 
-template <class T>
-constexpr int _log_10_ceil(T num) {
-    return num < 10 ? 1 : 1 + _log_10_ceil(num / 10);
-}
+// Token bucket that refills at 'rate' tokens per second & holds at most 'burst' tokens, implemented as GCRA
+// (generic cell rate algorithm) which only needs a single atomic: "theoretical arrival time" when the bucket
+// would be full again. Call passes if it doesn't push that time more than 'burst' intervals into the future.
+class _token_bucket {
+    std::atomic<clock::rep> tat{0};
+    clock::rep              interval;  // time to refill one token
+    clock::rep              tolerance; // how far ahead 'tat' can get, (burst - 1) intervals
 
-template <class T>
-constexpr int _max_float_digits =
-    4 + std::numeric_limits<T>::max_digits10 + std::max(2, _log_10_ceil(std::numeric_limits<T>::max_exponent10));
+public:
+    _token_bucket(double rate, std::size_t burst) noexcept {
+        // Interval is computed in floating point & capped before the conversion to ticks, converting an out-of-range
+        // value would be UB. Cap also keeps 'tat' arithmetic from overflowing. Non-positive & NaN rates get the
+        // largest interval, such bucket never refills and only lets the initial burst through.
+        constexpr double max_ticks = static_cast<double>(std::numeric_limits<clock::rep>::max() / 4);
 
-template <class T>
-constexpr int _max_int_digits = 2 + std::numeric_limits<T>::digits10;
+        using ticks = std::chrono::duration<double, clock::period>;
 
-// --- Stringifier ---
-// -------------------
+        const double size     = static_cast<double>(burst ? burst : 1);
+        const double seconds  = rate > 0 ? 1. / rate : max_ticks; // also catches NaN
+        const double interval = std::chrono::duration_cast<ticks>(std::chrono::duration<double>(seconds)).count();
+        const double capped   = std::max(std::min(interval, max_ticks / size), 1.);
 
-// TODO:
-// Replace or rethink all of this stringifying stuff, perhaps it would be best to just have a super-simple
-// one and let other functions take custom stringifier from 'utl::log'
+        this->interval  = static_cast<clock::rep>(capped);
+        this->tolerance = static_cast<clock::rep>(std::min(capped * (size - 1), max_ticks));
+    }
 
-template <class T>
-void _append_stringified(std::string& str, const T& value);
+    bool operator()() noexcept {
+        const clock::rep now = clock::now().time_since_epoch().count();
+        clock::rep       tat = this->tat.load(std::memory_order_relaxed);
 
-inline void _append_stringified_bool(std::string& str, bool value) { str += value ? "true" : "false"; }
+        while (true) {
+            const clock::rep base = std::max(tat, now);
+            if (base - now > this->tolerance) return false;
+            if (this->tat.compare_exchange_weak(tat, base + this->interval, std::memory_order_relaxed)) return true;
+        }
+    }
+};
 
-template <class T>
-void _append_stringified_integer(std::string& str, T value) {
-    std::array<char, _max_int_digits<T>> buffer;
-    const auto [number_end_ptr, error_code] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
-    if (error_code != std::errc())
-        throw std::runtime_error(
-            "Integer stringification encountered std::to_chars() formatting error while serializing a value.");
-    str.append(buffer.data(), number_end_ptr - buffer.data());
-}
+// ======================
+// --- Logging macros ---
+// ======================
 
-template <class T>
-void _append_stringified_float(std::string& str, T value) {
-    std::array<char, _max_float_digits<T>> buffer;
-    const auto [number_end_ptr, error_code] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
-    if (error_code != std::errc())
-        throw std::runtime_error(
-            "Float stringification encountered std::to_chars() formatting error while serializing a value.");
-    str.append(buffer.data(), number_end_ptr - buffer.data());
-}
+// Messages above the max sink verbosity are rejected by a single atomic load, arguments don't get evaluated.
+// Levels above 'UTL_LOG_COMPILE_LEVEL' (which uses integer values of 'Verbosity') are removed from the code entirely.
 
-template <class T>
-void _append_stringified_complex(std::string& str, T value) {
-    _append_stringified_float(str, value.real());
-    str += " + ";
-    _append_stringified_float(str, value.imag());
-    str += " i";
-}
+#ifndef UTL_LOG_COMPILE_LEVEL
+#define UTL_LOG_COMPILE_LEVEL 5
+#endif
 
-template <class T>
-void _append_stringified_stringlike(std::string& str, const T& value) {
-    str += value;
-}
+#define utl_log_message(verbosity_, ...)                                                                               \
+    (utl::log::_is_enabled(utl::log::Verbosity::verbosity_)                                                            \
+         ? utl::log::_logger::instance().push_message({__FILE__, __LINE__}, {utl::log::Verbosity::verbosity_},         \
+                                                      __VA_ARGS__)                                                     \
+         : void())
 
-template <class T>
-void _append_stringified_string_convertible(std::string& str, const T& value) {
-    str += std::string(value);
-}
+#if UTL_LOG_COMPILE_LEVEL >= 0
+#define UTL_LOG_ERR(...) utl_log_message(ERR, __VA_ARGS__)
+#else
+#define UTL_LOG_ERR(...) static_cast<void>(0)
+#endif
 
-template <class T>
-void _append_stringified_array(std::string& str, const T& value) {
-    str += "{ ";
-    if (value.begin() != value.end())
-        for (auto it = value.begin();;) {
-            _append_stringified(str, *it);
-            if (++it == value.end()) break;
-            str += ", ";
-        }
-    str += " }";
-}
+#if UTL_LOG_COMPILE_LEVEL >= 1
+#define UTL_LOG_WARN(...) utl_log_message(WARN, __VA_ARGS__)
+#else
+#define UTL_LOG_WARN(...) static_cast<void>(0)
+#endif
 
-template <class Tuple, std::size_t... Idx>
-void _append_stringified_tuple_impl(std::string& str, Tuple value, std::index_sequence<Idx...>) {
-    ((Idx == 0 ? "" : str += ", ", _append_stringified(str, std::get<Idx>(value))), ...);
-}
+#if UTL_LOG_COMPILE_LEVEL >= 2
+#define UTL_LOG_NOTE(...) utl_log_message(NOTE, __VA_ARGS__)
+#else
+#define UTL_LOG_NOTE(...) static_cast<void>(0)
+#endif
 
-template <template <class...> class Tuple, class... Args>
-void _append_stringified_tuple(std::string& str, const Tuple<Args...>& value) {
-    str += "< ";
-    _append_stringified_tuple_impl(str, value, std::index_sequence_for<Args...>{});
-    str += " >";
-}
+#if UTL_LOG_COMPILE_LEVEL >= 3
+#define UTL_LOG_INFO(...) utl_log_message(INFO, __VA_ARGS__)
+#else
+#define UTL_LOG_INFO(...) static_cast<void>(0)
+#endif
 
-template <class T>
-void _append_stringified_printable(std::string& str, const T& value) {
-    str += (std::ostringstream() << value).str();
-}
+#if UTL_LOG_COMPILE_LEVEL >= 4
+#define UTL_LOG_DEBUG(...) utl_log_message(DEBUG, __VA_ARGS__)
+#else
+#define UTL_LOG_DEBUG(...) static_cast<void>(0)
+#endif
 
-// --- Selector ---
-// ----------------
+#if UTL_LOG_COMPILE_LEVEL >= 5
+#define UTL_LOG_TRACE(...) utl_log_message(TRACE, __VA_ARGS__)
+#else
+#define UTL_LOG_TRACE(...) static_cast<void>(0)
+#endif
 
-template <class T>
-void _append_stringified(std::string& str, const T& value) {
-    if constexpr (std::is_same_v<T, bool>) _append_stringified_bool(str, value);
-    else if constexpr (std::is_same_v<T, char>) _append_stringified_stringlike(str, value);
-    else if constexpr (std::is_integral_v<T>) _append_stringified_integer(str, value);
-    else if constexpr (std::is_floating_point_v<T>) _append_stringified_float(str, value);
-    else if constexpr (_has_real_v<T> && _has_imag_v<T>) _append_stringified_complex(str, value);
-    else if constexpr (std::is_convertible_v<T, std::string_view>) _append_stringified_stringlike(str, value);
-    else if constexpr (std::is_convertible_v<T, std::string>) _append_stringified_string_convertible(str, value);
-    else if constexpr (_has_begin_v<T> && _has_end_v<T> && _has_input_iter_v<T>) _append_stringified_array(str, value);
-    else if constexpr (_has_get_v<T> && _has_tuple_size_v<T>) _append_stringified_tuple(str, value);
-    else if constexpr (_has_ostream_insert_v<T>) _append_stringified_printable(str, value);
-    else static_assert(_always_false_v<T>, "No valid stringification exists for the type.");
-}
+#ifdef _DEBUG
+#define UTL_LOG_DERR(...) UTL_LOG_ERR(__VA_ARGS__)
+#define UTL_LOG_DWARN(...) UTL_LOG_WARN(__VA_ARGS__)
+#define UTL_LOG_DNOTE(...) UTL_LOG_NOTE(__VA_ARGS__)
+#define UTL_LOG_DINFO(...) UTL_LOG_INFO(__VA_ARGS__)
+#define UTL_LOG_DDEBUG(...) UTL_LOG_DEBUG(__VA_ARGS__)
+#define UTL_LOG_DTRACE(...) UTL_LOG_TRACE(__VA_ARGS__)
+#else
+#define UTL_LOG_DERR(...)
+#define UTL_LOG_DWARN(...)
+#define UTL_LOG_DNOTE(...)
+#define UTL_LOG_DINFO(...)
+#define UTL_LOG_DDEBUG(...)
+#define UTL_LOG_DTRACE(...)
+#endif
 
-// --- Public API ---
-// ------------------
+// Rate-limited logging, 'level_' is one of the 'Verbosity' names, limits are per callsite & shared by all threads.
+// Suppressed calls don't evaluate arguments & don't reach the sinks.
+//    - 'UTL_LOG_EVERY_N'      - logs calls #0, #n, #2n, ...
+//    - 'UTL_LOG_FIRST_N'      - logs first 'n' calls
+//    - 'UTL_LOG_EVERY_MS'     - logs at most once per 'ms' milliseconds
+//    - 'UTL_LOG_RATE_LIMITED' - logs at most 'rate_' messages per second on average, with bursts up to 'burst_'
 
-template <class... Args>
-void append_stringified(std::string& str, Args&&... args) {
-    (_append_stringified(str, std::forward<Args>(args)), ...);
-}
+#define utl_log_limited(level_, limiter_type_, limiter_args_, ...)                                                     \
+    do {                                                                                                               \
+        if (static_cast<int>(utl::log::Verbosity::level_) > UTL_LOG_COMPILE_LEVEL) break;                             \
+        if (!utl::log::_is_enabled(utl::log::Verbosity::level_)) break;                                                \
+        static utl::log::limiter_type_ utl_log_limiter limiter_args_;                                                  \
+        if (utl_log_limiter()) UTL_LOG_##level_(__VA_ARGS__);                                                          \
+    } while (false)
 
-template <class... Args>
-[[nodiscard]] std::string stringify(Args&&... args) {
-    std::string buffer;
-    append_stringified(buffer, std::forward<Args>(args)...);
-    return buffer;
-}
+#define UTL_LOG_EVERY_N(level_, n_, ...) utl_log_limited(level_, _every_n, (n_), __VA_ARGS__)
 
-// Override "common special cases" that can be improved relative to a generic implementation
-[[nodiscard]] inline std::string stringify(int value) { return std::to_string(value); }
-[[nodiscard]] inline std::string stringify(long value) { return std::to_string(value); }
-[[nodiscard]] inline std::string stringify(long long value) { return std::to_string(value); }
-[[nodiscard]] inline std::string stringify(unsigned int value) { return std::to_string(value); }
-[[nodiscard]] inline std::string stringify(unsigned long value) { return std::to_string(value); }
-[[nodiscard]] inline std::string stringify(unsigned long long value) { return std::to_string(value); }
+#define UTL_LOG_FIRST_N(level_, n_, ...) utl_log_limited(level_, _first_n, (n_), __VA_ARGS__)
 
-// We wrap stringifying function in functor-class so we can use it a default template callable argument.
-// Templates can't infer template parameters from default arguments:
-//
-//    template<class Func>
-//    void do_stuff(Func f = default_f);  // <- CAN'T infer 'Func'
+#define UTL_LOG_EVERY_MS(level_, ms_, ...)                                                                             \
+    utl_log_limited(level_, _every_interval, (std::chrono::milliseconds(ms_)), __VA_ARGS__)
+
+#define UTL_LOG_RATE_LIMITED(level_, rate_, burst_, ...)                                                               \
+    utl_log_limited(level_, _token_bucket, (rate_, burst_), __VA_ARGS__)
+
+
+} // namespace utl::log
+
+#endif
+#endif // module utl::log
+
+
+
+
+
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //
-//    template<class Func = default_functor>
-//    void do_stuff(Func f = Func());     // <- CAN infer 'Func'
+// Module:        utl::math
+// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_math.md
+// Source repo:   https://github.com/DmitriBogdanov/UTL
 //
-// which is why the "standard" way of doing it (standard as in used by STL containers) is to use functors as default
-// template arguments, if user passes a callable it will override the 'Func' and we get the usual behaviour.
+// This project is licensed under the MIT License
 //
-template <class T>
-struct default_stringifier {
-    [[nodiscard]] std::string operator()(const T& value) const { return stringify(value); }
-};
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-// ======================
-// --- Codegen Macros ---
-// ======================
+#if !defined(UTL_PICK_MODULES) || defined(UTLMODULE_MATH)
+#ifndef UTLHEADERGUARD_MATH
+#define UTLHEADERGUARD_MATH
 
-#define utl_mvl_assert(condition_) assert(condition_)
-// if (!__VA_ARGS__) throw std::runtime_error("Failed assert on line " + std::to_string(__LINE__))
+// _______________________ INCLUDES _______________________
 
-// ========================
-// --- Helper Functions ---
-// ========================
+#include <algorithm>        // sort(), is_permutation(), reverse()
+#include <cassert>          // assert()
+#include <cmath>            // cos
+#include <cstddef>          // size_t
+#include <initializer_list> // initializer_list<>
+#include <tuple>            // get<>(), tuple_size_v<>, apply<>()
+#include <type_traits>      // enable_if_t<>, is_floating_point<>, is_arithmetic<>, conditional_t<>, is_integral<>, ...
+#include <utility>          // declval<>(), move(), forward<>()
+#include <vector>           // vector<>
 
-// Shortcut for lambda-type-based SFINAE.
-//
-// Callables in this module are usually takes as a template type since 'std::function<>' introduces very significant
-// overhead with its type erasure. With template args all lambdas and functors can be nicely inlined, however we lose
-// the ability to overload functions that take callable the way we could with 'std::function<>'.
-//
-// As a workaround we can use SFINAE to reject "overloads" tha don't have a particular signature, effectively achieving
-// the behaviour we need.
-template <class FuncType, class Signature>
-using _has_signature_enable_if = std::enable_if_t<std::is_convertible_v<FuncType, std::function<Signature>>, bool>;
+// ____________________ DEVELOPER DOCS ____________________
 
-template <class T>
-[[nodiscard]] std::unique_ptr<T[]> _make_unique_ptr_array(size_t size) {
-    return std::unique_ptr<T[]>(new T[size]);
-}
+// With C++20 following functions will be added into the standard:
+// - midpoint()
 
-// Marker for unreachable code
-[[noreturn]] inline void _unreachable() {
-// (Implementation from https://en.cppreference.com/w/cpp/utility/unreachable)
-// Use compiler specific extensions if possible.
-// Even if no extension is used, undefined behavior is still raised by
-// an empty function body and the noreturn attribute.
-#if defined(_MSC_VER) && !defined(__clang__) // MSVC
-    __assume(false);
-#else // GCC, Clang
-    __builtin_unreachable();
-#endif
-}
+// ____________________ IMPLEMENTATION ____________________
 
-// =======================
-// --- Utility Classes ---
-// =======================
+namespace utl::math {
+
+// ============================
+// --- Implementation Utils ---
+// ============================
+
+// Make SFINAE a bit nicer
+template <bool Cond>
+using _require = std::enable_if_t<Cond, bool>; // makes SFINAE a bit less cumbersome
 
-// Wrapper that allows passing standard set of member types down the CRTP chain
-// (types have to be passed through template args one way or another. Trying to access
-// 'derived_type::value_type' from the CRTP base class will fail, since in order for it to be available
-// the derived class has to be "implemented" which can only happen after the base class is "implemented",
-// which requires the type => a logical loop. So we wrap all the types in a class a pass them down
-// the chain a "pack with everything" type of deal. This pack then gets "unwrapped" with
-// '_utl_storage_define_types' macro in every class => we have all the member types defined).
-//
-// (!) Since CRTP approach has been deprecated in favor of mixins, the original reasoning is no longer
-// accurate, however it is this a useful class whenever a pack of types have to be passed through a
-// template (like, for example, in iterator implementation)
 template <class T>
-struct _types {
-    using value_type      = T;
-    using size_type       = std::size_t;
-    using difference_type = std::ptrdiff_t;
-    using reference       = T&;
-    using const_reference = const T&;
-    using pointer         = T*;
-    using const_pointer   = const T*;
-};
+using _require_arithmetic = _require<std::is_arithmetic_v<T>>;
 
-// A minimal equivalent of the once proposed 'std::observer_ptr<>'.
-// Used in views to allow observer pointers with the same interface as 'std::unique_ptr',
-// which means a generic '.data()` can be implemented without having to make a separate version for views and containers
 template <class T>
-class _observer_ptr {
-public:
-    using element_type = T;
+using _require_integral = _require<std::is_integral_v<T>>;
 
-private:
-    element_type* _data = nullptr;
+template <class T>
+using _require_uint = _require<std::is_integral_v<T> && std::is_unsigned_v<T>>;
 
-public:
-    // - Constructors -
-    constexpr _observer_ptr() noexcept = default;
-    constexpr _observer_ptr(std::nullptr_t) noexcept {}
-    explicit _observer_ptr(element_type* ptr) : _data(ptr) {}
+template <class T>
+using _require_float = _require<std::is_floating_point_v<T>>;
 
-    _observer_ptr& operator=(element_type* ptr) {
-        this->_data = ptr;
-        return *this;
-    }
+template <class Return, class T, class... Args>
+using _require_invocable_r = _require<std::is_invocable_r_v<Return, T, Args...>>;
 
-    // - Interface -
-    [[nodiscard]] constexpr element_type* get() const noexcept { return _data; }
-};
+template <class T, class... Args>
+using _require_invocable = _require<std::is_invocable_v<T, Args...>>;
+
+// ===================
+// --- Type Traits ---
+// ===================
+
+#define utl_math_define_trait(trait_name_, ...)                                                                        \
+    template <class T, class = void>                                                                                   \
+    struct trait_name_ : std::false_type {};                                                                           \
+                                                                                                                       \
+    template <class T>                                                                                                 \
+    struct trait_name_<T, std::void_t<decltype(__VA_ARGS__)>> : std::true_type {};                                     \
+                                                                                                                       \
+    template <class T>                                                                                                 \
+    constexpr bool trait_name_##_v = trait_name_<T>::value;
+
+utl_math_define_trait(has_size, std::declval<T>().size());
+utl_math_define_trait(has_capacity, std::declval<T>().capacity());
+utl_math_define_trait(has_data, std::declval<T>().data());
+utl_math_define_trait(has_value_type, std::declval<typename T::value_type>());
+utl_math_define_trait(has_node_type, std::declval<typename T::node_type>());
+utl_math_define_trait(has_allocator_type, std::declval<typename T::allocator_type>());
+utl_math_define_trait(has_tuple_size, std::tuple_size<T>::value);
+utl_math_define_trait(has_get, std::get<0>(std::declval<T>()));
+
+#undef utl_math_define_trait
 
 // =================
-// --- Iterators ---
+// --- Constants ---
 // =================
 
-// Iterator template for 1D iterator over a tensor.
-// Reduces code duplication for const & non-const variants by bundling some conditional logic.
-// Uses 'operator[]' of 'ParentPointer' for all logic, thus allowing arbitrary tensors that
-// don't have to be contiguous or even ordered in memory.
-template <class ParentPointer, class Types, bool is_const_iter = false>
-class _flat_iterator {
-    using parent_pointer = ParentPointer;
+namespace constants {
 
-public:
-    // Iterator reqs: [General]
-    // Contains member types      =>
-    using iterator_category = std::random_access_iterator_tag;
-    using difference_type   = typename Types::difference_type;
-    using value_type        = typename Types::value_type;
-    using pointer = typename std::conditional_t<is_const_iter, typename Types::const_pointer, typename Types::pointer>;
-    using reference =
-        typename std::conditional_t<is_const_iter, typename Types::const_reference, typename Types::reference>;
+constexpr double pi      = 3.14159265358979323846;
+constexpr double two_pi  = 2. * pi;
+constexpr double half_pi = 0.5 * pi;
+constexpr double e       = 2.71828182845904523536;
+constexpr double phi     = 1.6180339887498948482; // golden ration
 
-    // Iterator reqs: [General]
-    // Constructible
-    _flat_iterator(parent_pointer parent, difference_type idx) : _parent(parent), _idx(idx) {}
-    // Copy-constructible => by default
-    // Copy-assignable    => by default
-    // Destructible       => by default
-    // Swappable
-    friend void swap(_flat_iterator& lhs, _flat_iterator& rhs) { std::swap(lhs._idx, rhs._idx); }
-
-    // Iterator reqs: [General]
-    // Can be incremented (prefix & postfix)
-    _flat_iterator& operator++() {
-        ++_idx;
-        return *this;
-    } // prefix
-    _flat_iterator operator++(int) {
-        _flat_iterator temp = *this;
-        ++_idx;
-        return temp;
-    } // postfix
+} // namespace constants
 
-    // Iterator reqs: [Input iterator]
-    // Supports equality/inequality comparisons
-    friend bool operator==(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx == it2._idx; };
-    friend bool operator!=(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx != it2._idx; };
-    // Can be dereferenced as an rvalue
-    reference   operator*() const { return _parent->operator[](_idx); }
-    pointer     operator->() const { return &_parent->operator[](_idx); }
+// =======================
+// --- Basic functions ---
+// =======================
 
-    // Iterator reqs: [Output iterator]
-    // Can be dereferenced as an lvalue (only for mutable iterator types) => not needed
+template <class T, _require_arithmetic<T> = true>
+[[nodiscard]] constexpr T abs(T x) noexcept {
+    return (x > T(0)) ? x : -x;
+}
 
-    // Iterator reqs: [Forward iterator]
-    // Default-constructible
-    _flat_iterator() : _parent(nullptr), _idx(0) {}
-    // "Multi-pass" - dereferencing & incrementing does not affects dereferenceability => satisfied
+template <class T, _require_arithmetic<T> = true>
+[[nodiscard]] constexpr T sign(T x) noexcept {
+    if constexpr (std::is_unsigned_v<T>) return (x > T(0)) ? T(1) : T(0);
+    else return (x > T(0)) ? T(1) : (x < T(0)) ? T(-1) : T(0);
+} // returns -1 / 0 / 1
 
-    // Iterator reqs: [Bidirectional iterator]
-    // Can be decremented
-    _flat_iterator& operator--() {
-        --_idx;
-        return *this;
-    } // prefix
-    _flat_iterator operator--(int) {
-        _flat_iterator temp = *this;
-        --_idx;
-        return temp;
-    } // postfix
+template <class T, _require_arithmetic<T> = true>
+[[nodiscard]] constexpr T bsign(T x) noexcept {
+    if constexpr (std::is_unsigned_v<T>) return T(1);
+    else return (x >= T(0)) ? T(1) : T(-1);
+} // returns -1 / 1 (1 gets priority in x == 0)
 
-    // Iterator reqs: [Random Access iterator]
-    // See: https://en.cppreference.com/w/cpp/named_req/RandomAccessIterator
-    // Supports arithmetic operators: it + n, n + it, it - n, it1 - it2
-    friend _flat_iterator operator+(const _flat_iterator& it, difference_type diff) {
-        return _flat_iterator(it._parent, it._idx + diff);
-    }
-    friend _flat_iterator operator+(difference_type diff, const _flat_iterator& it) {
-        return _flat_iterator(it._parent, it._idx + diff);
-    }
-    friend _flat_iterator operator-(const _flat_iterator& it, difference_type diff) {
-        return _flat_iterator(it._parent, it._idx - diff);
-    }
-    friend difference_type operator-(const _flat_iterator& it1, const _flat_iterator& it2) {
-        return it1._idx - it2._idx;
-    }
-    // Supports inequality comparisons (<, >, <= and >=) between iterators
-    friend bool     operator<(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx < it2._idx; }
-    friend bool     operator>(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx > it2._idx; }
-    friend bool     operator<=(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx <= it2._idx; }
-    friend bool     operator>=(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx >= it2._idx; }
-    // Standard assumption: Both iterators are from the same container => no need to compare '_parent'
-    // Supports compound assignment operations += and -=
-    _flat_iterator& operator+=(difference_type diff) {
-        _idx += diff;
-        return *this;
-    }
-    _flat_iterator& operator-=(difference_type diff) {
-        _idx -= diff;
-        return *this;
-    }
-    // Supports offset dereference operator ([])
-    reference operator[](difference_type diff) const { return _parent->operator[](_idx + diff); }
+template <class T, _require_arithmetic<T> = true>
+[[nodiscard]] constexpr T sqr(T x) noexcept {
+    return x * x;
+}
 
-private:
-    parent_pointer  _parent;
-    difference_type _idx; // not size_type because we have to use it in 'difference_type' operations most of the time
-};
+template <class T, _require_arithmetic<T> = true>
+[[nodiscard]] constexpr T cube(T x) noexcept {
+    return x * x * x;
+}
 
-// ======================================
-// --- Sparse Matrix Pairs & Triplets ---
-// ======================================
+template <class T, _require_arithmetic<T> = true>
+[[nodiscard]] constexpr T inv(T x) noexcept {
+    return 1. / x; // integers will be cast to float then rounded
+}
 
-// Note:
-// All sparse entries and multi-dimensional indices can be sorted lexicographically
+template <class T, _require_arithmetic<T> = true>
+[[nodiscard]] constexpr T pow(T x, std::size_t p) noexcept {
+    if (p == 0) return T(1);
+    if (p == 1) return x;
+    const T half_pow = pow(x, p / 2);
+    return (p % 2 == 0) ? half_pow * half_pow : half_pow * half_pow * x;
+}
 
-template <class T>
-struct SparseEntry1D {
-    size_t i;
-    T      value;
+template <class T, _require_arithmetic<T> = true>
+[[nodiscard]] constexpr T midpoint(T a, T b) noexcept {
+    return (a + b) * 0.5; // integers will be cast to float then rounded
+}
 
-    constexpr static bool is_sparse_entry_1d = true;
+template <class T, _require_arithmetic<T> = true>
+[[nodiscard]] constexpr T absdiff(T a, T b) noexcept {
+    return (a > b) ? (a - b) : (b - a);
+}
 
-    [[nodiscard]] bool operator<(const SparseEntry1D& other) const noexcept { return this->i < other.i; }
-    [[nodiscard]] bool operator>(const SparseEntry1D& other) const noexcept { return this->i > other.i; }
-};
+[[nodiscard]] constexpr int signpow(int p) noexcept { return (p % 2 == 0) ? 1 : -1; }
 
-template <class T>
-struct SparseEntry2D {
-    size_t i;
-    size_t j;
-    T      value;
+// ===========================
+// --- Indicator functions ---
+// ===========================
 
-    constexpr static bool is_sparse_entry_2d = true;
+template <class T, _require_arithmetic<T> = true>
+[[nodiscard]] constexpr T heaviside(T x) noexcept {
+    return static_cast<T>(x > T(0));
+}
 
-    [[nodiscard]] bool operator<(const SparseEntry2D& other) const noexcept {
-        return (this->i < other.i) || (this->j < other.j);
-    }
-    [[nodiscard]] bool operator>(const SparseEntry2D& other) const noexcept {
-        return (this->i > other.i) || (this->j > other.j);
-    }
-};
+template <class T, _require_integral<T> = true>
+[[nodiscard]] constexpr T kronecker_delta(T i, T j) noexcept {
+    return (i == j) ? T(1) : T(0);
+}
 
-struct Index2D {
-    size_t i;
-    size_t j;
+template <class T, _require_integral<T> = true>
+[[nodiscard]] constexpr T levi_civita(T i, T j, T k) noexcept {
+    if (i == j || j == k || k == i) return T(0);
+    const std::size_t inversions = (i > j) + (i > k) + (j > k);
+    return (inversions % 2 == 0) ? T(1) : T(-1);
+}
 
-    [[nodiscard]] bool operator<(const Index2D& other) const noexcept {
-        return (this->i < other.i) || (this->j < other.j);
-    }
-    [[nodiscard]] bool operator>(const Index2D& other) const noexcept {
-        return (this->i > other.i) || (this->j > other.j);
-    }
-    [[nodiscard]] bool operator==(const Index2D& other) const noexcept {
-        return (this->i == other.i) && (this->j == other.j);
-    }
-};
+// ===========================
+// --- Degrees and radians ---
+// ===========================
 
-// Functions that take 2 sparse entries '{ i, j, v1 }' and '{ i, j, v2 }' and return '{ i, j, op(v1, v2) }'.
-// Same thing for 1D sparse entries. LHS/RHS index correctness only gets checked in debug.
-//
-// Declaring these functions saves us from having to duplicate implementations of 'apply_binary_operator()'
-// for 1D and 2D sparse entries that have different number of constructor args. Instead, those cases will
-// be handled by '_apply_binary_op_to_sparse_entry()' that is SFINAE-overloaded to work with both.
-//
-// Implementations use perfect forwarding for everything and do the "overloading" through SFINAE with type traits.
-//
-// In reality 'op' doesn't ever get forwarded as an r-value but since are doing things generic why not forward it
-// properly as well. This is also somewhat ugly, but it works well enough and there isn't much reason to rewrite
-// this with some new abstraction.
-//
-template <class L, class R, class Op, _is_sparse_entry_1d_enable_if<L> = true, _is_sparse_entry_1d_enable_if<R> = true>
-std::decay_t<L> _apply_binary_op_to_sparse_entries(L&& left, R&& right, Op&& op) {
-    utl_mvl_assert(left.i == right.i);
-    return {left.i, std::forward<Op>(op)(std::forward<L>(left).value, std::forward<R>(right).value)};
+// Degree <-> radian conversion
+template <class T, _require_float<T> = true>
+[[nodiscard]] constexpr T deg_to_rad(T degrees) noexcept {
+    constexpr T factor = T(constants::pi / 180.);
+    return degrees * factor;
 }
 
-template <class L, class R, class Op, _is_sparse_entry_2d_enable_if<L> = true, _is_sparse_entry_2d_enable_if<R> = true>
-std::decay_t<L> _apply_binary_op_to_sparse_entries(L&& left, R&& right, Op&& op) {
-    utl_mvl_assert(left.i == right.i);
-    utl_mvl_assert(left.j == right.j);
-    return {left.i, left.j, std::forward<Op>(op)(std::forward<L>(left).value, std::forward<R>(right).value)};
+template <class T, _require_float<T> = true>
+[[nodiscard]] constexpr T rad_to_deg(T radians) noexcept {
+    constexpr T factor = T(180. / constants::pi);
+    return radians * factor;
 }
 
-template <class L, class R, class Op, _is_sparse_entry_1d_enable_if<L> = true>
-std::decay_t<L> _apply_binary_op_to_sparse_entry_and_value(L&& left, R&& right_value, Op&& op) {
-    return {left.i, std::forward<Op>(op)(std::forward<L>(left).value, std::forward<R>(right_value))};
+// ===========================
+// --- Sequence operations ---
+// ===========================
+
+template <class Idx, class Func, _require_invocable<Func, Idx> = true>
+[[nodiscard]] constexpr auto sum(Idx low, Idx high, Func&& func) noexcept(noexcept(func(Idx{}))) {
+    assert(low <= high);
+    std::invoke_result_t<Func, Idx> res = 0;
+    for (Idx i = low; i <= high; ++i) res += func(i);
+    return res;
 }
 
-template <class L, class R, class Op, _is_sparse_entry_2d_enable_if<L> = true>
-std::decay_t<L> _apply_binary_op_to_sparse_entry_and_value(L&& left, R&& right_value, Op&& op) {
-    return {left.i, left.j, std::forward<Op>(op)(std::forward<L>(left).value, std::forward<R>(right_value))};
+template <class Idx, class Func, _require_invocable<Func, Idx> = true>
+[[nodiscard]] constexpr auto prod(Idx low, Idx high, Func&& func) noexcept(noexcept(func(Idx{}))) {
+    assert(low <= high);
+    std::invoke_result_t<Func, Idx> res = 1;
+    for (Idx i = low; i <= high; ++i) res *= func(i);
+    return res;
 }
 
-template <class L, class R, class Op, _is_sparse_entry_1d_enable_if<R> = true>
-std::decay_t<R> _apply_binary_op_to_value_and_sparse_entry(L&& left_value, R&& right, Op&& op) {
-    return {right.i, std::forward<Op>(op)(std::forward<L>(left_value), std::forward<R>(right).value)};
+// ==================
+// --- Indexation ---
+// ==================
+
+// Same thing as C++20 ssize()
+template <class T, _require<has_size_v<T>> = true>
+[[nodiscard]] constexpr auto ssize(const T& container) {
+    using return_type = std::common_type_t<std::ptrdiff_t, std::make_signed_t<decltype(container.size())>>;
+    return static_cast<return_type>(container.size());
 }
 
-template <class L, class R, class Op, _is_sparse_entry_2d_enable_if<R> = true>
-std::decay_t<R> _apply_binary_op_to_value_and_sparse_entry(L&& left_value, R&& right, Op&& op) {
-    return {right.i, right.j, std::forward<Op>(op)(std::forward<L>(left_value), std::forward<R>(right).value)};
+// Utility used to reverse indexation logic, mostly useful when working with unsigned indices
+template <class T, _require_integral<T> = true>
+[[nodiscard]] constexpr T reverse_idx(T idx, T size) noexcept {
+    return size - T(1) - idx;
 }
 
-// TODO:
-// Fix binary ops, figure out what the hell did I even do here
+// ====================
+// --- Permutations ---
+// ====================
 
-// =============
-// --- Enums ---
-// =============
-
-// Parameter enums
-//
-// Their combination specifies compiled tensor API.
-enum class Dimension { VECTOR, MATRIX };
-enum class Type { DENSE, STRIDED, SPARSE };
-enum class Ownership { CONTAINER, VIEW, CONST_VIEW };
+template <class Array>
+bool is_permutation(const Array& array) {
+    std::vector<std::size_t> p(array.size()); // Note: "non-allocating range adapter" would fit like a glove here
+    for (std::size_t i = 0; i < p.size(); ++i) p[i] = i;
 
-// Config enums
-//
-// They specify conditional logic for a tensor.
-// Combination of config & parameter enums fully defines a GenericTensor.
-enum class Checking { NONE, BOUNDS };
-enum class Layout { /* 1D */ FLAT, /* 2D */ RC, CR, /* Other */ SPARSE };
+    return std::is_permutation(array.begin(), array.end(), p.begin()); // I'm surprised it exists in the standard
+}
 
-// Shortcut template used to deduce type of '_data' based on tensor 'ownership' parameter
-template <Ownership ownership, class ContainerResult, class ViewResult, class ConstViewResult>
-using _choose_based_on_ownership =
-    std::conditional_t<ownership == Ownership::CONTAINER, ContainerResult,
-                       std::conditional_t<ownership == Ownership::VIEW, ViewResult, ConstViewResult>>;
+template <class Array, class Permutation = std::initializer_list<std::size_t>>
+void apply_permutation(Array& array, const Permutation& permutation) {
+    Array res(array.size());
 
-// Shortcut template used to check that both arguments are tensors
-// that have the same value type, mostly used in binary operators
-// for nicer error messages and to prevent accidental conversions
-template <class L, class R>
-using _are_tensors_with_same_value_type_enable_if =
-    std::enable_if_t<_is_tensor_v<L> && _is_tensor_v<R> &&
-                         std::is_same_v<typename std::decay_t<L>::value_type, typename std::decay_t<R>::value_type>,
-                     bool>;
+    typename Array::size_type emplace_idx = 0;
+    for (auto i : permutation) res[emplace_idx++] = std::move(array[i]);
+    array = std::move(res);
+}
 
-// =====================================
-// --- Boilerplate generation macros ---
-// =====================================
+template <class Array, class Cmp = std::less<>>
+std::vector<std::size_t> sorting_permutation(const Array& array, Cmp cmp = Cmp()) {
+    std::vector<std::size_t> permutation(array.size());
+    for (std::size_t i = 0; i < permutation.size(); ++i) permutation[i] = i;
 
-// Macros used to pass around unwieldy chains of tensor template arguments.
-//
-#define utl_mvl_tensor_arg_defs                                                                                        \
-    class T, Dimension _dimension, Type _type, Ownership _ownership, Checking _checking, Layout _layout
+    std::sort(permutation.begin(), permutation.end(),
+              [&](const auto& lhs, const auto& rhs) { return cmp(array[lhs], array[rhs]); });
 
-#define utl_mvl_tensor_arg_vals T, _dimension, _type, _ownership, _checking, _layout
+    return permutation;
+}
 
-// Incredibly important macros used for conditional compilation of member functions.
-// They automatically create the boilerplate that makes member functions dependant on the template parameters,
-// which is necessary for conditional compilation and "forward" to a 'enable_if' condition.
-//
-// 'utl_mvl_require' is intended to be used inside template methods (template in a sense that they have other template
-// args besides this conditional compilation boilerplate which technically makes all methods template).
-//
-// 'utl_mvl_reqs' is used when we want only conditional compilation (aka majority of cases) and cuts down on
-// boilerplate even more.
-//
-#define utl_mvl_require(condition_)                                                                                    \
-    class value_type = T, Dimension dimension = _dimension, Type type = _type, Ownership ownership = _ownership,       \
-          Checking checking = _checking, Layout layout = _layout, std::enable_if_t<condition_, bool> = true
+template <class Array, class... SyncedArrays>
+void sort_together(Array& array, SyncedArrays&... synced_arrays) {
+    // Get permutation that would make the 1st array sorted
+    const auto permutation = sorting_permutation(array);
 
-#define utl_mvl_reqs(condition_) template <utl_mvl_require(condition_)>
+    // Apply permutation to all arrays to "sort them in sync"
+    apply_permutation(array, permutation);
+    (apply_permutation(synced_arrays, permutation), ...);
+}
 
-// A somewhat scuffed version of trait-defining macro used to create SFINAE-restrictions
-// on tensor params in free functions. Only supports trivial conditions of the form
-// '<parameter> [==][!=] <value>'. Perhaps there is a better way of doing it, but I'm not yet sure.
-//
-// Used mostly to restrict linear algebra operations for sparse/nonsparse so we can get
-// a "SFINAE-driven overloading" on operators that take both arguments with perfect forwarding,
-// which means they can't be overloaded in a regular way
-//
-#define utl_mvl_define_tensor_param_restriction(trait_name_, expr_)                                                    \
-    template <class T>                                                                                                 \
-    constexpr bool trait_name_##_v = (std::decay_t<T>::params::expr_);                                                 \
-                                                                                                                       \
-    template <class T>                                                                                                 \
-    using trait_name_##_enable_if = std::enable_if_t<trait_name_##_v<T>, bool>;
+// ==========================
+// --- Branchless ternary ---
+// ==========================
 
-utl_mvl_define_tensor_param_restriction(_is_sparse_tensor, type == Type::SPARSE);
-utl_mvl_define_tensor_param_restriction(_is_nonsparse_tensor, type != Type::SPARSE);
-utl_mvl_define_tensor_param_restriction(_is_matrix_tensor, dimension == Dimension::MATRIX);
+template <class T, _require_arithmetic<T> = true>
+[[nodiscard]] constexpr T ternary_branchless(bool condition, T return_if_true, T return_if_false) noexcept {
+    return (condition * return_if_true) + (!condition * return_if_false);
+}
 
-// ===========================
-// --- Data Member Classes ---
-// ===========================
+template <class T, _require_integral<T> = true>
+[[nodiscard]] constexpr T ternary_bitselect(bool condition, T return_if_true, T return_if_false) noexcept {
+    return (return_if_true & -T(condition)) | (return_if_false & ~(-T(condition)));
+}
 
-// Unlike class method, member values can't be templated, which prevents us from using regular 'enable_if_t' SFINAE
-// for their conditional compilation. The (seemingly) best workaround to compile members conditionally is to inherit
-// 'std::conditional<T, EmptyClass>' where 'T' is a "dummy" class with the sole purpose of having data members to
-// inherit. This does not introduce virtualization (which is good, that how we want it).
+template <class T, _require_integral<T> = true>
+[[nodiscard]] constexpr T ternary_bitselect(bool condition, T return_if_true /* returns 0 if false*/) noexcept {
+    return return_if_true & -T(condition);
+}
 
-template <int id>
-struct _nothing {};
+// ===============
+// --- Meshing ---
+// ===============
 
-template <utl_mvl_tensor_arg_defs>
-class _2d_extents {
-private:
-    using size_type = typename _types<T>::size_type;
+// Semantic helpers that allow user to directly pass both interval/point counts for grid subdivision,
+// without thinking about whether function need +1 or -1 to its argument
+struct Points {
+    std::size_t count;
 
-public:
-    size_type _rows = 0;
-    size_type _cols = 0;
+    Points() = delete;
+    constexpr explicit Points(std::size_t count) noexcept : count(count) {}
 };
 
-template <utl_mvl_tensor_arg_defs>
-class _2d_strides {
-private:
-    using size_type = typename _types<T>::size_type;
+struct Intervals {
+    std::size_t count;
 
-public:
-    size_type _row_stride = 0;
-    size_type _col_stride = 0;
+    Intervals() = delete;
+    constexpr explicit Intervals(std::size_t count) noexcept : count(count) {}
+    constexpr Intervals(Points points) noexcept : count(points.count > 0 ? points.count - 1 : 0) {}
 };
 
-template <utl_mvl_tensor_arg_defs>
-struct _2d_dense_data {
-private:
-    using value_type = typename _types<T>::value_type;
-    using _data_t    = _choose_based_on_ownership<_ownership, std::unique_ptr<value_type[]>, _observer_ptr<value_type>,
-                                               _observer_ptr<const value_type>>;
-
-public:
-    _data_t _data;
-};
+// Linear 1D mesh
+template <class T, _require_float<T> = true>
+[[nodiscard]] std::vector<T> linspace(T L1, T L2, Intervals N) {
+    assert(L1 < L2);
+    assert(N.count >= 1);
 
-template <utl_mvl_tensor_arg_defs>
-struct _2d_sparse_data {
-private:
-    using value_type = typename _types<T>::value_type;
-    using _triplet_t = _choose_based_on_ownership<_ownership, SparseEntry2D<value_type>,
-                                                  SparseEntry2D<std::reference_wrapper<value_type>>,
-                                                  SparseEntry2D<std::reference_wrapper<const value_type>>>;
+    std::vector<T> res(N.count + 1);
+    for (std::size_t i = 0; i < res.size(); ++i) res[i] = i * (L2 - L1) / N.count;
+    return res;
+}
 
-public:
-    using triplet_type = _triplet_t;
+// Chebyshev 1D mesh
+template <class T, _require_float<T> = true>
+[[nodiscard]] std::vector<T> chebspace(T L1, T L2, Intervals N) {
+    assert(L1 < L2);
+    assert(N.count >= 1);
 
-    std::vector<triplet_type> _data;
-};
+    std::vector<T> res(N.count + 1);
+    res.front() = L2;
+    for (std::size_t i = 1; i < res.size() - 1; ++i) {
+        const std::size_t n  = res.size() - 2;
+        const T           c1 = T(0.5) * (L2 + L1);
+        const T           c2 = T(0.5) * (L2 - L1);
+        const T           c3 = constants::pi * (2 * i - 1) / (2 * n);
+        res[i]               = c1 + c2 * std::cos(c3);
+    }
+    res.back() = L1;
 
-// ===================
-// --- Tensor Type ---
-// ===================
+    std::reverse(res.begin(), res.end()); // standard formula goes from '1' to '-1', we want things sorted
+    return res;
+}
 
-template <utl_mvl_tensor_arg_defs>
-class GenericTensor
-    // Conditionally compile member variables through inheritance
-    : public std::conditional_t<_dimension == Dimension::MATRIX, _2d_extents<utl_mvl_tensor_arg_vals>, _nothing<1>>,
-      public std::conditional_t<_dimension == Dimension::MATRIX && _type == Type::STRIDED,
-                                _2d_strides<utl_mvl_tensor_arg_vals>, _nothing<2>>,
-      public std::conditional_t<_type == Type::DENSE || _type == Type::STRIDED, _2d_dense_data<utl_mvl_tensor_arg_vals>,
-                                _nothing<3>>,
-      public std::conditional_t<_type == Type::SPARSE, _2d_sparse_data<utl_mvl_tensor_arg_vals>, _nothing<4>>
-// > After this point no non-static member variables will be introduced
-{
-    // --- Parameter reflection ---
-    // ----------------------------
-public:
-    struct params {
-        constexpr static auto dimension = _dimension;
-        constexpr static auto type      = _type;
-        constexpr static auto ownership = _ownership;
-        constexpr static auto checking  = _checking;
-        constexpr static auto layout    = _layout;
+template <class T, class Func, _require_float<T> = true, _require_invocable_r<T, Func, T> = true>
+[[nodiscard]] T integrate_trapezoidal(Func&& f, T L1, T L2, Intervals N) {
+    assert(L1 < L2);
+    assert(N.count >= 1);
 
-        // Prevent impossible layouts
-        static_assert((dimension == Dimension::VECTOR) == (layout == Layout::FLAT), "Flat layout <=> matrix is 1D.");
-        static_assert((type == Type::SPARSE) == (layout == Layout::SPARSE), "Sparse layout <=> matrix is sparse.");
-    };
+    const T step = (L2 - L1) / N.count;
 
-    constexpr static bool is_tensor = true;
+    T sum = 0;
+    T x   = L1;
 
-    // --- Member types ---
-    // --------------------
-private:
-    using _type_wrapper = _types<T>;
+    for (std::size_t i = 0; i < N.count; ++i, x += step) sum += f(x) + f(x + step);
 
-public:
-    using self            = GenericTensor;
-    using value_type      = typename _type_wrapper::value_type;
-    using size_type       = typename _type_wrapper::size_type;
-    using difference_type = typename _type_wrapper::difference_type;
-    using reference       = typename _type_wrapper::reference;
-    using const_reference = typename _type_wrapper::const_reference;
-    using pointer         = typename _type_wrapper::pointer;
-    using const_pointer   = typename _type_wrapper::const_pointer;
+    return T(0.5) * sum * step;
+}
 
-    using owning_reflection = GenericTensor<value_type, params::dimension, params::type, Ownership::CONTAINER,
-                                            params::checking, params::layout>;
-    // container type corresponding to 'self', this is the return type of algebraic operations on a tensor
+// ====================
+// --- Memory usage ---
+// ====================
 
-    // --- Iterators ---
-    // -----------------
-public:
-    using const_iterator         = _flat_iterator<const self*, _type_wrapper, true>;
-    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
-
-    using iterator = std::conditional_t<_ownership != Ownership::CONST_VIEW, _flat_iterator<self*, _type_wrapper>,
-                                        const_iterator>; // for const views 'iterator' is the same as 'const_iterator'
-    using reverse_iterator = std::reverse_iterator<iterator>;
-
-    [[nodiscard]] const_iterator cbegin() const { return const_iterator(this, 0); }
-    [[nodiscard]] const_iterator cend() const { return const_iterator(this, this->size()); }
-    [[nodiscard]] const_iterator begin() const { return this->cbegin(); }
-    [[nodiscard]] const_iterator end() const { return this->cend(); }
-
-    [[nodiscard]] const_reverse_iterator crbegin() const { return const_reverse_iterator(this->cend()); }
-    [[nodiscard]] const_reverse_iterator crend() const { return const_reverse_iterator(this->cbegin()); }
-    [[nodiscard]] const_reverse_iterator rbegin() const { return this->crbegin(); }
-    [[nodiscard]] const_reverse_iterator rend() const { return this->crend(); }
-
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW) [[nodiscard]] iterator begin() { return iterator(this, 0); }
-
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW) [[nodiscard]] iterator end() {
-        return iterator(this, this->size());
-    }
-
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW) [[nodiscard]] reverse_iterator rbegin() {
-        return reverse_iterator(this->end());
-    }
+// Below are a few methods to do inaccurate but nonintrusive estimates of containers
+// memory usage, we can't really count anything accurately without intrusively knowing implementation
+// or providing a custom allocator that gathers statistics, nor can we distinguish heap usage from
+// stack usage, however we can get "good enough" estimates to know if something is relatively "big" or
+// "small" which is often quite handy for testing & debugging.
+//
+// Note 1: Node-based containers can be slightly inaccurate due to specifics of node allocation.
+//
+// Note 2: Contiguous containers should be accurate.
+//
+// Note 3:
+// Estimates for 'std::list', 'std::queue', 'std::dequeue', 'std::priority_queue' are quite inaccurate since unlike
+// node-based containers they don't expose the underlying node type to the user, we can only count actual content.
 
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW) [[nodiscard]] reverse_iterator rend() {
-        return reverse_iterator(this->begin());
-    }
+enum class MemoryUnit { BYTE, KiB, MiB, GiB, TiB, KB, MB, GB, TB };
 
-    // --- Basic getters ---
-    // ---------------------
-public:
-    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
-        [[nodiscard]] size_type size() const noexcept {
-        return this->rows() * this->cols();
-    }
+// Workaround for 'static_assert(false)' making program ill-formed even when placed inside an 'if constexpr' branch
+// that never compiles. 'static_assert(_always_false_v<T>)' on the the other hand delays its evaluation and works as
+// we would want. This is super-well known, this comment just explains the basics should I have amnesia in the future.
+template <MemoryUnit units>
+constexpr bool _always_false_mem_v = false;
 
-    utl_mvl_reqs(type == Type::SPARSE) [[nodiscard]] size_type size() const noexcept { return this->_data.size(); }
+template <class T, class Func>
+constexpr void _tuple_for_each(T&& tuple, Func&& func) {
+    std::apply([&func](auto&&... args) { (func(std::forward<decltype(args)>(args)), ...); }, std::forward<T>(tuple));
+}
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX) [[nodiscard]] size_type rows() const noexcept { return this->_rows; }
+template <MemoryUnit units = MemoryUnit::MiB>
+[[nodiscard]] constexpr double to_memory_units(std::size_t bytes) noexcept {
+    if constexpr (units == MemoryUnit::BYTE) return bytes;
+    else if constexpr (units == MemoryUnit::KiB) return bytes / 1024.;
+    else if constexpr (units == MemoryUnit::MiB) return bytes / 1024. / 1024.;
+    else if constexpr (units == MemoryUnit::GiB) return bytes / 1024. / 1024. / 1024.;
+    else if constexpr (units == MemoryUnit::TiB) return bytes / 1024. / 1024. / 1024. / 1024.;
+    else if constexpr (units == MemoryUnit::KB) return bytes / 1000.;
+    else if constexpr (units == MemoryUnit::MB) return bytes / 1000. / 1000.;
+    else if constexpr (units == MemoryUnit::GB) return bytes / 1000. / 1000. / 1000.;
+    else if constexpr (units == MemoryUnit::TB) return bytes / 1000. / 1000. / 1000. / 1000.;
+    else static_assert(_always_false_mem_v<units>, "Function is a non-exhaustive visitor of enum class {MemoryUnit}.");
+}
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX) [[nodiscard]] size_type cols() const noexcept { return this->_cols; }
+// Quick memory usage estimate, doesn't iterate containers and doesn't try to expand
+// recursively, gives the best guess it can get by just querying the size
+template <MemoryUnit units = MemoryUnit::MiB, class T>
+[[nodiscard]] constexpr double quick_memory_estimate(const T& value) {
+    std::size_t bytes{};
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE) [[nodiscard]] constexpr size_type
-        row_stride() const noexcept {
-        if constexpr (self::params::layout == Layout::RC) return 0;
-        if constexpr (self::params::layout == Layout::CR) return 1;
-        _unreachable();
+    // Node-based containers with size
+    // (like 'std::map', 'std::unordered_map', 'std::set', 'std::unordered_set')
+    if constexpr (has_size_v<T> && has_node_type_v<T>) {
+        bytes += sizeof(T);
+        bytes += value.size() * sizeof(typename T::node_type);
     }
-
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE) [[nodiscard]] constexpr size_type
-        col_stride() const noexcept {
-        if constexpr (self::params::layout == Layout::RC) return 1;
-        if constexpr (self::params::layout == Layout::CR) return 0;
-        _unreachable();
+    // Contiguous containers with static size
+    // (like 'std::array')
+    else if constexpr (has_data_v<T> && has_tuple_size_v<T> && has_value_type_v<T>) {
+        // counting 'sizeof(T)' here would likely lead to double-counting the same elements
+        bytes += std::tuple_size_v<T> * sizeof(typename T::value_type);
     }
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED) [[nodiscard]] size_type
-        row_stride() const noexcept {
-        return this->_row_stride;
+    // Contiguous containers with dynamic capacity
+    // (like 'std::vector', 'std::string' and most custom ones)
+    else if constexpr (has_data_v<T> && has_capacity_v<T> && has_value_type_v<T>) {
+        bytes += sizeof(T);
+        bytes += value.capacity() * sizeof(typename T::value_type);
     }
-
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED) [[nodiscard]] size_type
-        col_stride() const noexcept {
-        return this->_col_stride;
+    // Contiguous containers with dynamic size
+    // (like 'std::list', 'std::queue', 'std::dequeue', 'std::priority_queue')
+    else if constexpr (has_data_v<T> && has_size_v<T> && has_value_type_v<T>) {
+        bytes += sizeof(T);
+        bytes += value.size() * sizeof(typename T::value_type);
     }
-
-    utl_mvl_reqs(type == Type::DENSE || type == Type::STRIDED) [[nodiscard]] const_pointer data() const noexcept {
-        return this->_data.get();
+    // Tuple-like types
+    // (like 'std::tuple', 'std::pair')
+    else if constexpr (has_tuple_size_v<T> && has_get_v<T>) {
+        _tuple_for_each(value, [&](auto&& e) { bytes += quick_memory_estimate(e); });
     }
-
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && (type == Type::DENSE || type == Type::STRIDED))
-        [[nodiscard]] pointer data() noexcept {
-        return this->_data.get();
+    // Non-contiguous sized containers
+    // (like 'std::list', 'std::queue', 'std::dequeue', 'std::priority_queue')
+    else if constexpr (has_size_v<T> && has_value_type_v<T>) {
+        bytes += sizeof(T);
+        bytes += value.size() * sizeof(typename T::value_type);
     }
+    // Everything else
+    else {
+        bytes += sizeof(T);
+    };
 
-    [[nodiscard]] bool empty() const noexcept { return (this->size() == 0); }
-
-    // --- Advanced getters ---
-    // ------------------------
-    utl_mvl_reqs(_has_binary_op_equal<value_type>::value) [[nodiscard]] bool contains(const_reference value) const {
-        return std::find(this->cbegin(), this->cend(), value) != this->cend();
-    }
+    return to_memory_units<units>(bytes);
+}
 
-    utl_mvl_reqs(_has_binary_op_equal<value_type>::value) [[nodiscard]] size_type count(const_reference value) const {
-        return std::count(this->cbegin(), this->cend(), value);
-    }
+// TODO:
+// recursive_memory_estimate()
 
-    utl_mvl_reqs(_has_binary_op_less<value_type>::value) [[nodiscard]] bool is_sorted() const {
-        return std::is_sorted(this->cbegin(), this->cend());
-    }
+} // namespace utl::math
 
-    template <class Compare>
-    [[nodiscard]] bool is_sorted(Compare cmp) const {
-        return std::is_sorted(this->cbegin(), this->cend(), cmp);
-    }
+#endif
+#endif // module utl::math
 
-    [[nodiscard]] std::vector<value_type> to_std_vector() const { return std::vector(this->cbegin(), this->cend()); }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE) self transposed() const {
-        self res(this->cols(), this->rows());
-        this->for_each([&](const value_type& element, size_type i, size_type j) { res(j, i) = element; });
-        return res;
-    }
 
-    utl_mvl_reqs(ownership == Ownership::CONTAINER) [[nodiscard]] self clone() const { return *this; }
 
-    utl_mvl_reqs(ownership == Ownership::CONTAINER) [[nodiscard]] self move() & { return std::move(*this); }
 
-    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout>
-    [[nodiscard]] bool
-    compare_contents(const GenericTensor<value_type, self::params::dimension, other_type, other_ownership,
-                                         other_checking, other_layout>& other) const {
-        // Surface-level checks
-        if ((this->rows() != other.rows()) || (this->cols() != other.cols())) return false;
-        // Compare while respecting sparsity
-        constexpr bool is_sparse_l = (self::params::type == Type::SPARSE);
-        constexpr bool is_sparse_r = (std::remove_reference_t<decltype(other)>::params::type == Type::SPARSE);
-        // Same sparsity comparison
-        if constexpr (is_sparse_l == is_sparse_r) {
-            return this->size() == other.size() &&
-                   this->true_for_all([&](const_reference e, size_type i, size_type j) { return e == other(i, j); });
-        }
-        // Different sparsity comparison
-        // TODO: Impl here and use .all_of() OR .any_of()
-        return true;
-    }
 
-    // --- Indexation ---
-    // ------------------
-public:
-    // Vector API
-    [[nodiscard]] const_reference front() const { return this->operator[](0); }
-    [[nodiscard]] const_reference back() const { return this->operator[](this->size() - 1); }
-    [[nodiscard]] reference       front() { return this->operator[](0); }
-    [[nodiscard]] reference       back() { return this->operator[](this->size() - 1); }
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Module:        utl::mvl
+// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_mvl.md
+// Source repo:   https://github.com/DmitriBogdanov/UTL
+//
+// This project is licensed under the MIT License
+//
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-private:
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED) [[nodiscard]] size_type
-        _get_memory_offset_strided_impl(size_type idx, size_type i, size_type j) const {
-        if constexpr (self::params::layout == Layout::RC) return idx * this->col_stride() + this->row_stride() * i;
-        if constexpr (self::params::layout == Layout::CR) return idx * this->row_stride() + this->col_stride() * j;
-        _unreachable();
-    }
+#if !defined(UTL_PICK_MODULES) || defined(UTLMODULE_MVL)
+#ifndef UTLHEADERGUARD_MVL
+#define UTLHEADERGUARD_MVL
 
-public:
-    utl_mvl_reqs(type == Type::DENSE) [[nodiscard]] size_type get_memory_offset_of_idx(size_type idx) const {
-        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(idx);
-        return idx;
-    }
+// _______________________ INCLUDES _______________________
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE) [[nodiscard]] size_type
-        get_memory_offset_of_ij(size_type i, size_type j) const {
-        return this->get_idx_of_ij(i, j);
-    }
+#include <algorithm>        // swap(), find(), count(), is_sorted(), min_element(),
+                            // max_element(), sort(), stable_sort(), min(), max(), remove_if(), copy()
+#include <cassert>          // assert() // Note: Perhaps temporary
+#include <charconv>         // to_chars()
+#include <cmath>            // isfinite()
+#include <cstddef>          // size_t, ptrdiff_t, nullptr_t
+#include <exception>        // exception
+#include <functional>       // reference_wrapper<>, multiplies<>
+#include <initializer_list> // initializer_list<>
+#include <iomanip>          // setw()
+#include <ios>              // right(), boolalpha(), ios::boolalpha
+#include <iterator>         // random_access_iterator_tag, reverse_iterator<>
+#include <memory>           // unique_ptr<>
+#include <numeric>          // accumulate()
+#include <ostream>          // ostream
+#include <sstream>          // ostringstream
+#include <stdexcept>        // out_of_range, invalid_argument
+#include <string>           // string
+#include <string_view>      // string_view<>
+#include <type_traits>      // conditional_t<>, enable_if_t<>, void_t<>, true_type, false_type, remove_reference_t<>
+#include <utility>          // move()
+#include <vector>           // vector<>
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED) [[nodiscard]] size_type
-        get_memory_offset_of_idx(size_type idx) const {
-        const auto ij = this->get_ij_of_idx(idx);
-        return _get_memory_offset_strided_impl(idx, ij.i, ij.j);
-    }
+// ____________________ DEVELOPER DOCS ____________________
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED) [[nodiscard]] size_type
-        get_memory_offset_of_ij(size_type i, size_type j) const {
+// This module tries to implement an "unreasonably flexible yet convenient" template for vectors and matrices,
+// in order to do so we have to rely heavily on either conditional compilation or automatic code generation
+// (or both). There are multiple seemingly viable approaches to it, yet the most of them proved to be either
+// unsuitable or unreasonable from the implementation standpoint. Below is a little rundown of implementations
+// that were attempted and used/discared for various reasons.
+//
+// Currently matrix/vector/view/etc code reuse is implemented though a whole bunch of conditional compilation with
+// SFINAE, abuse of conditional inheritance, conditional types and constexpr if's. While not perfect, this is
+// the best working approach so far. Below is a list of approaches that has been considered & tried:
+//
+// 1) No code reuse, all classes implemented manually - unrealistically cumbersome, huge code duplication
+//
+//    => [-] UNSUITABLE APPROACH
+//
+// 2) Regular OOP with virtual classes - having vtables in lightweight containers is highly undesirable,
+//    we can avoid this using CRTP however we run into issues with multiple inheritance (see below)
+//
+//    => [-] UNSUITABLE APPROACH
+//
+// 3) CRTP - we unavoidably run into multiple inheritance issues (diamond problem) with concepts like:
+//       [mutable-matrix-like] : [const-matrix-like] & [mutable-iterable] where both parents derive from
+//       [const-iterable]
+//
+//    While those issues are resolvable, their handling becomes more and more difficult as parent classes grow larger.
+//    A usual solution for this would be virtual inheritance, however it prevents us from calling derived methods inside
+//    the base class due to "static downcast via virtual inheritance" rule, which makes 'static_cast<Derived*>(this)'
+//    illegal. We can resolve all name collisions manually, however it leads to a code that is absolutely horrific and
+//    easy to mess up.
+//
+//    There is also an issue of extreme boilerplate, since we want to propagate '_types<>' wrapper and the 'Final'
+//    return type to all base classes we end up with extremely unwieldy template arguments that make compile errors and
+//    refactoring a challenge.
+//
+//    => [~] SUITABLE, BUT VERY PROBLEMATIC APPROACH
+//
+// 4) Template-based mixins without CRTP - these allow to add functionality on top of a class, essentially it works
+//    like "inverted" CRTP from the code logic POV. While being almost a perfect solution, it doesn't allow us to
+//    return objects of derived type from base class methods, which is a requirement for the intended matrix API.
+//
+//    => [-] UNSUITABLE APPROACH
+//
+// 5) Macro-based mixins - insert functionality directly in a class, a simple way of doing exactly what we want.
+//    "Mixed-in" methods are simply functions implemented in terms of certain "required" methods.
+//    Doesn't lead to huge template chains and doesn't have any inheritance at all. The main downside is being
+//    preprocessor based, which exposes some identifiers to a global namespace and makes all "connection points"
+//    in logic dependant on correct naming inside macros, rather than actual semantical symbols.
+//
+//    Difficult to work with due to being ignored by the language server, gets increasingly cumbersome as the number of
+//    classes grows and still has significant code duplication (vector/matrix * dense/strided/sparse *
+//    * container/view/const_view = 18 manually created definitions).
+//
+//    => [+-] SUITABLE, BUT HEAVILY FLAWED APPROACH
+//
+// 6) A single class with all pars of API correctly enabled/disabled through SFINAE. Closes thing to a sensible
+//    approach with minimal (basically none) code duplication. However it has a number of non-trivial quirks
+//    when it comes to conditionally compiling member variables, types & functions (every group has a quirk of
+//    its own, functions are the least problematic). Some of such quirks limit possible conditional API (member
+//    types suffer from this) or, for example, prevent use of initialization lists on conditionally compiled
+//    constructors (big sad).
+//
+//    A less obvious downside compared to macros, is that it doesn't get handles as well by the language server
+//    autocomplete - SFINAE-disabled methods still show up as autocomplete suggestions, even if they get marked
+//    as missing immediately upon writing the whole name.
+//
+//    => [+] DIFFICULT, BUT WORKABLE, BEST APPROACH SO FAR
+//
+// NOTES ON SPAN:
+//
+// We can easily implement Matlab-like API to take matrix blocks like this:
+//    matrix(Span{0, 10}, 4)
+// which would be equivalent to
+//    matrix.block(0, 4, 10, 1)
+// we only need a thin 'Span' POD with 2 members and a few overloads for 'operator()' that redirect span
+// to 'this->block(...)'
+//
+// NOTES ON NAMING:
+//
+// Macro naming is a bit of a mess as of now.
+
+// ____________________ IMPLEMENTATION ____________________
+
+namespace utl::mvl {
+
+// ===================
+// --- Type Traits ---
+// ===================
+
+// Macro for generating type traits with all their boilerplate
+//
+// While it'd be nice to avoid macro usage alltogether, having a few macros for generating standardized boilerplate
+// that gets repeated several dozen times DRASTICALLY improves the maintainability of the whole conditional compilation
+// mechanism down the line. They will be later #undef'ed.
+
+#define utl_mvl_define_trait(trait_name_, ...)                                                                         \
+    template <class T, class = void>                                                                                   \
+    struct trait_name_ : std::false_type {};                                                                           \
+                                                                                                                       \
+    template <class T>                                                                                                 \
+    struct trait_name_<T, std::void_t<decltype(__VA_ARGS__)>> : std::true_type {};                                     \
+                                                                                                                       \
+    template <class T>                                                                                                 \
+    constexpr bool trait_name_##_v = trait_name_<T>::value;                                                            \
+                                                                                                                       \
+    template <class T>                                                                                                 \
+    using trait_name_##_enable_if = std::enable_if_t<trait_name_<T>::value, bool>
+
+// Shortcuts for different types of requirements
+
+#define utl_mvl_define_trait_has_binary_op(trait_name_, op_)                                                           \
+    utl_mvl_define_trait(trait_name_, std::declval<std::decay_t<T>>() op_ std::declval<std::decay_t<T>>())
+
+#define utl_mvl_define_trait_has_assignment_op(trait_name_, op_)                                                       \
+    utl_mvl_define_trait(trait_name_, std::declval<std::decay_t<T>&>() op_ std::declval<std::decay_t<T>>())
+// for operators like '+=' lhs should be a reference
+
+#define utl_mvl_define_trait_has_unary_op(trait_name_, op_)                                                            \
+    utl_mvl_define_trait(trait_name_, op_ std::declval<std::decay_t<T>>())
+
+#define utl_mvl_define_trait_has_member(trait_name_, member_)                                                          \
+    utl_mvl_define_trait(trait_name_, std::declval<std::decay_t<T>>().member_)
+
+#define utl_mvl_define_trait_has_member_type(trait_name_, member_)                                                     \
+    utl_mvl_define_trait(trait_name_, std::declval<typename std::decay_t<T>::member_>())
+
+// --- Type traits ---
+// -------------------
+
+utl_mvl_define_trait(_has_ostream_output_op, std::declval<std::ostream>() << std::declval<T>());
+
+utl_mvl_define_trait_has_binary_op(_has_binary_op_plus, +);
+utl_mvl_define_trait_has_binary_op(_has_binary_op_minus, -);
+utl_mvl_define_trait_has_binary_op(_has_binary_op_multiplies, *);
+utl_mvl_define_trait_has_binary_op(_has_binary_op_less, <);
+utl_mvl_define_trait_has_binary_op(_has_binary_op_greater, >);
+utl_mvl_define_trait_has_binary_op(_has_binary_op_equal, ==);
+
+utl_mvl_define_trait_has_assignment_op(_has_assignment_op_plus, +=);
+utl_mvl_define_trait_has_assignment_op(_has_assignment_op_minus, -=);
+utl_mvl_define_trait_has_assignment_op(_has_assignment_op_multiplies, *=);
+
+utl_mvl_define_trait_has_unary_op(_has_unary_op_plus, +);
+utl_mvl_define_trait_has_unary_op(_has_unary_op_minus, -);
+
+utl_mvl_define_trait_has_member(_has_member_i, i);
+utl_mvl_define_trait_has_member(_has_member_j, j);
+utl_mvl_define_trait_has_member(_has_member_value, value);
+
+utl_mvl_define_trait_has_member(_is_tensor, is_tensor);
+utl_mvl_define_trait_has_member(_is_sparse_entry_1d, is_sparse_entry_1d);
+utl_mvl_define_trait_has_member(_is_sparse_entry_2d, is_sparse_entry_2d);
+
+// =======================
+// --- Stringification ---
+// =======================
+
+// Stringification implementation from 'utl::log' module, see its source for more notes.
+
+// --- Internal type traits ---
+// ----------------------------
+
+utl_mvl_define_trait(_has_string_append, std::string() += std::declval<T>());
+utl_mvl_define_trait(_has_real, std::declval<T>().real());
+utl_mvl_define_trait(_has_imag, std::declval<T>().imag());
+utl_mvl_define_trait(_has_begin, std::declval<T>().begin());
+utl_mvl_define_trait(_has_end, std::declval<T>().end());
+utl_mvl_define_trait(_has_input_iter, std::next(std::declval<T>().begin()));
+utl_mvl_define_trait(_has_get, std::get<0>(std::declval<T>()));
+utl_mvl_define_trait(_has_tuple_size, std::tuple_size<T>::value);
+utl_mvl_define_trait(_has_ostream_insert, std::declval<std::ostream>() << std::declval<T>());
+
+// --- Internal utils ---
+// ----------------------
+
+template <class>
+inline constexpr bool _always_false_v = false;
+
+template <class T>
+constexpr int _log_10_ceil(T num) {
+    return num < 10 ? 1 : 1 + _log_10_ceil(num / 10);
+}
+
+template <class T>
+constexpr int _max_float_digits =
+    4 + std::numeric_limits<T>::max_digits10 + std::max(2, _log_10_ceil(std::numeric_limits<T>::max_exponent10));
+
+template <class T>
+constexpr int _max_int_digits = 2 + std::numeric_limits<T>::digits10;
+
+// --- Stringifier ---
+// -------------------
+
+// TODO:
+// Replace or rethink all of this stringifying stuff, perhaps it would be best to just have a super-simple
+// one and let other functions take custom stringifier from 'utl::log'
+
+template <class T>
+void _append_stringified(std::string& str, const T& value);
+
+inline void _append_stringified_bool(std::string& str, bool value) { str += value ? "true" : "false"; }
+
+template <class T>
+void _append_stringified_integer(std::string& str, T value) {
+    std::array<char, _max_int_digits<T>> buffer;
+    const auto [number_end_ptr, error_code] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    if (error_code != std::errc())
+        throw std::runtime_error(
+            "Integer stringification encountered std::to_chars() formatting error while serializing a value.");
+    str.append(buffer.data(), number_end_ptr - buffer.data());
+}
+
+template <class T>
+void _append_stringified_float(std::string& str, T value) {
+    std::array<char, _max_float_digits<T>> buffer;
+    const auto [number_end_ptr, error_code] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    if (error_code != std::errc())
+        throw std::runtime_error(
+            "Float stringification encountered std::to_chars() formatting error while serializing a value.");
+    str.append(buffer.data(), number_end_ptr - buffer.data());
+}
+
+template <class T>
+void _append_stringified_complex(std::string& str, T value) {
+    _append_stringified_float(str, value.real());
+    str += " + ";
+    _append_stringified_float(str, value.imag());
+    str += " i";
+}
+
+template <class T>
+void _append_stringified_stringlike(std::string& str, const T& value) {
+    str += value;
+}
+
+template <class T>
+void _append_stringified_string_convertible(std::string& str, const T& value) {
+    str += std::string(value);
+}
+
+template <class T>
+void _append_stringified_array(std::string& str, const T& value) {
+    str += "{ ";
+    if (value.begin() != value.end())
+        for (auto it = value.begin();;) {
+            _append_stringified(str, *it);
+            if (++it == value.end()) break;
+            str += ", ";
+        }
+    str += " }";
+}
+
+template <class Tuple, std::size_t... Idx>
+void _append_stringified_tuple_impl(std::string& str, Tuple value, std::index_sequence<Idx...>) {
+    ((Idx == 0 ? "" : str += ", ", _append_stringified(str, std::get<Idx>(value))), ...);
+}
+
+template <template <class...> class Tuple, class... Args>
+void _append_stringified_tuple(std::string& str, const Tuple<Args...>& value) {
+    str += "< ";
+    _append_stringified_tuple_impl(str, value, std::index_sequence_for<Args...>{});
+    str += " >";
+}
+
+template <class T>
+void _append_stringified_printable(std::string& str, const T& value) {
+    str += (std::ostringstream() << value).str();
+}
+
+// --- Selector ---
+// ----------------
+
+template <class T>
+void _append_stringified(std::string& str, const T& value) {
+    if constexpr (std::is_same_v<T, bool>) _append_stringified_bool(str, value);
+    else if constexpr (std::is_same_v<T, char>) _append_stringified_stringlike(str, value);
+    else if constexpr (std::is_integral_v<T>) _append_stringified_integer(str, value);
+    else if constexpr (std::is_floating_point_v<T>) _append_stringified_float(str, value);
+    else if constexpr (_has_real_v<T> && _has_imag_v<T>) _append_stringified_complex(str, value);
+    else if constexpr (std::is_convertible_v<T, std::string_view>) _append_stringified_stringlike(str, value);
+    else if constexpr (std::is_convertible_v<T, std::string>) _append_stringified_string_convertible(str, value);
+    else if constexpr (_has_begin_v<T> && _has_end_v<T> && _has_input_iter_v<T>) _append_stringified_array(str, value);
+    else if constexpr (_has_get_v<T> && _has_tuple_size_v<T>) _append_stringified_tuple(str, value);
+    else if constexpr (_has_ostream_insert_v<T>) _append_stringified_printable(str, value);
+    else static_assert(_always_false_v<T>, "No valid stringification exists for the type.");
+}
+
+// --- Public API ---
+// ------------------
+
+template <class... Args>
+void append_stringified(std::string& str, Args&&... args) {
+    (_append_stringified(str, std::forward<Args>(args)), ...);
+}
+
+template <class... Args>
+[[nodiscard]] std::string stringify(Args&&... args) {
+    std::string buffer;
+    append_stringified(buffer, std::forward<Args>(args)...);
+    return buffer;
+}
+
+// Override "common special cases" that can be improved relative to a generic implementation
+[[nodiscard]] inline std::string stringify(int value) { return std::to_string(value); }
+[[nodiscard]] inline std::string stringify(long value) { return std::to_string(value); }
+[[nodiscard]] inline std::string stringify(long long value) { return std::to_string(value); }
+[[nodiscard]] inline std::string stringify(unsigned int value) { return std::to_string(value); }
+[[nodiscard]] inline std::string stringify(unsigned long value) { return std::to_string(value); }
+[[nodiscard]] inline std::string stringify(unsigned long long value) { return std::to_string(value); }
+
+// We wrap stringifying function in functor-class so we can use it a default template callable argument.
+// Templates can't infer template parameters from default arguments:
+//
+//    template<class Func>
+//    void do_stuff(Func f = default_f);  // <- CAN'T infer 'Func'
+//
+//    template<class Func = default_functor>
+//    void do_stuff(Func f = Func());     // <- CAN infer 'Func'
+//
+// which is why the "standard" way of doing it (standard as in used by STL containers) is to use functors as default
+// template arguments, if user passes a callable it will override the 'Func' and we get the usual behaviour.
+//
+template <class T>
+struct default_stringifier {
+    [[nodiscard]] std::string operator()(const T& value) const { return stringify(value); }
+};
+
+// ======================
+// --- Codegen Macros ---
+// ======================
+
+#define utl_mvl_assert(condition_) assert(condition_)
+// if (!__VA_ARGS__) throw std::runtime_error("Failed assert on line " + std::to_string(__LINE__))
+
+// ========================
+// --- Helper Functions ---
+// ========================
+
+// Shortcut for lambda-type-based SFINAE.
+//
+// Callables in this module are usually takes as a template type since 'std::function<>' introduces very significant
+// overhead with its type erasure. With template args all lambdas and functors can be nicely inlined, however we lose
+// the ability to overload functions that take callable the way we could with 'std::function<>'.
+//
+// As a workaround we can use SFINAE to reject "overloads" tha don't have a particular signature, effectively achieving
+// the behaviour we need.
+template <class FuncType, class Signature>
+using _has_signature_enable_if = std::enable_if_t<std::is_convertible_v<FuncType, std::function<Signature>>, bool>;
+
+template <class T>
+[[nodiscard]] std::unique_ptr<T[]> _make_unique_ptr_array(size_t size) {
+    return std::unique_ptr<T[]>(new T[size]);
+}
+
+// Marker for unreachable code
+[[noreturn]] inline void _unreachable() {
+// (Implementation from https://en.cppreference.com/w/cpp/utility/unreachable)
+// Use compiler specific extensions if possible.
+// Even if no extension is used, undefined behavior is still raised by
+// an empty function body and the noreturn attribute.
+#if defined(_MSC_VER) && !defined(__clang__) // MSVC
+    __assume(false);
+#else // GCC, Clang
+    __builtin_unreachable();
+#endif
+}
+
+// =======================
+// --- Utility Classes ---
+// =======================
+
+// Wrapper that allows passing standard set of member types down the CRTP chain
+// (types have to be passed through template args one way or another. Trying to access
+// 'derived_type::value_type' from the CRTP base class will fail, since in order for it to be available
+// the derived class has to be "implemented" which can only happen after the base class is "implemented",
+// which requires the type => a logical loop. So we wrap all the types in a class a pass them down
+// the chain a "pack with everything" type of deal. This pack then gets "unwrapped" with
+// '_utl_storage_define_types' macro in every class => we have all the member types defined).
+//
+// (!) Since CRTP approach has been deprecated in favor of mixins, the original reasoning is no longer
+// accurate, however it is this a useful class whenever a pack of types have to be passed through a
+// template (like, for example, in iterator implementation)
+template <class T>
+struct _types {
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T&;
+    using const_reference = const T&;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+};
+
+// A minimal equivalent of the once proposed 'std::observer_ptr<>'.
+// Used in views to allow observer pointers with the same interface as 'std::unique_ptr',
+// which means a generic '.data()` can be implemented without having to make a separate version for views and containers
+template <class T>
+class _observer_ptr {
+public:
+    using element_type = T;
+
+private:
+    element_type* _data = nullptr;
+
+public:
+    // - Constructors -
+    constexpr _observer_ptr() noexcept = default;
+    constexpr _observer_ptr(std::nullptr_t) noexcept {}
+    explicit _observer_ptr(element_type* ptr) : _data(ptr) {}
+
+    _observer_ptr& operator=(element_type* ptr) {
+        this->_data = ptr;
+        return *this;
+    }
+
+    // - Interface -
+    [[nodiscard]] constexpr element_type* get() const noexcept { return _data; }
+};
+
+// =================
+// --- Iterators ---
+// =================
+
+// Iterator template for 1D iterator over a tensor.
+// Reduces code duplication for const & non-const variants by bundling some conditional logic.
+// Uses 'operator[]' of 'ParentPointer' for all logic, thus allowing arbitrary tensors that
+// don't have to be contiguous or even ordered in memory.
+template <class ParentPointer, class Types, bool is_const_iter = false>
+class _flat_iterator {
+    using parent_pointer = ParentPointer;
+
+public:
+    // Iterator reqs: [General]
+    // Contains member types      =>
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type   = typename Types::difference_type;
+    using value_type        = typename Types::value_type;
+    using pointer = typename std::conditional_t<is_const_iter, typename Types::const_pointer, typename Types::pointer>;
+    using reference =
+        typename std::conditional_t<is_const_iter, typename Types::const_reference, typename Types::reference>;
+
+    // Iterator reqs: [General]
+    // Constructible
+    _flat_iterator(parent_pointer parent, difference_type idx) : _parent(parent), _idx(idx) {}
+    // Copy-constructible => by default
+    // Copy-assignable    => by default
+    // Destructible       => by default
+    // Swappable
+    friend void swap(_flat_iterator& lhs, _flat_iterator& rhs) { std::swap(lhs._idx, rhs._idx); }
+
+    // Iterator reqs: [General]
+    // Can be incremented (prefix & postfix)
+    _flat_iterator& operator++() {
+        ++_idx;
+        return *this;
+    } // prefix
+    _flat_iterator operator++(int) {
+        _flat_iterator temp = *this;
+        ++_idx;
+        return temp;
+    } // postfix
+
+    // Iterator reqs: [Input iterator]
+    // Supports equality/inequality comparisons
+    friend bool operator==(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx == it2._idx; };
+    friend bool operator!=(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx != it2._idx; };
+    // Can be dereferenced as an rvalue
+    reference   operator*() const { return _parent->operator[](_idx); }
+    pointer     operator->() const { return &_parent->operator[](_idx); }
+
+    // Iterator reqs: [Output iterator]
+    // Can be dereferenced as an lvalue (only for mutable iterator types) => not needed
+
+    // Iterator reqs: [Forward iterator]
+    // Default-constructible
+    _flat_iterator() : _parent(nullptr), _idx(0) {}
+    // "Multi-pass" - dereferencing & incrementing does not affects dereferenceability => satisfied
+
+    // Iterator reqs: [Bidirectional iterator]
+    // Can be decremented
+    _flat_iterator& operator--() {
+        --_idx;
+        return *this;
+    } // prefix
+    _flat_iterator operator--(int) {
+        _flat_iterator temp = *this;
+        --_idx;
+        return temp;
+    } // postfix
+
+    // Iterator reqs: [Random Access iterator]
+    // See: https://en.cppreference.com/w/cpp/named_req/RandomAccessIterator
+    // Supports arithmetic operators: it + n, n + it, it - n, it1 - it2
+    friend _flat_iterator operator+(const _flat_iterator& it, difference_type diff) {
+        return _flat_iterator(it._parent, it._idx + diff);
+    }
+    friend _flat_iterator operator+(difference_type diff, const _flat_iterator& it) {
+        return _flat_iterator(it._parent, it._idx + diff);
+    }
+    friend _flat_iterator operator-(const _flat_iterator& it, difference_type diff) {
+        return _flat_iterator(it._parent, it._idx - diff);
+    }
+    friend difference_type operator-(const _flat_iterator& it1, const _flat_iterator& it2) {
+        return it1._idx - it2._idx;
+    }
+    // Supports inequality comparisons (<, >, <= and >=) between iterators
+    friend bool     operator<(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx < it2._idx; }
+    friend bool     operator>(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx > it2._idx; }
+    friend bool     operator<=(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx <= it2._idx; }
+    friend bool     operator>=(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx >= it2._idx; }
+    // Standard assumption: Both iterators are from the same container => no need to compare '_parent'
+    // Supports compound assignment operations += and -=
+    _flat_iterator& operator+=(difference_type diff) {
+        _idx += diff;
+        return *this;
+    }
+    _flat_iterator& operator-=(difference_type diff) {
+        _idx -= diff;
+        return *this;
+    }
+    // Supports offset dereference operator ([])
+    reference operator[](difference_type diff) const { return _parent->operator[](_idx + diff); }
+
+private:
+    parent_pointer  _parent;
+    difference_type _idx; // not size_type because we have to use it in 'difference_type' operations most of the time
+};
+
+// ======================================
+// --- Sparse Matrix Pairs & Triplets ---
+// ======================================
+
+// Note:
+// All sparse entries and multi-dimensional indices can be sorted lexicographically
+
+template <class T>
+struct SparseEntry1D {
+    size_t i;
+    T      value;
+
+    constexpr static bool is_sparse_entry_1d = true;
+
+    [[nodiscard]] bool operator<(const SparseEntry1D& other) const noexcept { return this->i < other.i; }
+    [[nodiscard]] bool operator>(const SparseEntry1D& other) const noexcept { return this->i > other.i; }
+};
+
+template <class T>
+struct SparseEntry2D {
+    size_t i;
+    size_t j;
+    T      value;
+
+    constexpr static bool is_sparse_entry_2d = true;
+
+    [[nodiscard]] bool operator<(const SparseEntry2D& other) const noexcept {
+        return (this->i < other.i) || (this->j < other.j);
+    }
+    [[nodiscard]] bool operator>(const SparseEntry2D& other) const noexcept {
+        return (this->i > other.i) || (this->j > other.j);
+    }
+};
+
+struct Index2D {
+    size_t i;
+    size_t j;
+
+    [[nodiscard]] bool operator<(const Index2D& other) const noexcept {
+        return (this->i < other.i) || (this->j < other.j);
+    }
+    [[nodiscard]] bool operator>(const Index2D& other) const noexcept {
+        return (this->i > other.i) || (this->j > other.j);
+    }
+    [[nodiscard]] bool operator==(const Index2D& other) const noexcept {
+        return (this->i == other.i) && (this->j == other.j);
+    }
+};
+
+// Functions that take 2 sparse entries '{ i, j, v1 }' and '{ i, j, v2 }' and return '{ i, j, op(v1, v2) }'.
+// Same thing for 1D sparse entries. LHS/RHS index correctness only gets checked in debug.
+//
+// Declaring these functions saves us from having to duplicate implementations of 'apply_binary_operator()'
+// for 1D and 2D sparse entries that have different number of constructor args. Instead, those cases will
+// be handled by '_apply_binary_op_to_sparse_entry()' that is SFINAE-overloaded to work with both.
+//
+// Implementations use perfect forwarding for everything and do the "overloading" through SFINAE with type traits.
+//
+// In reality 'op' doesn't ever get forwarded as an r-value but since are doing things generic why not forward it
+// properly as well. This is also somewhat ugly, but it works well enough and there isn't much reason to rewrite
+// this with some new abstraction.
+//
+template <class L, class R, class Op, _is_sparse_entry_1d_enable_if<L> = true, _is_sparse_entry_1d_enable_if<R> = true>
+std::decay_t<L> _apply_binary_op_to_sparse_entries(L&& left, R&& right, Op&& op) {
+    utl_mvl_assert(left.i == right.i);
+    return {left.i, std::forward<Op>(op)(std::forward<L>(left).value, std::forward<R>(right).value)};
+}
+
+template <class L, class R, class Op, _is_sparse_entry_2d_enable_if<L> = true, _is_sparse_entry_2d_enable_if<R> = true>
+std::decay_t<L> _apply_binary_op_to_sparse_entries(L&& left, R&& right, Op&& op) {
+    utl_mvl_assert(left.i == right.i);
+    utl_mvl_assert(left.j == right.j);
+    return {left.i, left.j, std::forward<Op>(op)(std::forward<L>(left).value, std::forward<R>(right).value)};
+}
+
+template <class L, class R, class Op, _is_sparse_entry_1d_enable_if<L> = true>
+std::decay_t<L> _apply_binary_op_to_sparse_entry_and_value(L&& left, R&& right_value, Op&& op) {
+    return {left.i, std::forward<Op>(op)(std::forward<L>(left).value, std::forward<R>(right_value))};
+}
+
+template <class L, class R, class Op, _is_sparse_entry_2d_enable_if<L> = true>
+std::decay_t<L> _apply_binary_op_to_sparse_entry_and_value(L&& left, R&& right_value, Op&& op) {
+    return {left.i, left.j, std::forward<Op>(op)(std::forward<L>(left).value, std::forward<R>(right_value))};
+}
+
+template <class L, class R, class Op, _is_sparse_entry_1d_enable_if<R> = true>
+std::decay_t<R> _apply_binary_op_to_value_and_sparse_entry(L&& left_value, R&& right, Op&& op) {
+    return {right.i, std::forward<Op>(op)(std::forward<L>(left_value), std::forward<R>(right).value)};
+}
+
+template <class L, class R, class Op, _is_sparse_entry_2d_enable_if<R> = true>
+std::decay_t<R> _apply_binary_op_to_value_and_sparse_entry(L&& left_value, R&& right, Op&& op) {
+    return {right.i, right.j, std::forward<Op>(op)(std::forward<L>(left_value), std::forward<R>(right).value)};
+}
+
+// TODO:
+// Fix binary ops, figure out what the hell did I even do here
+
+// =============
+// --- Enums ---
+// =============
+
+// Parameter enums
+//
+// Their combination specifies compiled tensor API.
+enum class Dimension { VECTOR, MATRIX };
+enum class Type { DENSE, STRIDED, SPARSE };
+enum class Ownership { CONTAINER, VIEW, CONST_VIEW };
+
+// Config enums
+//
+// They specify conditional logic for a tensor.
+// Combination of config & parameter enums fully defines a GenericTensor.
+enum class Checking { NONE, BOUNDS };
+enum class Layout { /* 1D */ FLAT, /* 2D */ RC, CR, /* Other */ SPARSE };
+
+// Shortcut template used to deduce type of '_data' based on tensor 'ownership' parameter
+template <Ownership ownership, class ContainerResult, class ViewResult, class ConstViewResult>
+using _choose_based_on_ownership =
+    std::conditional_t<ownership == Ownership::CONTAINER, ContainerResult,
+                       std::conditional_t<ownership == Ownership::VIEW, ViewResult, ConstViewResult>>;
+
+// Shortcut template used to check that both arguments are tensors
+// that have the same value type, mostly used in binary operators
+// for nicer error messages and to prevent accidental conversions
+template <class L, class R>
+using _are_tensors_with_same_value_type_enable_if =
+    std::enable_if_t<_is_tensor_v<L> && _is_tensor_v<R> &&
+                         std::is_same_v<typename std::decay_t<L>::value_type, typename std::decay_t<R>::value_type>,
+                     bool>;
+
+// =====================================
+// --- Boilerplate generation macros ---
+// =====================================
+
+// Macros used to pass around unwieldy chains of tensor template arguments.
+//
+#define utl_mvl_tensor_arg_defs                                                                                        \
+    class T, Dimension _dimension, Type _type, Ownership _ownership, Checking _checking, Layout _layout
+
+#define utl_mvl_tensor_arg_vals T, _dimension, _type, _ownership, _checking, _layout
+
+// Incredibly important macros used for conditional compilation of member functions.
+// They automatically create the boilerplate that makes member functions dependant on the template parameters,
+// which is necessary for conditional compilation and "forward" to a 'enable_if' condition.
+//
+// 'utl_mvl_require' is intended to be used inside template methods (template in a sense that they have other template
+// args besides this conditional compilation boilerplate which technically makes all methods template).
+//
+// 'utl_mvl_reqs' is used when we want only conditional compilation (aka majority of cases) and cuts down on
+// boilerplate even more.
+//
+#define utl_mvl_require(condition_)                                                                                    \
+    class value_type = T, Dimension dimension = _dimension, Type type = _type, Ownership ownership = _ownership,       \
+          Checking checking = _checking, Layout layout = _layout, std::enable_if_t<condition_, bool> = true
+
+#define utl_mvl_reqs(condition_) template <utl_mvl_require(condition_)>
+
+// A somewhat scuffed version of trait-defining macro used to create SFINAE-restrictions
+// on tensor params in free functions. Only supports trivial conditions of the form
+// '<parameter> [==][!=] <value>'. Perhaps there is a better way of doing it, but I'm not yet sure.
+//
+// Used mostly to restrict linear algebra operations for sparse/nonsparse so we can get
+// a "SFINAE-driven overloading" on operators that take both arguments with perfect forwarding,
+// which means they can't be overloaded in a regular way
+//
+#define utl_mvl_define_tensor_param_restriction(trait_name_, expr_)                                                    \
+    template <class T>                                                                                                 \
+    constexpr bool trait_name_##_v = (std::decay_t<T>::params::expr_);                                                 \
+                                                                                                                       \
+    template <class T>                                                                                                 \
+    using trait_name_##_enable_if = std::enable_if_t<trait_name_##_v<T>, bool>;
+
+utl_mvl_define_tensor_param_restriction(_is_sparse_tensor, type == Type::SPARSE);
+utl_mvl_define_tensor_param_restriction(_is_nonsparse_tensor, type != Type::SPARSE);
+utl_mvl_define_tensor_param_restriction(_is_matrix_tensor, dimension == Dimension::MATRIX);
+
+// ===========================
+// --- Data Member Classes ---
+// ===========================
+
+// Unlike class method, member values can't be templated, which prevents us from using regular 'enable_if_t' SFINAE
+// for their conditional compilation. The (seemingly) best workaround to compile members conditionally is to inherit
+// 'std::conditional<T, EmptyClass>' where 'T' is a "dummy" class with the sole purpose of having data members to
+// inherit. This does not introduce virtualization (which is good, that how we want it).
+
+template <int id>
+struct _nothing {};
+
+template <utl_mvl_tensor_arg_defs>
+class _2d_extents {
+private:
+    using size_type = typename _types<T>::size_type;
+
+public:
+    size_type _rows = 0;
+    size_type _cols = 0;
+};
+
+template <utl_mvl_tensor_arg_defs>
+class _2d_strides {
+private:
+    using size_type = typename _types<T>::size_type;
+
+public:
+    size_type _row_stride = 0;
+    size_type _col_stride = 0;
+};
+
+template <utl_mvl_tensor_arg_defs>
+struct _2d_dense_data {
+private:
+    using value_type = typename _types<T>::value_type;
+    using _data_t    = _choose_based_on_ownership<_ownership, std::unique_ptr<value_type[]>, _observer_ptr<value_type>,
+                                               _observer_ptr<const value_type>>;
+
+public:
+    _data_t _data;
+};
+
+template <utl_mvl_tensor_arg_defs>
+struct _2d_sparse_data {
+private:
+    using value_type = typename _types<T>::value_type;
+    using _triplet_t = _choose_based_on_ownership<_ownership, SparseEntry2D<value_type>,
+                                                  SparseEntry2D<std::reference_wrapper<value_type>>,
+                                                  SparseEntry2D<std::reference_wrapper<const value_type>>>;
+
+public:
+    using triplet_type = _triplet_t;
+
+    std::vector<triplet_type> _data;
+};
+
+// ===================
+// --- Tensor Type ---
+// ===================
+
+template <utl_mvl_tensor_arg_defs>
+class GenericTensor
+    // Conditionally compile member variables through inheritance
+    : public std::conditional_t<_dimension == Dimension::MATRIX, _2d_extents<utl_mvl_tensor_arg_vals>, _nothing<1>>,
+      public std::conditional_t<_dimension == Dimension::MATRIX && _type == Type::STRIDED,
+                                _2d_strides<utl_mvl_tensor_arg_vals>, _nothing<2>>,
+      public std::conditional_t<_type == Type::DENSE || _type == Type::STRIDED, _2d_dense_data<utl_mvl_tensor_arg_vals>,
+                                _nothing<3>>,
+      public std::conditional_t<_type == Type::SPARSE, _2d_sparse_data<utl_mvl_tensor_arg_vals>, _nothing<4>>
+// > After this point no non-static member variables will be introduced
+{
+    // --- Parameter reflection ---
+    // ----------------------------
+public:
+    struct params {
+        constexpr static auto dimension = _dimension;
+        constexpr static auto type      = _type;
+        constexpr static auto ownership = _ownership;
+        constexpr static auto checking  = _checking;
+        constexpr static auto layout    = _layout;
+
+        // Prevent impossible layouts
+        static_assert((dimension == Dimension::VECTOR) == (layout == Layout::FLAT), "Flat layout <=> matrix is 1D.");
+        static_assert((type == Type::SPARSE) == (layout == Layout::SPARSE), "Sparse layout <=> matrix is sparse.");
+    };
+
+    constexpr static bool is_tensor = true;
+
+    // --- Member types ---
+    // --------------------
+private:
+    using _type_wrapper = _types<T>;
+
+public:
+    using self            = GenericTensor;
+    using value_type      = typename _type_wrapper::value_type;
+    using size_type       = typename _type_wrapper::size_type;
+    using difference_type = typename _type_wrapper::difference_type;
+    using reference       = typename _type_wrapper::reference;
+    using const_reference = typename _type_wrapper::const_reference;
+    using pointer         = typename _type_wrapper::pointer;
+    using const_pointer   = typename _type_wrapper::const_pointer;
+
+    using owning_reflection = GenericTensor<value_type, params::dimension, params::type, Ownership::CONTAINER,
+                                            params::checking, params::layout>;
+    // container type corresponding to 'self', this is the return type of algebraic operations on a tensor
+
+    // --- Iterators ---
+    // -----------------
+public:
+    using const_iterator         = _flat_iterator<const self*, _type_wrapper, true>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    using iterator = std::conditional_t<_ownership != Ownership::CONST_VIEW, _flat_iterator<self*, _type_wrapper>,
+                                        const_iterator>; // for const views 'iterator' is the same as 'const_iterator'
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    [[nodiscard]] const_iterator cbegin() const { return const_iterator(this, 0); }
+    [[nodiscard]] const_iterator cend() const { return const_iterator(this, this->size()); }
+    [[nodiscard]] const_iterator begin() const { return this->cbegin(); }
+    [[nodiscard]] const_iterator end() const { return this->cend(); }
+
+    [[nodiscard]] const_reverse_iterator crbegin() const { return const_reverse_iterator(this->cend()); }
+    [[nodiscard]] const_reverse_iterator crend() const { return const_reverse_iterator(this->cbegin()); }
+    [[nodiscard]] const_reverse_iterator rbegin() const { return this->crbegin(); }
+    [[nodiscard]] const_reverse_iterator rend() const { return this->crend(); }
+
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW) [[nodiscard]] iterator begin() { return iterator(this, 0); }
+
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW) [[nodiscard]] iterator end() {
+        return iterator(this, this->size());
+    }
+
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW) [[nodiscard]] reverse_iterator rbegin() {
+        return reverse_iterator(this->end());
+    }
+
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW) [[nodiscard]] reverse_iterator rend() {
+        return reverse_iterator(this->begin());
+    }
+
+    // --- Basic getters ---
+    // ---------------------
+public:
+    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
+        [[nodiscard]] size_type size() const noexcept {
+        return this->rows() * this->cols();
+    }
+
+    utl_mvl_reqs(type == Type::SPARSE) [[nodiscard]] size_type size() const noexcept { return this->_data.size(); }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX) [[nodiscard]] size_type rows() const noexcept { return this->_rows; }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX) [[nodiscard]] size_type cols() const noexcept { return this->_cols; }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE) [[nodiscard]] constexpr size_type
+        row_stride() const noexcept {
+        if constexpr (self::params::layout == Layout::RC) return 0;
+        if constexpr (self::params::layout == Layout::CR) return 1;
+        _unreachable();
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE) [[nodiscard]] constexpr size_type
+        col_stride() const noexcept {
+        if constexpr (self::params::layout == Layout::RC) return 1;
+        if constexpr (self::params::layout == Layout::CR) return 0;
+        _unreachable();
+    }
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED) [[nodiscard]] size_type
+        row_stride() const noexcept {
+        return this->_row_stride;
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED) [[nodiscard]] size_type
+        col_stride() const noexcept {
+        return this->_col_stride;
+    }
+
+    utl_mvl_reqs(type == Type::DENSE || type == Type::STRIDED) [[nodiscard]] const_pointer data() const noexcept {
+        return this->_data.get();
+    }
+
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && (type == Type::DENSE || type == Type::STRIDED))
+        [[nodiscard]] pointer data() noexcept {
+        return this->_data.get();
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return (this->size() == 0); }
+
+    // --- Advanced getters ---
+    // ------------------------
+    utl_mvl_reqs(_has_binary_op_equal<value_type>::value) [[nodiscard]] bool contains(const_reference value) const {
+        return std::find(this->cbegin(), this->cend(), value) != this->cend();
+    }
+
+    utl_mvl_reqs(_has_binary_op_equal<value_type>::value) [[nodiscard]] size_type count(const_reference value) const {
+        return std::count(this->cbegin(), this->cend(), value);
+    }
+
+    utl_mvl_reqs(_has_binary_op_less<value_type>::value) [[nodiscard]] bool is_sorted() const {
+        return std::is_sorted(this->cbegin(), this->cend());
+    }
+
+    template <class Compare>
+    [[nodiscard]] bool is_sorted(Compare cmp) const {
+        return std::is_sorted(this->cbegin(), this->cend(), cmp);
+    }
+
+    [[nodiscard]] std::vector<value_type> to_std_vector() const { return std::vector(this->cbegin(), this->cend()); }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE) self transposed() const {
+        self res(this->cols(), this->rows());
+        this->for_each([&](const value_type& element, size_type i, size_type j) { res(j, i) = element; });
+        return res;
+    }
+
+    utl_mvl_reqs(ownership == Ownership::CONTAINER) [[nodiscard]] self clone() const { return *this; }
+
+    utl_mvl_reqs(ownership == Ownership::CONTAINER) [[nodiscard]] self move() & { return std::move(*this); }
+
+    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout>
+    [[nodiscard]] bool
+    compare_contents(const GenericTensor<value_type, self::params::dimension, other_type, other_ownership,
+                                         other_checking, other_layout>& other) const {
+        // Surface-level checks
+        if ((this->rows() != other.rows()) || (this->cols() != other.cols())) return false;
+        // Compare while respecting sparsity
+        constexpr bool is_sparse_l = (self::params::type == Type::SPARSE);
+        constexpr bool is_sparse_r = (std::remove_reference_t<decltype(other)>::params::type == Type::SPARSE);
+        // Same sparsity comparison
+        if constexpr (is_sparse_l == is_sparse_r) {
+            return this->size() == other.size() &&
+                   this->true_for_all([&](const_reference e, size_type i, size_type j) { return e == other(i, j); });
+        }
+        // Different sparsity comparison
+        // TODO: Impl here and use .all_of() OR .any_of()
+        return true;
+    }
+
+    // --- Indexation ---
+    // ------------------
+public:
+    // Vector API
+    [[nodiscard]] const_reference front() const { return this->operator[](0); }
+    [[nodiscard]] const_reference back() const { return this->operator[](this->size() - 1); }
+    [[nodiscard]] reference       front() { return this->operator[](0); }
+    [[nodiscard]] reference       back() { return this->operator[](this->size() - 1); }
+
+private:
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED) [[nodiscard]] size_type
+        _get_memory_offset_strided_impl(size_type idx, size_type i, size_type j) const {
+        if constexpr (self::params::layout == Layout::RC) return idx * this->col_stride() + this->row_stride() * i;
+        if constexpr (self::params::layout == Layout::CR) return idx * this->row_stride() + this->col_stride() * j;
+        _unreachable();
+    }
+
+public:
+    utl_mvl_reqs(type == Type::DENSE) [[nodiscard]] size_type get_memory_offset_of_idx(size_type idx) const {
+        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(idx);
+        return idx;
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE) [[nodiscard]] size_type
+        get_memory_offset_of_ij(size_type i, size_type j) const {
+        return this->get_idx_of_ij(i, j);
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED) [[nodiscard]] size_type
+        get_memory_offset_of_idx(size_type idx) const {
+        const auto ij = this->get_ij_of_idx(idx);
+        return _get_memory_offset_strided_impl(idx, ij.i, ij.j);
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED) [[nodiscard]] size_type
+        get_memory_offset_of_ij(size_type i, size_type j) const {
         const auto idx = this->get_idx_of_ij(i, j);
         return _get_memory_offset_strided_impl(idx, i, j);
     }
 
-public:
-    // - Flat indexation -
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && dimension == Dimension::MATRIX &&
-                 (type == Type::DENSE || type == Type::STRIDED)) [[nodiscard]] reference
-    operator[](size_type idx) {
-        return this->data()[this->get_memory_offset_of_idx(idx)];
+public:
+    // - Flat indexation -
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && dimension == Dimension::MATRIX &&
+                 (type == Type::DENSE || type == Type::STRIDED)) [[nodiscard]] reference
+    operator[](size_type idx) {
+        return this->data()[this->get_memory_offset_of_idx(idx)];
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
+        [[nodiscard]] const_reference
+        operator[](size_type idx) const {
+        return this->data()[this->get_memory_offset_of_idx(idx)];
+    }
+
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && dimension == Dimension::VECTOR || type == Type::SPARSE)
+        [[nodiscard]] reference
+        operator[](size_type idx) {
+        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(idx);
+        return this->_data[idx].value;
+    }
+
+    utl_mvl_reqs(dimension == Dimension::VECTOR || type == Type::SPARSE) [[nodiscard]] const_reference
+    operator[](size_type idx) const {
+        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(idx);
+        return this->_data[idx].value;
+    }
+
+    // - 2D indexation -
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && dimension == Dimension::MATRIX &&
+                 (type == Type::DENSE || type == Type::STRIDED)) [[nodiscard]] reference
+    operator()(size_type i, size_type j) {
+        return this->data()[this->get_memory_offset_of_ij(i, j)];
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
+        [[nodiscard]] const_reference
+        operator()(size_type i, size_type j) const {
+        return this->data()[this->get_memory_offset_of_ij(i, j)];
+    }
+
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && dimension == Dimension::MATRIX && type == Type::SPARSE)
+        [[nodiscard]] reference
+        operator()(size_type i, size_type j) {
+        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(i, j);
+        return this->_data[this->get_idx_of_ij(i, j)].value;
+    }
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE) [[nodiscard]] const_reference
+    operator()(size_type i, size_type j) const {
+        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(i, j);
+        return this->_data[this->get_idx_of_ij(i, j)].value;
+    }
+
+    // --- Index conversions ---
+    // -------------------------
+
+    // - Bound checking -
+private:
+    void _bound_check_idx(size_type idx) const {
+        if (idx >= this->size())
+            throw std::out_of_range(
+                stringify("idx (which is ", idx, ") >= this->size() (which is ", this->size(), ")"));
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX) void _bound_check_ij(size_type i, size_type j) const {
+        if (i >= this->rows())
+            throw std::out_of_range(stringify("i (which is ", i, ") >= this->rows() (which is ", this->rows(), ")"));
+        else if (j >= this->cols())
+            throw std::out_of_range(stringify("j (which is ", j, ") >= this->cols() (which is ", this->cols(), ")"));
+    }
+
+    // - Dense & strided implementations -
+private:
+    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
+        [[nodiscard]] size_type _unchecked_get_idx_of_ij(size_type i, size_type j) const {
+        if constexpr (self::params::layout == Layout::RC) return i * this->cols() + j;
+        if constexpr (self::params::layout == Layout::CR) return j * this->rows() + i;
+        _unreachable();
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED)) [[nodiscard]] Index2D
+        _unchecked_get_ij_of_idx(size_type idx) const {
+        if constexpr (self::params::layout == Layout::RC) return {idx / this->cols(), idx % this->cols()};
+        if constexpr (self::params::layout == Layout::CR) return {idx % this->rows(), idx / this->rows()};
+        _unreachable();
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::CONTAINER)
+        [[nodiscard]] size_type _total_allocated_size() const noexcept {
+        // Note 1: Allocated size of the strided matrix is NOT equal to .size() (which is same as rows * cols)
+        // This is due to all the padding between the actual elements
+        // Note 2: The question of whether .size() should return the number of 'strided' elements or the number
+        // of actually allocated elements is rather perplexing, while the second option is more "correct" its
+        // usefulness is dubious at bets, while the first one does in fact allow convenient 1D iteration over
+        // all the elements. Option 1 also provides an API consistent with strided views, which is why it ended
+        // up being the one chosen
+        //
+        // This method returns a true allocated size
+        if constexpr (self::params::layout == Layout::RC)
+            return (this->rows() - 1) * this->row_stride() + this->rows() * this->cols() * this->col_stride();
+        if constexpr (self::params::layout == Layout::CR)
+            return (this->cols() - 1) * this->col_stride() + this->rows() * this->cols() * this->row_stride();
+        _unreachable();
+    }
+
+public:
+    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
+        [[nodiscard]] size_type get_idx_of_ij(size_type i, size_type j) const {
+        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_ij(i, j);
+        return _unchecked_get_idx_of_ij(i, j);
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED)) [[nodiscard]] Index2D
+        get_ij_of_idx(size_type idx) const {
+        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(idx);
+        return _unchecked_get_ij_of_idx(idx);
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
+        [[nodiscard]] size_type extent_major() const noexcept {
+        if constexpr (self::params::layout == Layout::RC) return this->rows();
+        if constexpr (self::params::layout == Layout::CR) return this->cols();
+        _unreachable();
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
+        [[nodiscard]] size_type extent_minor() const noexcept {
+        if constexpr (self::params::layout == Layout::RC) return this->cols();
+        if constexpr (self::params::layout == Layout::CR) return this->rows();
+        _unreachable();
+    }
+
+    // - Sparse implementations -
+private:
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE) [[nodiscard]] size_type
+        _search_ij(size_type i, size_type j) const noexcept {
+        // Returns this->size() if {i, j} wasn't found.
+        // Linear search for small .size() (more efficient fue to prediction and cache locality)
+        if (true) {
+            for (size_type idx = 0; idx < this->size(); ++idx)
+                if (this->_data[idx].i == i && this->_data[idx].j == j) return idx;
+            return this->size();
+        }
+        // TODO: Binary search for larger .size() (N(log2(size)) instead of N(size) asymptotically)
+    }
+
+public:
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE) [[nodiscard]] size_type
+        get_idx_of_ij(size_type i, size_type j) const {
+        const size_type idx = this->_search_ij(i, j);
+        // Return this->size() if {i, j} wasn't found. Throw with bound checking.
+        if constexpr (self::params::checking == Checking::BOUNDS)
+            if (idx == this->size())
+                throw std::out_of_range(stringify("Index { ", i, ", ", j, "} in not a part of sparse matrix"));
+        return idx;
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE) [[nodiscard]] Index2D
+        get_ij_of_idx(size_type idx) const {
+        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(idx);
+        return Index2D{this->_data[idx].i, this->_data[idx].j};
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
+        [[nodiscard]] bool contains_index(size_type i, size_type j) const noexcept {
+        return this->_search_ij(i, j) != this->size();
+    }
+
+    // --- Reductions ---
+    // ------------------
+    utl_mvl_reqs(_has_binary_op_plus<value_type>::value) [[nodiscard]] value_type sum() const {
+        return std::accumulate(this->cbegin(), this->cend(), value_type());
+    }
+
+    utl_mvl_reqs(_has_binary_op_multiplies<value_type>::value) [[nodiscard]] value_type product() const {
+        return std::accumulate(this->cbegin(), this->cend(), value_type(), std::multiplies<value_type>());
+    }
+
+    utl_mvl_reqs(_has_binary_op_less<value_type>::value) [[nodiscard]] value_type min() const {
+        return *std::min_element(this->cbegin(), this->cend());
+    }
+
+    utl_mvl_reqs(_has_binary_op_less<value_type>::value) [[nodiscard]] value_type max() const {
+        return *std::max_element(this->cbegin(), this->cend());
+    }
+
+    // --- Predicate operations ---
+    // ----------------------------
+    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference)> = true>
+    [[nodiscard]] bool true_for_any(PredType predicate) const {
+        for (size_type idx = 0; idx < this->size(); ++idx)
+            if (predicate(this->operator[](idx), idx)) return true;
+        return false;
+    }
+
+    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference, size_type)> = true>
+    [[nodiscard]] bool true_for_any(PredType predicate) const {
+        for (size_type idx = 0; idx < this->size(); ++idx)
+            if (predicate(this->operator[](idx), idx)) return true;
+        return false;
+    }
+
+    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference, size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX)>
+    [[nodiscard]] bool true_for_any(PredType predicate) const {
+        // Loop over all 2D indices using 1D loop with idx->ij conversion
+        // This is just as fast and ensures looping only over existing elements in non-dense matrices
+        for (size_type idx = 0; idx < this->size(); ++idx) {
+            const auto ij = this->get_ij_of_idx(idx);
+            if (predicate(this->operator[](idx), ij.i, ij.j)) return true;
+        }
+        return false;
+    }
+
+    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference)> = true>
+    [[nodiscard]] bool true_for_all(PredType predicate) const {
+        auto inverse_predicate = [&](const_reference e) -> bool { return !predicate(e); };
+        return !this->true_for_any(inverse_predicate);
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
-        [[nodiscard]] const_reference
-        operator[](size_type idx) const {
-        return this->data()[this->get_memory_offset_of_idx(idx)];
+    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference, size_type)> = true>
+    [[nodiscard]] bool true_for_all(PredType predicate) const {
+        auto inverse_predicate = [&](const_reference e, size_type idx) -> bool { return !predicate(e, idx); };
+        return !this->true_for_any(inverse_predicate);
     }
 
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && dimension == Dimension::VECTOR || type == Type::SPARSE)
-        [[nodiscard]] reference
-        operator[](size_type idx) {
-        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(idx);
-        return this->_data[idx].value;
+    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference, size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX)>
+    [[nodiscard]] bool true_for_all(PredType predicate) const {
+        // We can reuse .true_for_any() with inverted predicate due to following conjecture:
+        // FOR_ALL (predicate)  ~  ! FOR_ANY (!predicate)
+        auto inverse_predicate = [&](const_reference e, size_type i, size_type j) -> bool {
+            return !predicate(e, i, j);
+        };
+        return !this->true_for_any(inverse_predicate);
     }
 
-    utl_mvl_reqs(dimension == Dimension::VECTOR || type == Type::SPARSE) [[nodiscard]] const_reference
-    operator[](size_type idx) const {
-        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(idx);
-        return this->_data[idx].value;
+    // --- Const algorithms ---
+    // ------------------------
+    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference)> = true>
+    const self& for_each(FuncType func) const {
+        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx));
+        return *this;
     }
 
-    // - 2D indexation -
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && dimension == Dimension::MATRIX &&
-                 (type == Type::DENSE || type == Type::STRIDED)) [[nodiscard]] reference
-    operator()(size_type i, size_type j) {
-        return this->data()[this->get_memory_offset_of_ij(i, j)];
+    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, size_type)> = true>
+    const self& for_each(FuncType func) const {
+        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx), idx);
+        return *this;
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
-        [[nodiscard]] const_reference
-        operator()(size_type i, size_type j) const {
-        return this->data()[this->get_memory_offset_of_ij(i, j)];
+    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX)>
+    const self& for_each(FuncType func) const {
+        // Loop over all 2D indices using 1D loop with idx->ij conversion.
+        // This is just as fast and ensures looping only over existing elements in non-dense matrices.
+        for (size_type idx = 0; idx < this->size(); ++idx) {
+            const auto ij = this->get_ij_of_idx(idx);
+            func(this->operator[](idx), ij.i, ij.j);
+        }
+        return *this;
     }
 
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && dimension == Dimension::MATRIX && type == Type::SPARSE)
-        [[nodiscard]] reference
-        operator()(size_type i, size_type j) {
-        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(i, j);
-        return this->_data[this->get_idx_of_ij(i, j)].value;
+    // --- Mutating algorithms ---
+    // ---------------------------
+    template <class FuncType, _has_signature_enable_if<FuncType, void(reference)> = true,
+              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
+    self& for_each(FuncType func) {
+        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx));
+        return *this;
     }
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE) [[nodiscard]] const_reference
-    operator()(size_type i, size_type j) const {
-        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(i, j);
-        return this->_data[this->get_idx_of_ij(i, j)].value;
+
+    template <class FuncType, _has_signature_enable_if<FuncType, void(reference, size_type)> = true,
+              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
+    self& for_each(FuncType func) {
+        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx), idx);
+        return *this;
     }
 
-    // --- Index conversions ---
-    // -------------------------
+    template <class FuncType, _has_signature_enable_if<FuncType, void(reference, size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX)>
+    self& for_each(FuncType func) {
+        for (size_type idx = 0; idx < this->size(); ++idx) {
+            const auto ij = this->get_ij_of_idx(idx);
+            func(this->operator[](idx), ij.i, ij.j);
+        }
+        return *this;
+    }
 
-    // - Bound checking -
-private:
-    void _bound_check_idx(size_type idx) const {
-        if (idx >= this->size())
-            throw std::out_of_range(
-                stringify("idx (which is ", idx, ") >= this->size() (which is ", this->size(), ")"));
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type(const_reference)> = true,
+              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
+    self& transform(FuncType func) {
+        const auto func_wrapper = [&](reference elem) { elem = func(elem); };
+        return this->for_each(func_wrapper);
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX) void _bound_check_ij(size_type i, size_type j) const {
-        if (i >= this->rows())
-            throw std::out_of_range(stringify("i (which is ", i, ") >= this->rows() (which is ", this->rows(), ")"));
-        else if (j >= this->cols())
-            throw std::out_of_range(stringify("j (which is ", j, ") >= this->cols() (which is ", this->cols(), ")"));
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type(const_reference, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::VECTOR && ownership != Ownership::CONST_VIEW)>
+    self& transform(FuncType func) {
+        const auto func_wrapper = [&](reference elem, size_type i) { elem = func(elem, i); };
+        return this->for_each(func_wrapper);
     }
 
-    // - Dense & strided implementations -
+    template <class FuncType,
+              _has_signature_enable_if<FuncType, value_type(const_reference, size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)>
+    self& transform(FuncType func) {
+        const auto func_wrapper = [&](reference elem, size_type i, size_type j) { elem = func(elem, i, j); };
+        return this->for_each(func_wrapper);
+    }
+
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW) self& fill(const_reference value) {
+        for (size_type idx = 0; idx < this->size(); ++idx) this->operator[](idx) = value;
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type()> = true,
+              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
+    self& fill(FuncType func) {
+        const auto func_wrapper = [&](reference elem) { elem = func(); };
+        return this->for_each(func_wrapper);
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type(size_type)> = true,
+              utl_mvl_require(dimension == Dimension::VECTOR && ownership != Ownership::CONST_VIEW)>
+    self& fill(FuncType func) {
+        const auto func_wrapper = [&](reference elem, size_type i) { elem = func(i); };
+        return this->for_each(func_wrapper);
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type(size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)>
+    self& fill(FuncType func) {
+        const auto func_wrapper = [&](reference elem, size_type i, size_type j) { elem = func(i, j); };
+        return this->for_each(func_wrapper);
+    }
+
+    template <class Compare, utl_mvl_require(ownership != Ownership::CONST_VIEW)>
+    self& sort(Compare cmp) {
+        std::sort(this->begin(), this->end(), cmp);
+        return *this;
+    }
+    template <class Compare, utl_mvl_require(ownership != Ownership::CONST_VIEW)>
+    self& stable_sort(Compare cmp) {
+        std::stable_sort(this->begin(), this->end(), cmp);
+        return *this;
+    }
+
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && _has_binary_op_less<value_type>::value) self& sort() {
+        std::sort(this->begin(), this->end());
+        return *this;
+    }
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && _has_binary_op_less<value_type>::value) self& stable_sort() {
+        std::stable_sort(this->begin(), this->end());
+        return *this;
+    }
+
+    // --- Sparse Subviews ---
+    // -----------------------
+
+    // - Const views -
 private:
-    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
-        [[nodiscard]] size_type _unchecked_get_idx_of_ij(size_type i, size_type j) const {
-        if constexpr (self::params::layout == Layout::RC) return i * this->cols() + j;
-        if constexpr (self::params::layout == Layout::CR) return j * this->rows() + i;
-        _unreachable();
+    using _cref_triplet_array =
+        std::vector<SparseEntry2D<std::reference_wrapper<const value_type>>>; // NOTE: Generalize for 1D
+
+public:
+    using sparse_const_view_type = GenericTensor<value_type, self::params::dimension, Type::SPARSE,
+                                                 Ownership::CONST_VIEW, self::params::checking, Layout::SPARSE>;
+
+    template <class UnaryPredicate, _has_signature_enable_if<UnaryPredicate, bool(const_reference)> = true>
+    [[nodiscard]] sparse_const_view_type filter(UnaryPredicate predicate) const {
+        const auto forwarded_predicate = [&](const_reference elem, size_type, size_type) -> bool {
+            return predicate(elem);
+        };
+        return this->filter(forwarded_predicate);
+        // NOTE: This would need its own implementation for a proper 1D support
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED)) [[nodiscard]] Index2D
-        _unchecked_get_ij_of_idx(size_type idx) const {
-        if constexpr (self::params::layout == Layout::RC) return {idx / this->cols(), idx % this->cols()};
-        if constexpr (self::params::layout == Layout::CR) return {idx % this->rows(), idx / this->rows()};
-        _unreachable();
+    template <class UnaryPredicate, _has_signature_enable_if<UnaryPredicate, bool(const_reference, size_type)> = true>
+    [[nodiscard]] sparse_const_view_type filter(UnaryPredicate predicate) const {
+        const auto forwarded_predicate = [&](const_reference elem, size_type i, size_type j) -> bool {
+            const size_type idx = this->get_idx_of_ij(i, j);
+            return predicate(elem, idx);
+        };
+        return this->filter(forwarded_predicate);
+        // NOTE: This would need its own implementation for a proper 1D support
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::CONTAINER)
-        [[nodiscard]] size_type _total_allocated_size() const noexcept {
-        // Note 1: Allocated size of the strided matrix is NOT equal to .size() (which is same as rows * cols)
-        // This is due to all the padding between the actual elements
-        // Note 2: The question of whether .size() should return the number of 'strided' elements or the number
-        // of actually allocated elements is rather perplexing, while the second option is more "correct" its
-        // usefulness is dubious at bets, while the first one does in fact allow convenient 1D iteration over
-        // all the elements. Option 1 also provides an API consistent with strided views, which is why it ended
-        // up being the one chosen
-        //
-        // This method returns a true allocated size
-        if constexpr (self::params::layout == Layout::RC)
-            return (this->rows() - 1) * this->row_stride() + this->rows() * this->cols() * this->col_stride();
-        if constexpr (self::params::layout == Layout::CR)
-            return (this->cols() - 1) * this->col_stride() + this->rows() * this->cols() * this->row_stride();
-        _unreachable();
+    template <class UnaryPredicate,
+              _has_signature_enable_if<UnaryPredicate, bool(const_reference, size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX)>
+    [[nodiscard]] sparse_const_view_type filter(UnaryPredicate predicate) const {
+        // We can't preallocate triplets without scanning predicate through the whole matrix,
+        // so we just push back entries into a vector and use to construct a sparse view
+        _cref_triplet_array triplets;
+        const auto          add_triplet_if_predicate = [&](const_reference elem, size_type i, size_type j) -> void {
+            if (predicate(elem, i, j)) triplets.push_back({i, j, elem});
+        };
+
+        this->for_each(add_triplet_if_predicate);
+
+        triplets.shrink_to_fit();
+        return sparse_const_view_type(this->rows(), this->cols(), std::move(triplets));
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX) [[nodiscard]] sparse_const_view_type diagonal() const {
+        // Sparse matrices have no better way of getting a diagonal than filtering (i ==j)
+        if constexpr (self::params::type == Type::SPARSE) {
+            return this->filter([](const_reference, size_type i, size_type j) { return i == j; });
+        }
+        // Non-sparse matrices can just iterate over diagonal directly
+        else {
+            const size_type     min_size = std::min(this->rows(), this->cols());
+            _cref_triplet_array triplets;
+            triplets.reserve(min_size);
+            for (size_type k = 0; k < min_size; ++k) triplets.push_back({k, k, this->operator()(k, k)});
+            return sparse_const_view_type(this->rows(), this->cols(), std::move(triplets));
+        }
     }
 
+    // - Mutable views -
+private:
+    using _ref_triplet_array =
+        std::vector<SparseEntry2D<std::reference_wrapper<value_type>>>; // NOTE: Generalize for 1D
+
 public:
-    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
-        [[nodiscard]] size_type get_idx_of_ij(size_type i, size_type j) const {
-        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_ij(i, j);
-        return _unchecked_get_idx_of_ij(i, j);
-    }
+    using sparse_view_type = GenericTensor<value_type, self::params::dimension, Type::SPARSE, Ownership::VIEW,
+                                           self::params::checking, Layout::SPARSE>;
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED)) [[nodiscard]] Index2D
-        get_ij_of_idx(size_type idx) const {
-        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(idx);
-        return _unchecked_get_ij_of_idx(idx);
+    template <class UnaryPredicate, utl_mvl_require(ownership != Ownership::CONST_VIEW),
+              _has_signature_enable_if<UnaryPredicate, bool(const_reference)> = true>
+    [[nodiscard]] sparse_view_type filter(UnaryPredicate predicate) {
+        const auto forwarded_predicate = [&](const_reference elem, size_type, size_type) -> bool {
+            return predicate(elem);
+        };
+        return this->filter(forwarded_predicate);
+        // NOTE: This would need its own implementation for a proper 1D support
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
-        [[nodiscard]] size_type extent_major() const noexcept {
-        if constexpr (self::params::layout == Layout::RC) return this->rows();
-        if constexpr (self::params::layout == Layout::CR) return this->cols();
-        _unreachable();
+    template <class UnaryPredicate, utl_mvl_require(ownership != Ownership::CONST_VIEW),
+              _has_signature_enable_if<UnaryPredicate, bool(const_reference, size_type)> = true>
+    [[nodiscard]] sparse_view_type filter(UnaryPredicate predicate) {
+        const auto forwarded_predicate = [&](const_reference elem, size_type i, size_type j) -> bool {
+            const size_type idx = this->get_idx_of_ij(i, j);
+            return predicate(elem, idx);
+        };
+        return this->filter(forwarded_predicate);
+        // NOTE: This would need its own implementation for a proper 1D support
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
-        [[nodiscard]] size_type extent_minor() const noexcept {
-        if constexpr (self::params::layout == Layout::RC) return this->cols();
-        if constexpr (self::params::layout == Layout::CR) return this->rows();
-        _unreachable();
+    template <class UnaryPredicate,
+              _has_signature_enable_if<UnaryPredicate, bool(const_reference, size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)>
+    [[nodiscard]] sparse_view_type filter(UnaryPredicate predicate) {
+        // This method implements actual filtering, others just forward predicates to it
+        _ref_triplet_array triplets;
+        // We can't preallocate triplets without scanning predicate through the whole matrix,
+        // so we just push back entries into a vector and use to construct a sparse view
+        const auto         add_triplet_if_predicate = [&](reference elem, size_type i, size_type j) -> void {
+            if (predicate(elem, i, j)) triplets.push_back({i, j, elem});
+        };
+
+        this->for_each(add_triplet_if_predicate);
+
+        triplets.shrink_to_fit();
+        return sparse_view_type(this->rows(), this->cols(), std::move(triplets));
     }
 
-    // - Sparse implementations -
-private:
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE) [[nodiscard]] size_type
-        _search_ij(size_type i, size_type j) const noexcept {
-        // Returns this->size() if {i, j} wasn't found.
-        // Linear search for small .size() (more efficient fue to prediction and cache locality)
-        if (true) {
-            for (size_type idx = 0; idx < this->size(); ++idx)
-                if (this->_data[idx].i == i && this->_data[idx].j == j) return idx;
-            return this->size();
+    utl_mvl_reqs(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW) [[nodiscard]] sparse_view_type
+        diagonal() {
+        /* Sparse matrices have no better way of getting a diagonal than filtering (i == j) */
+        if constexpr (self::params::type == Type::SPARSE) {
+            return this->filter([](const_reference, size_type i, size_type j) { return i == j; });
+        } /* Non-sparse matrices can just iterate over diagonal directly */
+        else {
+            const size_type    min_size = std::min(this->rows(), this->cols());
+            _ref_triplet_array triplets;
+            triplets.reserve(min_size);
+            for (size_type k = 0; k < min_size; ++k) triplets.push_back({k, k, this->operator()(k, k)});
+            return sparse_view_type(this->rows(), this->cols(), std::move(triplets));
         }
-        // TODO: Binary search for larger .size() (N(log2(size)) instead of N(size) asymptotically)
     }
 
+    // --- Block Subviews ---
+    // ----------------------
 public:
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE) [[nodiscard]] size_type
-        get_idx_of_ij(size_type i, size_type j) const {
-        const size_type idx = this->_search_ij(i, j);
-        // Return this->size() if {i, j} wasn't found. Throw with bound checking.
-        if constexpr (self::params::checking == Checking::BOUNDS)
-            if (idx == this->size())
-                throw std::out_of_range(stringify("Index { ", i, ", ", j, "} in not a part of sparse matrix"));
-        return idx;
-    }
+    // - Const views -
+    using block_const_view_type =
+        std::conditional_t<self::params::type == Type::SPARSE, sparse_const_view_type,
+                           GenericTensor<value_type, self::params::dimension, Type::STRIDED, Ownership::CONST_VIEW,
+                                         self::params::checking, self::params::layout>>;
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE) [[nodiscard]] Index2D
-        get_ij_of_idx(size_type idx) const {
-        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(idx);
-        return Index2D{this->_data[idx].i, this->_data[idx].j};
-    }
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE) [[nodiscard]] block_const_view_type
+        block(size_type block_i, size_type block_j, size_type block_rows, size_type block_cols) const {
+        // Sparse matrices have no better way of getting a block than filtering by { i, j }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
-        [[nodiscard]] bool contains_index(size_type i, size_type j) const noexcept {
-        return this->_search_ij(i, j) != this->size();
+        // Do the same thing as in .filter(), but shrink resulting view size to
+        // { block_rows, block_cols } and shift indexation by { block_i, block_j }
+        _cref_triplet_array triplets;
+
+        const auto add_triplet_if_inside_block = [&](const_reference elem, size_type i, size_type j) -> void {
+            if ((block_i <= i) && (i < block_i + block_rows) && (block_j <= j) && (j < block_j + block_cols))
+                triplets.push_back({i - block_i, j - block_j, elem});
+        };
+
+        this->for_each(add_triplet_if_inside_block);
+
+        triplets.shrink_to_fit();
+        return block_const_view_type(block_rows, block_cols, std::move(triplets));
     }
 
-    // --- Reductions ---
-    // ------------------
-    utl_mvl_reqs(_has_binary_op_plus<value_type>::value) [[nodiscard]] value_type sum() const {
-        return std::accumulate(this->cbegin(), this->cend(), value_type());
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type != Type::SPARSE) [[nodiscard]] block_const_view_type
+        block(size_type block_i, size_type block_j, size_type block_rows, size_type block_cols) const {
+        if constexpr (self::params::layout == Layout::RC) {
+            const size_type row_stride = this->row_stride() + this->col_stride() * (this->cols() - block_cols);
+            const size_type col_stride = this->col_stride();
+            return block_const_view_type(block_rows, block_cols, row_stride, col_stride,
+                                         &this->operator()(block_i, block_j));
+        }
+        if constexpr (self::params::layout == Layout::CR) {
+            const size_type row_stride = this->row_stride();
+            const size_type col_stride = this->col_stride() + this->row_stride() * (this->rows() - block_rows);
+            return block_const_view_type(block_rows, block_cols, row_stride, col_stride,
+                                         &this->operator()(block_i, block_j));
+        }
+        _unreachable();
     }
 
-    utl_mvl_reqs(_has_binary_op_multiplies<value_type>::value) [[nodiscard]] value_type product() const {
-        return std::accumulate(this->cbegin(), this->cend(), value_type(), std::multiplies<value_type>());
+    utl_mvl_reqs(dimension == Dimension::MATRIX) [[nodiscard]] block_const_view_type row(size_type i) const {
+        return this->block(i, 0, 1, this->cols());
     }
 
-    utl_mvl_reqs(_has_binary_op_less<value_type>::value) [[nodiscard]] value_type min() const {
-        return *std::min_element(this->cbegin(), this->cend());
+    utl_mvl_reqs(dimension == Dimension::MATRIX) [[nodiscard]] block_const_view_type col(size_type j) const {
+        return this->block(0, j, this->rows(), 1);
     }
 
-    utl_mvl_reqs(_has_binary_op_less<value_type>::value) [[nodiscard]] value_type max() const {
-        return *std::max_element(this->cbegin(), this->cend());
+    // - Mutable views -
+    using block_view_type =
+        std::conditional_t<self::params::type == Type::SPARSE, sparse_view_type,
+                           GenericTensor<value_type, self::params::dimension, Type::STRIDED, Ownership::VIEW,
+                                         self::params::checking, self::params::layout>>;
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE && ownership != Ownership::CONST_VIEW)
+        [[nodiscard]] block_view_type
+        block(size_type block_i, size_type block_j, size_type block_rows, size_type block_cols) {
+        // Sparse matrices have no better way of getting a block than filtering by { i, j }
+
+        // Do the same thing as in .filter(), but shrink resulting view size to
+        // { block_rows, block_cols } and shift indexation by { block_i, block_j }
+        _ref_triplet_array triplets;
+
+        const auto add_triplet_if_inside_block = [&](reference elem, size_type i, size_type j) -> void {
+            if ((block_i <= i) && (i < block_i + block_rows) && (block_j <= j) && (j < block_j + block_cols))
+                triplets.push_back({i - block_i, j - block_j, elem});
+        };
+
+        this->for_each(add_triplet_if_inside_block);
+
+        triplets.shrink_to_fit();
+        return block_view_type(block_rows, block_cols, std::move(triplets));
     }
 
-    // --- Predicate operations ---
-    // ----------------------------
-    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference)> = true>
-    [[nodiscard]] bool true_for_any(PredType predicate) const {
-        for (size_type idx = 0; idx < this->size(); ++idx)
-            if (predicate(this->operator[](idx), idx)) return true;
-        return false;
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type != Type::SPARSE && ownership != Ownership::CONST_VIEW)
+        [[nodiscard]] block_view_type
+        block(size_type block_i, size_type block_j, size_type block_rows, size_type block_cols) {
+        if constexpr (self::params::layout == Layout::RC) {
+            const size_type row_stride = this->row_stride() + this->col_stride() * (this->cols() - block_cols);
+            const size_type col_stride = this->col_stride();
+            return block_view_type(block_rows, block_cols, row_stride, col_stride, &this->operator()(block_i, block_j));
+        }
+        if constexpr (self::params::layout == Layout::CR) {
+            const size_type row_stride = this->row_stride();
+            const size_type col_stride = this->col_stride() + this->row_stride() * (this->rows() - block_rows);
+            return block_view_type(block_rows, block_cols, row_stride, col_stride, &this->operator()(block_i, block_j));
+        }
+        _unreachable();
     }
 
-    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference, size_type)> = true>
-    [[nodiscard]] bool true_for_any(PredType predicate) const {
-        for (size_type idx = 0; idx < this->size(); ++idx)
-            if (predicate(this->operator[](idx), idx)) return true;
-        return false;
+    utl_mvl_reqs(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW) [[nodiscard]] block_view_type
+        row(size_type i) {
+        return this->block(i, 0, 1, this->cols());
     }
 
-    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference, size_type, size_type)> = true,
-              utl_mvl_require(dimension == Dimension::MATRIX)>
-    [[nodiscard]] bool true_for_any(PredType predicate) const {
-        // Loop over all 2D indices using 1D loop with idx->ij conversion
-        // This is just as fast and ensures looping only over existing elements in non-dense matrices
-        for (size_type idx = 0; idx < this->size(); ++idx) {
-            const auto ij = this->get_ij_of_idx(idx);
-            if (predicate(this->operator[](idx), ij.i, ij.j)) return true;
-        }
-        return false;
+    utl_mvl_reqs(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW) [[nodiscard]] block_view_type
+        col(size_type j) {
+        return this->block(0, j, this->rows(), 1);
     }
 
-    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference)> = true>
-    [[nodiscard]] bool true_for_all(PredType predicate) const {
-        auto inverse_predicate = [&](const_reference e) -> bool { return !predicate(e); };
-        return !this->true_for_any(inverse_predicate);
+    // --- Sparse operations ---
+    // -------------------------
+
+private:
+    using _triplet_t = _choose_based_on_ownership<_ownership, SparseEntry2D<value_type>,
+                                                  SparseEntry2D<std::reference_wrapper<value_type>>,
+                                                  SparseEntry2D<std::reference_wrapper<const value_type>>>;
+
+public:
+    using sparse_entry_type = _triplet_t;
+
+    utl_mvl_reqs(type == Type::SPARSE) [[nodiscard]] const std::vector<sparse_entry_type>& entries() const noexcept {
+        return this->_data;
     }
 
-    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference, size_type)> = true>
-    [[nodiscard]] bool true_for_all(PredType predicate) const {
-        auto inverse_predicate = [&](const_reference e, size_type idx) -> bool { return !predicate(e, idx); };
-        return !this->true_for_any(inverse_predicate);
+    utl_mvl_reqs(type == Type::SPARSE && ownership != Ownership::CONST_VIEW)
+        [[nodiscard]] std::vector<sparse_entry_type>& entries() noexcept {
+        return this->_data;
     }
 
-    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference, size_type, size_type)> = true,
-              utl_mvl_require(dimension == Dimension::MATRIX)>
-    [[nodiscard]] bool true_for_all(PredType predicate) const {
-        // We can reuse .true_for_any() with inverted predicate due to following conjecture:
-        // FOR_ALL (predicate)  ~  ! FOR_ANY (!predicate)
-        auto inverse_predicate = [&](const_reference e, size_type i, size_type j) -> bool {
-            return !predicate(e, i, j);
+    utl_mvl_reqs(dimension == Dimension::MATRIX &&
+                 type == Type::SPARSE) self& insert_triplets(const std::vector<sparse_entry_type>& triplets) {
+        // Bulk-insert triplets and sort by index
+        const auto ordering = [](const sparse_entry_type& l, const sparse_entry_type& r) -> bool {
+            return (l.i < r.i) && (l.j < r.j);
         };
-        return !this->true_for_any(inverse_predicate);
-    }
 
-    // --- Const algorithms ---
-    // ------------------------
-    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference)> = true>
-    const self& for_each(FuncType func) const {
-        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx));
-        return *this;
-    }
+        this->_data.insert(this->_data.end(), triplets.begin(), triplets.end());
+        std::sort(this->_data.begin(), this->_data.end(), ordering);
 
-    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, size_type)> = true>
-    const self& for_each(FuncType func) const {
-        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx), idx);
         return *this;
     }
 
-    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, size_type, size_type)> = true,
-              utl_mvl_require(dimension == Dimension::MATRIX)>
-    const self& for_each(FuncType func) const {
-        // Loop over all 2D indices using 1D loop with idx->ij conversion.
-        // This is just as fast and ensures looping only over existing elements in non-dense matrices.
-        for (size_type idx = 0; idx < this->size(); ++idx) {
-            const auto ij = this->get_ij_of_idx(idx);
-            func(this->operator[](idx), ij.i, ij.j);
-        }
-        return *this;
-    }
+    utl_mvl_reqs(dimension == Dimension::MATRIX &&
+                 type == Type::SPARSE) self& rewrite_triplets(std::vector<sparse_entry_type>&& triplets) {
+        // Move-construct all triplets at once and sort by index
+        const auto ordering = [](const sparse_entry_type& l, const sparse_entry_type& r) -> bool {
+            return (l.i < r.i) && (l.j < r.j);
+        };
 
-    // --- Mutating algorithms ---
-    // ---------------------------
-    template <class FuncType, _has_signature_enable_if<FuncType, void(reference)> = true,
-              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
-    self& for_each(FuncType func) {
-        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx));
-        return *this;
-    }
+        this->_data = std::move(triplets);
+        std::sort(this->_data.begin(), this->_data.end(), ordering);
 
-    template <class FuncType, _has_signature_enable_if<FuncType, void(reference, size_type)> = true,
-              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
-    self& for_each(FuncType func) {
-        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx), idx);
         return *this;
     }
 
-    template <class FuncType, _has_signature_enable_if<FuncType, void(reference, size_type, size_type)> = true,
-              utl_mvl_require(dimension == Dimension::MATRIX)>
-    self& for_each(FuncType func) {
-        for (size_type idx = 0; idx < this->size(); ++idx) {
-            const auto ij = this->get_ij_of_idx(idx);
-            func(this->operator[](idx), ij.i, ij.j);
-        }
-        return *this;
-    }
+    utl_mvl_reqs(dimension == Dimension::MATRIX &&
+                 type == Type::SPARSE) self& erase_triplets(std::vector<Index2D> indices) {
+        // Erase triplets with {i, j} from 'indices' using the fact that both
+        // 'indices' and triplets are sorted. We can scan through triplets once
+        // while advancing 'cursor' when 'indices[cursor]' gets deleted, which
+        // result in all necessary triplets being marked for erasure in order.
+        std::sort(indices.begin(), indices.end());
+        std::size_t cursor = 0;
 
-    template <class FuncType, _has_signature_enable_if<FuncType, value_type(const_reference)> = true,
-              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
-    self& transform(FuncType func) {
-        const auto func_wrapper = [&](reference elem) { elem = func(elem); };
-        return this->for_each(func_wrapper);
-    }
+        const auto erase_condition = [&](const sparse_entry_type& triplet) -> bool {
+            /* Stop erasing once all target indices are handled */
+            if (cursor == indices.size()) return false;
+            if (indices[cursor].i == triplet.i && indices[cursor].j == triplet.j) {
+                ++cursor;
+                return true;
+            }
+            return false;
+        };
 
-    template <class FuncType, _has_signature_enable_if<FuncType, value_type(const_reference, size_type)> = true,
-              utl_mvl_require(dimension == Dimension::VECTOR && ownership != Ownership::CONST_VIEW)>
-    self& transform(FuncType func) {
-        const auto func_wrapper = [&](reference elem, size_type i) { elem = func(elem, i); };
-        return this->for_each(func_wrapper);
-    }
+        const auto iter = std::remove_if(this->_data.begin(), this->_data.end(), erase_condition);
+        this->_data.erase(iter, this->_data.end());
 
-    template <class FuncType,
-              _has_signature_enable_if<FuncType, value_type(const_reference, size_type, size_type)> = true,
-              utl_mvl_require(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)>
-    self& transform(FuncType func) {
-        const auto func_wrapper = [&](reference elem, size_type i, size_type j) { elem = func(elem, i, j); };
-        return this->for_each(func_wrapper);
-    }
+        // Re-sort triplets just in case
+        const auto ordering = [](const sparse_entry_type& l, const sparse_entry_type& r) -> bool {
+            return (l.i < r.i) && (l.j < r.j);
+        };
+        std::sort(this->_data.begin(), this->_data.end(), ordering);
 
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW) self& fill(const_reference value) {
-        for (size_type idx = 0; idx < this->size(); ++idx) this->operator[](idx) = value;
         return *this;
     }
 
-    template <class FuncType, _has_signature_enable_if<FuncType, value_type()> = true,
-              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
-    self& fill(FuncType func) {
-        const auto func_wrapper = [&](reference elem) { elem = func(); };
-        return this->for_each(func_wrapper);
-    }
+    // --- Constructors ---
+    // --------------------
 
-    template <class FuncType, _has_signature_enable_if<FuncType, value_type(size_type)> = true,
-              utl_mvl_require(dimension == Dimension::VECTOR && ownership != Ownership::CONST_VIEW)>
-    self& fill(FuncType func) {
-        const auto func_wrapper = [&](reference elem, size_type i) { elem = func(i); };
-        return this->for_each(func_wrapper);
-    }
+    // - Matrix -
+public:
+    // Rule of five:
+    // copy-ctor       - [+] (deduced from copy-assignment)
+    // move-ctor       - [+] (= default)
+    // copy-assignment - [+] (custom for dense/strided, same as default for sparse)
+    // move-assignment - [+] (= default)
+    // destructor      - [+] (= default)
 
-    template <class FuncType, _has_signature_enable_if<FuncType, value_type(size_type, size_type)> = true,
-              utl_mvl_require(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)>
-    self& fill(FuncType func) {
-        const auto func_wrapper = [&](reference elem, size_type i, size_type j) { elem = func(i, j); };
-        return this->for_each(func_wrapper);
-    }
+    // Move-ctor is default for all types
+    GenericTensor(self&& other) noexcept = default;
 
-    template <class Compare, utl_mvl_require(ownership != Ownership::CONST_VIEW)>
-    self& sort(Compare cmp) {
-        std::sort(this->begin(), this->end(), cmp);
-        return *this;
-    }
-    template <class Compare, utl_mvl_require(ownership != Ownership::CONST_VIEW)>
-    self& stable_sort(Compare cmp) {
-        std::stable_sort(this->begin(), this->end(), cmp);
+    // Move-assignment is default for all types
+    self& operator=(self&& other) noexcept = default;
+
+    // Copy-ctor is deduced from assignment operator
+    GenericTensor(const self& other) { *this = other; }
+
+    // Copy-assignment
+    self& operator=(const self& other) {
+        // Note: copy-assignment operator CANNOT be templated, it has to be implemented with 'if constexpr'
+        this->_rows = other.rows();
+        this->_cols = other.cols();
+        if constexpr (self::params::type == Type::DENSE) {
+            this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
+            std::copy(other.begin(), other.end(), this->begin());
+        }
+        if constexpr (self::params::type == Type::STRIDED) {
+            this->_row_stride = other.row_stride();
+            this->_col_stride = other.col_stride();
+            this->_data       = std::move(_make_unique_ptr_array<value_type>(this->size()));
+            std::copy(other.begin(), other.end(), this->begin());
+        }
+        if constexpr (self::params::type == Type::SPARSE) { this->_data = other._data; }
         return *this;
     }
 
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && _has_binary_op_less<value_type>::value) self& sort() {
-        std::sort(this->begin(), this->end());
+    // Default-ctor (containers)
+    utl_mvl_reqs(ownership == Ownership::CONTAINER) GenericTensor() noexcept {}
+
+    // Default-ctor (views)
+    utl_mvl_reqs(ownership != Ownership::CONTAINER) GenericTensor() noexcept = delete;
+
+    // Copy-assignment over the config boundaries
+    // We can change checking config, copy from matrices with different layouts,
+    // copy from views and even matrices of other types
+    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout,
+              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE &&
+                              ownership == Ownership::CONTAINER)>
+    self& operator=(const GenericTensor<value_type, self::params::dimension, other_type, other_ownership,
+                                        other_checking, other_layout>& other) {
+        this->_rows = other.rows();
+        this->_cols = other.cols();
+        this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
+        this->fill(value_type());
+        other.for_each([&](const value_type& element, size_type i, size_type j) { this->operator()(i, j) = element; });
         return *this;
+        // copying from sparse to dense works, all elements that weren't in the sparse matrix remain default-initialized
     }
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && _has_binary_op_less<value_type>::value) self& stable_sort() {
-        std::stable_sort(this->begin(), this->end());
+
+    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout,
+              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED &&
+                              ownership == Ownership::CONTAINER)>
+    self& operator=(const GenericTensor<value_type, self::params::dimension, other_type, other_ownership,
+                                        other_checking, other_layout>& other) {
+        this->_rows       = other.rows();
+        this->_cols       = other.cols();
+        this->_row_stride = other.row_stride();
+        this->_col_stride = other.col_stride();
+        this->_data       = std::move(_make_unique_ptr_array<value_type>(this->size()));
+        this->fill(value_type());
+        // Not quite sure whether swapping strides when changing layouts like this is okay,
+        // but it seems to be correct
+        if constexpr (self::params::layout != other_layout) std::swap(this->_row_stride, this->_cols_stride);
+        other.for_each([&](const value_type& element, size_type i, size_type j) { this->operator()(i, j) = element; });
         return *this;
+        // copying from sparse to strided works, all elements that weren't in the sparse matrix remain
+        // default-initialized
     }
 
-    // --- Sparse Subviews ---
-    // -----------------------
+    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout,
+              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::SPARSE &&
+                              ownership == Ownership::CONTAINER)>
+    self& operator=(const GenericTensor<value_type, self::params::dimension, other_type, other_ownership,
+                                        other_checking, other_layout>& other) {
+        this->_rows = other.rows();
+        this->_cols = other.cols();
+        std::vector<sparse_entry_type> triplets;
 
-    // - Const views -
-private:
-    using _cref_triplet_array =
-        std::vector<SparseEntry2D<std::reference_wrapper<const value_type>>>; // NOTE: Generalize for 1D
+        // Other sparse matrices can be trivially copied
+        if constexpr (other_type == Type::SPARSE) {
+            triplets.reserve(other.size());
+            other.for_each([&](const value_type& elem, size_type i, size_type j) { triplets.push_back({i, j, elem}); });
+        }
+        // Non-sparse matrices are filtered by non-default-initialized-elements to construct a sparse subset
+        else {
+            other.for_each([&](const_reference elem, size_type i, size_type j) {
+                if (elem != value_type()) triplets.push_back({i, j, elem});
+            });
+        }
 
-public:
-    using sparse_const_view_type = GenericTensor<value_type, self::params::dimension, Type::SPARSE,
-                                                 Ownership::CONST_VIEW, self::params::checking, Layout::SPARSE>;
+        this->rewrite_triplets(std::move(triplets));
+        return *this;
+    }
 
-    template <class UnaryPredicate, _has_signature_enable_if<UnaryPredicate, bool(const_reference)> = true>
-    [[nodiscard]] sparse_const_view_type filter(UnaryPredicate predicate) const {
-        const auto forwarded_predicate = [&](const_reference elem, size_type, size_type) -> bool {
-            return predicate(elem);
-        };
-        return this->filter(forwarded_predicate);
-        // NOTE: This would need its own implementation for a proper 1D support
+    // Copy-ctor over the config boundaries (deduced from assignment over config boundaries)
+    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout,
+              utl_mvl_require(dimension == Dimension::MATRIX && ownership == Ownership::CONTAINER)>
+    GenericTensor(const GenericTensor<value_type, self::params::dimension, other_type, other_ownership, other_checking,
+                                      other_layout>& other) {
+        *this = other;
+    }
+
+    // Move-assignment over config boundaries
+    // Note: Unlike copying, we can't change layout, only checking config
+    // Also 'other' can no longer be a view or have a different type
+    template <Checking other_checking, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE &&
+                                                       ownership == Ownership::CONTAINER)>
+    self& operator=(GenericTensor<value_type, self::params::dimension, self::params::type, self::params::ownership,
+                                  other_checking, self::params::layout>&& other) {
+        this->_rows = other.rows();
+        this->_cols = other.cols();
+        this->_data = std::move(other._data);
+        return *this;
     }
 
-    template <class UnaryPredicate, _has_signature_enable_if<UnaryPredicate, bool(const_reference, size_type)> = true>
-    [[nodiscard]] sparse_const_view_type filter(UnaryPredicate predicate) const {
-        const auto forwarded_predicate = [&](const_reference elem, size_type i, size_type j) -> bool {
-            const size_type idx = this->get_idx_of_ij(i, j);
-            return predicate(elem, idx);
-        };
-        return this->filter(forwarded_predicate);
-        // NOTE: This would need its own implementation for a proper 1D support
+    template <Checking other_checking, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED &&
+                                                       ownership == Ownership::CONTAINER)>
+    self& operator=(GenericTensor<value_type, self::params::dimension, self::params::type, self::params::ownership,
+                                  other_checking, self::params::layout>&& other) {
+        this->_rows       = other.rows();
+        this->_cols       = other.cols();
+        this->_row_stride = other.row_stride();
+        this->_col_stride = other.col_stride();
+        this->_data       = std::move(other._data);
+        return *this;
     }
 
-    template <class UnaryPredicate,
-              _has_signature_enable_if<UnaryPredicate, bool(const_reference, size_type, size_type)> = true,
-              utl_mvl_require(dimension == Dimension::MATRIX)>
-    [[nodiscard]] sparse_const_view_type filter(UnaryPredicate predicate) const {
-        // We can't preallocate triplets without scanning predicate through the whole matrix,
-        // so we just push back entries into a vector and use to construct a sparse view
-        _cref_triplet_array triplets;
-        const auto          add_triplet_if_predicate = [&](const_reference elem, size_type i, size_type j) -> void {
-            if (predicate(elem, i, j)) triplets.push_back({i, j, elem});
-        };
+    template <Checking other_checking, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::SPARSE &&
+                                                       ownership == Ownership::CONTAINER)>
+    self& operator=(GenericTensor<value_type, self::params::dimension, self::params::type, self::params::ownership,
+                                  other_checking, self::params::layout>&& other) {
+        this->_rows = other.rows();
+        this->_cols = other.cols();
+        this->_data = std::move(other._data);
+        return *this;
+    }
 
-        this->for_each(add_triplet_if_predicate);
+    // Move-ctor over the config boundaries (deduced from move-assignment over config boundaries)
+    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout,
+              utl_mvl_require(dimension == Dimension::MATRIX && ownership == Ownership::CONTAINER)>
+    GenericTensor(GenericTensor<value_type, self::params::dimension, other_type, other_ownership, other_checking,
+                                other_layout>&& other) {
+        *this = std::move(other);
+    }
 
-        triplets.shrink_to_fit();
-        return sparse_const_view_type(this->rows(), this->cols(), std::move(triplets));
+    // Init-with-value
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE &&
+                 ownership == Ownership::CONTAINER) explicit GenericTensor(size_type rows, size_type cols,
+                                                                           const_reference value = value_type()) {
+        this->_rows = rows;
+        this->_cols = cols;
+        this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
+        this->fill(value);
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX) [[nodiscard]] sparse_const_view_type diagonal() const {
-        // Sparse matrices have no better way of getting a diagonal than filtering (i ==j)
-        if constexpr (self::params::type == Type::SPARSE) {
-            return this->filter([](const_reference, size_type i, size_type j) { return i == j; });
-        }
-        // Non-sparse matrices can just iterate over diagonal directly
-        else {
-            const size_type     min_size = std::min(this->rows(), this->cols());
-            _cref_triplet_array triplets;
-            triplets.reserve(min_size);
-            for (size_type k = 0; k < min_size; ++k) triplets.push_back({k, k, this->operator()(k, k)});
-            return sparse_const_view_type(this->rows(), this->cols(), std::move(triplets));
-        }
+    // Init-with-lambda
+    template <class FuncType, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE &&
+                                              ownership == Ownership::CONTAINER)>
+    explicit GenericTensor(size_type rows, size_type cols, FuncType init_func) {
+        // .fill() already takes care of preventing improper values of 'FuncType', no need to do the check here
+        this->_rows = rows;
+        this->_cols = cols;
+        this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
+        this->fill(init_func);
     }
 
-    // - Mutable views -
-private:
-    using _ref_triplet_array =
-        std::vector<SparseEntry2D<std::reference_wrapper<value_type>>>; // NOTE: Generalize for 1D
+    // Init-with-ilist
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE && ownership == Ownership::CONTAINER)
+        GenericTensor(std::initializer_list<std::initializer_list<value_type>> init) {
+        this->_rows = init.size();
+        this->_cols = (*init.begin()).size();
+        this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
 
-public:
-    using sparse_view_type = GenericTensor<value_type, self::params::dimension, Type::SPARSE, Ownership::VIEW,
-                                           self::params::checking, Layout::SPARSE>;
+        // Check dimensions (throw if cols have different dimensions)
+        for (auto row_it = init.begin(); row_it < init.end(); ++row_it)
+            if (static_cast<size_type>((*row_it).end() - (*row_it).begin()) != this->cols())
+                throw std::invalid_argument("Initializer list dimensions don't match.");
 
-    template <class UnaryPredicate, utl_mvl_require(ownership != Ownership::CONST_VIEW),
-              _has_signature_enable_if<UnaryPredicate, bool(const_reference)> = true>
-    [[nodiscard]] sparse_view_type filter(UnaryPredicate predicate) {
-        const auto forwarded_predicate = [&](const_reference elem, size_type, size_type) -> bool {
-            return predicate(elem);
-        };
-        return this->filter(forwarded_predicate);
-        // NOTE: This would need its own implementation for a proper 1D support
+        // Copy elements
+        for (size_type i = 0; i < this->rows(); ++i)
+            for (size_type j = 0; j < this->cols(); ++j) this->operator()(i, j) = (init.begin()[i]).begin()[j];
     }
 
-    template <class UnaryPredicate, utl_mvl_require(ownership != Ownership::CONST_VIEW),
-              _has_signature_enable_if<UnaryPredicate, bool(const_reference, size_type)> = true>
-    [[nodiscard]] sparse_view_type filter(UnaryPredicate predicate) {
-        const auto forwarded_predicate = [&](const_reference elem, size_type i, size_type j) -> bool {
-            const size_type idx = this->get_idx_of_ij(i, j);
-            return predicate(elem, idx);
-        };
-        return this->filter(forwarded_predicate);
-        // NOTE: This would need its own implementation for a proper 1D support
+    // Init-with-data
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE &&
+                 ownership == Ownership::CONTAINER) explicit GenericTensor(size_type rows, size_type cols,
+                                                                           pointer data_ptr) noexcept {
+        this->_rows = rows;
+        this->_cols = cols;
+        this->_data = std::move(decltype(this->_data)(data_ptr));
     }
 
-    template <class UnaryPredicate,
-              _has_signature_enable_if<UnaryPredicate, bool(const_reference, size_type, size_type)> = true,
-              utl_mvl_require(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)>
-    [[nodiscard]] sparse_view_type filter(UnaryPredicate predicate) {
-        // This method implements actual filtering, others just forward predicates to it
-        _ref_triplet_array triplets;
-        // We can't preallocate triplets without scanning predicate through the whole matrix,
-        // so we just push back entries into a vector and use to construct a sparse view
-        const auto         add_triplet_if_predicate = [&](reference elem, size_type i, size_type j) -> void {
-            if (predicate(elem, i, j)) triplets.push_back({i, j, elem});
-        };
-
-        this->for_each(add_triplet_if_predicate);
+    // - Matrix View -
 
-        triplets.shrink_to_fit();
-        return sparse_view_type(this->rows(), this->cols(), std::move(triplets));
+    // Init-from-data
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE &&
+                 ownership == Ownership::VIEW) explicit GenericTensor(size_type rows, size_type cols,
+                                                                      pointer data_ptr) {
+        this->_rows = rows;
+        this->_cols = cols;
+        this->_data = data_ptr;
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW) [[nodiscard]] sparse_view_type
-        diagonal() {
-        /* Sparse matrices have no better way of getting a diagonal than filtering (i == j) */
-        if constexpr (self::params::type == Type::SPARSE) {
-            return this->filter([](const_reference, size_type i, size_type j) { return i == j; });
-        } /* Non-sparse matrices can just iterate over diagonal directly */
-        else {
-            const size_type    min_size = std::min(this->rows(), this->cols());
-            _ref_triplet_array triplets;
-            triplets.reserve(min_size);
-            for (size_type k = 0; k < min_size; ++k) triplets.push_back({k, k, this->operator()(k, k)});
-            return sparse_view_type(this->rows(), this->cols(), std::move(triplets));
-        }
+    // Init-from-tensor (any tensor of the same API type)
+    template <Ownership other_ownership, Checking other_checking, Layout other_layout,
+              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE && ownership == Ownership::VIEW)>
+    GenericTensor(GenericTensor<value_type, self::params::dimension, self::params::type, other_ownership,
+                                other_checking, other_layout>& other) {
+        this->_rows = other.rows();
+        this->_cols = other.cols();
+        this->_data = other.data();
     }
 
-    // --- Block Subviews ---
-    // ----------------------
-public:
-    // - Const views -
-    using block_const_view_type =
-        std::conditional_t<self::params::type == Type::SPARSE, sparse_const_view_type,
-                           GenericTensor<value_type, self::params::dimension, Type::STRIDED, Ownership::CONST_VIEW,
-                                         self::params::checking, self::params::layout>>;
-
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE) [[nodiscard]] block_const_view_type
-        block(size_type block_i, size_type block_j, size_type block_rows, size_type block_cols) const {
-        // Sparse matrices have no better way of getting a block than filtering by { i, j }
+    // - Const Matrix View -
 
-        // Do the same thing as in .filter(), but shrink resulting view size to
-        // { block_rows, block_cols } and shift indexation by { block_i, block_j }
-        _cref_triplet_array triplets;
+    // Init-from-data
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE &&
+                 ownership == Ownership::CONST_VIEW) explicit GenericTensor(size_type rows, size_type cols,
+                                                                            const_pointer data_ptr) {
+        this->_rows = rows;
+        this->_cols = cols;
+        this->_data = data_ptr;
+    }
 
-        const auto add_triplet_if_inside_block = [&](const_reference elem, size_type i, size_type j) -> void {
-            if ((block_i <= i) && (i < block_i + block_rows) && (block_j <= j) && (j < block_j + block_cols))
-                triplets.push_back({i - block_i, j - block_j, elem});
-        };
+    // Init-from-tensor (any tensor of the same API type)
+    template <Ownership other_ownership, Checking other_checking, Layout other_layout,
+              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE &&
+                              ownership == Ownership::CONST_VIEW)>
+    GenericTensor(const GenericTensor<value_type, self::params::dimension, self::params::type, other_ownership,
+                                      other_checking, other_layout>& other) {
+        this->_rows = other.rows();
+        this->_cols = other.cols();
+        this->_data = other.data();
+    }
 
-        this->for_each(add_triplet_if_inside_block);
+    // - Strided Matrix -
 
-        triplets.shrink_to_fit();
-        return block_const_view_type(block_rows, block_cols, std::move(triplets));
+    // Init-with-value
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED &&
+                 ownership == Ownership::CONTAINER) explicit GenericTensor(size_type rows, size_type cols,
+                                                                           size_type row_stride, size_type col_stride,
+                                                                           const_reference value = value_type()) {
+        this->_rows       = rows;
+        this->_cols       = cols;
+        this->_row_stride = row_stride;
+        this->_col_stride = col_stride;
+        // Allocates size is NOT the same as .size() due to padding, see notes on '_total_allocated_size()'
+        this->_data       = std::move(_make_unique_ptr_array<value_type>(this->_total_allocated_size()));
+        this->fill(value);
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type != Type::SPARSE) [[nodiscard]] block_const_view_type
-        block(size_type block_i, size_type block_j, size_type block_rows, size_type block_cols) const {
-        if constexpr (self::params::layout == Layout::RC) {
-            const size_type row_stride = this->row_stride() + this->col_stride() * (this->cols() - block_cols);
-            const size_type col_stride = this->col_stride();
-            return block_const_view_type(block_rows, block_cols, row_stride, col_stride,
-                                         &this->operator()(block_i, block_j));
-        }
-        if constexpr (self::params::layout == Layout::CR) {
-            const size_type row_stride = this->row_stride();
-            const size_type col_stride = this->col_stride() + this->row_stride() * (this->rows() - block_rows);
-            return block_const_view_type(block_rows, block_cols, row_stride, col_stride,
-                                         &this->operator()(block_i, block_j));
-        }
-        _unreachable();
+    // Init-with-lambda
+    template <class FuncType, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED &&
+                                              ownership == Ownership::CONTAINER)>
+    explicit GenericTensor(size_type rows, size_type cols, size_type row_stride, size_type col_stride,
+                           FuncType init_func) {
+        // .fill() already takes care of preventing improper values of 'FuncType', no need to do the check here
+        this->_rows       = rows;
+        this->_cols       = cols;
+        this->_row_stride = row_stride;
+        this->_col_stride = col_stride;
+        // Allocates size is NOT the same as .size() due to padding, see notes on '_total_allocated_size()'
+        this->_data       = std::move(_make_unique_ptr_array<value_type>(this->_total_allocated_size()));
+        this->fill(init_func);
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX) [[nodiscard]] block_const_view_type row(size_type i) const {
-        return this->block(i, 0, 1, this->cols());
-    }
+    // Init-with-ilist
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::CONTAINER)
+        GenericTensor(std::initializer_list<std::initializer_list<value_type>> init, size_type row_stride,
+                      size_type col_stride) {
+        this->_rows       = init.size();
+        this->_cols       = (*init.begin()).size();
+        this->_row_stride = row_stride;
+        this->_col_stride = col_stride;
+        // Allocates size is NOT the same as .size() due to padding, see notes on '_total_allocated_size()'
+        this->_data       = std::move(_make_unique_ptr_array<value_type>(this->_total_allocated_size()));
+
+        // Check dimensions (throw if cols have different dimensions)
+        for (auto row_it = init.begin(); row_it < init.end(); ++row_it)
+            if ((*row_it).end() - (*row_it).begin() != this->_cols)
+                throw std::invalid_argument("Initializer list dimensions don't match.");
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX) [[nodiscard]] block_const_view_type col(size_type j) const {
-        return this->block(0, j, this->rows(), 1);
+        // Copy elements
+        for (size_type i = 0; i < this->rows(); ++i)
+            for (size_type j = 0; j < this->cols(); ++j) this->operator()(i, j) = (init.begin()[i]).begin()[j];
     }
 
-    // - Mutable views -
-    using block_view_type =
-        std::conditional_t<self::params::type == Type::SPARSE, sparse_view_type,
-                           GenericTensor<value_type, self::params::dimension, Type::STRIDED, Ownership::VIEW,
-                                         self::params::checking, self::params::layout>>;
+    // Init-with-data
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED &&
+                 ownership == Ownership::CONTAINER) explicit GenericTensor(size_type rows, size_type cols,
+                                                                           size_type row_stride, size_type col_stride,
+                                                                           pointer data_ptr) noexcept {
+        this->_rows       = rows;
+        this->_cols       = cols;
+        this->_row_stride = row_stride;
+        this->_col_stride = col_stride;
+        this->_data       = std::move(decltype(this->_data)(data_ptr));
+    }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE && ownership != Ownership::CONST_VIEW)
-        [[nodiscard]] block_view_type
-        block(size_type block_i, size_type block_j, size_type block_rows, size_type block_cols) {
-        // Sparse matrices have no better way of getting a block than filtering by { i, j }
+    // - Strided Matrix View -
 
-        // Do the same thing as in .filter(), but shrink resulting view size to
-        // { block_rows, block_cols } and shift indexation by { block_i, block_j }
-        _ref_triplet_array triplets;
+    // Init-from-data
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED &&
+                 ownership == Ownership::VIEW) explicit GenericTensor(size_type rows, size_type cols,
+                                                                      size_type row_stride, size_type col_stride,
+                                                                      pointer data_ptr) {
+        this->_rows       = rows;
+        this->_cols       = cols;
+        this->_row_stride = row_stride;
+        this->_col_stride = col_stride;
+        this->_data       = data_ptr;
+    }
 
-        const auto add_triplet_if_inside_block = [&](reference elem, size_type i, size_type j) -> void {
-            if ((block_i <= i) && (i < block_i + block_rows) && (block_j <= j) && (j < block_j + block_cols))
-                triplets.push_back({i - block_i, j - block_j, elem});
-        };
+    // Init-from-tensor (any tensor of the same API type)
+    template <Ownership other_ownership, Checking other_checking, Layout other_layout,
+              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::VIEW)>
+    GenericTensor(GenericTensor<value_type, self::params::dimension, self::params::type, other_ownership,
+                                other_checking, other_layout>& other) {
+        this->_rows       = other.rows();
+        this->_cols       = other.cols();
+        this->_row_stride = other.row_stride();
+        this->_col_stride = other.col_stride();
+        this->_data       = other.data();
+    }
 
-        this->for_each(add_triplet_if_inside_block);
+    // - Const Strided Matrix View -
 
-        triplets.shrink_to_fit();
-        return block_view_type(block_rows, block_cols, std::move(triplets));
+    // Init-from-data
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED &&
+                 ownership == Ownership::CONST_VIEW) explicit GenericTensor(size_type rows, size_type cols,
+                                                                            size_type row_stride, size_type col_stride,
+                                                                            const_pointer data_ptr) {
+        this->_rows       = rows;
+        this->_cols       = cols;
+        this->_row_stride = row_stride;
+        this->_col_stride = col_stride;
+        this->_data       = data_ptr;
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type != Type::SPARSE && ownership != Ownership::CONST_VIEW)
-        [[nodiscard]] block_view_type
-        block(size_type block_i, size_type block_j, size_type block_rows, size_type block_cols) {
-        if constexpr (self::params::layout == Layout::RC) {
-            const size_type row_stride = this->row_stride() + this->col_stride() * (this->cols() - block_cols);
-            const size_type col_stride = this->col_stride();
-            return block_view_type(block_rows, block_cols, row_stride, col_stride, &this->operator()(block_i, block_j));
-        }
-        if constexpr (self::params::layout == Layout::CR) {
-            const size_type row_stride = this->row_stride();
-            const size_type col_stride = this->col_stride() + this->row_stride() * (this->rows() - block_rows);
-            return block_view_type(block_rows, block_cols, row_stride, col_stride, &this->operator()(block_i, block_j));
-        }
-        _unreachable();
+    // Init-from-tensor (any tensor of the same API type)
+    template <Ownership other_ownership, Checking other_checking, Layout other_layout,
+              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED &&
+                              ownership == Ownership::CONST_VIEW)>
+    GenericTensor(const GenericTensor<value_type, self::params::dimension, self::params::type, other_ownership,
+                                      other_checking, other_layout>& other) {
+        this->_rows       = other.rows();
+        this->_cols       = other.cols();
+        this->_row_stride = other.row_stride();
+        this->_col_stride = other.col_stride();
+        this->_data       = other.data();
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW) [[nodiscard]] block_view_type
-        row(size_type i) {
-        return this->block(i, 0, 1, this->cols());
+    // - Sparse Matrix / Sparse Matrix View / Sparse Matrix Const View -
+
+    // Init-from-data (copy)
+    utl_mvl_reqs(dimension == Dimension::MATRIX &&
+                 type == Type::SPARSE) explicit GenericTensor(size_type rows, size_type cols,
+                                                              const std::vector<sparse_entry_type>& data) {
+        this->_rows = rows;
+        this->_cols = cols;
+        this->insert_triplets(std::move(data));
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW) [[nodiscard]] block_view_type
-        col(size_type j) {
-        return this->block(0, j, this->rows(), 1);
+    // Init-from-data (move)
+    utl_mvl_reqs(dimension == Dimension::MATRIX &&
+                 type == Type::SPARSE) explicit GenericTensor(size_type rows, size_type cols,
+                                                              std::vector<sparse_entry_type>&& data) {
+        this->_rows = rows;
+        this->_cols = cols;
+        this->rewrite_triplets(std::move(data));
     }
+};
 
-    // --- Sparse operations ---
-    // -------------------------
+// ===========================
+// --- Predefined Typedefs ---
+// ===========================
 
-private:
-    using _triplet_t = _choose_based_on_ownership<_ownership, SparseEntry2D<value_type>,
-                                                  SparseEntry2D<std::reference_wrapper<value_type>>,
-                                                  SparseEntry2D<std::reference_wrapper<const value_type>>>;
+constexpr auto _default_checking        = Checking::NONE;
+constexpr auto _default_layout_dense_2d = Layout::RC;
 
-public:
-    using sparse_entry_type = _triplet_t;
+// - Dense 2D -
+template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
+using Matrix = GenericTensor<T, Dimension::MATRIX, Type::DENSE, Ownership::CONTAINER, checking, layout>;
 
-    utl_mvl_reqs(type == Type::SPARSE) [[nodiscard]] const std::vector<sparse_entry_type>& entries() const noexcept {
-        return this->_data;
-    }
+template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
+using MatrixView = GenericTensor<T, Dimension::MATRIX, Type::DENSE, Ownership::VIEW, checking, layout>;
 
-    utl_mvl_reqs(type == Type::SPARSE && ownership != Ownership::CONST_VIEW)
-        [[nodiscard]] std::vector<sparse_entry_type>& entries() noexcept {
-        return this->_data;
-    }
+template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
+using ConstMatrixView = GenericTensor<T, Dimension::MATRIX, Type::DENSE, Ownership::CONST_VIEW, checking, layout>;
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX &&
-                 type == Type::SPARSE) self& insert_triplets(const std::vector<sparse_entry_type>& triplets) {
-        // Bulk-insert triplets and sort by index
-        const auto ordering = [](const sparse_entry_type& l, const sparse_entry_type& r) -> bool {
-            return (l.i < r.i) && (l.j < r.j);
-        };
+// - Strided 2D -
+template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
+using StridedMatrix = GenericTensor<T, Dimension::MATRIX, Type::STRIDED, Ownership::CONTAINER, checking, layout>;
 
-        this->_data.insert(this->_data.end(), triplets.begin(), triplets.end());
-        std::sort(this->_data.begin(), this->_data.end(), ordering);
+template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
+using StridedMatrixView = GenericTensor<T, Dimension::MATRIX, Type::STRIDED, Ownership::VIEW, checking, layout>;
 
-        return *this;
-    }
+template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
+using ConstStridedMatrixView =
+    GenericTensor<T, Dimension::MATRIX, Type::STRIDED, Ownership::CONST_VIEW, checking, layout>;
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX &&
-                 type == Type::SPARSE) self& rewrite_triplets(std::vector<sparse_entry_type>&& triplets) {
-        // Move-construct all triplets at once and sort by index
-        const auto ordering = [](const sparse_entry_type& l, const sparse_entry_type& r) -> bool {
-            return (l.i < r.i) && (l.j < r.j);
-        };
+// - Sparse 2D -
+template <class T, Checking checking = _default_checking>
+using SparseMatrix = GenericTensor<T, Dimension::MATRIX, Type::SPARSE, Ownership::CONTAINER, checking, Layout::SPARSE>;
 
-        this->_data = std::move(triplets);
-        std::sort(this->_data.begin(), this->_data.end(), ordering);
+template <class T, Checking checking = _default_checking>
+using SparseMatrixView = GenericTensor<T, Dimension::MATRIX, Type::SPARSE, Ownership::VIEW, checking, Layout::SPARSE>;
 
-        return *this;
-    }
+template <class T, Checking checking = _default_checking>
+using ConstSparseMatrixView =
+    GenericTensor<T, Dimension::MATRIX, Type::SPARSE, Ownership::CONST_VIEW, checking, Layout::SPARSE>;
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX &&
-                 type == Type::SPARSE) self& erase_triplets(std::vector<Index2D> indices) {
-        // Erase triplets with {i, j} from 'indices' using the fact that both
-        // 'indices' and triplets are sorted. We can scan through triplets once
-        // while advancing 'cursor' when 'indices[cursor]' gets deleted, which
-        // result in all necessary triplets being marked for erasure in order.
-        std::sort(indices.begin(), indices.end());
-        std::size_t cursor = 0;
+// ==================
+// --- Formatters ---
+// ==================
 
-        const auto erase_condition = [&](const sparse_entry_type& triplet) -> bool {
-            /* Stop erasing once all target indices are handled */
-            if (cursor == indices.size()) return false;
-            if (indices[cursor].i == triplet.i && indices[cursor].j == triplet.j) {
-                ++cursor;
-                return true;
-            }
-            return false;
-        };
+namespace format {
 
-        const auto iter = std::remove_if(this->_data.begin(), this->_data.end(), erase_condition);
-        this->_data.erase(iter, this->_data.end());
+// --- Implementation ---
+// ----------------------
 
-        // Re-sort triplets just in case
-        const auto ordering = [](const sparse_entry_type& l, const sparse_entry_type& r) -> bool {
-            return (l.i < r.i) && (l.j < r.j);
-        };
-        std::sort(this->_data.begin(), this->_data.end(), ordering);
+// The "header" of all human-readable formats that displays
+// some meta info with tensor type and dimensions.
+template <utl_mvl_tensor_arg_defs>
+[[nodiscard]] std::string _tensor_meta_string(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor) {
+    std::string buffer;
 
-        return *this;
-    }
+    if constexpr (_type == Type::DENSE) buffer += "Dense";
+    if constexpr (_type == Type::STRIDED) buffer += "Strided";
+    if constexpr (_type == Type::SPARSE) buffer += "Sparse";
+    if constexpr (_dimension == Dimension::VECTOR) buffer += stringify(" vector [size = ", tensor.size(), "]:\n");
+    if constexpr (_dimension == Dimension::MATRIX)
+        buffer += stringify(" matrix [size = ", tensor.size(), "] (", tensor.rows(), " x ", tensor.cols(), "):\n");
 
-    // --- Constructors ---
-    // --------------------
+    return buffer;
+}
 
-    // - Matrix -
-public:
-    // Rule of five:
-    // copy-ctor       - [+] (deduced from copy-assignment)
-    // move-ctor       - [+] (= default)
-    // copy-assignment - [+] (custom for dense/strided, same as default for sparse)
-    // move-assignment - [+] (= default)
-    // destructor      - [+] (= default)
+// Human-readable formats automatically collapse matrices
+// that are too  large to be reasonably parsed by a human
+constexpr std::size_t _max_displayed_flat_size = 30 * 30;
+
+template <utl_mvl_tensor_arg_defs>
+[[nodiscard]] std::string _as_too_large(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor) {
+    return stringify(_tensor_meta_string(tensor), "  <hidden due to large size>\n");
+}
+
+// Generic method to do "dense matrix print" with given delimiters.
+// Cuts down on repetition since a lot of formats only differ in the delimiters used.
+template <class T, Type type, Ownership ownership, Checking checking, Layout layout, class Func>
+[[nodiscard]] std::string
+_generic_dense_format(const GenericTensor<T, Dimension::MATRIX, type, ownership, checking, layout>& tensor,     //
+                      std::string_view                                                              begin,      //
+                      std::string_view                                                              row_begin,  //
+                      std::string_view                                                              col_delim,  //
+                      std::string_view                                                              row_end,    //
+                      std::string_view                                                              row_delim,  //
+                      std::string_view                                                              end,        //
+                      Func                                                                          stringifier //
+) {
+    if (tensor.empty()) return (std::string() += begin) += end;
 
-    // Move-ctor is default for all types
-    GenericTensor(self&& other) noexcept = default;
+    Matrix<std::string> strings(tensor.rows(), tensor.cols());
 
-    // Move-assignment is default for all types
-    self& operator=(self&& other) noexcept = default;
+    // Stringify
+    if constexpr (type == Type::SPARSE) strings.fill("-");
+    tensor.for_each([&](const T& elem, std::size_t i, std::size_t j) { strings(i, j) = stringifier(elem); });
+    // this takes care of sparsity, if the matrix is sparse we prefill 'strings' with "-" and then fill appropriate
+    // {i, j} with actual stringified values from the tensor. For dense matrices no unnecessary work is done.
 
-    // Copy-ctor is deduced from assignment operator
-    GenericTensor(const self& other) { *this = other; }
+    // Get column widths - we want matrix to format nice and aligned
+    std::vector<std::size_t> column_widths(strings.cols(), 0);
+    for (std::size_t i = 0; i < strings.rows(); ++i)
+        for (std::size_t j = 0; j < strings.cols(); ++j)
+            column_widths[j] = std::max(column_widths[j], strings(i, j).size());
 
-    // Copy-assignment
-    self& operator=(const self& other) {
-        // Note: copy-assignment operator CANNOT be templated, it has to be implemented with 'if constexpr'
-        this->_rows = other.rows();
-        this->_cols = other.cols();
-        if constexpr (self::params::type == Type::DENSE) {
-            this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
-            std::copy(other.begin(), other.end(), this->begin());
-        }
-        if constexpr (self::params::type == Type::STRIDED) {
-            this->_row_stride = other.row_stride();
-            this->_col_stride = other.col_stride();
-            this->_data       = std::move(_make_unique_ptr_array<value_type>(this->size()));
-            std::copy(other.begin(), other.end(), this->begin());
+    // Format with proper alignment
+    std::string buffer(begin);
+    for (std::size_t i = 0; i < strings.rows(); ++i) {
+        buffer += row_begin;
+        for (std::size_t j = 0; j < strings.cols(); ++j) {
+            if (strings(i, j).size() < column_widths[j]) buffer.append(column_widths[j] - strings(i, j).size(), ' ');
+            buffer += strings(i, j);
+            if (j + 1 < strings.cols()) buffer += col_delim;
         }
-        if constexpr (self::params::type == Type::SPARSE) { this->_data = other._data; }
-        return *this;
+        buffer += row_end;
+        if (i + 1 < strings.rows()) buffer += row_delim;
     }
+    buffer += end;
 
-    // Default-ctor (containers)
-    utl_mvl_reqs(ownership == Ownership::CONTAINER) GenericTensor() noexcept {}
+    return buffer;
+}
 
-    // Default-ctor (views)
-    utl_mvl_reqs(ownership != Ownership::CONTAINER) GenericTensor() noexcept = delete;
+// --- Human-readable formats ---
+// ------------------------------
 
-    // Copy-assignment over the config boundaries
-    // We can change checking config, copy from matrices with different layouts,
-    // copy from views and even matrices of other types
-    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout,
-              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE &&
-                              ownership == Ownership::CONTAINER)>
-    self& operator=(const GenericTensor<value_type, self::params::dimension, other_type, other_ownership,
-                                        other_checking, other_layout>& other) {
-        this->_rows = other.rows();
-        this->_cols = other.cols();
-        this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
-        this->fill(value_type());
-        other.for_each([&](const value_type& element, size_type i, size_type j) { this->operator()(i, j) = element; });
-        return *this;
-        // copying from sparse to dense works, all elements that weren't in the sparse matrix remain default-initialized
-    }
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_vector(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
 
-    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout,
-              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED &&
-                              ownership == Ownership::CONTAINER)>
-    self& operator=(const GenericTensor<value_type, self::params::dimension, other_type, other_ownership,
-                                        other_checking, other_layout>& other) {
-        this->_rows       = other.rows();
-        this->_cols       = other.cols();
-        this->_row_stride = other.row_stride();
-        this->_col_stride = other.col_stride();
-        this->_data       = std::move(_make_unique_ptr_array<value_type>(this->size()));
-        this->fill(value_type());
-        // Not quite sure whether swapping strides when changing layouts like this is okay,
-        // but it seems to be correct
-        if constexpr (self::params::layout != other_layout) std::swap(this->_row_stride, this->_cols_stride);
-        other.for_each([&](const value_type& element, size_type i, size_type j) { this->operator()(i, j) = element; });
-        return *this;
-        // copying from sparse to strided works, all elements that weren't in the sparse matrix remain
-        // default-initialized
-    }
+    std::string buffer = _tensor_meta_string(tensor);
 
-    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout,
-              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::SPARSE &&
-                              ownership == Ownership::CONTAINER)>
-    self& operator=(const GenericTensor<value_type, self::params::dimension, other_type, other_ownership,
-                                        other_checking, other_layout>& other) {
-        this->_rows = other.rows();
-        this->_cols = other.cols();
-        std::vector<sparse_entry_type> triplets;
+    buffer += "  { ";
+    for (std::size_t idx = 0; idx < tensor.size(); ++idx) {
+        buffer += stringifier(tensor[idx]);
+        if (idx + 1 < tensor.size()) buffer += ", ";
+    }
+    buffer += " }\n";
 
-        // Other sparse matrices can be trivially copied
-        if constexpr (other_type == Type::SPARSE) {
-            triplets.reserve(other.size());
-            other.for_each([&](const value_type& elem, size_type i, size_type j) { triplets.push_back({i, j, elem}); });
-        }
-        // Non-sparse matrices are filtered by non-default-initialized-elements to construct a sparse subset
-        else {
-            other.for_each([&](const_reference elem, size_type i, size_type j) {
-                if (elem != value_type()) triplets.push_back({i, j, elem});
-            });
-        }
+    return buffer;
+}
 
-        this->rewrite_triplets(std::move(triplets));
-        return *this;
-    }
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_dictionary(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor,
+                                        Func                                          stringifier = Func()) {
+    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
 
-    // Copy-ctor over the config boundaries (deduced from assignment over config boundaries)
-    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout,
-              utl_mvl_require(dimension == Dimension::MATRIX && ownership == Ownership::CONTAINER)>
-    GenericTensor(const GenericTensor<value_type, self::params::dimension, other_type, other_ownership, other_checking,
-                                      other_layout>& other) {
-        *this = other;
-    }
+    std::string buffer = _tensor_meta_string(tensor);
 
-    // Move-assignment over config boundaries
-    // Note: Unlike copying, we can't change layout, only checking config
-    // Also 'other' can no longer be a view or have a different type
-    template <Checking other_checking, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE &&
-                                                       ownership == Ownership::CONTAINER)>
-    self& operator=(GenericTensor<value_type, self::params::dimension, self::params::type, self::params::ownership,
-                                  other_checking, self::params::layout>&& other) {
-        this->_rows = other.rows();
-        this->_cols = other.cols();
-        this->_data = std::move(other._data);
-        return *this;
+    if constexpr (_dimension == Dimension::MATRIX) {
+        tensor.for_each([&](const T& elem, std::size_t i, std::size_t j) {
+            buffer += stringify("(", i, ", ", j, ") = ");
+            buffer += stringifier(elem);
+            buffer += '\n';
+        });
+    } else {
+        tensor.for_each([&](const T& elem, std::size_t i) {
+            buffer += stringify("(", i, ") = ");
+            buffer += stringifier(elem);
+            buffer += '\n';
+        });
     }
 
-    template <Checking other_checking, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED &&
-                                                       ownership == Ownership::CONTAINER)>
-    self& operator=(GenericTensor<value_type, self::params::dimension, self::params::type, self::params::ownership,
-                                  other_checking, self::params::layout>&& other) {
-        this->_rows       = other.rows();
-        this->_cols       = other.cols();
-        this->_row_stride = other.row_stride();
-        this->_col_stride = other.col_stride();
-        this->_data       = std::move(other._data);
-        return *this;
-    }
+    return buffer;
+}
 
-    template <Checking other_checking, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::SPARSE &&
-                                                       ownership == Ownership::CONTAINER)>
-    self& operator=(GenericTensor<value_type, self::params::dimension, self::params::type, self::params::ownership,
-                                  other_checking, self::params::layout>&& other) {
-        this->_rows = other.rows();
-        this->_cols = other.cols();
-        this->_data = std::move(other._data);
-        return *this;
-    }
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_matrix(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
 
-    // Move-ctor over the config boundaries (deduced from move-assignment over config boundaries)
-    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout,
-              utl_mvl_require(dimension == Dimension::MATRIX && ownership == Ownership::CONTAINER)>
-    GenericTensor(GenericTensor<value_type, self::params::dimension, other_type, other_ownership, other_checking,
-                                other_layout>&& other) {
-        *this = std::move(other);
-    }
+    return _generic_dense_format(tensor, _tensor_meta_string(tensor), "  [ ", " ", " ]\n", "", "", stringifier);
+}
 
-    // Init-with-value
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE &&
-                 ownership == Ownership::CONTAINER) explicit GenericTensor(size_type rows, size_type cols,
-                                                                           const_reference value = value_type()) {
-        this->_rows = rows;
-        this->_cols = cols;
-        this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
-        this->fill(value);
-    }
+// --- Export formats ---
+// ----------------------
 
-    // Init-with-lambda
-    template <class FuncType, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE &&
-                                              ownership == Ownership::CONTAINER)>
-    explicit GenericTensor(size_type rows, size_type cols, FuncType init_func) {
-        // .fill() already takes care of preventing improper values of 'FuncType', no need to do the check here
-        this->_rows = rows;
-        this->_cols = cols;
-        this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
-        this->fill(init_func);
-    }
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_raw(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    return _generic_dense_format(tensor, "", "", " ", "\n", "", "", stringifier);
+}
 
-    // Init-with-ilist
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE && ownership == Ownership::CONTAINER)
-        GenericTensor(std::initializer_list<std::initializer_list<value_type>> init) {
-        this->_rows = init.size();
-        this->_cols = (*init.begin()).size();
-        this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_csv(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    return _generic_dense_format(tensor, "", "", ", ", "\n", "", "", stringifier);
+}
 
-        // Check dimensions (throw if cols have different dimensions)
-        for (auto row_it = init.begin(); row_it < init.end(); ++row_it)
-            if (static_cast<size_type>((*row_it).end() - (*row_it).begin()) != this->cols())
-                throw std::invalid_argument("Initializer list dimensions don't match.");
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_json(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    return _generic_dense_format(tensor, "[\n", "    [ ", ", ", " ]", ",\n", "\n]\n", stringifier);
+}
 
-        // Copy elements
-        for (size_type i = 0; i < this->rows(); ++i)
-            for (size_type j = 0; j < this->cols(); ++j) this->operator()(i, j) = (init.begin()[i]).begin()[j];
-    }
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_mathematica(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor,
+                                         Func                                          stringifier = Func()) {
+    return _generic_dense_format(tensor, "{\n", "    { ", ", ", " }", ",\n", "\n}\n", stringifier);
+}
 
-    // Init-with-data
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE &&
-                 ownership == Ownership::CONTAINER) explicit GenericTensor(size_type rows, size_type cols,
-                                                                           pointer data_ptr) noexcept {
-        this->_rows = rows;
-        this->_cols = cols;
-        this->_data = std::move(decltype(this->_data)(data_ptr));
-    }
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_latex(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    return _generic_dense_format(tensor, "\\begin{pmatrix}\n", "  ", " & ", " \\\\\n", "", "\\end{pmatrix}\n",
+                                 stringifier);
+}
 
-    // - Matrix View -
 
-    // Init-from-data
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE &&
-                 ownership == Ownership::VIEW) explicit GenericTensor(size_type rows, size_type cols,
-                                                                      pointer data_ptr) {
-        this->_rows = rows;
-        this->_cols = cols;
-        this->_data = data_ptr;
-    }
+} // namespace format
 
-    // Init-from-tensor (any tensor of the same API type)
-    template <Ownership other_ownership, Checking other_checking, Layout other_layout,
-              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE && ownership == Ownership::VIEW)>
-    GenericTensor(GenericTensor<value_type, self::params::dimension, self::params::type, other_ownership,
-                                other_checking, other_layout>& other) {
-        this->_rows = other.rows();
-        this->_cols = other.cols();
-        this->_data = other.data();
-    }
+// ================================
+// --- Linear algebra operators ---
+// ================================
 
-    // - Const Matrix View -
+// --- Unary operator implementation ----
+// --------------------------------------
 
-    // Init-from-data
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE &&
-                 ownership == Ownership::CONST_VIEW) explicit GenericTensor(size_type rows, size_type cols,
-                                                                            const_pointer data_ptr) {
-        this->_rows = rows;
-        this->_cols = cols;
-        this->_data = data_ptr;
-    }
+template <class L, class Op,                                                    //
+          _is_tensor_enable_if<L> = true,                                       //
+          class return_type       = typename std::decay_t<L>::owning_reflection //
+          >
+return_type apply_unary_op(L&& left, Op&& op) {
+    using reference = typename std::decay_t<L>::reference;
 
-    // Init-from-tensor (any tensor of the same API type)
-    template <Ownership other_ownership, Checking other_checking, Layout other_layout,
-              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE &&
-                              ownership == Ownership::CONST_VIEW)>
-    GenericTensor(const GenericTensor<value_type, self::params::dimension, self::params::type, other_ownership,
-                                      other_checking, other_layout>& other) {
-        this->_rows = other.rows();
-        this->_cols = other.cols();
-        this->_data = other.data();
-    }
+    // Reuse r-value if possible
+    return_type res = std::forward<L>(left);
 
-    // - Strided Matrix -
+    // '.for_each()' takes care of possible sparsity
+    res.for_each([&](reference elem) { elem = op(std::move(elem)); });
 
-    // Init-with-value
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED &&
-                 ownership == Ownership::CONTAINER) explicit GenericTensor(size_type rows, size_type cols,
-                                                                           size_type row_stride, size_type col_stride,
-                                                                           const_reference value = value_type()) {
-        this->_rows       = rows;
-        this->_cols       = cols;
-        this->_row_stride = row_stride;
-        this->_col_stride = col_stride;
-        // Allocates size is NOT the same as .size() due to padding, see notes on '_total_allocated_size()'
-        this->_data       = std::move(_make_unique_ptr_array<value_type>(this->_total_allocated_size()));
-        this->fill(value);
-    }
+    return res;
+}
 
-    // Init-with-lambda
-    template <class FuncType, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED &&
-                                              ownership == Ownership::CONTAINER)>
-    explicit GenericTensor(size_type rows, size_type cols, size_type row_stride, size_type col_stride,
-                           FuncType init_func) {
-        // .fill() already takes care of preventing improper values of 'FuncType', no need to do the check here
-        this->_rows       = rows;
-        this->_cols       = cols;
-        this->_row_stride = row_stride;
-        this->_col_stride = col_stride;
-        // Allocates size is NOT the same as .size() due to padding, see notes on '_total_allocated_size()'
-        this->_data       = std::move(_make_unique_ptr_array<value_type>(this->_total_allocated_size()));
-        this->fill(init_func);
-    }
+// --- Unary operator API ----
+// ---------------------------
 
-    // Init-with-ilist
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::CONTAINER)
-        GenericTensor(std::initializer_list<std::initializer_list<value_type>> init, size_type row_stride,
-                      size_type col_stride) {
-        this->_rows       = init.size();
-        this->_cols       = (*init.begin()).size();
-        this->_row_stride = row_stride;
-        this->_col_stride = col_stride;
-        // Allocates size is NOT the same as .size() due to padding, see notes on '_total_allocated_size()'
-        this->_data       = std::move(_make_unique_ptr_array<value_type>(this->_total_allocated_size()));
+// std <functional> has function objects for every operator possible,
+// except unary '+' for some reason, which is why we have to implement it ourselves.
+// This is the exact same thing as 'std::negate<>' but for operator '+'.
+template <class T>
+struct _unary_plus_functor {
+    constexpr T operator()(const T& lhs) const { return +lhs; }
+};
 
-        // Check dimensions (throw if cols have different dimensions)
-        for (auto row_it = init.begin(); row_it < init.end(); ++row_it)
-            if ((*row_it).end() - (*row_it).begin() != this->_cols)
-                throw std::invalid_argument("Initializer list dimensions don't match.");
+template <class L, _is_tensor_enable_if<L> = true, class value_type = typename std::decay_t<L>::value_type,
+          _has_unary_op_plus_enable_if<value_type> = true>
+auto operator+(L&& left) {
+    return apply_unary_op(std::forward<L>(left), _unary_plus_functor<value_type>());
+}
 
-        // Copy elements
-        for (size_type i = 0; i < this->rows(); ++i)
-            for (size_type j = 0; j < this->cols(); ++j) this->operator()(i, j) = (init.begin()[i]).begin()[j];
-    }
+template <class L, _is_tensor_enable_if<L> = true, class value_type = typename std::decay_t<L>::value_type,
+          _has_unary_op_minus_enable_if<value_type> = true>
+auto operator-(L&& left) {
+    return apply_unary_op(std::forward<L>(left), std::negate<value_type>());
+}
 
-    // Init-with-data
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED &&
-                 ownership == Ownership::CONTAINER) explicit GenericTensor(size_type rows, size_type cols,
-                                                                           size_type row_stride, size_type col_stride,
-                                                                           pointer data_ptr) noexcept {
-        this->_rows       = rows;
-        this->_cols       = cols;
-        this->_row_stride = row_stride;
-        this->_col_stride = col_stride;
-        this->_data       = std::move(decltype(this->_data)(data_ptr));
-    }
+// --- Binary operator implementation ---
+// --------------------------------------
 
-    // - Strided Matrix View -
+// Doing things "in a dumb but simple way" would be to just have all operators take arguments as const-refs and
+// return a copy, however we can speed things up a lot by properly using perfect forwarding, which would reuse
+// r-values if possible to avoid allocation. Doing so would effectively change something like this:
+//    res = A + B - C - D + E
+// from 5 (!) copies to only 1, since first operator will create an r-value that gets propagated and reused by
+// all others. This however introduces it's own set of challenges since instead of traditional overloading we
+// now have to resort to SFINAE-driven imitation of it and carefully watch what we restrict.
+//
+// So here are the key points of implementing all of this:
+//
+//    1. All unary and binary operators ('-', '+', '*' and etc.) can benefit from reusing r-values and moving
+//       one of the arguments into the result rather than copy. This can only happen to CONTAINER args that
+//       correspond to the return type.
+//
+//    2. Binary operators have following return types for different tensors:
+//       - (1)  dense +  dense =>  dense      (complexity O(N^2))
+//       - (2)  dense + sparse =>  dense      (complexity O(N)  )
+//       - (3) sparse +  dense =>  dense      (complexity O(N)  )
+//       - (4) sparse + sparse => sparse      (complexity O(N)  )
+//       return types inherit option arguments from the lhs and always have 'ownership == CONTAINER',
+//       while argument can be anything, including views. To implement the list above efficiently there
+//       is no other way but to make 4 separate implementation, tailored for each level of sparsity.
+//
+//    3. All binary operators can be written in a generic form like 'apply_binary_operator(A, B, op)'
+//       and specialized with operator functors froms std <functional>. All we need for individual
+//       operators is to figure out correct boilerplate with perfect forwarding. "Overload resolution"
+//       will be performed by the 'apply_operator' method.
+//
+// It's a good question whether to threat binary '*' as element-wise product (which would be in line with other
+// operators) or a matrix product, but in the end it seems doing it element-wise would be too confusing for the
+// user, so we leave '*' as a matrix product and declare element-wise product as a function 'elementwise_product()'
+// since no existing operators seem suitable for such overload.
 
-    // Init-from-data
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED &&
-                 ownership == Ownership::VIEW) explicit GenericTensor(size_type rows, size_type cols,
-                                                                      size_type row_stride, size_type col_stride,
-                                                                      pointer data_ptr) {
-        this->_rows       = rows;
-        this->_cols       = cols;
-        this->_row_stride = row_stride;
-        this->_col_stride = col_stride;
-        this->_data       = data_ptr;
-    }
+// (1)  dense +  dense =>  dense
+template <class L, class R, class Op,                                                                     //
+          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
+          _is_nonsparse_tensor_enable_if<L>                 = true,                                       //
+          _is_nonsparse_tensor_enable_if<R>                 = true,                                       //
+          class return_type                                 = typename std::decay_t<L>::owning_reflection //
+          >
+return_type apply_binary_op(L&& left, R&& right, Op&& op) {
+    utl_mvl_assert(left.rows() == right.rows());
+    utl_mvl_assert(left.cols() == right.cols());
 
-    // Init-from-tensor (any tensor of the same API type)
-    template <Ownership other_ownership, Checking other_checking, Layout other_layout,
-              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::VIEW)>
-    GenericTensor(GenericTensor<value_type, self::params::dimension, self::params::type, other_ownership,
-                                other_checking, other_layout>& other) {
-        this->_rows       = other.rows();
-        this->_cols       = other.cols();
-        this->_row_stride = other.row_stride();
-        this->_col_stride = other.col_stride();
-        this->_data       = other.data();
-    }
+    using reference = typename std::decay_t<L>::reference;
+    using size_type = typename std::decay_t<L>::size_type;
 
-    // - Const Strided Matrix View -
+    return_type res;
 
-    // Init-from-data
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED &&
-                 ownership == Ownership::CONST_VIEW) explicit GenericTensor(size_type rows, size_type cols,
-                                                                            size_type row_stride, size_type col_stride,
-                                                                            const_pointer data_ptr) {
-        this->_rows       = rows;
-        this->_cols       = cols;
-        this->_row_stride = row_stride;
-        this->_col_stride = col_stride;
-        this->_data       = data_ptr;
+    // Reuse r-value arguments if possible while preserving the order of operations
+    if constexpr (std::is_rvalue_reference_v<L> && std::decay_t<L>::params::ownership == Ownership::CONTAINER) {
+        res = std::forward<L>(left);
+        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(std::move(elem), right(i, j)); });
+    } else if constexpr (std::is_rvalue_reference_v<R> && std::decay_t<R>::params::ownership == Ownership::CONTAINER) {
+        res = std::forward<R>(right);
+        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(left(i, j), std::move(elem)); });
+    } else {
+        res = return_type(left.rows(), left.cols());
+        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(left(i, j), right(i, j)); });
     }
 
-    // Init-from-tensor (any tensor of the same API type)
-    template <Ownership other_ownership, Checking other_checking, Layout other_layout,
-              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED &&
-                              ownership == Ownership::CONST_VIEW)>
-    GenericTensor(const GenericTensor<value_type, self::params::dimension, self::params::type, other_ownership,
-                                      other_checking, other_layout>& other) {
-        this->_rows       = other.rows();
-        this->_cols       = other.cols();
-        this->_row_stride = other.row_stride();
-        this->_col_stride = other.col_stride();
-        this->_data       = other.data();
-    }
+    return res;
+}
 
-    // - Sparse Matrix / Sparse Matrix View / Sparse Matrix Const View -
+// (2)  dense + sparse =>  dense
+template <class L, class R, class Op,                                                                     //
+          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
+          _is_nonsparse_tensor_enable_if<L>                 = true,                                       //
+          _is_sparse_tensor_enable_if<R>                    = true,                                       //
+          class return_type                                 = typename std::decay_t<L>::owning_reflection //
+          >
+return_type apply_binary_op(L&& left, R&& right, Op&& op) {
+    utl_mvl_assert(left.rows() == right.rows());
+    utl_mvl_assert(left.cols() == right.cols());
 
-    // Init-from-data (copy)
-    utl_mvl_reqs(dimension == Dimension::MATRIX &&
-                 type == Type::SPARSE) explicit GenericTensor(size_type rows, size_type cols,
-                                                              const std::vector<sparse_entry_type>& data) {
-        this->_rows = rows;
-        this->_cols = cols;
-        this->insert_triplets(std::move(data));
-    }
+    using reference = typename std::decay_t<L>::reference;
+    using size_type = typename std::decay_t<L>::size_type;
 
-    // Init-from-data (move)
-    utl_mvl_reqs(dimension == Dimension::MATRIX &&
-                 type == Type::SPARSE) explicit GenericTensor(size_type rows, size_type cols,
-                                                              std::vector<sparse_entry_type>&& data) {
-        this->_rows = rows;
-        this->_cols = cols;
-        this->rewrite_triplets(std::move(data));
-    }
-};
+    // Reuse r-value if possible
+    return_type res = std::forward<L>(left);
 
-// ===========================
-// --- Predefined Typedefs ---
-// ===========================
+    // '.for_each()' to only iterate sparse elements
+    right.for_each([&](reference elem, size_type i, size_type j) { res(i, j) = op(std::move(res(i, j)), elem); });
 
-constexpr auto _default_checking        = Checking::NONE;
-constexpr auto _default_layout_dense_2d = Layout::RC;
+    return res;
+}
 
-// - Dense 2D -
-template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
-using Matrix = GenericTensor<T, Dimension::MATRIX, Type::DENSE, Ownership::CONTAINER, checking, layout>;
+// (3) sparse +  dense =>  dense
+template <class L, class R, class Op,                                                                     //
+          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
+          _is_sparse_tensor_enable_if<L>                    = true,                                       //
+          _is_nonsparse_tensor_enable_if<R>                 = true,                                       //
+          class return_type                                 = typename std::decay_t<R>::owning_reflection //
+          >
+return_type apply_binary_op(L&& left, R&& right, Op&& op) {
+    utl_mvl_assert(left.rows() == right.rows());
+    utl_mvl_assert(left.cols() == right.cols());
 
-template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
-using MatrixView = GenericTensor<T, Dimension::MATRIX, Type::DENSE, Ownership::VIEW, checking, layout>;
+    using reference = typename std::decay_t<R>::reference;
+    using size_type = typename std::decay_t<R>::size_type;
 
-template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
-using ConstMatrixView = GenericTensor<T, Dimension::MATRIX, Type::DENSE, Ownership::CONST_VIEW, checking, layout>;
+    // Reuse r-value if possible
+    return_type res = std::forward<R>(right);
 
-// - Strided 2D -
-template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
-using StridedMatrix = GenericTensor<T, Dimension::MATRIX, Type::STRIDED, Ownership::CONTAINER, checking, layout>;
+    // '.for_each()' to only iterate sparse elements
+    left.for_each([&](reference elem, size_type i, size_type j) { res(i, j) = op(elem, std::move(res(i, j))); });
 
-template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
-using StridedMatrixView = GenericTensor<T, Dimension::MATRIX, Type::STRIDED, Ownership::VIEW, checking, layout>;
+    return res;
+}
 
-template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
-using ConstStridedMatrixView =
-    GenericTensor<T, Dimension::MATRIX, Type::STRIDED, Ownership::CONST_VIEW, checking, layout>;
+// (4) sparse + sparse => sparse
+template <class L, class R, class Op,                                                                     //
+          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
+          _is_sparse_tensor_enable_if<L>                    = true,                                       //
+          _is_sparse_tensor_enable_if<R>                    = true,                                       //
+          class return_type                                 = typename std::decay_t<L>::owning_reflection //
+          >
+return_type apply_binary_op(L&& left, R&& right, Op&& op) {
+    utl_mvl_assert(left.rows() == right.rows());
+    utl_mvl_assert(left.cols() == right.cols());
 
-// - Sparse 2D -
-template <class T, Checking checking = _default_checking>
-using SparseMatrix = GenericTensor<T, Dimension::MATRIX, Type::SPARSE, Ownership::CONTAINER, checking, Layout::SPARSE>;
+    using sparse_entry = typename std::decay_t<L>::sparse_entry_type;
+    using value_type   = typename std::decay_t<L>::value_type;
 
-template <class T, Checking checking = _default_checking>
-using SparseMatrixView = GenericTensor<T, Dimension::MATRIX, Type::SPARSE, Ownership::VIEW, checking, Layout::SPARSE>;
+    std::vector<sparse_entry> res_triplets;
+    res_triplets.reserve(std::max(left.size(), right.size()));
+    // not enough when matrices have different sparsity patterns, but good enough for initial guess
 
-template <class T, Checking checking = _default_checking>
-using ConstSparseMatrixView =
-    GenericTensor<T, Dimension::MATRIX, Type::SPARSE, Ownership::CONST_VIEW, checking, Layout::SPARSE>;
+    std::size_t i = 0, j = 0;
 
-// ==================
-// --- Formatters ---
-// ==================
+    // Merge sparsity patterns
+    while (i < left.size() && j < right.size()) {
+        // Entry present only in lhs sparsity pattern
+        if (left._data[i] < right._data[j]) {
+            res_triplets.emplace_back(
+                _apply_binary_op_to_sparse_entry_and_value(std::forward<L>(left)._data[i++], value_type{}, op));
+        }
+        // Entry present only in rhs sparsity pattern
+        else if (left._data[i] > right._data[j]) {
+            res_triplets.emplace_back(
+                _apply_binary_op_to_value_and_sparse_entry(value_type{}, std::forward<R>(right)._data[j++], op));
+        }
+        // Entry present in both sparsity patterns
+        else {
+            res_triplets.emplace_back(_apply_binary_op_to_sparse_entries(std::forward<L>(left)._data[i++],
+                                                                         std::forward<R>(right)._data[j++], op));
+        }
+    }
+    // Copy the rest of lhs (if needed)
+    while (i < left.size()) res_triplets.emplace_back(std::forward<L>(left)._data[i++]);
+    // Copy the rest of rhs (if needed)
+    while (j < right.size()) res_triplets.emplace_back(std::forward<R>(right)._data[j++]);
 
-namespace format {
+    return return_type(left.rows(), left.cols(), std::move(res_triplets));
+}
 
-// --- Implementation ---
-// ----------------------
+// --- Binary operator API ---
+// ---------------------------
 
-// The "header" of all human-readable formats that displays
-// some meta info with tensor type and dimensions.
-template <utl_mvl_tensor_arg_defs>
-[[nodiscard]] std::string _tensor_meta_string(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor) {
-    std::string buffer;
+template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
+          class value_type = typename std::decay_t<L>::value_type, _has_binary_op_plus_enable_if<value_type> = true>
+auto operator+(L&& left, R&& right) {
+    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::plus<value_type>());
+}
 
-    if constexpr (_type == Type::DENSE) buffer += "Dense";
-    if constexpr (_type == Type::STRIDED) buffer += "Strided";
-    if constexpr (_type == Type::SPARSE) buffer += "Sparse";
-    if constexpr (_dimension == Dimension::VECTOR) buffer += stringify(" vector [size = ", tensor.size(), "]:\n");
-    if constexpr (_dimension == Dimension::MATRIX)
-        buffer += stringify(" matrix [size = ", tensor.size(), "] (", tensor.rows(), " x ", tensor.cols(), "):\n");
+template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
+          class value_type = typename std::decay_t<L>::value_type, _has_binary_op_minus_enable_if<value_type> = true>
+auto operator-(L&& left, R&& right) {
+    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::minus<value_type>());
+}
 
-    return buffer;
+template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
+          class value_type                                = typename std::decay_t<L>::value_type,
+          _has_binary_op_multiplies_enable_if<value_type> = true>
+auto elementwise_product(L&& left, R&& right) {
+    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::multiplies<value_type>());
 }
 
-// Human-readable formats automatically collapse matrices
-// that are too  large to be reasonably parsed by a human
-constexpr std::size_t _max_displayed_flat_size = 30 * 30;
+// --- Augmented assignment operator API ---
+// -----------------------------------------
 
-template <utl_mvl_tensor_arg_defs>
-[[nodiscard]] std::string _as_too_large(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor) {
-    return stringify(_tensor_meta_string(tensor), "  <hidden due to large size>\n");
+// These can just reuse corresponding binary operators while 'std::move()'ing lhs to avoid copying.
+
+template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
+          class value_type = typename std::decay_t<L>::value_type, _has_assignment_op_plus_enable_if<value_type> = true>
+L& operator+=(L&& left, R&& right) {
+    return (left = std::move(left) + right);
 }
 
-// Generic method to do "dense matrix print" with given delimiters.
-// Cuts down on repetition since a lot of formats only differ in the delimiters used.
-template <class T, Type type, Ownership ownership, Checking checking, Layout layout, class Func>
-[[nodiscard]] std::string
-_generic_dense_format(const GenericTensor<T, Dimension::MATRIX, type, ownership, checking, layout>& tensor,     //
-                      std::string_view                                                              begin,      //
-                      std::string_view                                                              row_begin,  //
-                      std::string_view                                                              col_delim,  //
-                      std::string_view                                                              row_end,    //
-                      std::string_view                                                              row_delim,  //
-                      std::string_view                                                              end,        //
-                      Func                                                                          stringifier //
-) {
-    if (tensor.empty()) return (std::string() += begin) += end;
+template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
+          class value_type                               = typename std::decay_t<L>::value_type,
+          _has_assignment_op_minus_enable_if<value_type> = true>
+L& operator-=(L&& left, R&& right) {
+    return (left = std::move(left) - right);
+}
 
-    Matrix<std::string> strings(tensor.rows(), tensor.cols());
+// --- Matrix multiplication ---
+// -----------------------------
 
-    // Stringify
-    if constexpr (type == Type::SPARSE) strings.fill("-");
-    tensor.for_each([&](const T& elem, std::size_t i, std::size_t j) { strings(i, j) = stringifier(elem); });
-    // this takes care of sparsity, if the matrix is sparse we prefill 'strings' with "-" and then fill appropriate
-    // {i, j} with actual stringified values from the tensor. For dense matrices no unnecessary work is done.
+// Just like with binary operators, we run into the need to have 4 different implementations:
+//    - (1)  dense +  dense =>  dense      (complexity O(N^3))
+//    - (2)  dense + sparse =>  dense      (complexity O(N^2))
+//    - (3) sparse +  dense =>  dense      (complexity O(N^2))
+//    - (4) sparse + sparse => sparse      (complexity O(N)  )
+//
+// Would be gread to implement proper "smart" GEMM and CRS-multiplication for sparse matrices, however that adds
+// an absolutely huge amount of complexity for x1.5-x3 speedup on matrix multiplication, which is already kind of
+// an afterthought provided here mainly for convenience and not for actual number crunching usage.
+//
+// We do however use some basic optimizations like loop reordering / temporaries / blocking to have a sensible baseline,
+// we properly account for sparsity which brings multiplication with sparse matrices from O(N^3) down to O(N^2) / O(N).
 
-    // Get column widths - we want matrix to format nice and aligned
-    std::vector<std::size_t> column_widths(strings.cols(), 0);
-    for (std::size_t i = 0; i < strings.rows(); ++i)
-        for (std::size_t j = 0; j < strings.cols(); ++j)
-            column_widths[j] = std::max(column_widths[j], strings(i, j).size());
+// (1)  dense +  dense =>  dense
+//
+// From benchmarks 1D blocking over "k" with a decently large block size seems to be more reliable than 2D/3D blocking.
+// When measuring varying matrix sizes and datatypes, for matrices with less than ~1k rows/cols (aka matrices that fully
+// fit into L2 cache) 1D blocking doesn't  seem to have much of an effect (positive or negative), while 2D/3D has often
+// lead to a slowdown for specific matrix  sizes. At large enough sizes blocking leads to a noticeable (~2x) speedup.
+// Note that this is all very hardware-specific, so it's difficult to make a truly generic judgement. In general,
+// blocking seems to be worth it.
+//
+// Note that unlike other binary operators, here there is no possible benefit in r-value reuse.
+//
+template <class L, class R,                                                                                //
+          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                        //
+          _is_nonsparse_tensor_enable_if<L>                 = true,                                        //
+          _is_nonsparse_tensor_enable_if<R>                 = true,                                        //
+          class value_type                                  = typename std::decay_t<L>::value_type,        //
+          class return_type                                 = typename std::decay_t<L>::owning_reflection, //
+          _has_binary_op_multiplies_enable_if<value_type>   = true,                                        //
+          _has_assignment_op_plus_enable_if<value_type>     = true                                         //
+          >
+return_type operator*(const L& left, const R& right) {
+    utl_mvl_assert(left.cols() == right.rows());
 
-    // Format with proper alignment
-    std::string buffer(begin);
-    for (std::size_t i = 0; i < strings.rows(); ++i) {
-        buffer += row_begin;
-        for (std::size_t j = 0; j < strings.cols(); ++j) {
-            if (strings(i, j).size() < column_widths[j]) buffer.append(column_widths[j] - strings(i, j).size(), ' ');
-            buffer += strings(i, j);
-            if (j + 1 < strings.cols()) buffer += col_delim;
+    using size_type = typename std::decay_t<L>::size_type;
+
+    const size_type N_i = left.rows(), N_k = left.cols(), N_j = right.cols();
+    // (N_i)x(N_k) * (N_k)x(N_j) => (N_i)x(N_j)
+
+    constexpr size_type block_size_kk = 32;
+
+    return_type res(N_i, N_j, value_type{});
+
+    for (size_type kk = 0; kk < N_k; kk += block_size_kk) {
+        const size_type k_extent = std::min(N_k, kk + block_size_kk);
+        // needed for matrices that aren't a multiple of block size
+        for (size_type i = 0; i < N_i; ++i) {
+            for (size_type k = kk; k < k_extent; ++k) {
+                const auto& r = left(i, k);
+                for (size_type j = 0; j < N_j; ++j) res(i, j) += r * right(k, j);
+            }
         }
-        buffer += row_end;
-        if (i + 1 < strings.rows()) buffer += row_delim;
     }
-    buffer += end;
 
-    return buffer;
+    return res;
 }
 
-// --- Human-readable formats ---
-// ------------------------------
+// (2)  dense + sparse =>  dense
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_vector(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
+// TODO:
 
-    std::string buffer = _tensor_meta_string(tensor);
+// (3) sparse +  dense =>  dense
 
-    buffer += "  { ";
-    for (std::size_t idx = 0; idx < tensor.size(); ++idx) {
-        buffer += stringifier(tensor[idx]);
-        if (idx + 1 < tensor.size()) buffer += ", ";
-    }
-    buffer += " }\n";
+// TODO:
 
-    return buffer;
-}
+// (4) sparse + sparse => sparse
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_dictionary(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor,
-                                        Func                                          stringifier = Func()) {
-    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
+// TODO:
 
-    std::string buffer = _tensor_meta_string(tensor);
+// Clear out internal macros
+#undef utl_mvl_tensor_arg_defs
+#undef utl_mvl_tensor_arg_vals
+#undef utl_mvl_require
+#undef utl_mvl_reqs
 
-    if constexpr (_dimension == Dimension::MATRIX) {
-        tensor.for_each([&](const T& elem, std::size_t i, std::size_t j) {
-            buffer += stringify("(", i, ", ", j, ") = ");
-            buffer += stringifier(elem);
-            buffer += '\n';
-        });
-    } else {
-        tensor.for_each([&](const T& elem, std::size_t i) {
-            buffer += stringify("(", i, ") = ");
-            buffer += stringifier(elem);
-            buffer += '\n';
-        });
-    }
+} // namespace utl::mvl
 
-    return buffer;
-}
+#endif
+#endif // module utl::mvl
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_matrix(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
 
-    return _generic_dense_format(tensor, _tensor_meta_string(tensor), "  [ ", " ", " ]\n", "", "", stringifier);
-}
 
-// --- Export formats ---
-// ----------------------
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_raw(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    return _generic_dense_format(tensor, "", "", " ", "\n", "", "", stringifier);
-}
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_csv(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    return _generic_dense_format(tensor, "", "", ", ", "\n", "", "", stringifier);
-}
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_json(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    return _generic_dense_format(tensor, "[\n", "    [ ", ", ", " ]", ",\n", "\n]\n", stringifier);
-}
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Module:        utl::parallel
+// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_parallel.md
+// Source repo:   https://github.com/DmitriBogdanov/UTL
+//
+// This project is licensed under the MIT License
+//
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_mathematica(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor,
-                                         Func                                          stringifier = Func()) {
-    return _generic_dense_format(tensor, "{\n", "    { ", ", ", " }", ",\n", "\n}\n", stringifier);
-}
+#if !defined(UTL_PICK_MODULES) || defined(UTLMODULE_PARALLEL)
+#ifndef UTLHEADERGUARD_PARALLEL
+#define UTLHEADERGUARD_PARALLEL
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_latex(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    return _generic_dense_format(tensor, "\\begin{pmatrix}\n", "  ", " & ", " \\\\\n", "", "\\end{pmatrix}\n",
-                                 stringifier);
-}
+// _______________________ INCLUDES _______________________
 
+#include <algorithm>          // sort(), merge()
+#include <array>              // array<>
+#include <atomic>             // atomic<>
+#include <condition_variable> // condition_variable
+#include <cstddef>            // size_t
+#include <deque>              // deque<>
+#include <exception>          // exception_ptr, current_exception(), rethrow_exception()
+#include <fstream>            // ifstream
+#include <functional>         // bind()
+#include <future>             // future<>, promise<>
+#include <iterator>           // iterator_traits<>, make_move_iterator()
+#include <limits>             // numeric_limits<>
+#include <memory>             // unique_ptr<>, make_unique<>(), allocator<>, allocator_arg
+#include <mutex>              // mutex, recursive_mutex, lock_guard<>, unique_lock<>
+#include <new>                // operator new, operator delete
+#include <optional>           // optional<>
+#include <string>             // string, to_string(), getline()
+#include <thread>             // thread
+#include <type_traits>        // decay_t<>, invoke_result_t<>
+#include <utility>            // forward<>(), exchange(), pair<>
+#include <vector>             // vector
 
-} // namespace format
+// Thread pinning & naming are OS-specific, modules are self-contained so we detect the platform here rather than
+// through 'utl::predef'. On other platforms corresponding pool options are accepted, but have no effect.
+#if defined(__linux__)
+#define utl_parallel_linux
+#include <pthread.h> // pthread_self(), pthread_setaffinity_np(), pthread_setname_np()
+#include <sched.h>   // cpu_set_t, CPU_ZERO(), CPU_SET(), CPU_ISSET(), sched_getaffinity()
+#elif defined(__APPLE__)
+#define utl_parallel_apple
+#include <pthread.h> // pthread_setname_np()
+#endif
 
-// ================================
-// --- Linear algebra operators ---
-// ================================
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h> // _mm_pause()
+#endif
 
-// --- Unary operator implementation ----
-// --------------------------------------
+// ____________________ DEVELOPER DOCS ____________________
 
-template <class L, class Op,                                                    //
-          _is_tensor_enable_if<L> = true,                                       //
-          class return_type       = typename std::decay_t<L>::owning_reflection //
-          >
-return_type apply_unary_op(L&& left, Op&& op) {
-    using reference = typename std::decay_t<L>::reference;
+// In C++20 'std::jthread' can be used to simplify code a bit, no reason not to do so.
+//
+// In C++20 '_unroll<>()' template can be improved to take index as a template-lambda-explicit-argument
+// rather than a regular arg, ensuring its constexpr'ness. This may lead to a slight performance boost
+// as truly manual unrolling seems to be slightly faster than automatic one.
 
-    // Reuse r-value if possible
-    return_type res = std::forward<L>(left);
+// ____________________ IMPLEMENTATION ____________________
 
-    // '.for_each()' takes care of possible sparsity
-    res.for_each([&](reference elem) { elem = op(std::move(elem)); });
+namespace utl::parallel {
 
-    return res;
-}
+// =============
+// --- Utils ---
+// =============
 
-// --- Unary operator API ----
-// ---------------------------
+template <class T, class Mutex = std::mutex>
+class MutexProtected {
+    T             value;
+    mutable Mutex mutex;
 
-// std <functional> has function objects for every operator possible,
-// except unary '+' for some reason, which is why we have to implement it ourselves.
-// This is the exact same thing as 'std::negate<>' but for operator '+'.
-template <class T>
-struct _unary_plus_functor {
-    constexpr T operator()(const T& lhs) const { return +lhs; }
-};
+public:
+    MutexProtected() = default;
+    MutexProtected(const T& value) : value(value), mutex() {}
+    MutexProtected(T&& value) : value(std::move(value)), mutex() {}
 
-template <class L, _is_tensor_enable_if<L> = true, class value_type = typename std::decay_t<L>::value_type,
-          _has_unary_op_plus_enable_if<value_type> = true>
-auto operator+(L&& left) {
-    return apply_unary_op(std::forward<L>(left), _unary_plus_functor<value_type>());
-}
+    template <class Func>
+    decltype(auto) apply(Func&& func) const {
+        const std::lock_guard lock(this->mutex);
+        return std::forward<Func>(func)(this->value);
+    }
 
-template <class L, _is_tensor_enable_if<L> = true, class value_type = typename std::decay_t<L>::value_type,
-          _has_unary_op_minus_enable_if<value_type> = true>
-auto operator-(L&& left) {
-    return apply_unary_op(std::forward<L>(left), std::negate<value_type>());
+    template <class Func>
+    decltype(auto) apply(Func&& func) {
+        const std::lock_guard lock(this->mutex);
+        return std::forward<Func>(func)(this->value);
+    }
+
+    [[nodiscard]] T&& release() { return std::move(this->value); }
+};
+
+[[nodiscard]] inline std::size_t max_thread_count() noexcept {
+    const std::size_t detected_threads = std::thread::hardware_concurrency();
+    return detected_threads ? detected_threads : 1;
+    // 'hardware_concurrency()' returns '0' if it can't determine the number of threads,
+    // in this case we reasonably assume there is a single thread available
 }
 
-// --- Binary operator implementation ---
-// --------------------------------------
+// 'std::min()' & 'std::max()' require both arguments to have the same type, which gets verbose once
+// we start mixing 'std::size_t' with iterator differences, so we implement 'std::size_t' min/max here
+[[nodiscard]] constexpr std::size_t _min_size(std::size_t a, std::size_t b) noexcept { return (b < a) ? b : a; }
+[[nodiscard]] constexpr std::size_t _max_size(std::size_t a, std::size_t b) noexcept { return (b < a) ? a : b; }
 
-// Doing things "in a dumb but simple way" would be to just have all operators take arguments as const-refs and
-// return a copy, however we can speed things up a lot by properly using perfect forwarding, which would reuse
-// r-values if possible to avoid allocation. Doing so would effectively change something like this:
-//    res = A + B - C - D + E
-// from 5 (!) copies to only 1, since first operator will create an r-value that gets propagated and reused by
-// all others. This however introduces it's own set of challenges since instead of traditional overloading we
-// now have to resort to SFINAE-driven imitation of it and carefully watch what we restrict.
+// Template for automatic loop unrolling.
 //
-// So here are the key points of implementing all of this:
+// It is used in 'parallel::reduce()' to (optionally) speed up a tight loop while leaving the user
+// with ability to easily control that unrolling. By default NO unrolling is used.
 //
-//    1. All unary and binary operators ('-', '+', '*' and etc.) can benefit from reusing r-values and moving
-//       one of the arguments into the result rather than copy. This can only happen to CONTAINER args that
-//       correspond to the return type.
+// Benchmarks indicate speedups ~130% to ~400% depending on CPU, compiler and options
+// large unrolling (32) seems to be the best on benchmarks, however it may bloat the binary
+// and take over too many branch predictor slots in case of min/max reductions, 4-8 seems
+// like a reasonable sweet spot for most machines.
 //
-//    2. Binary operators have following return types for different tensors:
-//       - (1)  dense +  dense =>  dense      (complexity O(N^2))
-//       - (2)  dense + sparse =>  dense      (complexity O(N)  )
-//       - (3) sparse +  dense =>  dense      (complexity O(N)  )
-//       - (4) sparse + sparse => sparse      (complexity O(N)  )
-//       return types inherit option arguments from the lhs and always have 'ownership == CONTAINER',
-//       while argument can be anything, including views. To implement the list above efficiently there
-//       is no other way but to make 4 separate implementation, tailored for each level of sparsity.
+// One may think that it is a job of compiler to perform such optimizations, yet even with
+// GCC '-Ofast -funroll-all-loop' and GCC unroll pragmas it fails to do them reliably.
 //
-//    3. All binary operators can be written in a generic form like 'apply_binary_operator(A, B, op)'
-//       and specialized with operator functors froms std <functional>. All we need for individual
-//       operators is to figure out correct boilerplate with perfect forwarding. "Overload resolution"
-//       will be performed by the 'apply_operator' method.
+// The reason it fails to do so is pretty clear for '-O2' and below - strictly speaking, most binary
+// operations on floats are non-commutative (sum depends on the order of addition, for example), however
+// since reduction is inherently not-order-preserving there is no harm in reordering operations some more
+// and unrolling the loop so compiler will be able to use SIMD if it sees it as possible (which it often does).
+//
+// Why vectorization of simple loops still tends to fail with '-Ofast' which reduces conformance and
+// allows reordering of math operations is unclear, but this is how it happens when actually measured.
+//
+template <class T, T... indices, class F>
+constexpr void _unroll_impl(std::integer_sequence<T, indices...>, F&& f) {
+    (f(std::integral_constant<T, indices>{}), ...);
+}
+template <class T, T count, class F>
+constexpr void _unroll(F&& f) {
+    _unroll_impl(std::make_integer_sequence<T, count>{}, std::forward<F>(f));
+}
+
+// Hints the CPU that we're in a spin-wait loop, this saves power & frees up resources for the sibling
+// hyper-thread. Falls back to a no-op on architectures we don't recognize.
+inline void _cpu_relax() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// ====================
+// --- Task storage ---
+// ====================
+
+// Move-only type-erased 'void()' callable with inline small-buffer storage.
+//
+// Thread pool used to store tasks as 'std::packaged_task<void()>', which allocates a shared state for every task
+// even when nobody asks for a future. Most tasks are small (a functor reference & a couple of indices), so we store
+// them inline and only fall back onto the heap for large or throwing-move callables. Buffer size is chosen so the
+// whole wrapper fits into 64 bytes.
+//
+// Unlike 'std::function' it doesn't require callables to be copyable, which lets us store promises & packaged tasks.
+
+constexpr std::size_t _task_buffer_size = 56;
+
+class _task {
+    struct vtable_type {
+        void (*invoke)(void* self);
+        void (*move)(void* dst, void* src) noexcept; // move-constructs 'dst' from 'src' and destroys 'src'
+        void (*destroy)(void* self) noexcept;
+    };
+
+    template <class Func>
+    constexpr static bool stored_inline = sizeof(Func) <= _task_buffer_size &&
+                                          alignof(Func) <= alignof(std::max_align_t) &&
+                                          std::is_nothrow_move_constructible_v<Func>;
+
+    template <class Func>
+    constexpr static vtable_type inline_vtable = {
+        [](void* self) { (*static_cast<Func*>(self))(); },
+        [](void* dst, void* src) noexcept {
+            ::new (dst) Func(std::move(*static_cast<Func*>(src)));
+            static_cast<Func*>(src)->~Func();
+        },
+        [](void* self) noexcept { static_cast<Func*>(self)->~Func(); }};
+
+    template <class Func>
+    constexpr static vtable_type heap_vtable = {
+        [](void* self) { (**static_cast<Func**>(self))(); },
+        [](void* dst, void* src) noexcept { *static_cast<Func**>(dst) = *static_cast<Func**>(src); },
+        [](void* self) noexcept { delete *static_cast<Func**>(self); }};
+
+    alignas(std::max_align_t) unsigned char buffer[_task_buffer_size];
+    const vtable_type*                      vtable = nullptr;
+
+public:
+    _task() noexcept = default;
+
+    template <class Func, std::enable_if_t<!std::is_same_v<std::decay_t<Func>, _task>, bool> = true>
+    explicit _task(Func&& func) {
+        using callable_type = std::decay_t<Func>;
+
+        if constexpr (stored_inline<callable_type>) {
+            ::new (static_cast<void*>(this->buffer)) callable_type(std::forward<Func>(func));
+            this->vtable = &inline_vtable<callable_type>;
+        } else {
+            ::new (static_cast<void*>(this->buffer)) callable_type*(new callable_type(std::forward<Func>(func)));
+            this->vtable = &heap_vtable<callable_type>;
+        }
+    }
+
+    _task(const _task&)            = delete;
+    _task& operator=(const _task&) = delete;
+
+    _task(_task&& other) noexcept { *this = std::move(other); }
+
+    _task& operator=(_task&& other) noexcept {
+        if (this == &other) return *this;
+
+        this->reset();
+        if (other.vtable) {
+            other.vtable->move(this->buffer, other.buffer);
+            this->vtable = std::exchange(other.vtable, nullptr);
+        }
+        return *this;
+    }
+
+    ~_task() { this->reset(); }
+
+    void reset() noexcept {
+        if (this->vtable) std::exchange(this->vtable, nullptr)->destroy(this->buffer);
+    }
+
+    void operator()() { this->vtable->invoke(this->buffer); }
+
+    explicit operator bool() const noexcept { return this->vtable != nullptr; }
+};
+
+// Thread-local cache of fixed-size memory blocks, used to recycle shared states of futures.
 //
-// It's a good question whether to threat binary '*' as element-wise product (which would be in line with other
-// operators) or a matrix product, but in the end it seems doing it element-wise would be too confusing for the
-// user, so we leave '*' as a matrix product and declare element-wise product as a function 'elementwise_product()'
-// since no existing operators seem suitable for such overload.
+// Blocks are often freed on a different thread than the one that allocated them (for example promise
+// dies on a worker, future dies on the caller), which is fine since every cache is capped and returns
+// surplus blocks to the heap. This keeps the common case of repeatedly submitting tasks allocation-free.
+template <std::size_t block_size>
+class _block_cache {
+    constexpr static std::size_t capacity = 256;
 
-// (1)  dense +  dense =>  dense
-template <class L, class R, class Op,                                                                     //
-          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
-          _is_nonsparse_tensor_enable_if<L>                 = true,                                       //
-          _is_nonsparse_tensor_enable_if<R>                 = true,                                       //
-          class return_type                                 = typename std::decay_t<L>::owning_reflection //
-          >
-return_type apply_binary_op(L&& left, R&& right, Op&& op) {
-    utl_mvl_assert(left.rows() == right.rows());
-    utl_mvl_assert(left.cols() == right.cols());
+    struct Storage {
+        std::size_t size = 0;
+        void*       blocks[capacity];
 
-    using reference = typename std::decay_t<L>::reference;
-    using size_type = typename std::decay_t<L>::size_type;
+        ~Storage() {
+            for (std::size_t i = 0; i < this->size; ++i) ::operator delete(this->blocks[i]);
+            destroyed = true;
+        }
+    };
 
-    return_type res;
+    inline static thread_local Storage storage;
+    inline static thread_local bool    destroyed = false;
+    // futures can outlive thread-local storage (for example when stored in a static variable), trivially
+    // destructible flag stays valid till the very end and lets us fall back onto the heap in such case
 
-    // Reuse r-value arguments if possible while preserving the order of operations
-    if constexpr (std::is_rvalue_reference_v<L> && std::decay_t<L>::params::ownership == Ownership::CONTAINER) {
-        res = std::forward<L>(left);
-        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(std::move(elem), right(i, j)); });
-    } else if constexpr (std::is_rvalue_reference_v<R> && std::decay_t<R>::params::ownership == Ownership::CONTAINER) {
-        res = std::forward<R>(right);
-        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(left(i, j), std::move(elem)); });
-    } else {
-        res = return_type(left.rows(), left.cols());
-        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(left(i, j), right(i, j)); });
+public:
+    [[nodiscard]] static void* allocate() {
+        if (destroyed || storage.size == 0) return ::operator new(block_size);
+        return storage.blocks[--storage.size];
     }
 
-    return res;
-}
+    static void deallocate(void* block) noexcept {
+        if (destroyed || storage.size == capacity) return ::operator delete(block);
+        storage.blocks[storage.size++] = block;
+    }
+};
 
-// (2)  dense + sparse =>  dense
-template <class L, class R, class Op,                                                                     //
-          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
-          _is_nonsparse_tensor_enable_if<L>                 = true,                                       //
-          _is_sparse_tensor_enable_if<R>                    = true,                                       //
-          class return_type                                 = typename std::decay_t<L>::owning_reflection //
-          >
-return_type apply_binary_op(L&& left, R&& right, Op&& op) {
-    utl_mvl_assert(left.rows() == right.rows());
-    utl_mvl_assert(left.cols() == right.cols());
+template <class T>
+struct _pooled_allocator {
+    using value_type = T;
 
-    using reference = typename std::decay_t<L>::reference;
-    using size_type = typename std::decay_t<L>::size_type;
+    constexpr static std::size_t block_size = (sizeof(T) + 15) / 16 * 16; // rounding lets similar types share caches
+    constexpr static bool        pooled     = alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__;
 
-    // Reuse r-value if possible
-    return_type res = std::forward<L>(left);
+    _pooled_allocator() noexcept = default;
 
-    // '.for_each()' to only iterate sparse elements
-    right.for_each([&](reference elem, size_type i, size_type j) { res(i, j) = op(std::move(res(i, j)), elem); });
+    template <class U>
+    _pooled_allocator(const _pooled_allocator<U>&) noexcept {}
 
-    return res;
-}
+    [[nodiscard]] T* allocate(std::size_t n) {
+        if constexpr (pooled)
+            if (n == 1) return static_cast<T*>(_block_cache<block_size>::allocate());
+        return std::allocator<T>{}.allocate(n);
+    }
 
-// (3) sparse +  dense =>  dense
-template <class L, class R, class Op,                                                                     //
-          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
-          _is_sparse_tensor_enable_if<L>                    = true,                                       //
-          _is_nonsparse_tensor_enable_if<R>                 = true,                                       //
-          class return_type                                 = typename std::decay_t<R>::owning_reflection //
-          >
-return_type apply_binary_op(L&& left, R&& right, Op&& op) {
-    utl_mvl_assert(left.rows() == right.rows());
-    utl_mvl_assert(left.cols() == right.cols());
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        if constexpr (pooled)
+            if (n == 1) return _block_cache<block_size>::deallocate(ptr);
+        std::allocator<T>{}.deallocate(ptr, n);
+    }
 
-    using reference = typename std::decay_t<R>::reference;
-    using size_type = typename std::decay_t<R>::size_type;
+    template <class U>
+    bool operator==(const _pooled_allocator<U>&) const noexcept {
+        return true;
+    }
+    template <class U>
+    bool operator!=(const _pooled_allocator<U>&) const noexcept {
+        return false;
+    }
+};
 
-    // Reuse r-value if possible
-    return_type res = std::forward<R>(right);
+// ========================
+// --- Thread placement ---
+// ========================
 
-    // '.for_each()' to only iterate sparse elements
-    left.for_each([&](reference elem, size_type i, size_type j) { res(i, j) = op(elem, std::move(res(i, j))); });
+// Worker pinning, similar to OpenMP 'proc_bind(close | spread)':
+//    - 'NONE'     - workers aren't pinned, OS is free to migrate them between CPUs
+//    - 'COMPACT'  - workers are packed onto consecutive CPUs, filling up one NUMA node before moving to the next
+//    - 'SCATTER'  - workers are spread round-robin across NUMA nodes, then across CPUs within each node
+//    - 'EXPLICIT' - worker 'i' is pinned to 'cpus[i % cpus.size()]' from a user-provided list
+// Compact placement keeps workers sharing caches & memory of a single node, scatter placement maximizes total
+// memory bandwidth. Pinning is only supported on Linux, on other platforms the option has no effect.
+enum class Affinity { NONE, COMPACT, SCATTER, EXPLICIT };
 
-    return res;
+// Parses Linux CPU list format used by sysfs, for example "0-3,8-11"
+[[nodiscard]] inline std::vector<std::size_t> _parse_cpu_list(const std::string& list) {
+    std::vector<std::size_t> cpus;
+
+    std::size_t i = 0;
+
+    const auto parse_number = [&](std::size_t& number) -> bool {
+        if (i >= list.size() || list[i] < '0' || list[i] > '9') return false;
+        number = 0;
+        while (i < list.size() && list[i] >= '0' && list[i] <= '9') number = number * 10 + (list[i++] - '0');
+        return true;
+    };
+
+    std::size_t first, last;
+    while (parse_number(first)) {
+        last = first;
+        if (i < list.size() && list[i] == '-' && !(++i, parse_number(last))) break;
+        for (std::size_t cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+
+        if (i < list.size() && list[i] == ',') ++i;
+        else break;
+    }
+
+    return cpus;
 }
 
-// (4) sparse + sparse => sparse
-template <class L, class R, class Op,                                                                     //
-          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
-          _is_sparse_tensor_enable_if<L>                    = true,                                       //
-          _is_sparse_tensor_enable_if<R>                    = true,                                       //
-          class return_type                                 = typename std::decay_t<L>::owning_reflection //
-          >
-return_type apply_binary_op(L&& left, R&& right, Op&& op) {
-    utl_mvl_assert(left.rows() == right.rows());
-    utl_mvl_assert(left.cols() == right.cols());
+[[nodiscard]] inline std::string _read_first_line(const std::string& path) {
+    std::ifstream file(path);
+    std::string   line;
+    std::getline(file, line);
+    return line;
+}
 
-    using sparse_entry = typename std::decay_t<L>::sparse_entry_type;
-    using value_type   = typename std::decay_t<L>::value_type;
+// CPUs available to the process grouped by NUMA node, nodes without available CPUs are skipped.
+// Machines without NUMA information (or non-Linux ones) are treated as a single node.
+[[nodiscard]] inline std::vector<std::vector<std::size_t>> _read_numa_topology() {
+    std::vector<std::vector<std::size_t>> nodes;
 
-    std::vector<sparse_entry> res_triplets;
-    res_triplets.reserve(std::max(left.size(), right.size()));
-    // not enough when matrices have different sparsity patterns, but good enough for initial guess
+#ifdef utl_parallel_linux
+    // Respect the process affinity mask, containers & 'taskset' often restrict the set of usable CPUs
+    cpu_set_t  allowed;
+    CPU_ZERO(&allowed);
+    const bool has_mask   = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+    const auto is_allowed = [&](std::size_t cpu) {
+        return !has_mask || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed));
+    };
 
-    std::size_t i = 0, j = 0;
+    const std::string sysfs = "/sys/devices/system/node/";
 
-    // Merge sparsity patterns
-    while (i < left.size() && j < right.size()) {
-        // Entry present only in lhs sparsity pattern
-        if (left._data[i] < right._data[j]) {
-            res_triplets.emplace_back(
-                _apply_binary_op_to_sparse_entry_and_value(std::forward<L>(left)._data[i++], value_type{}, op));
-        }
-        // Entry present only in rhs sparsity pattern
-        else if (left._data[i] > right._data[j]) {
-            res_triplets.emplace_back(
-                _apply_binary_op_to_value_and_sparse_entry(value_type{}, std::forward<R>(right)._data[j++], op));
-        }
-        // Entry present in both sparsity patterns
-        else {
-            res_triplets.emplace_back(_apply_binary_op_to_sparse_entries(std::forward<L>(left)._data[i++],
-                                                                         std::forward<R>(right)._data[j++], op));
-        }
+    for (std::size_t node : _parse_cpu_list(_read_first_line(sysfs + "online"))) {
+        std::vector<std::size_t> cpus;
+        for (std::size_t cpu : _parse_cpu_list(_read_first_line(sysfs + "node" + std::to_string(node) + "/cpulist")))
+            if (is_allowed(cpu)) cpus.push_back(cpu);
+        if (!cpus.empty()) nodes.push_back(std::move(cpus));
     }
-    // Copy the rest of lhs (if needed)
-    while (i < left.size()) res_triplets.emplace_back(std::forward<L>(left)._data[i++]);
-    // Copy the rest of rhs (if needed)
-    while (j < right.size()) res_triplets.emplace_back(std::forward<R>(right)._data[j++]);
 
-    return return_type(left.rows(), left.cols(), std::move(res_triplets));
-}
+    if (nodes.empty() && has_mask) {
+        std::vector<std::size_t> cpus;
+        for (std::size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            if (CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+        if (!cpus.empty()) nodes.push_back(std::move(cpus));
+    }
+#endif
 
-// --- Binary operator API ---
-// ---------------------------
+    if (nodes.empty()) {
+        std::vector<std::size_t> cpus(max_thread_count());
+        for (std::size_t cpu = 0; cpu < cpus.size(); ++cpu) cpus[cpu] = cpu;
+        nodes.push_back(std::move(cpus));
+    }
 
-template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
-          class value_type = typename std::decay_t<L>::value_type, _has_binary_op_plus_enable_if<value_type> = true>
-auto operator+(L&& left, R&& right) {
-    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::plus<value_type>());
+    return nodes;
 }
 
-template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
-          class value_type = typename std::decay_t<L>::value_type, _has_binary_op_minus_enable_if<value_type> = true>
-auto operator-(L&& left, R&& right) {
-    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::minus<value_type>());
+// Topology doesn't change during the runtime, no reason to read sysfs more than once
+[[nodiscard]] inline const std::vector<std::vector<std::size_t>>& _numa_topology() {
+    static const std::vector<std::vector<std::size_t>> topology = _read_numa_topology();
+    return topology;
 }
 
-template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
-          class value_type                                = typename std::decay_t<L>::value_type,
-          _has_binary_op_multiplies_enable_if<value_type> = true>
-auto elementwise_product(L&& left, R&& right) {
-    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::multiplies<value_type>());
-}
+struct _worker_placement {
+    std::optional<std::size_t> cpu;      // no value => worker isn't pinned
+    std::size_t                node = 0; // index of the NUMA node, used to prefer stealing from nearby workers
+};
 
-// --- Augmented assignment operator API ---
-// -----------------------------------------
+// Topology is taken as a parameter so the placement logic doesn't depend on the machine it runs on
+[[nodiscard]] inline std::vector<_worker_placement>
+_place_workers(std::size_t thread_count, Affinity affinity, const std::vector<std::size_t>& explicit_cpus,
+               const std::vector<std::vector<std::size_t>>& nodes) {
+    std::vector<_worker_placement> placement(thread_count);
 
-// These can just reuse corresponding binary operators while 'std::move()'ing lhs to avoid copying.
+    if (affinity == Affinity::NONE) return placement;
 
-template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
-          class value_type = typename std::decay_t<L>::value_type, _has_assignment_op_plus_enable_if<value_type> = true>
-L& operator+=(L&& left, R&& right) {
-    return (left = std::move(left) + right);
+    const auto node_of = [&](std::size_t cpu) -> std::size_t {
+        for (std::size_t node = 0; node < nodes.size(); ++node)
+            if (std::find(nodes[node].begin(), nodes[node].end(), cpu) != nodes[node].end()) return node;
+        return 0;
+    };
+
+    std::vector<std::size_t> compact_cpus; // CPUs ordered node by node
+    for (const auto& node : nodes) compact_cpus.insert(compact_cpus.end(), node.begin(), node.end());
+
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        if (affinity == Affinity::COMPACT) {
+            placement[i].cpu = compact_cpus[i % compact_cpus.size()];
+        } else if (affinity == Affinity::SCATTER) {
+            const auto& node = nodes[i % nodes.size()];
+            placement[i].cpu = node[(i / nodes.size()) % node.size()];
+        } else if (!explicit_cpus.empty()) {
+            placement[i].cpu = explicit_cpus[i % explicit_cpus.size()];
+        }
+
+        if (placement[i].cpu) placement[i].node = node_of(*placement[i].cpu);
+    }
+
+    return placement;
 }
 
-template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
-          class value_type                               = typename std::decay_t<L>::value_type,
-          _has_assignment_op_minus_enable_if<value_type> = true>
-L& operator-=(L&& left, R&& right) {
-    return (left = std::move(left) - right);
+[[nodiscard]] inline std::vector<_worker_placement>
+_place_workers(std::size_t thread_count, Affinity affinity, const std::vector<std::size_t>& explicit_cpus) {
+    if (affinity == Affinity::NONE) return std::vector<_worker_placement>(thread_count); // no need to read sysfs
+    return _place_workers(thread_count, affinity, explicit_cpus, _numa_topology());
 }
 
-// --- Matrix multiplication ---
-// -----------------------------
+// Failures are ignored, a CPU outside of the allowed set simply leaves the thread unpinned
+inline void _pin_current_thread(std::size_t cpu) {
+#ifdef utl_parallel_linux
+    if (cpu >= CPU_SETSIZE) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
 
-// Just like with binary operators, we run into the need to have 4 different implementations:
-//    - (1)  dense +  dense =>  dense      (complexity O(N^3))
-//    - (2)  dense + sparse =>  dense      (complexity O(N^2))
-//    - (3) sparse +  dense =>  dense      (complexity O(N^2))
-//    - (4) sparse + sparse => sparse      (complexity O(N)  )
-//
-// Would be gread to implement proper "smart" GEMM and CRS-multiplication for sparse matrices, however that adds
-// an absolutely huge amount of complexity for x1.5-x3 speedup on matrix multiplication, which is already kind of
-// an afterthought provided here mainly for convenience and not for actual number crunching usage.
-//
-// We do however use some basic optimizations like loop reordering / temporaries / blocking to have a sensible baseline,
-// we properly account for sparsity which brings multiplication with sparse matrices from O(N^3) down to O(N^2) / O(N).
+// Names show up in debuggers, 'top -H', 'perf' & other profilers, Linux limits them to 15 characters
+// so we truncate the prefix rather than the index which is what tells workers apart
+inline void _name_current_thread(const std::string& prefix, std::size_t index) {
+    const std::string suffix = "-" + std::to_string(index);
+#if defined(utl_parallel_linux)
+    const std::string name = prefix.substr(0, 15 - _min_size(15, suffix.size())) + suffix;
+    pthread_setname_np(pthread_self(), name.c_str());
+#elif defined(utl_parallel_apple)
+    pthread_setname_np((prefix + suffix).c_str());
+#else
+    (void)prefix;
+    (void)suffix;
+#endif
+}
 
-// (1)  dense +  dense =>  dense
+// ===================
+// --- Thread pool ---
+// ===================
+
+// A task threadpool, uploads of arbitrary callables as tasks, returns optional futures, supports pausing.
 //
-// From benchmarks 1D blocking over "k" with a decently large block size seems to be more reliable than 2D/3D blocking.
-// When measuring varying matrix sizes and datatypes, for matrices with less than ~1k rows/cols (aka matrices that fully
-// fit into L2 cache) 1D blocking doesn't  seem to have much of an effect (positive or negative), while 2D/3D has often
-// lead to a slowdown for specific matrix  sizes. At large enough sizes blocking leads to a noticeable (~2x) speedup.
-// Note that this is all very hardware-specific, so it's difficult to make a truly generic judgement. In general,
-// blocking seems to be worth it.
+// Pool supports 2 scheduling modes:
+//    - 'SHARED_QUEUE'  - a single FIFO queue shared by all workers, simple and fair
+//    - 'WORK_STEALING' - one deque per worker, workers pop their own deque from the back (LIFO, which keeps
+//                        recently produced data in cache) and steal from the front of other deques when idle
+// Under a single queue every submission & every pop contend on the same lock, which starts to dominate once
+// tasks are fine-grained and the thread count is high. Work stealing spreads that contention over per-worker
+// locks: tasks submitted from inside a worker go to its own deque, external submissions get distributed
+// round-robin. Both modes share the same implementation, shared queue is just a case with one deque.
 //
-// Note that unlike other binary operators, here there is no possible benefit in r-value reuse.
+// Worker deques are regular mutex-protected deques rather than lock-free Chase-Lev deques, uncontended
+// locks are cheap and this keeps the implementation simple while removing the global contention point.
 //
-template <class L, class R,                                                                                //
-          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                        //
-          _is_nonsparse_tensor_enable_if<L>                 = true,                                        //
-          _is_nonsparse_tensor_enable_if<R>                 = true,                                        //
-          class value_type                                  = typename std::decay_t<L>::value_type,        //
-          class return_type                                 = typename std::decay_t<L>::owning_reflection, //
-          _has_binary_op_multiplies_enable_if<value_type>   = true,                                        //
-          _has_assignment_op_plus_enable_if<value_type>     = true                                         //
-          >
-return_type operator*(const L& left, const R& right) {
-    utl_mvl_assert(left.cols() == right.rows());
+// Workers can be pinned to CPUs (see 'Affinity') & named for profiling. Pinned workers steal from workers
+// on the same NUMA node first, so stolen tasks are more likely to find their data in a nearby cache & memory.
 
-    using size_type = typename std::decay_t<L>::size_type;
-
-    const size_type N_i = left.rows(), N_k = left.cols(), N_j = right.cols();
-    // (N_i)x(N_k) * (N_k)x(N_j) => (N_i)x(N_j)
+// Note 1:
+// We don't use 'MutexProtected' here to make implementation a bit more decoupled, plus such idiom isn't nearly as
+// convenient once we enter the realm of non-trivial syncronization with recursive mutexes and condition variables.
 
-    constexpr size_type block_size_kk = 32;
+// Note 2:
+// Reconfiguring the pool with '.set_thread_count()' / '.set_scheduler()' is not supposed to happen concurrently
+// with task submission from other threads, same as with any other non-trivial reconfiguration of a pool.
+
+enum class Scheduler { SHARED_QUEUE, WORK_STEALING };
+
+// What idle threads do before going to sleep:
+//    1. Spin 'spin_count' iterations with a CPU 'pause' hint, checking for new tasks
+//    2. Call 'std::this_thread::yield()' 'yield_count' times, checking for new tasks
+//    3. Block on a condition variable until notified
+// Blocking right away (the default) costs nothing while idle, but every task submitted to a sleeping pool
+// pays for a futex wake-up, which is several microseconds of latency & gets paid again on every 'for_loop()'
+// in a tight outer loop. Spinning & yielding workers pick up new tasks almost immediately without being
+// notified, at the cost of burning CPU time while idle. Same policy applies to threads waiting for tasks,
+// for example to a thread that waits for 'for_loop()' to finish.
+//
+// Spinning only makes sense when workers don't compete with other threads for cores, on oversubscribed
+// machines spinning workers take time away from threads that do useful work.
+struct IdlePolicy {
+    std::size_t spin_count  = 0;
+    std::size_t yield_count = 0;
+};
 
-    return_type res(N_i, N_j, value_type{});
+constexpr std::size_t _cache_line_size = 64;
+// 'std::hardware_destructive_interference_size' would be the proper way to get this, but it isn't
+// implemented by some compilers and produces ABI warnings on others, 64 bytes is correct for most CPUs
 
-    for (size_type kk = 0; kk < N_k; kk += block_size_kk) {
-        const size_type k_extent = std::min(N_k, kk + block_size_kk);
-        // needed for matrices that aren't a multiple of block size
-        for (size_type i = 0; i < N_i; ++i) {
-            for (size_type k = kk; k < k_extent; ++k) {
-                const auto& r = left(i, k);
-                for (size_type j = 0; j < N_j; ++j) res(i, j) += r * right(k, j);
-            }
-        }
-    }
+class ThreadPool {
+private:
+    friend class TaskGroup;
 
-    return res;
-}
+    using task_type = _task;
 
-// (2)  dense + sparse =>  dense
+    struct alignas(_cache_line_size) TaskQueue {
+        std::mutex            mutex;
+        std::deque<task_type> tasks;
+    }; // aligned so different worker queues don't share cache lines
 
-// TODO:
+    std::vector<std::thread>     threads;
+    mutable std::recursive_mutex thread_mutex;
 
-// (3) sparse +  dense =>  dense
+    Scheduler                               scheduler = Scheduler::SHARED_QUEUE;
+    std::vector<std::unique_ptr<TaskQueue>> queues; // 1 queue for a shared queue mode, 1 per worker otherwise
+    std::atomic<std::size_t>                next_queue{0}; // round-robin counter for external submissions
+    std::vector<std::vector<std::size_t>>   steal_order;   // per-queue list of queues to steal from, nearest first
 
-// TODO:
+    Affinity                       affinity = Affinity::NONE;
+    std::vector<std::size_t>       affinity_cpus; // used by 'Affinity::EXPLICIT'
+    std::vector<_worker_placement> placement;     // computed on every (re)start, one per worker
+    std::string                    thread_name;   // workers are named '<thread_name>-<index>' unless empty
 
-// (4) sparse + sparse => sparse
+    mutable std::mutex      task_mutex;       // used for sleeping & waiting, queues themselves have separate locks
+    std::condition_variable task_cv;          // used to notify sleeping workers of new tasks
+    std::condition_variable task_finished_cv; // used to notify of all tasks being finished
 
-// TODO:
+    // Signals
+    std::atomic<bool> stopping{false}; // signal for workers to shut down '.worker_main()'
+    std::atomic<bool> paused{false};   // signal for workers to not pull new tasks from the queue
 
-// Clear out internal macros
-#undef utl_mvl_tensor_arg_defs
-#undef utl_mvl_tensor_arg_vals
-#undef utl_mvl_require
-#undef utl_mvl_reqs
+    std::atomic<std::size_t> tasks_queued{0};     // number of tasks waiting in the queues
+    std::atomic<std::size_t> tasks_unfinished{0}; // number of tasks queued or currently executed by workers
+    std::atomic<std::size_t> workers_sleeping{0}; // lets submission skip notification when nobody sleeps
 
-} // namespace utl::mvl
+    std::atomic<std::size_t> idle_spin_count{0};  // see 'IdlePolicy', read by idle threads before sleeping
+    std::atomic<std::size_t> idle_yield_count{0}; // which means policy can be changed without restarting workers
 
-#endif
-#endif // module utl::mvl
+    // Lets tasks know which pool & worker they are running on, used to submit nested tasks into local queues
+    inline static thread_local ThreadPool* current_pool   = nullptr;
+    inline static thread_local std::size_t current_worker = 0;
 
+    // --- Queues ---
 
+    void rebuild_queues(std::size_t queue_count) {
+        std::vector<std::unique_ptr<TaskQueue>> new_queues(queue_count);
+        for (auto& queue : new_queues) queue = std::make_unique<TaskQueue>();
 
+        // Tasks still waiting in the old queues (for example due to pause) get redistributed
+        std::size_t i = 0;
+        for (auto& queue : this->queues)
+            for (auto& task : queue->tasks) new_queues[i++ % queue_count]->tasks.push_back(std::move(task));
 
+        this->queues = std::move(new_queues);
 
+        // Victims are ordered by NUMA distance first & by index second, without pinning
+        // all workers count as a single node and this is a regular round-robin order
+        const auto node_of = [&](std::size_t queue) {
+            return queue < this->placement.size() ? this->placement[queue].node : std::size_t(0);
+        };
 
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-//
-// Module:        utl::parallel
-// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_parallel.md
-// Source repo:   https://github.com/DmitriBogdanov/UTL
-//
-// This project is licensed under the MIT License
-//
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+        this->steal_order.assign(queue_count, {});
+        if (queue_count == 1) return;
 
-#include <iterator>
-#if !defined(UTL_PICK_MODULES) || defined(UTLMODULE_PARALLEL)
-#ifndef UTLHEADERGUARD_PARALLEL
-#define UTLHEADERGUARD_PARALLEL
+        for (std::size_t home = 0; home < queue_count; ++home) {
+            auto& order = this->steal_order[home];
+            for (std::size_t offset = 1; offset < queue_count; ++offset) order.push_back((home + offset) % queue_count);
+            std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+                return (node_of(a) != node_of(home)) < (node_of(b) != node_of(home));
+            });
+        }
+    }
 
-// _______________________ INCLUDES _______________________
+    void push_task(task_type&& task) {
+        ++this->tasks_unfinished; // has to be incremented before the task can be seen & finished by a worker
 
-#include <condition_variable> // condition_variable
-#include <cstddef>            // size_t
-#include <functional>         // bind()
-#include <future>             // future<>, packaged_task<>
-#include <mutex>              // mutex, recursive_mutex, lock_guard<>, unique_lock<>
-#include <queue>              // queue<>
-#include <thread>             // thread
-#include <type_traits>        // decay_t<>, invoke_result_t<>
-#include <utility>            // forward<>()
-#include <vector>             // vector
+        const std::size_t queue_count = this->queues.size();
 
-// ____________________ DEVELOPER DOCS ____________________
+        std::size_t index = 0;
+        if (queue_count > 1) index = (current_pool == this) ? current_worker : this->next_queue++ % queue_count;
 
-// In C++20 'std::jthread' can be used to simplify code a bit, no reason not to do so.
-//
-// In C++20 '_unroll<>()' template can be improved to take index as a template-lambda-explicit-argument
-// rather than a regular arg, ensuring its constexpr'ness. This may lead to a slight performance boost
-// as truly manual unrolling seems to be slightly faster than automatic one.
+        {
+            TaskQueue&                        queue = *this->queues[index];
+            const std::lock_guard<std::mutex> queue_lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+            ++this->tasks_queued;
+        }
 
-// ____________________ IMPLEMENTATION ____________________
+        // Sleeping workers re-check 'tasks_queued' under the 'task_mutex' before going to sleep, locking it
+        // here ensures the notification can't slip in-between that check and the wait, which means no lost wakeups
+        if (this->workers_sleeping > 0) {
+            { const std::lock_guard<std::mutex> task_lock(this->task_mutex); }
+            this->task_cv.notify_one(); // wakes up one thread (if possible) so it can pull the new task
+        }
+    }
 
-namespace utl::parallel {
+    bool try_pop_task(std::size_t worker, task_type& task) {
+        if (this->tasks_queued == 0) return false; // quick escape, avoids locking every queue while idle
 
-// =============
-// --- Utils ---
-// =============
+        const std::size_t queue_count = this->queues.size();
+        const std::size_t home        = (queue_count == 1) ? 0 : worker;
 
-template <class T, class Mutex = std::mutex>
-class MutexProtected {
-    T             value;
-    mutable Mutex mutex;
+        // Own queue, LIFO when work stealing
+        {
+            TaskQueue&                        queue = *this->queues[home];
+            const std::lock_guard<std::mutex> queue_lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                if (this->scheduler == Scheduler::WORK_STEALING) {
+                    task = std::move(queue.tasks.back());
+                    queue.tasks.pop_back();
+                } else {
+                    task = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                }
+                --this->tasks_queued;
+                return true;
+            }
+        }
 
-public:
-    MutexProtected() = default;
-    MutexProtected(const T& value) : value(value), mutex() {}
-    MutexProtected(T&& value) : value(std::move(value)), mutex() {}
+        // Steal from other queues, FIFO
+        for (std::size_t victim : this->steal_order[home]) {
+            TaskQueue&                        queue = *this->queues[victim];
+            const std::lock_guard<std::mutex> queue_lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                --this->tasks_queued;
+                return true;
+            }
+        }
 
-    template <class Func>
-    decltype(auto) apply(Func&& func) const {
-        const std::lock_guard lock(this->mutex);
-        return std::forward<Func>(func)(this->value);
+        return false;
     }
 
-    template <class Func>
-    decltype(auto) apply(Func&& func) {
-        const std::lock_guard lock(this->mutex);
-        return std::forward<Func>(func)(this->value);
+    void run_task(task_type& task) {
+        try {
+            task();
+        } catch (...) {} // tasks with futures store their exceptions, fire-and-forget tasks have nowhere to report them
+        task.reset();    // release resources captured by the task before reporting it as finished
+
+        if (--this->tasks_unfinished == 0) {
+            { const std::lock_guard<std::mutex> task_lock(this->task_mutex); }
+            this->task_finished_cv.notify_all();
+        }
     }
 
-    [[nodiscard]] T&& release() { return std::move(this->value); }
-};
+    // --- Idling ---
 
-[[nodiscard]] inline std::size_t max_thread_count() noexcept {
-    const std::size_t detected_threads = std::thread::hardware_concurrency();
-    return detected_threads ? detected_threads : 1;
-    // 'hardware_concurrency()' returns '0' if it can't determine the number of threads,
-    // in this case we reasonably assume there is a single thread available
-}
+    // Spins & yields according to the idle policy, returns 'true' as soon as 'ready()' is satisfied,
+    // returns 'false' if the thread should proceed to block
+    template <class Pred>
+    bool spin_until(Pred&& ready) const {
+        const std::size_t spin_count  = this->idle_spin_count.load(std::memory_order_relaxed);
+        const std::size_t yield_count = this->idle_yield_count.load(std::memory_order_relaxed);
 
-// No reason to include the entirety of <algorithm> just for 2 one-liner functions,
-// so we implement 'std::size_t' min/max here
-[[nodiscard]] constexpr std::size_t _min_size(std::size_t a, std::size_t b) noexcept { return (b < a) ? b : a; }
-[[nodiscard]] constexpr std::size_t _max_size(std::size_t a, std::size_t b) noexcept { return (b < a) ? a : b; }
+        for (std::size_t i = 0; i < spin_count; ++i) {
+            if (ready()) return true;
+            _cpu_relax();
+        }
+        for (std::size_t i = 0; i < yield_count; ++i) {
+            if (ready()) return true;
+            std::this_thread::yield();
+        }
+        return false;
+    }
 
-// Template for automatic loop unrolling.
-//
-// It is used in 'parallel::reduce()' to (optionally) speed up a tight loop while leaving the user
-// with ability to easily control that unrolling. By default NO unrolling is used.
-//
-// Benchmarks indicate speedups ~130% to ~400% depending on CPU, compiler and options
-// large unrolling (32) seems to be the best on benchmarks, however it may bloat the binary
-// and take over too many branch predictor slots in case of min/max reductions, 4-8 seems
-// like a reasonable sweet spot for most machines.
-//
-// One may think that it is a job of compiler to perform such optimizations, yet even with
-// GCC '-Ofast -funroll-all-loop' and GCC unroll pragmas it fails to do them reliably.
-//
-// The reason it fails to do so is pretty clear for '-O2' and below - strictly speaking, most binary
-// operations on floats are non-commutative (sum depends on the order of addition, for example), however
-// since reduction is inherently not-order-preserving there is no harm in reordering operations some more
-// and unrolling the loop so compiler will be able to use SIMD if it sees it as possible (which it often does).
-//
-// Why vectorization of simple loops still tends to fail with '-Ofast' which reduces conformance and
-// allows reordering of math operations is unclear, but this is how it happens when actually measured.
-//
-template <class T, T... indices, class F>
-constexpr void _unroll_impl(std::integer_sequence<T, indices...>, F&& f) {
-    (f(std::integral_constant<T, indices>{}), ...);
-}
-template <class T, T count, class F>
-constexpr void _unroll(F&& f) {
-    _unroll_impl(std::make_integer_sequence<T, count>{}, std::forward<F>(f));
-}
+    // --- Helping ---
 
-// ===================
-// --- Thread pool ---
-// ===================
+    // Instead of blocking, threads waiting for some condition can execute pending tasks in the meantime.
+    // This is what makes nested parallelism possible: a worker waiting for its nested tasks keeps running
+    // them (or any other tasks) rather than blocking, so workers can't all end up waiting on each other.
+    template <class Pred>
+    void wait_and_help(Pred&& done) {
+        const std::size_t worker = (current_pool == this) ? current_worker : 0;
 
-// A simple single-queue task threadpool, uploads of arbitrary callables as tasks,
-// returns optional futures, supports pausing. Work stealing would probably be better
-// in a general case, however it complicates the implementation quite noticeably and
-// doesn't provide much measurable benefit under the API of this module.
+        task_type task;
 
-// Note:
-// We don't use 'MutexProtected' here to make implementation a bit more decoupled, plus such idiom isn't nearly as
-// convenient once we enter the realm of non-trivial syncronization with recursive mutexes and condition variables.
+        const auto ready = [&] { return done() || (!this->paused && this->tasks_queued > 0); };
 
-class ThreadPool {
-private:
-    std::vector<std::thread>     threads;
-    mutable std::recursive_mutex thread_mutex;
+        while (!done()) {
+            if (!this->paused && this->try_pop_task(worker, task)) {
+                this->run_task(task);
+                continue;
+            }
 
-    std::queue<std::packaged_task<void()>> tasks{};
-    mutable std::mutex                     task_mutex;
+            if (this->spin_until(ready)) continue;
 
-    std::condition_variable task_cv;          // used to notify changes to the task queue
-    std::condition_variable task_finished_cv; // used to notify of finished tasks
+            // Nothing to help with, sleep until there is a new task or condition is satisfied,
+            // see '.notify_helpers()'. Helpers sleep the same way workers do so submissions wake them up.
+            std::unique_lock<std::mutex> task_lock(this->task_mutex);
+            ++this->workers_sleeping;
+            this->task_cv.wait(task_lock, ready);
+            --this->workers_sleeping;
+        }
+    }
 
-    // Signals
-    bool stopping = false; // signal for workers to shut down '.worker_main()'
-    bool paused   = false; // signal for workers to not pull new tasks from the queue
-    bool waiting  = false; // signal for workers that they should notify 'task_finished_cv' when
-                           // finishing a task, which is used to implement 'wait for tasks' methods
+    // Should be called after making condition of some '.wait_and_help()' true
+    void notify_helpers() {
+        { const std::lock_guard<std::mutex> task_lock(this->task_mutex); }
+        this->task_cv.notify_all();
+    }
 
-    int tasks_running = 0; // number of tasks currently executed by workers
+    // --- Workers ---
 
     // Main function for worker threads,
-    // here workers wait for the queue, pull new tasks from it and run them
-    void thread_main() {
-        bool task_was_finished = false;
+    // here workers pull tasks from the queues and run them, sleeping when there is nothing to do
+    void thread_main(std::size_t worker) {
+        current_pool   = this;
+        current_worker = worker;
+
+        if (this->placement[worker].cpu) _pin_current_thread(*this->placement[worker].cpu);
+        if (!this->thread_name.empty()) _name_current_thread(this->thread_name, worker);
+
+        task_type task;
+
+        const auto ready = [&] { return this->stopping || (!this->paused && this->tasks_queued > 0); };
 
         while (true) {
-            std::unique_lock<std::mutex> task_lock(this->task_mutex);
+            if (!this->paused && this->try_pop_task(worker, task)) {
+                this->run_task(task);
+                continue;
+            }
 
-            if (task_was_finished) {
-                --this->tasks_running;
-                if (this->waiting) this->task_finished_cv.notify_all();
-                // no need to set 'task_was_finished' back to 'false',
-                // the only way we get back into this condition is if another task was finished
+            if (this->spin_until(ready)) {
+                if (this->stopping) break;
+                continue;
             }
 
             // Pool isn't destructing, isn't paused and there are tasks available in the queue
-            //    => continue execution, a new task from the queue and start executing it
+            //    => continue execution, pull a new task from the queue and start executing it
             // otherwise
             //    => unlock the mutex and wait until a new task is submitted,
             //       pool is unpaused or destruction is initiated
-            this->task_cv.wait(task_lock, [&] { return this->stopping || (!this->paused && !this->tasks.empty()); });
+            std::unique_lock<std::mutex> task_lock(this->task_mutex);
+            ++this->workers_sleeping;
+            this->task_cv.wait(task_lock, ready);
+            --this->workers_sleeping;
 
             if (this->stopping) break; // escape hatch for thread destruction
-
-            // Pull a new task from the queue and start executing it
-            std::packaged_task<void()> task_to_execute = std::move(this->tasks.front());
-            this->tasks.pop();
-            ++this->tasks_running;
-            task_lock.unlock();
-
-            task_to_execute(); // NOTE: Should I catch exceptions here?
-            task_was_finished = true;
         }
+
+        current_pool = nullptr;
     }
 
-    void start_threads(std::size_t worker_count_increase) {
+    void start_threads(std::size_t thread_count) {
         const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
         // the mutex has to be recursive because we call '.start_threads()' inside '.set_num_threads()'
         // which also locks 'worker_mutex', if mutex wan't recursive we would deadlock trying to lock
         // it a 2nd time on the same thread.
 
-        // NOTE: It feels like '.start_threads()' can be split into '.start_threads()' and
-        // '._start_threads_assuming_locked()' which would remove the need for recursive mutex
+        // Workers index their own queues & placement, which means those have to be set up before workers start
+        this->placement = _place_workers(thread_count, this->affinity, this->affinity_cpus);
+        this->rebuild_queues(this->scheduler == Scheduler::WORK_STEALING ? _max_size(thread_count, 1) : 1);
 
-        for (std::size_t i = 0; i < worker_count_increase; ++i)
-            this->threads.emplace_back(&ThreadPool::thread_main, this);
+        this->stopping = false;
+        for (std::size_t i = 0; i < thread_count; ++i) this->threads.emplace_back(&ThreadPool::thread_main, this, i);
     }
 
     void stop_all_threads() {
@@ -6674,13 +9665,24 @@ class ThreadPool {
         this->threads.clear();
     }
 
+    void restart_threads(std::size_t thread_count) {
+        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
+        this->stop_all_threads();
+        this->start_threads(thread_count);
+        // Restarting the whole pool is the simplest way to keep per-worker queues consistent with the workers,
+        // reconfiguration is rare enough for this to not matter
+    }
+
 public:
     // --- Construction ---
     // --------------------
 
-    ThreadPool() = default;
+    ThreadPool() : ThreadPool(0) {}
 
-    explicit ThreadPool(std::size_t thread_count) { this->start_threads(thread_count); }
+    explicit ThreadPool(std::size_t thread_count, Scheduler scheduler = Scheduler::SHARED_QUEUE)
+        : scheduler(scheduler) {
+        this->start_threads(thread_count);
+    }
 
     ~ThreadPool() {
         this->unpause();
@@ -6698,25 +9700,95 @@ class ThreadPool {
 
     void set_thread_count(std::size_t thread_count) {
         this->wait_for_tasks(); // all threads need to be free
-        
-        const std::size_t current_thread_count = this->get_thread_count();
 
-        if (thread_count == current_thread_count) return;
+        if (thread_count == this->get_thread_count()) return;
         // 'quick escape' so we don't experience too much slowdown when the user calls '.set_thread_count()' repeatedly
 
-        if (thread_count > current_thread_count) {
-            this->start_threads(thread_count - current_thread_count);
-        } else {
-            this->stop_all_threads();
-            {
-                const std::lock_guard<std::mutex> task_lock(this->task_mutex);
-                this->stopping = false;
-            }
-            this->start_threads(thread_count);
-            // It is possible to improve implementation by making the pool shrink by joining only the necessary amount
-            // of threads instead of recreating the the whole pool, however that task is non-trivial and would likely
-            // require a more granular signaling with one flag per thread instead of a global 'stopping' flag.
-        }
+        this->restart_threads(thread_count);
+    }
+
+    // --- Scheduling ---
+    // ------------------
+
+    [[nodiscard]] Scheduler get_scheduler() const {
+        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
+        return this->scheduler;
+    }
+
+    void set_scheduler(Scheduler scheduler) {
+        this->wait_for_tasks(); // all threads need to be free
+
+        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
+
+        if (scheduler == this->scheduler) return;
+
+        this->scheduler = scheduler;
+        this->restart_threads(this->threads.size());
+    }
+
+    // --- Idling ---
+    // --------------
+
+    [[nodiscard]] IdlePolicy get_idle_policy() const {
+        return {this->idle_spin_count.load(std::memory_order_relaxed),
+                this->idle_yield_count.load(std::memory_order_relaxed)};
+    }
+
+    void set_idle_policy(IdlePolicy policy) {
+        this->idle_spin_count.store(policy.spin_count, std::memory_order_relaxed);
+        this->idle_yield_count.store(policy.yield_count, std::memory_order_relaxed);
+    }
+
+    // --- Placement ---
+    // -----------------
+
+    [[nodiscard]] Affinity get_affinity() const {
+        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
+        return this->affinity;
+    }
+
+    void set_affinity(Affinity affinity) {
+        this->wait_for_tasks(); // all threads need to be free
+
+        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
+
+        if (affinity == this->affinity) return;
+
+        // Workers read placement settings on startup, they can only change while no workers exist
+        const std::size_t thread_count = this->threads.size();
+        this->stop_all_threads();
+        this->affinity = affinity;
+        this->start_threads(thread_count);
+    }
+
+    void set_affinity(std::vector<std::size_t> cpus) {
+        this->wait_for_tasks(); // all threads need to be free
+
+        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
+
+        const std::size_t thread_count = this->threads.size();
+        this->stop_all_threads();
+        this->affinity      = Affinity::EXPLICIT;
+        this->affinity_cpus = std::move(cpus);
+        this->start_threads(thread_count);
+    }
+
+    [[nodiscard]] std::string get_thread_name() const {
+        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
+        return this->thread_name;
+    }
+
+    void set_thread_name(std::string name) {
+        this->wait_for_tasks(); // all threads need to be free
+
+        const std::lock_guard<std::recursive_mutex> thread_lock(this->thread_mutex);
+
+        if (name == this->thread_name) return;
+
+        const std::size_t thread_count = this->threads.size();
+        this->stop_all_threads();
+        this->thread_name = std::move(name);
+        this->start_threads(thread_count);
     }
 
     // --- Task queue ---
@@ -6724,77 +9796,157 @@ class ThreadPool {
 
     template <class Func, class... Args>
     void add_task(Func&& func, Args&&... args) {
-        const std::lock_guard<std::mutex> task_lock(this->task_mutex);
-        this->tasks.emplace(std::bind(std::forward<Func>(func), std::forward<Args>(args)...));
-        this->task_cv.notify_one(); // wakes up one thread (if possible) so it can pull the new task
+        this->push_task(task_type(std::bind(std::forward<Func>(func), std::forward<Args>(args)...)));
     }
 
     template <class Func, class... Args,
               class FuncReturnType = std::invoke_result_t<std::decay_t<Func>, std::decay_t<Args>...>>
     [[nodiscard]] std::future<FuncReturnType> add_task_with_future(Func&& func, Args&&... args) {
-#if defined(_MSC_VER) || defined(_MSC_FULL_VER)
-        // MSVC messed up implementation of 'std::packaged_task<>' so it is not movable (which,
-        // according to the standard, it should be) and they can't fix it for 7 (and counting) years
-        // because fixing the bug would change the ABI. See this thread about the bug report:
-        // https://developercommunity.visualstudio.com/t/unable-to-move-stdpackaged-task-into-any-stl-conta/108672
-        // As a workaround we wrap the packaged task into a shared pointer and add another layer of packaging.
-        auto new_task = std::make_shared<std::packaged_task<FuncReturnType()>>(
-            std::bind(std::forward<Func>(func), std::forward<Args>(args)...));
-        this->add_task([new_task] { (*new_task)(); }); // horrible
-        return new_task->get_future();
-#else
-        std::packaged_task<FuncReturnType()> new_task(std::bind(std::forward<Func>(func), std::forward<Args>(args)...));
-        auto                                 future = new_task.get_future();
-        this->add_task(std::move(new_task));
+        // Shared state is allocated through a pooled allocator so repeated submissions recycle the same memory,
+        // promise is move-only which is fine since '_task' doesn't require copyability. This also sidesteps MSVC
+        // 'std::packaged_task<>' not being movable, which used to require wrapping it into a shared pointer.
+        std::promise<FuncReturnType> promise(std::allocator_arg, _pooled_allocator<char>{}); // gets rebound
+        auto                         future = promise.get_future();
+
+        auto task = std::bind(std::forward<Func>(func), std::forward<Args>(args)...);
+
+        this->push_task(task_type([promise = std::move(promise), task = std::move(task)]() mutable {
+            try {
+                if constexpr (std::is_void_v<FuncReturnType>) {
+                    task();
+                    promise.set_value();
+                } else promise.set_value(task());
+            } catch (...) { promise.set_exception(std::current_exception()); }
+        }));
+
         return future;
-#endif
     }
 
     void wait_for_tasks() {
         std::unique_lock<std::mutex> task_lock(this->task_mutex);
-        this->waiting = true;
-        this->task_finished_cv.wait(task_lock, [&] { return this->tasks.empty() && this->tasks_running == 0; });
-        this->waiting = false;
+        this->task_finished_cv.wait(task_lock, [&] { return this->tasks_unfinished == 0; });
     }
 
     void clear_task_queue() {
-        const std::lock_guard<std::mutex> task_lock(this->task_mutex);
-        this->tasks = {}; // for some reason 'std::queue' has no '.clear()', complexity O(N)
+        std::size_t cleared = 0;
+        for (auto& queue : this->queues) {
+            const std::lock_guard<std::mutex> queue_lock(queue->mutex);
+            cleared += queue->tasks.size();
+            this->tasks_queued -= queue->tasks.size();
+            queue->tasks.clear();
+        }
+
+        if (cleared && (this->tasks_unfinished -= cleared) == 0) {
+            { const std::lock_guard<std::mutex> task_lock(this->task_mutex); }
+            this->task_finished_cv.notify_all();
+        }
     }
 
     // --- Pausing ---
     // ---------------
 
-    void pause() {
-        const std::lock_guard<std::mutex> task_lock(this->task_mutex);
-        this->paused = true;
-    }
+    void pause() {
+        const std::lock_guard<std::mutex> task_lock(this->task_mutex);
+        this->paused = true;
+    }
+
+    void unpause() {
+        const std::lock_guard<std::mutex> task_lock(this->task_mutex);
+        this->paused = false;
+        this->task_cv.notify_all();
+    }
+
+    [[nodiscard]] bool is_paused() const { return this->paused; }
+};
+
+// =====================================
+// --- Static thread pool operations ---
+// =====================================
+
+inline ThreadPool& static_thread_pool() {
+    // no '[nodiscard]' since a call to this function might be used to initialize a threadpool
+    static ThreadPool pool(max_thread_count());
+    return pool;
+}
+
+[[nodiscard]] inline std::size_t get_thread_count() { return static_thread_pool().get_thread_count(); }
+
+inline void set_thread_count(std::size_t thread_count) { static_thread_pool().set_thread_count(thread_count); }
+
+[[nodiscard]] inline Scheduler get_scheduler() { return static_thread_pool().get_scheduler(); }
+
+inline void set_scheduler(Scheduler scheduler) { static_thread_pool().set_scheduler(scheduler); }
+
+[[nodiscard]] inline IdlePolicy get_idle_policy() { return static_thread_pool().get_idle_policy(); }
+
+inline void set_idle_policy(IdlePolicy policy) { static_thread_pool().set_idle_policy(policy); }
+
+[[nodiscard]] inline Affinity get_affinity() { return static_thread_pool().get_affinity(); }
+
+inline void set_affinity(Affinity affinity) { static_thread_pool().set_affinity(affinity); }
+
+inline void set_affinity(std::vector<std::size_t> cpus) { static_thread_pool().set_affinity(std::move(cpus)); }
+
+[[nodiscard]] inline std::string get_thread_name() { return static_thread_pool().get_thread_name(); }
+
+inline void set_thread_name(std::string name) { static_thread_pool().set_thread_name(std::move(name)); }
+
+// ==================
+// --- Task group ---
+// ==================
+
+// A handle for a group of tasks that can be waited on independently from the rest of the pool.
+//
+// Waiting on the whole pool from inside a task would deadlock (the task itself is never finished while it waits)
+// and makes unrelated parallel sections wait on each other. Task group only waits for its own tasks, and does so
+// by helping to execute pending tasks, which makes nested parallel loops & divide-and-conquer algorithms possible.
+//
+// Exceptions thrown by the tasks are captured, the first one gets rethrown by '.wait()'.
+
+class TaskGroup {
+    ThreadPool&              pool;
+    std::atomic<std::size_t> tasks_pending{0};
+
+    std::mutex         exception_mutex;
+    std::exception_ptr exception;
 
-    void unpause() {
-        const std::lock_guard<std::mutex> task_lock(this->task_mutex);
-        this->paused = false;
-        this->task_cv.notify_all();
+    void wait_without_rethrow() {
+        this->pool.wait_and_help([&] { return this->tasks_pending == 0; });
     }
 
-    [[nodiscard]] bool is_paused() const {
-        const std::lock_guard<std::mutex> task_lock(this->task_mutex);
-        return this->paused;
-    }
-};
+public:
+    explicit TaskGroup(ThreadPool& pool = static_thread_pool()) : pool(pool) {}
 
-// =====================================
-// --- Static thread pool operations ---
-// =====================================
+    TaskGroup(const TaskGroup&)            = delete;
+    TaskGroup(TaskGroup&&)                 = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    TaskGroup& operator=(TaskGroup&&)      = delete;
 
-inline ThreadPool& static_thread_pool() {
-    // no '[nodiscard]' since a call to this function might be used to initialize a threadpool
-    static ThreadPool pool(max_thread_count());
-    return pool;
-}
+    ~TaskGroup() { this->wait_without_rethrow(); } // tasks reference the group, it can't die before they finish
 
-[[nodiscard]] inline std::size_t get_thread_count() { return static_thread_pool().get_thread_count(); }
+    template <class Func, class... Args>
+    void add_task(Func&& func, Args&&... args) {
+        ++this->tasks_pending;
+
+        this->pool.add_task([this, task = std::bind(std::forward<Func>(func), std::forward<Args>(args)...)]() mutable {
+            try {
+                task();
+            } catch (...) {
+                const std::lock_guard<std::mutex> exception_lock(this->exception_mutex);
+                if (!this->exception) this->exception = std::current_exception();
+            }
 
-inline void set_thread_count(std::size_t thread_count) { static_thread_pool().set_thread_count(thread_count); }
+            ThreadPool& pool = this->pool; // group may be destroyed as soon as the counter reaches zero
+            if (--this->tasks_pending == 0) pool.notify_helpers();
+        });
+    }
+
+    void wait() {
+        this->wait_without_rethrow();
+
+        if (this->exception) std::rethrow_exception(std::exchange(this->exception, nullptr));
+    }
+};
 
 // ================
 // --- Task API ---
@@ -6823,6 +9975,11 @@ constexpr std::size_t default_grains_per_thread = 4;
 // yet we want it to be a bit more granular than doing 1 task per thread since
 // that would be horrible if tasks are noticeably uneven.
 
+// Pool with no threads still runs tasks on the waiting thread, for splitting purposes it counts as 1 thread
+[[nodiscard]] inline std::size_t _default_grain_size(std::size_t range_size) {
+    return _max_size(1, range_size / (_max_size(1, get_thread_count()) * default_grains_per_thread));
+}
+
 // Note:
 // In range constructors we intentionally allow some possibly narrowing conversions like 'it1 - it2' to 'size_t'
 // for better compatibility with containers that can use large ints as their difference type
@@ -6837,7 +9994,7 @@ struct IndexRange {
     constexpr IndexRange(Idx first, Idx last, std::size_t grain_size)
         : first(first), last(last), grain_size(grain_size) {}
     IndexRange(Idx first, Idx last)
-        : IndexRange(first, last, _max_size(1, (last - first) / (get_thread_count() * default_grains_per_thread))){};
+        : IndexRange(first, last, _default_grain_size(last - first)){};
 };
 
 template <class Iter>
@@ -6849,13 +10006,14 @@ struct Range {
     Range() = delete;
     constexpr Range(Iter begin, Iter end, std::size_t grain_size) : begin(begin), end(end), grain_size(grain_size) {}
     Range(Iter begin, Iter end)
-        : Range(begin, end, _max_size(1, (end - begin) / (get_thread_count() * default_grains_per_thread))) {}
+        : Range(begin, end, _default_grain_size(end - begin)) {}
 
 
-    template <class Container>
+    // Copying a non-const 'Range' lvalue would pick templated constructors over the copy constructor, hence the SFINAE
+    template <class Container, std::enable_if_t<!std::is_same_v<std::remove_cv_t<Container>, Range>, bool> = true>
     Range(const Container& container) : Range(container.begin(), container.end()) {}
 
-    template <class Container>
+    template <class Container, std::enable_if_t<!std::is_same_v<std::remove_cv_t<Container>, Range>, bool> = true>
     Range(Container& container) : Range(container.begin(), container.end()) {}
 };// requires random-access iterator, but no good way to express that before C++20 concepts
 
@@ -6871,29 +10029,288 @@ Range(const Container& container) -> Range<typename Container::const_iterator>;
 template <class Container>
 Range(Container& container) -> Range<typename Container::iterator>;
 
+// --- Multi-dimensional ranges ---
+// --------------------------------
+
+// Blocked 2D / 3D index spaces, each dimension is an 'IndexRange' whose 'grain_size' acts as the tile extent
+// along that dimension. Dimensions are listed from the outermost (slowest-varying) to the innermost one, which
+// for a row-major matrix means '{ rows, cols }'.
+//
+// Tile traversal order decides which tiles end up next to each other in a task (and in time):
+//    - 'ROW_MAJOR' - tiles are walked row by row, same as a regular nested loop
+//    - 'MORTON'    - tiles are walked along the Z-order curve, consecutive tiles stay close in every dimension,
+//                    which helps kernels that also touch neighbouring tiles (stencils, transposition, etc.)
+enum class Traversal { ROW_MAJOR, MORTON };
+
+constexpr std::size_t default_tile_size_2d = 64;
+constexpr std::size_t default_tile_size_3d = 16;
+// 64x64 doubles is 32 KiB & 16x16x16 doubles is another 32 KiB, which is a tile of input & a tile of output
+// fitting into a typical 32-64 KiB L1 cache. Like 'default_grains_per_thread' this is empirical rather than exact.
+
+template <class Idx>
+struct IndexRange2D {
+    IndexRange<Idx> i;
+    IndexRange<Idx> j;
+    Traversal       traversal;
+
+    IndexRange2D() = delete;
+    constexpr IndexRange2D(IndexRange<Idx> i, IndexRange<Idx> j, Traversal traversal = Traversal::ROW_MAJOR)
+        : i(i), j(j), traversal(traversal) {}
+    constexpr IndexRange2D(Idx i_extent, Idx j_extent, Traversal traversal = Traversal::ROW_MAJOR)
+        : IndexRange2D({Idx{}, i_extent, default_tile_size_2d}, {Idx{}, j_extent, default_tile_size_2d}, traversal) {}
+
+    // Accepts any matrix-like type with '.rows()' & '.cols()', such as 'mvl::Matrix'
+    template <class Matrix, class = decltype(std::declval<const Matrix&>().cols())>
+    explicit IndexRange2D(const Matrix& matrix, Traversal traversal = Traversal::ROW_MAJOR)
+        : IndexRange2D(static_cast<Idx>(matrix.rows()), static_cast<Idx>(matrix.cols()), traversal) {}
+};
+
+template <class Matrix, class = decltype(std::declval<const Matrix&>().cols())>
+IndexRange2D(const Matrix& matrix) -> IndexRange2D<decltype(std::declval<const Matrix&>().rows())>;
+
+template <class Matrix, class = decltype(std::declval<const Matrix&>().cols())>
+IndexRange2D(const Matrix& matrix, Traversal traversal) -> IndexRange2D<decltype(std::declval<const Matrix&>().rows())>;
+
+template <class Idx>
+struct IndexRange3D {
+    IndexRange<Idx> i;
+    IndexRange<Idx> j;
+    IndexRange<Idx> k;
+    Traversal       traversal;
+
+    IndexRange3D() = delete;
+    constexpr IndexRange3D(IndexRange<Idx> i, IndexRange<Idx> j, IndexRange<Idx> k,
+                           Traversal traversal = Traversal::ROW_MAJOR)
+        : i(i), j(j), k(k), traversal(traversal) {}
+    constexpr IndexRange3D(Idx i_extent, Idx j_extent, Idx k_extent, Traversal traversal = Traversal::ROW_MAJOR)
+        : IndexRange3D({Idx{}, i_extent, default_tile_size_3d}, {Idx{}, j_extent, default_tile_size_3d},
+                       {Idx{}, k_extent, default_tile_size_3d}, traversal) {}
+};
+
 // ==========================
 // --- 'Parallel for' API ---
 // ==========================
 
+// Loops only wait for their own tasks, which means they can be safely nested and called from inside other tasks
+
+// Loop schedules, similar to OpenMP 'schedule(static | dynamic | guided)':
+//    - 'STATIC'  - range gets split into 'grain_size' chunks upfront, each chunk is submitted as a separate task
+//    - 'DYNAMIC' - 1 task per thread, tasks claim 'grain_size' chunks from a shared atomic counter until the range
+//                  is exhausted, threads that got cheap iterations simply claim more chunks
+//    - 'GUIDED'  - same as 'DYNAMIC', but the claimed chunk is proportional to the remaining work and shrinks
+//                  down to 'grain_size', large chunks at the start keep claiming overhead low, small chunks
+//                  at the end balance out the tail
+// Static schedule has the least overhead and works best when iterations have similar cost, dynamic & guided
+// schedules are meant for irregular workloads where a fixed split leaves threads idle at the tail.
+//
+// Not to be confused with 'Scheduler', which selects how the pool itself distributes tasks between workers.
+enum class Schedule { STATIC, DYNAMIC, GUIDED };
+
+// Runs 'func(low, high)' over sub-ranges of '[0, size)' claimed from a shared counter, used by non-static schedules
+template <class Func>
+void _for_loop_claiming(std::size_t size, std::size_t grain_size, Schedule schedule, Func& func) {
+    if (size == 0) return;
+
+    const std::size_t thread_count = _max_size(1, get_thread_count());
+    const std::size_t min_chunk    = _max_size(1, grain_size);
+    const std::size_t task_count   = _min_size(thread_count, (size + min_chunk - 1) / min_chunk);
+
+    std::atomic<std::size_t> next{0};
+    // relaxed ordering is sufficient, the counter only partitions the range,
+    // results are synchronized by the task group once the loop is finished
+
+    const auto claim = [&](std::size_t& low, std::size_t& high) -> bool {
+        if (schedule == Schedule::DYNAMIC) {
+            low = next.fetch_add(min_chunk, std::memory_order_relaxed);
+            if (low >= size) return false;
+            high = _min_size(low + min_chunk, size);
+            return true;
+        }
+
+        low = next.load(std::memory_order_relaxed);
+        do {
+            if (low >= size) return false;
+            const std::size_t remaining = size - low;
+            high = low + _min_size(remaining, _max_size(min_chunk, remaining / (2 * thread_count)));
+        } while (!next.compare_exchange_weak(low, high, std::memory_order_relaxed));
+        return true;
+    };
+
+    const auto run = [&] {
+        std::size_t low, high;
+        while (claim(low, high)) func(low, high);
+    };
+
+    TaskGroup group;
+
+    for (std::size_t i = 0; i < task_count; ++i) group.add_task(std::ref(run));
+
+    group.wait();
+}
+
 template <class Idx, class Func>
-void for_loop(IndexRange<Idx> range, Func&& func) {
-    for (Idx i = range.first; i < range.last; i += range.grain_size)
-        task(std::forward<Func>(func), i, _min_size(i + range.grain_size, range.last));
+void for_loop(IndexRange<Idx> range, Func&& func, Schedule schedule = Schedule::STATIC) {
+    if (schedule != Schedule::STATIC) {
+        if (!(range.first < range.last)) return;
+
+        auto offset_func = [&](std::size_t low, std::size_t high) {
+            func(static_cast<Idx>(range.first + low), static_cast<Idx>(range.first + high));
+        };
+        _for_loop_claiming(range.last - range.first, range.grain_size, schedule, offset_func);
+        return;
+    }
+
+    const std::size_t grain_size = _max_size(1, range.grain_size);
+
+    TaskGroup group;
 
-    wait_for_tasks();
+    for (Idx i = range.first; i < range.last; i += grain_size) {
+        const bool is_last_chunk = static_cast<std::size_t>(range.last - i) <= grain_size;
+        group.add_task(std::ref(func), i, is_last_chunk ? range.last : static_cast<Idx>(i + grain_size));
+    } // no '_min_size()' here since it would break for negative indices
+
+    group.wait();
 }
 
 template <class Iter, class Func>
-void for_loop(Range<Iter> range, Func&& func) {
-    for (Iter i = range.begin; i < range.end; i += range.grain_size)
-        task(std::forward<Func>(func), i, i + _min_size(range.grain_size, range.end - i));
+void for_loop(Range<Iter> range, Func&& func, Schedule schedule = Schedule::STATIC) {
+    if (schedule != Schedule::STATIC) {
+        if (!(range.begin < range.end)) return;
+
+        auto offset_func = [&](std::size_t low, std::size_t high) { func(range.begin + low, range.begin + high); };
+        _for_loop_claiming(range.end - range.begin, range.grain_size, schedule, offset_func);
+        return;
+    }
 
-    wait_for_tasks();
+    const std::size_t grain_size = _max_size(1, range.grain_size);
+
+    TaskGroup group;
+
+    for (Iter i = range.begin; i < range.end; i += grain_size)
+        group.add_task(std::ref(func), i, i + _min_size(grain_size, range.end - i));
+
+    group.wait();
 }
 
 template <class Container, class Func>
-void for_loop(Container&& container, Func&& func) {
-    for_loop(Range{std::forward<Container>(container)}, std::forward<Func>(func));
+void for_loop(Container&& container, Func&& func, Schedule schedule = Schedule::STATIC) {
+    for_loop(Range{std::forward<Container>(container)}, std::forward<Func>(func), schedule);
+}
+
+// Parallel algorithms often need to know which chunk they are working on (to store per-chunk results),
+// these helpers split '[0, size)' into 'grain_size' chunks & run 'func(chunk, low, high)' for each one in parallel
+[[nodiscard]] constexpr std::size_t _chunk_count(std::size_t size, std::size_t grain_size) noexcept {
+    grain_size = _max_size(1, grain_size);
+    return (size + grain_size - 1) / grain_size;
+}
+
+template <class Func>
+void _for_each_chunk(std::size_t size, std::size_t grain_size, Func&& func) {
+    grain_size = _max_size(1, grain_size);
+
+    for_loop(IndexRange<std::size_t>{0, _chunk_count(size, grain_size), 1}, [&](std::size_t low, std::size_t high) {
+        for (std::size_t chunk = low; chunk < high; ++chunk)
+            func(chunk, chunk * grain_size, _min_size((chunk + 1) * grain_size, size));
+    });
+}
+
+// --- Multi-dimensional loops ---
+// -------------------------------
+
+// Tiles of each dimension are numbered '0, 1, ...', the last tile may be partial
+template <class Idx>
+[[nodiscard]] std::size_t _tile_count(const IndexRange<Idx>& range) noexcept {
+    if (!(range.first < range.last)) return 0;
+    return _chunk_count(static_cast<std::size_t>(range.last - range.first), range.grain_size);
+}
+
+template <class Idx>
+[[nodiscard]] std::pair<Idx, Idx> _tile_bounds(const IndexRange<Idx>& range, std::size_t tile) noexcept {
+    const std::size_t grain_size = _max_size(1, range.grain_size);
+    const std::size_t size       = static_cast<std::size_t>(range.last - range.first);
+    const std::size_t low        = tile * grain_size;
+    const std::size_t high       = _min_size(low + grain_size, size);
+    return {static_cast<Idx>(range.first + static_cast<Idx>(low)),
+            static_cast<Idx>(range.first + static_cast<Idx>(high))};
+}
+
+// Interleaves bits of tile coordinates, sorting tiles by this code walks them along the Z-order curve
+template <std::size_t N>
+[[nodiscard]] constexpr std::size_t _morton_code(const std::array<std::size_t, N>& coords) noexcept {
+    constexpr std::size_t bits_per_coord = std::numeric_limits<std::size_t>::digits / N;
+
+    std::size_t code = 0;
+    for (std::size_t bit = 0; bit < bits_per_coord; ++bit)
+        for (std::size_t d = 0; d < N; ++d) code |= ((coords[d] >> bit) & 1) << (bit * N + (N - 1 - d));
+    return code;
+}
+
+// Runs 'func(coords)' for every tile of an 'N'-dimensional tile grid, tiles are split into tasks
+// along the chosen traversal order, so each task gets a contiguous piece of the curve
+template <std::size_t N, class Func>
+void _for_each_tile(const std::array<std::size_t, N>& tile_counts, Traversal traversal, Schedule schedule,
+                    Func&& func) {
+    std::size_t total = 1;
+    for (std::size_t count : tile_counts) total *= count;
+    if (total == 0) return;
+
+    const auto unflatten = [&](std::size_t flat) {
+        std::array<std::size_t, N> coords{};
+        for (std::size_t d = N; d-- > 0;) {
+            coords[d] = flat % tile_counts[d];
+            flat /= tile_counts[d];
+        }
+        return coords;
+    };
+
+    const IndexRange<std::size_t> tiles{0, total, _default_grain_size(total)};
+
+    if (traversal == Traversal::ROW_MAJOR) {
+        for_loop(
+            tiles,
+            [&](std::size_t low, std::size_t high) {
+                for (std::size_t t = low; t < high; ++t) func(unflatten(t));
+            },
+            schedule);
+        return;
+    }
+
+    // Tile grids are small compared to the index space (a tile covers thousands of indices),
+    // so sorting them by Morton code is cheap & handles grids that aren't powers of 2 without any special cases
+    std::vector<std::pair<std::size_t, std::size_t>> order(total); // { morton code, row-major index }
+    for (std::size_t t = 0; t < total; ++t) order[t] = {_morton_code<N>(unflatten(t)), t};
+    std::sort(order.begin(), order.end());
+
+    for_loop(
+        tiles,
+        [&](std::size_t low, std::size_t high) {
+            for (std::size_t t = low; t < high; ++t) func(unflatten(order[t].second));
+        },
+        schedule);
+}
+
+template <class Idx, class Func>
+void for_loop(IndexRange2D<Idx> range, Func&& func, Schedule schedule = Schedule::STATIC) {
+    const std::array<std::size_t, 2> tile_counts = {_tile_count(range.i), _tile_count(range.j)};
+
+    _for_each_tile<2>(tile_counts, range.traversal, schedule, [&](const std::array<std::size_t, 2>& tile) {
+        const auto [i_low, i_high] = _tile_bounds(range.i, tile[0]);
+        const auto [j_low, j_high] = _tile_bounds(range.j, tile[1]);
+        func(i_low, i_high, j_low, j_high);
+    });
+}
+
+template <class Idx, class Func>
+void for_loop(IndexRange3D<Idx> range, Func&& func, Schedule schedule = Schedule::STATIC) {
+    const std::array<std::size_t, 3> tile_counts = {_tile_count(range.i), _tile_count(range.j),
+                                                    _tile_count(range.k)};
+
+    _for_each_tile<3>(tile_counts, range.traversal, schedule, [&](const std::array<std::size_t, 3>& tile) {
+        const auto [i_low, i_high] = _tile_bounds(range.i, tile[0]);
+        const auto [j_low, j_high] = _tile_bounds(range.j, tile[1]);
+        const auto [k_low, k_high] = _tile_bounds(range.k, tile[2]);
+        func(i_low, i_high, j_low, j_high, k_low, k_high);
+    });
 }
 
 // =============================
@@ -6902,58 +10319,75 @@ void for_loop(Container&& container, Func&& func) {
 
 constexpr std::size_t default_unroll = 1;
 
-template <std::size_t unroll = default_unroll, class BinaryOp, class Iter, class T = typename Iter::value_type>
-auto reduce(Range<Iter> range, BinaryOp&& op) -> T {
+// Per-chunk partial results are padded to a cache line so neighbouring chunks finishing at the same time
+// don't invalidate each other's slots, 'std::optional<>' lets us avoid requiring 'T' to be default-constructible
+template <class T>
+struct alignas(_cache_line_size) _padded_partial {
+    std::optional<T> value;
+};
 
-    MutexProtected<T> result = *range.begin;
-    // we have to start from the 1st element and not 'T{}' because there is no guarantee
-    // than doing so would be correct for some non-trivial 'T' and 'op'
-
-    for_loop(Range<Iter>{range.begin + 1, range.end, range.grain_size}, [&](Iter low, Iter high) {
-        const std::size_t range_size = high - low;
-
-        // Execute unrolled loop if unrolling is enabled and the range is sufficiently large
-        if constexpr (unroll > 1)
-            if (range_size > unroll) {
-                // (parallel section) Compute partial result (unrolled for SIMD)
-                // Reduce unrollable part
-                std::array<T, unroll> partial_results;
-                _unroll<std::size_t, unroll>([&](std::size_t j) { partial_results[j] = *(low + j); });
-                Iter it = low + unroll;
-                for (; it < high - unroll; it += unroll)
-                    _unroll<std::size_t, unroll>(
-                        [&, it](std::size_t j) { partial_results[j] = op(partial_results[j], *(it + j)); });
-                // Reduce remaining elements
-                for (; it < high; ++it) partial_results[0] = op(partial_results[0], *it);
-                // Collect the result
-                for (std::size_t i = 1; i < partial_results.size(); ++i)
-                    partial_results[0] = op(partial_results[0], partial_results[i]);
-
-                // (critical section) Add partial result to the global one
-                result.apply([&](auto&& res) { res = op(std::forward<decltype(res)>(res), partial_results[0]); });
-
-                return; // skip the non-unrolled version
-            }
+// Reduces '[low, high)' sequentially, 'get(it)' produces the value associated with iterator 'it'.
+// Every chunk starts from its own first value and not 'T{}' because there is no guarantee
+// that doing so would be correct for some non-trivial 'T' and 'op'.
+template <std::size_t unroll, class T, class Iter, class BinaryOp, class Getter>
+T _reduce_chunk(Iter low, Iter high, BinaryOp& op, Getter& get) {
+    const std::size_t range_size = high - low;
+
+    // Execute unrolled loop if unrolling is enabled and the range is sufficiently large
+    if constexpr (unroll > 1)
+        if (range_size > unroll) {
+            // Reduce unrollable part (unrolled for SIMD)
+            std::array<T, unroll> partial_results;
+            _unroll<std::size_t, unroll>([&](std::size_t j) { partial_results[j] = get(low + j); });
+            Iter it = low + unroll;
+            for (; it < high - unroll; it += unroll)
+                _unroll<std::size_t, unroll>(
+                    [&, it](std::size_t j) { partial_results[j] = op(partial_results[j], get(it + j)); });
+            // Reduce remaining elements
+            for (; it < high; ++it) partial_results[0] = op(partial_results[0], get(it));
+            // Collect the result
+            for (std::size_t i = 1; i < partial_results.size(); ++i)
+                partial_results[0] = op(partial_results[0], partial_results[i]);
+
+            return partial_results[0]; // skip the non-unrolled version
+        }
+    // 'if constexpr (unroll > 1)' ensures that unrolling logic will have no effect
+    //  whatsoever on the non-unrolled version of the template, it will not even compile.
+
+    // Fallback onto a regular reduction loop otherwise
+    T partial_result = get(low);
+    for (auto it = low + 1; it != high; ++it) partial_result = op(partial_result, get(it));
+    return partial_result;
+}
+
+template <std::size_t unroll, class T, class Iter, class BinaryOp, class Getter>
+T _reduce_impl(Range<Iter> range, BinaryOp& op, Getter& get) {
+    const std::size_t range_size  = range.end - range.begin;
+    const std::size_t chunk_count = _chunk_count(range_size, range.grain_size);
 
-        // Fallback onto a regular reduction loop otherwise
-        // (parallel section) Compute partial result
-        T partial_result = *low;
-        for (auto it = low + 1; it != high; ++it) partial_result = op(partial_result, *it);
+    // (parallel section) Each chunk writes its partial result into its own slot, no locking needed
+    std::vector<_padded_partial<T>> partials(chunk_count);
 
-        // (critical section) Add partial result to the global one
-        result.apply([&](auto&& res) { res = op(std::forward<decltype(res)>(res), partial_result); });
+    _for_each_chunk(range_size, range.grain_size, [&](std::size_t chunk, std::size_t low, std::size_t high) {
+        partials[chunk].value.emplace(_reduce_chunk<unroll, T>(range.begin + low, range.begin + high, op, get));
     });
 
-    // Note 1:
-    // We could also collect results into an array of partial results and then reduce it on the
-    // main thread at the end, but that leads to a much less clean implementation and doesn't
-    // seem to be measurably faster.
+    // (serial section) Combine partial results pairwise in a tree, this keeps the order of operations
+    // deterministic for a given grain size and tends to accumulate less floating point error than a linear fold
+    for (std::size_t stride = 1; stride < chunk_count; stride *= 2)
+        for (std::size_t i = 0; i + stride < chunk_count; i += 2 * stride)
+            partials[i].value.emplace(op(*partials[i].value, *partials[i + stride].value));
 
-    // Note 2:
-    // 'if constexpr (unroll > 1)' ensures that unrolling logic will have no effect
-    //  whatsoever on the non-unrolled version of the template, it will not even compile.
+    return std::move(*partials.front().value);
+}
+
+// Note:
+// All reductions expect a non-empty range since there is no identity element to return otherwise
 
-    return result.release();
+template <std::size_t unroll = default_unroll, class BinaryOp, class Iter, class T = typename Iter::value_type>
+auto reduce(Range<Iter> range, BinaryOp&& op) -> T {
+    auto get = [](Iter it) -> decltype(auto) { return *it; };
+    return _reduce_impl<unroll, T>(range, op, get);
 }
 
 template <std::size_t unroll = default_unroll, class BinaryOp, class Container>
@@ -6961,6 +10395,37 @@ auto reduce(Container&& container, BinaryOp&& op) -> typename std::decay_t<Conta
     return reduce<unroll>(Range{std::forward<Container>(container)}, std::forward<BinaryOp>(op));
 }
 
+// --- Transform-reduce ---
+// ------------------------
+
+template <std::size_t unroll = default_unroll, class BinaryOp, class UnaryOp, class Iter,
+          class T = std::decay_t<std::invoke_result_t<UnaryOp&, typename std::iterator_traits<Iter>::reference>>>
+auto transform_reduce(Range<Iter> range, BinaryOp&& reduce_op, UnaryOp&& transform_op) -> T {
+    auto get = [&](Iter it) -> T { return transform_op(*it); };
+    return _reduce_impl<unroll, T>(range, reduce_op, get);
+}
+
+template <std::size_t unroll = default_unroll, class BinaryOp, class UnaryOp, class Container>
+auto transform_reduce(Container&& container, BinaryOp&& reduce_op, UnaryOp&& transform_op) {
+    return transform_reduce<unroll>(Range{std::forward<Container>(container)}, std::forward<BinaryOp>(reduce_op),
+                                    std::forward<UnaryOp>(transform_op));
+}
+
+template <std::size_t unroll = default_unroll, class BinaryOp, class TransformOp, class Iter1, class Iter2,
+          class T = std::decay_t<std::invoke_result_t<TransformOp&, typename std::iterator_traits<Iter1>::reference,
+                                                      typename std::iterator_traits<Iter2>::reference>>>
+auto transform_reduce(Range<Iter1> range, Iter2 first2, BinaryOp&& reduce_op, TransformOp&& transform_op) -> T {
+    auto get = [&](Iter1 it) -> T { return transform_op(*it, *(first2 + (it - range.begin))); };
+    return _reduce_impl<unroll, T>(range, reduce_op, get);
+}
+
+template <std::size_t unroll = default_unroll, class BinaryOp, class TransformOp, class Container1, class Container2>
+auto transform_reduce(Container1&& container1, Container2&& container2, BinaryOp&& reduce_op,
+                      TransformOp&& transform_op) {
+    return transform_reduce<unroll>(Range{std::forward<Container1>(container1)}, container2.begin(),
+                                    std::forward<BinaryOp>(reduce_op), std::forward<TransformOp>(transform_op));
+}
+
 // --- Pre-defined binary ops ---
 // ------------------------------
 
@@ -7022,8 +10487,356 @@ struct max<void> {
     using is_transparent = std::less<>::is_transparent;
 };
 
+// ===========================
+// --- Parallel algorithms ---
+// ===========================
+
+// Parallel counterparts of some standard algorithms built on top of ranges & the thread pool.
+//
+// Algorithms that need a temporary buffer ('partition()', 'sort()') require 'value_type' to be default-constructible
+// and move-assignable, this allows buffers to be filled in parallel. All iterators are expected to be random-access.
+
+// --- Transform ---
+// -----------------
+
+template <class Iter, class OutIter, class UnaryOp>
+OutIter transform(Range<Iter> range, OutIter out, UnaryOp&& op) {
+    for_loop(range, [&](Iter low, Iter high) {
+        OutIter dst = out + (low - range.begin);
+        for (Iter it = low; it != high; ++it, ++dst) *dst = op(*it);
+    });
+
+    return out + (range.end - range.begin);
+}
+
+template <class Container, class OutIter, class UnaryOp>
+OutIter transform(Container&& container, OutIter out, UnaryOp&& op) {
+    return transform(Range{std::forward<Container>(container)}, out, std::forward<UnaryOp>(op));
+}
+
+// --- Count ---
+// -------------
+
+template <class Iter, class UnaryPred>
+std::size_t count_if(Range<Iter> range, UnaryPred&& pred) {
+    if (!(range.begin < range.end)) return 0;
+
+    return transform_reduce(range, sum<>{}, [&](const auto& value) -> std::size_t { return pred(value) ? 1 : 0; });
+}
+
+template <class Container, class UnaryPred>
+std::size_t count_if(Container&& container, UnaryPred&& pred) {
+    return count_if(Range{std::forward<Container>(container)}, std::forward<UnaryPred>(pred));
+}
+
+// --- Find ---
+// ------------
+
+// Chunks check the index of the best match found so far every '_find_check_period' iterations
+// and stop early once it is known that no element of theirs can be the first match
+constexpr std::size_t _find_check_period = 1024;
+
+template <class Iter, class UnaryPred>
+Iter find_if(Range<Iter> range, UnaryPred&& pred) {
+    const std::size_t range_size = range.end - range.begin;
+
+    std::atomic<std::size_t> found{range_size}; // index of the first match found so far
+
+    _for_each_chunk(range_size, range.grain_size, [&](std::size_t, std::size_t low, std::size_t high) {
+        for (std::size_t block = low; block < high; block += _find_check_period) {
+            if (found.load(std::memory_order_relaxed) < block) return;
+
+            const Iter block_begin = range.begin + block;
+            const Iter block_end   = range.begin + _min_size(block + _find_check_period, high);
+
+            for (Iter it = block_begin; it != block_end; ++it) {
+                if (!pred(*it)) continue;
+
+                const std::size_t i       = it - range.begin;
+                std::size_t       current = found.load(std::memory_order_relaxed);
+                while (i < current && !found.compare_exchange_weak(current, i, std::memory_order_relaxed));
+                return;
+            }
+        }
+    });
+
+    return range.begin + found.load();
+}
+
+template <class Container, class UnaryPred>
+auto find_if(Container&& container, UnaryPred&& pred) {
+    return find_if(Range{std::forward<Container>(container)}, std::forward<UnaryPred>(pred));
+}
+
+// --- Scan ---
+// ------------
+
+// Both scans are done in 3 passes:
+//    1. (parallel) Reduce every chunk
+//    2. (serial)   Scan chunk results to get the starting value of every chunk
+//    3. (parallel) Scan every chunk starting from its value
+// Every element gets read before its output is written, which means scans can be done in-place ('out == range.begin').
+
+template <class Iter, class OutIter, class BinaryOp>
+OutIter inclusive_scan(Range<Iter> range, OutIter out, BinaryOp&& op) {
+    using value_type = typename std::iterator_traits<Iter>::value_type;
+
+    const std::size_t range_size  = range.end - range.begin;
+    const std::size_t chunk_count = _chunk_count(range_size, range.grain_size);
+
+    std::vector<_padded_partial<value_type>> partials(chunk_count);
+
+    auto get = [](Iter it) -> decltype(auto) { return *it; };
+
+    _for_each_chunk(range_size, range.grain_size, [&](std::size_t chunk, std::size_t low, std::size_t high) {
+        if (chunk + 1 == chunk_count) return; // total of the last chunk is never used
+        partials[chunk].value.emplace(_reduce_chunk<1, value_type>(range.begin + low, range.begin + high, op, get));
+    });
+
+    for (std::size_t chunk = 1; chunk + 1 < chunk_count; ++chunk)
+        partials[chunk].value.emplace(op(*partials[chunk - 1].value, *partials[chunk].value));
+    // now 'partials[i]' holds the reduction of all chunks up to 'i' inclusive
+
+    _for_each_chunk(range_size, range.grain_size, [&](std::size_t chunk, std::size_t low, std::size_t high) {
+        Iter    it  = range.begin + low;
+        OutIter dst = out + low;
+
+        value_type acc = chunk ? op(*partials[chunk - 1].value, *it) : *it;
+        *dst           = acc;
+
+        for (++it, ++dst; it != range.begin + high; ++it, ++dst) {
+            acc  = op(acc, *it);
+            *dst = acc;
+        }
+    });
+
+    return out + range_size;
+}
+
+template <class Container, class OutIter, class BinaryOp>
+OutIter inclusive_scan(Container&& container, OutIter out, BinaryOp&& op) {
+    return inclusive_scan(Range{std::forward<Container>(container)}, out, std::forward<BinaryOp>(op));
+}
+
+template <class Iter, class OutIter, class T, class BinaryOp>
+OutIter exclusive_scan(Range<Iter> range, OutIter out, T init, BinaryOp&& op) {
+    const std::size_t range_size  = range.end - range.begin;
+    const std::size_t chunk_count = _chunk_count(range_size, range.grain_size);
+
+    std::vector<_padded_partial<T>> partials(chunk_count);
+
+    auto get = [](Iter it) -> T { return *it; };
+
+    _for_each_chunk(range_size, range.grain_size, [&](std::size_t chunk, std::size_t low, std::size_t high) {
+        if (chunk + 1 == chunk_count) return; // total of the last chunk is never used
+        partials[chunk].value.emplace(_reduce_chunk<1, T>(range.begin + low, range.begin + high, op, get));
+    });
+
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        if (chunk + 1 == chunk_count) {
+            partials[chunk].value.emplace(std::move(init));
+            break;
+        }
+        T next = op(init, *partials[chunk].value);
+        partials[chunk].value.emplace(std::move(init));
+        init = std::move(next);
+    } // now 'partials[i]' holds the starting value of the chunk 'i'
+
+    _for_each_chunk(range_size, range.grain_size, [&](std::size_t chunk, std::size_t low, std::size_t high) {
+        OutIter dst = out + low;
+        T       acc = std::move(*partials[chunk].value);
+
+        for (Iter it = range.begin + low; it != range.begin + high; ++it, ++dst) {
+            T next = op(acc, *it);
+            *dst   = std::move(acc);
+            acc    = std::move(next);
+        }
+    });
+
+    return out + range_size;
+}
+
+template <class Container, class OutIter, class T, class BinaryOp>
+OutIter exclusive_scan(Container&& container, OutIter out, T init, BinaryOp&& op) {
+    return exclusive_scan(Range{std::forward<Container>(container)}, out, std::move(init), std::forward<BinaryOp>(op));
+}
+
+// --- Partition ---
+// -----------------
+
+// Stable partition done in 3 passes:
+//    1. (parallel) Evaluate predicate for every element & count matches in every chunk
+//    2. (serial)   Compute where matching & non-matching elements of every chunk should go
+//    3. (parallel) Move elements into a buffer at their final positions, then move them back
+// Predicate results are cached so it gets evaluated exactly once per element.
+
+template <class Iter, class UnaryPred>
+Iter partition(Range<Iter> range, UnaryPred&& pred) {
+    using value_type = typename std::iterator_traits<Iter>::value_type;
+
+    const std::size_t range_size  = range.end - range.begin;
+    const std::size_t grain_size  = _max_size(1, range.grain_size);
+    const std::size_t chunk_count = _chunk_count(range_size, grain_size);
+
+    std::vector<char>        matches(range_size); // not 'std::vector<bool>' since we write to it from multiple threads
+    std::vector<std::size_t> match_counts(chunk_count);
+
+    _for_each_chunk(range_size, grain_size, [&](std::size_t chunk, std::size_t low, std::size_t high) {
+        std::size_t count = 0;
+        for (std::size_t i = low; i < high; ++i) count += (matches[i] = pred(*(range.begin + i)) ? 1 : 0);
+        match_counts[chunk] = count;
+    });
+
+    std::vector<std::size_t> match_offsets(chunk_count);
+    std::vector<std::size_t> mismatch_offsets(chunk_count);
+
+    std::size_t total_matches = 0;
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        match_offsets[chunk] = total_matches;
+        total_matches += match_counts[chunk];
+    }
+
+    std::size_t total_mismatches = total_matches; // non-matching elements go after the matching ones
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        mismatch_offsets[chunk] = total_mismatches;
+        total_mismatches += _min_size(grain_size, range_size - chunk * grain_size) - match_counts[chunk];
+    }
+
+    std::vector<value_type> buffer(range_size);
+
+    _for_each_chunk(range_size, grain_size, [&](std::size_t chunk, std::size_t low, std::size_t high) {
+        std::size_t match_pos    = match_offsets[chunk];
+        std::size_t mismatch_pos = mismatch_offsets[chunk];
+        for (std::size_t i = low; i < high; ++i)
+            buffer[matches[i] ? match_pos++ : mismatch_pos++] = std::move(*(range.begin + i));
+    });
+
+    _for_each_chunk(range_size, grain_size, [&](std::size_t, std::size_t low, std::size_t high) {
+        for (std::size_t i = low; i < high; ++i) *(range.begin + i) = std::move(buffer[i]);
+    });
+
+    return range.begin + total_matches;
+}
+
+template <class Container, class UnaryPred>
+auto partition(Container&& container, UnaryPred&& pred) {
+    return partition(Range{std::forward<Container>(container)}, std::forward<UnaryPred>(pred));
+}
+
+// --- Sort ---
+// ------------
+
+// Parallel merge sort:
+//    1. (parallel) Sort every chunk with 'std::sort()'
+//    2. (parallel) Merge sorted runs pairwise until a single run remains, ping-ponging between the range & a buffer
+// Merging 2 large runs on a single thread would make the last rounds serial, to avoid this every merge gets split into
+// independent parts using merge path partitioning, which keeps the number of tasks per round roughly constant.
+
+// Returns how many elements of 'a' go into the first 'k' elements of 'merge(a, b)', the same way 'std::merge()'
+// would do it, that is, equivalent elements of 'a' go before those of 'b'
+template <class Iter1, class Iter2, class Compare>
+std::size_t _merge_path(std::size_t k, Iter1 a, std::size_t a_size, Iter2 b, std::size_t b_size, Compare& comp) {
+    std::size_t low  = (k > b_size) ? k - b_size : 0;
+    std::size_t high = _min_size(k, a_size);
+
+    while (low < high) {
+        const std::size_t mid = low + (high - low) / 2;
+        if (!comp(*(b + (k - mid - 1)), *(a + mid))) low = mid + 1; // 'a[mid]' goes before 'b[k - mid - 1]'
+        else high = mid;
+    }
+
+    return low;
+}
+
+template <class Iter, class Compare = std::less<>>
+void sort(Range<Iter> range, Compare&& comp = Compare{}) {
+    using value_type = typename std::iterator_traits<Iter>::value_type;
+
+    const std::size_t range_size  = range.end - range.begin;
+    const std::size_t grain_size  = _max_size(1, range.grain_size);
+    const std::size_t chunk_count = _chunk_count(range_size, grain_size);
+
+    if (chunk_count <= 1) return std::sort(range.begin, range.end, comp); // nothing to parallelize
+
+    _for_each_chunk(range_size, grain_size, [&](std::size_t, std::size_t low, std::size_t high) {
+        std::sort(range.begin + low, range.begin + high, comp);
+    });
+
+    std::vector<value_type>  buffer(range_size);
+    std::vector<std::size_t> splits; // how many elements of the 1st run precede every merge part
+
+    // Merges pairs of sorted runs of size 'run' from 'src' into 'dst', every merge is split into 'part_count' parts
+    const auto merge_round = [&](auto src, auto dst, std::size_t run, std::size_t pair_count, std::size_t part_count) {
+        const auto bounds = [&](std::size_t pair) {
+            const std::size_t low = pair * 2 * run;
+            return std::array{low, _min_size(low + run, range_size), _min_size(low + 2 * run, range_size)};
+        };
+        const auto part_start = [&](std::size_t merged_size, std::size_t part) {
+            return merged_size * part / part_count;
+        };
+
+        // Split points have to be found before merging starts since merging moves elements out of 'src'
+        splits.resize(pair_count * (part_count + 1));
+        for (std::size_t pair = 0; pair < pair_count; ++pair) {
+            const auto [low, mid, high] = bounds(pair);
+            for (std::size_t part = 0; part <= part_count; ++part)
+                splits[pair * (part_count + 1) + part] =
+                    _merge_path(part_start(high - low, part), src + low, mid - low, src + mid, high - mid, comp);
+        }
+
+        TaskGroup group;
+
+        for (std::size_t pair = 0; pair < pair_count; ++pair) {
+            for (std::size_t part = 0; part < part_count; ++part) {
+                group.add_task([&, pair, part] {
+                    const auto [low, mid, high] = bounds(pair);
+
+                    const std::size_t k_first = part_start(high - low, part);
+                    const std::size_t k_last  = part_start(high - low, part + 1);
+                    const std::size_t i_first = splits[pair * (part_count + 1) + part];
+                    const std::size_t i_last  = splits[pair * (part_count + 1) + part + 1];
+
+                    const auto a = src + low;
+                    const auto b = src + mid;
+
+                    std::merge(std::make_move_iterator(a + i_first), std::make_move_iterator(a + i_last),
+                               std::make_move_iterator(b + (k_first - i_first)),
+                               std::make_move_iterator(b + (k_last - i_last)), dst + low + k_first, comp);
+                });
+            }
+        }
+
+        group.wait();
+    };
+
+    bool in_buffer = false; // which side holds the sorted runs
+
+    for (std::size_t run = grain_size; run < range_size; run *= 2) {
+        const std::size_t pair_count = (range_size + 2 * run - 1) / (2 * run);
+        const std::size_t part_count = _max_size(1, chunk_count / pair_count);
+
+        if (in_buffer) merge_round(buffer.begin(), range.begin, run, pair_count, part_count);
+        else merge_round(range.begin, buffer.begin(), run, pair_count, part_count);
+
+        in_buffer = !in_buffer;
+    }
+
+    if (in_buffer)
+        _for_each_chunk(range_size, grain_size, [&](std::size_t, std::size_t low, std::size_t high) {
+            for (std::size_t i = low; i < high; ++i) *(range.begin + i) = std::move(buffer[i]);
+        });
+}
+
+template <class Container, class Compare = std::less<>>
+void sort(Container&& container, Compare&& comp = Compare{}) {
+    sort(Range{std::forward<Container>(container)}, std::forward<Compare>(comp));
+}
+
 } // namespace utl::parallel
 
+#undef utl_parallel_linux
+#undef utl_parallel_apple
+
 #endif
 #endif // module utl::parallel
 
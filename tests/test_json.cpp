@@ -9,14 +9,20 @@
 
 // _______________________ INCLUDES _______________________
 
+#include <algorithm>        // max()
 #include <array>            // testing JSON array conversion
+#include <cstdio>           // tmpfile(), fread(), FILE
 #include <deque>            // testing JSON array conversion
 #include <filesystem>       // iteration over the test suite files
 #include <forward_list>     // testing JSON array conversion
+#include <fstream>          // reading test suite files into a buffer
 #include <initializer_list> // testing JSON array conversion
 #include <list>             // testing JSON array conversion
 #include <set>              // testing JSON array conversion
+#include <sstream>          // reading test suite files into a buffer
+#include <type_traits>      // testing flat object iterators & view overloads
 #include <unordered_map>    // testing JSON array conversion
+#include <utility>          // testing flat object iterators & view overloads
 #include <vector>           // testing JSON array conversion
 
 // ____________________ DEVELOPER DOCS ____________________
@@ -73,6 +79,50 @@ TEST_CASE("Parser passes JSON validation test suite (reject invalid)") {
     }
 }
 
+TEST_CASE("Parser handles special characters at any position relative to the SIMD block boundaries") {
+    // SIMD scanning processes strings & whitespace in blocks of 16 / 32 bytes, make sure that
+    // special chars are detected correctly at every offset, including the scalar tail
+    for (std::size_t length = 0; length < 80; ++length) {
+        for (std::size_t pos = 0; pos < length; ++pos) {
+            std::string contents(length, 'a');
+
+            // Escape sequences
+            contents[pos]            = '\\';
+            const std::string escaped = R"(")" + contents.substr(0, pos) + R"(\n)" + contents.substr(pos + 1) + R"(")";
+            CHECK(json::from_string(escaped).get_string() == contents.substr(0, pos) + '\n' + contents.substr(pos + 1));
+
+            // Control characters
+            contents[pos] = '\t';
+            CHECK(check_if_throws([&] { return json::from_string(R"(")" + contents + R"(")"); }));
+
+            // Whitespace runs
+            const std::string whitespace(pos, ' ');
+            const std::string padded = whitespace + "[" + whitespace + "1" + whitespace + "]" + whitespace;
+            CHECK(json::from_string(padded).at(0).get_number() == 1);
+        }
+    }
+}
+
+TEST_CASE("Serialized JSON parses back into the same JSON") {
+    const fs::path test_suite_path = "tests/data/json_test_suite/should_accept/";
+
+    for (const auto& test_suite_entry : fs::directory_iterator(test_suite_path)) {
+        const auto json = json::from_file(test_suite_entry.path());
+
+        for (const auto format : {json::Format::PRETTY, json::Format::MINIMIZED})
+            CHECK(json::from_string(json.to_string(format)).to_string() == json.to_string());
+    }
+}
+
+TEST_CASE("Serializer escapes both keys and values") {
+    json::Node json;
+    json["control\x01"]                  = std::string("\x00\x1F", 2);
+    json["key \"with\" \\ escapes\n"] = "value \"with\" \\ escapes\t";
+
+    CHECK(json.to_string(json::Format::MINIMIZED) ==
+          R"({"control\u0001":"\u0000\u001f","key \"with\" \\ escapes\n":"value \"with\" \\ escapes\t"})");
+}
+
 // =============================
 // --- Type conversion tests ---
 // =============================
@@ -219,6 +269,421 @@ TEST_CASE("JSON object node API basics work as intended") {
     CHECK(json.value_or("non_existent_key", -5.) == -5.);
 }
 
+// ===========================
+// --- View node API tests ---
+// ===========================
+
+TEST_CASE("View parser agrees with the regular parser on JSON validation test suite") {
+    for (const auto& test_suite_path :
+         {"tests/data/json_test_suite/should_accept/", "tests/data/json_test_suite/should_reject/"}) {
+        for (const auto& test_suite_entry : fs::directory_iterator(test_suite_path)) {
+            const std::string chars = (std::ostringstream() << std::ifstream(test_suite_entry.path()).rdbuf()).str();
+
+            const bool node_throws = check_if_throws([&]() { return json::from_string(chars); });
+            const bool view_throws = check_if_throws([&]() { return json::view_from_string(chars); });
+
+            CHECK(node_throws == view_throws);
+        }
+    }
+}
+
+TEST_CASE("JSON view API basics work as intended") {
+    const std::string chars = R"(
+        {
+            "string": "lorem ipsum",
+            "number": 17,
+            "array": [ 1, "2", null ],
+            "object": { "bool": true },
+            "number": 18
+        }
+    )";
+
+    const auto json = json::view_from_string(chars);
+
+    CHECK(check_if_throws([&]() { auto val = json.at("non_existent_key"); }));
+    CHECK(json.contains("string"));
+    CHECK(json.at("string").get_string() == "lorem ipsum");
+    CHECK(json.at("number").get_number() == 17); // duplicate keys resolve to the first value, same as 'Node'
+    CHECK(json.at("array").get_array().size() == 3);
+    CHECK(json.at("array")[1].get_string() == "2");
+    CHECK(json.at("array").at(2).is_null());
+    CHECK(json["object"]["bool"].get_bool() == true);
+    CHECK(json.value_or("number", -5.) == 17.);
+    CHECK(json.value_or("non_existent_key", -5.) == -5.);
+}
+
+TEST_CASE("JSON view strings reference the buffer unless they contain escape sequences") {
+    const std::string chars = R"({ "plain": "lorem ipsum", "escaped": "lorem\nipsum \u0041\uD834\uDD1E" })";
+
+    const auto json = json::view_from_string(chars);
+
+    const auto plain   = json.at("plain").get_string();
+    const auto escaped = json.at("escaped").get_string();
+
+    const auto points_into_buffer = [&](std::string_view str) {
+        return chars.data() <= str.data() && str.data() + str.size() <= chars.data() + chars.size();
+    };
+
+    CHECK(plain == "lorem ipsum");
+    CHECK(points_into_buffer(plain));
+    CHECK(escaped == json::from_string(chars).at("escaped").get_string());
+    CHECK(!points_into_buffer(escaped));
+}
+
+template <class T, class = void>
+struct can_view_from : std::false_type {};
+
+template <class T>
+struct can_view_from<T, std::void_t<decltype(json::view_from_string(std::declval<T>()))>> : std::true_type {};
+
+// Temporary strings (including const ones) would leave views dangling, lvalues & string views are fine
+static_assert(can_view_from<std::string&>::value);
+static_assert(can_view_from<const std::string&>::value);
+static_assert(can_view_from<std::string_view>::value);
+static_assert(!can_view_from<std::string>::value);
+static_assert(!can_view_from<std::string&&>::value);
+static_assert(!can_view_from<const std::string>::value);
+static_assert(!can_view_from<const std::string&&>::value);
+
+// ============================
+// --- Arena node API tests ---
+// ============================
+
+TEST_CASE("Arena parser produces the same JSON as the regular parser") {
+    const fs::path test_suite_path = "tests/data/json_test_suite/should_accept/";
+
+    for (const auto& test_suite_entry : fs::directory_iterator(test_suite_path)) {
+        const std::string chars = (std::ostringstream() << std::ifstream(test_suite_entry.path()).rdbuf()).str();
+
+        json::Arena arena;
+        const auto  arena_json = json::from_string(chars, arena);
+
+        CHECK(arena_json.to_string() == json::from_string(chars).to_string());
+    }
+}
+
+TEST_CASE("JSON arena node can be modified after parsing") {
+    json::Arena arena;
+    auto        json = json::from_string(R"({ "string": "lorem ipsum", "array": [ 1, 2 ] })", arena);
+
+    // Modifications that allocate outside the arena should coexist with arena-allocated data
+    json["string"] = "a string that is long enough to not fit into the small string buffer";
+    json["object"]["key"] = std::map<std::string, int>{{"key_1", 1}};
+    json["array"].push_back(json::ArenaNode{3});
+    json["array"] = std::vector<int>{4, 5, 6};
+
+    CHECK(json.at("string").get_string() == "a string that is long enough to not fit into the small string buffer");
+    CHECK(json.at("object").at("key").at("key_1").get_number() == 1);
+    CHECK(json.at("array").to_string(json::Format::MINIMIZED) == "[4,5,6]");
+    CHECK(json.contains("object"));
+    CHECK(json.value_or("non_existent_key", -5.) == -5.);
+}
+
+TEST_CASE("Moved-from JSON arena is empty and doesn't hand out memory of the new owner") {
+    json::Arena source;
+    const auto  stored = source.store("lorem ipsum");
+
+    json::Arena moved       = std::move(source);
+    const auto  from_moved  = moved.store("dolor sit");
+    const auto  from_source = source.store("amet");
+
+    CHECK(from_source.data() != from_moved.data());
+    CHECK(stored == "lorem ipsum"); // memory moved along with the blocks
+    CHECK(from_moved == "dolor sit");
+    CHECK(from_source == "amet");
+
+    json::Arena assigned;
+    assigned = std::move(moved);
+    const auto from_assigned    = assigned.store("consectetur");
+    const auto from_moved_again = moved.store("adipiscing");
+
+    CHECK(from_assigned.data() != from_moved_again.data());
+    CHECK(stored == "lorem ipsum");
+    CHECK(from_moved == "dolor sit");
+    CHECK(from_assigned == "consectetur");
+    CHECK(from_moved_again == "adipiscing");
+}
+
+// ===========================
+// --- Flat node API tests ---
+// ===========================
+
+// Structural comparison of nodes with different object backends, ignores the order of object keys
+template <class NodeA, class NodeB>
+bool same_json(const NodeA& a, const NodeB& b) {
+    if (a.is_object() && b.is_object()) {
+        if (a.get_object().size() != b.get_object().size()) return false;
+        for (const auto& [key, value] : a.get_object())
+            if (!b.contains(key) || !same_json(value, b.at(key))) return false;
+        return true;
+    }
+    if (a.is_array() && b.is_array()) {
+        if (a.get_array().size() != b.get_array().size()) return false;
+        for (std::size_t i = 0; i < a.get_array().size(); ++i)
+            if (!same_json(a.at(i), b.at(i))) return false;
+        return true;
+    }
+    return a.to_string() == b.to_string(); // scalars serialize the same way
+}
+
+TEST_CASE("Flat object parser produces the same JSON as the regular parser") {
+    const fs::path test_suite_path = "tests/data/json_test_suite/should_accept/";
+
+    for (const auto& test_suite_entry : fs::directory_iterator(test_suite_path)) {
+        const std::string chars = (std::ostringstream() << std::ifstream(test_suite_entry.path()).rdbuf()).str();
+
+        const auto flat_json = json::from_string<json::FlatNode>(chars);
+
+        // flat objects preserve insertion order while regular ones are sorted, compare contents regardless of it
+        CHECK(same_json(flat_json, json::from_string(chars)));
+    }
+}
+
+TEST_CASE("JSON flat node API basics") {
+    auto json = json::from_string<json::FlatNode>(R"({ "key_3": 3, "key_1": 1, "key_2": 2, "key_1": 4 })");
+
+    // Insertion order is preserved, first duplicate key wins
+    CHECK(json.to_string(json::Format::MINIMIZED) == R"({"key_3":3,"key_1":1,"key_2":2})");
+
+    json["key_4"] = "value";
+    json["object"]["key"] = std::map<std::string, int>{{"key_1", 1}};
+
+    CHECK(json.at("key_1").get_number() == 1);
+    CHECK(json.at("key_4").get_string() == "value");
+    CHECK(json.at("object").at("key").at("key_1").get_number() == 1);
+    CHECK(json.contains("key_2"));
+    CHECK(!json.contains("key_5"));
+    CHECK(json.value_or("key_5", -5.) == -5.);
+    CHECK(check_if_throws([&] { std::ignore = json.at("key_5"); }));
+
+    CHECK(json.get_object().erase("key_3") == 1);
+    CHECK(json.to_string(json::Format::MINIMIZED) ==
+          R"({"key_1":1,"key_2":2,"key_4":"value","object":{"key":{"key_1":1}}})");
+}
+
+TEST_CASE("JSON flat node iterators expose read-only keys") {
+    using object_type = json::FlatNode::object_type;
+
+    static_assert(std::is_same_v<object_type::value_type, std::pair<const std::string, json::FlatNode>>);
+    static_assert(std::is_same_v<decltype(std::declval<object_type::iterator>()->first), const std::string&>);
+
+    auto json = json::from_string<json::FlatNode>(R"({ "a": 1, "b": 2, "c": 3 })");
+    auto& object = json.get_object();
+
+    for (auto&& [key, value] : object) value = value.get_number() * 10; // values stay mutable
+    object.begin()->second = "first";
+
+    std::string keys;
+    for (const auto& [key, value] : std::as_const(object)) keys += key;
+    CHECK(keys == "abc");
+
+    object_type::const_iterator it = object.find("b"); // 'iterator' converts to 'const_iterator'
+    CHECK(it != object.cend());
+    CHECK(it - object.cbegin() == 1);
+    CHECK((*it).second.get_number() == 20);
+    CHECK(object.erase(it)->first == "c");
+    CHECK(json.to_string(json::Format::MINIMIZED) == R"({"a":"first","c":30})");
+}
+
+TEST_CASE("JSON flat node handles large objects") {
+    // Large objects switch from linear search to a hash index, make sure
+    // lookup stays correct during the transition, after growth & after erasure
+    json::FlatNode json;
+    for (int i = 0; i < 1000; ++i) {
+        json["key_" + std::to_string(i)] = i;
+        for (int j = 0; j <= i; j += 97) CHECK(json.at("key_" + std::to_string(j)).get_number() == j);
+    }
+    CHECK(json.get_object().size() == 1000);
+
+    for (int i = 0; i < 1000; i += 2) json.get_object().erase("key_" + std::to_string(i));
+    CHECK(json.get_object().size() == 500);
+
+    const json::FlatNode copy = json;
+    for (int i = 0; i < 1000; ++i) CHECK(copy.contains("key_" + std::to_string(i)) == (i % 2 == 1));
+}
+
+// ========================
+// --- SAX parser tests ---
+// ========================
+
+// Records all events as a single string so we can check their exact order
+struct RecordingHandler {
+    std::string events;
+
+    void on_object_begin() { this->events += "{ "; }
+    void on_object_end() { this->events += "} "; }
+    void on_array_begin() { this->events += "[ "; }
+    void on_array_end() { this->events += "] "; }
+    void on_key(std::string_view key) { this->events += "key:" + std::string(key) + " "; }
+    void on_string(std::string_view value) { this->events += "string:" + std::string(value) + " "; }
+    void on_number(double value) { this->events += "number:" + std::to_string(int(value)) + " "; }
+    void on_bool(bool value) { this->events += value ? "true " : "false "; }
+    void on_null() { this->events += "null "; }
+};
+
+TEST_CASE("SAX parser reports events in document order") {
+    const std::string chars = R"({ "key_1": [ 1, "a\nb", true, false, null ], "key_1": {}, "key_2": { "key": [] } })";
+
+    RecordingHandler handler;
+    json::sax_from_string(chars, handler);
+
+    CHECK(handler.events == "{ key:key_1 [ number:1 string:a\nb true false null ] "
+                            "key:key_1 { } key:key_2 { key:key [ ] } } ");
+    // duplicate keys are reported as-is, deciding what to do with them is up to the handler
+}
+
+TEST_CASE("SAX parser agrees with the regular parser on JSON validation test suite") {
+    for (const auto& test_suite_path :
+         {"tests/data/json_test_suite/should_accept/", "tests/data/json_test_suite/should_reject/"}) {
+        for (const auto& test_suite_entry : fs::directory_iterator(test_suite_path)) {
+            const std::string chars = (std::ostringstream() << std::ifstream(test_suite_entry.path()).rdbuf()).str();
+
+            json::SaxHandler handler; // no-op handler
+            const bool       node_throws = check_if_throws([&]() { return json::from_string(chars); });
+            const bool       sax_throws  = check_if_throws([&]() { json::sax_from_string(chars, handler); });
+
+            CHECK(node_throws == sax_throws);
+        }
+    }
+}
+
+TEST_CASE("SAX handlers can aggregate without building a tree") {
+    // Handler that only cares about some events, the rest are no-ops inherited from 'json::SaxHandler'
+    struct SumHandler : json::SaxHandler {
+        double      sum   = 0;
+        std::size_t count = 0;
+
+        void on_number(double value) {
+            this->sum += value;
+            ++this->count;
+        }
+    };
+
+    SumHandler handler;
+    for (const auto& line : {R"({ "value": 1, "nested": [ 2, { "value": 3 } ] })", R"({ "value": 4 })", R"([])"})
+        json::sax_from_string(line, handler); // NDJSON can be aggregated line-by-line
+
+    CHECK(handler.sum == 10);
+    CHECK(handler.count == 4);
+}
+
+// ===========================
+// --- Stream parser tests ---
+// ===========================
+
+TEST_CASE("Stream parser handles values split at any position") {
+    const std::string chars =
+        R"( {"key":[1,2,"x\"]{"]}17 "str\\" [] true null{"b":{}}-1.5e3)" "\n" R"({ "last": "\u0041" } )";
+
+    const std::vector<std::string> expected = {R"({"key":[1,2,"x\"]{"]})", "17", R"("str\\")", "[]", "true",
+                                               "null", R"({"b":{}})", "-1.5e3", R"({ "last": "\u0041" })"};
+
+    std::vector<std::string> parsed;
+    json::StreamParser       parser([&](json::Node&& node) { parsed.push_back(node.to_string()); });
+
+    const auto check_parsed = [&] {
+        REQUIRE(parsed.size() == expected.size());
+        for (std::size_t i = 0; i < expected.size(); ++i)
+            CHECK(parsed[i] == json::from_string(expected[i]).to_string());
+        parsed.clear();
+    };
+
+    // Split into 2 chunks at every position
+    for (std::size_t split = 0; split <= chars.size(); ++split) {
+        parser.feed(std::string_view(chars).substr(0, split));
+        parser.feed(std::string_view(chars).substr(split));
+        parser.finish();
+        check_parsed();
+    }
+
+    // Feed 1 symbol at a time
+    for (const char c : chars) parser.feed(std::string_view(&c, 1));
+    parser.finish();
+    check_parsed();
+}
+
+TEST_CASE("Stream parser reports invalid values and recovers") {
+    std::vector<std::string> parsed;
+    json::StreamParser       parser(
+        [&](json::Node&& node) { parsed.push_back(node.to_string(json::Format::MINIMIZED)); });
+
+    CHECK(check_if_throws([&] { parser.feed(R"([1,2} [3])"); }));
+    CHECK(parsed == std::vector<std::string>{"[3]"}); // values after the invalid one are parsed by the same 'feed()'
+
+    parser.feed(R"({"key": [1, 2)");
+    CHECK(check_if_throws([&] { parser.finish(); })); // incomplete value at the end of the stream
+
+    parser.feed("tru");
+    parser.feed("e");
+    parser.finish();
+    CHECK(parsed == std::vector<std::string>{"[3]", "true"});
+}
+
+TEST_CASE("Stream parser doesn't drop valid values that follow an invalid one in the same chunk") {
+    std::vector<std::string> parsed;
+    json::StreamParser       parser(
+        [&](json::Node&& node) { parsed.push_back(node.to_string(json::Format::MINIMIZED)); });
+
+    CHECK(check_if_throws([&] { parser.feed("[1] {] [2] [3]\n"); }));
+    parser.finish();
+    CHECK(parsed == std::vector<std::string>{"[1]", "[2]", "[3]"});
+
+    parsed.clear();
+    CHECK(check_if_throws([&] { parser.feed(R"(1 {"a":} "x" 2)"); }));
+    parser.finish(); // trailing scalar can only be completed by the end of the stream
+    CHECK(parsed == std::vector<std::string>{"1", R"("x")", "2"});
+}
+
+// ==================================
+// --- Streaming serializer tests ---
+// ==================================
+
+TEST_CASE("Streaming serializer produces the same output as 'to_string()'") {
+    // Large enough to require several flushes of the internal buffer
+    json::Node json;
+    for (int i = 0; i < 4000; ++i) {
+        json["array"].push_back(json::Array{i, "string \"with\" escapes\n", true, json::Null{}});
+        json["object"]["key " + std::to_string(i)]["nested"] = i * 0.5;
+    }
+
+    for (const auto format : {json::Format::PRETTY, json::Format::MINIMIZED}) {
+        const std::string expected = json.to_string(format);
+        REQUIRE(expected.size() > 4 * 65536);
+
+        // Callback
+        std::string from_callback;
+        std::size_t max_chunk_size = 0;
+        json.to_callback(
+            [&](std::string_view chunk) {
+                from_callback += chunk;
+                max_chunk_size = std::max(max_chunk_size, chunk.size());
+            },
+            format);
+        CHECK(from_callback == expected);
+        CHECK(max_chunk_size < 2 * 65536); // output is bounded by the buffer, not by the size of JSON
+
+        // std::ostream
+        std::ostringstream stream;
+        json.to_stream(stream, format);
+        CHECK(stream.str() == expected);
+
+        // FILE*
+        std::FILE* file = std::tmpfile();
+        REQUIRE(file);
+        json.to_stream(file, format);
+        std::string from_file(static_cast<std::size_t>(std::ftell(file)), '\0');
+        std::rewind(file);
+        CHECK(std::fread(from_file.data(), 1, from_file.size(), file) == from_file.size());
+        std::fclose(file);
+        CHECK(from_file == expected);
+    }
+
+    // Trivial values get flushed too
+    std::string small;
+    json::Node(17).to_callback([&](std::string_view chunk) { small += chunk; });
+    CHECK(small == "17");
+}
+
 // ========================
 // --- Reflection tests ---
 // ========================
@@ -377,4 +842,106 @@ TEST_CASE("JSON struct reflection works for nested containers of reflected struc
     CHECK(reflected_cfg == cfg);
 }
 // if map-of-arrays of structs and 3D tensor of reflected structs are properly reflected in
-// another struct then it seems pretty safe to assume that everything else should be possible too
\ No newline at end of file
+// another struct then it seems pretty safe to assume that everything else should be possible too
+
+// =========================================
+// --- Direct struct serialization tests ---
+// =========================================
+
+template <class T>
+void check_direct_serialization(const T& cfg) {
+    for (const auto format : {json::Format::PRETTY, json::Format::MINIMIZED}) {
+        std::string chars;
+        json::to_json_string(cfg, chars, format);
+
+        // Fields are written in declaration order, while 'from_struct()' goes through an object,
+        // parsing both back normalizes the order
+        const auto parsed = json::from_string(chars);
+        check_json_against_struct(parsed, cfg);
+        CHECK(parsed.to_string(format) == json::from_struct(cfg).to_string(format));
+        CHECK(parsed.to_struct<T>() == cfg);
+    }
+}
+
+TEST_CASE("Direct struct serialization agrees with 'from_struct()'") {
+    check_direct_serialization(test_simple_cfg);
+    check_direct_serialization(test_nested_cfg);
+    check_direct_serialization(test_nested_container_cfg);
+}
+
+TEST_CASE("Direct struct serialization appends to the buffer") {
+    const NestedConfig cfg = {{{}, {}, "with \"escapes\"\n", 1.5, false, json::Null{}}, true};
+
+    std::string chars = "prefix ";
+    json::to_json_string(cfg, chars, json::Format::MINIMIZED);
+
+    CHECK(chars == R"(prefix {"substruct":{"object":{},"array":[],"string":"with \"escapes\"\n","number":1.5,)"
+                   R"("boolean":false,"null":null},"flag":true})");
+}
+
+// ===================================
+// --- Direct struct parsing tests ---
+// ===================================
+
+template <class T>
+void check_direct_parsing(const T& cfg) {
+    for (const auto format : {json::Format::PRETTY, json::Format::MINIMIZED}) {
+        const std::string chars = json::from_struct(cfg).to_string(format);
+        CHECK(json::from_json_string<T>(chars) == cfg);
+        CHECK(json::from_json_string<T>(chars) == json::from_string(chars).to_struct<T>());
+    }
+}
+
+TEST_CASE("Direct struct parsing agrees with 'to_struct()'") {
+    check_direct_parsing(test_simple_cfg);
+    check_direct_parsing(test_nested_cfg);
+    check_direct_parsing(test_nested_container_cfg);
+}
+
+TEST_CASE("Direct struct parsing skips unknown keys") {
+    const auto cfg = json::from_json_string<NestedConfig>(R"({
+        "unknown_1": { "nested": [ 1, { "deeper": null }, "\"}]" ] },
+        "flag": true,
+        "substruct": { "string": "lorem\nipsum", "unknown_2": [], "array": [ 1, 2 ] },
+        "unknown_3": -1.5e3
+    })");
+
+    CHECK(cfg.flag == true);
+    CHECK(cfg.substruct.string == "lorem\nipsum");
+    CHECK(cfg.substruct.array == std::vector<int>{1, 2});
+    CHECK(cfg.substruct.object.empty()); // missing fields stay default-initialized
+}
+
+TEST_CASE("Direct struct parsing resolves duplicate keys the same way as 'to_struct()'") {
+    const std::string chars = R"({
+        "substruct": {
+            "object": { "a": 1, "b": 2, "a": 3 },
+            "array": [ 1, 2 ],
+            "string": "first",
+            "number": 1,
+            "boolean": true,
+            "null": null,
+            "string": "second",
+            "object": { "c": 4 }
+        },
+        "flag": false,
+        "substruct": { "object": {}, "number": 2 },
+        "flag": true
+    })";
+
+    const auto direct = json::from_json_string<NestedConfig>(chars);
+    CHECK(direct == json::from_string(chars).to_struct<NestedConfig>());
+
+    CHECK(direct.flag == false); // first duplicate wins at every level
+    CHECK(direct.substruct.object == std::unordered_map<std::string, int>{{"a", 1}, {"b", 2}});
+    CHECK(direct.substruct.string == "first");
+    CHECK(direct.substruct.number == 1);
+}
+
+TEST_CASE("Direct struct parsing rejects invalid JSON and mismatched types") {
+    CHECK(check_if_throws([] { (void)json::from_json_string<NestedConfig>(R"({"flag": 1})"); }));
+    CHECK(check_if_throws([] { (void)json::from_json_string<NestedConfig>(R"({"flag": true,})"); }));
+    CHECK(check_if_throws([] { (void)json::from_json_string<NestedConfig>(R"({"flag": true} [])"); }));
+    CHECK(check_if_throws([] { (void)json::from_json_string<NestedConfig>(R"({"unknown": [1, 2})"); }));
+    CHECK(check_if_throws([] { (void)json::from_json_string<NestedConfig>(R"({"substruct": []})"); }));
+}
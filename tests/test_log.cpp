@@ -10,6 +10,7 @@
 // _______________________ INCLUDES _______________________
 
 #include <array>         // testing stringification
+#include <atomic>        // testing rate limiting
 #include <complex>       // testing stringification
 #include <cstdint>       // testing stringification
 #include <deque>         // testing stringification
@@ -17,7 +18,9 @@
 #include <map>           // testing stringification
 #include <queue>         // testing stringification
 #include <set>           // testing stringification
+#include <sstream>       // testing logging
 #include <stack>         // testing stringification
+#include <thread>        // testing async logging
 #include <unordered_map> // testing stringification
 #include <unordered_set> // testing stringification
 #include <vector>        // testing stringification
@@ -249,4 +252,272 @@ TEST_CASE("Stringifier customization correctly overrides formatting of specific
 // --- Logger formatting tests ---
 // ===============================
 
-// Is that even a sensible test?
\ No newline at end of file
+// Is that even a sensible test?
+
+// ===========================
+// --- Async logging tests ---
+// ===========================
+
+// Logger sinks are global & can't be removed, which is why all logging tests share a single message-only sink
+std::ostringstream& test_stream() {
+    static std::ostringstream oss;
+    return oss;
+}
+
+log::Sink& test_sink_handle() {
+    static log::Sink& sink = [&]() -> log::Sink& {
+        log::Columns columns;
+        columns.datetime = false;
+        columns.uptime   = false;
+        columns.thread   = false;
+        columns.callsite = false;
+        columns.level    = false;
+        return log::add_ostream_sink(test_stream(), log::Verbosity::TRACE, log::Colors::DISABLE,
+                                     std::chrono::milliseconds{0}, columns)
+            .skip_header();
+    }();
+    return sink;
+}
+
+std::ostringstream& test_sink() {
+    test_sink_handle();
+    return test_stream();
+}
+
+// Logs 'thread_count * message_count' messages of the form "<thread> <index>" from multiple threads
+void log_from_multiple_threads(int thread_count, int message_count) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t)
+        threads.emplace_back([t, message_count] {
+            for (int i = 0; i < message_count; ++i) UTL_LOG_TRACE(t, " ", i);
+        });
+    for (auto& thread : threads) thread.join();
+}
+
+// Returns the number of logged lines, checks that messages of each thread are in order & without gaps
+std::size_t check_logged_messages(int thread_count, bool allow_gaps) {
+    std::istringstream in(test_sink().str());
+    std::vector<int>   last(thread_count, -1);
+    std::size_t        count = 0;
+
+    for (std::string line; std::getline(in, line); ++count) {
+        std::istringstream line_in(line);
+        int                t = 0, i = 0;
+        line_in >> t >> i;
+        REQUIRE(t < thread_count);
+        if (allow_gaps) CHECK(i > last[t]);
+        else CHECK(i == last[t] + 1);
+        last[t] = i;
+    }
+
+    return count;
+}
+
+TEST_CASE("Async logging doesn't lose or reorder messages") {
+    constexpr int thread_count  = 4;
+    constexpr int message_count = 5'000;
+
+    for (auto overflow : {log::Overflow::BLOCK, log::Overflow::GROW}) {
+        test_sink().str("");
+
+        log::enable_async(16, overflow); // small queue so overflow actually happens
+        log_from_multiple_threads(thread_count, message_count);
+        log::flush();
+
+        CHECK(check_logged_messages(thread_count, false) == thread_count * message_count);
+        CHECK(log::get_dropped_count() == 0);
+
+        log::disable_async();
+    }
+}
+
+TEST_CASE("Async logging with 'Overflow::DROP' only loses messages it reports as dropped") {
+    constexpr int thread_count  = 4;
+    constexpr int message_count = 5'000;
+
+    test_sink().str("");
+
+    log::enable_async(16, log::Overflow::DROP);
+    log_from_multiple_threads(thread_count, message_count);
+    log::flush();
+
+    CHECK(check_logged_messages(thread_count, true) + log::get_dropped_count() == thread_count * message_count);
+
+    log::disable_async();
+}
+
+TEST_CASE("Disabling async logging writes all pending messages") {
+    test_sink().str("");
+
+    log::enable_async(4, log::Overflow::GROW);
+    for (int i = 0; i < 100; ++i) UTL_LOG_TRACE(0, " ", i);
+    log::disable_async();
+
+    CHECK(check_logged_messages(1, false) == 100);
+    CHECK_FALSE(log::is_async());
+}
+
+// ==============================
+// --- Deferred logging tests ---
+// ==============================
+
+TEST_CASE("Deferred logging doesn't lose or reorder messages") {
+    constexpr int thread_count  = 4;
+    constexpr int message_count = 5'000;
+
+    test_sink().str("");
+
+    log::enable_deferred(1024); // small buffers, so producers have to wait for space
+    log_from_multiple_threads(thread_count, message_count);
+    log::flush();
+    CHECK(log::is_deferred());
+
+    CHECK(check_logged_messages(thread_count, false) == thread_count * message_count);
+
+    log::disable_deferred();
+}
+
+TEST_CASE("Deferred logging produces the same text as regular logging") {
+    const auto log_everything = [] {
+        const std::string        str  = "string";
+        const std::string_view   view = "view";
+        const char*              ptr  = "pointer";
+        const std::vector<int>   vec  = {1, 2, 3};
+        const unsigned long long ull  = 18446744073709551615ull;
+
+        UTL_LOG_TRACE("literal ", 1, ' ', -2, ' ', ull, ' ', 0.125f, ' ', 1.5e300, ' ', true);
+        UTL_LOG_TRACE(str, ' ', view, ' ', ptr, ' ', std::string(3, 'x'));
+        UTL_LOG_TRACE("fallback ", vec, ' ', log::PadLeft{7, 4}); // stringified on the calling thread
+        UTL_LOG_TRACE(std::string(5000, 'y'));                   // larger than the whole buffer
+    };
+
+    test_sink().str("");
+    log_everything();
+    const std::string expected = test_sink().str();
+
+    test_sink().str("");
+    log::enable_deferred(1024);
+    log_everything();
+    log::disable_deferred();
+
+    CHECK(test_sink().str() == expected);
+    CHECK_FALSE(log::is_deferred());
+}
+
+// ============================
+// --- Verbosity gate tests ---
+// ============================
+
+TEST_CASE("Messages above the verbosity of all sinks don't evaluate their arguments") {
+    test_sink().str("");
+
+    int  evaluated = 0;
+    auto argument  = [&] { return ++evaluated; };
+
+    test_sink_handle().set_verbosity(log::Verbosity::INFO);
+    UTL_LOG_TRACE(argument());
+    UTL_LOG_DEBUG(argument());
+    CHECK(evaluated == 0);
+    CHECK(test_sink().str().empty());
+
+    UTL_LOG_INFO(argument());
+    CHECK(evaluated == 1);
+    CHECK(test_sink().str() == " 1\n");
+
+    test_sink_handle().set_verbosity(log::Verbosity::TRACE);
+    UTL_LOG_TRACE(argument());
+    CHECK(evaluated == 2);
+}
+
+// ============================
+// --- Multiple sinks tests ---
+// ============================
+
+TEST_CASE("Messages are stringified once & written to every sink with its own decoration") {
+    test_sink().str("");
+
+    log::Columns message_only;
+    message_only.datetime = false;
+    message_only.uptime   = false;
+    message_only.thread   = false;
+    message_only.callsite = false;
+    message_only.level    = false;
+
+    log::Columns with_level = message_only;
+    with_level.level        = true;
+
+    static std::ostringstream same_decoration, other_decoration;
+    log::add_ostream_sink(same_decoration, log::Verbosity::TRACE, log::Colors::DISABLE, {}, message_only).skip_header();
+    log::add_ostream_sink(other_decoration, log::Verbosity::WARN, log::Colors::DISABLE, {}, with_level).skip_header();
+
+    int  evaluated = 0;
+    auto argument  = [&] { return ++evaluated; };
+
+    UTL_LOG_TRACE("value = ", argument());
+    UTL_LOG_WARN("value = ", argument());
+    CHECK(evaluated == 2);
+
+    CHECK(test_sink().str() == " value = 1\n value = 2\n");
+    CHECK(same_decoration.str() == test_sink().str());
+    CHECK(other_decoration.str() == " WARN| value = 2\n");
+}
+
+// ===========================
+// --- Rate limiting tests ---
+// ===========================
+
+TEST_CASE("Rate-limited macros only evaluate & log the calls they let through") {
+    test_sink().str("");
+
+    int  evaluated = 0;
+    auto argument  = [&] { return ++evaluated; };
+
+    for (int i = 0; i < 10; ++i) UTL_LOG_EVERY_N(TRACE, 4, argument());
+    CHECK(evaluated == 3); // calls #0, #4, #8
+
+    evaluated = 0;
+    for (int i = 0; i < 10; ++i) UTL_LOG_FIRST_N(TRACE, 3, argument());
+    CHECK(evaluated == 3);
+
+    evaluated = 0;
+    for (int i = 0; i < 10; ++i) UTL_LOG_EVERY_MS(TRACE, 3'600'000, argument());
+    CHECK(evaluated == 1);
+
+    evaluated = 0;
+    for (int i = 0; i < 10; ++i) UTL_LOG_RATE_LIMITED(TRACE, 1. / 3600, 5, argument());
+    CHECK(evaluated == 5); // initial burst, refilling a token takes an hour
+
+    CHECK(test_sink().str() == " 1\n 2\n 3\n 1\n 2\n 3\n 1\n 1\n 2\n 3\n 4\n 5\n");
+}
+
+TEST_CASE("Rate-limited macros with a non-positive rate only let the initial burst through") {
+    test_sink().str("");
+
+    int  evaluated = 0;
+    auto argument  = [&] { return ++evaluated; };
+
+    for (int i = 0; i < 10; ++i) UTL_LOG_RATE_LIMITED(TRACE, 0., 3, argument());
+    CHECK(evaluated == 3);
+
+    evaluated = 0;
+    for (int i = 0; i < 10; ++i) UTL_LOG_RATE_LIMITED(TRACE, -5., 2, argument());
+    CHECK(evaluated == 2);
+
+    CHECK(test_sink().str() == " 1\n 2\n 3\n 1\n 2\n");
+}
+
+TEST_CASE("Rate limits are shared by all threads") {
+    constexpr int thread_count = 4;
+
+    test_sink().str("");
+
+    std::atomic<int>         evaluated = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t)
+        threads.emplace_back([&] {
+            for (int i = 0; i < 1000; ++i) UTL_LOG_FIRST_N(TRACE, 10, ++evaluated);
+        });
+    for (auto& thread : threads) thread.join();
+
+    CHECK(evaluated == 10);
+}
@@ -0,0 +1,632 @@
+// _______________ TEST FRAMEWORK & MODULE  _______________
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "thirdparty/doctest.h"
+
+#include "test.hpp"
+
+#include "UTL/parallel.hpp"
+
+// _______________________ INCLUDES _______________________
+
+#include <algorithm>  // testing algorithms
+#include <array>      // testing tasks
+#include <atomic>     // testing loops & task groups
+#include <cstddef>    // testing algorithms
+#include <functional> // testing algorithms
+#include <future>     // testing tasks
+#include <memory>     // testing tasks
+#include <numeric>    // testing algorithms
+#include <random>     // generating test data
+#include <stdexcept>  // testing task groups
+#include <string>     // testing reductions
+#include <thread>     // testing tasks
+#include <utility>    // testing algorithms
+#include <vector>     // testing algorithms
+
+// ____________________ DEVELOPER DOCS ____________________
+
+// NOTE: DOCS
+
+// ____________________ IMPLEMENTATION ____________________
+
+// =====================
+// --- Test fixtures ---
+// =====================
+
+// Every algorithm is checked against its 'std::' equivalent for all combinations of pool configuration,
+// input size & grain size. Sizes & grains are picked to hit empty, single-element, partial last chunk,
+// single chunk & many chunk cases. Thread count '0' means all tasks get executed by the waiting thread.
+
+const std::size_t test_thread_count = std::max<std::size_t>(4, parallel::max_thread_count());
+
+template <class Func>
+void for_every_pool_config(Func&& func) {
+    for (auto scheduler : {parallel::Scheduler::SHARED_QUEUE, parallel::Scheduler::WORK_STEALING}) {
+        for (std::size_t thread_count : {std::size_t{0}, std::size_t{1}, test_thread_count}) {
+            parallel::set_scheduler(scheduler);
+            parallel::set_thread_count(thread_count);
+
+            CAPTURE(static_cast<int>(scheduler));
+            CAPTURE(thread_count);
+
+            func();
+        }
+    }
+
+    parallel::set_scheduler(parallel::Scheduler::SHARED_QUEUE);
+    parallel::set_thread_count(parallel::max_thread_count());
+}
+
+template <class Func>
+void for_every_input(Func&& func) {
+    for (std::size_t size : {0, 1, 17, 5000}) {
+        for (std::size_t grain_size : {0, 1, 7, 100000}) {
+            CAPTURE(size);
+            CAPTURE(grain_size);
+
+            std::mt19937                       gen(static_cast<unsigned>(size));
+            std::uniform_int_distribution<int> dist(-100, 100); // small range => plenty of duplicates
+
+            std::vector<int> data(size);
+            for (auto& e : data) e = dist(gen);
+
+            func(std::move(data), grain_size);
+        }
+    }
+}
+
+template <class Func>
+void for_every_config_and_input(Func&& func) {
+    for_every_pool_config([&] { for_every_input(func); });
+}
+
+constexpr auto is_even = [](int x) { return x % 2 == 0; };
+
+// ==================
+// --- Task tests ---
+// ==================
+
+// Tasks are stored inline when the callable is small & nothrow-movable, everything else goes onto the heap.
+// Detached tasks are only ever executed by workers, so pools without threads are skipped.
+
+struct ThrowingMoveCallable {
+    std::atomic<int>* counter;
+
+    ThrowingMoveCallable(std::atomic<int>* counter) : counter(counter) {}
+    ThrowingMoveCallable(const ThrowingMoveCallable&) = default;
+    ThrowingMoveCallable(ThrowingMoveCallable&& other) : counter(other.counter) {} // not 'noexcept'
+
+    void operator()() const { ++*this->counter; }
+};
+
+TEST_CASE("Tasks run small, large & throwing-move callables") {
+    for_every_pool_config([] {
+        if (parallel::get_thread_count() == 0) return;
+
+        std::atomic<int> counter{0};
+
+        std::array<int, 64> payload{}; // too large for the inline buffer
+        payload.back() = 3;
+
+        parallel::task([&counter] { ++counter; });
+        parallel::task([&counter, payload] { counter += payload.back(); });
+        parallel::task(ThrowingMoveCallable{&counter});
+        parallel::wait_for_tasks();
+
+        CHECK(counter == 1 + 3 + 1);
+    });
+}
+
+TEST_CASE("Tasks accept move-only captures") {
+    for_every_pool_config([] {
+        if (parallel::get_thread_count() == 0) return;
+
+        std::atomic<int> result{0};
+
+        parallel::task([&result, ptr = std::make_unique<int>(42)] { result = *ptr; });
+        parallel::wait_for_tasks();
+
+        CHECK(result == 42);
+
+        auto future = parallel::task_with_future([ptr = std::make_unique<int>(17)] { return *ptr; });
+        CHECK(future.get() == 17);
+    });
+}
+
+TEST_CASE("Tasks with future return values, void & exceptions") {
+    for_every_pool_config([] {
+        if (parallel::get_thread_count() == 0) return;
+
+        auto value_future = parallel::task_with_future([](int x, int y) { return x * y; }, 6, 7);
+        CHECK(value_future.get() == 42);
+
+        std::atomic<bool> done{false};
+        auto              void_future = parallel::task_with_future([&done] { done = true; });
+        void_future.get();
+        CHECK(done);
+
+        auto throwing_future = parallel::task_with_future([]() -> int { throw std::runtime_error("task failed"); });
+        CHECK_THROWS_AS(throwing_future.get(), std::runtime_error);
+
+        // repeated submissions recycle shared states through the block cache
+        std::vector<std::future<std::size_t>> futures;
+        for (std::size_t i = 0; i < 1000; ++i) futures.push_back(parallel::task_with_future([i] { return i; }));
+        for (std::size_t i = 0; i < futures.size(); ++i) CHECK(futures[i].get() == i);
+    });
+}
+
+TEST_CASE("Futures can outlive the thread-local block cache") {
+    // Thread-local future is constructed before the first allocation creates the block cache of this thread,
+    // so it gets destroyed after the cache and its shared state has to bypass the cache on deallocation
+    parallel::ThreadPool pool(2);
+
+    std::thread thread([&] {
+        thread_local std::future<int> future;
+
+        future = pool.add_task_with_future([] { return 5; });
+        future.wait();
+        pool.wait_for_tasks();
+    });
+    thread.join();
+
+    // same for futures that outlive the worker which fulfilled them
+    std::future<int> future;
+    {
+        parallel::ThreadPool local_pool(1);
+        future = local_pool.add_task_with_future([] { return 7; });
+    }
+    CHECK(future.get() == 7);
+}
+
+// ========================
+// --- Task group tests ---
+// ========================
+
+TEST_CASE("Task group runs nested parallel loops without deadlocking") {
+    for_every_pool_config([] {
+        std::atomic<std::size_t> total{0};
+
+        parallel::TaskGroup group;
+        for (int task = 0; task < 16; ++task)
+            group.add_task([&] {
+                parallel::for_loop(parallel::IndexRange<int>{0, 1000, 10}, [&](int low, int high) {
+                    parallel::for_loop(parallel::IndexRange<int>{low, high, 3}, [&](int l, int h) {
+                        total += static_cast<std::size_t>(h - l);
+                    });
+                });
+            });
+        group.wait();
+
+        CHECK(total == 16 * 1000);
+    });
+}
+
+TEST_CASE("Task group rethrows exceptions from its tasks on wait()") {
+    for_every_pool_config([] {
+        std::atomic<std::size_t> tasks_done{0};
+
+        parallel::TaskGroup group;
+        for (int task = 0; task < 16; ++task)
+            group.add_task([&, task] {
+                ++tasks_done;
+                if (task == 5) throw std::runtime_error("task failed");
+            });
+
+        CHECK_THROWS_AS(group.wait(), std::runtime_error);
+        CHECK(tasks_done == 16); // other tasks still get to run
+        CHECK_NOTHROW(group.wait()); // exception gets rethrown only once
+
+        const auto throwing_loop = [] {
+            parallel::for_loop(parallel::IndexRange<int>{0, 100, 10}, [](int low, int) {
+                if (low == 50) throw std::runtime_error("chunk failed");
+            });
+        };
+        CHECK_THROWS_AS(throwing_loop(), std::runtime_error);
+    });
+}
+
+// ===========================
+// --- Loop schedule tests ---
+// ===========================
+
+// Every index of the range should be visited exactly once, regardless of the schedule & grain size
+template <class Idx>
+void check_every_index_hit_once(parallel::IndexRange<Idx> range, parallel::Schedule schedule) {
+    const std::size_t size = range.first < range.last ? static_cast<std::size_t>(range.last - range.first) : 0;
+
+    std::vector<std::atomic<int>> hits(size);
+
+    parallel::for_loop(
+        range,
+        [&](Idx low, Idx high) {
+            CHECK(range.first <= low);
+            CHECK(high <= range.last);
+            for (Idx i = low; i < high; ++i) ++hits[static_cast<std::size_t>(i - range.first)];
+        },
+        schedule);
+
+    const bool all_hit_once = std::all_of(hits.begin(), hits.end(), [](const auto& hit) { return hit == 1; });
+    CHECK(all_hit_once);
+}
+
+TEST_CASE("Loop schedules visit every index exactly once") {
+    for_every_pool_config([] {
+        for (auto schedule : {parallel::Schedule::STATIC, parallel::Schedule::DYNAMIC, parallel::Schedule::GUIDED}) {
+            for (std::size_t grain_size : {0, 1, 7, 100000}) {
+                CAPTURE(static_cast<int>(schedule));
+                CAPTURE(grain_size);
+
+                check_every_index_hit_once(parallel::IndexRange<std::size_t>{0, 1000, grain_size}, schedule);
+                check_every_index_hit_once(parallel::IndexRange<int>{-537, 464, grain_size}, schedule);
+                check_every_index_hit_once(parallel::IndexRange<int>{-20, -3, grain_size}, schedule);
+                check_every_index_hit_once(parallel::IndexRange<int>{5, 5, grain_size}, schedule);
+            }
+        }
+    });
+}
+
+TEST_CASE("Loop schedules visit every element of an iterator range exactly once") {
+    for_every_pool_config([] {
+        for (auto schedule : {parallel::Schedule::STATIC, parallel::Schedule::DYNAMIC, parallel::Schedule::GUIDED}) {
+            CAPTURE(static_cast<int>(schedule));
+
+            std::vector<int> data(1001, 0);
+            parallel::for_loop(
+                parallel::Range{data.begin(), data.end(), 13},
+                [](auto low, auto high) {
+                    for (auto it = low; it != high; ++it) ++*it;
+                },
+                schedule);
+
+            CHECK(std::count(data.begin(), data.end(), 1) == 1001);
+        }
+    });
+}
+
+// ====================================
+// --- Multi-dimensional loop tests ---
+// ====================================
+
+TEST_CASE("2D loops visit every index exactly once") {
+    for_every_pool_config([] {
+        for (auto traversal : {parallel::Traversal::ROW_MAJOR, parallel::Traversal::MORTON}) {
+            for (auto schedule : {parallel::Schedule::STATIC, parallel::Schedule::GUIDED}) {
+                CAPTURE(static_cast<int>(traversal));
+                CAPTURE(static_cast<int>(schedule));
+
+                // extents are not multiples of the tile size, the last tile in every dimension is partial
+                const parallel::IndexRange<int> rows{-3, 34, 8}, cols{0, 23, 5};
+                std::vector<std::atomic<int>>   hits(37 * 23);
+
+                parallel::for_loop(
+                    parallel::IndexRange2D<int>{rows, cols, traversal},
+                    [&](int i_low, int i_high, int j_low, int j_high) {
+                        for (int i = i_low; i < i_high; ++i)
+                            for (int j = j_low; j < j_high; ++j) ++hits[(i - rows.first) * 23 + (j - cols.first)];
+                    },
+                    schedule);
+
+                const bool all_hit_once = std::all_of(hits.begin(), hits.end(), [](const auto& h) { return h == 1; });
+                CHECK(all_hit_once);
+            }
+        }
+    });
+}
+
+TEST_CASE("3D loops visit every index exactly once") {
+    for_every_pool_config([] {
+        for (auto traversal : {parallel::Traversal::ROW_MAJOR, parallel::Traversal::MORTON}) {
+            for (auto schedule : {parallel::Schedule::STATIC, parallel::Schedule::DYNAMIC}) {
+                CAPTURE(static_cast<int>(traversal));
+                CAPTURE(static_cast<int>(schedule));
+
+                const parallel::IndexRange<int> x{0, 11, 4}, y{0, 9, 2}, z{0, 7, 3};
+                std::vector<std::atomic<int>>   hits(11 * 9 * 7);
+
+                parallel::for_loop(
+                    parallel::IndexRange3D<int>{x, y, z, traversal},
+                    [&](int i_low, int i_high, int j_low, int j_high, int k_low, int k_high) {
+                        for (int i = i_low; i < i_high; ++i)
+                            for (int j = j_low; j < j_high; ++j)
+                                for (int k = k_low; k < k_high; ++k) ++hits[(i * 9 + j) * 7 + k];
+                    },
+                    schedule);
+
+                const bool all_hit_once = std::all_of(hits.begin(), hits.end(), [](const auto& h) { return h == 1; });
+                CHECK(all_hit_once);
+            }
+        }
+    });
+}
+
+// ==================
+// --- Sort tests ---
+// ==================
+
+TEST_CASE("Parallel sort matches std::sort()") {
+    for_every_config_and_input([](std::vector<int> data, std::size_t grain_size) {
+        std::vector<int> expected = data;
+        std::sort(expected.begin(), expected.end());
+
+        parallel::sort(parallel::Range{data.begin(), data.end(), grain_size});
+        CHECK(data == expected);
+    });
+}
+
+TEST_CASE("Parallel sort with a custom comparator matches std::sort()") {
+    for_every_config_and_input([](std::vector<int> data, std::size_t grain_size) {
+        std::vector<int> expected = data;
+        std::sort(expected.begin(), expected.end(), std::greater<>{});
+
+        parallel::sort(parallel::Range{data.begin(), data.end(), grain_size}, std::greater<>{});
+        CHECK(data == expected);
+    });
+}
+
+// =======================
+// --- Partition tests ---
+// =======================
+
+TEST_CASE("Parallel partition matches std::stable_partition()") {
+    for_every_config_and_input([](std::vector<int> values, std::size_t grain_size) {
+        // pair every value with its original index so any loss of stability shows up in the comparison
+        std::vector<std::pair<int, std::size_t>> data(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) data[i] = {values[i], i};
+
+        const auto pred = [](const std::pair<int, std::size_t>& e) { return is_even(e.first); };
+
+        auto       expected     = data;
+        const auto expected_mid = std::stable_partition(expected.begin(), expected.end(), pred);
+
+        const auto mid = parallel::partition(parallel::Range{data.begin(), data.end(), grain_size}, pred);
+        CHECK(data == expected);
+        CHECK(mid - data.begin() == expected_mid - expected.begin());
+    });
+}
+
+TEST_CASE("Parallel partition works with zero grain size") {
+    std::vector<int> data = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    const auto mid = parallel::partition(parallel::Range{data.begin(), data.end(), 0}, is_even);
+    CHECK(data == std::vector{2, 4, 6, 8, 1, 3, 5, 7});
+    CHECK(mid - data.begin() == 4);
+}
+
+// ==================
+// --- Scan tests ---
+// ==================
+
+TEST_CASE("Parallel inclusive scan matches std::inclusive_scan()") {
+    for_every_config_and_input([](std::vector<int> data, std::size_t grain_size) {
+        std::vector<int> expected(data.size());
+        std::inclusive_scan(data.begin(), data.end(), expected.begin(), std::plus<>{});
+
+        std::vector<int> result(data.size());
+        const auto       end = parallel::inclusive_scan(parallel::Range{data.begin(), data.end(), grain_size},
+                                                        result.begin(), std::plus<>{});
+        CHECK(result == expected);
+        CHECK(end == result.end());
+
+        parallel::inclusive_scan(parallel::Range{data.begin(), data.end(), grain_size}, data.begin(), std::plus<>{});
+        CHECK(data == expected); // in-place
+    });
+}
+
+TEST_CASE("Parallel exclusive scan matches std::exclusive_scan()") {
+    for_every_config_and_input([](std::vector<int> data, std::size_t grain_size) {
+        std::vector<int> expected(data.size());
+        std::exclusive_scan(data.begin(), data.end(), expected.begin(), 7, std::plus<>{});
+
+        std::vector<int> result(data.size());
+        const auto       end = parallel::exclusive_scan(parallel::Range{data.begin(), data.end(), grain_size},
+                                                        result.begin(), 7, std::plus<>{});
+        CHECK(result == expected);
+        CHECK(end == result.end());
+
+        parallel::exclusive_scan(parallel::Range{data.begin(), data.end(), grain_size}, data.begin(), 7,
+                                 std::plus<>{});
+        CHECK(data == expected); // in-place
+    });
+}
+
+// ======================================
+// --- Find / count / transform tests ---
+// ======================================
+
+TEST_CASE("Parallel find_if() matches std::find_if()") {
+    for_every_config_and_input([](std::vector<int> data, std::size_t grain_size) {
+        const auto range = parallel::Range{data.begin(), data.end(), grain_size};
+
+        const auto is_large = [](int x) { return x > 90; }; // first match is usually somewhere in the middle
+        const auto is_none  = [](int x) { return x > 100; };
+        const auto is_any   = [](int) { return true; };
+        const auto is_last  = [&](int x) { return x == data.back(); }; // only called when 'data' isn't empty
+
+        CHECK(parallel::find_if(range, is_large) == std::find_if(data.begin(), data.end(), is_large));
+        CHECK(parallel::find_if(range, is_none) == std::find_if(data.begin(), data.end(), is_none));
+        CHECK(parallel::find_if(range, is_any) == std::find_if(data.begin(), data.end(), is_any));
+        CHECK(parallel::find_if(range, is_last) == std::find_if(data.begin(), data.end(), is_last));
+    });
+}
+
+TEST_CASE("Parallel count_if() matches std::count_if()") {
+    for_every_config_and_input([](std::vector<int> data, std::size_t grain_size) {
+        const auto range    = parallel::Range{data.begin(), data.end(), grain_size};
+        const auto expected = std::count_if(data.begin(), data.end(), is_even);
+
+        CHECK(parallel::count_if(range, is_even) == static_cast<std::size_t>(expected));
+    });
+}
+
+TEST_CASE("Parallel transform() matches std::transform()") {
+    for_every_config_and_input([](std::vector<int> data, std::size_t grain_size) {
+        const auto op = [](int x) { return 3 * x - 1; };
+
+        std::vector<int> expected(data.size());
+        std::transform(data.begin(), data.end(), expected.begin(), op);
+
+        std::vector<int> result(data.size());
+        const auto end = parallel::transform(parallel::Range{data.begin(), data.end(), grain_size}, result.begin(), op);
+        CHECK(result == expected);
+        CHECK(end == result.end());
+    });
+}
+
+// ====================
+// --- Reduce tests ---
+// ====================
+
+// Reductions have no identity element to return, empty inputs are skipped
+
+TEST_CASE("Parallel reduce() matches std::accumulate()") {
+    for_every_config_and_input([](std::vector<int> data, std::size_t grain_size) {
+        if (data.empty()) return;
+
+        const auto range = parallel::Range{data.begin(), data.end(), grain_size};
+
+        const int expected_sum = std::accumulate(data.begin() + 1, data.end(), data.front(), std::plus<>{});
+        const int expected_min = *std::min_element(data.begin(), data.end());
+        const int expected_max = *std::max_element(data.begin(), data.end());
+
+        CHECK(parallel::reduce(range, parallel::sum<int>{}) == expected_sum);
+        CHECK(parallel::reduce<4>(range, parallel::sum<int>{}) == expected_sum); // unrolled
+        CHECK(parallel::reduce(range, parallel::min<int>{}) == expected_min);
+        CHECK(parallel::reduce(range, parallel::max<int>{}) == expected_max);
+    });
+}
+
+TEST_CASE("Parallel reduce() preserves the order of a non-commutative op") {
+    for_every_config_and_input([](std::vector<int> values, std::size_t grain_size) {
+        if (values.empty()) return;
+
+        // string concatenation is associative but not commutative, any reordering of the tree shows up here
+        std::vector<std::string> data(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) data[i] = std::to_string(values[i]) + ',';
+
+        const std::string expected = std::accumulate(data.begin() + 1, data.end(), data.front());
+
+        CHECK(parallel::reduce<1>(parallel::Range{data.begin(), data.end(), grain_size}, std::plus<>{}) == expected);
+    });
+}
+
+TEST_CASE("Parallel transform_reduce() matches std::transform_reduce()") {
+    for_every_config_and_input([](std::vector<int> data, std::size_t grain_size) {
+        if (data.empty()) return;
+
+        const auto range  = parallel::Range{data.begin(), data.end(), grain_size};
+        const auto square = [](int x) { return x * x; };
+        const auto mul    = [](int x, int y) { return x * y; };
+
+        std::vector<int> other(data.size());
+        for (std::size_t i = 0; i < other.size(); ++i) other[i] = static_cast<int>(i % 5) - 2;
+
+        // unary
+        const int expected_unary = std::transform_reduce(data.begin(), data.end(), 0, std::plus<>{}, square);
+        CHECK(parallel::transform_reduce(range, std::plus<>{}, square) == expected_unary);
+        CHECK(parallel::transform_reduce<4>(range, std::plus<>{}, square) == expected_unary);
+
+        // binary
+        const int expected_binary =
+            std::transform_reduce(data.begin(), data.end(), other.begin(), 0, std::plus<>{}, mul);
+        CHECK(parallel::transform_reduce(range, other.begin(), std::plus<>{}, mul) == expected_binary);
+        CHECK(parallel::transform_reduce<4>(range, other.begin(), std::plus<>{}, mul) == expected_binary);
+    });
+}
+
+// ==============================
+// --- Thread placement tests ---
+// ==============================
+
+TEST_CASE("CPU lists in sysfs format get parsed") {
+    using cpus = std::vector<std::size_t>;
+
+    CHECK(parallel::_parse_cpu_list("0-3,8-11") == cpus{0, 1, 2, 3, 8, 9, 10, 11});
+    CHECK(parallel::_parse_cpu_list("5") == cpus{5});
+    CHECK(parallel::_parse_cpu_list("") == cpus{});
+    CHECK(parallel::_parse_cpu_list("1,4-5\n") == cpus{1, 4, 5}); // trailing newline from a file
+    CHECK(parallel::_parse_cpu_list("1,2-x") == cpus{1});         // garbage stops parsing
+    CHECK(parallel::_parse_cpu_list("7,abc") == cpus{7});
+}
+
+TEST_CASE("Workers get placed according to the affinity") {
+    const std::vector<std::vector<std::size_t>> topology = {{0, 1, 2, 3}, {8, 9, 10, 11}}; // 2 NUMA nodes
+
+    const auto place = [&](std::size_t thread_count, parallel::Affinity affinity, std::vector<std::size_t> cpus = {}) {
+        std::vector<std::pair<std::size_t, std::size_t>> result; // { cpu, node }
+        for (const auto& worker : parallel::_place_workers(thread_count, affinity, cpus, topology)) {
+            REQUIRE(worker.cpu.has_value());
+            result.emplace_back(*worker.cpu, worker.node);
+        }
+        return result;
+    };
+
+    using placement = std::vector<std::pair<std::size_t, std::size_t>>;
+
+    // compact placement fills up the first node before moving to the next one, then wraps around
+    CHECK(place(6, parallel::Affinity::COMPACT) == placement{{0, 0}, {1, 0}, {2, 0}, {3, 0}, {8, 1}, {9, 1}});
+    CHECK(place(10, parallel::Affinity::COMPACT)[8] == std::pair<std::size_t, std::size_t>{0, 0});
+
+    // scatter placement alternates between nodes
+    CHECK(place(6, parallel::Affinity::SCATTER) == placement{{0, 0}, {8, 1}, {1, 0}, {9, 1}, {2, 0}, {10, 1}});
+
+    // explicit placement cycles through the list, unknown CPUs count as the first node
+    CHECK(place(4, parallel::Affinity::EXPLICIT, {9, 2, 42}) == placement{{9, 1}, {2, 0}, {42, 0}, {9, 1}});
+
+    // no affinity & an empty explicit list leave workers unpinned
+    for (auto affinity : {parallel::Affinity::NONE, parallel::Affinity::EXPLICIT})
+        for (const auto& worker : parallel::_place_workers(4, affinity, {}, topology)) CHECK(!worker.cpu);
+}
+
+TEST_CASE("Thread pool keeps working after changing affinity & thread names") {
+    const std::string default_name = parallel::get_thread_name();
+
+    for_every_pool_config([] {
+        parallel::set_affinity(parallel::Affinity::COMPACT);
+        parallel::set_thread_name("utl-test");
+        CHECK(parallel::get_affinity() == parallel::Affinity::COMPACT);
+        CHECK(parallel::get_thread_name() == "utl-test");
+
+        parallel::set_affinity(parallel::Affinity::SCATTER);
+        parallel::set_affinity(std::vector<std::size_t>{0});
+        CHECK(parallel::get_affinity() == parallel::Affinity::EXPLICIT);
+
+        std::atomic<int> total{0};
+        parallel::for_loop(parallel::IndexRange<int>{0, 1000, 10}, [&](int low, int high) { total += high - low; });
+        CHECK(total == 1000);
+    });
+
+    parallel::set_affinity(parallel::Affinity::NONE);
+    parallel::set_thread_name(default_name);
+}
+
+// =========================
+// --- Idle policy tests ---
+// =========================
+
+TEST_CASE("Thread pool keeps working with a spinning idle policy") {
+    for_every_pool_config([] {
+        parallel::set_idle_policy({1000, 10});
+
+        const auto policy = parallel::get_idle_policy();
+        CHECK(policy.spin_count == 1000);
+        CHECK(policy.yield_count == 10);
+
+        // tight sequence of small loops is exactly the case spinning is meant for
+        for (int repeat = 0; repeat < 100; ++repeat) {
+            std::atomic<int> total{0};
+            parallel::for_loop(parallel::IndexRange<int>{0, 100, 10}, [&](int low, int high) { total += high - low; });
+            CHECK(total == 100);
+        }
+
+        if (parallel::get_thread_count() != 0) { // detached tasks are only ever executed by workers
+            std::vector<std::future<int>> futures;
+            for (int i = 0; i < 100; ++i) futures.push_back(parallel::task_with_future([i] { return i; }));
+            for (int i = 0; i < 100; ++i) CHECK(futures[i].get() == i);
+        }
+
+        parallel::set_idle_policy({});
+        CHECK(parallel::get_idle_policy().spin_count == 0);
+        CHECK(parallel::get_idle_policy().yield_count == 0);
+    });
+}